@@ -0,0 +1,140 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "base_profiler.h"
+#include <iostream>
+#include <random>
+
+import stl;
+import catalog;
+import function_set;
+import scalar_function;
+import scalar_function_set;
+import add;
+import substract;
+import multiply;
+import greater;
+import base_expression;
+import value_expression;
+import reference_expression;
+import function_expression;
+import column_vector;
+import expression_state;
+import expression_evaluator;
+import value;
+import data_block;
+import default_values;
+import logical_type;
+import internal_types;
+import data_type;
+
+using namespace infinity;
+
+// Evaluates "c0 * 2 + c1 > c2" and "(c0 - 3.5) * c1" over blocks of DEFAULT_VECTOR_SIZE rows, node by node with one
+// intermediate column vector per function, and as one fused kernel.
+// Usage: fused_expression_benchmark [block_count] [rounds]
+
+static UniquePtr<Catalog> catalog;
+
+static SharedPtr<BaseExpression> MakeFunction(const String &name, SharedPtr<BaseExpression> left, SharedPtr<BaseExpression> right) {
+    SharedPtr<FunctionSet> function_set = Catalog::GetFunctionSetByName(catalog.get(), name);
+    auto scalar_function_set = std::static_pointer_cast<ScalarFunctionSet>(function_set);
+    Vector<SharedPtr<BaseExpression>> arguments{std::move(left), std::move(right)};
+    ScalarFunction func = scalar_function_set->GetMostMatchFunction(arguments);
+    return MakeShared<FunctionExpression>(func, arguments);
+}
+
+static Vector<SharedPtr<DataBlock>> GenerateBlocks(LogicalType type, SizeT block_count) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<i32> dist(-1'000'000, 1'000'000);
+    auto data_type = MakeShared<DataType>(type);
+    Vector<SharedPtr<DataBlock>> blocks;
+    for (SizeT block_idx = 0; block_idx < block_count; ++block_idx) {
+        auto data_block = DataBlock::Make();
+        data_block->Init({data_type, data_type, data_type});
+        for (SizeT i = 0; i < DEFAULT_VECTOR_SIZE; ++i) {
+            for (SizeT column_idx = 0; column_idx < 3; ++column_idx) {
+                i32 number = dist(rng);
+                data_block->AppendValue(column_idx, type == LogicalType::kBigInt ? Value::MakeBigInt(number) : Value::MakeDouble(number / 16.0));
+            }
+        }
+        data_block->Finalize();
+        blocks.push_back(std::move(data_block));
+    }
+    return blocks;
+}
+
+static void
+Benchmark(const String &name, const SharedPtr<BaseExpression> &expr, const Vector<SharedPtr<DataBlock>> &blocks, SizeT rounds, bool fuse) {
+    ExpressionState::enable_expression_fusion_ = fuse;
+    SharedPtr<ExpressionState> state = ExpressionState::CreateState(expr);
+    ExpressionState::enable_expression_fusion_ = true;
+    ExpressionEvaluator evaluator;
+    u64 checksum = 0;
+    BaseProfiler profiler;
+    profiler.Begin();
+    for (SizeT round = 0; round < rounds; ++round) {
+        for (const auto &block : blocks) {
+            evaluator.Init(block.get());
+            SharedPtr<ColumnVector> &output = state->OutputColumnVector();
+            evaluator.Execute(expr, state, output);
+            checksum += output->data()[0];
+        }
+    }
+    profiler.End();
+
+    double seconds = profiler.Elapsed() / 1e9;
+    double rows = 1.0 * DEFAULT_VECTOR_SIZE * blocks.size() * rounds;
+    std::cout << name << (fuse ? " fused: " : " node by node: ") << rows / seconds / 1e6 << " M rows/s, "
+              << (state->fused_expression_ ? "fused kernel" : "no fused kernel") << ", checksum " << checksum << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    SizeT block_count = 128;
+    SizeT rounds = 100;
+    if (argc > 1) {
+        block_count = std::stoull(argv[1]);
+    }
+    if (argc > 2) {
+        rounds = std::stoull(argv[2]);
+    }
+    catalog = MakeUnique<Catalog>(MakeShared<String>("/tmp/infinity/data"));
+    RegisterAddFunction(catalog);
+    RegisterSubtractFunction(catalog);
+    RegisterMulFunction(catalog);
+    RegisterGreaterFunction(catalog);
+    std::cout << "fused expression benchmark, blocks: " << block_count << ", rows per block: " << DEFAULT_VECTOR_SIZE << ", rounds: " << rounds
+              << std::endl;
+
+    {
+        auto blocks = GenerateBlocks(LogicalType::kBigInt, block_count);
+        auto c0 = ReferenceExpression::Make(DataType(LogicalType::kBigInt), "t1", "c0", String(), 0);
+        auto c1 = ReferenceExpression::Make(DataType(LogicalType::kBigInt), "t1", "c1", String(), 1);
+        auto c2 = ReferenceExpression::Make(DataType(LogicalType::kBigInt), "t1", "c2", String(), 2);
+        auto two = MakeShared<ValueExpression>(Value::MakeBigInt(2));
+        auto expr = MakeFunction(">", MakeFunction("+", MakeFunction("*", c0, two), c1), c2);
+        Benchmark("c0 * 2 + c1 > c2 (BigInt)", expr, blocks, rounds, false);
+        Benchmark("c0 * 2 + c1 > c2 (BigInt)", expr, blocks, rounds, true);
+    }
+    {
+        auto blocks = GenerateBlocks(LogicalType::kDouble, block_count);
+        auto c0 = ReferenceExpression::Make(DataType(LogicalType::kDouble), "t1", "c0", String(), 0);
+        auto c1 = ReferenceExpression::Make(DataType(LogicalType::kDouble), "t1", "c1", String(), 1);
+        auto constant = MakeShared<ValueExpression>(Value::MakeDouble(3.5));
+        auto expr = MakeFunction("*", MakeFunction("-", c0, constant), c1);
+        Benchmark("(c0 - 3.5) * c1 (Double)", expr, blocks, rounds, false);
+        Benchmark("(c0 - 3.5) * c1 (Double)", expr, blocks, rounds, true);
+    }
+    return 0;
+}
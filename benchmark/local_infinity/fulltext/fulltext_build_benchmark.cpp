@@ -0,0 +1,126 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "base_profiler.h"
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <sys/resource.h>
+
+import stl;
+import third_party;
+import memory_pool;
+import index_defines;
+import column_vector;
+import data_type;
+import logical_type;
+import value;
+import internal_types;
+import memory_indexer;
+import segment_index_entry;
+import local_file_system;
+import column_length_io;
+import default_values;
+
+using namespace infinity;
+
+// Builds the full-text index of a synthetic segment the way SegmentIndexEntry::PopulateEntirely does, i.e. offline Insert + Commit per
+// block and a final Dump, under a given memory budget. Run it once per budget, since the peak RSS reported is the one of the process.
+// Usage: fulltext_build_benchmark [doc_count] [memory_budget_mb] [thread_num]
+
+static Vector<SharedPtr<ColumnVector>> GenerateBlocks(SizeT doc_count) {
+    constexpr SizeT vocabulary_size = 100000;
+    constexpr SizeT words_per_doc = 64;
+    std::mt19937 rng(42);
+    // Zipf-like term distribution: a few very frequent terms and a long tail
+    Vector<double> weights(vocabulary_size);
+    for (SizeT i = 0; i < vocabulary_size; ++i) {
+        weights[i] = 1.0 / (i + 1);
+    }
+    std::discrete_distribution<SizeT> word_dist(weights.begin(), weights.end());
+
+    Vector<SharedPtr<ColumnVector>> blocks;
+    for (SizeT offset = 0; offset < doc_count; offset += DEFAULT_BLOCK_CAPACITY) {
+        SizeT row_count = std::min<SizeT>(DEFAULT_BLOCK_CAPACITY, doc_count - offset);
+        auto column = ColumnVector::Make(MakeShared<DataType>(LogicalType::kVarchar));
+        column->Initialize();
+        for (SizeT i = 0; i < row_count; ++i) {
+            String doc;
+            for (SizeT j = 0; j < words_per_doc; ++j) {
+                doc += "w" + std::to_string(word_dist(rng)) + " ";
+            }
+            Value v = Value::MakeVarchar(doc);
+            column->AppendValue(v);
+        }
+        blocks.push_back(std::move(column));
+    }
+    return blocks;
+}
+
+int main(int argc, char *argv[]) {
+    SizeT doc_count = 1'000'000;
+    SizeT memory_budget = DEFAULT_FULL_TEXT_BUILD_MEMORY_BUDGET;
+    SizeT thread_num = 4;
+    if (argc > 1) {
+        doc_count = std::stoull(argv[1]);
+    }
+    if (argc > 2) {
+        memory_budget = std::stoull(argv[2]) * MB;
+    }
+    if (argc > 3) {
+        thread_num = std::stoull(argv[3]);
+    }
+
+    String index_dir = "/tmp/infinity/fulltext_build_benchmark";
+    std::system(("rm -rf " + index_dir + " && mkdir -p " + index_dir).c_str());
+
+    BaseProfiler profiler;
+    profiler.Begin();
+    Vector<SharedPtr<ColumnVector>> blocks = GenerateBlocks(doc_count);
+    profiler.End();
+    std::cout << "generated " << doc_count << " docs in " << blocks.size() << " blocks, cost " << profiler.ElapsedToString() << std::endl;
+
+    MemoryPool byte_slice_pool;
+    RecyclePool buffer_pool;
+    ThreadPool thread_pool(thread_num);
+    auto fake_segment_index_entry = SegmentIndexEntry::CreateFakeEntry();
+    String base_name = "chunk_benchmark";
+    String column_length_file_path = index_dir + "/" + base_name + LENGTH_SUFFIX;
+    auto column_length_file_handler =
+        MakeShared<FullTextColumnLengthFileHandler>(MakeUnique<LocalFileSystem>(), column_length_file_path, fake_segment_index_entry.get());
+
+    profiler.Begin();
+    {
+        MemoryIndexer indexer(index_dir, base_name, RowID(0U, 0U), OPTION_FLAG_ALL, "standard", byte_slice_pool, buffer_pool, thread_pool, memory_budget);
+        for (auto &block : blocks) {
+            indexer.Insert(block, 0, block->Size(), column_length_file_handler, true);
+            indexer.Commit(true);
+        }
+        column_length_file_handler.reset();
+        profiler.End();
+        std::cout << "invert and spill cost " << profiler.ElapsedToString() << std::endl;
+        profiler.Begin();
+        indexer.Dump(true);
+    }
+    profiler.End();
+    std::cout << "merge and dump cost " << profiler.ElapsedToString() << std::endl;
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    std::cout << "memory budget " << memory_budget / MB << " MB, threads " << thread_num << ", peak RSS " << usage.ru_maxrss / 1024 << " MB"
+              << std::endl;
+
+    std::system(("rm -rf " + index_dir).c_str());
+    return 0;
+}
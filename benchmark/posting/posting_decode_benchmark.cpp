@@ -0,0 +1,98 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "base_profiler.h"
+#include <iostream>
+#include <random>
+
+import stl;
+import byte_slice_reader;
+import byte_slice_writer;
+import posting_field;
+import index_defines;
+
+using namespace infinity;
+
+// Decodes the doc-id/tf blocks of a single hot term, the way SkipIndexDecoder walks a posting list
+// during a full traversal, and compares the default codec against the SIMD block-of-128 format.
+
+static void GeneratePosting(SizeT doc_count, Vector<u32> &doc_deltas, Vector<u32> &tfs) {
+    std::mt19937 rng(42);
+    // hot term: appears in about one of every three documents
+    std::geometric_distribution<u32> delta_dist(0.3);
+    std::geometric_distribution<u32> tf_dist(0.6);
+    doc_deltas.resize(doc_count);
+    tfs.resize(doc_count);
+    for (SizeT i = 0; i < doc_count; ++i) {
+        doc_deltas[i] = delta_dist(rng) + 1;
+        tfs[i] = tf_dist(rng) + 1;
+    }
+}
+
+template <typename Encoder>
+static void Benchmark(const String &name, const Encoder *encoder, const Vector<u32> &doc_deltas, const Vector<u32> &tfs, SizeT rounds) {
+    ByteSliceWriter writer;
+    SizeT doc_count = doc_deltas.size();
+    for (SizeT offset = 0; offset < doc_count; offset += MAX_DOC_PER_RECORD) {
+        u32 len = std::min<SizeT>(MAX_DOC_PER_RECORD, doc_count - offset);
+        encoder->Encode(writer, doc_deltas.data() + offset, len);
+        encoder->Encode(writer, tfs.data() + offset, len);
+    }
+
+    u32 doc_buffer[MAX_DOC_PER_RECORD];
+    u32 tf_buffer[MAX_DOC_PER_RECORD];
+    u64 checksum = 0;
+    BaseProfiler profiler;
+    profiler.Begin();
+    for (SizeT round = 0; round < rounds; ++round) {
+        ByteSliceReader reader(writer.GetByteSliceList());
+        docid_t doc_id = 0;
+        for (SizeT decoded = 0; decoded < doc_count;) {
+            u32 len = encoder->Decode(doc_buffer, MAX_DOC_PER_RECORD, reader);
+            encoder->Decode(tf_buffer, MAX_DOC_PER_RECORD, reader);
+            for (u32 i = 0; i < len; ++i) {
+                doc_id += doc_buffer[i];
+                checksum += doc_id ^ tf_buffer[i];
+            }
+            decoded += len;
+        }
+    }
+    profiler.End();
+
+    double seconds = profiler.Elapsed() / 1e9;
+    double decoded_ints = 2.0 * doc_count * rounds;
+    double decoded_bytes = decoded_ints * sizeof(u32);
+    std::cout << name << ": encoded " << writer.GetSize() << " bytes (" << 8.0 * writer.GetSize() / (2.0 * doc_count) << " bits/int), "
+              << decoded_ints / seconds / 1e6 << " M ints/s, " << decoded_bytes / seconds / (1 << 30) << " GiB/s decoded, checksum " << checksum
+              << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    SizeT doc_count = 10'000'000;
+    SizeT rounds = 10;
+    if (argc > 1) {
+        doc_count = std::stoull(argv[1]);
+    }
+    if (argc > 2) {
+        rounds = std::stoull(argv[2]);
+    }
+    Vector<u32> doc_deltas;
+    Vector<u32> tfs;
+    GeneratePosting(doc_count, doc_deltas, tfs);
+    std::cout << "posting decode benchmark, docs: " << doc_count << ", rounds: " << rounds << std::endl;
+
+    Benchmark("default(SIMDBitPacking)", GetDocIDEncoder(), doc_deltas, tfs, rounds);
+    Benchmark("simd_block", GetSIMDBlockEncoder(), doc_deltas, tfs, rounds);
+    return 0;
+}
@@ -0,0 +1,150 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "base_profiler.h"
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+import stl;
+import infinity_context;
+import storage;
+import txn_manager;
+import txn;
+import table_def;
+import column_def;
+import data_type;
+import logical_type;
+import data_block;
+import value;
+import extra_ddl_info;
+import statement_common;
+import status;
+
+using namespace infinity;
+
+// Throughput of short transactions committed concurrently: each thread begins and commits transactions in a loop,
+// either read only ones, which only go through the txn manager, or single row inserts, which also go through the wal.
+// A background thread polls the min unflushed ts the way the periodic checkpoint and cleanup triggers do.
+// Usage: txn_manager_benchmark [readonly|insert] [txn_per_thread] [max_thread_num]
+
+static const String bench_dir = "/tmp/infinity/txn_manager_benchmark";
+
+static SharedPtr<String> WriteConfig() {
+    String config_path = bench_dir + "/infinity_conf.toml";
+    std::ofstream ofs(config_path);
+    ofs << "[general]\n"
+           "version = \"0.1.0\"\n"
+           "timezone = \"utc-8\"\n"
+           "[log]\n"
+           "log_dir = \""
+        << bench_dir
+        << "/log\"\n"
+           "log_level = \"warning\"\n"
+           "[storage]\n"
+           "data_dir = \""
+        << bench_dir
+        << "/data\"\n"
+           "[buffer]\n"
+           "temp_dir = \""
+        << bench_dir
+        << "/temp\"\n"
+           "[wal]\n"
+           "wal_dir = \""
+        << bench_dir
+        << "/wal\"\n"
+           "flush_at_commit = \"only_write\"\n";
+    return MakeShared<String>(config_path);
+}
+
+static void RunTxns(TxnManager *txn_mgr, bool insert, SizeT thread_id, SizeT txn_count) {
+    Vector<SharedPtr<DataType>> column_types{MakeShared<DataType>(LogicalType::kBigInt)};
+    for (SizeT t = 0; t < txn_count; ++t) {
+        auto *txn = txn_mgr->BeginTxn();
+        if (insert) {
+            auto input_block = MakeShared<DataBlock>();
+            input_block->Init(column_types, 1);
+            input_block->AppendValue(0, Value::MakeBigInt(thread_id * txn_count + t));
+            input_block->Finalize();
+            txn->Append("default", "tbl", input_block);
+        }
+        txn_mgr->CommitTxn(txn);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    bool insert = false;
+    SizeT txn_per_thread = 100'000;
+    SizeT max_thread_num = Thread::hardware_concurrency();
+    if (argc > 1) {
+        insert = String(argv[1]) == "insert";
+    }
+    if (argc > 2) {
+        txn_per_thread = std::stoull(argv[2]);
+    }
+    if (argc > 3) {
+        max_thread_num = std::stoull(argv[3]);
+    }
+    max_thread_num = std::max<SizeT>(1, max_thread_num);
+
+    std::system(("rm -rf " + bench_dir + " && mkdir -p " + bench_dir).c_str());
+    InfinityContext::instance().Init(WriteConfig());
+    TxnManager *txn_mgr = InfinityContext::instance().storage()->txn_manager();
+
+    if (insert) {
+        Vector<SharedPtr<ColumnDef>> columns;
+        columns.push_back(MakeShared<ColumnDef>(0, MakeShared<DataType>(LogicalType::kBigInt), "c1", HashSet<ConstraintType>()));
+        auto table_def = TableDef::Make(MakeShared<String>("default"), MakeShared<String>("tbl"), columns);
+        auto *txn = txn_mgr->BeginTxn();
+        Status status = txn->CreateTable("default", std::move(table_def), ConflictType::kError);
+        if (!status.ok()) {
+            std::cerr << "create table failed: " << status.message() << std::endl;
+            return 1;
+        }
+        txn_mgr->CommitTxn(txn);
+    }
+
+    std::cout << (insert ? "insert" : "readonly") << " txns, " << txn_per_thread << " per thread" << std::endl;
+    for (SizeT thread_num = 1; thread_num <= max_thread_num; thread_num *= 2) {
+        Atomic<bool> stop_poll{false};
+        u64 poll_count = 0;
+        Thread poll_thread([&] {
+            while (!stop_poll.load()) {
+                txn_mgr->GetMinUnflushedTS();
+                ++poll_count;
+            }
+        });
+
+        BaseProfiler profiler;
+        profiler.Begin();
+        Vector<Thread> threads;
+        for (SizeT i = 0; i < thread_num; ++i) {
+            threads.emplace_back(RunTxns, txn_mgr, insert, i, txn_per_thread);
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        profiler.End();
+        stop_poll.store(true);
+        poll_thread.join();
+
+        double seconds = profiler.Elapsed() / 1e9;
+        std::cout << "threads: " << thread_num << ", " << thread_num * txn_per_thread / seconds << " txn/s, cost " << profiler.ElapsedToString()
+                  << ", min ts polls: " << poll_count << std::endl;
+    }
+
+    InfinityContext::instance().UnInit();
+    std::system(("rm -rf " + bench_dir).c_str());
+    return 0;
+}
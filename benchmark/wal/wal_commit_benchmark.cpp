@@ -0,0 +1,196 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "base_profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+import stl;
+import wal_entry;
+import wal_entry_blocking_queue;
+import wal_file_writer;
+import internal_types;
+import default_values;
+
+using namespace infinity;
+
+// Commit latency and throughput of the wal writer, with the flush loop of WalManager::Flush reproduced around the real
+// WALEntryBlockingQueue and WalFileWriter. Each client commits one transaction (a delete of `rows_per_txn` rows) at a
+// time and waits until its entry is durable.
+// Modes:
+//   sync_each       one write and one fdatasync per entry, i.e. durability without group commit
+//   group           one write and one fdatasync per drained batch
+//   group_adaptive  group, plus the batch window used by WalManager for FlushOption::kFlushAtOnce
+//   only_write      one write per drained batch, no sync
+// Usage: wal_commit_benchmark [client_num] [txn_per_client] [rows_per_txn] [mode]
+
+enum class Mode { kSyncEach, kGroup, kGroupAdaptive, kOnlyWrite };
+
+struct Client {
+    Atomic<u64> durable_count_{0};
+    Vector<i64> latencies_ns_{};
+};
+
+static void FlushLoop(Mode mode, WALEntryBlockingQueue &queue, WalFileWriter &writer, Vector<UniquePtr<Client>> &clients, SizeT &batch_count) {
+    Deque<WalEntry *> log_batch;
+    i64 sync_cost_us = 0;
+    SizeT last_batch_size = 0;
+    while (true) {
+        if (mode == Mode::kSyncEach) {
+            WalEntry *entry = nullptr;
+            queue.Dequeue(entry);
+            log_batch.push_back(entry);
+        } else {
+            SizeT min_batch_size = 0;
+            std::chrono::microseconds window(0);
+            if (mode == Mode::kGroupAdaptive && last_batch_size > 1) {
+                min_batch_size = last_batch_size;
+                window = std::chrono::microseconds(std::min<i64>(sync_cost_us / 2, WAL_GROUP_COMMIT_MAX_WINDOW_US));
+            }
+            queue.DequeueBulk(log_batch, min_batch_size, window);
+        }
+        bool stop = false;
+        SizeT write_count = 0;
+        for (const auto &entry : log_batch) {
+            if (entry == nullptr) {
+                stop = true;
+                break;
+            }
+            char *const buf = writer.Reserve(entry->GetSizeInBytes());
+            char *ptr = buf;
+            entry->WriteAdv(ptr);
+            writer.Commit(ptr - buf);
+            ++write_count;
+        }
+        writer.FlushBuffer();
+        if (mode != Mode::kOnlyWrite) {
+            auto begin = std::chrono::steady_clock::now();
+            writer.Sync();
+            i64 cost = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count();
+            sync_cost_us = (sync_cost_us * 7 + cost) / 8;
+        }
+        for (SizeT i = 0; i < write_count; ++i) {
+            Client &client = *clients[log_batch[i]->txn_id_];
+            client.durable_count_.fetch_add(1);
+            client.durable_count_.notify_one();
+        }
+        if (write_count > 0) {
+            ++batch_count;
+        }
+        last_batch_size = log_batch.size();
+        log_batch.clear();
+        if (stop) {
+            break;
+        }
+    }
+}
+
+static void Benchmark(Mode mode, const String &name, SizeT client_num, SizeT txn_per_client, SizeT rows_per_txn, const String &wal_path) {
+    std::system(("rm -f " + wal_path).c_str());
+    WALEntryBlockingQueue queue;
+    WalFileWriter writer;
+    writer.Open(wal_path);
+
+    Vector<UniquePtr<Client>> clients;
+    for (SizeT i = 0; i < client_num; ++i) {
+        clients.push_back(MakeUnique<Client>());
+    }
+    SizeT batch_count = 0;
+    Thread flush_thread([&] { FlushLoop(mode, queue, writer, clients, batch_count); });
+
+    BaseProfiler profiler;
+    profiler.Begin();
+    Vector<Thread> client_threads;
+    for (SizeT client_id = 0; client_id < client_num; ++client_id) {
+        client_threads.emplace_back([&, client_id] {
+            Client &client = *clients[client_id];
+            Vector<RowID> row_ids;
+            for (SizeT i = 0; i < rows_per_txn; ++i) {
+                row_ids.emplace_back(client_id, i);
+            }
+            WalEntry entry;
+            entry.txn_id_ = client_id;
+            entry.cmds_.push_back(MakeShared<WalCmdDelete>("db", "tbl", row_ids));
+            for (SizeT txn = 0; txn < txn_per_client; ++txn) {
+                auto begin = std::chrono::steady_clock::now();
+                entry.commit_ts_ = txn;
+                queue.Enqueue(&entry, nullptr);
+                for (u64 durable = client.durable_count_.load(); durable <= txn; durable = client.durable_count_.load()) {
+                    client.durable_count_.wait(durable);
+                }
+                client.latencies_ns_.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count());
+            }
+        });
+    }
+    for (auto &client_thread : client_threads) {
+        client_thread.join();
+    }
+    profiler.End();
+    queue.Enqueue(nullptr, nullptr);
+    flush_thread.join();
+    u64 file_size = writer.FileSize();
+    writer.Close(false);
+
+    Vector<i64> latencies;
+    for (auto &client : clients) {
+        latencies.insert(latencies.end(), client->latencies_ns_.begin(), client->latencies_ns_.end());
+    }
+    std::sort(latencies.begin(), latencies.end());
+    SizeT txn_count = latencies.size();
+    double seconds = profiler.Elapsed() / 1e9;
+    std::cout << name << ": " << txn_count / seconds << " txn/s, " << file_size / seconds / (1 << 20) << " MiB/s, avg batch "
+              << double(txn_count) / std::max<SizeT>(batch_count, 1) << ", latency p50 " << latencies[txn_count / 2] / 1000 << " us, p99 "
+              << latencies[txn_count * 99 / 100] / 1000 << " us, max " << latencies.back() / 1000 << " us" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    SizeT client_num = 16;
+    SizeT txn_per_client = 1000;
+    SizeT rows_per_txn = 16;
+    String mode = "all";
+    if (argc > 1) {
+        client_num = std::stoull(argv[1]);
+    }
+    if (argc > 2) {
+        txn_per_client = std::stoull(argv[2]);
+    }
+    if (argc > 3) {
+        rows_per_txn = std::stoull(argv[3]);
+    }
+    if (argc > 4) {
+        mode = argv[4];
+    }
+
+    String wal_dir = "/tmp/infinity/wal_commit_benchmark";
+    std::system(("rm -rf " + wal_dir + " && mkdir -p " + wal_dir).c_str());
+    String wal_path = wal_dir + "/" + String(WAL_FILE_TEMP_FILE);
+    std::cout << "wal commit benchmark, clients: " << client_num << ", txns per client: " << txn_per_client << ", rows per txn: " << rows_per_txn
+              << std::endl;
+
+    Vector<Pair<Mode, String>> modes{{Mode::kSyncEach, "sync_each"},
+                                     {Mode::kGroup, "group"},
+                                     {Mode::kGroupAdaptive, "group_adaptive"},
+                                     {Mode::kOnlyWrite, "only_write"}};
+    for (const auto &[m, name] : modes) {
+        if (mode == "all" || mode == name) {
+            Benchmark(m, name, client_num, txn_per_client, rows_per_txn, wal_path);
+        }
+    }
+
+    std::system(("rm -rf " + wal_dir).c_str());
+    return 0;
+}
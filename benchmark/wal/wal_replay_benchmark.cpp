@@ -0,0 +1,141 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "base_profiler.h"
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+import stl;
+import infinity_context;
+import storage;
+import txn_manager;
+import txn;
+import table_def;
+import column_def;
+import data_type;
+import logical_type;
+import data_block;
+import value;
+import extra_ddl_info;
+import statement_common;
+import status;
+
+using namespace infinity;
+
+// Recovery time after a crash: fills the wal with appends spread over several tables without any checkpoint after
+// the initial one, stops without checkpointing, and measures the restart, which replays the whole wal.
+// Usage: wal_replay_benchmark [txn_count] [rows_per_txn] [table_count]
+
+static const String bench_dir = "/tmp/infinity/wal_replay_benchmark";
+
+static SharedPtr<String> WriteConfig() {
+    String config_path = bench_dir + "/infinity_conf.toml";
+    std::ofstream ofs(config_path);
+    ofs << "[general]\n"
+           "version = \"0.1.0\"\n"
+           "timezone = \"utc-8\"\n"
+           "[log]\n"
+           "log_dir = \""
+        << bench_dir
+        << "/log\"\n"
+           "log_level = \"warning\"\n"
+           "[storage]\n"
+           "data_dir = \""
+        << bench_dir
+        << "/data\"\n"
+           "[buffer]\n"
+           "temp_dir = \""
+        << bench_dir
+        << "/temp\"\n"
+           "[wal]\n"
+           "wal_dir = \""
+        << bench_dir
+        << "/wal\"\n"
+           "full_checkpoint_interval_sec = 0\n"
+           "delta_checkpoint_interval_sec = 0\n"
+           "delta_checkpoint_interval_wal_bytes = 1099511627776\n"
+           "wal_file_size_threshold = \"1GB\"\n";
+    return MakeShared<String>(config_path);
+}
+
+static void GenerateWal(const SharedPtr<String> &config_path, SizeT txn_count, SizeT rows_per_txn, SizeT table_count) {
+    InfinityContext::instance().Init(config_path);
+    TxnManager *txn_mgr = InfinityContext::instance().storage()->txn_manager();
+
+    Vector<SharedPtr<ColumnDef>> columns;
+    columns.push_back(MakeShared<ColumnDef>(0, MakeShared<DataType>(LogicalType::kBigInt), "c1", HashSet<ConstraintType>()));
+    columns.push_back(MakeShared<ColumnDef>(1, MakeShared<DataType>(LogicalType::kDouble), "c2", HashSet<ConstraintType>()));
+    for (SizeT i = 0; i < table_count; ++i) {
+        auto table_def = TableDef::Make(MakeShared<String>("default"), MakeShared<String>("tbl" + std::to_string(i)), columns);
+        auto *txn = txn_mgr->BeginTxn();
+        Status status = txn->CreateTable("default", std::move(table_def), ConflictType::kError);
+        if (!status.ok()) {
+            std::cerr << "create table failed: " << status.message() << std::endl;
+            std::exit(1);
+        }
+        txn_mgr->CommitTxn(txn);
+    }
+
+    Vector<SharedPtr<DataType>> column_types{MakeShared<DataType>(LogicalType::kBigInt), MakeShared<DataType>(LogicalType::kDouble)};
+    for (SizeT t = 0; t < txn_count; ++t) {
+        auto input_block = MakeShared<DataBlock>();
+        input_block->Init(column_types, rows_per_txn);
+        for (SizeT i = 0; i < rows_per_txn; ++i) {
+            input_block->AppendValue(0, Value::MakeBigInt(t * rows_per_txn + i));
+            input_block->AppendValue(1, Value::MakeDouble(double(i)));
+        }
+        input_block->Finalize();
+        auto *txn = txn_mgr->BeginTxn();
+        txn->Append("default", "tbl" + std::to_string(t % table_count), input_block);
+        txn_mgr->CommitTxn(txn);
+    }
+    // Stop without checkpoint, all the appends stay in the wal only
+    InfinityContext::instance().UnInit();
+}
+
+int main(int argc, char *argv[]) {
+    SizeT txn_count = 100'000;
+    SizeT rows_per_txn = 64;
+    SizeT table_count = 8;
+    if (argc > 1) {
+        txn_count = std::stoull(argv[1]);
+    }
+    if (argc > 2) {
+        rows_per_txn = std::stoull(argv[2]);
+    }
+    if (argc > 3) {
+        table_count = std::max<SizeT>(1, std::stoull(argv[3]));
+    }
+    std::system(("rm -rf " + bench_dir + " && mkdir -p " + bench_dir).c_str());
+    SharedPtr<String> config_path = WriteConfig();
+
+    BaseProfiler profiler;
+    profiler.Begin();
+    GenerateWal(config_path, txn_count, rows_per_txn, table_count);
+    profiler.End();
+    std::cout << "wrote " << txn_count << " txns of " << rows_per_txn << " rows into " << table_count << " tables, cost "
+              << profiler.ElapsedToString() << std::endl;
+    std::system(("du -sh " + bench_dir + "/wal").c_str());
+
+    profiler.Begin();
+    InfinityContext::instance().Init(config_path);
+    profiler.End();
+    std::cout << "recovery cost " << profiler.ElapsedToString() << std::endl;
+    InfinityContext::instance().UnInit();
+
+    std::system(("rm -rf " + bench_dir).c_str());
+    return 0;
+}
@@ -710,6 +710,31 @@ class TestIndex:
             res = table_obj.show_index("my_index_" + str(i))
             print(res)
 
+    @pytest.mark.parametrize("posting_format", ["default", "simd_block"])
+    def test_show_fulltext_index_posting_format(self, get_infinity_db, posting_format):
+        db_obj = get_infinity_db
+        db_obj.drop_table("test_show_fulltext_index_posting_format", ConflictType.Ignore)
+        table_obj = db_obj.create_table(
+            "test_show_fulltext_index_posting_format",
+            {"doctitle": "varchar", "body": "varchar"}, ConflictType.Error)
+        assert table_obj is not None
+        res = table_obj.create_index("my_index",
+                                     [index.IndexInfo("body",
+                                                      index.IndexType.FullText,
+                                                      [
+                                                          index.InitParameter(
+                                                              "analyzer", "standard"),
+                                                          index.InitParameter(
+                                                              "posting_format", posting_format)
+                                                      ])], ConflictType.Error)
+        assert res.error_code == ErrorCode.OK
+        res = table_obj.show_index("my_index")
+        assert res.error_code == ErrorCode.OK
+        assert res.other_parameters == "analyzer = standard, posting_format = " + posting_format
+
+        res = db_obj.drop_table("test_show_fulltext_index_posting_format", ConflictType.Error)
+        assert res.error_code == ErrorCode.OK
+
     @pytest.mark.parametrize("index_name", ["my_index"])
     def test_show_valid_name_index(self, get_infinity_db, index_name):
         db_obj = get_infinity_db
@@ -43,6 +43,9 @@ public:
             return AnalyzeImpl(input, &array, &Analyzer::AppendTermList);
     }
 
+    // Folds a term pattern, e.g. "Foo*", the way the terms are folded when they are analyzed, without tokenizing it.
+    virtual void Normalize(String &text) {}
+
 protected:
     typedef void (
         *HookType)(void *data, const char *text, const u32 len, const u32 offset, const u8 and_or_bit, const u8 level, const bool is_special_char);
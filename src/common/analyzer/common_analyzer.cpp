@@ -26,6 +26,13 @@ module common_analyzer;
 namespace infinity {
 constexpr int MAX_TUPLE_LENGTH = 1024;
 
+void CommonLanguageAnalyzer::Normalize(String &text) {
+    // case sensitive analyzers keep the original terms, so that they are matched as is
+    if (!case_sensitive_) {
+        ToLower(text.data(), text.size());
+    }
+}
+
 CommonLanguageAnalyzer::CommonLanguageAnalyzer()
     : Analyzer(), lowercase_string_buffer_(term_string_buffer_limit_), stemmer_(MakeUnique<Stemmer>()), case_sensitive_(false), contain_lower_(false),
       extract_eng_stem_(true), extract_synonym_(false), chinese_(false), remove_stopwords_(false) {
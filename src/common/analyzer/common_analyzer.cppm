@@ -40,6 +40,8 @@ public:
 
     bool IsRemoveStopwords() { return remove_stopwords_; }
 
+    void Normalize(String &text) override;
+
 protected:
     int AnalyzeImpl(const Term &input, void *data, HookType func) override;
     /// Parse given input
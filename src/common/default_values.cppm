@@ -90,6 +90,17 @@ export {
     constexpr SizeT FULL_CHECKPOINT_INTERVAL_SEC = 30;          // 30 seconds
     constexpr SizeT DELTA_CHECKPOINT_INTERVAL_SEC = 5;         // 5 seconds
     constexpr SizeT DELTA_CHECKPOINT_INTERVAL_WAL_BYTES = 64 * 1024;
+    constexpr SizeT WAL_SYNC_INTERVAL_MS = 1000;               // kFlushPerSecond
+    constexpr SizeT WAL_GROUP_COMMIT_MAX_WINDOW_US = 1000;     // longest wait for a wal batch to grow before sync
+    constexpr SizeT WAL_REPLAY_MAX_THREAD_NUM = 16;
+    constexpr SizeT CATALOG_LOAD_MAX_THREAD_NUM = 16;
+    constexpr SizeT DEFAULT_CHECKPOINT_IO_THREAD_NUM = 4;
+    constexpr SizeT DEFAULT_DELTA_CHECKPOINT_COMPACT_THRESHOLD = 16;
+    constexpr SizeT DEFAULT_READ_AHEAD_DEPTH = 2;              // blocks loaded ahead of a table scan
+    constexpr SizeT DEFAULT_READ_AHEAD_THREAD_NUM = 4;
+    constexpr SizeT READ_AHEAD_MEMORY_FRACTION = 4;            // read ahead pins at most 1/4 of the buffer pool
+    constexpr SizeT SHORT_QUERY_BLOCK_COUNT = 4;               // queries scanning at most these blocks run with high priority
+    constexpr SizeT HIGH_PRIORITY_TASK_QUOTA = 8;              // high priority tasks a worker runs in a row while normal ones wait
     constexpr std::string_view WAL_FILE_TEMP_FILE = "wal.log";
     constexpr std::string_view WAL_FILE_PREFIX = "wal.log";
     constexpr std::string_view CATALOG_FILE_DIR = "catalog";
@@ -117,6 +128,17 @@ export {
 
     // default query option parameter
     constexpr u32 DEFAULT_FULL_TEXT_OPTION_TOP_N = 100;
+
+    // memory budget of sorted runs held by an offline full-text index build
+    constexpr SizeT DEFAULT_FULL_TEXT_BUILD_MEMORY_BUDGET = 256 * MB;
+    constexpr SizeT MIN_FULL_TEXT_MERGE_BUFFER_PER_RUN = 64 * KB;
+
+    // background merge of full-text chunk indexes
+    constexpr SizeT DEFAULT_FULL_TEXT_MERGE_FACTOR = 4;
+    constexpr SizeT DEFAULT_FULL_TEXT_MAX_CHUNKS_PER_SEGMENT = 8;
+    constexpr u32 DEFAULT_FULL_TEXT_MERGE_TIER_BASE = DEFAULT_BLOCK_CAPACITY;
+    constexpr SizeT DEFAULT_OPTIMIZE_INTERVAL_SEC = 0;
+    constexpr SizeT DEFAULT_OPTIMIZE_IO_BYTES_PER_SEC = 64 * MB;
 }
 
 // constexpr SizeT DEFAULT_BUFFER_SIZE = 8192;
@@ -0,0 +1,130 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+module;
+
+#include <atomic>
+#include <type_traits>
+
+export module work_stealing_deque;
+
+import stl;
+
+namespace infinity {
+
+// Lock-free work stealing deque (Chase-Lev, with the memory orders of Le et al. for weak memory models).
+// Only the owner thread calls Push and Pop, on the bottom end. Any other thread calls Steal, on the top end.
+export template <typename T>
+    requires std::is_trivially_copyable_v<T>
+class WorkStealingDeque {
+public:
+    explicit WorkStealingDeque(SizeT capacity = 64) {
+        SizeT power_of_two = 1;
+        while (power_of_two < capacity) {
+            power_of_two <<= 1;
+        }
+        buffers_.emplace_back(MakeUnique<Buffer>(power_of_two));
+        buffer_.store(buffers_.back().get(), std::memory_order_relaxed);
+    }
+
+    WorkStealingDeque(const WorkStealingDeque &) = delete;
+    WorkStealingDeque &operator=(const WorkStealingDeque &) = delete;
+
+    // Owner only.
+    void Push(T item) {
+        i64 bottom = bottom_.load(std::memory_order_relaxed);
+        i64 top = top_.load(std::memory_order_acquire);
+        Buffer *buffer = buffer_.load(std::memory_order_relaxed);
+        if (bottom - top >= (i64)buffer->capacity_) {
+            buffer = Grow(buffer, top, bottom);
+        }
+        buffer->Put(bottom, item);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+    }
+
+    // Owner only, takes the item pushed last.
+    bool Pop(T &item) {
+        i64 bottom = bottom_.load(std::memory_order_relaxed) - 1;
+        Buffer *buffer = buffer_.load(std::memory_order_relaxed);
+        bottom_.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        i64 top = top_.load(std::memory_order_relaxed);
+        if (top > bottom) {
+            // empty
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+            return false;
+        }
+        item = buffer->Get(bottom);
+        if (top == bottom) {
+            // the last item, race with the thieves for it
+            bool won = top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    // Any thread, takes the item pushed first. Fails when empty or when another thread took the item first.
+    bool Steal(T &item) {
+        i64 top = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        i64 bottom = bottom_.load(std::memory_order_acquire);
+        if (top >= bottom) {
+            return false;
+        }
+        Buffer *buffer = buffer_.load(std::memory_order_acquire);
+        item = buffer->Get(top);
+        return top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    }
+
+    // A snapshot, may be stale by the time it is used.
+    [[nodiscard]] bool Empty() const {
+        i64 bottom = bottom_.load(std::memory_order_relaxed);
+        i64 top = top_.load(std::memory_order_relaxed);
+        return top >= bottom;
+    }
+
+private:
+    struct Buffer {
+        explicit Buffer(SizeT capacity) : capacity_(capacity), items_(MakeUnique<Atomic<T>[]>(capacity)) {}
+
+        T Get(i64 idx) const { return items_[idx & (capacity_ - 1)].load(std::memory_order_relaxed); }
+
+        void Put(i64 idx, T item) { items_[idx & (capacity_ - 1)].store(item, std::memory_order_relaxed); }
+
+        const SizeT capacity_;
+        UniquePtr<Atomic<T>[]> items_;
+    };
+
+    // A thief may still read the old buffer, it is kept until the deque is destroyed.
+    Buffer *Grow(Buffer *buffer, i64 top, i64 bottom) {
+        auto new_buffer = MakeUnique<Buffer>(buffer->capacity_ * 2);
+        for (i64 idx = top; idx < bottom; ++idx) {
+            new_buffer->Put(idx, buffer->Get(idx));
+        }
+        buffers_.emplace_back(std::move(new_buffer));
+        buffer_.store(buffers_.back().get(), std::memory_order_release);
+        return buffers_.back().get();
+    }
+
+    Atomic<i64> top_{0};
+    Atomic<i64> bottom_{0};
+    Atomic<Buffer *> buffer_{nullptr};
+    // owner only
+    Vector<UniquePtr<Buffer>> buffers_{};
+};
+
+} // namespace infinity
@@ -34,9 +34,29 @@ import third_party;
 import infinity_exception;
 import expression_type;
 import bound_cast_func;
+import in_value_set;
+import value;
+import bitmask;
+import vector_buffer;
+import fused_expression;
 
 namespace infinity {
 
+namespace {
+
+// Evaluates a row wise function on the dictionary of an encoded column vector, once per distinct value,
+// and expands the results to the rows of the column vector.
+template <typename DictionaryFunction>
+void EvaluateOnDictionary(const ColumnVector &encoded, SharedPtr<ColumnVector> &output_column_vector, DictionaryFunction &&function) {
+    auto dictionary_output = MakeShared<ColumnVector>(output_column_vector->data_type());
+    dictionary_output->Initialize();
+    function(encoded.dictionary(), dictionary_output);
+    output_column_vector = MakeShared<ColumnVector>(output_column_vector->data_type());
+    output_column_vector->InitializeDecoded(encoded, *dictionary_output);
+}
+
+} // namespace
+
 void ExpressionEvaluator::Init(const DataBlock *input_data_block) { input_data_block_ = input_data_block; }
 
 void ExpressionEvaluator::Execute(const SharedPtr<BaseExpression> &expr, SharedPtr<ExpressionState> &state, SharedPtr<ColumnVector> &output_column) {
@@ -78,6 +98,9 @@ void ExpressionEvaluator::Execute(const SharedPtr<AggregateExpression> &expr,
     // TODO: In the future, it can be implemented as on-demand allocation.
     SharedPtr<ColumnVector> &child_output_col = child_state->OutputColumnVector();
     this->Execute(child_expr, child_state, child_output_col);
+    if (child_output_col->IsEncoded()) {
+        child_output_col = child_output_col->Decode();
+    }
 
     if (expr->aggregate_function_.return_type_ != *output_column_vector->data_type()) {
         RecoverableError(Status::DataTypeMismatch(expr->aggregate_function_.return_type_.ToString(), output_column_vector->data_type()->ToString()));
@@ -112,6 +135,12 @@ void ExpressionEvaluator::Execute(const SharedPtr<CastExpression> &expr,
 
     CastParameters cast_parameters;
 
+    if (child_output->IsEncoded()) {
+        EvaluateOnDictionary(*child_output, output_column_vector, [&](const SharedPtr<ColumnVector> &dictionary, SharedPtr<ColumnVector> &output) {
+            expr->func_.function(dictionary, output, dictionary->Size(), cast_parameters);
+        });
+        return;
+    }
     expr->func_.function(child_output, output_column_vector, child_output->Size(), cast_parameters);
 }
 
@@ -126,6 +155,25 @@ void ExpressionEvaluator::Execute(const SharedPtr<ColumnExpression> &, SharedPtr
 void ExpressionEvaluator::Execute(const SharedPtr<FunctionExpression> &expr,
                                   SharedPtr<ExpressionState> &state,
                                   SharedPtr<ColumnVector> &output_column_vector) {
+    if (const SharedPtr<FusedExpression> &fused_expression = state->fused_expression_; fused_expression) {
+        // evaluate the leaves only, the tree above them is one loop without intermediate column vectors
+        const auto &leaves = fused_expression->leaves();
+        Vector<SharedPtr<ColumnVector>> leaf_columns;
+        leaf_columns.reserve(leaves.size());
+        SizeT count = 1;
+        for (SizeT i = 0; i < leaves.size(); ++i) {
+            SharedPtr<ExpressionState> &leaf_state = state->Children()[i];
+            SharedPtr<ColumnVector> &leaf_output = leaf_state->OutputColumnVector();
+            Execute(leaves[i], leaf_state, leaf_output);
+            SharedPtr<ColumnVector> leaf_column = leaf_output->IsEncoded() ? leaf_output->Decode() : leaf_output;
+            if (leaf_column->vector_type() != ColumnVectorType::kConstant) {
+                count = leaf_column->Size();
+            }
+            leaf_columns.emplace_back(std::move(leaf_column));
+        }
+        fused_expression->Execute(leaf_columns, output_column_vector, count);
+        return;
+    }
 
     SizeT argument_count = expr->arguments().size();
     Vector<SharedPtr<ColumnVector>> arguments;
@@ -139,6 +187,34 @@ void ExpressionEvaluator::Execute(const SharedPtr<FunctionExpression> &expr,
         arguments.emplace_back(argument_output);
     }
 
+    // A function of one encoded argument and constants is evaluated on the dictionary, other encoded arguments are decoded.
+    SizeT encoded_count = 0;
+    SizeT encoded_idx = 0;
+    bool others_constant = true;
+    for (SizeT i = 0; i < argument_count; ++i) {
+        if (arguments[i]->IsEncoded()) {
+            ++encoded_count;
+            encoded_idx = i;
+        } else if (arguments[i]->vector_type() != ColumnVectorType::kConstant) {
+            others_constant = false;
+        }
+    }
+    if (encoded_count == 1 && others_constant) {
+        SharedPtr<ColumnVector> encoded = arguments[encoded_idx];
+        EvaluateOnDictionary(*encoded, output_column_vector, [&](const SharedPtr<ColumnVector> &dictionary, SharedPtr<ColumnVector> &output) {
+            arguments[encoded_idx] = dictionary;
+            DataBlock func_input_data_block;
+            func_input_data_block.Init(arguments);
+            expr->func_.function_(func_input_data_block, output);
+        });
+        return;
+    }
+    for (auto &argument : arguments) {
+        if (argument->IsEncoded()) {
+            argument = argument->Decode();
+        }
+    }
+
     DataBlock func_input_data_block;
     func_input_data_block.Init(arguments);
 
@@ -169,8 +245,53 @@ void ExpressionEvaluator::Execute(const SharedPtr<ReferenceExpression> &expr,
     output_column_vector = input_data_block_->column_vectors[column_index];
 }
 
-void ExpressionEvaluator::Execute(const SharedPtr<InExpression> &, SharedPtr<ExpressionState> &, SharedPtr<ColumnVector> &) {
-    RecoverableError(Status::NotSupport("IN execution isn't implemented yet."));
+void ExpressionEvaluator::Execute(const SharedPtr<InExpression> &expr,
+                                  SharedPtr<ExpressionState> &state,
+                                  SharedPtr<ColumnVector> &output_column_vector) {
+    SharedPtr<InValueSet> value_set = expr->GetValueSet([&] {
+        // Children of the state: the left operand, then the value list.
+        Vector<Value> values;
+        values.reserve(expr->arguments().size());
+        for (SizeT idx = 0; idx < expr->arguments().size(); ++idx) {
+            SharedPtr<ExpressionState> &argument_state = state->Children()[idx + 1];
+            SharedPtr<ColumnVector> &argument_output = argument_state->OutputColumnVector();
+            if (argument_output->vector_type() != ColumnVectorType::kConstant) {
+                RecoverableError(Status::NotSupport(fmt::format("IN list only supports constant values: {}", expr->arguments()[idx]->Name())));
+            }
+            Execute(expr->arguments()[idx], argument_state, argument_output);
+            values.push_back(argument_output->GetValue(0));
+        }
+        return MakeShared<InValueSet>(expr->left_operand()->Type(), values);
+    });
+
+    SharedPtr<ExpressionState> &left_state = state->Children()[0];
+    SharedPtr<ColumnVector> &left_output = left_state->OutputColumnVector();
+    Execute(expr->left_operand(), left_state, left_output);
+
+    if (left_output->IsEncoded()) {
+        bool not_in = expr->in_type() == InType::kNotIn;
+        EvaluateOnDictionary(*left_output, output_column_vector, [&](const SharedPtr<ColumnVector> &dictionary, SharedPtr<ColumnVector> &output) {
+            value_set->Probe(*dictionary, dictionary->Size(), not_in, *output);
+        });
+        return;
+    }
+
+    SizeT count = left_output->Size();
+    value_set->Probe(*left_output, count, expr->in_type() == InType::kNotIn, *output_column_vector);
+    if (left_output->vector_type() == ColumnVectorType::kConstant && output_column_vector->vector_type() != ColumnVectorType::kConstant &&
+        input_data_block_ != nullptr) {
+        // Broadcast the result of a constant left operand to all rows.
+        bool result = output_column_vector->buffer_->GetCompactBit(0);
+        bool is_null = !output_column_vector->nulls_ptr_->IsTrue(0);
+        count = input_data_block_->row_count();
+        for (SizeT idx = 1; idx < count; ++idx) {
+            output_column_vector->buffer_->SetCompactBit(idx, result);
+            if (is_null) {
+                output_column_vector->nulls_ptr_->SetFalse(idx);
+            }
+        }
+        output_column_vector->Finalize(count);
+    }
 }
 
 } // namespace infinity
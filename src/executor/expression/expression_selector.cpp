@@ -14,6 +14,9 @@
 
 module;
 
+#include <algorithm>
+#include <numeric>
+
 module expression_selector;
 
 import stl;
@@ -29,11 +32,86 @@ import expression_evaluator;
 import internal_types;
 import third_party;
 import data_type;
+import expression_type;
+import function_expression;
+import reference_expression;
+import in_expression;
 
 import infinity_exception;
 
 namespace infinity {
 
+namespace {
+
+bool IsConjunction(const SharedPtr<BaseExpression> &expr, const String &name) {
+    return expr->type() == ExpressionType::kFunction && static_cast<const FunctionExpression &>(*expr).ScalarFunctionName() == name;
+}
+
+// AND(AND(a, b), c) is evaluated as AND(a, b, c), so all of its conjuncts can be reordered.
+void FlattenConjunction(const SharedPtr<BaseExpression> &expr,
+                        SharedPtr<ExpressionState> &state,
+                        const String &name,
+                        Vector<SharedPtr<BaseExpression>> &children,
+                        Vector<SharedPtr<ExpressionState>> &child_states) {
+    for (SizeT idx = 0; idx < expr->arguments().size(); ++idx) {
+        SharedPtr<BaseExpression> &child = expr->arguments()[idx];
+        SharedPtr<ExpressionState> &child_state = state->Children()[idx];
+        if (IsConjunction(child, name)) {
+            FlattenConjunction(child, child_state, name, children, child_states);
+        } else {
+            children.push_back(child);
+            child_states.push_back(child_state);
+        }
+    }
+}
+
+void CollectReferencedColumns(const SharedPtr<BaseExpression> &expr, Vector<bool> &referenced) {
+    if (expr->type() == ExpressionType::kReference) {
+        SizeT column_index = static_cast<const ReferenceExpression &>(*expr).column_index();
+        if (column_index < referenced.size()) {
+            referenced[column_index] = true;
+        }
+        return;
+    }
+    if (expr->type() == ExpressionType::kIn) {
+        CollectReferencedColumns(static_cast<const InExpression &>(*expr).left_operand(), referenced);
+    }
+    for (const auto &argument : expr->arguments()) {
+        CollectReferencedColumns(argument, referenced);
+    }
+}
+
+// Rows of input_select (all rows if it's null) which are not in sub_select, both sorted.
+SharedPtr<Selection> DifferenceSelect(const SharedPtr<Selection> &input_select, const Selection &sub_select, SizeT count) {
+    SizeT input_count = input_select.get() == nullptr ? count : input_select->Size();
+    SizeT sub_count = sub_select.Size();
+    auto result = MakeShared<Selection>();
+    result->Initialize(std::max<SizeT>(input_count - sub_count, 1));
+    for (SizeT idx = 0, sub_idx = 0; idx < input_count; ++idx) {
+        SizeT row = input_select.get() == nullptr ? idx : input_select->Get(idx);
+        if (sub_idx < sub_count && sub_select[sub_idx] == row) {
+            ++sub_idx;
+        } else {
+            result->Append(row);
+        }
+    }
+    return result;
+}
+
+// Expected time to settle a row: cost / rows dropped for AND, cost / rows accepted for OR. Children never evaluated go first to get measured.
+double ConjunctRank(const ConjunctStats &stats, SizeT child_idx, bool is_and) {
+    if (stats.input_rows_[child_idx] == 0) {
+        return 0;
+    }
+    double input_rows = stats.input_rows_[child_idx];
+    double cost_per_row = stats.cost_ns_[child_idx] / input_rows;
+    double pass_rate = stats.true_rows_[child_idx] / input_rows;
+    double settle_rate = is_and ? 1 - pass_rate : pass_rate;
+    return cost_per_row / (settle_rate + 1e-3);
+}
+
+} // namespace
+
 SizeT ExpressionSelector::Select(const SharedPtr<BaseExpression> &expr,
                                  SharedPtr<ExpressionState> &state,
                                  const DataBlock *input_data_block,
@@ -68,18 +146,167 @@ void ExpressionSelector::Select(const SharedPtr<BaseExpression> &expr,
     if (expr->Type().type() != LogicalType::kBoolean) {
         UnrecoverableError("Attempting to select non-boolean expression");
     }
-    Select(expr, state, count, output_true_select);
+    SharedPtr<Selection> true_select = output_true_select;
+    if (true_select.get() == nullptr) {
+        true_select = MakeShared<Selection>();
+        true_select->Initialize(count);
+    }
+    SelectTrue(expr, state, count, input_select, true_select);
+    if (output_false_select.get() != nullptr) {
+        // Rows the expression is false or null for.
+        SharedPtr<Selection> false_select = DifferenceSelect(input_select, *true_select, count);
+        for (SizeT idx = 0; idx < false_select->Size(); ++idx) {
+            output_false_select->Append((*false_select)[idx]);
+        }
+    }
 }
 
 void ExpressionSelector::Select(const SharedPtr<BaseExpression> &expr,
                                 SharedPtr<ExpressionState> &state,
                                 SizeT count,
                                 SharedPtr<Selection> &output_true_select) {
+    SelectAll(input_data_, expr, state, count, output_true_select);
+}
+
+void ExpressionSelector::SelectTrue(const SharedPtr<BaseExpression> &expr,
+                                    SharedPtr<ExpressionState> &state,
+                                    SizeT count,
+                                    const SharedPtr<Selection> &input_select,
+                                    SharedPtr<Selection> &output_true_select) {
+    if (IsConjunction(expr, "AND")) {
+        SelectConjunction(expr, state, true, count, input_select, output_true_select);
+    } else if (IsConjunction(expr, "OR")) {
+        SelectConjunction(expr, state, false, count, input_select, output_true_select);
+    } else {
+        SelectLeaf(expr, state, count, input_select, output_true_select);
+    }
+}
+
+void ExpressionSelector::SelectConjunction(const SharedPtr<BaseExpression> &expr,
+                                           SharedPtr<ExpressionState> &state,
+                                           bool is_and,
+                                           SizeT count,
+                                           const SharedPtr<Selection> &input_select,
+                                           SharedPtr<Selection> &output_true_select) {
+    Vector<SharedPtr<BaseExpression>> children;
+    Vector<SharedPtr<ExpressionState>> child_states;
+    FlattenConjunction(expr, state, is_and ? "AND" : "OR", children, child_states);
+
+    ConjunctStats &stats = conjunct_stats_[expr.get()];
+    if (stats.order_.size() != children.size()) {
+        stats.order_.resize(children.size());
+        std::iota(stats.order_.begin(), stats.order_.end(), 0);
+        stats.input_rows_.assign(children.size(), 0);
+        stats.true_rows_.assign(children.size(), 0);
+        stats.cost_ns_.assign(children.size(), 0);
+    }
+
+    // AND: rows all evaluated children were true for. OR: rows no evaluated child was true for.
+    SharedPtr<Selection> remain_select = input_select;
+    for (SizeT child_idx : stats.order_) {
+        SizeT remain_count = remain_select.get() == nullptr ? count : remain_select->Size();
+        if (remain_count == 0) {
+            break;
+        }
+        auto child_true_select = MakeShared<Selection>();
+        child_true_select->Initialize(remain_count);
+        auto begin_ts = Clock::now();
+        SelectTrue(children[child_idx], child_states[child_idx], count, remain_select, child_true_select);
+        stats.cost_ns_[child_idx] += ElapsedFromStart(Clock::now(), begin_ts).count();
+        stats.input_rows_[child_idx] += remain_count;
+        stats.true_rows_[child_idx] += child_true_select->Size();
+
+        if (is_and) {
+            remain_select = child_true_select;
+        } else if (child_true_select->Size() > 0) {
+            remain_select = DifferenceSelect(remain_select, *child_true_select, count);
+        }
+    }
+
+    if (is_and) {
+        SizeT true_count = remain_select.get() == nullptr ? count : remain_select->Size();
+        for (SizeT idx = 0; idx < true_count; ++idx) {
+            output_true_select->Append(remain_select.get() == nullptr ? idx : (*remain_select)[idx]);
+        }
+    } else {
+        SharedPtr<Selection> true_select = DifferenceSelect(input_select, *remain_select, count);
+        for (SizeT idx = 0; idx < true_select->Size(); ++idx) {
+            output_true_select->Append((*true_select)[idx]);
+        }
+    }
+
+    std::stable_sort(stats.order_.begin(), stats.order_.end(), [&](SizeT left, SizeT right) {
+        return ConjunctRank(stats, left, is_and) < ConjunctRank(stats, right, is_and);
+    });
+}
+
+void ExpressionSelector::SelectLeaf(const SharedPtr<BaseExpression> &expr,
+                                    SharedPtr<ExpressionState> &state,
+                                    SizeT count,
+                                    const SharedPtr<Selection> &input_select,
+                                    SharedPtr<Selection> &output_true_select) {
+    if (input_select.get() == nullptr || input_select->Size() == count) {
+        SelectAll(input_data_, expr, state, count, output_true_select);
+        return;
+    }
+
+    SizeT input_count = input_select->Size();
+    SizeT column_count = input_data_->column_count();
+    Vector<bool> referenced(column_count, false);
+    CollectReferencedColumns(expr, referenced);
+    if (std::find(referenced.begin(), referenced.end(), true) == referenced.end()) {
+        // No column to gather, evaluate on the whole block and keep the selected rows.
+        auto all_true_select = MakeShared<Selection>();
+        all_true_select->Initialize(count);
+        SelectAll(input_data_, expr, state, count, all_true_select);
+        for (SizeT idx = 0, true_idx = 0; idx < input_count && true_idx < all_true_select->Size();) {
+            if ((*input_select)[idx] == (*all_true_select)[true_idx]) {
+                output_true_select->Append((*input_select)[idx]);
+                ++idx;
+                ++true_idx;
+            } else if ((*input_select)[idx] < (*all_true_select)[true_idx]) {
+                ++idx;
+            } else {
+                ++true_idx;
+            }
+        }
+        return;
+    }
+
+    // Columns the expression doesn't read are left as empty constant vectors.
+    Vector<SharedPtr<ColumnVector>> gathered_columns;
+    gathered_columns.reserve(column_count);
+    for (SizeT idx = 0; idx < column_count; ++idx) {
+        const SharedPtr<ColumnVector> &input_column = input_data_->column_vectors[idx];
+        auto gathered_column = MakeShared<ColumnVector>(input_column->data_type());
+        if (referenced[idx]) {
+            gathered_column->Initialize(*input_column, *input_select);
+        } else {
+            gathered_column->Initialize(ColumnVectorType::kConstant, 1);
+        }
+        gathered_columns.push_back(std::move(gathered_column));
+    }
+    DataBlock gathered_block;
+    gathered_block.Init(gathered_columns);
+
+    auto gathered_true_select = MakeShared<Selection>();
+    gathered_true_select->Initialize(input_count);
+    SelectAll(&gathered_block, expr, state, input_count, gathered_true_select);
+    for (SizeT idx = 0; idx < gathered_true_select->Size(); ++idx) {
+        output_true_select->Append((*input_select)[(*gathered_true_select)[idx]]);
+    }
+}
+
+void ExpressionSelector::SelectAll(const DataBlock *input_data,
+                                   const SharedPtr<BaseExpression> &expr,
+                                   SharedPtr<ExpressionState> &state,
+                                   SizeT count,
+                                   SharedPtr<Selection> &output_true_select) {
     SharedPtr<ColumnVector> bool_column = MakeShared<ColumnVector>(MakeShared<DataType>(LogicalType::kBoolean));
     bool_column->Initialize(ColumnVectorType::kCompactBit);
 
     ExpressionEvaluator expr_evaluator;
-    expr_evaluator.Init(input_data_);
+    expr_evaluator.Init(input_data);
     expr_evaluator.Execute(expr, state, bool_column);
 
     Select(bool_column, count, output_true_select, true);
@@ -26,6 +26,14 @@ export module expression_selector;
 namespace infinity {
 class ColumnVector;
 
+// Observed cost and pass rate of the children of an AND / OR, used to evaluate the cheapest and most decisive child first.
+struct ConjunctStats {
+    Vector<SizeT> order_{};
+    Vector<u64> input_rows_{};
+    Vector<u64> true_rows_{};
+    Vector<u64> cost_ns_{};
+};
+
 export class ExpressionSelector {
 public:
     SizeT Select(const SharedPtr<BaseExpression> &expr,
@@ -46,7 +54,38 @@ public:
     static void Select(const SharedPtr<ColumnVector> &bool_column, SizeT count, SharedPtr<Selection> &output_true_select, bool nullable);
 
 private:
+    // Appends the rows of input_select (all rows if it's null) for which expr is true to output_true_select.
+    void SelectTrue(const SharedPtr<BaseExpression> &expr,
+                    SharedPtr<ExpressionState> &state,
+                    SizeT count,
+                    const SharedPtr<Selection> &input_select,
+                    SharedPtr<Selection> &output_true_select);
+
+    // Each child of an AND runs only on the rows all previous children were true for, each child of an OR only on the rows they weren't.
+    void SelectConjunction(const SharedPtr<BaseExpression> &expr,
+                           SharedPtr<ExpressionState> &state,
+                           bool is_and,
+                           SizeT count,
+                           const SharedPtr<Selection> &input_select,
+                           SharedPtr<Selection> &output_true_select);
+
+    // Evaluates expr on a block gathered from the referenced columns of the selected rows.
+    void SelectLeaf(const SharedPtr<BaseExpression> &expr,
+                    SharedPtr<ExpressionState> &state,
+                    SizeT count,
+                    const SharedPtr<Selection> &input_select,
+                    SharedPtr<Selection> &output_true_select);
+
+    void SelectAll(const DataBlock *input_data,
+                   const SharedPtr<BaseExpression> &expr,
+                   SharedPtr<ExpressionState> &state,
+                   SizeT count,
+                   SharedPtr<Selection> &output_true_select);
+
     const DataBlock *input_data_{nullptr};
+
+    // Kept across the blocks of a task, keyed by the AND / OR expression.
+    HashMap<const BaseExpression *, ConjunctStats> conjunct_stats_{};
 };
 
 } // namespace infinity
@@ -33,6 +33,7 @@ import function_expression;
 import in_expression;
 import reference_expression;
 import value_expression;
+import fused_expression;
 import status;
 
 import default_values;
@@ -139,7 +140,11 @@ SharedPtr<ExpressionState> ExpressionState::CreateState(const SharedPtr<Function
     SharedPtr<ExpressionState> result = MakeShared<ExpressionState>();
     SharedPtr<DataType> function_expr_data_type = MakeShared<DataType>(function_expr->Type());
 
-    for (auto &arg : function_expr->arguments()) {
+    if (enable_expression_fusion_) {
+        result->fused_expression_ = FusedExpression::Make(function_expr);
+    }
+    const auto &children = result->fused_expression_ ? result->fused_expression_->leaves() : function_expr->arguments();
+    for (auto &arg : children) {
         result->AddChild(arg);
     }
 
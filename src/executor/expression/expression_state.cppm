@@ -24,6 +24,7 @@ import function_expression;
 import value_expression;
 import in_expression;
 import column_vector;
+import fused_expression;
 
 export module expression_state;
 
@@ -57,6 +58,12 @@ public:
 
     char *agg_state_{};
 
+    // set if the function expression is evaluated as one fused kernel, the children are the states of its leaves
+    SharedPtr<FusedExpression> fused_expression_{};
+
+    // turned off by benchmarks and tests comparing against the evaluation node by node
+    static inline bool enable_expression_fusion_ = true;
+
 private:
     Vector<SharedPtr<ExpressionState>> children_;
     String name_;
@@ -0,0 +1,248 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+module fused_expression;
+
+import stl;
+import base_expression;
+import function_expression;
+import scalar_function;
+import column_vector;
+import fused_operator;
+import expression_type;
+import data_type;
+import logical_type;
+import internal_types;
+
+namespace infinity {
+
+namespace {
+
+enum class FusedOpType {
+    kInvalid,
+    kAdd,
+    kSubtract,
+    kMultiply,
+    kLess,
+    kLessEqual,
+    kGreater,
+    kGreaterEqual,
+    kEqual,
+    kNotEqual,
+};
+
+FusedOpType GetFusedOpType(const String &function_name) {
+    static const HashMap<String, FusedOpType> op_types = {
+        {"+", FusedOpType::kAdd},
+        {"-", FusedOpType::kSubtract},
+        {"*", FusedOpType::kMultiply},
+        {"<", FusedOpType::kLess},
+        {"<=", FusedOpType::kLessEqual},
+        {">", FusedOpType::kGreater},
+        {">=", FusedOpType::kGreaterEqual},
+        {"=", FusedOpType::kEqual},
+        {"<>", FusedOpType::kNotEqual},
+    };
+    auto iter = op_types.find(function_name);
+    return iter == op_types.end() ? FusedOpType::kInvalid : iter->second;
+}
+
+bool IsArithmetic(FusedOpType op) { return op == FusedOpType::kAdd or op == FusedOpType::kSubtract or op == FusedOpType::kMultiply; }
+
+// x op y -> y op' x
+FusedOpType SwapOperands(FusedOpType op) {
+    switch (op) {
+        case FusedOpType::kAdd:
+        case FusedOpType::kMultiply:
+        case FusedOpType::kEqual:
+        case FusedOpType::kNotEqual:
+            return op;
+        case FusedOpType::kLess:
+            return FusedOpType::kGreater;
+        case FusedOpType::kLessEqual:
+            return FusedOpType::kGreaterEqual;
+        case FusedOpType::kGreater:
+            return FusedOpType::kLess;
+        case FusedOpType::kGreaterEqual:
+            return FusedOpType::kLessEqual;
+        default:
+            return FusedOpType::kInvalid;
+    }
+}
+
+struct FusedNode {
+    FusedOpType op_{FusedOpType::kInvalid};
+    SharedPtr<BaseExpression> left_{};
+    SharedPtr<BaseExpression> right_{};
+};
+
+// A binary arithmetic or comparison function of two operands of type `type`.
+bool MatchNode(const SharedPtr<BaseExpression> &expr, const DataType &type, FusedNode &node) {
+    if (expr->type() != ExpressionType::kFunction) {
+        return false;
+    }
+    auto function_expr = std::static_pointer_cast<FunctionExpression>(expr);
+    const ScalarFunction &func = function_expr->func_;
+    FusedOpType op = GetFusedOpType(func.name());
+    if (op == FusedOpType::kInvalid or function_expr->arguments().size() != 2 or func.parameter_types_.size() != 2) {
+        return false;
+    }
+    if (func.parameter_types_[0] != type or func.parameter_types_[1] != type) {
+        return false;
+    }
+    if (IsArithmetic(op) and func.return_type() != type) {
+        return false;
+    }
+    node.op_ = op;
+    node.left_ = function_expr->arguments()[0];
+    node.right_ = function_expr->arguments()[1];
+    return true;
+}
+
+// Matches the arithmetic child of the node, which is moved to the left.
+bool MatchArithmeticChild(FusedNode &node, const DataType &type, FusedNode &child) {
+    if (MatchNode(node.left_, type, child) and IsArithmetic(child.op_)) {
+        return true;
+    }
+    FusedOpType swapped_op = SwapOperands(node.op_);
+    if (swapped_op == FusedOpType::kInvalid or !MatchNode(node.right_, type, child) or !IsArithmetic(child.op_)) {
+        return false;
+    }
+    node.op_ = swapped_op;
+    std::swap(node.left_, node.right_);
+    return true;
+}
+
+template <typename Function>
+FusedExpression::KernelType DispatchType(LogicalType type, Function &&function) {
+    switch (type) {
+        case LogicalType::kInteger:
+            return function(IntegerT{});
+        case LogicalType::kBigInt:
+            return function(BigIntT{});
+        case LogicalType::kFloat:
+            return function(FloatT{});
+        case LogicalType::kDouble:
+            return function(DoubleT{});
+        default:
+            return nullptr;
+    }
+}
+
+template <typename Function>
+FusedExpression::KernelType DispatchArithmetic(FusedOpType op, Function &&function) {
+    switch (op) {
+        case FusedOpType::kAdd:
+            return function(FusedAddOp{});
+        case FusedOpType::kSubtract:
+            return function(FusedSubtractOp{});
+        case FusedOpType::kMultiply:
+            return function(FusedMultiplyOp{});
+        default:
+            return nullptr;
+    }
+}
+
+template <typename Function>
+FusedExpression::KernelType DispatchComparison(FusedOpType op, Function &&function) {
+    switch (op) {
+        case FusedOpType::kLess:
+            return function(FusedLessOp{});
+        case FusedOpType::kLessEqual:
+            return function(FusedLessEqualOp{});
+        case FusedOpType::kGreater:
+            return function(FusedGreaterOp{});
+        case FusedOpType::kGreaterEqual:
+            return function(FusedGreaterEqualOp{});
+        case FusedOpType::kEqual:
+            return function(FusedEqualOp{});
+        case FusedOpType::kNotEqual:
+            return function(FusedNotEqualOp{});
+        default:
+            return nullptr;
+    }
+}
+
+template <typename Expression>
+FusedExpression::KernelType GetKernel() {
+    return &FusedOperator::Execute<Expression>;
+}
+
+} // namespace
+
+SharedPtr<FusedExpression> FusedExpression::Make(const SharedPtr<FunctionExpression> &function_expr) {
+    const auto &parameter_types = function_expr->func_.parameter_types_;
+    if (parameter_types.empty()) {
+        return nullptr;
+    }
+    const DataType &type = parameter_types[0];
+    FusedNode top;
+    FusedNode middle;
+    if (!MatchNode(function_expr, type, top) or !MatchArithmeticChild(top, type, middle)) {
+        // a single node has no intermediate column to save
+        return nullptr;
+    }
+
+    Vector<SharedPtr<BaseExpression>> leaves;
+    KernelType kernel = nullptr;
+    if (IsArithmetic(top.op_)) {
+        // (x op y) op z
+        leaves = {middle.left_, middle.right_, top.right_};
+        kernel = DispatchType(type.type(), [&](auto type_tag) {
+            using Leaf = FusedLeaf<decltype(type_tag)>;
+            return DispatchArithmetic(middle.op_, [&](auto middle_op) {
+                using Middle = FusedBinary<decltype(middle_op), Leaf, Leaf>;
+                return DispatchArithmetic(top.op_, [&](auto top_op) { return GetKernel<FusedBinary<decltype(top_op), Middle, Leaf>>(); });
+            });
+        });
+    } else if (FusedNode bottom; MatchArithmeticChild(middle, type, bottom)) {
+        // ((x op y) op z) cmp w
+        leaves = {bottom.left_, bottom.right_, middle.right_, top.right_};
+        kernel = DispatchType(type.type(), [&](auto type_tag) {
+            using Leaf = FusedLeaf<decltype(type_tag)>;
+            return DispatchArithmetic(bottom.op_, [&](auto bottom_op) {
+                using Bottom = FusedBinary<decltype(bottom_op), Leaf, Leaf>;
+                return DispatchArithmetic(middle.op_, [&](auto middle_op) {
+                    using Middle = FusedBinary<decltype(middle_op), Bottom, Leaf>;
+                    return DispatchComparison(top.op_, [&](auto top_op) { return GetKernel<FusedBinary<decltype(top_op), Middle, Leaf>>(); });
+                });
+            });
+        });
+    } else {
+        // (x op y) cmp z
+        leaves = {middle.left_, middle.right_, top.right_};
+        kernel = DispatchType(type.type(), [&](auto type_tag) {
+            using Leaf = FusedLeaf<decltype(type_tag)>;
+            return DispatchArithmetic(middle.op_, [&](auto middle_op) {
+                using Middle = FusedBinary<decltype(middle_op), Leaf, Leaf>;
+                return DispatchComparison(top.op_, [&](auto top_op) { return GetKernel<FusedBinary<decltype(top_op), Middle, Leaf>>(); });
+            });
+        });
+    }
+    if (kernel == nullptr) {
+        return nullptr;
+    }
+    bool all_constant = true;
+    for (const auto &leaf : leaves) {
+        all_constant = all_constant and leaf->type() == ExpressionType::kValue;
+    }
+    if (all_constant) {
+        return nullptr;
+    }
+    return MakeShared<FusedExpression>(std::move(leaves), kernel);
+}
+
+} // namespace infinity
@@ -0,0 +1,51 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+export module fused_expression;
+
+import stl;
+import base_expression;
+import function_expression;
+import column_vector;
+
+namespace infinity {
+
+// An arithmetic / comparison tree over one fixed width type, such as "a * 2 + b > c", evaluated by one loop over the rows
+// instead of one column vector per node. The loop is a FusedOperator kernel instantiated for the shape of the tree.
+// Supported shapes, with x, y, z, w leaves of any expression of the type:
+//   (x op y) op z,  (x op y) cmp z,  ((x op y) op z) cmp w
+// Deeper subtrees are leaves, and are fused on their own when their state is created.
+export class FusedExpression {
+public:
+    using KernelType = void (*)(const Vector<SharedPtr<ColumnVector>> &leaves, SharedPtr<ColumnVector> &result, SizeT count);
+
+    // nullptr if the expression is not a supported tree
+    static SharedPtr<FusedExpression> Make(const SharedPtr<FunctionExpression> &function_expr);
+
+    FusedExpression(Vector<SharedPtr<BaseExpression>> leaves, KernelType kernel) : leaves_(std::move(leaves)), kernel_(kernel) {}
+
+    [[nodiscard]] inline const Vector<SharedPtr<BaseExpression>> &leaves() const { return leaves_; }
+
+    inline void Execute(const Vector<SharedPtr<ColumnVector>> &leaf_columns, SharedPtr<ColumnVector> &result, SizeT count) const {
+        kernel_(leaf_columns, result, count);
+    }
+
+private:
+    Vector<SharedPtr<BaseExpression>> leaves_;
+    KernelType kernel_{};
+};
+
+} // namespace infinity
@@ -0,0 +1,365 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+#include <algorithm>
+#include <cmath>
+
+module in_value_set;
+
+import stl;
+import value;
+import data_type;
+import logical_type;
+import internal_types;
+import column_vector;
+import vector_buffer;
+import fix_heap;
+import bitmask;
+import status;
+import third_party;
+import infinity_exception;
+
+namespace infinity {
+
+namespace {
+
+Pair<i64, i64> IntegerRange(LogicalType type) {
+    switch (type) {
+        case LogicalType::kTinyInt: {
+            return {std::numeric_limits<TinyIntT>::lowest(), std::numeric_limits<TinyIntT>::max()};
+        }
+        case LogicalType::kSmallInt: {
+            return {std::numeric_limits<SmallIntT>::lowest(), std::numeric_limits<SmallIntT>::max()};
+        }
+        case LogicalType::kInteger: {
+            return {std::numeric_limits<IntegerT>::lowest(), std::numeric_limits<IntegerT>::max()};
+        }
+        default: {
+            return {std::numeric_limits<BigIntT>::lowest(), std::numeric_limits<BigIntT>::max()};
+        }
+    }
+}
+
+// Returns false if the value can't be equal to any integer of the range.
+bool ToInteger(const Value &value, Pair<i64, i64> range, i64 &result) {
+    switch (value.type().type()) {
+        case LogicalType::kTinyInt: {
+            result = value.GetValue<TinyIntT>();
+            break;
+        }
+        case LogicalType::kSmallInt: {
+            result = value.GetValue<SmallIntT>();
+            break;
+        }
+        case LogicalType::kInteger: {
+            result = value.GetValue<IntegerT>();
+            break;
+        }
+        case LogicalType::kBigInt: {
+            result = value.GetValue<BigIntT>();
+            break;
+        }
+        case LogicalType::kFloat:
+        case LogicalType::kDouble: {
+            DoubleT double_value = value.type().type() == LogicalType::kFloat ? value.GetValue<FloatT>() : value.GetValue<DoubleT>();
+            // 2^63 itself isn't a BigIntT
+            if (std::trunc(double_value) != double_value || double_value < -0x1p63 || double_value >= 0x1p63) {
+                return false;
+            }
+            result = static_cast<i64>(double_value);
+            break;
+        }
+        default: {
+            RecoverableError(Status::DataTypeMismatch(DataType(LogicalType::kBigInt).ToString(), value.type().ToString()));
+        }
+    }
+    return result >= range.first && result <= range.second;
+}
+
+// Returns false if the value can't be equal to any value of the floating point type.
+bool ToDouble(const Value &value, LogicalType left_type, DoubleT &result) {
+    switch (value.type().type()) {
+        case LogicalType::kTinyInt: {
+            result = value.GetValue<TinyIntT>();
+            break;
+        }
+        case LogicalType::kSmallInt: {
+            result = value.GetValue<SmallIntT>();
+            break;
+        }
+        case LogicalType::kInteger: {
+            result = value.GetValue<IntegerT>();
+            break;
+        }
+        case LogicalType::kBigInt: {
+            result = value.GetValue<BigIntT>();
+            break;
+        }
+        case LogicalType::kFloat: {
+            result = value.GetValue<FloatT>();
+            break;
+        }
+        case LogicalType::kDouble: {
+            result = value.GetValue<DoubleT>();
+            break;
+        }
+        default: {
+            RecoverableError(Status::DataTypeMismatch(DataType(left_type).ToString(), value.type().ToString()));
+        }
+    }
+    if (std::isnan(result)) {
+        return false;
+    }
+    return left_type != LogicalType::kFloat || static_cast<DoubleT>(static_cast<FloatT>(result)) == result;
+}
+
+// Branchless, so that the compiler can vectorize it.
+template <typename T>
+inline bool ScanContains(const Vector<T> &values, T value) {
+    bool hit = false;
+    for (T v : values) {
+        hit |= v == value;
+    }
+    return hit;
+}
+
+} // namespace
+
+InValueSet::InValueSet(const DataType &left_type, const Vector<Value> &values) : left_type_(left_type) {
+    switch (left_type_.type()) {
+        case LogicalType::kTinyInt:
+        case LogicalType::kSmallInt:
+        case LogicalType::kInteger:
+        case LogicalType::kBigInt: {
+            Pair<i64, i64> range = IntegerRange(left_type_.type());
+            for (const auto &value : values) {
+                i64 integer = 0;
+                if (value.type().type() == LogicalType::kNull) {
+                    has_null_ = true;
+                } else if (ToInteger(value, range, integer)) {
+                    integers_.push_back(integer);
+                }
+            }
+            std::sort(integers_.begin(), integers_.end());
+            integers_.erase(std::unique(integers_.begin(), integers_.end()), integers_.end());
+            if (integers_.size() > IN_SMALL_LIST_SIZE) {
+                integer_set_.insert(integers_.begin(), integers_.end());
+            }
+            value_count_ = integers_.size();
+            break;
+        }
+        case LogicalType::kFloat:
+        case LogicalType::kDouble: {
+            for (const auto &value : values) {
+                DoubleT double_value = 0;
+                if (value.type().type() == LogicalType::kNull) {
+                    has_null_ = true;
+                } else if (ToDouble(value, left_type_.type(), double_value)) {
+                    doubles_.push_back(double_value);
+                }
+            }
+            std::sort(doubles_.begin(), doubles_.end());
+            doubles_.erase(std::unique(doubles_.begin(), doubles_.end()), doubles_.end());
+            if (doubles_.size() > IN_SMALL_LIST_SIZE) {
+                double_set_.insert(doubles_.begin(), doubles_.end());
+            }
+            value_count_ = doubles_.size();
+            break;
+        }
+        case LogicalType::kVarchar: {
+            for (const auto &value : values) {
+                if (value.type().type() == LogicalType::kNull) {
+                    has_null_ = true;
+                } else if (value.type().type() == LogicalType::kVarchar) {
+                    const String &str = value.GetVarchar();
+                    max_string_length_ = std::max(max_string_length_, str.size());
+                    string_set_.insert(str);
+                } else {
+                    RecoverableError(Status::DataTypeMismatch(left_type_.ToString(), value.type().ToString()));
+                }
+            }
+            value_count_ = string_set_.size();
+            break;
+        }
+        default: {
+            RecoverableError(Status::NotSupport(fmt::format("IN on {} type isn't supported.", left_type_.ToString())));
+        }
+    }
+}
+
+bool InValueSet::ContainsInteger(i64 value) const {
+    if (integers_.empty() || value < integers_.front() || value > integers_.back()) {
+        return false;
+    }
+    if (integers_.size() <= IN_SMALL_LIST_SIZE) {
+        return ScanContains(integers_, value);
+    }
+    return integer_set_.contains(value);
+}
+
+bool InValueSet::ContainsDouble(DoubleT value) const {
+    if (doubles_.empty() || !(value >= doubles_.front() && value <= doubles_.back())) {
+        return false;
+    }
+    if (doubles_.size() <= IN_SMALL_LIST_SIZE) {
+        return ScanContains(doubles_, value);
+    }
+    return double_set_.contains(value);
+}
+
+template <typename RowContains>
+void InValueSet::ProbeRows(const ColumnVector &input, SizeT count, bool not_in, ColumnVector &output, RowContains &&row_contains) const {
+    const Bitmask &input_null = *input.nulls_ptr_;
+    Bitmask &output_null = *output.nulls_ptr_;
+    VectorBuffer &output_buffer = *output.buffer_;
+    bool all_valid = input_null.IsAllTrue();
+    output_null.SetAllTrue();
+    for (SizeT idx = 0; idx < count; ++idx) {
+        if (!all_valid && !input_null.IsTrue(idx)) {
+            output_buffer.SetCompactBit(idx, false);
+            output_null.SetFalse(idx);
+            continue;
+        }
+        bool hit = row_contains(idx);
+        if (!hit && has_null_) {
+            // x IN (..., NULL) is null rather than false.
+            output_buffer.SetCompactBit(idx, false);
+            output_null.SetFalse(idx);
+            continue;
+        }
+        output_buffer.SetCompactBit(idx, hit != not_in);
+    }
+    output.Finalize(count);
+}
+
+template <typename T>
+void InValueSet::ProbeInteger(const ColumnVector &input, SizeT count, bool not_in, ColumnVector &output) const {
+    const auto *data = reinterpret_cast<const T *>(input.data());
+    ProbeRows(input, count, not_in, output, [&](SizeT idx) { return ContainsInteger(data[idx]); });
+}
+
+template <typename T>
+void InValueSet::ProbeDouble(const ColumnVector &input, SizeT count, bool not_in, ColumnVector &output) const {
+    const auto *data = reinterpret_cast<const T *>(input.data());
+    ProbeRows(input, count, not_in, output, [&](SizeT idx) { return ContainsDouble(data[idx]); });
+}
+
+void InValueSet::ProbeVarchar(const ColumnVector &input, SizeT count, bool not_in, ColumnVector &output) const {
+    const auto *data = reinterpret_cast<const VarcharT *>(input.data());
+    String row_value;
+    ProbeRows(input, count, not_in, output, [&](SizeT idx) {
+        const VarcharT &varchar = data[idx];
+        if (varchar.length_ > max_string_length_) {
+            return false;
+        }
+        if (varchar.IsInlined()) {
+            row_value.assign(varchar.short_.data_, varchar.length_);
+        } else {
+            row_value.resize(varchar.length_);
+            input.buffer_->fix_heap_mgr_->ReadFromHeap(row_value.data(), varchar.vector_.chunk_id_, varchar.vector_.chunk_offset_, varchar.length_);
+        }
+        return string_set_.contains(row_value);
+    });
+}
+
+void InValueSet::Probe(const ColumnVector &input, SizeT count, bool not_in, ColumnVector &output) const {
+    if (input.vector_type() != ColumnVectorType::kFlat && input.vector_type() != ColumnVectorType::kConstant) {
+        UnrecoverableError(fmt::format("IN doesn't support column vector type {}", (u8)input.vector_type()));
+    }
+    switch (left_type_.type()) {
+        case LogicalType::kTinyInt: {
+            return ProbeInteger<TinyIntT>(input, count, not_in, output);
+        }
+        case LogicalType::kSmallInt: {
+            return ProbeInteger<SmallIntT>(input, count, not_in, output);
+        }
+        case LogicalType::kInteger: {
+            return ProbeInteger<IntegerT>(input, count, not_in, output);
+        }
+        case LogicalType::kBigInt: {
+            return ProbeInteger<BigIntT>(input, count, not_in, output);
+        }
+        case LogicalType::kFloat: {
+            return ProbeDouble<FloatT>(input, count, not_in, output);
+        }
+        case LogicalType::kDouble: {
+            return ProbeDouble<DoubleT>(input, count, not_in, output);
+        }
+        case LogicalType::kVarchar: {
+            return ProbeVarchar(input, count, not_in, output);
+        }
+        default: {
+            UnrecoverableError(fmt::format("IN on {} type isn't supported.", left_type_.ToString()));
+        }
+    }
+}
+
+Vector<Value> InValueSet::ToValues() const {
+    Vector<Value> values;
+    values.reserve(value_count_);
+    switch (left_type_.type()) {
+        case LogicalType::kTinyInt: {
+            for (i64 integer : integers_) {
+                values.push_back(Value::MakeTinyInt(static_cast<TinyIntT>(integer)));
+            }
+            break;
+        }
+        case LogicalType::kSmallInt: {
+            for (i64 integer : integers_) {
+                values.push_back(Value::MakeSmallInt(static_cast<SmallIntT>(integer)));
+            }
+            break;
+        }
+        case LogicalType::kInteger: {
+            for (i64 integer : integers_) {
+                values.push_back(Value::MakeInt(static_cast<IntegerT>(integer)));
+            }
+            break;
+        }
+        case LogicalType::kBigInt: {
+            for (i64 integer : integers_) {
+                values.push_back(Value::MakeBigInt(integer));
+            }
+            break;
+        }
+        case LogicalType::kFloat: {
+            for (DoubleT double_value : doubles_) {
+                values.push_back(Value::MakeFloat(static_cast<FloatT>(double_value)));
+            }
+            break;
+        }
+        case LogicalType::kDouble: {
+            for (DoubleT double_value : doubles_) {
+                values.push_back(Value::MakeDouble(double_value));
+            }
+            break;
+        }
+        case LogicalType::kVarchar: {
+            Vector<String> strings(string_set_.begin(), string_set_.end());
+            std::sort(strings.begin(), strings.end());
+            for (const auto &str : strings) {
+                values.push_back(Value::MakeVarchar(str));
+            }
+            break;
+        }
+        default: {
+            UnrecoverableError(fmt::format("IN on {} type isn't supported.", left_type_.ToString()));
+        }
+    }
+    return values;
+}
+
+} // namespace infinity
@@ -0,0 +1,75 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+export module in_value_set;
+
+import stl;
+import value;
+import data_type;
+import column_vector;
+
+namespace infinity {
+
+// Lists up to this size are probed with a branchless scan of the sorted values, larger ones with a hash set.
+export constexpr SizeT IN_SMALL_LIST_SIZE = 16;
+
+// The value list of an IN expression, converted to the type domain of the left operand and built once per query.
+// Integer columns are probed as i64, float columns as double and varchar columns as strings.
+export class InValueSet {
+public:
+    InValueSet(const DataType &left_type, const Vector<Value> &values);
+
+    // Writes to output whether each input row is in the set, negated for NOT IN.
+    // Null rows are null, so are the misses when the list contains a null.
+    void Probe(const ColumnVector &input, SizeT count, bool not_in, ColumnVector &output) const;
+
+    // The distinct non-null values of the left operand type, in ascending order. Used as the points of an index lookup.
+    Vector<Value> ToValues() const;
+
+    [[nodiscard]] inline SizeT ValueCount() const { return value_count_; }
+
+    [[nodiscard]] inline bool HasNull() const { return has_null_; }
+
+private:
+    bool ContainsInteger(i64 value) const;
+
+    bool ContainsDouble(DoubleT value) const;
+
+    template <typename T>
+    void ProbeInteger(const ColumnVector &input, SizeT count, bool not_in, ColumnVector &output) const;
+
+    template <typename T>
+    void ProbeDouble(const ColumnVector &input, SizeT count, bool not_in, ColumnVector &output) const;
+
+    void ProbeVarchar(const ColumnVector &input, SizeT count, bool not_in, ColumnVector &output) const;
+
+    template <typename RowContains>
+    void ProbeRows(const ColumnVector &input, SizeT count, bool not_in, ColumnVector &output, RowContains &&row_contains) const;
+
+    DataType left_type_;
+    bool has_null_{false};
+    SizeT value_count_{0};
+
+    // sorted and distinct
+    Vector<i64> integers_{};
+    HashSet<i64> integer_set_{};
+    Vector<DoubleT> doubles_{};
+    HashSet<DoubleT> double_set_{};
+    HashSet<String> string_set_{};
+    SizeT max_string_length_{0};
+};
+
+} // namespace infinity
@@ -75,8 +75,7 @@ bool PhysicalFilter::Execute(QueryContext *, OperatorState *operator_state) {
         SharedPtr<ExpressionState> condition_state = ExpressionState::CreateState(condition_);
         DataBlock* input_data_block = prev_op_state->data_block_array_[block_idx].get();
 
-        // selector contains a pointer to input data, which should not be shared by multiple tasks
-        ExpressionSelector selector;
+        ExpressionSelector &selector = filter_operator_state->selector_;
         SizeT selected_count = selector.Select(condition_, condition_state, input_data_block, output_data_block, input_data_block->row_count());
 
         LOG_TRACE(fmt::format("{} rows after filter", selected_count));
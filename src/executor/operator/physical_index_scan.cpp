@@ -15,6 +15,7 @@
 module;
 
 #include <bit>
+#include <cmath>
 #include <vector>
 
 module physical_index_scan;
@@ -29,6 +30,8 @@ import third_party;
 import txn;
 import data_block;
 import secondary_index_scan_execute_expression;
+import secondary_index_data;
+import secondary_index_key;
 import logical_type;
 import table_index_entry;
 import segment_index_entry;
@@ -47,11 +50,12 @@ PhysicalIndexScan::PhysicalIndexScan(u64 id,
                                      Vector<FilterExecuteElem> &&filter_execute_command,
                                      UniquePtr<FastRoughFilterEvaluator> &&fast_rough_filter_evaluator,
                                      SharedPtr<Vector<LoadMeta>> load_metas,
+                                     Optional<f64> estimated_row_count,
                                      bool add_row_id)
     : PhysicalOperator(PhysicalOperatorType::kIndexScan, nullptr, nullptr, id, load_metas), base_table_ref_(std::move(base_table_ref)),
       index_filter_qualified_(std::move(index_filter_qualified)), column_index_map_(std::move(column_index_map)),
       filter_execute_command_(std::move(filter_execute_command)), fast_rough_filter_evaluator_(std::move(fast_rough_filter_evaluator)),
-      add_row_id_(add_row_id) {
+      estimated_row_count_(estimated_row_count), add_row_id_(add_row_id) {
     // output only one hidden column: RowID
     // create empty output_names_ and output_types_
     output_names_ = MakeShared<Vector<String>>();
@@ -63,6 +67,16 @@ PhysicalIndexScan::PhysicalIndexScan(u64 id,
     }
 }
 
+SizeT PhysicalIndexScan::EstimatedBlockCount() const {
+    SizeT block_count = base_table_ref_->block_index_->BlockCount();
+    if (!estimated_row_count_.has_value()) {
+        return block_count;
+    }
+    // At worst, each selected row is in a block of its own.
+    auto row_count = static_cast<SizeT>(std::ceil(*estimated_row_count_));
+    return std::min(block_count, row_count);
+}
+
 Vector<UniquePtr<Vector<SegmentID>>> PhysicalIndexScan::PlanSegments(u32 parallel_count) const {
     const u32 total_segment_num = base_table_ref_->block_index_->SegmentCount();
     const u32 segment_num_per_tasklet = total_segment_num / parallel_count;
@@ -414,6 +428,133 @@ public:
         }
     }
 
+    // reads the keys of an index on encoded keys by position, keeps the current part in memory
+    class EncodedKeyReader {
+    public:
+        EncodedKeyReader(SegmentIndexEntry &index_entry, u32 part_capacity) : index_entry_(index_entry), part_capacity_(part_capacity) {}
+
+        inline u64 Prefix(u32 pos) {
+            Load(pos);
+            return static_cast<const u64 *>(part_->GetColumnKeyData())[pos % part_capacity_];
+        }
+
+        inline std::string_view Overflow(u32 pos) {
+            Load(pos);
+            return part_->GetKeyOverflow(pos % part_capacity_);
+        }
+
+        inline u32 Offset(u32 pos) {
+            Load(pos);
+            return static_cast<const u32 *>(part_->GetColumnOffsetData())[pos % part_capacity_];
+        }
+
+    private:
+        inline void Load(u32 pos) {
+            u32 part_id = pos / part_capacity_;
+            if (part_ != nullptr and part_id == part_id_) {
+                return;
+            }
+            part_handle_ = index_entry_.GetIndexPartAt(part_id);
+            part_ = static_cast<const SecondaryIndexDataPart *>(part_handle_.GetData());
+            part_id_ = part_id;
+            if (part_->GetPartId() != part_id) {
+                UnrecoverableError("FilterResult::EncodedKeyReader: GetPartId() error.");
+            }
+        }
+
+        SegmentIndexEntry &index_entry_;
+        const u32 part_capacity_;
+        u32 part_id_{};
+        BufferHandle part_handle_;
+        const SecondaryIndexDataPart *part_{};
+    };
+
+    // first position where the key >= key
+    static inline u32 EncodedKeyLowerBound(const SecondaryIndexDataHead *index, EncodedKeyReader &reader, const String &key) {
+        const u32 data_num = index->GetDataNum();
+        const u64 prefix = SecondaryIndexKeyPrefix(key);
+        const std::string_view overflow = SecondaryIndexKeyOverflow(key);
+        // 1. PGM on the key prefixes: approximate position of the first prefix >= prefix
+        auto [approx_pos, lower, upper] = index->SearchPGM(&prefix);
+        u32 begin = std::min<SizeT>(lower, data_num);
+        u32 end = std::min<SizeT>(upper + 1, data_num);
+        // widen the range if the approximation misses
+        while (begin > 0 and reader.Prefix(begin - 1) >= prefix) {
+            begin = begin > 64 ? begin - 64 : 0;
+        }
+        while (end < data_num and reader.Prefix(end - 1) < prefix) {
+            end = std::min(end + 64, data_num);
+        }
+        // 2. binary search on the prefixes
+        while (begin < end) {
+            u32 mid = begin + (end - begin) / 2;
+            if (reader.Prefix(mid) < prefix) {
+                begin = mid + 1;
+            } else {
+                end = mid;
+            }
+        }
+        if ((prefix & 0xFF) <= kSecondaryIndexKeyPrefixBytes) {
+            // short key, equal prefixes are equal keys
+            return begin;
+        }
+        // 3. equal prefixes: gallop over the smaller keys, then binary search on the overflow bytes
+        end = begin;
+        for (u32 step = 1; end < data_num and reader.Prefix(end) == prefix and reader.Overflow(end) < overflow; step *= 2) {
+            begin = end + 1;
+            end = std::min<u32>(end + step, data_num);
+        }
+        while (begin < end) {
+            u32 mid = begin + (end - begin) / 2;
+            if (CompareSecondaryIndexKey(reader.Prefix(mid), reader.Overflow(mid), prefix, overflow) < 0) {
+                begin = mid + 1;
+            } else {
+                end = mid;
+            }
+        }
+        return begin;
+    }
+
+    inline void ExecuteEncodedKeyRange(const FilterEncodedKeyRange &key_range, SegmentIndexEntry &index_entry) {
+        if (key_range.IsAlwaysFalse()) {
+            return SetEmptyResult();
+        }
+        BufferHandle index_handle_head = index_entry.GetIndex();
+        auto index = static_cast<const SecondaryIndexDataHead *>(index_handle_head.GetData());
+        const u32 index_data_num = index->GetDataNum();
+        if (index_data_num < SegmentRowActualCount()) {
+            UnrecoverableError("FilterResult::ExecuteEncodedKeyRange(): index_data_num < SegmentRowActualCount(). index error.");
+        }
+        if (index_data_num == 0) {
+            return SetEmptyResult();
+        }
+        EncodedKeyReader reader(index_entry, index->GetPartCapacity());
+        // [begin_pos, end_pos) of the sorted keys
+        u32 begin_pos = EncodedKeyLowerBound(index, reader, key_range.BeginKey());
+        u32 end_pos = key_range.EndKey() ? EncodedKeyLowerBound(index, reader, *key_range.EndKey()) : index_data_num;
+        if (end_pos <= begin_pos) {
+            return SetEmptyResult();
+        }
+        u32 result_size = end_pos - begin_pos;
+        // use array when result_size <= 1024 or size of array (u32 type) <= size of bitmask
+        bool use_array = result_size <= 1024 or result_size <= (std::bit_ceil(SegmentRowCount()) / 32);
+        if (use_array) {
+            auto &selected_rows = selected_rows_.emplace<Vector<u32>>();
+            selected_rows.reserve(result_size);
+            for (u32 pos = begin_pos; pos < end_pos; ++pos) {
+                selected_rows.emplace_back(reader.Offset(pos));
+            }
+            std::sort(selected_rows.begin(), selected_rows.end());
+        } else {
+            auto &bitmask = selected_rows_.emplace<Bitmask>();
+            bitmask.Initialize(std::bit_ceil(SegmentRowCount()));
+            bitmask.SetAllFalse();
+            for (u32 pos = begin_pos; pos < end_pos; ++pos) {
+                bitmask.SetTrue(reader.Offset(pos));
+            }
+        }
+    }
+
     inline void ExecuteSingleRange(const HashMap<ColumnID, TableIndexEntry *> &column_index_map,
                                    const FilterExecuteSingleRange &single_range,
                                    SegmentID segment_id) {
@@ -427,9 +568,20 @@ public:
         SegmentIndexEntry &index_entry = *(index_by_segment.at(segment_id));
         // step 3. search index
         auto &interval_range_variant = single_range.GetIntervalRange();
+        bool encoded_key_index = false;
+        {
+            BufferHandle index_handle_head = index_entry.GetIndex();
+            encoded_key_index = static_cast<const SecondaryIndexDataHead *>(index_handle_head.GetData())->IsEncodedKey();
+        }
         std::visit(Overload{[&]<typename ColumnValueType>(const FilterIntervalRangeT<ColumnValueType> &interval_range) {
-                                ExecuteSingleRangeT(interval_range, index_entry, segment_id);
+                                if (encoded_key_index) {
+                                    // the column is the leading column of an index on several columns
+                                    ExecuteEncodedKeyRange(interval_range.ToEncodedKeyRange(), index_entry);
+                                } else {
+                                    ExecuteSingleRangeT(interval_range, index_entry, segment_id);
+                                }
                             },
+                            [&](const FilterEncodedKeyRange &key_range) { ExecuteEncodedKeyRange(key_range, index_entry); },
                             [](const std::monostate &empty) {
                                 UnrecoverableError("FilterResult::ExecuteSingleRange(): class member interval_range_ not initialized!");
                             }},
@@ -53,6 +53,7 @@ public:
                                Vector<FilterExecuteElem> &&filter_execute_command,
                                UniquePtr<FastRoughFilterEvaluator> &&fast_rough_filter_evaluator,
                                SharedPtr<Vector<LoadMeta>> load_metas,
+                               Optional<f64> estimated_row_count,
                                bool add_row_id = true);
 
     ~PhysicalIndexScan() final = default;
@@ -77,6 +78,9 @@ public:
 
     Vector<UniquePtr<Vector<SegmentID>>> PlanSegments(u32 parallel_count) const;
 
+    // Blocks the selected rows are estimated to be read from, all the blocks of the table without statistics.
+    SizeT EstimatedBlockCount() const;
+
     inline String table_alias() const { return base_table_ref_->alias_; }
 
     inline u64 TableIndex() const { return base_table_ref_->table_index_; }
@@ -100,6 +104,9 @@ private:
 
     UniquePtr<FastRoughFilterEvaluator> fast_rough_filter_evaluator_{};
 
+    // input from cost based optimizer
+    Optional<f64> estimated_row_count_{};
+
     bool add_row_id_{};
     mutable Vector<SizeT> column_ids_{};
 };
@@ -65,6 +65,7 @@ import block_entry;
 import segment_index_entry;
 import segment_entry;
 import abstract_hnsw;
+import row_id_gather;
 
 namespace infinity {
 
@@ -513,6 +514,14 @@ void PhysicalKnnScan::ExecuteInternal(QueryContext *query_context, KnnScanOperat
             do {
                 auto data_block = DataBlock::MakeUniquePtr();
                 data_block->Init(*GetOutputTypes());
+                if (!materialize_columns_) {
+                    // The table columns are left as empty constant vectors.
+                    for (SizeT i = 0; i < base_table_ref_->column_ids_.size(); ++i) {
+                        auto column_vector = ColumnVector::Make(data_block->column_vectors[i]->data_type());
+                        column_vector->Initialize(ColumnVectorType::kConstant, 1);
+                        data_block->column_vectors[i] = std::move(column_vector);
+                    }
+                }
                 operator_state->data_block_array_.emplace_back(std::move(data_block));
                 row_idx += DEFAULT_BLOCK_CAPACITY;
             } while (row_idx < total_data_row_count);
@@ -521,23 +530,12 @@ void PhysicalKnnScan::ExecuteInternal(QueryContext *query_context, KnnScanOperat
         SizeT output_block_row_id = 0;
         SizeT output_block_idx = 0;
         DataBlock *output_block_ptr = operator_state->data_block_array_[output_block_idx].get();
+        SizeT column_n = base_table_ref_->column_ids_.size();
         for (u64 query_idx = 0; query_idx < knn_scan_shared_data->query_count_; ++query_idx) {
             DataType *result_dists = merge_heap->GetDistancesByIdx(query_idx);
             RowID *row_ids = merge_heap->GetIDsByIdx(query_idx);
 
-            for (i64 top_idx = 0; top_idx < result_n; ++top_idx) {
-                SizeT id = query_idx * knn_scan_shared_data->query_count_ + top_idx;
-
-                SegmentID segment_id = row_ids[top_idx].segment_id_;
-                SegmentOffset segment_offset = row_ids[top_idx].segment_offset_;
-                BlockID block_id = segment_offset / DEFAULT_BLOCK_CAPACITY;
-                BlockOffset block_offset = segment_offset % DEFAULT_BLOCK_CAPACITY;
-
-                BlockEntry *block_entry = block_index->GetBlockEntry(segment_id, block_id);
-                if (block_entry == nullptr) {
-                    UnrecoverableError(fmt::format("Cannot find block segment id: {}, block id: {}", segment_id, block_id));
-                }
-
+            for (i64 top_idx = 0; top_idx < result_n;) {
                 if (output_block_row_id == DEFAULT_BLOCK_CAPACITY) {
                     output_block_ptr->Finalize();
                     ++output_block_idx;
@@ -545,18 +543,20 @@ void PhysicalKnnScan::ExecuteInternal(QueryContext *query_context, KnnScanOperat
                     output_block_row_id = 0;
                 }
 
-                SizeT column_n = base_table_ref_->column_ids_.size();
-                for (SizeT i = 0; i < column_n; ++i) {
-                    SizeT column_id = base_table_ref_->column_ids_[i];
-                    auto *block_column_entry = block_entry->GetColumnBlockEntry(column_id);
-                    ColumnVector &&column_vector = block_column_entry->GetColumnVector(query_context->storage()->buffer_manager());
-
-                    output_block_ptr->column_vectors[i]->AppendWith(column_vector, block_offset, 1);
+                i64 output_count = std::min<i64>(result_n - top_idx, DEFAULT_BLOCK_CAPACITY - output_block_row_id);
+                if (materialize_columns_) {
+                    Vector<ColumnVector *> column_vectors;
+                    for (SizeT i = 0; i < column_n; ++i) {
+                        column_vectors.push_back(output_block_ptr->column_vectors[i].get());
+                    }
+                    BufferManager *buffer_mgr = query_context->storage()->buffer_manager();
+                    GatherByRowID(block_index, buffer_mgr, row_ids + top_idx, output_count, base_table_ref_->column_ids_, column_vectors);
                 }
-                output_block_ptr->AppendValueByPtr(column_n, (ptr_t)&result_dists[id]);
-                output_block_ptr->AppendValueByPtr(column_n + 1, (ptr_t)&row_ids[id]);
-
-                ++output_block_row_id;
+                for (i64 end_idx = top_idx + output_count; top_idx < end_idx; ++top_idx) {
+                    output_block_ptr->AppendValueByPtr(column_n, (ptr_t)&result_dists[top_idx]);
+                    output_block_ptr->AppendValueByPtr(column_n + 1, (ptr_t)&row_ids[top_idx]);
+                }
+                output_block_row_id += output_count;
             }
         }
         output_block_ptr->Finalize();
@@ -100,6 +100,10 @@ public:
     UniquePtr<Vector<BlockColumnEntry *>> block_column_entries_{};
     UniquePtr<Vector<SegmentIndexEntry *>> index_entries_{};
 
+    // False when a merge operator fetches the table columns of the merged top k,
+    // then each task only outputs the distances and row ids of its top k.
+    bool materialize_columns_{true};
+
 private:
     template <typename DataType, template <typename, typename> typename C>
     void ExecuteInternal(QueryContext *query_context, KnnScanOperatorState *operator_state);
@@ -14,6 +14,7 @@
 
 module;
 
+#include <algorithm>
 #include <string>
 
 module physical_match;
@@ -38,8 +39,8 @@ import value;
 import third_party;
 import base_table_ref;
 import load_meta;
-import block_entry;
-import block_column_entry;
+import row_id_gather;
+import buffer_manager;
 import logical_type;
 import search_options;
 import status;
@@ -47,6 +48,7 @@ import index_defines;
 import search_driver;
 import query_node;
 import query_builder;
+import match_data;
 import doc_iterator;
 import knn_result_handler;
 import logger;
@@ -63,6 +65,11 @@ void AnalyzeFunc(const String &analyzer_name, String &&text, TermList &output_te
     analyzer->Analyze(input_term, output_terms);
 }
 
+void NormalizeFunc(const String &analyzer_name, String &text) {
+    UniquePtr<Analyzer> analyzer = AnalyzerPool::instance().Get(analyzer_name);
+    analyzer->Normalize(text);
+}
+
 bool ExecuteInnerHomebrewed(QueryContext *query_context,
                             OperatorState *operator_state,
                             SharedPtr<BaseTableRef> &base_table_ref_,
@@ -80,6 +87,7 @@ bool ExecuteInnerHomebrewed(QueryContext *query_context,
     // 1.3 build filter
     SearchDriver driver(column2analyzer, default_field);
     driver.analyze_func_ = reinterpret_cast<void (*)()>(&AnalyzeFunc);
+    driver.normalize_func_ = reinterpret_cast<void (*)()>(&NormalizeFunc);
     UniquePtr<QueryNode> query_tree = driver.ParseSingleWithFields(match_expr_->fields_, match_expr_->matching_text_);
     if (!query_tree) {
         RecoverableError(Status::ParseMatchExprFailed(match_expr_->fields_, match_expr_->matching_text_));
@@ -113,12 +121,20 @@ bool ExecuteInnerHomebrewed(QueryContext *query_context,
         result_handler.Begin();
         // prepare query_builder
         query_builder.LoadScorerColumnLength(iter_row_id);
+        // score in batches, term frequencies are collected while the iterators are positioned on each doc
+        RowID batch_row_ids[Scorer::BATCH_SIZE];
+        float batch_scores[Scorer::BATCH_SIZE];
         do {
-            // call scorer
-            float score = query_builder.Score(iter_row_id);
-            result_handler.AddResult(0, score, iter_row_id);
+            batch_row_ids[query_builder.CollectedScoreDocCount()] = iter_row_id;
+            query_builder.CollectScoreDoc(iter_row_id);
             // get next row_id
             iter_row_id = doc_iterator->Next();
+            if (u32 batch_size = query_builder.CollectedScoreDocCount(); batch_size == Scorer::BATCH_SIZE || iter_row_id == INVALID_ROWID) {
+                query_builder.ScoreCollected(batch_scores);
+                for (u32 i = 0; i < batch_size; ++i) {
+                    result_handler.AddResult(0, batch_scores[i], batch_row_ids[i]);
+                }
+            }
         } while (iter_row_id != INVALID_ROWID);
         result_handler.End();
         result_count = result_handler.GetSize(0);
@@ -138,34 +154,27 @@ bool ExecuteInnerHomebrewed(QueryContext *query_context,
     {
         Vector<SizeT> &column_ids = base_table_ref_->column_ids_;
         SizeT column_n = column_ids.size();
-        u32 block_capacity = DEFAULT_BLOCK_CAPACITY;
-        u32 output_block_row_id = 0;
-        DataBlock *output_block_ptr = output_data_blocks.back().get();
-        for (u32 output_id = 0; output_id < result_count; ++output_id) {
-            if (output_block_row_id == block_capacity) {
-                output_block_ptr->Finalize();
+        BufferManager *buffer_mgr = query_context->storage()->buffer_manager();
+        for (u32 output_begin = 0; output_begin < result_count; output_begin += DEFAULT_BLOCK_CAPACITY) {
+            if (output_begin > 0) {
+                output_data_blocks.back()->Finalize();
                 append_data_block();
-                output_block_ptr = output_data_blocks.back().get();
-                output_block_row_id = 0;
             }
-            RowID &row_id = row_id_result[output_id];
-            u32 segment_id = row_id.segment_id_;
-            u32 segment_offset = row_id.segment_offset_;
-            u16 block_id = segment_offset / DEFAULT_BLOCK_CAPACITY;
-            u16 block_offset = segment_offset % DEFAULT_BLOCK_CAPACITY;
-            const BlockEntry *block_entry = base_table_ref_->block_index_->GetBlockEntry(segment_id, block_id);
-            SizeT column_id = 0;
-            for (; column_id < column_n; ++column_id) {
-                BlockColumnEntry *block_column_ptr = block_entry->GetColumnBlockEntry(column_ids[column_id]);
-                ColumnVector column_vector = block_column_ptr->GetColumnVector(query_context->storage()->buffer_manager());
-                output_block_ptr->column_vectors[column_id]->AppendWith(column_vector, block_offset, 1);
+            DataBlock *output_block_ptr = output_data_blocks.back().get();
+            u32 output_count = std::min<u32>(result_count - output_begin, DEFAULT_BLOCK_CAPACITY);
+            Vector<ColumnVector *> column_vectors;
+            for (SizeT column_id = 0; column_id < column_n; ++column_id) {
+                column_vectors.push_back(output_block_ptr->column_vectors[column_id].get());
+            }
+            const RowID *row_ids = row_id_result.get() + output_begin;
+            GatherByRowID(base_table_ref_->block_index_.get(), buffer_mgr, row_ids, output_count, column_ids, column_vectors);
+            for (u32 output_id = output_begin; output_id < output_begin + output_count; ++output_id) {
+                Value v = Value::MakeFloat(score_result[output_id]);
+                output_block_ptr->column_vectors[column_n]->AppendValue(v);
+                output_block_ptr->column_vectors[column_n + 1]->AppendWith(row_id_result[output_id], 1);
             }
-            Value v = Value::MakeFloat(score_result[output_id]);
-            output_block_ptr->column_vectors[column_id++]->AppendValue(v);
-            output_block_ptr->column_vectors[column_id]->AppendWith(row_id, 1);
-            ++output_block_row_id;
         }
-        output_block_ptr->Finalize();
+        output_data_blocks.back()->Finalize();
     }
 
     operator_state->SetComplete();
@@ -31,7 +31,7 @@ import merge_knn;
 import block_index;
 import buffer_manager;
 import third_party;
-import block_entry;
+import row_id_gather;
 import default_values;
 import data_block;
 import knn_expression;
@@ -112,21 +112,11 @@ void PhysicalMergeKnn::ExecuteInner(QueryContext *query_context, MergeKnnOperato
 
         u64 output_row_count{0};
         i64 result_n = std::min(merge_knn_data.topk_, merge_knn->total_count());
+        SizeT column_n = table_ref_->column_ids_.size();
         for (i64 query_idx = 0; query_idx < merge_knn_data.query_count_; ++query_idx) {
             DataType *result_dists = merge_knn->GetDistancesByIdx(query_idx);
             RowID *result_row_ids = merge_knn->GetIDsByIdx(query_idx);
-            for (i64 top_idx = 0; top_idx < result_n; ++top_idx) {
-                u32 segment_id = result_row_ids[top_idx].segment_id_;
-                u32 segment_offset = result_row_ids[top_idx].segment_offset_;
-                u16 block_id = segment_offset / DEFAULT_BLOCK_CAPACITY;
-                u16 block_offset = segment_offset % DEFAULT_BLOCK_CAPACITY;
-                // LOG_TRACE(fmt::format("Row offset: {}: {}: {}, distance: {}", segment_id, block_id, block_offset, result_dists[top_idx]));
-
-                BlockEntry *block_entry = block_index->GetBlockEntry(segment_id, block_id);
-                if (block_entry == nullptr) {
-                    UnrecoverableError(fmt::format("Cannot find block segment id: {}, block id: {}", segment_id, block_id));
-                }
-
+            for (i64 top_idx = 0; top_idx < result_n;) {
                 DataBlock *output_data_block = merge_knn_state->data_block_array_.back().get();
                 if (output_row_count == DEFAULT_BLOCK_CAPACITY) {
                     output_data_block->Finalize();
@@ -136,19 +126,19 @@ void PhysicalMergeKnn::ExecuteInner(QueryContext *query_context, MergeKnnOperato
                     output_row_count -= DEFAULT_BLOCK_CAPACITY;
                 }
 
-                SizeT column_n = table_ref_->column_ids_.size();
+                // The table columns of the merged top k are fetched at once, grouped by block.
+                i64 output_count = std::min<i64>(result_n - top_idx, DEFAULT_BLOCK_CAPACITY - output_row_count);
+                Vector<ColumnVector *> column_vectors;
                 for (SizeT i = 0; i < column_n; ++i) {
-                    SizeT column_id = table_ref_->column_ids_[i];
-                    ColumnVector &&column_vector = block_entry->GetColumnBlockEntry(column_id)->GetColumnVector(buffer_mgr);
-                    output_data_block->column_vectors[i]->AppendWith(column_vector, block_offset, 1);
+                    column_vectors.push_back(output_data_block->column_vectors[i].get());
+                }
+                GatherByRowID(block_index, buffer_mgr, result_row_ids + top_idx, output_count, table_ref_->column_ids_, column_vectors);
+                for (i64 end_idx = top_idx + output_count; top_idx < end_idx; ++top_idx) {
+                    output_data_block->AppendValueByPtr(column_n, (ptr_t)&result_dists[top_idx]);
+                    output_data_block->AppendValueByPtr(column_n + 1, (ptr_t)&result_row_ids[top_idx]);
                 }
-                output_data_block->AppendValueByPtr(column_n, (ptr_t)&result_dists[top_idx]);
-                output_data_block->AppendValueByPtr(column_n + 1, (ptr_t)&result_row_ids[top_idx]);
-                ++output_row_count;
+                output_row_count += output_count;
             }
-            // for (SizeT i = 0; i < column_n; ++i) {
-            //  LOG_TRACE(fmt::format("Output Column ID: {}, Name: {}", merge_knn_data.table_ref_->column_ids_[i], output_names_->at(i)));
-            //}
         }
 
         merge_knn_state->data_block_array_.back()->Finalize();
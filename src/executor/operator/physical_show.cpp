@@ -50,6 +50,7 @@ import status;
 import local_file_system;
 import utility;
 import buffer_manager;
+import catalog;
 import session_manager;
 import compilation_config;
 import logical_type;
@@ -2222,6 +2223,48 @@ void PhysicalShow::ExecuteShowGlobalStatus(QueryContext *query_context, ShowOper
         }
     }
 
+    CheckpointStatistics checkpoint_stats = query_context->storage()->catalog()->GetCheckpointStatistics();
+    {
+        {
+            // option name
+            Value value = Value::MakeVarchar("last checkpoint");
+            ValueExpression value_expr(value);
+            value_expr.AppendToChunk(output_block_ptr->column_vectors[0]);
+        }
+        {
+            // option value
+            String last_checkpoint = "none";
+            if (checkpoint_stats.checkpoint_count_ > 0) {
+                last_checkpoint = fmt::format("{} checkpoint at ts {}, {} written in {} ms",
+                                              checkpoint_stats.is_full_checkpoint_ ? "full" : "delta",
+                                              checkpoint_stats.max_commit_ts_,
+                                              Utility::FormatByteSize(checkpoint_stats.written_bytes_),
+                                              checkpoint_stats.duration_us_ / 1000);
+            }
+            Value value = Value::MakeVarchar(last_checkpoint);
+            ValueExpression value_expr(value);
+            value_expr.AppendToChunk(output_block_ptr->column_vectors[1]);
+        }
+    }
+
+    {
+        {
+            // option name
+            Value value = Value::MakeVarchar("checkpoint total");
+            ValueExpression value_expr(value);
+            value_expr.AppendToChunk(output_block_ptr->column_vectors[0]);
+        }
+        {
+            // option value
+            Value value = Value::MakeVarchar(fmt::format("{} checkpoints, {} written in {} ms",
+                                                         checkpoint_stats.checkpoint_count_,
+                                                         Utility::FormatByteSize(checkpoint_stats.total_written_bytes_),
+                                                         checkpoint_stats.total_duration_us_ / 1000));
+            ValueExpression value_expr(value);
+            value_expr.AppendToChunk(output_block_ptr->column_vectors[1]);
+        }
+    }
+
     {
         {
             // option name
@@ -14,6 +14,9 @@
 
 module;
 
+#include <algorithm>
+#include <chrono>
+#include <future>
 #include <string>
 
 module physical_table_scan;
@@ -40,8 +43,17 @@ import logger;
 import column_vector;
 import infinity_exception;
 import logical_type;
+import column_block_encoding;
 
 import block_entry;
+import segment_entry;
+import fast_rough_filter;
+import top_n_boundary;
+import block_column_entry;
+import buffer_manager;
+import buffer_obj;
+import buffer_handle;
+import config;
 
 namespace infinity {
 
@@ -97,25 +109,42 @@ Vector<SizeT> &PhysicalTableScan::ColumnIDs() const {
     return column_ids_;
 }
 
-Vector<SharedPtr<Vector<GlobalBlockID>>> PhysicalTableScan::PlanBlockEntries(i64 parallel_count) const {
+Vector<SharedPtr<TableScanMorselSource>> PhysicalTableScan::PlanMorsels(i64 parallel_count) const {
     BlockIndex *block_index = base_table_ref_->block_index_.get();
-
-    u64 all_block_count = block_index->BlockCount();
-    u64 block_per_task = all_block_count / parallel_count;
-    u64 residual = all_block_count % parallel_count;
-
-    Vector<SharedPtr<Vector<GlobalBlockID>>> result(parallel_count, nullptr);
-    for (SizeT task_id = 0, global_block_id = 0, residual_idx = 0; (i64)task_id < parallel_count; ++task_id) {
-        result[task_id] = MakeShared<Vector<GlobalBlockID>>();
-        for (u64 block_id_in_task = 0; block_id_in_task < block_per_task; ++block_id_in_task) {
-            result[task_id]->emplace_back(block_index->global_blocks_[global_block_id++]);
-        }
-        if (residual_idx < residual) {
-            result[task_id]->emplace_back(block_index->global_blocks_[global_block_id++]);
-            ++residual_idx;
+    if (top_n_boundary_.get() == nullptr) {
+        // Each task scans a contiguous range of blocks, so the results joined task by task stay in row id order.
+        u64 all_block_count = block_index->BlockCount();
+        u64 block_per_task = all_block_count / parallel_count;
+        u64 residual = all_block_count % parallel_count;
+
+        Vector<SharedPtr<TableScanMorselSource>> result;
+        result.reserve(parallel_count);
+        for (SizeT task_id = 0, global_block_id = 0; (i64)task_id < parallel_count; ++task_id) {
+            SizeT task_block_count = block_per_task + (task_id < residual ? 1 : 0);
+            auto begin = block_index->global_blocks_.begin() + global_block_id;
+            result.emplace_back(MakeShared<TableScanMorselSource>(Vector<GlobalBlockID>(begin, begin + task_block_count)));
+            global_block_id += task_block_count;
         }
+        return result;
+    }
+
+    // The most promising blocks first, so every task tightens the boundary early and skips most of the blocks it claims later.
+    // Blocks without a min max filter can't be skipped, they are read first.
+    Vector<Pair<f64, GlobalBlockID>> ordered_blocks;
+    ordered_blocks.reserve(block_index->BlockCount());
+    for (const GlobalBlockID &global_block_id : block_index->global_blocks_) {
+        BlockEntry *block_entry = block_index->GetBlockEntry(global_block_id.segment_id_, global_block_id.block_id_);
+        Optional<f64> key = top_n_boundary_->ScanOrderKey(*block_entry->GetFastRoughFilter());
+        ordered_blocks.emplace_back(key.value_or(-std::numeric_limits<f64>::infinity()), global_block_id);
     }
-    return result;
+    std::stable_sort(ordered_blocks.begin(), ordered_blocks.end(), [](const auto &x, const auto &y) { return x.first < y.first; });
+    Vector<GlobalBlockID> global_block_ids;
+    global_block_ids.reserve(ordered_blocks.size());
+    for (const auto &[key, global_block_id] : ordered_blocks) {
+        global_block_ids.emplace_back(global_block_id);
+    }
+    // The result is sorted afterwards, so all tasks share one source and claim the blocks in whatever order they race.
+    return Vector<SharedPtr<TableScanMorselSource>>(parallel_count, MakeShared<TableScanMorselSource>(std::move(global_block_ids)));
 }
 
 void PhysicalTableScan::ExecuteInternal(QueryContext *query_context, TableScanOperatorState *table_scan_operator_state) {
@@ -129,10 +158,10 @@ void PhysicalTableScan::ExecuteInternal(QueryContext *query_context, TableScanOp
 
     TableScanFunctionData *table_scan_function_data_ptr = table_scan_operator_state->table_scan_function_data_.get();
     const BlockIndex *block_index = table_scan_function_data_ptr->block_index_;
-    Vector<GlobalBlockID> *block_ids = table_scan_function_data_ptr->global_block_ids_.get();
+    Vector<GlobalBlockID> *block_ids = &table_scan_function_data_ptr->global_block_ids_;
     const Vector<SizeT> &column_ids = table_scan_function_data_ptr->column_ids_;
     u64 &block_ids_idx = table_scan_function_data_ptr->current_block_ids_idx_;
-    if (block_ids_idx >= block_ids->size()) {
+    if (!table_scan_function_data_ptr->ClaimBlocks(block_ids_idx)) {
         // No data or all data is read
         table_scan_operator_state->SetComplete();
         return;
@@ -140,6 +169,7 @@ void PhysicalTableScan::ExecuteInternal(QueryContext *query_context, TableScanOp
 
     TxnTimeStamp begin_ts = query_context->GetTxn()->BeginTS();
     SizeT &read_offset = table_scan_function_data_ptr->current_read_offset_;
+    table_scan_function_data_ptr->read_ahead_depth_ = query_context->global_config()->read_ahead_depth();
 
     {
         String out;
@@ -151,7 +181,9 @@ void PhysicalTableScan::ExecuteInternal(QueryContext *query_context, TableScanOp
 
     // Here we assume output is a fresh data block, we have never written anything into it.
     auto write_capacity = output_ptr->available_capacity();
-    while (block_ids_idx < block_ids->size()) {
+    while (table_scan_function_data_ptr->ClaimBlocks(block_ids_idx)) {
+        ReadAhead(query_context, table_scan_function_data_ptr, begin_ts);
+
         u32 segment_id = block_ids->at(block_ids_idx).segment_id_;
         u16 block_id = block_ids->at(block_ids_idx).block_id_;
 
@@ -171,6 +203,13 @@ void PhysicalTableScan::ExecuteInternal(QueryContext *query_context, TableScanOp
                                       block_ids_idx,
                                       block_ids->size()));
             }
+            if (SkipByTopNBoundary(begin_ts, block_index, segment_id, fast_rough_filter)) {
+                LOG_TRACE(fmt::format("TableScan: block_ids_idx: {}, block_ids.size(): {}, skipped by the top-N boundary",
+                                      block_ids_idx,
+                                      block_ids->size()));
+                ++block_ids_idx;
+                continue;
+            }
         }
         auto [row_begin, row_end] = current_block_entry->GetVisibleRange(begin_ts, read_offset);
         if (row_begin == row_end) {
@@ -186,30 +225,119 @@ void PhysicalTableScan::ExecuteInternal(QueryContext *query_context, TableScanOp
         auto write_size = std::min(write_capacity, SizeT(row_end - row_begin));
 
         read_offset = row_begin;
+        // Only a fresh output block can take encoded columns, since they can't be appended to.
+        bool encode_columns = emit_encoded_columns_ && write_capacity == output_ptr->capacity();
+        bool encoded = false;
         SizeT output_column_id{0};
         for (auto column_id : column_ids) {
             if (column_id == COLUMN_IDENTIFIER_ROW_ID) {
                 u32 segment_offset = block_id * DEFAULT_BLOCK_CAPACITY + read_offset;
                 output_ptr->column_vectors[output_column_id++]->AppendWith(RowID(segment_id, segment_offset), write_size);
             } else {
-                ColumnVector column_vector =
-                    current_block_entry->GetColumnBlockEntry(column_id)->GetColumnVector(query_context->storage()->buffer_manager());
-                output_ptr->column_vectors[output_column_id++]->AppendWith(column_vector, read_offset, write_size);
+                BlockColumnEntry *column_block_entry = current_block_entry->GetColumnBlockEntry(column_id);
+                ColumnVector column_vector = column_block_entry->GetColumnVector(query_context->storage()->buffer_manager());
+                SharedPtr<ColumnBlockDictionary> dictionary = encode_columns ? column_block_entry->GetDictionary() : nullptr;
+                if (dictionary.get() != nullptr && dictionary->EntryCount() <= DEFAULT_VECTOR_SIZE) {
+                    auto encoded_column = MakeShared<ColumnVector>(column_vector.data_type());
+                    encoded_column->InitializeEncoded(column_vector, *dictionary, read_offset, write_size);
+                    output_ptr->column_vectors[output_column_id++] = std::move(encoded_column);
+                    encoded = true;
+                } else {
+                    output_ptr->column_vectors[output_column_id++]->AppendWith(column_vector, read_offset, write_size);
+                }
             }
         }
 
         // write_size = already read size = already write size
         write_capacity -= write_size;
         read_offset += write_size;
+        if (encoded) {
+            break;
+        }
     }
 
     LOG_TRACE(fmt::format("TableScan: block_ids_idx: {}, block_ids.size(): {}", block_ids_idx, block_ids->size()));
 
-    if (block_ids_idx >= block_ids->size()) {
+    if (!table_scan_function_data_ptr->ClaimBlocks(block_ids_idx)) {
         table_scan_operator_state->SetComplete();
     }
 
     output_ptr->Finalize();
 }
 
+void PhysicalTableScan::ReadAhead(QueryContext *query_context, TableScanFunctionData *table_scan_function_data, TxnTimeStamp begin_ts) const {
+    u64 read_ahead_depth = table_scan_function_data->read_ahead_depth_;
+    if (read_ahead_depth == 0) {
+        return;
+    }
+    const BlockIndex *block_index = table_scan_function_data->block_index_;
+    const Vector<GlobalBlockID> &block_ids = table_scan_function_data->global_block_ids_;
+    const Vector<SizeT> &column_ids = table_scan_function_data->column_ids_;
+    u64 block_ids_idx = table_scan_function_data->current_block_ids_idx_;
+    Deque<ReadAheadBlock> &read_ahead_blocks = table_scan_function_data->read_ahead_blocks_;
+
+    // The scan moved past these blocks, release their buffers.
+    while (!read_ahead_blocks.empty() && read_ahead_blocks.front().block_ids_idx_ < block_ids_idx) {
+        read_ahead_blocks.pop_front();
+    }
+    if (!read_ahead_blocks.empty() && read_ahead_blocks.front().block_ids_idx_ == block_ids_idx && !read_ahead_blocks.front().reached_) {
+        // A block whose loads are still running is waited for by the scan in BufferObj::Load. A failed load leaves the buffer unloaded,
+        // so the scan loads it again there.
+        ReadAheadBlock &current_block = read_ahead_blocks.front();
+        current_block.reached_ = true;
+        bool ready = std::all_of(current_block.handles_.begin(), current_block.handles_.end(), [](const std::future<BufferHandle> &handle) {
+            return handle.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+        });
+        if (ready) {
+            ++table_scan_function_data->read_ahead_ready_count_;
+        }
+    }
+
+    BufferManager *buffer_mgr = query_context->storage()->buffer_manager();
+    u64 &read_ahead_idx = table_scan_function_data->read_ahead_block_ids_idx_;
+    read_ahead_idx = std::max(read_ahead_idx, block_ids_idx + 1);
+    // The blocks to load are claimed now, they stay with this task.
+    for (; read_ahead_idx <= block_ids_idx + read_ahead_depth && table_scan_function_data->ClaimBlocks(read_ahead_idx); ++read_ahead_idx) {
+        const GlobalBlockID &global_block_id = block_ids[read_ahead_idx];
+        BlockEntry *block_entry = block_index->GetBlockEntry(global_block_id.segment_id_, global_block_id.block_id_);
+        const auto &fast_rough_filter = *block_entry->GetFastRoughFilter();
+        if (fast_rough_filter_evaluator_ and !fast_rough_filter_evaluator_->Evaluate(begin_ts, fast_rough_filter)) {
+            // The scan will skip this block
+            continue;
+        }
+        if (SkipByTopNBoundary(begin_ts, block_index, global_block_id.segment_id_, fast_rough_filter)) {
+            // The scan will skip this block too, the boundary only tightens
+            continue;
+        }
+        Vector<BufferObj *> buffer_objs;
+        for (auto column_id : column_ids) {
+            if (column_id != COLUMN_IDENTIFIER_ROW_ID) {
+                block_entry->GetColumnBlockEntry(column_id)->GetBufferObjs(buffer_mgr, buffer_objs);
+            }
+        }
+        ReadAheadBlock read_ahead_block;
+        read_ahead_block.block_ids_idx_ = read_ahead_idx;
+        if (!buffer_mgr->Prefetch(buffer_objs, read_ahead_block.handles_, read_ahead_block.reservation_)) {
+            // Read ahead pins its share of the buffer pool already, try again once the scan moves on.
+            break;
+        }
+        read_ahead_blocks.push_back(std::move(read_ahead_block));
+        ++table_scan_function_data->read_ahead_count_;
+    }
+}
+
+bool PhysicalTableScan::SkipByTopNBoundary(TxnTimeStamp begin_ts,
+                                           const BlockIndex *block_index,
+                                           u32 segment_id,
+                                           const FastRoughFilter &block_filter) const {
+    if (top_n_boundary_.get() == nullptr) {
+        return false;
+    }
+    SegmentEntry *segment_entry = block_index->segment_index_.at(segment_id);
+    if (!top_n_boundary_->Evaluate(begin_ts, *segment_entry->GetFastRoughFilter())) {
+        return true;
+    }
+    return !top_n_boundary_->Evaluate(begin_ts, block_filter);
+}
+
 } // namespace infinity
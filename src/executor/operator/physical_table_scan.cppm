@@ -31,6 +31,8 @@ import load_meta;
 import internal_types;
 import data_type;
 import fast_rough_filter;
+import table_scan_function_data;
+import top_n_boundary;
 
 namespace infinity {
 
@@ -56,7 +58,8 @@ public:
 
     SharedPtr<Vector<SharedPtr<DataType>>> GetOutputTypes() const final;
 
-    Vector<SharedPtr<Vector<GlobalBlockID>>> PlanBlockEntries(i64 parallel_count) const;
+    // The blocks to scan in read order for each task, claimed one at a time. Top-N scans share one source across the tasks.
+    Vector<SharedPtr<TableScanMorselSource>> PlanMorsels(i64 parallel_count) const;
 
     String table_alias() const;
 
@@ -70,6 +73,12 @@ public:
 
     Vector<SizeT> &ColumnIDs() const;
 
+    // Columns of sealed blocks are emitted dictionary / RLE encoded, the consumer must be able to evaluate them.
+    void SetEmitEncodedColumns(bool emit_encoded_columns) { emit_encoded_columns_ = emit_encoded_columns; }
+
+    // Blocks are planned and read the most promising first, and the ones that can't beat the boundary of the top above are skipped.
+    void SetTopNBoundary(SharedPtr<TopNBoundary> top_n_boundary) { top_n_boundary_ = std::move(top_n_boundary); }
+
     bool ParallelExchange() const override { return true; }
 
     bool IsExchange() const override { return true; }
@@ -81,12 +90,21 @@ public:
 private:
     void ExecuteInternal(QueryContext *query_context, TableScanOperatorState *table_scan_operator_state);
 
+    // Keeps the column buffers of the next read_ahead_depth blocks of the task loading in the background.
+    void ReadAhead(QueryContext *query_context, TableScanFunctionData *table_scan_function_data, TxnTimeStamp begin_ts) const;
+
+    // true if the block or its segment can't hold a row reaching the top-N result
+    bool SkipByTopNBoundary(TxnTimeStamp begin_ts, const BlockIndex *block_index, u32 segment_id, const FastRoughFilter &block_filter) const;
+
 private:
     SharedPtr<BaseTableRef> base_table_ref_{};
 
     UniquePtr<FastRoughFilterEvaluator> fast_rough_filter_evaluator_{};
 
+    SharedPtr<TopNBoundary> top_n_boundary_{};
+
     bool add_row_id_;
+    bool emit_encoded_columns_{false};
     mutable Vector<SizeT> column_ids_;
 };
 
@@ -37,6 +37,7 @@ import third_party;
 import status;
 import logical_type;
 import internal_types;
+import top_n_boundary;
 
 namespace infinity {
 
@@ -54,6 +55,8 @@ public:
         WriteToOutput(input_data_block_array, output_data_block_array);
         return size_;
     }
+    // the last row of the sorted result
+    Pair<u32, u32> LastRow() const { return candidate_local_row_ids_[size_ - 1]; }
 
 private:
     u32 size_{};
@@ -345,6 +348,11 @@ bool PhysicalTop::Execute(QueryContext *, OperatorState *operator_state) {
     auto eval_columns = GetEvalColumns(sort_expressions_, (static_cast<TopOperatorState *>(operator_state))->expr_states_, input_data_block_array);
     TopSolver solve_top(limit_, prefer_left_function_);
     auto output_row_cnt = solve_top.WriteTopResultsToOutput(eval_columns, input_data_block_array, output_data_block_array);
+    if (top_n_boundary_.get() != nullptr and output_row_cnt == limit_) {
+        // limit_ rows sort before or equal to the last one, no other row worse than it on the first key can reach the result
+        auto [block_id, row_id] = solve_top.LastRow();
+        top_n_boundary_->Update(eval_columns[block_id][0], row_id);
+    }
     input_data_block_array.clear();
     HandleOutputOffset(output_row_cnt, offset_, output_data_block_array);
     if (prev_op_state->Complete()) {
@@ -35,6 +35,7 @@ import physical_limit;
 import internal_types;
 import select_statement;
 import data_type;
+import top_n_boundary;
 
 namespace infinity {
 
@@ -103,6 +104,9 @@ public:
     // for MergeTop
     inline auto const &GetInnerCompareFunction() const { return prefer_left_function_; }
 
+    // shared with the other tasks of the top and the table scan below
+    void SetTopNBoundary(SharedPtr<TopNBoundary> top_n_boundary) { top_n_boundary_ = std::move(top_n_boundary); }
+
     // for Top and MergeTop
     static void HandleOutputOffset(u32 total_row_cnt, u32 offset, Vector<UniquePtr<DataBlock>> &output_data_block_array);
 
@@ -122,7 +126,7 @@ private:
     Vector<OrderType> order_by_types_;                   // ASC or DESC
     Vector<SharedPtr<BaseExpression>> sort_expressions_; // expressions to sort
     CompareTwoRowAndPreferLeft prefer_left_function_;    // compare function
-    // TODO: save a common threshold value for all tasks
+    SharedPtr<TopNBoundary> top_n_boundary_;             // common threshold of all tasks on the first sort key, may be nullptr
 };
 
 } // namespace infinity
@@ -29,6 +29,7 @@ import merge_knn_data;
 import create_index_data;
 import blocking_queue;
 import expression_state;
+import expression_selector;
 import status;
 import internal_types;
 import column_def;
@@ -121,6 +122,9 @@ export struct MergeKnnOperatorState : public OperatorState {
 // Filter
 export struct FilterOperatorState : public OperatorState {
     inline explicit FilterOperatorState() : OperatorState(PhysicalOperatorType::kFilter) {}
+
+    // Learns the order of the AND / OR children over the blocks of the task, not shared by multiple tasks.
+    ExpressionSelector selector_{};
 };
 
 // IndexScan
@@ -407,10 +411,10 @@ export struct AggregateSourceState : public SourceState {
 };
 
 export struct TableScanSourceState : public SourceState {
-    explicit TableScanSourceState(SharedPtr<Vector<GlobalBlockID>> global_ids)
-        : SourceState(SourceStateType::kTableScan), global_ids_(std::move(global_ids)) {}
+    explicit TableScanSourceState(SharedPtr<TableScanMorselSource> morsel_source)
+        : SourceState(SourceStateType::kTableScan), morsel_source_(std::move(morsel_source)) {}
 
-    SharedPtr<Vector<GlobalBlockID>> global_ids_;
+    SharedPtr<TableScanMorselSource> morsel_source_;
 };
 
 export struct IndexScanSourceState : public SourceState {
@@ -27,8 +27,7 @@ import query_context;
 import base_table_ref;
 import third_party;
 import infinity_exception;
-import block_entry;
-import block_column_entry;
+import row_id_gather;
 import logical_type;
 import internal_types;
 
@@ -57,34 +56,23 @@ void PhysicalOperator::InputLoad(QueryContext *query_context, OperatorState *ope
         SizeT capacity = input_block->capacity();
 
         // Filling ColumnVector
+        Vector<SizeT> column_ids;
+        Vector<ColumnVector *> column_vectors;
         for (SizeT j = 0; j < load_column_count; ++j) {
             SharedPtr<ColumnVector> column_vector = ColumnVector::Make(load_metas[j].type_);
             auto column_vector_type =
                 (load_metas[j].type_->type() == LogicalType::kBoolean) ? ColumnVectorType::kCompactBit : ColumnVectorType::kFlat;
             column_vector->Initialize(column_vector_type, capacity);
+            column_ids.push_back(load_metas[j].binding_.column_idx);
+            column_vectors.push_back(column_vector.get());
 
             input_block->InsertVector(column_vector, load_metas[j].index_);
         }
 
+        // If late materialization needs to be optional, then this needs to be modified
         auto row_column_id = input_block->column_count() - 1;
-
-        for (SizeT j = 0; j < row_count; ++j) {
-            // If late materialization needs to be optional, then this needs to be modified
-            RowID row_id = input_block->GetValue(row_column_id, j).value_.row;
-            u32 segment_id = row_id.segment_id_;
-            u32 segment_offset = row_id.segment_offset_;
-            u16 block_id = segment_offset / DEFAULT_BLOCK_CAPACITY;
-            u16 block_offset = segment_offset % DEFAULT_BLOCK_CAPACITY;
-
-            const BlockEntry *block_entry = table_ref->block_index_->GetBlockEntry(segment_id, block_id);
-            for (SizeT k = 0; k < load_column_count; ++k) {
-                auto binding = load_metas[k].binding_;
-                BlockColumnEntry *block_column_ptr = block_entry->GetColumnBlockEntry(binding.column_idx);
-
-                ColumnVector column_vector = block_column_ptr->GetColumnVector(query_context->storage()->buffer_manager());
-                input_block->column_vectors[load_metas[k].index_]->AppendWith(column_vector, block_offset, 1);
-            }
-        }
+        const auto *row_ids = reinterpret_cast<const RowID *>(input_block->column_vectors[row_column_id]->data());
+        GatherByRowID(table_ref->block_index_.get(), query_context->storage()->buffer_manager(), row_ids, row_count, column_ids, column_vectors);
     }
 }
 
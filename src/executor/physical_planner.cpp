@@ -124,6 +124,13 @@ import create_index_info;
 import command_statement;
 import explain_statement;
 import load_meta;
+import base_expression;
+import reference_expression;
+import expression_type;
+import logical_type;
+import default_values;
+import select_statement;
+import top_n_boundary;
 
 namespace infinity {
 
@@ -674,6 +681,53 @@ UniquePtr<PhysicalOperator> PhysicalPlanner::BuildLimit(const SharedPtr<LogicalN
     }
 }
 
+namespace {
+
+// Shares the top-N boundary between the top and the table scan feeding it directly or through a filter, whose output columns keep their
+// positions. Only a first sort key reading a column with a min max filter can skip blocks.
+SharedPtr<TopNBoundary>
+MakeTopNBoundary(PhysicalOperator *input, Vector<SharedPtr<BaseExpression>> &sort_expressions, const Vector<OrderType> &order_by_types) {
+    if (input->operator_type() == PhysicalOperatorType::kFilter) {
+        input = input->left();
+    }
+    if (input->operator_type() != PhysicalOperatorType::kTableScan or sort_expressions.empty() or
+        sort_expressions[0]->type() != ExpressionType::kReference) {
+        return nullptr;
+    }
+    switch (sort_expressions[0]->Type().type()) {
+        case LogicalType::kTinyInt:
+        case LogicalType::kSmallInt:
+        case LogicalType::kInteger:
+        case LogicalType::kBigInt:
+        case LogicalType::kHugeInt:
+        case LogicalType::kFloat:
+        case LogicalType::kDouble:
+        case LogicalType::kVarchar:
+        case LogicalType::kDate:
+        case LogicalType::kTime:
+        case LogicalType::kDateTime:
+        case LogicalType::kTimestamp: {
+            break;
+        }
+        default: {
+            return nullptr;
+        }
+    }
+    auto *table_scan = static_cast<PhysicalTableScan *>(input);
+    SizeT column_index = static_pointer_cast<ReferenceExpression>(sort_expressions[0])->column_index();
+    const Vector<SizeT> &column_ids = table_scan->ColumnIDs();
+    if (column_index >= column_ids.size() or column_ids[column_index] == COLUMN_IDENTIFIER_ROW_ID) {
+        return nullptr;
+    }
+    auto top_n_boundary = MakeShared<TopNBoundary>(column_ids[column_index],
+                                                   order_by_types[0] == OrderType::kDesc,
+                                                   PhysicalTop::GenerateSortFunction(order_by_types[0], sort_expressions[0]));
+    table_scan->SetTopNBoundary(top_n_boundary);
+    return top_n_boundary;
+}
+
+} // namespace
+
 UniquePtr<PhysicalOperator> PhysicalPlanner::BuildTop(const SharedPtr<LogicalNode> &logical_operator) const {
     auto logical_operator_top = static_cast<LogicalTop *>(logical_operator.get());
     if (logical_operator_top->right_node()) {
@@ -699,15 +753,20 @@ UniquePtr<PhysicalOperator> PhysicalPlanner::BuildTop(const SharedPtr<LogicalNod
     if (merge_limit >= std::numeric_limits<u32>::max()) {
         RecoverableError(Status::SyntaxError("Limit is too large"));
     }
+    // merge_limit counts the offset rows, so the boundary holds for the top with offset too
+    SharedPtr<TopNBoundary> top_n_boundary =
+        MakeTopNBoundary(input_physical_operator.get(), logical_operator_top->sort_expressions_, logical_operator_top->order_by_types_);
     if (input_physical_operator->TaskletCount() <= 1) {
         // only Top
-        return MakeUnique<PhysicalTop>(logical_operator_top->node_id(),
-                                       std::move(input_physical_operator),
-                                       merge_limit,
-                                       merge_offset, // start from offset
-                                       logical_operator_top->sort_expressions_,
-                                       logical_operator_top->order_by_types_,
-                                       logical_operator_top->load_metas());
+        auto top_op = MakeUnique<PhysicalTop>(logical_operator_top->node_id(),
+                                              std::move(input_physical_operator),
+                                              merge_limit,
+                                              merge_offset, // start from offset
+                                              logical_operator_top->sort_expressions_,
+                                              logical_operator_top->order_by_types_,
+                                              logical_operator_top->load_metas());
+        top_op->SetTopNBoundary(std::move(top_n_boundary));
+        return top_op;
     } else {
         // need MergeTop
         auto child_top_op = MakeUnique<PhysicalTop>(logical_operator_top->node_id(),
@@ -717,6 +776,7 @@ UniquePtr<PhysicalOperator> PhysicalPlanner::BuildTop(const SharedPtr<LogicalNod
                                                     logical_operator_top->sort_expressions_,
                                                     logical_operator_top->order_by_types_,
                                                     logical_operator_top->load_metas());
+        child_top_op->SetTopNBoundary(std::move(top_n_boundary));
         return MakeUnique<PhysicalMergeTop>(query_context_ptr_->GetNextNodeID(),
                                             logical_operator_top->base_table_ref_,
                                             std::move(child_top_op),
@@ -755,6 +815,10 @@ UniquePtr<PhysicalOperator> PhysicalPlanner::BuildFilter(const SharedPtr<Logical
     }
 
     auto input_physical_operator = BuildPhysicalOperator(input_logical_node);
+    if (input_physical_operator->operator_type() == PhysicalOperatorType::kTableScan) {
+        // The filter evaluates encoded columns once per dictionary entry and decodes the rows it selects.
+        static_cast<PhysicalTableScan *>(input_physical_operator.get())->SetEmitEncodedColumns(true);
+    }
 
     SharedPtr<LogicalFilter> logical_filter = static_pointer_cast<LogicalFilter>(logical_operator);
 
@@ -807,6 +871,7 @@ UniquePtr<PhysicalOperator> PhysicalPlanner::BuildIndexScan(const SharedPtr<Logi
                                          std::move(logical_index_scan->filter_execute_command_),
                                          std::move(logical_index_scan->fast_rough_filter_evaluator_),
                                          logical_operator->load_metas(),
+                                         logical_operator->estimated_row_count(),
                                          logical_index_scan->add_row_id_);
 }
 
@@ -877,6 +942,7 @@ UniquePtr<PhysicalOperator> PhysicalPlanner::BuildKnn(const SharedPtr<LogicalNod
     if (knn_scan_op->TaskletCount() == 1) {
         return knn_scan_op;
     } else {
+        knn_scan_op->materialize_columns_ = false;
         return MakeUnique<PhysicalMergeKnn>(query_context_ptr_->GetNextNodeID(),
                                             logical_knn_scan->base_table_ref_,
                                             std::move(knn_scan_op),
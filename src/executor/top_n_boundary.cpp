@@ -0,0 +1,64 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+module;
+
+#include <compare>
+
+module top_n_boundary;
+
+import stl;
+import column_vector;
+import value;
+import fast_rough_filter;
+import filter_expression_push_down_helper;
+import internal_types;
+
+namespace infinity {
+
+void TopNBoundary::Update(const SharedPtr<ColumnVector> &column, u32 row) {
+    if (!column->nulls_ptr_->IsTrue(row)) {
+        // a null has no place in the min max filters
+        return;
+    }
+    std::lock_guard lock(mutex_);
+    if (boundary_column_.get() != nullptr and compare_function_(column, row, boundary_column_, 0) != std::strong_ordering::less) {
+        return;
+    }
+    auto boundary_column = MakeShared<ColumnVector>(column->data_type());
+    boundary_column->Initialize(ColumnVectorType::kFlat, 1);
+    boundary_column->AppendWith(*column, row, 1);
+    boundary_column_ = std::move(boundary_column);
+    boundary_value_ = boundary_column_->GetValue(0);
+}
+
+bool TopNBoundary::EvaluateInner(TxnTimeStamp, const FastRoughFilter &filter) const {
+    std::lock_guard lock(mutex_);
+    if (boundary_column_.get() == nullptr) {
+        return true;
+    }
+    // rows equal to the boundary are kept, they may still win on the next sort keys
+    return filter.MayInRange(column_id_, boundary_value_, descending_ ? FilterCompareType::kGreaterEqual : FilterCompareType::kLessEqual);
+}
+
+Optional<f64> TopNBoundary::ScanOrderKey(const FastRoughFilter &filter) const {
+    Optional<f64> key = filter.GetMinMaxOrderKey(column_id_, descending_);
+    if (key.has_value() and descending_) {
+        return -*key;
+    }
+    return key;
+}
+
+} // namespace infinity
@@ -0,0 +1,64 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+module;
+
+#include <compare>
+
+export module top_n_boundary;
+
+import stl;
+import column_vector;
+import value;
+import fast_rough_filter;
+import filter_expression_push_down_helper;
+import internal_types;
+
+namespace infinity {
+
+// The running top-N boundary of a PhysicalTop on its first sort key, shared by all tasks of the top and the table scan below them.
+// Once a task has limit rows sorting before or equal to the boundary row, a block without such a row can't reach the result, the scan
+// skips the blocks and segments whose min max filter proves it.
+export class TopNBoundary final : public FastRoughFilterEvaluator {
+public:
+    using CompareFunction = std::function<std::strong_ordering(const SharedPtr<ColumnVector> &, u32, const SharedPtr<ColumnVector> &, u32)>;
+
+    TopNBoundary(ColumnID column_id, bool descending, CompareFunction compare_function)
+        : column_id_(column_id), descending_(descending), compare_function_(std::move(compare_function)) {}
+
+    ~TopNBoundary() final = default;
+
+    // row of column is the limit-th row of a sorted top result, the boundary only moves towards the head of the order
+    void Update(const SharedPtr<ColumnVector> &column, u32 row);
+
+    // false if no row of the filtered block or segment sorts before or equal to the boundary
+    bool EvaluateInner(TxnTimeStamp query_ts, const FastRoughFilter &filter) const final;
+
+    // the scan reads blocks in ascending key order, the blocks reaching furthest towards the head of the order first
+    Optional<f64> ScanOrderKey(const FastRoughFilter &filter) const;
+
+    inline ColumnID column_id() const { return column_id_; }
+
+private:
+    const ColumnID column_id_;
+    const bool descending_;
+    const CompareFunction compare_function_;
+
+    mutable std::mutex mutex_;
+    SharedPtr<ColumnVector> boundary_column_{}; // one row, nullptr before the first update
+    Value boundary_value_{Value::MakeNull()};
+};
+
+} // namespace infinity
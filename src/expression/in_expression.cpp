@@ -19,6 +19,7 @@ module;
 import infinity_exception;
 import stl;
 import expression_type;
+import in_value_set;
 
 module in_expression;
 
@@ -58,4 +59,12 @@ String InExpression::ToString() const {
     return op.str();
 }
 
+SharedPtr<InValueSet> InExpression::GetValueSet(const std::function<SharedPtr<InValueSet>()> &build) {
+    std::unique_lock lock(value_set_mutex_);
+    if (value_set_.get() == nullptr) {
+        value_set_ = build();
+    }
+    return value_set_;
+}
+
 } // namespace infinity
@@ -22,6 +22,7 @@ import data_type;
 import stl;
 import logical_type;
 import internal_types;
+import in_value_set;
 
 namespace infinity {
 
@@ -45,9 +46,15 @@ public:
 
     inline InType in_type() const { return in_type_; }
 
+    // The value list is built into a set on the first use and shared by all the tasks evaluating the expression.
+    SharedPtr<InValueSet> GetValueSet(const std::function<SharedPtr<InValueSet>()> &build);
+
 private:
     SharedPtr<BaseExpression> left_operand_ptr_;
     InType in_type_;
+
+    std::mutex value_set_mutex_{};
+    SharedPtr<InValueSet> value_set_{};
 };
 
 } // namespace infinity
@@ -14,6 +14,8 @@
 
 module;
 
+#include <cstring>
+
 module like;
 
 import stl;
@@ -26,19 +28,23 @@ import scalar_function_set;
 import third_party;
 import internal_types;
 import data_type;
+import data_block;
+import column_vector;
+import vector_buffer;
+import fix_heap;
+import bitmask;
 
 namespace infinity {
 
-bool LikeOperator(const ptr_t left_ptr, SizeT left_len, const ptr_t right_ptr, SizeT right_len) {
+namespace {
+
+// General matcher, '_' matches any one character and '%' any characters.
+bool LikeOperator(const char *left_ptr, SizeT left_len, const char *right_ptr, SizeT right_len) {
     SizeT left_idx{0}, right_idx{0};
 
     while (right_idx < right_len) {
-        char left_char = left_ptr[left_idx];
         char right_char = right_ptr[right_idx];
-        if (right_char == '_' or (left_char == right_char)) {
-            ++left_idx;
-            ++right_idx;
-        } else if (right_char == '%') {
+        if (right_char == '%') {
             ++right_idx;
 
             // If there are more than one %
@@ -61,54 +67,203 @@ bool LikeOperator(const ptr_t left_ptr, SizeT left_len, const ptr_t right_ptr, S
 
             // Not matched
             return false;
+        } else if (left_idx < left_len && (right_char == '_' or left_ptr[left_idx] == right_char)) {
+            ++left_idx;
+            ++right_idx;
         } else {
             return false;
         }
     }
 
-    while (right_idx < right_len && right_ptr[right_idx] == '%') {
-        ++right_idx;
+    return left_idx == left_len;
+}
+
+// Position of needle in str, or -1. memchr / memmem are vectorized by libc.
+inline i64 FindLiteral(const char *str, SizeT len, const String &needle) {
+    if (needle.empty()) {
+        return 0;
+    }
+    if (needle.size() > len) {
+        return -1;
     }
+    const void *found = nullptr;
+    if (needle.size() == 1) {
+        found = std::memchr(str, needle[0], len);
+    } else {
+        found = memmem(str, len, needle.data(), needle.size());
+    }
+    return found == nullptr ? -1 : static_cast<const char *>(found) - str;
+}
 
-    return left_idx == left_len && right_idx == right_len;
+inline bool StartsWith(const char *str, SizeT len, const String &literal) {
+    return literal.size() <= len && std::memcmp(str, literal.data(), literal.size()) == 0;
 }
 
-struct LikeFunction {
-    template <typename TA, typename TB, typename TC>
-    static inline void Run(TA, TB, TC &) {
-        UnrecoverableError("Not implement: LikeFunction");
+inline bool EndsWith(const char *str, SizeT len, const String &literal) {
+    return literal.size() <= len && std::memcmp(str + len - literal.size(), literal.data(), literal.size()) == 0;
+}
+
+// Reads the strings of a varchar column vector, without copying the ones stored in one heap chunk.
+class VarcharReader {
+public:
+    explicit VarcharReader(const ColumnVector &column)
+        : data_ptr_(reinterpret_cast<const VarcharT *>(column.data())), fix_heap_mgr_(column.buffer_->fix_heap_mgr_.get()) {}
+
+    inline Pair<const char *, SizeT> operator[](SizeT idx) {
+        const VarcharT &varchar = data_ptr_[idx];
+        if (varchar.IsInlined()) {
+            return {varchar.short_.data_, varchar.length_};
+        }
+        const char *ptr = fix_heap_mgr_->ViewFromHeap(buffer_, varchar.vector_.chunk_id_, varchar.vector_.chunk_offset_, varchar.length_);
+        return {ptr, varchar.length_};
     }
+
+private:
+    const VarcharT *data_ptr_{nullptr};
+    FixHeapManager *fix_heap_mgr_{nullptr};
+    String buffer_{};
 };
 
-template <>
-inline void LikeFunction::Run(VarcharT &, VarcharT &, bool &) {
-    UnrecoverableError("Not implement: varchar like varchar");
+template <bool NOT_LIKE>
+void LikeFunction(const DataBlock &input, SharedPtr<ColumnVector> &output) {
+    if (input.column_count() != 2) {
+        UnrecoverableError("Like function: input column count isn't two.");
+    }
+    if (!input.Finalized()) {
+        UnrecoverableError("Input data block is finalized");
+    }
+    const ColumnVector &left = *input.column_vectors[0];
+    const ColumnVector &right = *input.column_vectors[1];
+    bool left_constant = left.vector_type() == ColumnVectorType::kConstant;
+    bool right_constant = right.vector_type() == ColumnVectorType::kConstant;
+    SizeT count = (left_constant && right_constant) ? 1 : input.row_count();
 
-//    ptr_t left_ptr = left.GetDataPtr();
-//    SizeT left_len = left.GetDataLen();
-//    ptr_t right_ptr = right.GetDataPtr();
-//    SizeT right_len = right.GetDataLen();
+    const Bitmask &left_null = *left.nulls_ptr_;
+    const Bitmask &right_null = *right.nulls_ptr_;
+    Bitmask &result_null = *output->nulls_ptr_;
+    VectorBuffer &result_buffer = *output->buffer_;
+    bool has_null = !left_null.IsAllTrue() || !right_null.IsAllTrue();
+    result_null.SetAllTrue();
 
-//    result = LikeOperator(left_ptr, left_len, right_ptr, right_len);
-}
+    VarcharReader left_reader(left);
+    VarcharReader right_reader(right);
+    // The pattern is almost always a constant, then it's classified once for the whole block.
+    Optional<LikePattern> constant_pattern;
+    if (right_constant && right_null.IsTrue(0)) {
+        auto [pattern_ptr, pattern_len] = right_reader[0];
+        constant_pattern.emplace(pattern_ptr, pattern_len);
+    }
 
-struct NotLikeFunction {
-    template <typename TA, typename TB, typename TC>
-    static inline void Run(TA, TB, TC &) {
-        UnrecoverableError("Not implement: not like function");
+    for (SizeT idx = 0; idx < count; ++idx) {
+        SizeT left_idx = left_constant ? 0 : idx;
+        SizeT right_idx = right_constant ? 0 : idx;
+        if (has_null && (!left_null.IsTrue(left_idx) || !right_null.IsTrue(right_idx))) {
+            result_buffer.SetCompactBit(idx, false);
+            result_null.SetFalse(idx);
+            continue;
+        }
+        auto [str_ptr, str_len] = left_reader[left_idx];
+        bool matched = false;
+        if (constant_pattern.has_value()) {
+            matched = constant_pattern->Match(str_ptr, str_len);
+        } else {
+            auto [pattern_ptr, pattern_len] = right_reader[right_idx];
+            matched = LikePattern(pattern_ptr, pattern_len).Match(str_ptr, str_len);
+        }
+        result_buffer.SetCompactBit(idx, matched != NOT_LIKE);
     }
-};
+    output->Finalize(count);
+}
+
+} // namespace
 
-template <>
-inline void NotLikeFunction::Run(VarcharT &, VarcharT &, bool &) {
-    UnrecoverableError("Not implement: varchar not like varchar");
+LikePattern::LikePattern(const char *pattern, SizeT pattern_len) : pattern_(pattern, pattern_len) {
+    if (pattern_.find('_') != String::npos) {
+        type_ = LikePatternType::kGeneral;
+        return;
+    }
+    anchored_begin_ = pattern_.empty() || pattern_.front() != '%';
+    anchored_end_ = pattern_.empty() || pattern_.back() != '%';
+    SizeT begin = 0;
+    while (begin <= pattern_.size()) {
+        SizeT end = pattern_.find('%', begin);
+        if (end == String::npos) {
+            end = pattern_.size();
+        }
+        if (end > begin) {
+            segments_.emplace_back(pattern_, begin, end - begin);
+        }
+        begin = end + 1;
+    }
 
-//    ptr_t left_ptr = left.GetDataPtr();
-//    SizeT left_len = left.GetDataLen();
-//    ptr_t right_ptr = right.GetDataPtr();
-//    SizeT right_len = right.GetDataLen();
+    if (pattern_.find('%') == String::npos) {
+        type_ = LikePatternType::kExact;
+        if (segments_.empty()) {
+            segments_.emplace_back();
+        }
+    } else if (segments_.size() > 1) {
+        type_ = LikePatternType::kSegments;
+    } else if (segments_.empty()) {
+        // Only '%'s, matches all.
+        type_ = LikePatternType::kPrefix;
+        segments_.emplace_back();
+    } else if (anchored_begin_) {
+        type_ = LikePatternType::kPrefix;
+    } else if (anchored_end_) {
+        type_ = LikePatternType::kSuffix;
+    } else {
+        type_ = LikePatternType::kContains;
+    }
+}
 
-//    result = !LikeOperator(left_ptr, left_len, right_ptr, right_len);
+bool LikePattern::Match(const char *str, SizeT len) const {
+    switch (type_) {
+        case LikePatternType::kExact: {
+            return len == segments_[0].size() && std::memcmp(str, segments_[0].data(), len) == 0;
+        }
+        case LikePatternType::kPrefix: {
+            return StartsWith(str, len, segments_[0]);
+        }
+        case LikePatternType::kSuffix: {
+            return EndsWith(str, len, segments_[0]);
+        }
+        case LikePatternType::kContains: {
+            return FindLiteral(str, len, segments_[0]) >= 0;
+        }
+        case LikePatternType::kSegments: {
+            SizeT begin = 0;
+            SizeT end = len;
+            SizeT first_segment = 0;
+            SizeT last_segment = segments_.size();
+            if (anchored_begin_) {
+                if (!StartsWith(str, len, segments_.front())) {
+                    return false;
+                }
+                begin = segments_.front().size();
+                ++first_segment;
+            }
+            if (anchored_end_) {
+                if (!EndsWith(str + begin, end - begin, segments_.back())) {
+                    return false;
+                }
+                end -= segments_.back().size();
+                --last_segment;
+            }
+            // The leftmost match of each middle segment leaves the most room for the next ones.
+            for (SizeT idx = first_segment; idx < last_segment; ++idx) {
+                i64 pos = FindLiteral(str + begin, end - begin, segments_[idx]);
+                if (pos < 0) {
+                    return false;
+                }
+                begin += pos + segments_[idx].size();
+            }
+            return true;
+        }
+        case LikePatternType::kGeneral: {
+            return LikeOperator(str, len, pattern_.data(), pattern_.size());
+        }
+    }
+    return false;
 }
 
 void RegisterLikeFunction(const UniquePtr<Catalog> &catalog_ptr) {
@@ -119,7 +274,7 @@ void RegisterLikeFunction(const UniquePtr<Catalog> &catalog_ptr) {
     ScalarFunction varchar_like_function(func_name,
                                          {DataType(LogicalType::kVarchar), DataType(LogicalType::kVarchar)},
                                          DataType(kBoolean),
-                                         &ScalarFunction::BinaryFunction<VarcharT, VarcharT, BooleanT, LikeFunction>);
+                                         &LikeFunction<false>);
     function_set_ptr->AddFunction(varchar_like_function);
 
     Catalog::AddFunctionSet(catalog_ptr.get(), function_set_ptr);
@@ -133,10 +288,10 @@ void RegisterNotLikeFunction(const UniquePtr<Catalog> &catalog_ptr) {
     ScalarFunction varchar_not_like_function(func_name,
                                              {DataType(LogicalType::kVarchar), DataType(LogicalType::kVarchar)},
                                              DataType(kBoolean),
-                                             &ScalarFunction::BinaryFunction<VarcharT, VarcharT, BooleanT, NotLikeFunction>);
+                                             &LikeFunction<true>);
     function_set_ptr->AddFunction(varchar_not_like_function);
 
     Catalog::AddFunctionSet(catalog_ptr.get(), function_set_ptr);
 }
 
-} // namespace infinity
\ No newline at end of file
+} // namespace infinity
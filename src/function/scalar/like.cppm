@@ -22,6 +22,33 @@ namespace infinity {
 
 class Catalog;
 
+export enum class LikePatternType : i8 {
+    kExact,    // 'abc'
+    kPrefix,   // 'abc%'
+    kSuffix,   // '%abc'
+    kContains, // '%abc%'
+    kSegments, // 'a%b%c', only '%' wildcards
+    kGeneral,  // with '_' wildcards
+};
+
+// A LIKE pattern classified once, so that the common shapes are matched with memcmp / memchr / memmem instead of backtracking.
+export class LikePattern {
+public:
+    LikePattern(const char *pattern, SizeT pattern_len);
+
+    [[nodiscard]] bool Match(const char *str, SizeT len) const;
+
+    [[nodiscard]] inline LikePatternType type() const { return type_; }
+
+private:
+    LikePatternType type_{LikePatternType::kGeneral};
+    String pattern_{};
+    // Literal parts between the '%'s, the first one is anchored to the begin unless the pattern starts with '%', the last one to the end.
+    Vector<String> segments_{};
+    bool anchored_begin_{false};
+    bool anchored_end_{false};
+};
+
 export void RegisterLikeFunction(const UniquePtr<Catalog> &catalog_ptr);
 
 export void RegisterNotLikeFunction(const UniquePtr<Catalog> &catalog_ptr);
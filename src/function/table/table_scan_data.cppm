@@ -14,27 +14,84 @@
 
 module;
 
+#include <future>
+
 import stl;
 import function_data;
 import table_function;
 import global_block_id;
 import block_index;
+import buffer_handle;
+import buffer_manager;
 
 export module table_scan_function_data;
 
 namespace infinity {
 
+// Column buffers of a block loaded ahead of the table scan, dropped once the scan moves past the block.
+export struct ReadAheadBlock {
+    u64 block_ids_idx_{};
+    // Declared before the handles, so it is given back after they unpin the buffers.
+    ReadAheadReservation reservation_{};
+    Vector<std::future<BufferHandle>> handles_{};
+    bool reached_{false};
+};
+
+// The blocks of a table scan, claimed one block at a time. A plain scan gives each task its own contiguous range, so the output keeps
+// row id order. A top-N scan shares one source across the tasks, so a task that is done early keeps scanning the most promising blocks.
+export class TableScanMorselSource {
+public:
+    explicit TableScanMorselSource(Vector<GlobalBlockID> &&global_block_ids) : global_block_ids_(std::move(global_block_ids)) {}
+
+    // false once all blocks are claimed
+    bool Next(GlobalBlockID &global_block_id) {
+        SizeT idx = next_idx_.fetch_add(1);
+        if (idx >= global_block_ids_.size()) {
+            return false;
+        }
+        global_block_id = global_block_ids_[idx];
+        return true;
+    }
+
+    SizeT BlockCount() const { return global_block_ids_.size(); }
+
+private:
+    const Vector<GlobalBlockID> global_block_ids_;
+    Atomic<SizeT> next_idx_{0};
+};
+
 export class TableScanFunctionData : public TableFunctionData {
 public:
-    TableScanFunctionData(const BlockIndex *block_index, const SharedPtr<Vector<GlobalBlockID>> &global_block_ids, const Vector<SizeT> &column_ids)
-        : block_index_(block_index), global_block_ids_(global_block_ids), column_ids_(column_ids) {}
+    TableScanFunctionData(const BlockIndex *block_index, SharedPtr<TableScanMorselSource> morsel_source, const Vector<SizeT> &column_ids)
+        : block_index_(block_index), morsel_source_(std::move(morsel_source)), column_ids_(column_ids) {}
+
+    // Claims blocks from the morsel source until the one at `block_ids_idx`, false if the source runs out first.
+    bool ClaimBlocks(u64 block_ids_idx) {
+        while (global_block_ids_.size() <= block_ids_idx) {
+            GlobalBlockID global_block_id;
+            if (!morsel_source_->Next(global_block_id)) {
+                return false;
+            }
+            global_block_ids_.emplace_back(global_block_id);
+        }
+        return true;
+    }
 
     const BlockIndex *block_index_{};
-    const SharedPtr<Vector<GlobalBlockID>> &global_block_ids_{};
+    SharedPtr<TableScanMorselSource> morsel_source_{};
+    // blocks claimed by this task, in the order they are read
+    Vector<GlobalBlockID> global_block_ids_{};
     const Vector<SizeT> &column_ids_{};
 
     u64 current_block_ids_idx_{0};
     SizeT current_read_offset_{0};
+
+    u64 read_ahead_depth_{0};
+    u64 read_ahead_block_ids_idx_{0};
+    Deque<ReadAheadBlock> read_ahead_blocks_{};
+    // Blocks loaded ahead, and those of them already in memory when the scan reached them.
+    u64 read_ahead_count_{0};
+    u64 read_ahead_ready_count_{0};
 };
 
 } // namespace infinity
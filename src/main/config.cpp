@@ -163,6 +163,8 @@ Status Config::Init(const SharedPtr<String> &config_path) {
     // Default buffer config
     u64 default_buffer_pool_size = 4 * 1024lu * 1024lu * 1024lu; // 4Gib
     SharedPtr<String> default_temp_dir = MakeShared<String>("/tmp/infinity/temp");
+    u64 default_read_ahead_depth = DEFAULT_READ_AHEAD_DEPTH;
+    u64 default_read_ahead_thread_num = DEFAULT_READ_AHEAD_THREAD_NUM;
 
     // Default wal config
     u64 default_wal_size_threshold = DEFAULT_WAL_FILE_SIZE_THRESHOLD;
@@ -173,11 +175,16 @@ Status Config::Init(const SharedPtr<String> &config_path) {
     u64 delta_checkpoint_interval_wal_bytes = DELTA_CHECKPOINT_INTERVAL_WAL_BYTES;
     SharedPtr<String> default_wal_dir = MakeShared<String>("/tmp/infinity/wal");
     FlushOption default_flush_at_commit = FlushOption::kOnlyWrite;
+    u64 default_wal_compress_threshold = 0;
+    u64 default_checkpoint_io_thread_num = DEFAULT_CHECKPOINT_IO_THREAD_NUM;
+    u64 default_delta_checkpoint_compact_threshold = DEFAULT_DELTA_CHECKPOINT_COMPACT_THRESHOLD;
 
     // Default resource config
     String default_resource_dict_path = String("/tmp/infinity/resource");
     u64 default_cleanup_interval_sec = DEFAULT_CLEANUP_INTERVAL_SEC;
     bool default_enable_compaction = DEFAULT_ENABLE_COMPACTION;
+    u64 default_optimize_interval_sec = DEFAULT_OPTIMIZE_INTERVAL_SEC;
+    u64 default_optimize_io_budget = DEFAULT_OPTIMIZE_IO_BYTES_PER_SEC;
 
     LocalFileSystem fs;
     if (config_path.get() == nullptr || !fs.Exists(*config_path)) {
@@ -243,6 +250,8 @@ Status Config::Init(const SharedPtr<String> &config_path) {
         {
             system_option_.buffer_pool_size = default_buffer_pool_size; // 4Gib
             system_option_.temp_dir = MakeShared<String>(*default_temp_dir);
+            system_option_.read_ahead_depth_ = default_read_ahead_depth;
+            system_option_.read_ahead_thread_num_ = default_read_ahead_thread_num;
         }
 
         // Wal
@@ -253,6 +262,9 @@ Status Config::Init(const SharedPtr<String> &config_path) {
             system_option_.delta_checkpoint_interval_sec_ = delta_checkpoint_interval_sec;
             system_option_.delta_checkpoint_interval_wal_bytes_ = delta_checkpoint_interval_wal_bytes;
             system_option_.flush_at_commit_ = default_flush_at_commit;
+            system_option_.wal_compress_threshold_ = default_wal_compress_threshold;
+            system_option_.checkpoint_io_thread_num_ = default_checkpoint_io_thread_num;
+            system_option_.delta_checkpoint_compact_threshold_ = default_delta_checkpoint_compact_threshold;
         }
 
         // Resource
@@ -260,6 +272,8 @@ Status Config::Init(const SharedPtr<String> &config_path) {
             system_option_.resource_dict_path_ = default_resource_dict_path;
             system_option_.cleanup_interval_ = std::chrono::seconds(default_cleanup_interval_sec);
             system_option_.enable_compaction_ = default_enable_compaction;
+            system_option_.optimize_interval_ = std::chrono::seconds(default_optimize_interval_sec);
+            system_option_.optimize_io_budget_ = default_optimize_io_budget;
         }
     } else {
         fmt::print("Read config from: {}\n", *config_path);
@@ -435,6 +449,11 @@ Status Config::Init(const SharedPtr<String> &config_path) {
             }
 
             system_option_.temp_dir = MakeShared<String>(buffer_config["temp_dir"].value_or("invalid"));
+            system_option_.read_ahead_depth_ = buffer_config["read_ahead_depth"].value_or(default_read_ahead_depth);
+            system_option_.read_ahead_thread_num_ = buffer_config["read_ahead_thread_num"].value_or(default_read_ahead_thread_num);
+            if (system_option_.read_ahead_thread_num_ == 0) {
+                system_option_.read_ahead_thread_num_ = 1;
+            }
         }
 
         // Wal
@@ -461,6 +480,20 @@ Status Config::Init(const SharedPtr<String> &config_path) {
             if (IsEqual(flush_log_str, "flush_per_second")) {
                 system_option_.flush_at_commit_ = FlushOption::kFlushPerSecond;
             }
+            system_option_.wal_compress_threshold_ = default_wal_compress_threshold;
+            if (wal_config["wal_compress_threshold"]) {
+                String wal_compress_threshold_str = wal_config["wal_compress_threshold"].value_or("0KB");
+                Status status = ParseByteSize(wal_compress_threshold_str, system_option_.wal_compress_threshold_);
+                if (!status.ok()) {
+                    return status;
+                }
+            }
+            system_option_.checkpoint_io_thread_num_ = wal_config["checkpoint_io_thread_num"].value_or(default_checkpoint_io_thread_num);
+            if (system_option_.checkpoint_io_thread_num_ == 0) {
+                system_option_.checkpoint_io_thread_num_ = 1;
+            }
+            system_option_.delta_checkpoint_compact_threshold_ =
+                wal_config["delta_checkpoint_compact_threshold"].value_or(default_delta_checkpoint_compact_threshold);
         }
 
         // Resource
@@ -469,6 +502,15 @@ Status Config::Init(const SharedPtr<String> &config_path) {
             system_option_.resource_dict_path_ = resource_config["dictionary_dir"].value_or(default_resource_dict_path);
             system_option_.cleanup_interval_ = std::chrono::seconds(resource_config["cleanup_interval"].value_or(default_cleanup_interval_sec));
             system_option_.enable_compaction_  = resource_config["enable_compaction"].value_or(default_enable_compaction);
+            system_option_.optimize_interval_ = std::chrono::seconds(resource_config["optimize_interval"].value_or(default_optimize_interval_sec));
+            system_option_.optimize_io_budget_ = default_optimize_io_budget;
+            if (resource_config["optimize_io_budget"]) {
+                String optimize_io_budget_str = resource_config["optimize_io_budget"].value_or("64MB");
+                Status status = ParseByteSize(optimize_io_budget_str, system_option_.optimize_io_budget_);
+                if (!status.ok()) {
+                    return status;
+                }
+            }
         }
     }
 
@@ -516,6 +558,8 @@ void Config::PrintAll() const {
     // Buffer
     fmt::print(" - buffer_pool_size: {}\n", Utility::FormatByteSize(system_option_.buffer_pool_size));
     fmt::print(" - temp_dir: {}\n", system_option_.temp_dir->c_str());
+    fmt::print(" - read_ahead_depth: {}\n", system_option_.read_ahead_depth_);
+    fmt::print(" - read_ahead_thread_num: {}\n", system_option_.read_ahead_thread_num_);
 
     // Wal
     fmt::print(" - full_checkpoint_interval_sec: {}\n", system_option_.full_checkpoint_interval_sec_);
@@ -541,6 +585,9 @@ void Config::PrintAll() const {
         }
     }
     fmt::print(" - flush_at_commit: {}\n", flush_str);
+    fmt::print(" - wal_compress_threshold: {}\n", Utility::FormatByteSize(system_option_.wal_compress_threshold_));
+    fmt::print(" - checkpoint_io_thread_num: {}\n", system_option_.checkpoint_io_thread_num_);
+    fmt::print(" - delta_checkpoint_compact_threshold: {}\n", system_option_.delta_checkpoint_compact_threshold_);
 
     // Resource
     fmt::print(" - dictionary_dir: {}\n", system_option_.resource_dict_path_.c_str());
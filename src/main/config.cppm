@@ -97,6 +97,10 @@ public:
 
     [[nodiscard]] inline SharedPtr<String> temp_dir() const { return system_option_.temp_dir; }
 
+    [[nodiscard]] inline u64 read_ahead_depth() const { return system_option_.read_ahead_depth_; }
+
+    [[nodiscard]] inline u64 read_ahead_thread_num() const { return system_option_.read_ahead_thread_num_; }
+
     // Wal
     [[nodiscard]] inline SharedPtr<String> wal_dir() const { return system_option_.wal_dir; }
 
@@ -112,6 +116,12 @@ public:
 
     [[nodiscard]] inline FlushOption flush_at_commit() const { return system_option_.flush_at_commit_; }
 
+    [[nodiscard]] inline u64 wal_compress_threshold() const { return system_option_.wal_compress_threshold_; }
+
+    [[nodiscard]] inline u64 checkpoint_io_thread_num() const { return system_option_.checkpoint_io_thread_num_; }
+
+    [[nodiscard]] inline u64 delta_checkpoint_compact_threshold() const { return system_option_.delta_checkpoint_compact_threshold_; }
+
     // Resource
     [[nodiscard]] inline String resource_dict_path() const { return system_option_.resource_dict_path_; }
 
@@ -119,6 +129,10 @@ public:
 
     [[nodiscard]] inline bool enable_compaction() const { return system_option_.enable_compaction_; }
 
+    [[nodiscard]] inline std::chrono::seconds optimize_interval() const { return system_option_.optimize_interval_; }
+
+    [[nodiscard]] inline u64 optimize_io_budget() const { return system_option_.optimize_io_budget_; }
+
 private:
     static void ParseTimeZoneStr(const String &time_zone_str, String &parsed_time_zone, i32 &parsed_time_zone_bias);
 
@@ -78,6 +78,8 @@ export struct SystemOptions {
     // Buffer
     u64 buffer_pool_size{};
     SharedPtr<String> temp_dir{};
+    u64 read_ahead_depth_{};      // 0: table scan loads blocks synchronously
+    u64 read_ahead_thread_num_{}; // threads loading blocks ahead of table scans
 
     // Wal
     SharedPtr<String> wal_dir{};
@@ -87,11 +89,16 @@ export struct SystemOptions {
     u64 delta_checkpoint_interval_sec_{};
     u64 delta_checkpoint_interval_wal_bytes_{};
     FlushOption flush_at_commit_{FlushOption::kOnlyWrite}; // 0: flush_at_once, 1: only_write, 2: flush_per_second
+    u64 wal_compress_threshold_{};                          // 0: never compress
+    u64 checkpoint_io_thread_num_{};                        // threads flushing data and index files at delta checkpoint
+    u64 delta_checkpoint_compact_threshold_{};              // 0: never merge delta checkpoint files
 
     // Resource
     String resource_dict_path_{};
     std::chrono::seconds cleanup_interval_{};
     bool enable_compaction_{};
+    std::chrono::seconds optimize_interval_{};
+    u64 optimize_io_budget_{}; // bytes per second, 0 for unlimited
 };
 
 } // namespace infinity
@@ -21,6 +21,8 @@ import physical_operator;
 import plan_fragment;
 import operator_state;
 import data_block;
+import physical_operator_type;
+import table_scan_function_data;
 
 import infinity_exception;
 
@@ -121,6 +123,13 @@ void TaskProfiler::StopOperator(const OperatorState *operator_state) {
     }
 
     OperatorInformation info(active_operator_->GetName(), profiler_.GetBegin(), profiler_.GetEnd(), profiler_.Elapsed(), input_rows, output_data_size, output_rows);
+    if (operator_state->operator_type_ == PhysicalOperatorType::kTableScan) {
+        const auto *table_scan_function_data = static_cast<const TableScanOperatorState *>(operator_state)->table_scan_function_data_.get();
+        info.extra_info_ = fmt::format("ReadAheadDepth: {}, ReadAheadBlocks: {}, ReadAheadReadyBlocks: {}",
+                                       table_scan_function_data->read_ahead_depth_,
+                                       table_scan_function_data->read_ahead_count_,
+                                       table_scan_function_data->read_ahead_ready_count_);
+    }
 
     timings_.push_back(std::move(info));
     active_operator_ = nullptr;
@@ -226,8 +235,11 @@ void QueryProfiler::ExecuteRender(std::stringstream &ss) const {
                        << ": ElapsedTime: " << op.elapsed_
                        << ", InputRows: " << op.input_rows_
                        << ", OutputRows: " << op.output_rows_
-                       << ", OutputDataSize: " << op.output_data_size_
-                       << std::endl;
+                       << ", OutputDataSize: " << op.output_data_size_;
+                    if (!op.extra_info_.empty()) {
+                        ss << ", " << op.extra_info_;
+                    }
+                    ss << std::endl;
                 }
                 times ++;
             }
@@ -295,6 +307,9 @@ nlohmann::json QueryProfiler::Serialize(const QueryProfiler *profiler) {
                     json_info["input_rows"] = op.input_rows_;
                     json_info["output_rows"] = op.output_rows_;
                     json_info["output_data_size"] = op.output_data_size_;
+                    if (!op.extra_info_.empty()) {
+                        json_info["extra_info"] = op.extra_info_;
+                    }
                     json_operators["infos"].push_back(json_info);
                 }
                 times ++;
@@ -85,13 +85,13 @@ struct OperatorInformation {
 
     OperatorInformation(const OperatorInformation& other)
         : name_(other.name_), start_(other.start_), end_(other.end_), elapsed_(other.elapsed_), input_rows_(other.input_rows_),
-          output_data_size_(other.output_data_size_), output_rows_(other.output_rows_) {
+          output_data_size_(other.output_data_size_), output_rows_(other.output_rows_), extra_info_(other.extra_info_) {
 
     }
 
     OperatorInformation(OperatorInformation&& other)
         : name_(std::move(other.name_)), start_(other.start_), end_(other.end_), elapsed_(other.elapsed_), input_rows_(other.input_rows_),
-          output_data_size_(other.output_data_size_), output_rows_(other.output_rows_) {
+          output_data_size_(other.output_data_size_), output_rows_(other.output_rows_), extra_info_(std::move(other.extra_info_)) {
     }
 
     OperatorInformation(String name, i64 start, i64 end, i64 elapsed, u16 input_rows, i32 output_data_size, u16 output_rows)
@@ -107,6 +107,7 @@ struct OperatorInformation {
             input_rows_ = other.input_rows_;
             output_rows_ = other.output_rows_;
             output_data_size_ = other.output_data_size_;
+            extra_info_ = std::move(other.extra_info_);
         }
         return *this;
     }
@@ -119,6 +120,8 @@ struct OperatorInformation {
     u16 input_rows_ {};
     i32 output_data_size_ {};
     u16 output_rows_ {};
+    // Operator specific counters, e.g. the read ahead of table scan
+    String extra_info_ {};
 };
 
 export struct TaskBinding {
@@ -864,7 +864,7 @@ namespace infinity {
     break;
 
   case 14: // basic_filter: STRING
-#line 125 "search_parser.y"
+#line 126 "search_parser.y"
          {
     const std::string &field = default_field;
     if(field.empty()){
@@ -877,15 +877,36 @@ namespace infinity {
     break;
 
   case 15: // basic_filter: STRING OP_COLON STRING
-#line 133 "search_parser.y"
+#line 134 "search_parser.y"
                          {
     yylhs.value.as < std::unique_ptr<QueryNode> > () = driver.AnalyzeAndBuildQueryNode(yystack_[2].value.as < std::string > (), std::move(yystack_[0].value.as < std::string > ()));
 }
 #line 885 "search_parser.cpp"
     break;
 
+  case 16: // basic_filter: STRING OP_COLON OP_COLON STRING
+#line 137 "search_parser.y"
+                                  {
+    const std::string &field = default_field;
+    if(field.empty()){
+        error(yystack_[3].location, "default_field is empty");
+        YYERROR;
+    }
+    yylhs.value.as < std::unique_ptr<QueryNode> > () = driver.BuildPatternQueryNode(field, yystack_[3].value.as < std::string > (), std::move(yystack_[0].value.as < std::string > ()));
+}
+#line 898 "search_parser.cpp"
+    break;
+
+  case 17: // basic_filter: STRING OP_COLON STRING OP_COLON OP_COLON STRING
+#line 145 "search_parser.y"
+                                                  {
+    yylhs.value.as < std::unique_ptr<QueryNode> > () = driver.BuildPatternQueryNode(yystack_[5].value.as < std::string > (), yystack_[3].value.as < std::string > (), std::move(yystack_[0].value.as < std::string > ()));
+}
+#line 906 "search_parser.cpp"
+    break;
+
 
-#line 889 "search_parser.cpp"
+#line 910 "search_parser.cpp"
 
             default:
               break;
@@ -1244,9 +1265,9 @@ namespace infinity {
   const signed char
   SearchParser::yypact_[] =
   {
-       4,     4,     4,    -5,    15,     1,    10,    -7,    -7,    12,
-      -7,    13,    -6,    -7,    -7,     4,    10,     4,    -7,    16,
-      -7,    10,    -7,    -7
+       4,     4,     4,    -5,    21,     1,    19,    -7,    -7,    15,
+      -7,    13,     5,    -7,    -7,     4,    19,     4,    -7,    16,
+      -6,    18,    19,    -7,    -7,    -7,    20,    17,    -7
   };
 
   const signed char
@@ -1254,13 +1275,13 @@ namespace infinity {
   {
        0,     0,     0,    14,     0,     0,     3,     6,     8,    12,
        9,     0,     0,     1,     2,     0,     4,     0,    13,    10,
-      15,     5,     7,    11
+       0,    15,     5,     7,    11,    16,     0,     0,    17
   };
 
   const signed char
   SearchParser::yypgoto_[] =
   {
-      -7,    -7,    20,    -3,    -1,    -7,    -7
+      -7,    -7,    27,    -3,    -1,    -7,    -7
   };
 
   const signed char
@@ -1272,17 +1293,17 @@ namespace infinity {
   const signed char
   SearchParser::yytable_[] =
   {
-      10,    14,    16,    12,    20,    15,     1,     2,    16,     1,
-       2,     3,    21,    17,     3,    13,    22,    15,     1,     2,
-      19,    18,    11,     3,     0,    23
+      10,    14,    16,    12,    25,    15,     1,     2,    16,     1,
+       2,     3,    22,    20,     3,    21,    23,    15,     1,     2,
+      19,    13,    17,     3,    18,    24,    26,    28,    27,    11
   };
 
   const signed char
   SearchParser::yycheck_[] =
   {
        1,     0,     5,     8,    10,     4,     5,     6,    11,     5,
-       6,    10,    15,     3,    10,     0,    17,     4,     5,     6,
-       7,     9,     2,    10,    -1,     9
+       6,    10,    15,     8,    10,    10,    17,     4,     5,     6,
+       7,     0,     3,    10,     9,     9,     8,    10,     8,     2
   };
 
   const signed char
@@ -1290,21 +1311,21 @@ namespace infinity {
   {
        0,     5,     6,    10,    12,    13,    14,    15,    16,    17,
       15,    13,     8,     0,     0,     4,    14,     3,     9,     7,
-      10,    14,    15,     9
+       8,    10,    14,    15,     9,    10,     8,     8,    10
   };
 
   const signed char
   SearchParser::yyr1_[] =
   {
        0,    11,    12,    13,    13,    13,    14,    14,    15,    15,
-      15,    15,    16,    16,    17,    17
+      15,    15,    16,    16,    17,    17,    17,    17
   };
 
   const signed char
   SearchParser::yyr2_[] =
   {
        0,     2,     2,     1,     2,     3,     1,     3,     1,     2,
-       3,     4,     1,     2,     1,     3
+       3,     4,     1,     2,     1,     3,     4,     6
   };
 
 
@@ -1327,7 +1348,7 @@ namespace infinity {
   SearchParser::yyrline_[] =
   {
        0,    74,    74,    79,    80,    86,    94,    95,   103,   104,
-     109,   110,   116,   119,   125,   133
+     109,   110,   116,   119,   126,   134,   137,   145
   };
 
   void
@@ -1365,9 +1386,9 @@ namespace infinity {
 
 #line 9 "search_parser.y"
 } // infinity
-#line 1369 "search_parser.cpp"
+#line 1390 "search_parser.cpp"
 
-#line 137 "search_parser.y"
+#line 149 "search_parser.y"
 
 
 namespace infinity{
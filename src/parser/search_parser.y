@@ -121,6 +121,7 @@ basic_filter_boost
     $$->MultiplyWeight($2);
 };
 
+// term pattern: [field:]op::"pattern", see SearchDriver::BuildPatternQueryNode
 basic_filter
 : STRING {
     const std::string &field = default_field;
@@ -132,6 +133,17 @@ basic_filter
 }
 | STRING OP_COLON STRING {
     $$ = driver.AnalyzeAndBuildQueryNode($1, std::move($3));
+}
+| STRING OP_COLON OP_COLON STRING {
+    const std::string &field = default_field;
+    if(field.empty()){
+        error(@1, "default_field is empty");
+        YYERROR;
+    }
+    $$ = driver.BuildPatternQueryNode(field, $1, std::move($4));
+}
+| STRING OP_COLON STRING OP_COLON OP_COLON STRING {
+    $$ = driver.BuildPatternQueryNode($1, $3, std::move($6));
 };
 
 %%
@@ -219,6 +219,10 @@ void ExplainLogicalPlan::Explain(const LogicalNode *statement, SharedPtr<Vector<
             UnrecoverableError("Unexpected logical node type");
         }
     }
+    if (const auto &estimated_row_count = statement->estimated_row_count(); estimated_row_count.has_value()) {
+        String estimated_rows_str = fmt::format("{} - estimated rows: {:.0f}", String(intent_size, ' '), *estimated_row_count);
+        result->emplace_back(MakeShared<String>(estimated_rows_str));
+    }
     if (statement->left_node().get() != nullptr) {
         ExplainLogicalPlan::Explain(statement->left_node().get(), result, intent_size + 2);
     }
@@ -56,6 +56,10 @@ public:
 
     void set_load_metas(SharedPtr<Vector<LoadMeta>> load_metas) { load_metas_ = load_metas; }
 
+    [[nodiscard]] const Optional<f64> &estimated_row_count() const { return estimated_row_count_; }
+
+    void set_estimated_row_count(Optional<f64> estimated_row_count) { estimated_row_count_ = estimated_row_count; }
+
     virtual String ToString(i64 &space) const = 0;
 
     virtual String name() = 0;
@@ -71,6 +75,9 @@ protected:
 
     SharedPtr<Vector<LoadMeta>> load_metas_{};
 
+    // set by the cost based optimizer, None if the tables have no statistics
+    Optional<f64> estimated_row_count_{};
+
 public:
     template <class TARGET>
     TARGET &Cast() {
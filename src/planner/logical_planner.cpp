@@ -579,6 +579,31 @@ Status LogicalPlanner::BuildCreateIndex(const CreateStatement *statement, Shared
     UniquePtr<QueryBinder> query_binder_ptr = MakeUnique<QueryBinder>(this->query_context_ptr_, bind_context_ptr);
     auto base_table_ref = query_binder_ptr->GetTableRef(*schema_name, *table_name);
 
+    // "(a, b)" without "USING" is one secondary index on several columns
+    bool composite_secondary = create_index_info->index_info_list_->size() > 1;
+    for (IndexInfo *index_info : *create_index_info->index_info_list_) {
+        composite_secondary = composite_secondary and index_info->index_type_ == IndexType::kSecondary;
+    }
+    if (composite_secondary) {
+        Vector<String> column_names;
+        for (IndexInfo *index_info : *create_index_info->index_info_list_) {
+            IndexSecondary::ValidateColumnDataType(base_table_ref, index_info->column_name_); // may throw exception
+            if (std::find(column_names.begin(), column_names.end(), index_info->column_name_) != column_names.end()) {
+                RecoverableError(Status::InvalidIndexDefinition(
+                    fmt::format("Index {}: column {} appears more than once.", *index_name, index_info->column_name_)));
+            }
+            column_names.push_back(index_info->column_name_);
+        }
+        SharedPtr<IndexBase> base_index_ptr =
+            IndexSecondary::Make(index_name, fmt::format("{}_{}", create_index_info->table_name_, *index_name), std::move(column_names));
+        this->logical_plan_ = MakeShared<LogicalCreateIndex>(bind_context_ptr->GetNewLogicalNodeId(),
+                                                             base_table_ref,
+                                                             base_index_ptr,
+                                                             create_index_info->conflict_type_);
+        this->names_ptr_->emplace_back("OK");
+        this->types_ptr_->emplace_back(LogicalType::kInteger);
+        return Status::OK();
+    }
     if (create_index_info->index_info_list_->size() != 1) {
         RecoverableError(Status::InvalidIndexDefinition(
             fmt::format("Index {} consists of {} IndexInfo however 1 is expected", *index_name, create_index_info->index_info_list_->size())));
@@ -0,0 +1,180 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+#include <algorithm>
+
+module cost_based_optimizer;
+
+import stl;
+import logical_node;
+import logical_node_type;
+import logical_table_scan;
+import base_table_ref;
+import logical_index_scan;
+import logical_filter;
+import logical_join;
+import logical_aggregate;
+import logical_limit;
+import logical_top;
+import query_context;
+import base_expression;
+import value_expression;
+import expression_type;
+import value;
+import logical_type;
+import internal_types;
+import join_reference;
+import cost_model;
+import logger;
+import third_party;
+
+namespace infinity {
+
+class CardinalityEstimator {
+public:
+    Optional<f64> VisitNode(SharedPtr<LogicalNode> &op) {
+        if (!op) {
+            return None;
+        }
+        Optional<f64> left = VisitNode(op->left_node());
+        Optional<f64> right = VisitNode(op->right_node());
+        Optional<f64> estimate;
+        switch (op->operator_type()) {
+            case LogicalNodeType::kTableScan: {
+                auto &table_scan = static_cast<LogicalTableScan &>(*op);
+                estimate = AddTable(table_scan.TableIndex(), *table_scan.base_table_ref_);
+                break;
+            }
+            case LogicalNodeType::kIndexScan: {
+                auto &index_scan = static_cast<LogicalIndexScan &>(*op);
+                estimate = AddTable(index_scan.TableIndex(), *index_scan.base_table_ref_);
+                if (estimate.has_value()) {
+                    *estimate *= CostModel::EstimateSelectivity(index_scan.index_filter_qualified_, statistics_map_);
+                }
+                break;
+            }
+            case LogicalNodeType::kFilter: {
+                if (left.has_value()) {
+                    estimate = *left * CostModel::EstimateSelectivity(static_cast<LogicalFilter &>(*op).expression(), statistics_map_);
+                }
+                break;
+            }
+            case LogicalNodeType::kJoin: {
+                if (left.has_value() and right.has_value()) {
+                    estimate = EstimateJoin(static_cast<LogicalJoin &>(*op), *left, *right);
+                }
+                break;
+            }
+            case LogicalNodeType::kCrossProduct: {
+                if (left.has_value() and right.has_value()) {
+                    estimate = *left * *right;
+                }
+                break;
+            }
+            case LogicalNodeType::kAggregate: {
+                if (static_cast<LogicalAggregate &>(*op).groups_.empty()) {
+                    estimate = 1;
+                } else {
+                    // no more groups than input rows
+                    estimate = left;
+                }
+                break;
+            }
+            case LogicalNodeType::kLimit: {
+                estimate = ApplyLimit(left, static_cast<LogicalLimit &>(*op).limit_expression_);
+                break;
+            }
+            case LogicalNodeType::kTop: {
+                estimate = ApplyLimit(left, static_cast<LogicalTop &>(*op).limit_expression_);
+                break;
+            }
+            default: {
+                // projection, sort and the other single input nodes keep the row count
+                if (!op->right_node()) {
+                    estimate = left;
+                }
+                break;
+            }
+        }
+        op->set_estimated_row_count(estimate);
+        return estimate;
+    }
+
+private:
+    Optional<f64> AddTable(u64 table_index, const BaseTableRef &base_table_ref) {
+        SharedPtr<TableStatistics> table_statistics = TableStatistics::Make(base_table_ref);
+        if (!table_statistics) {
+            return None;
+        }
+        f64 row_count = table_statistics->row_count();
+        statistics_map_.emplace(table_index, std::move(table_statistics));
+        return row_count;
+    }
+
+    f64 EstimateJoin(LogicalJoin &join, f64 left, f64 right) {
+        f64 selectivity = 1;
+        for (auto &condition : join.conditions_) {
+            selectivity *= CostModel::EstimateSelectivity(condition, statistics_map_);
+        }
+        f64 inner_row_count = left * right * selectivity;
+        switch (join.join_type_) {
+            case JoinType::kInner: {
+                if (left < right) {
+                    LOG_TRACE(fmt::format("CostBasedOptimizer: swap the inputs of join {}, estimated rows: {} and {}", join.node_id(), left, right));
+                    SharedPtr<LogicalNode> left_node = join.left_node();
+                    join.set_left_node(join.right_node());
+                    join.set_right_node(left_node);
+                }
+                return inner_row_count;
+            }
+            case JoinType::kLeft: {
+                return std::max(inner_row_count, left);
+            }
+            case JoinType::kRight: {
+                return std::max(inner_row_count, right);
+            }
+            case JoinType::kFull: {
+                return std::max(inner_row_count, left + right);
+            }
+            case JoinType::kCross: {
+                return left * right;
+            }
+            default: {
+                return std::min(inner_row_count, left);
+            }
+        }
+    }
+
+    static Optional<f64> ApplyLimit(Optional<f64> input, const SharedPtr<BaseExpression> &limit_expression) {
+        if (!input.has_value() or !limit_expression or limit_expression->type() != ExpressionType::kValue) {
+            return input;
+        }
+        const Value &limit = static_cast<const ValueExpression &>(*limit_expression).GetValue();
+        if (limit.type().type() != LogicalType::kBigInt) {
+            return input;
+        }
+        return std::min(*input, f64(limit.GetValue<BigIntT>()));
+    }
+
+    TableStatisticsMap statistics_map_{};
+};
+
+void CostBasedOptimizer::ApplyToPlan(QueryContext *, SharedPtr<LogicalNode> &logical_plan) {
+    CardinalityEstimator estimator;
+    estimator.VisitNode(logical_plan);
+}
+
+} // namespace infinity
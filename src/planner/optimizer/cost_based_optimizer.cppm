@@ -0,0 +1,37 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+export module cost_based_optimizer;
+
+import stl;
+import logical_node;
+import query_context;
+import optimizer_rule;
+
+namespace infinity {
+
+// Estimates the row count of every node from the table statistics, and puts the smaller input of an inner join on the right,
+// the inner side of the nested loop join. Needs the column bindings of the scans, so it runs before ColumnPruner.
+export class CostBasedOptimizer final : public OptimizerRule {
+public:
+    ~CostBasedOptimizer() final = default;
+
+    void ApplyToPlan(QueryContext *query_context_ptr, SharedPtr<LogicalNode> &logical_plan) final;
+
+    String name() const final { return "Cost Based Optimizer"; }
+};
+
+} // namespace infinity
@@ -0,0 +1,326 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+#include <algorithm>
+#include <array>
+
+module cost_model;
+
+import stl;
+import value;
+import internal_types;
+import logical_type;
+import data_type;
+import base_expression;
+import base_table_ref;
+import expression_type;
+import function_expression;
+import column_expression;
+import in_expression;
+import block_index;
+import segment_entry;
+import segment_statistics;
+import hyper_log_log;
+import filter_expression_push_down_helper;
+
+namespace infinity {
+
+namespace {
+
+f64 ColumnSelectivity(const ColumnStatistics &column_statistics, FilterCompareType compare_type, const Value &value) {
+    if (column_statistics.row_count_ == 0) {
+        return 0;
+    }
+    const f64 non_null_fraction = 1 - column_statistics.NullFraction();
+    const f64 distinct_count = column_statistics.DistinctCount();
+    const EquiDepthHistogram &histogram = column_statistics.histogram_;
+    Optional<f64> key = histogram.empty() ? None : ToStatisticsKey(value);
+    f64 equal_fraction = distinct_count == 0 ? 0 : 1 / distinct_count;
+    if (key.has_value()) {
+        if (*key < histogram.min() or *key > histogram.max()) {
+            equal_fraction = 0;
+        } else {
+            equal_fraction = std::max(equal_fraction, histogram.FractionEqual(*key));
+        }
+    }
+    switch (compare_type) {
+        case FilterCompareType::kEqual: {
+            return non_null_fraction * equal_fraction;
+        }
+        case FilterCompareType::kLessEqual: {
+            if (!key.has_value()) {
+                return non_null_fraction * CostModel::kDefaultRangeSelectivity;
+            }
+            return non_null_fraction * std::min(1.0, histogram.FractionLess(*key) + equal_fraction);
+        }
+        case FilterCompareType::kGreaterEqual: {
+            if (!key.has_value()) {
+                return non_null_fraction * CostModel::kDefaultRangeSelectivity;
+            }
+            return non_null_fraction * (1 - histogram.FractionLess(*key));
+        }
+        default: {
+            return non_null_fraction * CostModel::kDefaultRangeSelectivity;
+        }
+    }
+}
+
+// the column under the casts, nullptr if the expression is not a column
+const ColumnExpression *UnwrapColumn(const SharedPtr<BaseExpression> &expression) {
+    switch (expression->type()) {
+        case ExpressionType::kCast: {
+            return UnwrapColumn(expression->arguments()[0]);
+        }
+        case ExpressionType::kColumn: {
+            return static_cast<const ColumnExpression *>(expression.get());
+        }
+        default: {
+            return nullptr;
+        }
+    }
+}
+
+bool IsValueResult(const SharedPtr<BaseExpression> &expression) {
+    switch (expression->type()) {
+        case ExpressionType::kValue: {
+            return true;
+        }
+        case ExpressionType::kCast:
+        case ExpressionType::kFunction: {
+            return std::all_of(expression->arguments().begin(), expression->arguments().end(), IsValueResult);
+        }
+        default: {
+            return false;
+        }
+    }
+}
+
+class SelectivityEstimator {
+public:
+    explicit SelectivityEstimator(const TableStatisticsMap &statistics_map) : statistics_map_(statistics_map) {}
+
+    f64 Estimate(SharedPtr<BaseExpression> &expression) {
+        switch (expression->type()) {
+            case ExpressionType::kFunction: {
+                const auto &f_name = static_cast<const FunctionExpression &>(*expression).ScalarFunctionName();
+                auto &arguments = expression->arguments();
+                if (f_name == "AND") {
+                    return Estimate(arguments[0]) * Estimate(arguments[1]);
+                } else if (f_name == "OR") {
+                    f64 left = Estimate(arguments[0]);
+                    f64 right = Estimate(arguments[1]);
+                    return left + right - left * right;
+                } else if (f_name == "NOT") {
+                    return 1 - Estimate(arguments[0]);
+                }
+                static constexpr std::array<const char *, 5> CompareFunctionNames = {"<", ">", "<=", ">=", "="};
+                static constexpr std::array<FilterCompareType, 5> CompareTypes = {FilterCompareType::kLess,
+                                                                                 FilterCompareType::kGreater,
+                                                                                 FilterCompareType::kLessEqual,
+                                                                                 FilterCompareType::kGreaterEqual,
+                                                                                 FilterCompareType::kEqual};
+                static constexpr std::array<FilterCompareType, 5> ReverseCompareTypes = {FilterCompareType::kGreater,
+                                                                                        FilterCompareType::kLess,
+                                                                                        FilterCompareType::kGreaterEqual,
+                                                                                        FilterCompareType::kLessEqual,
+                                                                                        FilterCompareType::kEqual};
+                if (f_name == "<>") {
+                    return 1 - EstimateCompare(arguments, FilterCompareType::kEqual, FilterCompareType::kEqual);
+                }
+                auto it = std::find(CompareFunctionNames.begin(), CompareFunctionNames.end(), f_name);
+                if (it == CompareFunctionNames.end()) {
+                    return CostModel::kDefaultSelectivity;
+                }
+                auto idx = std::distance(CompareFunctionNames.begin(), it);
+                return EstimateCompare(arguments, CompareTypes[idx], ReverseCompareTypes[idx]);
+            }
+            case ExpressionType::kIn: {
+                return EstimateIn(static_cast<InExpression &>(*expression));
+            }
+            case ExpressionType::kValue: {
+                Value value = FilterExpressionPushDownHelper::CalcValueResult(expression);
+                if (value.type().type() != LogicalType::kBoolean) {
+                    return CostModel::kDefaultSelectivity;
+                }
+                return value.GetValue<BooleanT>() ? 1 : 0;
+            }
+            default: {
+                return CostModel::kDefaultSelectivity;
+            }
+        }
+    }
+
+private:
+    const TableStatistics *FindTable(const ColumnExpression *column) const {
+        auto it = statistics_map_.find(column->binding().table_idx);
+        return it == statistics_map_.end() ? nullptr : it->second.get();
+    }
+
+    f64 EstimateCompare(Vector<SharedPtr<BaseExpression>> &arguments, FilterCompareType compare_type, FilterCompareType reverse_compare_type) {
+        const ColumnExpression *left_column = UnwrapColumn(arguments[0]);
+        const ColumnExpression *right_column = UnwrapColumn(arguments[1]);
+        if (left_column != nullptr and IsValueResult(arguments[1])) {
+            return EstimateColumnCompare(arguments[0], *left_column, arguments[1], compare_type);
+        }
+        if (right_column != nullptr and IsValueResult(arguments[0])) {
+            return EstimateColumnCompare(arguments[1], *right_column, arguments[0], reverse_compare_type);
+        }
+        if (left_column != nullptr and right_column != nullptr and compare_type == FilterCompareType::kEqual) {
+            // equi-join condition: every row matches the rows of one distinct value on the side with more distinct values
+            const TableStatistics *left_table = FindTable(left_column);
+            const TableStatistics *right_table = FindTable(right_column);
+            if (left_table != nullptr and right_table != nullptr) {
+                Optional<f64> left_distinct = left_table->EstimateDistinctCount(left_column->binding().column_idx);
+                Optional<f64> right_distinct = right_table->EstimateDistinctCount(right_column->binding().column_idx);
+                if (left_distinct.has_value() and right_distinct.has_value()) {
+                    return 1 / std::max({*left_distinct, *right_distinct, 1.0});
+                }
+            }
+            return CostModel::kDefaultEqualSelectivity;
+        }
+        return compare_type == FilterCompareType::kEqual ? CostModel::kDefaultEqualSelectivity : CostModel::kDefaultRangeSelectivity;
+    }
+
+    f64 EstimateColumnCompare(SharedPtr<BaseExpression> &column_expr,
+                              const ColumnExpression &column,
+                              SharedPtr<BaseExpression> &value_expr,
+                              FilterCompareType compare_type) {
+        const f64 default_selectivity =
+            compare_type == FilterCompareType::kEqual ? CostModel::kDefaultEqualSelectivity : CostModel::kDefaultRangeSelectivity;
+        const TableStatistics *table = FindTable(&column);
+        if (table == nullptr) {
+            return default_selectivity;
+        }
+        // the same types as the fast rough filter, UnwindCast only rewrites the compare of these types
+        DataType column_type = column_expr->Type();
+        bool supported = compare_type == FilterCompareType::kEqual ? column_type.SupportBloomFilter() : column_type.SupportMinMaxFilter();
+        if (!supported or (compare_type != FilterCompareType::kEqual and column_type.type() == LogicalType::kVarchar)) {
+            return default_selectivity;
+        }
+        Value value = FilterExpressionPushDownHelper::CalcValueResult(value_expr);
+        if (value.type().type() == LogicalType::kNull) {
+            return 0;
+        }
+        auto [column_idx, unwind_value, unwind_compare_type] =
+            FilterExpressionPushDownHelper::UnwindCast(column_expr, std::move(value), compare_type);
+        switch (unwind_compare_type) {
+            case FilterCompareType::kAlwaysTrue: {
+                return 1;
+            }
+            case FilterCompareType::kAlwaysFalse: {
+                return 0;
+            }
+            default: {
+                return table->EstimateSelectivity(column_idx, unwind_compare_type, unwind_value).value_or(default_selectivity);
+            }
+        }
+    }
+
+    f64 EstimateIn(InExpression &in_expression) {
+        const auto &left = in_expression.left_operand();
+        f64 selectivity = 0;
+        const TableStatistics *table = nullptr;
+        if (left->type() == ExpressionType::kColumn) {
+            table = FindTable(static_cast<const ColumnExpression *>(left.get()));
+        }
+        SizeT column_idx = table == nullptr ? 0 : static_cast<const ColumnExpression &>(*left).binding().column_idx;
+        for (auto &argument : in_expression.arguments()) {
+            Optional<f64> value_selectivity;
+            if (table != nullptr and IsValueResult(argument)) {
+                Value value = FilterExpressionPushDownHelper::CalcValueResult(argument);
+                if (value.type().type() == LogicalType::kNull) {
+                    continue;
+                }
+                value_selectivity = table->EstimateSelectivity(column_idx, FilterCompareType::kEqual, value);
+            }
+            selectivity += value_selectivity.value_or(CostModel::kDefaultEqualSelectivity);
+        }
+        selectivity = std::min(selectivity, 1.0);
+        return in_expression.in_type() == InType::kNotIn ? 1 - selectivity : selectivity;
+    }
+
+    const TableStatisticsMap &statistics_map_;
+};
+
+} // namespace
+
+SharedPtr<TableStatistics> TableStatistics::Make(const BaseTableRef &base_table_ref) {
+    auto table_statistics = MakeShared<TableStatistics>();
+    table_statistics->column_ids_.assign(base_table_ref.column_ids_.begin(), base_table_ref.column_ids_.end());
+    for (SegmentEntry *segment_entry : base_table_ref.block_index_->segments_) {
+        f64 segment_row_count = segment_entry->actual_row_count();
+        table_statistics->row_count_ += segment_row_count;
+        ++table_statistics->segment_count_;
+        if (auto segment_statistics = segment_entry->GetStatistics(); segment_statistics) {
+            table_statistics->segment_statistics_.emplace_back(segment_row_count, std::move(segment_statistics));
+        }
+    }
+    if (table_statistics->segment_statistics_.empty()) {
+        return nullptr;
+    }
+    return table_statistics;
+}
+
+Optional<f64> TableStatistics::EstimateSelectivity(SizeT column_idx, FilterCompareType compare_type, const Value &value) const {
+    if (column_idx >= column_ids_.size()) {
+        return None;
+    }
+    ColumnID column_id = column_ids_[column_idx];
+    f64 weighted_selectivity = 0;
+    f64 total_weight = 0;
+    for (const auto &[segment_row_count, segment_statistics] : segment_statistics_) {
+        const ColumnStatistics *column_statistics = segment_statistics->GetColumnStatistics(column_id);
+        if (column_statistics == nullptr) {
+            continue;
+        }
+        weighted_selectivity += segment_row_count * ColumnSelectivity(*column_statistics, compare_type, value);
+        total_weight += segment_row_count;
+    }
+    if (total_weight == 0) {
+        return None;
+    }
+    return weighted_selectivity / total_weight;
+}
+
+Optional<f64> TableStatistics::EstimateDistinctCount(SizeT column_idx) const {
+    if (column_idx >= column_ids_.size()) {
+        return None;
+    }
+    ColumnID column_id = column_ids_[column_idx];
+    HyperLogLog merged_sketch;
+    f64 covered_row_count = 0;
+    for (const auto &[segment_row_count, segment_statistics] : segment_statistics_) {
+        const ColumnStatistics *column_statistics = segment_statistics->GetColumnStatistics(column_id);
+        if (column_statistics == nullptr) {
+            continue;
+        }
+        merged_sketch.Merge(column_statistics->distinct_sketch_);
+        covered_row_count += segment_row_count;
+    }
+    if (covered_row_count == 0) {
+        return None;
+    }
+    // rows without statistics are assumed to bring new values in proportion
+    f64 distinct_count = merged_sketch.Estimate() * (row_count_ / covered_row_count);
+    return std::clamp(distinct_count, 1.0, std::max(row_count_, 1.0));
+}
+
+f64 CostModel::EstimateSelectivity(SharedPtr<BaseExpression> &expression, const TableStatisticsMap &statistics_map) {
+    SelectivityEstimator estimator(statistics_map);
+    return std::clamp(estimator.Estimate(expression), 0.0, 1.0);
+}
+
+} // namespace infinity
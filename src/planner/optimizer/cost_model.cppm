@@ -0,0 +1,78 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+export module cost_model;
+
+import stl;
+import value;
+import internal_types;
+import base_expression;
+import base_table_ref;
+import segment_statistics;
+import filter_expression_push_down_helper;
+
+namespace infinity {
+
+// The statistics of the sealed segments of a table visible to the query.
+// Segments without statistics (unsealed, or loaded from an older catalog) are assumed to look like the others.
+export class TableStatistics {
+public:
+    // nullptr if no segment of the table has statistics
+    static SharedPtr<TableStatistics> Make(const BaseTableRef &base_table_ref);
+
+    [[nodiscard]] inline f64 row_count() const { return row_count_; }
+
+    [[nodiscard]] inline SizeT segment_count() const { return segment_count_; }
+
+    // Fraction of the rows where "column compare_type value" is true. column_idx is the column index of the table reference.
+    // None if the column has no statistics.
+    Optional<f64> EstimateSelectivity(SizeT column_idx, FilterCompareType compare_type, const Value &value) const;
+
+    Optional<f64> EstimateDistinctCount(SizeT column_idx) const;
+
+private:
+    Vector<ColumnID> column_ids_{};
+    f64 row_count_{};
+    SizeT segment_count_{};
+    // the row count of the segment and its statistics
+    Vector<Pair<f64, SharedPtr<const SegmentStatistics>>> segment_statistics_{};
+};
+
+// table index -> statistics of the table
+export using TableStatisticsMap = HashMap<u64, SharedPtr<TableStatistics>>;
+
+// Costs are in units of one row read by a table scan.
+export class CostModel {
+public:
+    // used when the column has no statistics or the predicate is not understood
+    static constexpr f64 kDefaultEqualSelectivity = 0.05;
+    static constexpr f64 kDefaultRangeSelectivity = 1.0 / 3;
+    static constexpr f64 kDefaultSelectivity = 0.1;
+
+    // an index scan reads the index of every segment, then gathers the selected rows one by one
+    static constexpr f64 kIndexSegmentCost = 1024;
+    static constexpr f64 kIndexRowCost = 4;
+
+    static f64 EstimateSelectivity(SharedPtr<BaseExpression> &expression, const TableStatisticsMap &statistics_map);
+
+    static inline f64 TableScanCost(f64 row_count) { return row_count; }
+
+    static inline f64 IndexScanCost(f64 row_count, f64 selectivity, SizeT segment_count) {
+        return segment_count * kIndexSegmentCost + row_count * selectivity * kIndexRowCost;
+    }
+};
+
+} // namespace infinity
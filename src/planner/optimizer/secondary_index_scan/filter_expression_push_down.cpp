@@ -45,6 +45,9 @@ import value;
 import column_vector;
 import filter_expression_push_down_helper;
 import table_index_meta;
+import in_expression;
+import secondary_index_key;
+import logical_type;
 
 namespace infinity {
 
@@ -148,11 +151,19 @@ public:
 //         step 2 includes:
 //             case 1. the subexpression is in the form of "[cast] x compare value_expr" and the column x has a secondary index.
 //             case 2. the subexpression is constructed by "and" or "or" expression, and each fundamental child expression satisfies case 1.
+//             case 3. the subexpression is in the form of "x in (value_expr, ...)" and the column x has a secondary index.
+//         before step 2, the subexpressions "x = value_expr" on the leading columns of a secondary index on several columns,
+//         and "y compare value_expr" on the next column, are combined into one range of the encoded keys of that index.
 // step 3. push down the qualified index filter candidates to the index scan (otherwise, keep the table scan)
 class IndexScanFilterExpressionPushDownMethod final : public FilterExpressionPushDownMethodBase {
 private:
     // for index scan
     HashMap<ColumnID, TableIndexEntry *> candidate_column_index_map_;
+    // secondary indexes on several columns: key columns and index
+    Vector<Pair<Vector<ColumnID>, TableIndexEntry *>> candidate_composite_indexes_;
+    // subexpressions answered by one range of a secondary index on several columns
+    Vector<SharedPtr<BaseExpression>> composite_key_filters_;
+    Vector<FilterExecuteSingleRange> composite_key_ranges_;
     Vector<SharedPtr<BaseExpression>> index_filter_candidates_;
     Vector<SharedPtr<BaseExpression>> index_filter_leftover_;
     HashMap<ColumnID, TableIndexEntry *> column_index_map_;
@@ -169,6 +180,8 @@ public:
         FlattenAndExpression(std::move(expression));
         // collect column index information
         InitColumnIndexEntries();
+        // ranges of the secondary indexes on several columns
+        FindCompositeKeyFilters();
         // classification of subexpressions
         FindIndexFilterCandidates();
         // build two filter expressions: one for index scan, one for normal filter
@@ -177,6 +190,7 @@ public:
         if (index_filter_qualified_) {
             filter_execute_command_ = BuildSecondaryIndexScanCommand(index_filter_qualified_);
         }
+        AddCompositeKeyFilters();
         return {std::move(column_index_map_),
                 std::move(index_filter_qualified_),
                 std::move(extra_leftover_filter_),
@@ -201,6 +215,14 @@ private:
                 if (index_base->index_type_ != IndexType::kSecondary) {
                     continue;
                 }
+                if (index_base->column_names_.size() > 1) {
+                    Vector<ColumnID> key_column_ids;
+                    for (const String &column_name : index_base->column_names_) {
+                        key_column_ids.push_back(table_entry->GetColumnIdByName(column_name));
+                    }
+                    candidate_composite_indexes_.emplace_back(std::move(key_column_ids), table_index_entry);
+                    continue;
+                }
                 String column_name = index_base->column_name();
                 u64 column_id = table_entry->GetColumnIdByName(column_name);
                 if (candidate_column_index_map_.contains(column_id)) {
@@ -210,6 +232,164 @@ private:
                 }
             }
         }
+        // an index on several columns also serves the filters on its leading column, if that column has no index of its own
+        for (auto &[key_column_ids, table_index_entry] : candidate_composite_indexes_) {
+            candidate_column_index_map_.emplace(key_column_ids[0], table_index_entry);
+        }
+    }
+
+    // "[cast] x compare value_expr" on the column. Returns the compare type and the value in the column type, kInvalid if not matched.
+    inline FilterCompareType MatchColumnCompareValue(const SharedPtr<BaseExpression> &expression, ColumnID column_id, Value &value) const {
+        if (expression->type() != ExpressionType::kFunction or expression->arguments().size() != 2) {
+            return FilterCompareType::kInvalid;
+        }
+        static const HashMap<String, FilterCompareType> compare_types = {{"=", FilterCompareType::kEqual},
+                                                                         {"<", FilterCompareType::kLess},
+                                                                         {"<=", FilterCompareType::kLessEqual},
+                                                                         {">", FilterCompareType::kGreater},
+                                                                         {">=", FilterCompareType::kGreaterEqual}};
+        auto function_expression = std::static_pointer_cast<FunctionExpression>(expression);
+        auto iter = compare_types.find(function_expression->ScalarFunctionName());
+        if (iter == compare_types.end()) {
+            return FilterCompareType::kInvalid;
+        }
+        auto left = expression->arguments()[0];
+        auto &right = expression->arguments()[1];
+        auto is_key_column = [column_id](const SharedPtr<BaseExpression> &expr, u32 depth) -> bool {
+            // cast of varchar column can't be unwound
+            return std::static_pointer_cast<ColumnExpression>(expr)->binding().column_idx == column_id and
+                   !(expr->Type().type() == LogicalType::kVarchar and depth > 1);
+        };
+        if (!IsValidColumnExpression(left, 1, is_key_column) or !IsValueResultExpression(right, 1)) {
+            return FilterCompareType::kInvalid;
+        }
+        if (left->type() == ExpressionType::kCast) {
+            // UnwindCast() handles the cast of integers to BigIntT, and of numbers to DoubleT except in equality comparison
+            auto target_type = left->Type().type();
+            auto source_type = left->arguments()[0]->Type().type();
+            bool integer_source =
+                source_type == LogicalType::kTinyInt or source_type == LogicalType::kSmallInt or source_type == LogicalType::kInteger;
+            bool can_unwind = false;
+            if (target_type == LogicalType::kBigInt) {
+                can_unwind = integer_source;
+            } else if (target_type == LogicalType::kDouble and iter->second != FilterCompareType::kEqual) {
+                can_unwind = integer_source or source_type == LogicalType::kBigInt or source_type == LogicalType::kFloat;
+            }
+            if (left->arguments()[0]->type() != ExpressionType::kColumn or !can_unwind) {
+                return FilterCompareType::kInvalid;
+            }
+        }
+        auto [unwound_column_id, unwound_value, compare_type] =
+            FilterExpressionPushDownHelper::UnwindCast(left, FilterExpressionPushDownHelper::CalcValueResult(right), iter->second);
+        switch (compare_type) {
+            case FilterCompareType::kEqual:
+            case FilterCompareType::kLess:
+            case FilterCompareType::kLessEqual:
+            case FilterCompareType::kGreater:
+            case FilterCompareType::kGreaterEqual: {
+                value = std::move(unwound_value);
+                return compare_type;
+            }
+            default: {
+                // kAlwaysTrue and kAlwaysFalse are left to the index filter of the column
+                return FilterCompareType::kInvalid;
+            }
+        }
+    }
+
+    // For each secondary index on several columns (k0, k1, ...):
+    // "k0 = v0 AND ... AND ki = vi" and optionally "k(i+1) compare v" become one range of the encoded keys.
+    // Only used when at least two key columns are compared, the filters on the leading column alone are handled as usual.
+    inline void FindCompositeKeyFilters() {
+        for (auto &[key_column_ids, table_index_entry] : candidate_composite_indexes_) {
+            if (candidate_column_index_map_.at(key_column_ids[0]) != table_index_entry) {
+                LOG_TRACE(fmt::format("FindCompositeKeyFilters(): Column {} has another secondary index.", key_column_ids[0]));
+                continue;
+            }
+            Vector<SizeT> matched_subexpressions;
+            String equal_prefix;
+            SizeT equal_column_cnt = 0;
+            for (; equal_column_cnt < key_column_ids.size(); ++equal_column_cnt) {
+                bool found = false;
+                for (SizeT i = 0; i < flatten_and_subexpressions_.size() and !found; ++i) {
+                    Value value = Value::MakeNull();
+                    if (MatchColumnCompareValue(flatten_and_subexpressions_[i], key_column_ids[equal_column_cnt], value) ==
+                        FilterCompareType::kEqual) {
+                        AppendSecondaryIndexKey(equal_prefix, value);
+                        matched_subexpressions.push_back(i);
+                        found = true;
+                    }
+                }
+                if (!found) {
+                    break;
+                }
+            }
+            if (equal_column_cnt == 0) {
+                continue;
+            }
+            FilterEncodedKeyRange range(equal_prefix, nullptr, FilterCompareType::kAlwaysTrue);
+            SizeT compared_column_cnt = equal_column_cnt;
+            if (equal_column_cnt < key_column_ids.size()) {
+                // range on the next key column
+                for (SizeT i = 0; i < flatten_and_subexpressions_.size(); ++i) {
+                    Value value = Value::MakeNull();
+                    FilterCompareType compare_type = MatchColumnCompareValue(flatten_and_subexpressions_[i], key_column_ids[equal_column_cnt], value);
+                    if (compare_type == FilterCompareType::kInvalid or compare_type == FilterCompareType::kEqual) {
+                        continue;
+                    }
+                    if (!range.MergeAnd(FilterEncodedKeyRange(equal_prefix, &value, compare_type))) {
+                        range.SetAlwaysFalse();
+                    }
+                    matched_subexpressions.push_back(i);
+                    compared_column_cnt = equal_column_cnt + 1;
+                }
+            }
+            if (compared_column_cnt < 2) {
+                continue;
+            }
+            // move the matched subexpressions out
+            std::sort(matched_subexpressions.begin(), matched_subexpressions.end());
+            for (auto iter = matched_subexpressions.rbegin(); iter != matched_subexpressions.rend(); ++iter) {
+                composite_key_filters_.push_back(std::move(flatten_and_subexpressions_[*iter]));
+                flatten_and_subexpressions_.erase(flatten_and_subexpressions_.begin() + *iter);
+            }
+            bool always_false = range.IsAlwaysFalse();
+            auto &key_range = composite_key_ranges_.emplace_back(key_column_ids[0], FilterRangeType::kInterval);
+            key_range.SetEncodedKeyRange(std::move(range));
+            if (always_false) {
+                key_range.SetEmpty();
+            }
+            AddColumnToResultMap(key_column_ids[0]);
+        }
+    }
+
+    // "and" the ranges of the secondary indexes on several columns with the other index filters
+    inline void AddCompositeKeyFilters() {
+        if (composite_key_ranges_.empty()) {
+            return;
+        }
+        auto and_function_set_ptr = Catalog::GetFunctionSetByName(query_context_->storage()->catalog(), "AND");
+        auto and_scalar_function_set_ptr = static_pointer_cast<ScalarFunctionSet>(and_function_set_ptr);
+        for (auto &key_range : composite_key_ranges_) {
+            bool need_and = !filter_execute_command_.empty();
+            filter_execute_command_.emplace_back(std::move(key_range));
+            if (need_and) {
+                filter_execute_command_.emplace_back(FilterExecuteCombineType::kAnd);
+            }
+        }
+        composite_key_ranges_.clear();
+        for (auto &expression : composite_key_filters_) {
+            if (!index_filter_qualified_) {
+                index_filter_qualified_ = std::move(expression);
+            } else {
+                Vector<SharedPtr<BaseExpression>> arguments;
+                arguments.emplace_back(std::move(index_filter_qualified_));
+                arguments.emplace_back(std::move(expression));
+                ScalarFunction and_func = and_scalar_function_set_ptr->GetMostMatchFunction(arguments);
+                index_filter_qualified_ = MakeShared<FunctionExpression>(std::move(and_func), std::move(arguments));
+            }
+        }
+        composite_key_filters_.clear();
     }
 
     inline void FindIndexFilterCandidates() {
@@ -227,6 +407,7 @@ private:
     inline bool CanApplyIndexScan(const SharedPtr<BaseExpression> &expression) {
         // case 1. expression is a scalar expression containing only one column and the column has a secondary index
         // case 2. expression is an "and" or "or" expression, and each child expression can be applied to the index scan (recursive check)
+        // case 3. expression is "x IN (value_expr, ...)" and the column x has a secondary index, it becomes a lookup of each value
         // now we do not support "not" expression in index scan
         if (expression->type() == ExpressionType::kFunction) {
             auto function_expression = std::static_pointer_cast<FunctionExpression>(expression);
@@ -248,6 +429,9 @@ private:
                 // case 1.
                 return CheckExprIndexState(expression, 0);
             }
+        } else if (expression->type() == ExpressionType::kIn) {
+            // case 3.
+            return CheckInExprIndexState(expression);
         } else if (expression->type() == ExpressionType::kValue) {
             LOG_TRACE(fmt::format("Unsupported expression type: In CanApplyIndexScan(), the expression \"{}\" is a value expression. "
                                   "Need to apply the expression rewrite optimizer first.",
@@ -283,6 +467,11 @@ private:
                     bool valid_compare = true;
                     // left expression should be column
                     auto is_column_index = [&m = candidate_column_index_map_](const SharedPtr<BaseExpression> &expr, u32 depth) -> bool {
+                        if (expr->Type().type() == LogicalType::kVarchar and depth > 1) {
+                            // cast of varchar column can't be unwound
+                            LOG_TRACE(fmt::format("Expression depth: {}. In is_column_index(), cast of varchar column {}.", depth, expr->Name()));
+                            return false;
+                        }
                         if (!(expr->Type().CanBuildSecondaryIndex())) {
                             // Unsupported type
                             LOG_TRACE(fmt::format("Expression depth: {}. In is_column_index(), unsupported column value type {}. Expression: {}.",
@@ -349,6 +538,32 @@ private:
         }
     }
 
+    // case 3. "x IN (value_expr, ...)": x should be a numeric column with a secondary index, "NOT IN" is a scan like "!=".
+    inline bool CheckInExprIndexState(const SharedPtr<BaseExpression> &expression) {
+        auto in_expression = std::static_pointer_cast<InExpression>(expression);
+        if (in_expression->in_type() != InType::kIn) {
+            LOG_TRACE(fmt::format("Unsupported expression type: In CheckInExprIndexState(), {} is a \"not in\" expression.", expression->Name()));
+            return false;
+        }
+        const auto &left = in_expression->left_operand();
+        if (left->type() != ExpressionType::kColumn or !left->Type().CanBuildSecondaryIndex() or !left->Type().IsNumeric()) {
+            LOG_TRACE(fmt::format("In CheckInExprIndexState(), left expression {} is not a numeric column.", left->Name()));
+            return false;
+        }
+        auto column_id = std::static_pointer_cast<ColumnExpression>(left)->binding().column_idx;
+        if (!candidate_column_index_map_.contains(column_id)) {
+            LOG_TRACE(fmt::format("In CheckInExprIndexState(), column {} does not have a secondary index.", left->Name()));
+            return false;
+        }
+        for (auto &argument : expression->arguments()) {
+            if (!IsValueResultExpression(argument, 1)) {
+                LOG_TRACE(fmt::format("In CheckInExprIndexState(), {} is not a value.", argument->Name()));
+                return false;
+            }
+        }
+        return true;
+    }
+
     inline void PrepareResult() {
         auto and_function_set_ptr = Catalog::GetFunctionSetByName(query_context_->storage()->catalog(), "AND");
         auto and_scalar_function_set_ptr = static_pointer_cast<ScalarFunctionSet>(and_function_set_ptr);
@@ -408,6 +623,8 @@ private:
                 // check left argument
                 return AddIndexForColumnExpression(expression->arguments()[0]);
             }
+        } else if (expression->type() == ExpressionType::kIn) {
+            return AddIndexForColumnExpression(std::static_pointer_cast<InExpression>(expression)->left_operand());
         } else {
             return false;
         }
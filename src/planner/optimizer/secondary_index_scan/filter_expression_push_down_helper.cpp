@@ -280,6 +280,10 @@ inline void RewriteCompare(Value &right_val, FilterCompareType &compare_type) {
 }
 
 inline void SimplifyCompareTypeAndValue(Value &right_val, FilterCompareType &compare_type) {
+    if (right_val.type().type() == LogicalType::kVarchar) {
+        // no previous / next string, the range of encoded varchar keys can be half open
+        return;
+    }
     switch (compare_type) {
         case FilterCompareType::kLess: {
             RewriteCompare(right_val, compare_type);
@@ -82,6 +82,10 @@ private:
                 result.SetIntervalRange<TimestampT>(value, compare_type);
                 break;
             }
+            case LogicalType::kVarchar: {
+                result.SetEncodedKeyRange(FilterEncodedKeyRange(value, compare_type));
+                break;
+            }
             default: {
                 UnrecoverableError(fmt::format("SaveToResult(): type error: {}.", value.type().ToString()));
             }
@@ -95,6 +99,9 @@ private:
                 result_.emplace_back(std::in_place_index<1>, column_id, FilterRangeType::kEmpty);
                 return;
             }
+            case FilterCompareType::kLess:
+            case FilterCompareType::kGreater:
+                // only varchar keeps kLess and kGreater
             case FilterCompareType::kEqual:
             case FilterCompareType::kLessEqual:
             case FilterCompareType::kGreaterEqual:
@@ -142,11 +149,15 @@ private:
         if (last_elem.GetColumnID() != second_last_elem.GetColumnID()) {
             return false;
         }
-        // same column id, same type
         auto &second_last_interval = second_last_elem.GetIntervalRange();
         auto &last_interval = last_elem.GetIntervalRange();
+        // same column id, but the range on the leading column of an index on several columns has a different type
+        if (second_last_interval.index() != last_interval.index()) {
+            return false;
+        }
         bool merge_result = std::visit(Overload{
             []<typename T>(FilterIntervalRangeT<T> &second_last, const FilterIntervalRangeT<T> &last) -> bool { return second_last.MergeAnd(last); },
+            [](FilterEncodedKeyRange &second_last, const FilterEncodedKeyRange &last) -> bool { return second_last.MergeAnd(last); },
             []<typename T1, typename T2>
                 requires IncompatibleFilterIntervalRangePair<T1, T2>
             (T1 & x, T2 & y) -> bool {
@@ -21,6 +21,7 @@ import value;
 import base_expression;
 import infinity_exception;
 import secondary_index_data;
+import secondary_index_key;
 import secondary_index_scan_middle_expression;
 import filter_expression_push_down_helper;
 import internal_types;
@@ -29,6 +30,116 @@ import filter_value_type_classification;
 
 namespace infinity {
 
+// Half open range [begin_key_, end_key_) of order preserving keys, see secondary_index_key.
+// Used for the index on varchar column and for the index on several columns.
+// No end_key_ means no upper bound.
+export class FilterEncodedKeyRange {
+public:
+    // the whole range
+    FilterEncodedKeyRange() = default;
+
+    // "x compare_type val" on a varchar column
+    // compare_type can also be kLess or kGreater here, no need to rewrite them into kLessEqual or kGreaterEqual
+    explicit FilterEncodedKeyRange(const Value &val, FilterCompareType compare_type) : FilterEncodedKeyRange(String(), &val, compare_type) {}
+
+    // leading columns of the key are equal to the values encoded in equal_prefix, then "next column compare_type val"
+    // val can be nullptr: only the leading columns are compared
+    FilterEncodedKeyRange(const String &equal_prefix, const Value *val, FilterCompareType compare_type) {
+        begin_key_ = equal_prefix;
+        SetEnd(SecondaryIndexKeySuccessor(equal_prefix));
+        if (val == nullptr) {
+            return;
+        }
+        String key = equal_prefix;
+        AppendSecondaryIndexKey(key, *val);
+        switch (compare_type) {
+            case FilterCompareType::kEqual: {
+                AddGE(key);
+                AddLT(SecondaryIndexKeySuccessor(key));
+                break;
+            }
+            case FilterCompareType::kLess: {
+                AddLT(key);
+                break;
+            }
+            case FilterCompareType::kLessEqual: {
+                AddLT(SecondaryIndexKeySuccessor(key));
+                break;
+            }
+            case FilterCompareType::kGreater: {
+                String successor = SecondaryIndexKeySuccessor(key);
+                if (successor.empty()) {
+                    // no key is greater
+                    SetAlwaysFalse();
+                } else {
+                    AddGE(successor);
+                }
+                break;
+            }
+            case FilterCompareType::kGreaterEqual: {
+                AddGE(key);
+                break;
+            }
+            case FilterCompareType::kAlwaysTrue: {
+                break;
+            }
+            default: {
+                UnrecoverableError("FilterEncodedKeyRange: compare type error.");
+            }
+        }
+    }
+
+    // [begin_key, end_key_inclusive]
+    static FilterEncodedKeyRange MakeClosed(String begin_key, const String &end_key_inclusive) {
+        FilterEncodedKeyRange range;
+        range.begin_key_ = std::move(begin_key);
+        range.SetEnd(SecondaryIndexKeySuccessor(end_key_inclusive));
+        return range;
+    }
+
+    [[nodiscard]] bool MergeAnd(const FilterEncodedKeyRange &other) {
+        AddGE(other.begin_key_);
+        if (other.end_key_) {
+            AddLT(*other.end_key_);
+        }
+        return !IsAlwaysFalse();
+    }
+
+    [[nodiscard]] const String &BeginKey() const { return begin_key_; }
+
+    [[nodiscard]] const Optional<String> &EndKey() const { return end_key_; }
+
+    [[nodiscard]] bool IsAlwaysFalse() const { return end_key_ and *end_key_ <= begin_key_; }
+
+    inline void SetAlwaysFalse() {
+        begin_key_.clear();
+        end_key_ = String();
+    }
+
+private:
+    String begin_key_;
+    Optional<String> end_key_;
+
+    // empty end_key is the successor of keys full of 0xFF: no upper bound
+    inline void SetEnd(String end_key) {
+        if (end_key.empty()) {
+            end_key_ = None;
+        } else {
+            end_key_ = std::move(end_key);
+        }
+    }
+    inline void AddGE(const String &key) {
+        if (key > begin_key_) {
+            begin_key_ = key;
+        }
+    }
+    inline void AddLT(const String &key) {
+        if (!end_key_ or key < *end_key_) {
+            end_key_ = key;
+        }
+    }
+};
+
 // The range will only monotonically shrink
 // MergeAnd is meaningful: reduce the search range
 // MergeOr is not needed if expression rewrite is done
@@ -59,6 +170,20 @@ public:
         begin_val_ = std::numeric_limits<T>::max();
     }
 
+    // the same range on the leading column of an index on several columns
+    [[nodiscard]] FilterEncodedKeyRange ToEncodedKeyRange() const {
+        if (begin_val_ > end_val_) {
+            FilterEncodedKeyRange range;
+            range.SetAlwaysFalse();
+            return range;
+        }
+        String begin_key;
+        String end_key;
+        AppendSecondaryIndexKeyT(begin_key, begin_val_);
+        AppendSecondaryIndexKeyT(end_key, end_val_);
+        return FilterEncodedKeyRange::MakeClosed(std::move(begin_key), end_key);
+    }
+
 private:
     // The interval range will only monotonically shrink
     // default: the whole range of T
@@ -113,12 +238,13 @@ export using FilterIntervalRange = std::variant<std::monostate,
                                                 FilterIntervalRangeT<DateT>,
                                                 FilterIntervalRangeT<TimeT>,
                                                 FilterIntervalRangeT<DateTimeT>,
-                                                FilterIntervalRangeT<TimestampT>>;
+                                                FilterIntervalRangeT<TimestampT>,
+                                                FilterEncodedKeyRange>;
 
 // because some rows may be deleted, kAlwaysTrue is meaningless
 // kInterval of the same column can be merged in "AND" condition
 // kAlwaysFalse can be merged with any other condition
-enum class FilterRangeType : i8 { kEmpty, kInterval };
+export enum class FilterRangeType : i8 { kEmpty, kInterval };
 
 export class FilterExecuteSingleRange {
     ColumnID column_id_{};
@@ -127,6 +253,7 @@ export class FilterExecuteSingleRange {
 
     inline void SetIntervalToEmpty() {
         std::visit(Overload{[]<typename T>(FilterIntervalRangeT<T> &interval) { interval.SetAlwaysFalse(); },
+                            [](FilterEncodedKeyRange &interval) { interval.SetAlwaysFalse(); },
                             [](const std::monostate &empty) {
                                 UnrecoverableError("FilterExecuteSingleRange::SetIntervalToEmpty(): class member interval_range_ not initialized!");
                             }},
@@ -159,6 +286,8 @@ public:
     void SetIntervalRange(const Value &value, FilterCompareType compare_type) {
         interval_range_.emplace<FilterIntervalRangeT<ColumnValueType>>(value, compare_type);
     }
+
+    void SetEncodedKeyRange(FilterEncodedKeyRange range) { interval_range_.emplace<FilterEncodedKeyRange>(std::move(range)); }
 };
 
 export enum class FilterExecuteCombineType : i8 { kAnd, kOr };
@@ -33,6 +33,8 @@ import internal_types;
 import data_type;
 import logical_type;
 import filter_expression_push_down_helper;
+import in_expression;
+import in_value_set;
 
 namespace infinity {
 
@@ -50,7 +52,7 @@ public:
 
 private:
     inline bool BuildFilterEvaluator(SharedPtr<BaseExpression> &expression) {
-        // expression: 1. basic component "[cast] x compare value_expr" 2. combine component with "and/or/not"
+        // expression: 1. basic component "[cast] x compare value_expr" or "x IN (value_expr, ...)" 2. combine component with "and/or/not"
         if (expression->type() == ExpressionType::kFunction) {
             auto function_expression = std::static_pointer_cast<FunctionExpression>(expression);
             auto const &function_name = function_expression->ScalarFunctionName();
@@ -90,6 +92,12 @@ private:
                         result_.emplace_back(column_id);
                         result_.emplace_back(final_val);
                         // make sure that result_ only contain FilterCompareType of kEqual, kLessEqual, kGreaterEqual, kAlwaysFalse, kAlwaysTrue
+                        // kLess and kGreater are kept for varchar
+                        if (final_val.type().type() == LogicalType::kVarchar and
+                            (final_compare_type == FilterCompareType::kLess or final_compare_type == FilterCompareType::kGreater)) {
+                            result_.emplace_back(final_compare_type);
+                            return true;
+                        }
                         switch (final_compare_type) {
                             case FilterCompareType::kEqual:
                             case FilterCompareType::kLessEqual:
@@ -114,12 +122,45 @@ private:
                     return false;
                 }
             }
+        } else if (expression->type() == ExpressionType::kIn) {
+            // "x IN (value_expr, ...)": a lookup of each distinct value
+            auto in_expression = std::static_pointer_cast<InExpression>(expression);
+            auto column_expression = std::static_pointer_cast<ColumnExpression>(in_expression->left_operand());
+            ColumnID column_id = column_expression->binding().column_idx;
+            Vector<Value> values;
+            values.reserve(in_expression->arguments().size());
+            for (auto &argument : in_expression->arguments()) {
+                values.push_back(FilterExpressionPushDownHelper::CalcValueResult(argument));
+            }
+            Vector<Value> points = InValueSet(column_expression->Type(), values).ToValues();
+            if (points.empty()) {
+                result_.emplace_back(column_id);
+                result_.emplace_back(Value::MakeNull());
+                result_.emplace_back(FilterCompareType::kAlwaysFalse);
+                return true;
+            }
+            BuildPointsEvaluator(column_id, points, 0, points.size());
+            return true;
         } else {
             UnrecoverableError(fmt::format("BuildFilterEvaluator(): expression type error: {}.", expression->Name()));
             return false;
         }
     }
 
+    // The points are ORed as a balanced tree, so that the lookup results are merged in log(points) rounds instead of one by one.
+    inline void BuildPointsEvaluator(ColumnID column_id, const Vector<Value> &points, SizeT begin, SizeT end) {
+        if (end - begin == 1) {
+            result_.emplace_back(column_id);
+            result_.emplace_back(points[begin]);
+            result_.emplace_back(FilterCompareType::kEqual);
+            return;
+        }
+        SizeT mid = begin + (end - begin) / 2;
+        BuildPointsEvaluator(column_id, points, begin, mid);
+        BuildPointsEvaluator(column_id, points, mid, end);
+        result_.emplace_back(BooleanCombineType::kOr);
+    }
+
     inline static BooleanCombineType GetBooleanCombineType(const String &function_name) {
         if (function_name == "AND") {
             return BooleanCombineType::kAnd;
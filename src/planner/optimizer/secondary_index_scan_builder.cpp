@@ -28,6 +28,12 @@ import infinity_exception;
 import logger;
 import third_party;
 import filter_expression_push_down;
+import cost_model;
+import base_expression;
+import function_expression;
+import scalar_function;
+import scalar_function_set;
+import catalog;
 
 namespace infinity {
 
@@ -62,6 +68,10 @@ public:
                 if (!v_qualified) {
                     // no qualified index filter condition, keep the table scan
                     LOG_TRACE("BuildSecondaryIndexScan: No qualified index scan filter. Keep the table scan.");
+                } else if (TableScanIsCheaper(table_scan, v_qualified)) {
+                    // the index filter selects too many rows, evaluate it in the filter node
+                    LOG_TRACE("BuildSecondaryIndexScan: Table scan is cheaper than index scan. Keep the table scan.");
+                    s_leftover = s_leftover ? MakeAndExpression(std::move(v_qualified), std::move(s_leftover)) : std::move(v_qualified);
                 } else {
                     // try to push down the qualified index filter condition to the scan
                     // replace logical table scan with logical index scan
@@ -92,6 +102,35 @@ public:
     }
 
 private:
+    // Without statistics the index scan is always used.
+    bool TableScanIsCheaper(const LogicalTableScan &table_scan, SharedPtr<BaseExpression> &index_filter) const {
+        SharedPtr<TableStatistics> table_statistics = TableStatistics::Make(*table_scan.base_table_ref_);
+        if (!table_statistics) {
+            return false;
+        }
+        TableStatisticsMap statistics_map{{table_scan.TableIndex(), table_statistics}};
+        f64 selectivity = CostModel::EstimateSelectivity(index_filter, statistics_map);
+        f64 row_count = table_statistics->row_count();
+        f64 table_scan_cost = CostModel::TableScanCost(row_count);
+        f64 index_scan_cost = CostModel::IndexScanCost(row_count, selectivity, table_statistics->segment_count());
+        LOG_TRACE(fmt::format("BuildSecondaryIndexScan: rows: {}, index filter selectivity: {}, table scan cost: {}, index scan cost: {}",
+                              row_count,
+                              selectivity,
+                              table_scan_cost,
+                              index_scan_cost));
+        return table_scan_cost < index_scan_cost;
+    }
+
+    SharedPtr<BaseExpression> MakeAndExpression(SharedPtr<BaseExpression> left, SharedPtr<BaseExpression> right) const {
+        auto and_function_set_ptr = Catalog::GetFunctionSetByName(query_context_->storage()->catalog(), "AND");
+        auto and_scalar_function_set_ptr = static_pointer_cast<ScalarFunctionSet>(and_function_set_ptr);
+        Vector<SharedPtr<BaseExpression>> arguments;
+        arguments.emplace_back(std::move(left));
+        arguments.emplace_back(std::move(right));
+        ScalarFunction and_func = and_scalar_function_set_ptr->GetMostMatchFunction(arguments);
+        return MakeShared<FunctionExpression>(std::move(and_func), std::move(arguments));
+    }
+
     QueryContext *query_context_ = nullptr;
 };
 
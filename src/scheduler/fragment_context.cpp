@@ -88,7 +88,7 @@ UniquePtr<OperatorState> MakeTableScanState(PhysicalTableScan *physical_table_sc
     UniquePtr<OperatorState> operator_state = MakeUnique<TableScanOperatorState>();
     TableScanOperatorState *table_scan_op_state_ptr = (TableScanOperatorState *)(operator_state.get());
     table_scan_op_state_ptr->table_scan_function_data_ = MakeUnique<TableScanFunctionData>(physical_table_scan->GetBlockIndex(),
-                                                                                           table_scan_source_state->global_ids_,
+                                                                                           table_scan_source_state->morsel_source_,
                                                                                            physical_table_scan->ColumnIDs());
     return operator_state;
 }
@@ -677,11 +677,11 @@ void FragmentContext::MakeSourceState(i64 parallel_count) {
                 UnrecoverableError(fmt::format("{} task count isn't correct.", PhysicalOperatorToString(first_operator->operator_type())));
             }
 
-            // Partition the hash range to each source state
+            // Partition the blocks to each source state, top-N scans pull from one shared morsel source
             auto *table_scan_operator = (PhysicalTableScan *)first_operator;
-            Vector<SharedPtr<Vector<GlobalBlockID>>> blocks_group = table_scan_operator->PlanBlockEntries(parallel_count);
+            Vector<SharedPtr<TableScanMorselSource>> morsel_sources = table_scan_operator->PlanMorsels(parallel_count);
             for (i64 task_id = 0; task_id < parallel_count; ++task_id) {
-                tasks_[task_id]->source_state_ = MakeUnique<TableScanSourceState>(blocks_group[task_id]);
+                tasks_[task_id]->source_state_ = MakeUnique<TableScanSourceState>(morsel_sources[task_id]);
             }
             break;
         }
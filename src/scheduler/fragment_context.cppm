@@ -55,10 +55,19 @@ export String FragmentType2String(FragmentType type) {
     }
 }
 
+// Workers take the tasks of high priority queries first, so short queries don't wait behind large scans.
+export enum class QueryPriority : u8 {
+    kHigh,
+    kNormal,
+};
+
+export constexpr SizeT QUERY_PRIORITY_COUNT = 2;
+
 export class Notifier {
     SizeT all_task_n_ = 0;
     SizeT start_task_n_ = 0;
     bool error_ = false;
+    QueryPriority priority_ = QueryPriority::kNormal;
     FragmentContext *error_fragment_ctx_ = nullptr;
 
     std::mutex locker_{};
@@ -69,6 +78,10 @@ export class Notifier {
 public:
     void SetTaskN(SizeT all_task_n) { all_task_n_ = all_task_n; }
 
+    void SetPriority(QueryPriority priority) { priority_ = priority; }
+
+    QueryPriority priority() const { return priority_; }
+
     void Wait() {
         std::unique_lock<std::mutex> lk(locker_);
         cv_.wait(lk, [&] { return this->Check(); });
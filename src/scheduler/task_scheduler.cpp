@@ -14,7 +14,6 @@
 
 module;
 
-#include <list>
 #include <sched.h>
 
 module task_scheduler;
@@ -37,9 +36,18 @@ import physical_sink;
 import base_statement;
 import extra_ddl_info;
 import create_statement;
+import physical_table_scan;
+import physical_index_scan;
 
 namespace infinity {
 
+namespace {
+
+// The worker running on this thread, null on the other threads
+thread_local Worker *current_worker = nullptr;
+
+} // namespace
+
 // Non-static memory methods
 
 TaskScheduler::TaskScheduler(const Config *config_ptr) { Init(config_ptr); }
@@ -47,7 +55,6 @@ TaskScheduler::TaskScheduler(const Config *config_ptr) { Init(config_ptr); }
 void TaskScheduler::Init(const Config *config_ptr) {
     worker_count_ = config_ptr->worker_cpu_limit();
     worker_array_.reserve(worker_count_);
-    worker_workloads_.resize(worker_count_);
     u64 cpu_count = Thread::hardware_concurrency();
 
     u64 cpu_select_step = cpu_count / worker_count_;
@@ -57,44 +64,32 @@ void TaskScheduler::Init(const Config *config_ptr) {
         cpu_select_step = 1;
     }
 
-    for (u64 cpu_id = 0; cpu_id < worker_count_; cpu_id += cpu_select_step) {
-        UniquePtr<FragmentTaskBlockQueue> worker_queue = MakeUnique<FragmentTaskBlockQueue>();
-        UniquePtr<Thread> worker_thread = MakeUnique<Thread>(&TaskScheduler::WorkerLoop, this, worker_queue.get(), cpu_id);
-        // Pin the thread to specific cpu
-        ThreadUtil::pin(*worker_thread, cpu_id % cpu_count);
-
-        worker_array_.emplace_back(cpu_id, std::move(worker_queue), std::move(worker_thread));
-        worker_workloads_[cpu_id] = 0;
+    for (u64 worker_id = 0; worker_id < worker_count_; ++worker_id) {
+        worker_array_.emplace_back(MakeUnique<Worker>(worker_id, worker_id * cpu_select_step % cpu_count));
     }
-
     if (worker_array_.empty()) {
         UnrecoverableError("No cpu is used in scheduler");
     }
 
+    // Workers steal from each other, start them once all of them exist
+    stop_ = false;
+    for (auto &worker : worker_array_) {
+        worker->thread_ = MakeUnique<Thread>(&TaskScheduler::WorkerLoop, this, worker.get());
+        // Pin the thread to specific cpu
+        ThreadUtil::pin(*worker->thread_, worker->cpu_id_);
+    }
+
     initialized_ = true;
 }
 
 void TaskScheduler::UnInit() {
     initialized_ = false;
-    UniquePtr<FragmentTask> terminate_task = MakeUnique<FragmentTask>(true);
+    stop_ = true;
+    WakeWorker(true);
 
     for (const auto &worker : worker_array_) {
-        worker.queue_->Enqueue(terminate_task.get());
-        worker.thread_->join();
-    }
-}
-
-u64 TaskScheduler::FindLeastWorkloadWorker() {
-    u64 min_workload = worker_workloads_[0];
-    u64 min_workload_worker_id = 0;
-    for (u64 worker_id = 1; worker_id < worker_count_ && min_workload; ++worker_id) {
-        u64 current_worker_load = worker_workloads_[worker_id];
-        if (current_worker_load < min_workload) {
-            min_workload = current_worker_load;
-            min_workload_worker_id = worker_id;
-        }
+        worker->thread_->join();
     }
-    return min_workload_worker_id;
 }
 
 SizeT TaskScheduler::GetStartFragments(PlanFragment *plan_fragment, Vector<PlanFragment *> &leaf_fragments) {
@@ -159,7 +154,9 @@ void TaskScheduler::Schedule(PlanFragment *plan_fragment, const BaseStatement *b
 
     Vector<PlanFragment *> start_fragments;
     SizeT task_n = GetStartFragments(plan_fragment, start_fragments);
-    plan_fragment->GetContext()->notifier()->SetTaskN(task_n);
+    Notifier *notifier = plan_fragment->GetContext()->notifier();
+    notifier->SetTaskN(task_n);
+    notifier->SetPriority(GetQueryPriority(start_fragments));
     for (auto *sub_fragment : start_fragments) {
         auto &tasks = sub_fragment->GetContext()->Tasks();
         for (auto &task : tasks) {
@@ -167,12 +164,32 @@ void TaskScheduler::Schedule(PlanFragment *plan_fragment, const BaseStatement *b
             if (!task->TryIntoWorkerLoop()) {
                 UnrecoverableError("Task can't be scheduled");
             }
-            u64 worker_id = FindLeastWorkloadWorker();
-            ScheduleTask(task.get(), worker_id);
+            ScheduleTask(task.get());
         }
     }
 }
 
+QueryPriority TaskScheduler::GetQueryPriority(const Vector<PlanFragment *> &start_fragments) {
+    SizeT block_count = 0;
+    for (auto *fragment : start_fragments) {
+        PhysicalOperator *source_operator = fragment->GetOperators().back();
+        switch (source_operator->operator_type()) {
+            case PhysicalOperatorType::kTableScan: {
+                block_count += static_cast<PhysicalTableScan *>(source_operator)->BlockEntryCount();
+                break;
+            }
+            case PhysicalOperatorType::kIndexScan: {
+                block_count += static_cast<PhysicalIndexScan *>(source_operator)->EstimatedBlockCount();
+                break;
+            }
+            default: {
+                return QueryPriority::kNormal;
+            }
+        }
+    }
+    return block_count <= SHORT_QUERY_BLOCK_COUNT ? QueryPriority::kHigh : QueryPriority::kNormal;
+}
+
 void TaskScheduler::RunTask(FragmentTask *task) {
 
     bool finish = false;
@@ -203,53 +220,96 @@ void TaskScheduler::ScheduleFragment(PlanFragment *plan_fragment) {
         }
     }
     for (auto *task_ptr : task_ptrs) {
-        if (task_ptr->LastWorkerID() == -1) {
-            u64 worker_id = FindLeastWorkloadWorker();
-            ScheduleTask(task_ptr, worker_id);
-        } else {
-            ScheduleTask(task_ptr, task_ptr->LastWorkerID());
-        }
+        ScheduleTask(task_ptr);
     }
 }
 
-void TaskScheduler::ScheduleTask(FragmentTask *task, u64 worker_id) {
-    ++worker_workloads_[worker_id];
-    worker_array_[worker_id].queue_->Enqueue(task);
+void TaskScheduler::ScheduleTask(FragmentTask *task) {
+    SizeT priority = static_cast<SizeT>(task->fragment_context()->notifier()->priority());
+    if (current_worker != nullptr) {
+        // Scheduled by a task of this worker, such as the parent fragment of a stream. It runs here next unless an idle worker steals it.
+        current_worker->task_deques_[priority].Push(task);
+    } else {
+        std::lock_guard<std::mutex> lock(injected_mutex_);
+        injected_tasks_[priority].push_back(task);
+        ++injected_task_counts_[priority];
+    }
+    WakeWorker(false);
 }
 
-void TaskScheduler::WorkerLoop(FragmentTaskBlockQueue *task_queue, i64 worker_id) {
-    List<FragmentTask *> task_lists;
-    auto iter = task_lists.end();
-    auto last_iter = task_lists.end();
-    while (true) {
-        if (iter == last_iter) {
-            Vector<FragmentTask *> dequeue_output;
-            if (task_lists.empty()) {
-                task_queue->DequeueBulk(dequeue_output);
+bool TaskScheduler::TakeTask(Worker *worker, FragmentTask *&task) {
+    // Once the worker has run its quota of high priority tasks in a row, a normal priority task goes first.
+    bool normal_first = worker->high_priority_streak_ >= HIGH_PRIORITY_TASK_QUOTA;
+    for (SizeT i = 0; i < QUERY_PRIORITY_COUNT; ++i) {
+        SizeT priority = normal_first ? QUERY_PRIORITY_COUNT - 1 - i : i;
+        if (TakeTask(worker, priority, task)) {
+            if (priority == static_cast<SizeT>(QueryPriority::kHigh)) {
+                ++worker->high_priority_streak_;
             } else {
-                task_queue->TryDequeueBulk(dequeue_output);
-            }
-            if (!dequeue_output.empty()) {
-                task_lists.insert(task_lists.end(), dequeue_output.begin(), dequeue_output.end());
+                worker->high_priority_streak_ = 0;
             }
-            last_iter = task_lists.end();
+            return true;
         }
-        if (iter == task_lists.end()) {
-            iter = task_lists.begin();
+    }
+    return false;
+}
+
+bool TaskScheduler::TakeTask(Worker *worker, SizeT priority, FragmentTask *&task) {
+    if (worker->task_deques_[priority].Pop(task)) {
+        return true;
+    }
+    if (injected_task_counts_[priority].load() > 0) {
+        std::lock_guard<std::mutex> lock(injected_mutex_);
+        if (!injected_tasks_[priority].empty()) {
+            task = injected_tasks_[priority].front();
+            injected_tasks_[priority].pop_front();
+            --injected_task_counts_[priority];
+            return true;
         }
-        auto &fragment_task = *iter;
-        if (fragment_task->IsTerminator()) {
-            break;
+    }
+    for (SizeT i = 1; i < worker_count_; ++i) {
+        Worker *victim = worker_array_[(worker->worker_id_ + i) % worker_count_].get();
+        if (victim->task_deques_[priority].Steal(task)) {
+            return true;
         }
+    }
+    return false;
+}
+
+void TaskScheduler::WakeWorker(bool all) {
+    ++task_epoch_;
+    {
+        // A worker checking the epoch before it sleeps either sees the new epoch or is woken up
+        std::lock_guard<std::mutex> lock(idle_mutex_);
+    }
+    if (all) {
+        idle_cv_.notify_all();
+    } else {
+        idle_cv_.notify_one();
+    }
+}
+
+// A task runs one step, which reads one morsel from its source, and goes back to the bottom of the deque of the worker. The worker picks
+// it up again unless a task of higher priority is waiting. The tasks on the top of the deque are stolen by idle workers, so a skewed
+// fragment doesn't hold the tasks queued behind it.
+void TaskScheduler::WorkerLoop(Worker *worker) {
+    current_worker = worker;
+    while (!stop_) {
+        u64 epoch = task_epoch_;
+        FragmentTask *fragment_task = nullptr;
+        if (!TakeTask(worker, fragment_task)) {
+            std::unique_lock<std::mutex> lock(idle_mutex_);
+            idle_cv_.wait(lock, [&] { return stop_ || task_epoch_ != epoch; });
+            continue;
+        }
+
         auto *fragment_ctx = fragment_task->fragment_context();
         if (!fragment_ctx->notifier()->StartTask()) {
-            --worker_workloads_[worker_id];
-            iter = task_lists.erase(iter);
             continue;
         }
 
         fragment_task->OnExecute();
-        fragment_task->SetLastWorkID(worker_id);
+        fragment_task->SetLastWorkID(worker->worker_id_);
 
         bool error = false;
         bool finish = false;
@@ -257,26 +317,21 @@ void TaskScheduler::WorkerLoop(FragmentTaskBlockQueue *task_queue, i64 worker_id
         if (fragment_task->status() != FragmentTaskStatus::kError) {
             if (fragment_task->IsComplete()) {
                 // auto *sink_op = fragment_ctx->GetSinkOperator();
-                --worker_workloads_[worker_id];
                 fragment_task->CompleteTask();
-                iter = task_lists.erase(iter);
                 finish = true;
-            } else if (fragment_task->QuitFromWorkerLoop()) {
-                --worker_workloads_[worker_id];
-                iter = task_lists.erase(iter);
-            } else {
-                ++iter;
+            } else if (!fragment_task->QuitFromWorkerLoop()) {
+                SizeT priority = static_cast<SizeT>(fragment_ctx->notifier()->priority());
+                worker->task_deques_[priority].Push(fragment_task);
             }
         } else {
             error = true;
             finish = true;
-            --worker_workloads_[worker_id];
-            iter = task_lists.erase(iter);
         }
         if (finish) {
             fragment_ctx->notifier()->FinishTask(error, fragment_ctx);
         }
     }
+    current_worker = nullptr;
 }
 
 void TaskScheduler::DumpPlanFragment(PlanFragment *root) {
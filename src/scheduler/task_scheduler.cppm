@@ -19,7 +19,8 @@ export module task_scheduler;
 import config;
 import stl;
 import fragment_task;
-import blocking_queue;
+import fragment_context;
+import work_stealing_deque;
 import base_statement;
 
 namespace infinity {
@@ -27,13 +28,16 @@ namespace infinity {
 class QueryContext;
 class PlanFragment;
 
-using FragmentTaskBlockQueue = BlockingQueue<FragmentTask*>;
+using FragmentTaskDeque = WorkStealingDeque<FragmentTask *>;
 
 struct Worker {
-    Worker(u64 cpu_id, UniquePtr<FragmentTaskBlockQueue> queue, UniquePtr<Thread> thread)
-        : cpu_id_(cpu_id), queue_(std::move(queue)), thread_(std::move(thread)) {}
+    Worker(u64 worker_id, u64 cpu_id) : worker_id_(worker_id), cpu_id_(cpu_id) {}
+    u64 worker_id_{0};
     u64 cpu_id_{0};
-    UniquePtr<FragmentTaskBlockQueue> queue_{};
+    // One deque per query priority. The worker pushes and pops its own, the other workers steal from them.
+    Array<FragmentTaskDeque, QUERY_PRIORITY_COUNT> task_deques_{};
+    // high priority tasks taken in a row, so normal priority queries are not starved
+    SizeT high_priority_streak_{0};
     UniquePtr<Thread> thread_{};
 };
 
@@ -56,21 +60,39 @@ public:
     void DumpPlanFragment(PlanFragment *plan_fragment);
 
 private:
-    u64 FindLeastWorkloadWorker();
-
     SizeT GetStartFragments(PlanFragment* plan_fragment, Vector<PlanFragment *>& leaf_fragments);
 
-    void ScheduleTask(FragmentTask *task, u64 worker_id);
+    static QueryPriority GetQueryPriority(const Vector<PlanFragment *> &start_fragments);
+
+    void ScheduleTask(FragmentTask *task);
+
+    // High priority tasks first, but a normal priority one after HIGH_PRIORITY_TASK_QUOTA high priority tasks in a row.
+    bool TakeTask(Worker *worker, FragmentTask *&task);
+
+    // Own deque, then the injected tasks, then stealing from the other workers.
+    bool TakeTask(Worker *worker, SizeT priority, FragmentTask *&task);
+
+    void WakeWorker(bool all);
 
     void RunTask(FragmentTask *task);
 
-    void WorkerLoop(FragmentTaskBlockQueue *task_queue, i64 worker_id);
+    void WorkerLoop(Worker *worker);
 
 private:
     bool initialized_{false};
 
-    Vector<Worker> worker_array_{};
-    Deque<Atomic<u64>> worker_workloads_{};
+    Vector<UniquePtr<Worker>> worker_array_{};
+
+    // Tasks scheduled from threads other than the workers
+    std::mutex injected_mutex_{};
+    Array<Deque<FragmentTask *>, QUERY_PRIORITY_COUNT> injected_tasks_{};
+    Array<Atomic<SizeT>, QUERY_PRIORITY_COUNT> injected_task_counts_{};
+
+    // Idle workers sleep until a task is scheduled
+    std::mutex idle_mutex_{};
+    std::condition_variable idle_cv_{};
+    Atomic<u64> task_epoch_{0};
+    atomic_bool stop_{false};
 
     u64 worker_count_{0};
 };
@@ -27,6 +27,8 @@ import blocking_queue;
 import infinity_exception;
 import wal_manager;
 import catalog;
+import txn;
+import txn_manager;
 import third_party;
 
 namespace infinity {
@@ -35,6 +37,7 @@ BGTaskProcessor::BGTaskProcessor(WalManager *wal_manager, Catalog *catalog) : wa
 
 void BGTaskProcessor::Start() {
     processor_thread_ = Thread([this] { Process(); });
+    optimize_thread_ = Thread([this] { ProcessOptimize(); });
     LOG_INFO("Background processor is started.");
 }
 
@@ -44,10 +47,20 @@ void BGTaskProcessor::Stop() {
     task_queue_.Enqueue(stop_task);
     stop_task->Wait();
     processor_thread_.join();
+    SharedPtr<StopProcessorTask> stop_optimize_task = MakeShared<StopProcessorTask>();
+    optimize_task_queue_.Enqueue(stop_optimize_task);
+    stop_optimize_task->Wait();
+    optimize_thread_.join();
     LOG_INFO("Background processor is stopped.");
 }
 
-void BGTaskProcessor::Submit(SharedPtr<BGTask> bg_task) { task_queue_.Enqueue(std::move(bg_task)); }
+void BGTaskProcessor::Submit(SharedPtr<BGTask> bg_task) {
+    if (bg_task->type_ == BGTaskType::kOptimizeIndex) {
+        optimize_task_queue_.Enqueue(std::move(bg_task));
+        return;
+    }
+    task_queue_.Enqueue(std::move(bg_task));
+}
 
 void BGTaskProcessor::Process() {
     bool running{true};
@@ -118,4 +131,37 @@ void BGTaskProcessor::Process() {
     }
 }
 
+void BGTaskProcessor::ProcessOptimize() {
+    bool running{true};
+    Deque<SharedPtr<BGTask>> tasks;
+    while (running) {
+        optimize_task_queue_.DequeueBulk(tasks);
+        for (const auto &bg_task : tasks) {
+            switch (bg_task->type_) {
+                case BGTaskType::kStopProcessor: {
+                    LOG_INFO("Stop the background optimize processor");
+                    running = false;
+                    break;
+                }
+                case BGTaskType::kOptimizeIndex: {
+                    auto *task = static_cast<OptimizeIndexTask *>(bg_task.get());
+                    SizeT merge_count = catalog_->OptimizeIndexChunks(task->txn_, task->policy_, task->rate_limiter_);
+                    task->txn_->txn_mgr()->CommitTxn(task->txn_);
+                    if (merge_count > 0) {
+                        LOG_INFO(fmt::format("Merged {} full-text chunk runs in background", merge_count));
+                    }
+                    break;
+                }
+                default: {
+                    UnrecoverableError("Invalid background optimize task");
+                    break;
+                }
+            }
+
+            bg_task->Complete();
+        }
+        tasks.clear();
+    }
+}
+
 } // namespace infinity
@@ -37,10 +37,16 @@ public:
 private:
     void Process();
 
+    void ProcessOptimize();
+
 private:
     BlockingQueue<SharedPtr<BGTask>> task_queue_;
     Thread processor_thread_{};
 
+    // The I/O-throttled chunk index merge runs on its own thread, so it never holds up checkpoint and cleanup.
+    BlockingQueue<SharedPtr<BGTask>> optimize_task_queue_;
+    Thread optimize_thread_{};
+
     WalManager *wal_manager_{};
     Catalog *catalog_{};
 };
@@ -19,6 +19,8 @@ import txn;
 import catalog;
 import catalog_delta_entry;
 import cleanup_scanner;
+import chunk_index_merge_policy;
+import rate_limiter;
 
 export module bg_task;
 
@@ -31,6 +33,7 @@ export enum class BGTaskType {
     kForceCheckpoint, // Manually triggered by PhysicalFlush
     kCompactSegments,
     kCleanup,
+    kOptimizeIndex,
     kUpdateSegmentBloomFilterData, // Not used
     kInvalid
 };
@@ -49,6 +52,8 @@ export String BGTaskTypeToString(BGTaskType type) {
             return "CompactSegments";
         case BGTaskType::kCleanup:
             return "Cleanup";
+        case BGTaskType::kOptimizeIndex:
+            return "OptimizeIndex";
         case BGTaskType::kUpdateSegmentBloomFilterData:
             return "UpdateSegmentBloomFilterData";
         default:
@@ -85,6 +90,11 @@ export struct BGTask {
         cv_.notify_one();
     }
 
+    bool IsComplete() {
+        std::unique_lock<std::mutex> locker(mutex_);
+        return complete_;
+    }
+
     virtual String ToString() const = 0;
 };
 
@@ -152,4 +162,17 @@ private:
     const TxnTimeStamp visible_ts_;
 };
 
+export struct OptimizeIndexTask final : public BGTask {
+    OptimizeIndexTask(Txn *txn, const TieredChunkMergePolicy &policy, RateLimiter *rate_limiter)
+        : BGTask(BGTaskType::kOptimizeIndex, false), txn_(txn), policy_(policy), rate_limiter_(rate_limiter) {}
+
+    ~OptimizeIndexTask() override = default;
+
+    String ToString() const override { return "OptimizeIndexTask"; }
+
+    Txn *txn_{};
+    const TieredChunkMergePolicy policy_;
+    RateLimiter *const rate_limiter_{}; // owned by the trigger, shared by its successive tasks
+};
+
 } // namespace infinity
@@ -43,6 +43,16 @@ void CleanupPeriodicTrigger::Trigger() {
     bg_processor_->Submit(std::move(cleanup_task));
 }
 
+void OptimizeIndexPeriodicTrigger::Trigger() {
+    if (running_task_.get() != nullptr && !running_task_->IsComplete()) {
+        LOG_TRACE("Skip optimize index because the previous optimize index task is still running.");
+        return;
+    }
+    Txn *txn = txn_mgr_->BeginTxn();
+    running_task_ = MakeShared<OptimizeIndexTask>(txn, policy_, &rate_limiter_);
+    bg_processor_->Submit(running_task_);
+}
+
 void CheckpointPeriodicTrigger::Trigger() {
     auto checkpoint_task = MakeShared<CheckpointTask>(is_full_checkpoint_);
     LOG_INFO(fmt::format("Trigger {} periodic checkpoint.", is_full_checkpoint_ ? "FULL" : "DELTA"));
@@ -21,6 +21,9 @@ import background_process;
 import catalog;
 import txn_manager;
 import wal_manager;
+import bg_task;
+import chunk_index_merge_policy;
+import rate_limiter;
 
 namespace infinity {
 
@@ -63,6 +66,23 @@ private:
     TxnTimeStamp last_visible_ts_{0};
 };
 
+// Periodically submits a background merge of the full-text chunk indexes, unless the previous one is still running.
+export class OptimizeIndexPeriodicTrigger final : public PeriodicTrigger {
+public:
+    OptimizeIndexPeriodicTrigger(std::chrono::milliseconds interval, BGTaskProcessor *bg_processor, TxnManager *txn_mgr, u64 io_bytes_per_sec)
+        : PeriodicTrigger(interval), bg_processor_(bg_processor), txn_mgr_(txn_mgr), rate_limiter_(io_bytes_per_sec) {}
+
+    virtual void Trigger() override;
+
+private:
+    BGTaskProcessor *const bg_processor_{};
+    TxnManager *const txn_mgr_{};
+
+    const TieredChunkMergePolicy policy_{};
+    RateLimiter rate_limiter_;
+    SharedPtr<OptimizeIndexTask> running_task_{};
+};
+
 export class CheckpointPeriodicTrigger final : public PeriodicTrigger {
 public:
     explicit CheckpointPeriodicTrigger(std::chrono::milliseconds interval, WalManager *wal_mgr, bool full_checkpoint)
@@ -0,0 +1,197 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+#include <algorithm>
+#include <bit>
+#include <type_traits>
+module build_segment_statistics_task;
+
+import stl;
+import block_entry;
+import segment_entry;
+import table_entry;
+import segment_iter;
+import infinity_exception;
+import internal_types;
+import logical_type;
+import logger;
+import buffer_manager;
+import block_column_entry;
+import column_vector;
+import bitmask;
+import value;
+import third_party;
+import block_column_iter;
+import probabilistic_data_filter;
+import segment_statistics;
+
+namespace infinity {
+
+void BuildSegmentStatisticsTask::ExecuteOnNewSealedSegment(SegmentEntry *segment_entry, BufferManager *buffer_manager, TxnTimeStamp begin_ts) {
+    LOG_TRACE(fmt::format("BuildSegmentStatisticsTask: build statistics for segment {}, job begin.", segment_entry->segment_id()));
+    SharedPtr<SegmentStatistics> statistics;
+    // same as the fast rough filter: a segment full because of append is read with block versions
+    switch (auto status = segment_entry->status(); status) {
+        case SegmentStatus::kUnsealed: {
+            statistics = ExecuteInner<true>(segment_entry, buffer_manager, begin_ts);
+            break;
+        }
+        case SegmentStatus::kSealed: {
+            statistics = ExecuteInner<false>(segment_entry, buffer_manager, begin_ts);
+            break;
+        }
+        default: {
+            UnrecoverableError(fmt::format("BuildSegmentStatisticsTask: segment {} status {} cannot build statistics",
+                                           segment_entry->segment_id(),
+                                           static_cast<std::underlying_type_t<SegmentStatus>>(status)));
+            return;
+        }
+    }
+    segment_entry->SetStatistics(std::move(statistics));
+    LOG_TRACE(fmt::format("BuildSegmentStatisticsTask: build statistics for segment {}, job end.", segment_entry->segment_id()));
+}
+
+template <bool CheckTS>
+SharedPtr<SegmentStatistics>
+BuildSegmentStatisticsTask::ExecuteInner(SegmentEntry *segment_entry, BufferManager *buffer_manager, TxnTimeStamp begin_ts) {
+    const u32 column_count = segment_entry->column_count();
+    auto statistics = MakeShared<SegmentStatistics>(column_count);
+    const auto *table_entry = segment_entry->GetTableEntry();
+    for (u32 column_id = 0; column_id < column_count; ++column_id) {
+        const auto &data_type = table_entry->GetColumnDefByID(column_id)->type();
+        UniquePtr<ColumnStatistics> column_statistics;
+        switch (data_type->type()) {
+            case kBoolean: {
+                column_statistics = BuildColumnStatistics<BooleanT, CheckTS>(segment_entry, column_id, buffer_manager, begin_ts);
+                break;
+            }
+            case kTinyInt: {
+                column_statistics = BuildColumnStatistics<TinyIntT, CheckTS>(segment_entry, column_id, buffer_manager, begin_ts);
+                break;
+            }
+            case kSmallInt: {
+                column_statistics = BuildColumnStatistics<SmallIntT, CheckTS>(segment_entry, column_id, buffer_manager, begin_ts);
+                break;
+            }
+            case kInteger: {
+                column_statistics = BuildColumnStatistics<IntegerT, CheckTS>(segment_entry, column_id, buffer_manager, begin_ts);
+                break;
+            }
+            case kBigInt: {
+                column_statistics = BuildColumnStatistics<BigIntT, CheckTS>(segment_entry, column_id, buffer_manager, begin_ts);
+                break;
+            }
+            case kHugeInt: {
+                column_statistics = BuildColumnStatistics<HugeIntT, CheckTS>(segment_entry, column_id, buffer_manager, begin_ts);
+                break;
+            }
+            case kDecimal: {
+                column_statistics = BuildColumnStatistics<DecimalT, CheckTS>(segment_entry, column_id, buffer_manager, begin_ts);
+                break;
+            }
+            case kFloat: {
+                column_statistics = BuildColumnStatistics<FloatT, CheckTS>(segment_entry, column_id, buffer_manager, begin_ts);
+                break;
+            }
+            case kDouble: {
+                column_statistics = BuildColumnStatistics<DoubleT, CheckTS>(segment_entry, column_id, buffer_manager, begin_ts);
+                break;
+            }
+            case kVarchar: {
+                column_statistics = BuildColumnStatistics<VarcharT, CheckTS>(segment_entry, column_id, buffer_manager, begin_ts);
+                break;
+            }
+            case kDate: {
+                column_statistics = BuildColumnStatistics<DateT, CheckTS>(segment_entry, column_id, buffer_manager, begin_ts);
+                break;
+            }
+            case kTime: {
+                column_statistics = BuildColumnStatistics<TimeT, CheckTS>(segment_entry, column_id, buffer_manager, begin_ts);
+                break;
+            }
+            case kDateTime: {
+                column_statistics = BuildColumnStatistics<DateTimeT, CheckTS>(segment_entry, column_id, buffer_manager, begin_ts);
+                break;
+            }
+            case kTimestamp: {
+                column_statistics = BuildColumnStatistics<TimestampT, CheckTS>(segment_entry, column_id, buffer_manager, begin_ts);
+                break;
+            }
+            default: {
+                // embedding, tensor and other types are not used in filters, skip them
+                continue;
+            }
+        }
+        statistics->SetColumnStatistics(column_id, std::move(column_statistics));
+    }
+    return statistics;
+}
+
+template <typename ValueType, bool CheckTS>
+UniquePtr<ColumnStatistics> BuildSegmentStatisticsTask::BuildColumnStatistics(SegmentEntry *segment_entry,
+                                                                              ColumnID column_id,
+                                                                              BufferManager *buffer_manager,
+                                                                              TxnTimeStamp begin_ts) {
+    auto column_statistics = MakeUnique<ColumnStatistics>();
+    // sample every sample_step-th key for the histogram
+    const SizeT sample_step = std::max<SizeT>(1, segment_entry->row_count() / STATISTICS_HISTOGRAM_SAMPLE_SIZE);
+    Vector<f64> sample_keys;
+    auto iter = BlockEntryIter(segment_entry);
+    for (auto *block_entry = iter.Next(); block_entry != nullptr; block_entry = iter.Next()) {
+        if (block_entry->row_count() == 0) {
+            continue;
+        }
+        BlockColumnEntry *block_column_entry = block_entry->GetColumnBlockEntry(column_id);
+        BlockColumnIter<CheckTS> column_iter(block_column_entry, buffer_manager, begin_ts);
+        const Bitmask *nulls = column_iter.column_vector()->nulls_ptr_.get();
+        for (auto next_pair = column_iter.Next(); next_pair; next_pair = column_iter.Next()) {
+            auto &[ptr, offset] = next_pair.value();
+            ++column_statistics->row_count_;
+            if (nulls != nullptr and !nulls->IsTrue(offset)) {
+                ++column_statistics->null_count_;
+                continue;
+            }
+            if constexpr (std::is_same_v<ValueType, BooleanT>) {
+                // booleans are stored as bits
+                auto *u8_ptr = reinterpret_cast<const u8 *>(column_iter.data());
+                BooleanT val = u8_ptr[offset / 8] & (u8(1) << (offset % 8));
+                column_statistics->distinct_sketch_.Add(ConvertValueToU64(val));
+            } else if constexpr (std::is_same_v<ValueType, VarcharT>) {
+                Value val = column_iter.column_vector()->GetValue(offset);
+                column_statistics->distinct_sketch_.Add(ConvertValueToU64(val.GetVarchar()));
+            } else {
+                const auto &val = *static_cast<const ValueType *>(ptr);
+                if constexpr (std::is_floating_point_v<ValueType>) {
+                    column_statistics->distinct_sketch_.Add(std::bit_cast<u64>(static_cast<f64>(val)));
+                } else {
+                    column_statistics->distinct_sketch_.Add(ConvertValueToU64(val));
+                }
+                if constexpr (HaveStatisticsKey<ValueType>) {
+                    if (column_statistics->row_count_ % sample_step == 0) {
+                        sample_keys.push_back(ToStatisticsKey(val));
+                    }
+                }
+            }
+        }
+    }
+    if (!sample_keys.empty()) {
+        std::sort(sample_keys.begin(), sample_keys.end());
+        column_statistics->histogram_ = EquiDepthHistogram(sample_keys, STATISTICS_HISTOGRAM_BUCKET_COUNT);
+    }
+    return column_statistics;
+}
+
+} // namespace infinity
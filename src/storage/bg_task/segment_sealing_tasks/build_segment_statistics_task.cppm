@@ -0,0 +1,40 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+export module build_segment_statistics_task;
+
+import stl;
+import segment_entry;
+import buffer_manager;
+import segment_statistics;
+
+namespace infinity {
+
+// Collects the row count, null count, distinct count sketch and histogram of every column of a new sealed segment.
+export class BuildSegmentStatisticsTask {
+public:
+    static void ExecuteOnNewSealedSegment(SegmentEntry *segment_entry, BufferManager *buffer_manager, TxnTimeStamp begin_ts);
+
+private:
+    template <bool CheckTS>
+    static SharedPtr<SegmentStatistics> ExecuteInner(SegmentEntry *segment_entry, BufferManager *buffer_manager, TxnTimeStamp begin_ts);
+
+    template <typename ValueType, bool CheckTS>
+    static UniquePtr<ColumnStatistics>
+    BuildColumnStatistics(SegmentEntry *segment_entry, ColumnID column_id, BufferManager *buffer_manager, TxnTimeStamp begin_ts);
+};
+
+} // namespace infinity
@@ -14,6 +14,9 @@
 
 module;
 
+#include <future>
+#include <utility>
+
 import stl;
 import file_worker;
 import third_party;
@@ -23,12 +26,15 @@ import specific_concurrent_queue;
 
 import infinity_exception;
 import buffer_obj;
+import buffer_handle;
+import default_values;
 
 module buffer_manager;
 
 namespace infinity {
-BufferManager::BufferManager(u64 memory_limit, SharedPtr<String> data_dir, SharedPtr<String> temp_dir)
-    : data_dir_(std::move(data_dir)), temp_dir_(std::move(temp_dir)), memory_limit_(memory_limit), current_memory_size_(0) {
+BufferManager::BufferManager(u64 memory_limit, SharedPtr<String> data_dir, SharedPtr<String> temp_dir, SizeT read_ahead_thread_num)
+    : data_dir_(std::move(data_dir)), temp_dir_(std::move(temp_dir)), memory_limit_(memory_limit), current_memory_size_(0),
+      read_ahead_pool_(read_ahead_thread_num) {
     LocalFileSystem fs;
     if (!fs.Exists(*data_dir_)) {
         fs.CreateDirectory(*data_dir_);
@@ -81,6 +87,34 @@ void BufferManager::RemoveBufferObj(const String &file_path) {
     }
 }
 
+bool BufferManager::Prefetch(const Vector<BufferObj *> &buffer_objs, Vector<std::future<BufferHandle>> &handles, ReadAheadReservation &reservation) {
+    SizeT footprint = 0;
+    for (auto *buffer_obj : buffer_objs) {
+        footprint += buffer_obj->GetBufferSize();
+    }
+    u64 read_ahead_limit = memory_limit_ / READ_AHEAD_MEMORY_FRACTION;
+    u64 read_ahead_size = read_ahead_size_.load();
+    do {
+        if (read_ahead_size + footprint > read_ahead_limit) {
+            return false;
+        }
+    } while (!read_ahead_size_.compare_exchange_weak(read_ahead_size, read_ahead_size + footprint));
+    reservation = ReadAheadReservation(this, footprint);
+
+    for (auto *buffer_obj : buffer_objs) {
+        handles.push_back(read_ahead_pool_.push([buffer_obj](int) {
+            try {
+                return buffer_obj->Load();
+            } catch (const std::exception &e) {
+                // The buffer stays unloaded, the scan loads it again itself.
+                LOG_WARN(fmt::format("Read ahead of {} failed: {}", buffer_obj->GetFilename(), e.what()));
+                throw;
+            }
+        }));
+    }
+    return true;
+}
+
 void BufferManager::RequestSpace(SizeT need_size, BufferObj *buffer_obj) {
     while (current_memory_size_ + need_size > memory_limit_) {
         BufferObj *buffer_obj1 = nullptr;
@@ -114,4 +148,24 @@ void BufferManager::PushGCQueue(BufferObj *buffer_obj) {
     gc_queue_.Enqueue(buffer_obj);
 }
 
+ReadAheadReservation::ReadAheadReservation(ReadAheadReservation &&other) noexcept
+    : buffer_mgr_(std::exchange(other.buffer_mgr_, nullptr)), size_(std::exchange(other.size_, 0)) {}
+
+ReadAheadReservation &ReadAheadReservation::operator=(ReadAheadReservation &&other) noexcept {
+    if (this != &other) {
+        if (buffer_mgr_ != nullptr) {
+            buffer_mgr_->read_ahead_size_ -= size_;
+        }
+        buffer_mgr_ = std::exchange(other.buffer_mgr_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+}
+
+ReadAheadReservation::~ReadAheadReservation() {
+    if (buffer_mgr_ != nullptr) {
+        buffer_mgr_->read_ahead_size_ -= size_;
+    }
+}
+
 } // namespace infinity
@@ -14,19 +14,44 @@
 
 module;
 
+#include <future>
+
 import stl;
 import file_worker;
 import specific_concurrent_queue;
+import buffer_handle;
+import default_values;
 
 export module buffer_manager;
 
 namespace infinity {
 
 class BufferObj;
+export class BufferManager;
+
+// Memory of the buffers loaded ahead of a table scan, given back to the read ahead budget when destroyed.
+export class ReadAheadReservation {
+public:
+    ReadAheadReservation() = default;
+    ReadAheadReservation(BufferManager *buffer_mgr, SizeT size) : buffer_mgr_(buffer_mgr), size_(size) {}
+    ReadAheadReservation(ReadAheadReservation &&other) noexcept;
+    ReadAheadReservation &operator=(ReadAheadReservation &&other) noexcept;
+    ~ReadAheadReservation();
+
+    ReadAheadReservation(const ReadAheadReservation &) = delete;
+    ReadAheadReservation &operator=(const ReadAheadReservation &) = delete;
+
+private:
+    BufferManager *buffer_mgr_{};
+    SizeT size_{};
+};
 
 export class BufferManager {
 public:
-    explicit BufferManager(u64 memory_limit, SharedPtr<String> data_dir, SharedPtr<String> temp_dir);
+    explicit BufferManager(u64 memory_limit,
+                           SharedPtr<String> data_dir,
+                           SharedPtr<String> temp_dir,
+                           SizeT read_ahead_thread_num = DEFAULT_READ_AHEAD_THREAD_NUM);
 
 public:
     // Create a new BufferHandle, or in replay process. (read data block from wal)
@@ -37,6 +62,11 @@ public:
 
     void RemoveBufferObj(const String &file_path);
 
+    // Loads the buffers on the read ahead threads, or returns false if they don't fit in what is left of the read ahead budget.
+    // The handles held by the futures keep the buffers in memory until the futures are dropped, the reservation counts them
+    // against the budget until it is destroyed. Failed loads are logged, the buffers stay unloaded.
+    bool Prefetch(const Vector<BufferObj *> &buffer_objs, Vector<std::future<BufferHandle>> &handles, ReadAheadReservation &reservation);
+
     SharedPtr<String> GetDataDir() const { return data_dir_; }
 
     SharedPtr<String> GetTempDir() const { return temp_dir_; }
@@ -50,10 +80,14 @@ public:
 
 private:
     friend class BufferObj;
+    friend class ReadAheadReservation;
 
     // BufferHandle calls it, before allocate memory. It will start GC if necessary.
     void RequestSpace(SizeT need_size, BufferObj *buffer_obj);
 
+    // BufferObj calls it, when the load it requested space for fails.
+    void FreeSpace(SizeT size) { current_memory_size_ -= size; }
+
     // BufferHandle calls it, after unload.
     void PushGCQueue(BufferObj *buffer_handle);
 
@@ -66,5 +100,10 @@ private:
     atomic_u64 current_memory_size_{}; // TODO: need to be atomic
     HashMap<String, UniquePtr<BufferObj>> buffer_map_{};
     SpecificConcurrentQueue<BufferObj *> gc_queue_{};
+    // Memory pinned by read ahead, bounded so that it never takes the space the loads of the scans themselves need.
+    atomic_u64 read_ahead_size_{};
+
+    // Declared last, so the pending read ahead tasks are done before the buffer objects are destroyed.
+    ThreadPool read_ahead_pool_;
 };
 } // namespace infinity
\ No newline at end of file
@@ -53,7 +53,16 @@ BufferHandle BufferObj::Load() {
         }
         case BufferStatus::kFreed: {
             buffer_mgr_->RequestSpace(GetBufferSize(), this);
-            file_worker_->ReadFromFile(type_ != BufferType::kPersistent);
+            try {
+                file_worker_->ReadFromFile(type_ != BufferType::kPersistent);
+            } catch (const RecoverableException &e) {
+                // The buffer stays freed, so the next load, e.g. the one of a scan after its read ahead failed, reads the file again.
+                if (file_worker_->GetData() != nullptr) {
+                    file_worker_->FreeInMemory();
+                }
+                buffer_mgr_->FreeSpace(GetBufferSize());
+                throw;
+            }
             if (type_ == BufferType::kEphemeral) {
                 type_ = BufferType::kTemp;
             }
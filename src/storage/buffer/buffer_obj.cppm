@@ -86,6 +86,8 @@ public:
 
     String GetFilename() const { return file_worker_->GetFilePath(); }
 
+    FileWorker *file_worker() const { return file_worker_.get(); }
+
 private:
     // Friend to encapsulate `Unload` interface and to increase `rc_`.
     friend class BufferHandle;
@@ -21,9 +21,17 @@ import infinity_exception;
 import local_file_system;
 import third_party;
 import status;
+import column_block_encoding;
 
 namespace infinity {
 
+namespace {
+
+constexpr u64 DATA_FILE_MAGIC_NUMBER = 0x00dd3344;
+constexpr u64 ENCODED_DATA_FILE_MAGIC_NUMBER = 0x00dd3345;
+
+} // namespace
+
 DataFileWorker::DataFileWorker(SharedPtr<String> file_dir, SharedPtr<String> file_name, SizeT buffer_size)
     : FileWorker(std::move(file_dir), std::move(file_name)), buffer_size_(buffer_size) {}
 
@@ -53,6 +61,19 @@ void DataFileWorker::FreeInMemory() {
 }
 
 void DataFileWorker::WriteToFileImpl(bool &prepare_success) {
+    // Column blocks of sealed segments are written encoded if it's smaller.
+    if (element_size_ > 0 && buffer_size_ % element_size_ == 0) {
+        SharedPtr<ColumnBlockDictionary> dictionary =
+            AnalyzeColumnBlock(static_cast<const char *>(data_), element_size_, buffer_size_ / element_size_);
+        if (dictionary.get() != nullptr) {
+            WriteEncodedToFile(*dictionary);
+            SetDictionary(std::move(dictionary));
+            prepare_success = true;
+            return;
+        }
+        SetDictionary(nullptr);
+    }
+
     LocalFileSystem fs;
     // File structure:
     // - header: magic number
@@ -60,7 +81,7 @@ void DataFileWorker::WriteToFileImpl(bool &prepare_success) {
     // - data buffer
     // - footer: checksum
 
-    u64 magic_number = 0x00dd3344;
+    u64 magic_number = DATA_FILE_MAGIC_NUMBER;
     u64 nbytes = fs.Write(*file_handler_, &magic_number, sizeof(magic_number));
     if (nbytes != sizeof(magic_number)) {
         RecoverableError(Status::DataIOError(fmt::format("Write magic number which length is {}.", nbytes)));
@@ -98,7 +119,11 @@ void DataFileWorker::ReadFromFileImpl() {
     if (nbytes != sizeof(magic_number)) {
         RecoverableError(Status::DataIOError(fmt::format("Read magic number which length isn't {}.", nbytes)));
     }
-    if (magic_number != 0x00dd3344) {
+    if (magic_number == ENCODED_DATA_FILE_MAGIC_NUMBER) {
+        ReadEncodedFromFile(file_size);
+        return;
+    }
+    if (magic_number != DATA_FILE_MAGIC_NUMBER) {
         RecoverableError(Status::DataIOError(fmt::format("Incorrect file header magic number: {}.", magic_number)));
     }
 
@@ -126,4 +151,80 @@ void DataFileWorker::ReadFromFileImpl() {
     }
 }
 
-} // namespace infinity
\ No newline at end of file
+void DataFileWorker::WriteEncodedToFile(const ColumnBlockDictionary &dictionary) {
+    LocalFileSystem fs;
+    // File structure:
+    // - header: magic number
+    // - header: buffer size
+    // - header: element size
+    // - header: encoded size
+    // - encoded elements
+    // - footer: checksum
+    u64 element_count = buffer_size_ / element_size_;
+    u64 encoded_size = EncodedColumnBlockSize(dictionary, element_size_, element_count);
+    auto encoded = MakeUnique<char[]>(encoded_size);
+    char *ptr = encoded.get();
+    EncodeColumnBlock(dictionary, static_cast<const char *>(data_), element_size_, element_count, ptr);
+    if (SizeT(ptr - encoded.get()) != encoded_size) {
+        UnrecoverableError(fmt::format("Encoded column block size mismatch: {} / {}", ptr - encoded.get(), encoded_size));
+    }
+
+    u64 header[4] = {ENCODED_DATA_FILE_MAGIC_NUMBER, buffer_size_, element_size_, encoded_size};
+    u64 nbytes = fs.Write(*file_handler_, header, sizeof(header));
+    if (nbytes != sizeof(header)) {
+        RecoverableError(Status::DataIOError(fmt::format("Write encoded file header which length is {}.", nbytes)));
+    }
+
+    nbytes = fs.Write(*file_handler_, encoded.get(), encoded_size);
+    if (nbytes != encoded_size) {
+        RecoverableError(Status::DataIOError(fmt::format("Expect to write buffer with size: {}, but {} bytes is written", encoded_size, nbytes)));
+    }
+
+    u64 checksum{};
+    nbytes = fs.Write(*file_handler_, &checksum, sizeof(checksum));
+    if (nbytes != sizeof(checksum)) {
+        RecoverableError(Status::DataIOError(fmt::format("Write buffer length field which length is {}.", nbytes)));
+    }
+}
+
+void DataFileWorker::ReadEncodedFromFile(SizeT file_size) {
+    LocalFileSystem fs;
+
+    // header after the magic number: buffer size, element size, encoded size
+    u64 header[3]{};
+    u64 nbytes = fs.Read(*file_handler_, header, sizeof(header));
+    if (nbytes != sizeof(header)) {
+        RecoverableError(Status::DataIOError(fmt::format("Read encoded file header which length isn't {}.", nbytes)));
+    }
+    auto [buffer_size, element_size, encoded_size] = header;
+    if (element_size == 0 || buffer_size % element_size != 0) {
+        RecoverableError(Status::DataIOError(fmt::format("Incorrect element size {} of buffer size {}.", element_size, buffer_size)));
+    }
+    if (file_size != encoded_size + 5 * sizeof(u64)) {
+        RecoverableError(Status::DataIOError(fmt::format("File size: {} isn't matched with {}.", file_size, encoded_size + 5 * sizeof(u64))));
+    }
+
+    auto encoded = MakeUnique<char[]>(encoded_size);
+    nbytes = fs.Read(*file_handler_, encoded.get(), encoded_size);
+    if (nbytes != encoded_size) {
+        RecoverableError(Status::DataIOError(fmt::format("Expect to read buffer with size: {}, but {} bytes is read", encoded_size, nbytes)));
+    }
+
+    // file body
+    data_ = static_cast<void *>(new char[buffer_size]{});
+    const char *ptr = encoded.get();
+    SharedPtr<ColumnBlockDictionary> dictionary = DecodeColumnBlock(ptr, static_cast<char *>(data_), element_size, buffer_size / element_size);
+    if (SizeT(ptr - encoded.get()) != encoded_size) {
+        RecoverableError(Status::DataIOError(fmt::format("Decoded {} of {} bytes.", ptr - encoded.get(), encoded_size)));
+    }
+    SetDictionary(std::move(dictionary));
+
+    // file footer: checksum
+    u64 checksum{0};
+    nbytes = fs.Read(*file_handler_, &checksum, sizeof(checksum));
+    if (nbytes != sizeof(checksum)) {
+        RecoverableError(Status::DataIOError(fmt::format("Incorrect file checksum length: {}.", nbytes)));
+    }
+}
+
+} // namespace infinity
@@ -18,6 +18,7 @@ export module data_file_worker;
 
 import stl;
 import file_worker;
+import column_block_encoding;
 
 namespace infinity {
 
@@ -34,12 +35,35 @@ public:
 
     SizeT GetMemoryCost() const override { return buffer_size_; }
 
+    // Lets the following writes store the buffer as dictionary or RLE encoded elements of #element_size bytes when it's smaller.
+    // Only for buffers which are no longer appended, e.g. the column blocks of a sealed segment.
+    void EnableEncoding(SizeT element_size) { element_size_ = element_size; }
+
+    // Dictionary of the buffer if the file is encoded.
+    SharedPtr<ColumnBlockDictionary> dictionary() const {
+        std::unique_lock<std::mutex> lock(dictionary_mutex_);
+        return dictionary_;
+    }
+
 protected:
     void WriteToFileImpl(bool &prepare_success) override;
 
     void ReadFromFileImpl() override;
 
 private:
+    void WriteEncodedToFile(const ColumnBlockDictionary &dictionary);
+
+    void ReadEncodedFromFile(SizeT file_size);
+
+    void SetDictionary(SharedPtr<ColumnBlockDictionary> dictionary) {
+        std::unique_lock<std::mutex> lock(dictionary_mutex_);
+        dictionary_ = std::move(dictionary);
+    }
+
     const SizeT buffer_size_;
+
+    SizeT element_size_{0};
+    mutable std::mutex dictionary_mutex_{};
+    SharedPtr<ColumnBlockDictionary> dictionary_{};
 };
 } // namespace infinity
\ No newline at end of file
@@ -176,6 +176,16 @@ void Bitmask::SetFalse(SizeT row_index) {
     data_ptr_[u64_index] &= ~(((u64(1))) << index_in_u64);
 }
 
+void Bitmask::SetFalseUnit(SizeT unit_index, u64 bits) {
+    if (buffer_ptr.get() == nullptr) {
+        buffer_ptr = BitmaskBuffer::Make(count_);
+        // Set raw pointer;
+        data_ptr_ = buffer_ptr->data_ptr_.get();
+    }
+
+    data_ptr_[unit_index] &= ~bits;
+}
+
 void Bitmask::Set(SizeT row_index, bool valid) {
     if (valid) {
         SetTrue(row_index);
@@ -59,6 +59,9 @@ public:
 
     void SetFalse(SizeT row_index);
 
+    // Sets the rows of the bits set in `bits` false, the rows of unit `unit_index` are [unit_index * 64, unit_index * 64 + 64).
+    void SetFalseUnit(SizeT unit_index, u64 bits);
+
     void Set(SizeT row_index, bool valid);
 
     void SetAllTrue();
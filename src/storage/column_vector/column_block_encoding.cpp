@@ -0,0 +1,222 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+#include <cstring>
+
+module column_block_encoding;
+
+import stl;
+import infinity_exception;
+import third_party;
+
+namespace infinity {
+
+namespace {
+
+// An encoding is only chosen if it's at most 3/4 of the plain size.
+constexpr SizeT ENCODED_SIZE_RATIO_NUMERATOR = 3;
+constexpr SizeT ENCODED_SIZE_RATIO_DENOMINATOR = 4;
+
+constexpr SizeT MAX_DICTIONARY_SIZE = std::numeric_limits<u16>::max();
+
+inline SizeT CodeWidth(SizeT entry_count) { return entry_count <= std::numeric_limits<u8>::max() + 1 ? sizeof(u8) : sizeof(u16); }
+
+SizeT DictionaryEncodedSize(SizeT entry_count, SizeT element_size, SizeT element_count) {
+    return sizeof(u32) + entry_count * element_size + element_count * CodeWidth(entry_count);
+}
+
+SizeT RLEEncodedSize(SizeT run_count, SizeT element_size) { return sizeof(u32) + run_count * (sizeof(u32) + element_size); }
+
+} // namespace
+
+SharedPtr<ColumnBlockDictionary> AnalyzeColumnBlock(const char *data, SizeT element_size, SizeT element_count) {
+    if (element_size == 0 || element_count == 0 || element_count > std::numeric_limits<u32>::max()) {
+        return nullptr;
+    }
+    SizeT plain_size = element_size * element_count;
+    SizeT max_size = plain_size * ENCODED_SIZE_RATIO_NUMERATOR / ENCODED_SIZE_RATIO_DENOMINATOR;
+
+    auto rle = MakeShared<ColumnBlockDictionary>();
+    rle->encoding_ = ColumnBlockEncoding::kRLE;
+    rle->value_rows_.push_back(0);
+    for (SizeT idx = 1; idx < element_count; ++idx) {
+        if (std::memcmp(data + idx * element_size, data + (idx - 1) * element_size, element_size) != 0) {
+            rle->codes_.push_back(idx);
+            rle->value_rows_.push_back(idx);
+            if (RLEEncodedSize(rle->value_rows_.size(), element_size) > max_size) {
+                rle.reset();
+                break;
+            }
+        }
+    }
+    if (rle.get() != nullptr) {
+        rle->codes_.push_back(element_count);
+    }
+
+    // Stop once the dictionary can't be smaller than the plain layout.
+    auto dictionary = MakeShared<ColumnBlockDictionary>();
+    dictionary->encoding_ = ColumnBlockEncoding::kDictionary;
+    dictionary->codes_.reserve(element_count);
+    HashMap<std::string_view, u32> entries;
+    for (SizeT idx = 0; idx < element_count; ++idx) {
+        std::string_view value(data + idx * element_size, element_size);
+        auto [iter, inserted] = entries.emplace(value, entries.size());
+        if (inserted) {
+            dictionary->value_rows_.push_back(idx);
+            if (entries.size() > MAX_DICTIONARY_SIZE || DictionaryEncodedSize(entries.size(), element_size, element_count) > max_size) {
+                dictionary.reset();
+                break;
+            }
+        }
+        dictionary->codes_.push_back(iter->second);
+    }
+
+    if (rle.get() == nullptr) {
+        return dictionary;
+    }
+    if (dictionary.get() == nullptr) {
+        return rle;
+    }
+    return EncodedColumnBlockSize(*rle, element_size, element_count) <= EncodedColumnBlockSize(*dictionary, element_size, element_count) ? rle
+                                                                                                                                        : dictionary;
+}
+
+SizeT EncodedColumnBlockSize(const ColumnBlockDictionary &dictionary, SizeT element_size, SizeT element_count) {
+    switch (dictionary.encoding_) {
+        case ColumnBlockEncoding::kDictionary: {
+            return sizeof(ColumnBlockEncoding) + DictionaryEncodedSize(dictionary.EntryCount(), element_size, element_count);
+        }
+        case ColumnBlockEncoding::kRLE: {
+            return sizeof(ColumnBlockEncoding) + RLEEncodedSize(dictionary.EntryCount(), element_size);
+        }
+        case ColumnBlockEncoding::kPlain: {
+            return sizeof(ColumnBlockEncoding) + element_size * element_count;
+        }
+    }
+    return 0;
+}
+
+void EncodeColumnBlock(const ColumnBlockDictionary &dictionary, const char *data, SizeT element_size, SizeT element_count, char *&ptr) {
+    // Layout:
+    // - encoding
+    // - kDictionary: entry count, entry values, codes
+    // - kRLE: run count, run ends, run values
+    // - kPlain: elements
+    *reinterpret_cast<ColumnBlockEncoding *>(ptr) = dictionary.encoding_;
+    ptr += sizeof(ColumnBlockEncoding);
+    if (dictionary.encoding_ == ColumnBlockEncoding::kPlain) {
+        std::memcpy(ptr, data, element_size * element_count);
+        ptr += element_size * element_count;
+        return;
+    }
+
+    u32 entry_count = dictionary.EntryCount();
+    std::memcpy(ptr, &entry_count, sizeof(entry_count));
+    ptr += sizeof(entry_count);
+    if (dictionary.encoding_ == ColumnBlockEncoding::kRLE) {
+        std::memcpy(ptr, dictionary.codes_.data(), entry_count * sizeof(u32));
+        ptr += entry_count * sizeof(u32);
+    }
+    for (u32 value_row : dictionary.value_rows_) {
+        std::memcpy(ptr, data + value_row * element_size, element_size);
+        ptr += element_size;
+    }
+    if (dictionary.encoding_ == ColumnBlockEncoding::kDictionary) {
+        if (CodeWidth(entry_count) == sizeof(u8)) {
+            for (SizeT idx = 0; idx < element_count; ++idx) {
+                *reinterpret_cast<u8 *>(ptr) = dictionary.codes_[idx];
+                ptr += sizeof(u8);
+            }
+        } else {
+            for (SizeT idx = 0; idx < element_count; ++idx) {
+                u16 code = dictionary.codes_[idx];
+                std::memcpy(ptr, &code, sizeof(code));
+                ptr += sizeof(u16);
+            }
+        }
+    }
+}
+
+SharedPtr<ColumnBlockDictionary> DecodeColumnBlock(const char *&ptr, char *data, SizeT element_size, SizeT element_count) {
+    auto dictionary = MakeShared<ColumnBlockDictionary>();
+    dictionary->encoding_ = *reinterpret_cast<const ColumnBlockEncoding *>(ptr);
+    ptr += sizeof(ColumnBlockEncoding);
+    switch (dictionary->encoding_) {
+        case ColumnBlockEncoding::kPlain: {
+            std::memcpy(data, ptr, element_size * element_count);
+            ptr += element_size * element_count;
+            return nullptr;
+        }
+        case ColumnBlockEncoding::kDictionary: {
+            u32 entry_count{};
+            std::memcpy(&entry_count, ptr, sizeof(entry_count));
+            ptr += sizeof(entry_count);
+            const char *values = ptr;
+            ptr += entry_count * element_size;
+            dictionary->codes_.resize(element_count);
+            dictionary->value_rows_.assign(entry_count, std::numeric_limits<u32>::max());
+            SizeT code_width = CodeWidth(entry_count);
+            for (SizeT idx = 0; idx < element_count; ++idx) {
+                u32 code{};
+                if (code_width == sizeof(u8)) {
+                    code = *reinterpret_cast<const u8 *>(ptr);
+                } else {
+                    u16 code16{};
+                    std::memcpy(&code16, ptr, sizeof(code16));
+                    code = code16;
+                }
+                ptr += code_width;
+                if (code >= entry_count) {
+                    UnrecoverableError(fmt::format("Invalid dictionary code {} of {} entries", code, entry_count));
+                }
+                std::memcpy(data + idx * element_size, values + code * element_size, element_size);
+                dictionary->codes_[idx] = code;
+                if (dictionary->value_rows_[code] == std::numeric_limits<u32>::max()) {
+                    dictionary->value_rows_[code] = idx;
+                }
+            }
+            return dictionary;
+        }
+        case ColumnBlockEncoding::kRLE: {
+            u32 run_count{};
+            std::memcpy(&run_count, ptr, sizeof(run_count));
+            ptr += sizeof(run_count);
+            dictionary->codes_.resize(run_count);
+            std::memcpy(dictionary->codes_.data(), ptr, run_count * sizeof(u32));
+            ptr += run_count * sizeof(u32);
+            u32 run_begin = 0;
+            for (u32 run_idx = 0; run_idx < run_count; ++run_idx) {
+                u32 run_end = dictionary->codes_[run_idx];
+                if (run_end < run_begin || run_end > element_count) {
+                    UnrecoverableError(fmt::format("Invalid run end {} of {} elements", run_end, element_count));
+                }
+                for (u32 idx = run_begin; idx < run_end; ++idx) {
+                    std::memcpy(data + idx * element_size, ptr, element_size);
+                }
+                ptr += element_size;
+                dictionary->value_rows_.push_back(run_begin);
+                run_begin = run_end;
+            }
+            if (run_begin != element_count) {
+                UnrecoverableError(fmt::format("Runs cover {} of {} elements", run_begin, element_count));
+            }
+            return dictionary;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace infinity
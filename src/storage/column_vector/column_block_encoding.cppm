@@ -0,0 +1,55 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+export module column_block_encoding;
+
+import stl;
+
+namespace infinity {
+
+export enum class ColumnBlockEncoding : u8 {
+    kPlain,
+    kDictionary, // Distinct values, and a one or two bytes code per element
+    kRLE,        // Run length encoding
+};
+
+// The dictionary of a dictionary or RLE encoded column block, kept along with the decoded block.
+// It's enough to read the block as encoded column vectors without decoding it again.
+export struct ColumnBlockDictionary {
+    ColumnBlockEncoding encoding_{ColumnBlockEncoding::kPlain};
+
+    // kDictionary: the dictionary entry of each element.
+    // kRLE: the end of each run, exclusive.
+    Vector<u32> codes_{};
+
+    // The first element of each dictionary entry or run, where its value is in the decoded block.
+    Vector<u32> value_rows_{};
+
+    [[nodiscard]] inline SizeT EntryCount() const { return value_rows_.size(); }
+};
+
+// Picks the smallest layout of #element_count elements of #element_size bytes.
+// Returns null if the plain layout is about as small as the encoded ones.
+export SharedPtr<ColumnBlockDictionary> AnalyzeColumnBlock(const char *data, SizeT element_size, SizeT element_count);
+
+export SizeT EncodedColumnBlockSize(const ColumnBlockDictionary &dictionary, SizeT element_size, SizeT element_count);
+
+export void EncodeColumnBlock(const ColumnBlockDictionary &dictionary, const char *data, SizeT element_size, SizeT element_count, char *&ptr);
+
+// Decodes the elements into #data and returns the dictionary of the block.
+export SharedPtr<ColumnBlockDictionary> DecodeColumnBlock(const char *&ptr, char *data, SizeT element_size, SizeT element_count);
+
+} // namespace infinity
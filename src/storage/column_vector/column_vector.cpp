@@ -15,6 +15,7 @@
 module;
 
 #include "type/complex/varchar.h"
+#include <algorithm>
 #include <sstream>
 
 module column_vector;
@@ -53,6 +54,9 @@ VectorBufferType ColumnVector::InitializeHelper(ColumnVectorType vector_type, Si
     if (vector_type == ColumnVectorType::kInvalid) {
         UnrecoverableError("Attempt to initialize column vector to invalid type.");
     }
+    if (vector_type == ColumnVectorType::kDictionary || vector_type == ColumnVectorType::kRLE) {
+        UnrecoverableError("Encoded column vector is only initialized from an encoded column block.");
+    }
 
     // require BooleanT vector to be initialized with ColumnVectorType::kConstant or ColumnVectorType::kCompactBit
     // if ColumnVectorType::kFlat is used, change it to ColumnVectorType::kCompactBit
@@ -139,6 +143,10 @@ void ColumnVector::Initialize(BufferManager *buffer_mgr,
 }
 
 void ColumnVector::Initialize(const ColumnVector &other, const Selection &input_select) {
+    if (other.IsEncoded()) {
+        InitializeDecoded(other, *other.dictionary_, &input_select, input_select.Size());
+        return;
+    }
     ColumnVectorType vector_type = other.vector_type_;
     Initialize(vector_type, vector_type == ColumnVectorType::kConstant ? other.capacity() : DEFAULT_VECTOR_SIZE);
 
@@ -274,6 +282,13 @@ void ColumnVector::Initialize(const ColumnVector &other, const Selection &input_
                 UnrecoverableError("Invalid data type");
             }
         }
+        if (!other.nulls_ptr_->IsAllTrue()) {
+            for (SizeT idx = 0; idx < tail_index_; ++idx) {
+                if (!other.nulls_ptr_->IsTrue(input_select[idx])) {
+                    nulls_ptr_->SetFalse(idx);
+                }
+            }
+        }
     }
 }
 
@@ -281,6 +296,16 @@ void ColumnVector::Initialize(ColumnVectorType vector_type, const ColumnVector &
     if (end_idx <= start_idx) {
         UnrecoverableError("End index should larger than start index.");
     }
+    if (other.IsEncoded()) {
+        // Decoded to a flat vector
+        Selection range_select;
+        range_select.Initialize(end_idx - start_idx);
+        for (SizeT idx = start_idx; idx < end_idx; ++idx) {
+            range_select.Append(idx);
+        }
+        InitializeDecoded(other, *other.dictionary_, &range_select, range_select.Size());
+        return;
+    }
     Initialize(vector_type, end_idx - start_idx);
 
     if (vector_type_ == ColumnVectorType::kConstant) {
@@ -420,10 +445,126 @@ void ColumnVector::Initialize(ColumnVectorType vector_type, const ColumnVector &
     }
 }
 
+void ColumnVector::InitializeEncoded(const ColumnVector &block_column,
+                                     const ColumnBlockDictionary &block_dictionary,
+                                     SizeT start_row,
+                                     SizeT row_count) {
+    if (initialized) {
+        UnrecoverableError("Column vector is already initialized.");
+    }
+    if (row_count == 0) {
+        UnrecoverableError("Attempt to initialize an empty encoded column vector.");
+    }
+    SizeT end_row = start_row + row_count;
+    Selection value_rows;
+    codes_ = MakeShared<Selection>();
+    codes_->Initialize(row_count);
+    switch (block_dictionary.encoding_) {
+        case ColumnBlockEncoding::kDictionary: {
+            // All entries of the block are kept, so the codes are the same.
+            vector_type_ = ColumnVectorType::kDictionary;
+            value_rows.Initialize(block_dictionary.EntryCount());
+            for (u32 value_row : block_dictionary.value_rows_) {
+                value_rows.Append(value_row);
+            }
+            for (SizeT row = start_row; row < end_row; ++row) {
+                codes_->Append(block_dictionary.codes_[row]);
+            }
+            break;
+        }
+        case ColumnBlockEncoding::kRLE: {
+            // Only the runs overlapping the rows
+            vector_type_ = ColumnVectorType::kRLE;
+            const Vector<u32> &run_ends = block_dictionary.codes_;
+            SizeT run_idx = std::upper_bound(run_ends.begin(), run_ends.end(), start_row) - run_ends.begin();
+            value_rows.Initialize(std::min(run_ends.size() - run_idx, row_count));
+            for (; run_idx < run_ends.size() && block_dictionary.value_rows_[run_idx] < end_row; ++run_idx) {
+                value_rows.Append(block_dictionary.value_rows_[run_idx]);
+                codes_->Append(std::min<SizeT>(run_ends[run_idx], end_row) - start_row);
+            }
+            break;
+        }
+        case ColumnBlockEncoding::kPlain: {
+            UnrecoverableError("Column block isn't encoded.");
+        }
+    }
+    dictionary_ = MakeShared<ColumnVector>(data_type_);
+    dictionary_->Initialize(block_column, value_rows);
+
+    initialized = true;
+    data_type_size_ = data_type_->Size();
+    capacity_ = row_count;
+    tail_index_ = row_count;
+    nulls_ptr_ = Bitmask::Make(row_count);
+    if (!block_column.nulls_ptr_->IsAllTrue()) {
+        for (SizeT row = start_row; row < end_row; ++row) {
+            if (!block_column.nulls_ptr_->IsTrue(row)) {
+                nulls_ptr_->SetFalse(row - start_row);
+            }
+        }
+    }
+}
+
+void ColumnVector::InitializeDecoded(const ColumnVector &encoded, const ColumnVector &dictionary) {
+    InitializeDecoded(encoded, dictionary, nullptr, encoded.Size());
+}
+
+void ColumnVector::InitializeDecoded(const ColumnVector &encoded, const ColumnVector &dictionary, const Selection *input_select, SizeT count) {
+    if (!encoded.IsEncoded()) {
+        UnrecoverableError("Attempt to decode a column vector which isn't encoded.");
+    }
+    Selection dictionary_rows = encoded.DictionaryRows(input_select, count);
+    Initialize(dictionary, dictionary_rows);
+    if (!encoded.nulls_ptr_->IsAllTrue()) {
+        for (SizeT idx = 0; idx < count; ++idx) {
+            SizeT row = input_select == nullptr ? idx : (*input_select)[idx];
+            if (!encoded.nulls_ptr_->IsTrue(row)) {
+                nulls_ptr_->SetFalse(idx);
+            }
+        }
+    }
+}
+
+SharedPtr<ColumnVector> ColumnVector::Decode() const {
+    auto decoded = MakeShared<ColumnVector>(data_type_);
+    decoded->InitializeDecoded(*this, *dictionary_);
+    return decoded;
+}
+
+SizeT ColumnVector::DictionaryRow(SizeT row) const {
+    if (vector_type_ == ColumnVectorType::kDictionary) {
+        return (*codes_)[row];
+    }
+    // The run containing the row
+    const u16 *run_ends = &(*codes_)[0];
+    return std::upper_bound(run_ends, run_ends + codes_->Size(), row) - run_ends;
+}
+
+Selection ColumnVector::DictionaryRows(const Selection *input_select, SizeT count) const {
+    Selection dictionary_rows;
+    dictionary_rows.Initialize(count);
+    if (vector_type_ == ColumnVectorType::kRLE && input_select == nullptr) {
+        for (SizeT run_idx = 0, row = 0; row < count; ++run_idx) {
+            SizeT run_end = std::min<SizeT>((*codes_)[run_idx], count);
+            for (; row < run_end; ++row) {
+                dictionary_rows.Append(run_idx);
+            }
+        }
+        return dictionary_rows;
+    }
+    for (SizeT idx = 0; idx < count; ++idx) {
+        dictionary_rows.Append(DictionaryRow(input_select == nullptr ? idx : (*input_select)[idx]));
+    }
+    return dictionary_rows;
+}
+
 void ColumnVector::CopyRow(const ColumnVector &other, SizeT dst_idx, SizeT src_idx) {
     if (!initialized) {
         UnrecoverableError("Column vector isn't initialized.");
     }
+    if (other.IsEncoded()) {
+        return CopyRow(*other.dictionary_, dst_idx, other.DictionaryRow(src_idx));
+    }
     if (data_type_->type() == LogicalType::kInvalid) {
         UnrecoverableError("Data type isn't assigned.");
     }
@@ -583,6 +724,10 @@ String ColumnVector::ToString(SizeT row_index) const {
         return "null";
     }
 
+    if (IsEncoded()) {
+        return dictionary_->ToString(DictionaryRow(row_index));
+    }
+
     switch (data_type_->type()) {
         case kBoolean: {
             return buffer_->GetCompactBit(row_index) ? "true" : "false";
@@ -715,6 +860,10 @@ Value ColumnVector::GetValue(SizeT index) const {
         return Value::MakeValue(*this->data_type_);
     }
 
+    if (IsEncoded()) {
+        return dictionary_->GetValue(DictionaryRow(index));
+    }
+
     switch (data_type_->type()) {
 
         case kBoolean: {
@@ -1315,6 +1464,12 @@ void ColumnVector::AppendWith(const ColumnVector &other, SizeT from, SizeT count
             fmt::format("Attempt to append {} rows data to {} rows data, which exceeds {} limit.", count, this->tail_index_, this->capacity_));
     }
 
+    if (other.IsEncoded()) {
+        ColumnVector decoded(data_type_);
+        decoded.Initialize(ColumnVectorType::kFlat, other, from, from + count);
+        return AppendWith(decoded, 0, count);
+    }
+
     switch (data_type_->type()) {
         case kBoolean: {
             CopyValue<BooleanT>(*this, other, from, count);
@@ -1497,6 +1652,8 @@ void ColumnVector::ShallowCopy(const ColumnVector &other) {
     if (this->nulls_ptr_.get() != other.nulls_ptr_.get()) {
         this->nulls_ptr_ = other.nulls_ptr_;
     }
+    this->dictionary_ = other.dictionary_;
+    this->codes_ = other.codes_;
     this->vector_type_ = other.vector_type_;
     this->data_ptr_ = other.data_ptr_;
     this->data_type_size_ = other.data_type_size_;
@@ -1535,13 +1692,17 @@ void ColumnVector::Reset() {
     // 5. null indicator need to reset
     //    nulls_ptr_.reset();
 
-    // 6. Capacity is set to zero
+    // 6. Encoded vector is reset to a plain one.
+    dictionary_.reset();
+    codes_.reset();
+
+    // 7. Capacity is set to zero
     capacity_ = 0;
 
-    // 7. Tail index is set to zero
+    // 8. Tail index is set to zero
     tail_index_ = 0;
 
-    // 8. Reset initialized flag
+    // 9. Reset initialized flag
     initialized = false;
 }
 
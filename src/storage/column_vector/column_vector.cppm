@@ -32,6 +32,7 @@ import infinity_exception;
 import fix_heap;
 import internal_types;
 import data_type;
+import column_block_encoding;
 
 namespace infinity {
 
@@ -43,8 +44,8 @@ export enum class ColumnVectorType : i8 {
     kFlat,          // Stand without any encode
     kConstant,      // All vector has same type and value
     kCompactBit,    // Compact bit encoding
-                    //    kDictionary, // There is a dictionary zone
-                    //    kRLE, // Run length encoding
+    kDictionary,    // Row i is row codes_[i] of dictionary_
+    kRLE,           // Run length encoding, rows of the run k are row k of dictionary_
                     //    kSequence,
                     //    kBias,
                     //
@@ -67,6 +68,12 @@ public:
     // A bitmap to indicate the null information
     SharedPtr<Bitmask> nulls_ptr_{nullptr};
 
+    // The values of a kDictionary or kRLE vector, a flat vector.
+    SharedPtr<ColumnVector> dictionary_{nullptr};
+
+    // kDictionary: the dictionary row of each row. kRLE: the end of each run, exclusive.
+    SharedPtr<Selection> codes_{nullptr};
+
     bool initialized{false};
 
 private:
@@ -91,9 +98,9 @@ public:
 
     // used in BatchInvertTask::BatchInvertTask, keep ObjectCount correct
     ColumnVector(const ColumnVector &right)
-        : data_type_size_(right.data_type_size_), buffer_(right.buffer_), nulls_ptr_(right.nulls_ptr_), initialized(right.initialized),
-          vector_type_(right.vector_type_), data_type_(right.data_type_), data_ptr_(right.data_ptr_), capacity_(right.capacity_),
-          tail_index_(right.tail_index_) {
+        : data_type_size_(right.data_type_size_), buffer_(right.buffer_), nulls_ptr_(right.nulls_ptr_), dictionary_(right.dictionary_),
+          codes_(right.codes_), initialized(right.initialized), vector_type_(right.vector_type_), data_type_(right.data_type_),
+          data_ptr_(right.data_ptr_), capacity_(right.capacity_), tail_index_(right.tail_index_) {
 #ifdef INFINITY_DEBUG
         GlobalResourceUsage::IncrObjectCount("ColumnVector");
 #endif
@@ -102,8 +109,9 @@ public:
     // used in BlockColumnIter, keep ObjectCount correct
     ColumnVector(ColumnVector &&right)
         : data_type_size_(right.data_type_size_), buffer_(std::move(right.buffer_)), nulls_ptr_(std::move(right.nulls_ptr_)),
-          initialized(right.initialized), vector_type_(right.vector_type_), data_type_(std::move(right.data_type_)), data_ptr_(right.data_ptr_),
-          capacity_(right.capacity_), tail_index_(right.tail_index_) {
+          dictionary_(std::move(right.dictionary_)), codes_(std::move(right.codes_)), initialized(right.initialized),
+          vector_type_(right.vector_type_), data_type_(std::move(right.data_type_)), data_ptr_(right.data_ptr_), capacity_(right.capacity_),
+          tail_index_(right.tail_index_) {
 #ifdef INFINITY_DEBUG
         GlobalResourceUsage::IncrObjectCount("ColumnVector");
 #endif
@@ -174,6 +182,16 @@ public:
 
     void Initialize(const ColumnVector &other, SizeT start_idx, SizeT end_idx) { Initialize(other.vector_type_, other, start_idx, end_idx); }
 
+    // Initialize a kDictionary or kRLE vector of the rows [start_row, start_row + row_count) of a column block which is stored encoded.
+    void InitializeEncoded(const ColumnVector &block_column, const ColumnBlockDictionary &block_dictionary, SizeT start_row, SizeT row_count);
+
+    // Initialize a flat vector with the rows of an encoded vector, reading the dictionary rows from #dictionary.
+    // #dictionary is the dictionary of #encoded, or the results of a function computed once per dictionary row.
+    void InitializeDecoded(const ColumnVector &encoded, const ColumnVector &dictionary);
+
+    // A flat copy of an encoded vector
+    SharedPtr<ColumnVector> Decode() const;
+
     String ToString(SizeT row_index) const;
 
     // Return the <index> of the vector
@@ -184,6 +202,9 @@ public:
     // Set the <index> element of the vector to the specified value.
     void SetValue(SizeT index, const Value &Value);
 
+    // Set the <index> element of the vector to the <src_index> element of <other>, which may be encoded.
+    void SetRow(SizeT index, const ColumnVector &other, SizeT src_index) { CopyRow(other, index, src_index); }
+
     void Finalize(SizeT index);
 
     void AppendByPtr(const_ptr_t value_ptr);
@@ -247,6 +268,13 @@ private:
 
     void CopyRow(const ColumnVector &other, SizeT dst_idx, SizeT src_idx);
 
+    // #count rows of #encoded, which are #input_select if it's not null.
+    void InitializeDecoded(const ColumnVector &encoded, const ColumnVector &dictionary, const Selection *input_select, SizeT count);
+
+    SizeT DictionaryRow(SizeT row) const;
+
+    Selection DictionaryRows(const Selection *input_select, SizeT count) const;
+
     template <typename DataT>
     inline void CopyFrom(const VectorBuffer *__restrict src_buf, VectorBuffer *__restrict dst_buf, SizeT count, const Selection &input_select);
 
@@ -260,6 +288,10 @@ private:
 public:
     [[nodiscard]] const inline ColumnVectorType &vector_type() const { return vector_type_; }
 
+    [[nodiscard]] inline bool IsEncoded() const { return vector_type_ == ColumnVectorType::kDictionary || vector_type_ == ColumnVectorType::kRLE; }
+
+    [[nodiscard]] inline const SharedPtr<ColumnVector> &dictionary() const { return dictionary_; }
+
     [[nodiscard]] const inline SharedPtr<DataType> data_type() const { return data_type_; }
 
     [[nodiscard]] inline ptr_t data() const { return data_ptr_; }
@@ -328,7 +360,7 @@ inline void ColumnVector::CopyFrom<VarcharT>(const VectorBuffer *__restrict src_
             std::memcpy(dst_ptr->short_.data_, src_ptr->short_.data_, varchar_len);
         } else {
             std::memcpy(dst_ptr->vector_.prefix_, src_ptr->value_.prefix_, VARCHAR_PREFIX_LEN);
-            auto [chunk_id, chunk_offset] = this->buffer_->fix_heap_mgr_->AppendToHeap(dst_buf->fix_heap_mgr_.get(),
+            auto [chunk_id, chunk_offset] = this->buffer_->fix_heap_mgr_->AppendToHeap(src_buf->fix_heap_mgr_.get(),
                                                                                        src_ptr->vector_.chunk_id_,
                                                                                        src_ptr->vector_.chunk_offset_,
                                                                                        varchar_len);
@@ -494,7 +526,7 @@ inline void ColumnVector::CopyFrom<VarcharT>(const VectorBuffer *__restrict src_
             std::memcpy(dst_ptr->short_.data_, src_ptr->short_.data_, varchar_len);
         } else {
             std::memcpy(dst_ptr->vector_.prefix_, src_ptr->value_.prefix_, VARCHAR_PREFIX_LEN);
-            auto [chunk_id, chunk_offset] = this->buffer_->fix_heap_mgr_->AppendToHeap(dst_buf->fix_heap_mgr_.get(),
+            auto [chunk_id, chunk_offset] = this->buffer_->fix_heap_mgr_->AppendToHeap(src_buf->fix_heap_mgr_.get(),
                                                                                        src_ptr->vector_.chunk_id_,
                                                                                        src_ptr->vector_.chunk_offset_,
                                                                                        varchar_len);
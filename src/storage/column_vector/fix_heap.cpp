@@ -225,6 +225,15 @@ void FixHeapManager::ReadFromHeap(char *buffer, ChunkId chunk_id, u64 chunk_offs
     }
 }
 
+const char *FixHeapManager::ViewFromHeap(String &buffer, ChunkId chunk_id, u64 chunk_offset, SizeT nbytes) {
+    if (chunk_offset + nbytes <= current_chunk_size_) {
+        return ReadChunk(chunk_id).GetPtr() + chunk_offset;
+    }
+    buffer.resize(nbytes);
+    ReadFromHeap(buffer.data(), chunk_id, chunk_offset, nbytes);
+    return buffer.data();
+}
+
 String FixHeapManager::Stats() const {
     std::stringstream ss;
     ss << "Chunk count: " << current_chunk_idx_ << ", Chunk size: " << current_chunk_size_ << ", Current Offset: " << current_chunk_offset_
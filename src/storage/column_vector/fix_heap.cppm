@@ -50,6 +50,9 @@ public:
     // the size of data.
     void ReadFromHeap(char *buffer, ChunkId chunk_id, u64 chunk_offset, SizeT nbytes);
 
+    // Return a pointer to #nbytes size of data in the heap if they are in one chunk, otherwise copy them to #buffer and return it.
+    const char *ViewFromHeap(String &buffer, ChunkId chunk_id, u64 chunk_offset, SizeT nbytes);
+
     [[nodiscard]] String Stats() const;
 
 public:
@@ -569,6 +569,10 @@ public:
             case ColumnVectorType::kHeterogeneous: {
                 return ExecuteHeterogeneous<LeftType, RightType, ResultType, Operator>(left, right, result, count, state_ptr, nullable);
             }
+            case ColumnVectorType::kDictionary:
+            case ColumnVectorType::kRLE: {
+                UnrecoverableError("Encoded column vector should be evaluated on its dictionary.");
+            }
         }
     }
 
@@ -597,6 +601,10 @@ private:
             case ColumnVectorType::kCompactBit: {
                 UnrecoverableError("CompactBit isn't implemented.");
             }
+            case ColumnVectorType::kDictionary:
+            case ColumnVectorType::kRLE: {
+                UnrecoverableError("Encoded column vector should be evaluated on its dictionary.");
+            }
         }
     }
 
@@ -623,6 +631,10 @@ private:
             case ColumnVectorType::kCompactBit: {
                 UnrecoverableError("CompactBit isn't implemented.");
             }
+            case ColumnVectorType::kDictionary:
+            case ColumnVectorType::kRLE: {
+                UnrecoverableError("Encoded column vector should be evaluated on its dictionary.");
+            }
         }
     }
 
@@ -649,6 +661,10 @@ private:
             case ColumnVectorType::kCompactBit: {
                 UnrecoverableError("CompactBit isn't implemented.");
             }
+            case ColumnVectorType::kDictionary:
+            case ColumnVectorType::kRLE: {
+                UnrecoverableError("Encoded column vector should be evaluated on its dictionary.");
+            }
         }
     }
 
@@ -83,6 +83,10 @@ public:
                 UnrecoverableError("Compact Bit embedding is not implemented yet.");
                 // return ExecuteHeterogeneous<InputElemType, OutputElemType, Operator>(input, result, count, state_ptr, nullable);
             }
+            case ColumnVectorType::kDictionary:
+            case ColumnVectorType::kRLE: {
+                UnrecoverableError("Encoded column vector should be evaluated on its dictionary.");
+            }
         }
     }
 
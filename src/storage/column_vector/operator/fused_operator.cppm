@@ -0,0 +1,282 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstring>
+#include <type_traits>
+
+export module fused_operator;
+
+import stl;
+import column_vector;
+import infinity_exception;
+import bitmask;
+import bitmask_buffer;
+import internal_types;
+
+namespace infinity {
+
+// Operators of a fused expression. Run returns false on overflow, the row becomes null, same as BinaryTryOpWrapper.
+
+export struct FusedAddOp {
+    template <typename T>
+    using ResultType = T;
+
+    template <typename T>
+    static inline bool Run(T left, T right, T &result) {
+        if constexpr (std::is_floating_point_v<T>) {
+            result = left + right;
+            return std::isfinite(result);
+        } else {
+            return !__builtin_add_overflow(left, right, &result);
+        }
+    }
+};
+
+export struct FusedSubtractOp {
+    template <typename T>
+    using ResultType = T;
+
+    template <typename T>
+    static inline bool Run(T left, T right, T &result) {
+        if constexpr (std::is_floating_point_v<T>) {
+            result = left - right;
+            return std::isfinite(result);
+        } else {
+            return !__builtin_sub_overflow(left, right, &result);
+        }
+    }
+};
+
+export struct FusedMultiplyOp {
+    template <typename T>
+    using ResultType = T;
+
+    template <typename T>
+    static inline bool Run(T left, T right, T &result) {
+        if constexpr (std::is_floating_point_v<T>) {
+            result = left * right;
+            return std::isfinite(result);
+        } else {
+            return !__builtin_mul_overflow(left, right, &result);
+        }
+    }
+};
+
+export struct FusedLessOp {
+    template <typename T>
+    using ResultType = BooleanT;
+
+    template <typename T>
+    static inline bool Run(T left, T right, BooleanT &result) {
+        result = left < right;
+        return true;
+    }
+};
+
+export struct FusedLessEqualOp {
+    template <typename T>
+    using ResultType = BooleanT;
+
+    template <typename T>
+    static inline bool Run(T left, T right, BooleanT &result) {
+        result = left <= right;
+        return true;
+    }
+};
+
+export struct FusedGreaterOp {
+    template <typename T>
+    using ResultType = BooleanT;
+
+    template <typename T>
+    static inline bool Run(T left, T right, BooleanT &result) {
+        result = left > right;
+        return true;
+    }
+};
+
+export struct FusedGreaterEqualOp {
+    template <typename T>
+    using ResultType = BooleanT;
+
+    template <typename T>
+    static inline bool Run(T left, T right, BooleanT &result) {
+        result = left >= right;
+        return true;
+    }
+};
+
+export struct FusedEqualOp {
+    template <typename T>
+    using ResultType = BooleanT;
+
+    template <typename T>
+    static inline bool Run(T left, T right, BooleanT &result) {
+        result = left == right;
+        return true;
+    }
+};
+
+export struct FusedNotEqualOp {
+    template <typename T>
+    using ResultType = BooleanT;
+
+    template <typename T>
+    static inline bool Run(T left, T right, BooleanT &result) {
+        result = left != right;
+        return true;
+    }
+};
+
+// A leaf of the expression tree: a flat column, or a constant read with stride 0.
+export template <typename T>
+struct FusedLeaf {
+    using ResultType = T;
+    static constexpr SizeT kLeafCount = 1;
+
+    static FusedLeaf Make(const SharedPtr<ColumnVector> *leaves) {
+        const SharedPtr<ColumnVector> &leaf = leaves[0];
+        return {reinterpret_cast<const T *>(leaf->data()), leaf->vector_type() == ColumnVectorType::kConstant ? SizeT(0) : SizeT(1)};
+    }
+
+    inline bool Run(SizeT idx, T &result) const {
+        result = data_[idx * stride_];
+        return true;
+    }
+
+    const T *data_{};
+    SizeT stride_{};
+};
+
+// An inner node, the whole tree is one type instantiated at bind time and evaluated row by row without intermediate columns.
+export template <typename Operator, typename Left, typename Right>
+    requires std::same_as<typename Left::ResultType, typename Right::ResultType>
+struct FusedBinary {
+    using ResultType = typename Operator::template ResultType<typename Left::ResultType>;
+    static constexpr SizeT kLeafCount = Left::kLeafCount + Right::kLeafCount;
+
+    // leaves are in the order of a left to right traversal of the tree
+    static FusedBinary Make(const SharedPtr<ColumnVector> *leaves) { return {Left::Make(leaves), Right::Make(leaves + Left::kLeafCount)}; }
+
+    inline bool Run(SizeT idx, ResultType &result) const {
+        typename Left::ResultType left_value;
+        typename Right::ResultType right_value;
+        // no short circuit, keeps the loop free of branches
+        bool ok = left_.Run(idx, left_value);
+        ok &= right_.Run(idx, right_value);
+        ok &= Operator::Run(left_value, right_value, result);
+        return ok;
+    }
+
+    Left left_;
+    Right right_;
+};
+
+export class FusedOperator {
+public:
+    // leaves are flat or constant column vectors of the leaf type, result is a flat or compact bit column vector.
+    template <typename Expression>
+    static void Execute(const Vector<SharedPtr<ColumnVector>> &leaves, SharedPtr<ColumnVector> &result, SizeT count) {
+        if (leaves.size() != Expression::kLeafCount) {
+            UnrecoverableError("Fused expression: leaf count mismatch.");
+        }
+        SharedPtr<Bitmask> &result_null = result->nulls_ptr_;
+        // result row is null if a leaf row is null
+        bool result_null_initialized = false;
+        for (const auto &leaf : leaves) {
+            const Bitmask &leaf_null = *leaf->nulls_ptr_;
+            if (leaf->vector_type() == ColumnVectorType::kConstant) {
+                if (!leaf_null.IsTrue(0)) {
+                    result_null->SetAllFalse();
+                    result->Finalize(count);
+                    return;
+                }
+                continue;
+            }
+            if (leaf_null.IsAllTrue()) {
+                continue;
+            }
+            if (!result_null_initialized) {
+                result_null->DeepCopy(leaf_null);
+                result_null_initialized = true;
+            } else {
+                result_null->Merge(leaf_null);
+            }
+        }
+        if (!result_null_initialized) {
+            result_null->SetAllTrue();
+        }
+
+        const Expression expression = Expression::Make(leaves.data());
+        const u64 *result_null_data = result_null->IsAllTrue() ? nullptr : result_null->GetData();
+        SizeT unit_count = BitmaskBuffer::UnitCount(count);
+        for (SizeT unit = 0; unit < unit_count; ++unit) {
+            SizeT start_index = unit * BitmaskBuffer::UNIT_BITS;
+            SizeT end_index = std::min(start_index + BitmaskBuffer::UNIT_BITS, count);
+            u64 valid = result_null_data == nullptr ? BitmaskBuffer::UNIT_MAX : result_null_data[unit];
+            if (valid == BitmaskBuffer::UNIT_MIN) {
+                // all data of 64 rows are null
+                continue;
+            }
+            u64 failed = ExecuteUnit(expression, result, start_index, end_index, valid);
+            if (failed != 0) {
+                result_null->SetFalseUnit(unit, failed);
+            }
+        }
+        result->Finalize(count);
+    }
+
+private:
+    // Returns the bits of the rows where an operator failed.
+    template <typename Expression>
+    static inline u64 ExecuteUnit(const Expression &expression, SharedPtr<ColumnVector> &result, SizeT start_index, SizeT end_index, u64 valid) {
+        using ResultType = typename Expression::ResultType;
+        u64 failed = 0;
+        if constexpr (std::is_same_v<ResultType, BooleanT>) {
+            u64 bits = 0;
+            for (SizeT i = start_index; i < end_index; ++i) {
+                BooleanT value{};
+                bool ok = expression.Run(i, value);
+                bits |= u64(value) << (i - start_index);
+                failed |= u64(!ok) << (i - start_index);
+            }
+            // compact bits are little endian: row i is bit i % 8 of byte i / 8
+            auto *result_bits = reinterpret_cast<u8 *>(result->data()) + start_index / 8;
+            std::memcpy(result_bits, &bits, (end_index - start_index + 7) / 8);
+        } else {
+            auto *result_data = reinterpret_cast<ResultType *>(result->data());
+            if (valid == BitmaskBuffer::UNIT_MAX) {
+                for (SizeT i = start_index; i < end_index; ++i) {
+                    bool ok = expression.Run(i, result_data[i]);
+                    failed |= u64(!ok) << (i - start_index);
+                }
+            } else {
+                for (SizeT i = start_index; i < end_index; ++i) {
+                    if (valid & (u64(1) << (i - start_index))) {
+                        bool ok = expression.Run(i, result_data[i]);
+                        failed |= u64(!ok) << (i - start_index);
+                    }
+                }
+            }
+        }
+        return failed & valid;
+    }
+};
+
+} // namespace infinity
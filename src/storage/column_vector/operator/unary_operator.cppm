@@ -103,6 +103,10 @@ public:
             case ColumnVectorType::kHeterogeneous: {
                 return ExecuteHeterogeneous<InputType, ResultType, Operator>(input_ptr, result_ptr, result_null, count, state_ptr);
             }
+            case ColumnVectorType::kDictionary:
+            case ColumnVectorType::kRLE: {
+                UnrecoverableError("Encoded column vector should be evaluated on its dictionary.");
+            }
         }
 
         UnrecoverableError("Unexpected error.");
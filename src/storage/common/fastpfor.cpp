@@ -22,6 +22,7 @@ module;
 #include <deltautil.h>
 #include <fastpfor.h>
 #include <simdbinarypacking.h>
+#include <simdbitpacking.h>
 #include <simdfastpfor.h>
 #include <simdnewpfor.h>
 #include <streamvariablebyte.h>
@@ -89,6 +90,12 @@ void FastPForWrapper<Codec>::RevertDelta(u32 *src, SizeT count) {
     FastPForLib::Delta::inverseDeltaSIMD(src, count);
 }
 
+u32 SIMDBlockMaxBits(const u32 *src) { return FastPForLib::maxbits(src, src + SIMD_BLOCK_SIZE); }
+
+void SIMDBlockPack(const u32 *src, u32 *dest, u32 bit) { FastPForLib::SIMD_fastpackwithoutmask_32(src, reinterpret_cast<__m128i *>(dest), bit); }
+
+void SIMDBlockUnpack(const u32 *src, u32 *dest, u32 bit) { FastPForLib::SIMD_fastunpack_32(reinterpret_cast<const __m128i *>(src), dest, bit); }
+
 // template struct FastPForWrapper<FastPForCodec::FastPFor>;
 template struct FastPForWrapper<FastPForCodec::SIMDBitPacking>;
 
@@ -46,4 +46,16 @@ export using SIMDNewPFor = FastPForWrapper<FastPForCodec::SIMDNewPFor>;
 export using StreamVByte = FastPForWrapper<FastPForCodec::StreamVByte>;
 export using SIMDBitPacking = FastPForWrapper<FastPForCodec::SIMDBitPacking>;
 
+// Raw SIMD bit-packing of a single block of SIMD_BLOCK_SIZE integers with a fixed bit width.
+// A packed block occupies SIMDBlockPackedSize(bit) u32 words, no header is written.
+export constexpr u32 SIMD_BLOCK_SIZE = 128;
+
+export constexpr u32 SIMDBlockPackedSize(u32 bit) { return SIMD_BLOCK_SIZE / 32 * bit; }
+
+export u32 SIMDBlockMaxBits(const u32 *src);
+
+export void SIMDBlockPack(const u32 *src, u32 *dest, u32 bit);
+
+export void SIMDBlockUnpack(const u32 *src, u32 *dest, u32 bit);
+
 } // namespace infinity
\ No newline at end of file
@@ -0,0 +1,83 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+#include <algorithm>
+#include <numeric>
+
+module row_id_gather;
+
+import stl;
+import block_index;
+import buffer_manager;
+import column_vector;
+import block_entry;
+import block_column_entry;
+import default_values;
+import internal_types;
+import infinity_exception;
+import third_party;
+
+namespace infinity {
+
+void GatherByRowID(const BlockIndex *block_index,
+                   BufferManager *buffer_mgr,
+                   const RowID *row_ids,
+                   SizeT row_count,
+                   const Vector<SizeT> &column_ids,
+                   const Vector<ColumnVector *> &outputs) {
+    if (column_ids.size() != outputs.size()) {
+        UnrecoverableError(fmt::format("Gather {} columns into {} column vectors", column_ids.size(), outputs.size()));
+    }
+    if (row_count == 0 || column_ids.empty()) {
+        return;
+    }
+
+    // The output rows are written in place, so the rows can be read in block order.
+    Vector<SizeT> output_offsets;
+    output_offsets.reserve(outputs.size());
+    for (ColumnVector *output : outputs) {
+        output_offsets.push_back(output->Size());
+        output->Finalize(output->Size() + row_count);
+    }
+
+    Vector<u32> order(row_count);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](u32 left, u32 right) { return row_ids[left] < row_ids[right]; });
+
+    auto block_of = [](const RowID &row_id) { return Pair<u32, u16>(row_id.segment_id_, row_id.segment_offset_ / DEFAULT_BLOCK_CAPACITY); };
+    for (SizeT begin = 0; begin < row_count;) {
+        auto [segment_id, block_id] = block_of(row_ids[order[begin]]);
+        SizeT end = begin + 1;
+        while (end < row_count && block_of(row_ids[order[end]]) == Pair<u32, u16>(segment_id, block_id)) {
+            ++end;
+        }
+
+        const BlockEntry *block_entry = block_index->GetBlockEntry(segment_id, block_id);
+        if (block_entry == nullptr) {
+            UnrecoverableError(fmt::format("Cannot find block segment id: {}, block id: {}", segment_id, block_id));
+        }
+        for (SizeT i = 0; i < column_ids.size(); ++i) {
+            ColumnVector column_vector = block_entry->GetColumnBlockEntry(column_ids[i])->GetColumnVector(buffer_mgr);
+            for (SizeT idx = begin; idx < end; ++idx) {
+                u32 row = order[idx];
+                outputs[i]->SetRow(output_offsets[i] + row, column_vector, row_ids[row].segment_offset_ % DEFAULT_BLOCK_CAPACITY);
+            }
+        }
+        begin = end;
+    }
+}
+
+} // namespace infinity
@@ -0,0 +1,37 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+export module row_id_gather;
+
+import stl;
+import block_index;
+import buffer_manager;
+import column_vector;
+import internal_types;
+
+namespace infinity {
+
+// Late materialization of table columns: fetches the columns of rows given by row id.
+// The rows are grouped by block, so each block column is read once for all the rows of the block.
+// Column column_ids[i] of row_ids[j] is appended to outputs[i], in the order of the row ids.
+export void GatherByRowID(const BlockIndex *block_index,
+                          BufferManager *buffer_mgr,
+                          const RowID *row_ids,
+                          SizeT row_count,
+                          const Vector<SizeT> &column_ids,
+                          const Vector<ColumnVector *> &outputs);
+
+} // namespace infinity
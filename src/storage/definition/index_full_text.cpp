@@ -40,6 +40,7 @@ SharedPtr<IndexBase> IndexFullText::Make(SharedPtr<String> index_name,
                                          Vector<String> column_names,
                                          const Vector<InitParameter *> &index_param_list) {
     String analyzer{};
+    optionflag_t flag = OPTION_FLAG_ALL;
     SizeT param_count = index_param_list.size();
     for (SizeT param_idx = 0; param_idx < param_count; ++param_idx) {
         InitParameter *parameter = index_param_list[param_idx];
@@ -47,16 +48,26 @@ SharedPtr<IndexBase> IndexFullText::Make(SharedPtr<String> index_name,
         ToLowerString(para_name);
         if (para_name == "analyzer") {
             analyzer = parameter->param_value_;
+        } else if (para_name == "posting_format") {
+            String posting_format = parameter->param_value_;
+            ToLowerString(posting_format);
+            if (posting_format == "simd_block") {
+                flag |= of_simd_block;
+            } else if (posting_format != "default") {
+                RecoverableError(Status::InvalidIndexParam("Posting format"));
+            }
         }
     }
-    return MakeShared<IndexFullText>(index_name, file_name, std::move(column_names), analyzer);
+    return MakeShared<IndexFullText>(index_name, file_name, std::move(column_names), analyzer, flag);
 }
 
+String IndexFullText::PostingFormatToString(optionflag_t flag) { return (flag & of_simd_block) ? "simd_block" : "default"; }
+
 bool IndexFullText::operator==(const IndexFullText &other) const {
     if (this->index_type_ != other.index_type_ || this->file_name_ != other.file_name_ || this->column_names_ != other.column_names_) {
         return false;
     }
-    return analyzer_ == other.analyzer_;
+    return analyzer_ == other.analyzer_ && flag_ == other.flag_;
 }
 
 bool IndexFullText::operator!=(const IndexFullText &other) const { return !(*this == other); }
@@ -80,13 +91,16 @@ String IndexFullText::ToString() const {
     if (!analyzer_.empty()) {
         output_str += ", " + analyzer_;
     }
+    if (flag_ & of_simd_block) {
+        output_str += ", " + PostingFormatToString(flag_);
+    }
     return output_str;
 }
 
 
 String IndexFullText::BuildOtherParamsString() const {
     std::stringstream ss;
-    ss << "analyzer = " << analyzer_;
+    ss << "analyzer = " << analyzer_ << ", posting_format = " << PostingFormatToString(flag_);
     return ss.str();
 }
 
@@ -94,6 +108,7 @@ String IndexFullText::BuildOtherParamsString() const {
 nlohmann::json IndexFullText::Serialize() const {
     nlohmann::json res = IndexBase::Serialize();
     res["analyzer"] = analyzer_;
+    res["flag"] = flag_;
     return res;
 }
 
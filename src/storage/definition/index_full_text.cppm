@@ -68,6 +68,8 @@ public:
 public:
     static void ValidateColumnDataType(const SharedPtr<BaseTableRef> &base_table_ref, const String &column_name);
 
+    static String PostingFormatToString(optionflag_t flag);
+
 public:
     String analyzer_{};
     optionflag_t flag_{OPTION_FLAG_ALL};
@@ -60,6 +60,14 @@ public:
         return min_max_data_filter_->MayInRange(column_id, value, compare_type);
     }
 
+    // Ordered key of the min or the max of a column, to read the most promising blocks first. Not a bound for a query, see Evaluate.
+    inline Optional<f64> GetMinMaxOrderKey(ColumnID column_id, bool max) const {
+        if (!HaveMinMaxFilter()) {
+            return None;
+        }
+        return min_max_data_filter_->GetOrderKey(column_id, max);
+    }
+
     String SerializeToString() const;
 
     void DeserializeFromString(const String &str);
@@ -23,6 +23,7 @@ import infinity_exception;
 import filter_expression_push_down_helper;
 import internal_types;
 import filter_value_type_classification;
+import segment_statistics;
 
 namespace infinity {
 
@@ -84,6 +85,15 @@ public:
 
     [[nodiscard]] inline bool MayInRange(const Value &value, FilterCompareType compare_type) const { return MayInRangeT(value, compare_type); }
 
+    // ordered key of the min or the max, None for types without a statistics key
+    [[nodiscard]] inline Optional<f64> GetOrderKey(bool max) const {
+        if constexpr (HaveStatisticsKey<OriginalValueType>) {
+            return ToStatisticsKey(max ? max_ : min_);
+        } else {
+            return None;
+        }
+    }
+
     [[nodiscard]] u32 SizeInBytes() const { return sizeof(min_) + sizeof(max_); }
 
     void SaveToOStringStream(OStringStream &os) const {
@@ -180,6 +190,13 @@ public:
                           min_max_filters_[column_id]);
     }
 
+    // None if the column has no min max filter or its type has no ordered key
+    [[nodiscard]] inline Optional<f64> GetOrderKey(ColumnID column_id, bool max) const {
+        return std::visit(Overload{[](const std::monostate &empty) -> Optional<f64> { return None; },
+                                   [max]<typename T>(const InnerMinMaxDataFilterT<T> &filter) -> Optional<f64> { return filter.GetOrderKey(max); }},
+                          min_max_filters_[column_id]);
+    }
+
     // used in build_fast_rough_filter_task
     template <typename OriginalValueType, typename MinMaxInnerValT>
     void Build(ColumnID column_id, MinMaxInnerValT &&min, MinMaxInnerValT &&max) {
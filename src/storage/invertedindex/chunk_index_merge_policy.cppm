@@ -0,0 +1,100 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+export module chunk_index_merge_policy;
+
+import stl;
+import default_values;
+
+namespace infinity {
+
+// Tiered merge policy for the full-text chunk indexes of a segment.
+// Tier 0 holds chunks of less than tier_base rows, tier i holds chunks of [tier_base * factor^(i-1), tier_base * factor^i) rows. Once
+// merge_factor adjacent chunks are in the same tier they are merged into one chunk of the next tier, so every row is rewritten only
+// about log_{factor}(segment rows / tier_base) times. If a segment still has more than max_chunks chunks, the adjacent chunks with the
+// fewest rows are merged regardless of their tiers, which bounds the number of dictionaries a term lookup probes.
+export class TieredChunkMergePolicy {
+public:
+    explicit TieredChunkMergePolicy(SizeT merge_factor = DEFAULT_FULL_TEXT_MERGE_FACTOR,
+                                    SizeT max_chunks = DEFAULT_FULL_TEXT_MAX_CHUNKS_PER_SEGMENT,
+                                    u32 tier_base = DEFAULT_FULL_TEXT_MERGE_TIER_BASE)
+        : merge_factor_(std::max<SizeT>(merge_factor, 2)), max_chunks_(std::max<SizeT>(max_chunks, 1)), tier_base_(std::max<u32>(tier_base, 1)) {}
+
+    // row_counts are of the chunks of a segment ordered by base row id.
+    // Returns the range [begin, end) of adjacent chunks to merge, or an empty range if the segment needs no merge.
+    Pair<SizeT, SizeT> Pick(const Vector<u32> &row_counts) const {
+        const SizeT num = row_counts.size();
+        if (num < 2) {
+            return {0, 0};
+        }
+        // The lowest tier is preferred since its chunks are the cheapest to merge.
+        Pair<SizeT, SizeT> picked{0, 0};
+        u32 picked_tier = std::numeric_limits<u32>::max();
+        SizeT run_begin = 0;
+        u32 run_tier = Tier(row_counts[0]);
+        for (SizeT i = 1; i <= num; ++i) {
+            u32 tier = i < num ? Tier(row_counts[i]) : std::numeric_limits<u32>::max();
+            if (tier == run_tier) {
+                continue;
+            }
+            if (i - run_begin >= merge_factor_ && run_tier < picked_tier) {
+                picked = {run_begin, run_begin + merge_factor_};
+                picked_tier = run_tier;
+            }
+            run_begin = i;
+            run_tier = tier;
+        }
+        if (picked.first < picked.second || num <= max_chunks_) {
+            return picked;
+        }
+        // Too many chunks of different tiers. Merge the window of adjacent chunks with the fewest rows.
+        const SizeT window = std::min(merge_factor_, num - max_chunks_ + 1);
+        u64 window_rows = 0;
+        for (SizeT i = 0; i < window; ++i) {
+            window_rows += row_counts[i];
+        }
+        u64 min_rows = window_rows;
+        SizeT min_begin = 0;
+        for (SizeT i = window; i < num; ++i) {
+            window_rows += row_counts[i];
+            window_rows -= row_counts[i - window];
+            if (window_rows < min_rows) {
+                min_rows = window_rows;
+                min_begin = i - window + 1;
+            }
+        }
+        return {min_begin, min_begin + window};
+    }
+
+    u32 Tier(u32 row_count) const {
+        u32 tier = 0;
+        for (u64 bound = tier_base_; row_count >= bound; bound *= merge_factor_) {
+            ++tier;
+        }
+        return tier;
+    }
+
+    SizeT merge_factor() const { return merge_factor_; }
+
+    SizeT max_chunks() const { return max_chunks_; }
+
+private:
+    const SizeT merge_factor_;
+    const SizeT max_chunks_;
+    const u32 tier_base_;
+};
+
+} // namespace infinity
@@ -26,6 +26,8 @@ import third_party;
 import file_system;
 import file_system_type;
 import infinity_exception;
+import rate_limiter;
+import column_length_io;
 
 namespace infinity {
 ColumnIndexMerger::ColumnIndexMerger(const String &index_dir, optionflag_t flag, MemoryPool *memory_pool, RecyclePool *buffer_pool)
@@ -37,7 +39,7 @@ SharedPtr<PostingMerger> ColumnIndexMerger::CreatePostingMerger() {
     return MakeShared<PostingMerger>(memory_pool_, buffer_pool_, flag_, column_length_mutex_, column_length_array_);
 }
 
-void ColumnIndexMerger::Merge(const Vector<String> &base_names, const Vector<RowID> &base_rowids, const String &dst_base_name) {
+void ColumnIndexMerger::Merge(const Vector<String> &base_names, const Vector<RowID> &base_rowids, const String &dst_base_name, RateLimiter *rate_limiter) {
     assert(base_names.size() == base_rowids.size());
     if (base_rowids.empty()) {
         return;
@@ -59,6 +61,7 @@ void ColumnIndexMerger::Merge(const Vector<String> &base_names, const Vector<Row
     String term;
     TermMeta term_meta;
     SizeT term_meta_offset = 0;
+    SizeT throttled_bytes = 0;
 
     auto merge_base_rowid = base_rowids[0];
     for (auto& row_id : base_rowids) {
@@ -85,6 +88,18 @@ void ColumnIndexMerger::Merge(const Vector<String> &base_names, const Vector<Row
                 UnrecoverableError("ColumnIndexMerger: when loading column length file, read_count != file_size");
             }
         }
+        // the merged chunk needs its own column length file, so that it can be read and merged again like a dumped one
+        String column_len_file = index_prefix + LENGTH_SUFFIX;
+        UniquePtr<FileHandler> file_handler =
+            fs_.OpenFile(column_len_file, FileFlags::WRITE_FLAG | FileFlags::CREATE_FLAG | FileFlags::TRUNCATE_CREATE, FileLockType::kNoLock);
+        const i64 expect_write_count = column_length_array_.size() * sizeof(u32);
+        const i64 write_count = fs_.Write(*file_handler, column_length_array_.data(), expect_write_count);
+        file_handler->Sync();
+        file_handler->Close();
+        if (write_count != expect_write_count) {
+            UnrecoverableError("ColumnIndexMerger: when dumping column length file, write_count != expect_write_count");
+        }
+        WriteColumnNormFile(fs_, index_prefix + NORM_SUFFIX, column_length_array_);
     }
 
     while (!term_posting_queue.Empty()) {
@@ -97,6 +112,12 @@ void ColumnIndexMerger::Merge(const Vector<String> &base_names, const Vector<Row
         fst_builder.Insert((u8 *)term.c_str(), term.length(), term_meta_offset);
         term_meta_offset = dict_file_writer->TotalWrittenBytes();
         term_posting_queue.MoveToNextTerm();
+        if (rate_limiter != nullptr) {
+            // postings are read and written once each
+            SizeT posting_bytes = posting_file_writer_->TotalWrittenBytes();
+            rate_limiter->Request(2 * (posting_bytes - throttled_bytes));
+            throttled_bytes = posting_bytes;
+        }
     }
     dict_file_writer->Sync();
     posting_file_writer_->Sync();
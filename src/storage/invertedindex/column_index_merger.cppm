@@ -15,6 +15,7 @@ import column_index_iterator;
 import segment_term_posting;
 import local_file_system;
 import internal_types;
+import rate_limiter;
 
 namespace infinity {
 export class ColumnIndexMerger {
@@ -22,7 +23,8 @@ public:
     ColumnIndexMerger(const String &index_dir, optionflag_t flag, MemoryPool *memory_pool, RecyclePool *buffer_pool);
     ~ColumnIndexMerger();
 
-    void Merge(const Vector<String> &base_names, const Vector<RowID> &base_rowids, const String &dst_base_name);
+    // Merge chunks of the same segment into dst_base_name. If rate_limiter is given, the posting I/O is throttled by it.
+    void Merge(const Vector<String> &base_names, const Vector<RowID> &base_rowids, const String &dst_base_name, RateLimiter *rate_limiter = nullptr);
 
 private:
     SharedPtr<PostingMerger> CreatePostingMerger();
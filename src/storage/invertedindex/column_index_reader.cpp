@@ -38,6 +38,8 @@ import create_index_info;
 import index_base;
 import index_full_text;
 import third_party;
+import fst;
+import column_length_io;
 
 namespace infinity {
 void ColumnIndexReader::Open(optionflag_t flag, String &&index_dir, Map<SegmentID, SharedPtr<SegmentIndexEntry>> &&index_by_segment) {
@@ -55,6 +57,7 @@ void ColumnIndexReader::Open(optionflag_t flag, String &&index_dir, Map<SegmentI
         // for loading column length files
         base_names_.insert(base_names_.end(), std::move_iterator(base_names.begin()), std::move_iterator(base_names.end()));
         base_row_ids_.insert(base_row_ids_.end(), base_row_ids.begin(), base_row_ids.end());
+        chunk_in_memory_.resize(base_names_.size(), false);
         if (memory_indexer and memory_indexer->GetDocCount() != 0) {
             // segment_reader
             SharedPtr<InMemIndexSegmentReader> segment_reader = MakeShared<InMemIndexSegmentReader>(memory_indexer);
@@ -62,13 +65,21 @@ void ColumnIndexReader::Open(optionflag_t flag, String &&index_dir, Map<SegmentI
             // for loading column length file
             base_names_.push_back(memory_indexer->GetBaseName());
             base_row_ids_.push_back(memory_indexer->GetBaseRowId());
+            chunk_in_memory_.push_back(true);
+            has_memory_chunk_ = true;
         }
+        auto [sum, cnt] = segment_index_entry->GetFulltextColumnLenInfo();
+        column_len_sum_ += sum;
+        column_len_cnt_ += cnt;
     }
     // put an INVALID_ROWID at the end of base_row_ids_
     base_row_ids_.emplace_back(INVALID_ROWID);
 }
 
 UniquePtr<PostingIterator> ColumnIndexReader::Lookup(const String &term, MemoryPool *session_pool) {
+    if (u32 df = 0; !has_memory_chunk_ and GetCachedDocFreq(term, df) and df == 0) {
+        return nullptr;
+    }
     SharedPtr<Vector<SegmentPosting>> seg_postings = MakeShared<Vector<SegmentPosting>>();
     for (u32 i = 0; i < segment_readers_.size(); ++i) {
         SegmentPosting seg_posting;
@@ -77,21 +88,79 @@ UniquePtr<PostingIterator> ColumnIndexReader::Lookup(const String &term, MemoryP
             seg_postings->push_back(seg_posting);
         }
     }
-    if (seg_postings->empty())
-        return nullptr;
-    auto iter = MakeUnique<PostingIterator>(flag_, session_pool);
-    u32 state_pool_size = 0; // TODO
-    iter->Init(seg_postings, state_pool_size);
+    UniquePtr<PostingIterator> iter;
+    if (!seg_postings->empty()) {
+        iter = MakeUnique<PostingIterator>(flag_, session_pool);
+        iter->Init(seg_postings, 0);
+    }
+    if (!has_memory_chunk_) {
+        CacheDocFreq(term, iter ? iter->GetDocFreq() : 0);
+    }
     return iter;
 }
 
+bool ColumnIndexReader::GetCachedDocFreq(const String &term, u32 &df) {
+    std::scoped_lock lock(cache_mutex_);
+    auto it = term_df_cache_.find(term);
+    if (it == term_df_cache_.end()) {
+        return false;
+    }
+    term_df_lru_.splice(term_df_lru_.begin(), term_df_lru_, it->second.second);
+    df = it->second.first;
+    return true;
+}
+
+void ColumnIndexReader::CacheDocFreq(const String &term, u32 df) {
+    std::scoped_lock lock(cache_mutex_);
+    if (auto it = term_df_cache_.find(term); it != term_df_cache_.end()) {
+        it->second.first = df;
+        term_df_lru_.splice(term_df_lru_.begin(), term_df_lru_, it->second.second);
+        return;
+    }
+    if (term_df_cache_.size() >= TERM_DF_CACHE_CAPACITY) {
+        term_df_cache_.erase(term_df_lru_.back());
+        term_df_lru_.pop_back();
+    }
+    term_df_lru_.push_front(term);
+    term_df_cache_.emplace(term, Pair<u32, List<String>::iterator>(df, term_df_lru_.begin()));
+}
+
+Vector<UniquePtr<PostingIterator>> ColumnIndexReader::LookupExpanded(Automaton &automaton, MemoryPool *session_pool) {
+    Vector<Pair<String, SegmentPosting>> term_postings;
+    for (u32 i = 0; i < segment_readers_.size(); ++i) {
+        segment_readers_[i]->GetSegmentPostings(automaton, term_postings, session_pool);
+    }
+    // segment readers are visited in row id order, so the postings of each term stay in row id order, same as Lookup
+    Map<String, SharedPtr<Vector<SegmentPosting>>> term_seg_postings;
+    for (auto &[term, seg_posting] : term_postings) {
+        auto &seg_postings = term_seg_postings[term];
+        if (!seg_postings) {
+            seg_postings = MakeShared<Vector<SegmentPosting>>();
+        }
+        seg_postings->push_back(std::move(seg_posting));
+    }
+    Vector<UniquePtr<PostingIterator>> iters;
+    iters.reserve(term_seg_postings.size());
+    for (auto &[term, seg_postings] : term_seg_postings) {
+        auto iter = MakeUnique<PostingIterator>(flag_, session_pool);
+        iter->Init(seg_postings, 0);
+        iters.push_back(std::move(iter));
+    }
+    return iters;
+}
+
 float ColumnIndexReader::GetAvgColumnLength() const {
-    u64 column_len_sum = 0;
-    u32 column_len_cnt = 0;
-    for (const auto &[segment_id, segment_index_entry] : index_by_segment_) {
-        auto [sum, cnt] = segment_index_entry->GetFulltextColumnLenInfo();
-        column_len_sum += sum;
-        column_len_cnt += cnt;
+    u64 column_len_sum = column_len_sum_;
+    u32 column_len_cnt = column_len_cnt_;
+    if (has_memory_chunk_) {
+        // column lengths of a memory indexer are counted when its inserts are committed
+        column_len_sum = 0;
+        column_len_cnt = 0;
+        for (const auto &[segment_id, segment_index_entry] : index_by_segment_) {
+            auto [sum, cnt] = segment_index_entry->GetFulltextColumnLenInfo();
+            column_len_sum += sum;
+            column_len_cnt += cnt;
+        }
     }
     if (column_len_cnt == 0) {
         UnrecoverableError("column_len_cnt is 0");
@@ -99,6 +168,17 @@ float ColumnIndexReader::GetAvgColumnLength() const {
     return static_cast<float>(column_len_sum) / column_len_cnt;
 }
 
+SharedPtr<FullTextColumnNorms> ColumnIndexReader::GetColumnNorms() {
+    if (has_memory_chunk_) {
+        return MakeShared<FullTextColumnNorms>(index_dir_, base_names_, base_row_ids_, chunk_in_memory_, GetAvgColumnLength());
+    }
+    std::scoped_lock lock(cache_mutex_);
+    if (!column_norms_) {
+        column_norms_ = MakeShared<FullTextColumnNorms>(index_dir_, base_names_, base_row_ids_, chunk_in_memory_, GetAvgColumnLength());
+    }
+    return column_norms_;
+}
+
 void TableIndexReaderCache::UpdateKnownUpdateTs(TxnTimeStamp ts, std::shared_mutex &segment_update_ts_mutex, TxnTimeStamp &segment_update_ts) {
     std::scoped_lock lock1(mutex_);
     std::unique_lock lock2(segment_update_ts_mutex);
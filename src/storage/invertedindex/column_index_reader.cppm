@@ -24,6 +24,8 @@ import index_defines;
 import memory_indexer;
 import internal_types;
 import segment_index_entry;
+import fst;
+import column_length_io;
 
 export module column_index_reader;
 
@@ -36,18 +38,41 @@ public:
 
     UniquePtr<PostingIterator> Lookup(const String &term, MemoryPool *session_pool);
 
+    // Returns one iterator per term accepted by the automaton, over the postings of the term in all segments
+    Vector<UniquePtr<PostingIterator>> LookupExpanded(Automaton &automaton, MemoryPool *session_pool);
+
+    // avgdl, df and norms are cached in the reader, which queries share through TableIndexReaderCache
     float GetAvgColumnLength() const;
 
+    SharedPtr<FullTextColumnNorms> GetColumnNorms();
+
 private:
+    // df of a term cached by an earlier Lookup, the lookup moves it to the front of the lru list
+    bool GetCachedDocFreq(const String &term, u32 &df);
+
+    void CacheDocFreq(const String &term, u32 df);
+
+    static constexpr SizeT TERM_DF_CACHE_CAPACITY = 4096;
+
     optionflag_t flag_;
     Vector<SharedPtr<IndexSegmentReader>> segment_readers_;
     Map<SegmentID, SharedPtr<SegmentIndexEntry>> index_by_segment_;
+    u64 column_len_sum_{0};
+    u32 column_len_cnt_{0};
+    // chunks of memory indexers still receive docs, statistics depending on them are not cached
+    bool has_memory_chunk_{false};
+    std::mutex cache_mutex_;
+    // df of the recently looked up terms, a cached df of 0 skips the dictionaries of all segments
+    List<String> term_df_lru_;
+    HashMap<String, Pair<u32, List<String>::iterator>> term_df_cache_;
+    SharedPtr<FullTextColumnNorms> column_norms_;
 
 public:
     // for loading column length files
     String index_dir_;
     Vector<String> base_names_;
     Vector<RowID> base_row_ids_;
+    Vector<bool> chunk_in_memory_;
 };
 
 namespace detail {
@@ -18,7 +18,6 @@ module;
 #include <cassert>
 #include <cstdio>
 #include <cstring>
-#include <iostream>
 #include <vector>
 module column_inverter;
 import stl;
@@ -231,6 +230,11 @@ void ColumnInverter::SortForOfflineDump() {
     Sort();
 }
 
+SizeT ColumnInverter::MemUsage() const {
+    return terms_.capacity() + positions_.capacity() * sizeof(PosInfo) + term_refs_.capacity() * sizeof(u32) +
+           terms_per_doc_.capacity() * sizeof(Pair<u32, UniquePtr<TermList>>);
+}
+
 /// Layout of the input of external sort file
 //    +-----------+  +----------------++--------------------++--------------------------++-------------------------------------------------------+
 //    |           |  |                ||                    ||                          ||                                                       |
@@ -239,50 +243,112 @@ void ColumnInverter::SortForOfflineDump() {
 //    +-----------+  +----------------++--------------------++--------------------------++-------------------------------------------------------+
 //                   ----------------------------------------------------------------------------------------------------------------------------+
 //                                                            Data within each group
+struct SpillRunWriter {
+    FILE *spill_file_;
+    u64 data_size_pos_{0};
+    u64 next_start_offset_pos_{0};
+    u64 data_start_offset_{0};
+
+    SpillRunWriter(FILE *spill_file, u32 num_of_tuples) : spill_file_(spill_file) {
+        // size of this Run in bytes
+        u32 data_size = 0;
+        data_size_pos_ = ftell(spill_file_);
+        fwrite(&data_size, sizeof(u32), 1, spill_file_);
+        // number of tuples
+        fwrite(&num_of_tuples, sizeof(u32), 1, spill_file_);
+        // start offset for next spill
+        u64 next_start_offset = 0;
+        next_start_offset_pos_ = ftell(spill_file_);
+        fwrite(&next_start_offset, sizeof(u64), 1, spill_file_);
+        data_start_offset_ = ftell(spill_file_);
+    }
+
+    void Write(StringRef term, docid_t doc_id, u32 term_pos) {
+        static const char str_null = '\0';
+        u32 record_length = term.size() + sizeof(docid_t) + sizeof(u32) + 1;
+        fwrite(&record_length, sizeof(u32), 1, spill_file_);
+        fwrite(term.data(), term.size(), 1, spill_file_);
+        fwrite(&str_null, sizeof(char), 1, spill_file_);
+        fwrite(&doc_id, sizeof(docid_t), 1, spill_file_);
+        fwrite(&term_pos, sizeof(u32), 1, spill_file_);
+    }
+
+    void Finish() {
+        // update data size
+        u64 next_start_offset = ftell(spill_file_);
+        u32 data_size = next_start_offset - data_start_offset_;
+        fseek(spill_file_, data_size_pos_, SEEK_SET);
+        fwrite(&data_size, sizeof(u32), 1, spill_file_); // update offset for next spill
+        fseek(spill_file_, next_start_offset_pos_, SEEK_SET);
+        fwrite(&next_start_offset, sizeof(u64), 1, spill_file_);
+        fseek(spill_file_, next_start_offset, SEEK_SET);
+    }
+};
+
 void ColumnInverter::SpillSortResults(FILE *spill_file, u64 &tuple_count) {
     // spill sort results for external merge sort
-
-    // size of this Run in bytes
-    u32 data_size = 0;
-    u64 data_size_pos = ftell(spill_file);
-    fwrite(&data_size, sizeof(u32), 1, spill_file);
-    // number of tuples
     u32 num_of_tuples = positions_.size();
     tuple_count += num_of_tuples;
-    fwrite(&num_of_tuples, sizeof(u32), 1, spill_file);
-    // start offset for next spill
-    u64 next_start_offset = 0;
-    u64 next_start_offset_pos = ftell(spill_file);
-    fwrite(&next_start_offset, sizeof(u64), 1, spill_file);
-    u64 data_start_offset = ftell(spill_file);
+    SpillRunWriter run_writer(spill_file, num_of_tuples);
     // sorted data
     u32 last_term_num = std::numeric_limits<u32>::max();
     StringRef term;
-    u32 record_length = 0;
-    char str_null = '\0';
     for (auto &i : positions_) {
         if (last_term_num != i.term_num_) {
             last_term_num = i.term_num_;
             term = GetTermFromNum(last_term_num);
         }
-        record_length = term.size() + sizeof(docid_t) + sizeof(u32) + 1;
-        if (record_length > 1024)
-            std::cout << "!!!!!! record_length " << record_length << std::endl;
-        fwrite(&record_length, sizeof(u32), 1, spill_file);
-        fwrite(term.data(), term.size(), 1, spill_file);
-        fwrite(&str_null, sizeof(char), 1, spill_file);
-        fwrite(&i.doc_id_, sizeof(docid_t), 1, spill_file);
-        fwrite(&i.term_pos_, sizeof(u32), 1, spill_file);
+        run_writer.Write(term, i.doc_id_, i.term_pos_);
     }
+    run_writer.Finish();
+}
 
-    // update data size
-    next_start_offset = ftell(spill_file);
-    data_size = next_start_offset - data_start_offset;
-    fseek(spill_file, data_size_pos, SEEK_SET);
-    fwrite(&data_size, sizeof(u32), 1, spill_file); // update offset for next spill
-    fseek(spill_file, next_start_offset_pos, SEEK_SET);
-    fwrite(&next_start_offset, sizeof(u64), 1, spill_file);
-    fseek(spill_file, next_start_offset, SEEK_SET);
+void ColumnInverter::SpillSortResults(FILE *spill_file, u64 &tuple_count, const Vector<SharedPtr<ColumnInverter>> &inverters) {
+    if (inverters.size() == 1) {
+        inverters[0]->SpillSortResults(spill_file, tuple_count);
+        return;
+    }
+    // k-way merge of the sorted inverters by term. Each cursor points at the first position of a term within one inverter,
+    // ties are broken by the inverter index which keeps the doc ids of the same term ascending.
+    struct Cursor {
+        const ColumnInverter *inverter_;
+        u32 idx_;
+        SizeT pos_;
+        const char *term_;
+    };
+    auto cmp = [](const Cursor &lhs, const Cursor &rhs) {
+        int ret = std::strcmp(lhs.term_, rhs.term_);
+        return ret != 0 ? ret > 0 : lhs.idx_ > rhs.idx_;
+    };
+    Heap<Cursor, decltype(cmp)> heap(cmp);
+    u64 num_of_tuples = 0;
+    for (u32 i = 0; i < inverters.size(); ++i) {
+        const ColumnInverter *inverter = inverters[i].get();
+        num_of_tuples += inverter->positions_.size();
+        if (!inverter->positions_.empty()) {
+            heap.push(Cursor{inverter, i, 0, inverter->GetTermFromNum(inverter->positions_[0].term_num_)});
+        }
+    }
+    if (num_of_tuples > std::numeric_limits<u32>::max()) {
+        UnrecoverableError(fmt::format("Too many tuples {} in one spill run", num_of_tuples));
+    }
+    tuple_count += num_of_tuples;
+    SpillRunWriter run_writer(spill_file, u32(num_of_tuples));
+    while (!heap.empty()) {
+        Cursor cursor = heap.top();
+        heap.pop();
+        const PosInfoVec &positions = cursor.inverter_->positions_;
+        u32 term_num = positions[cursor.pos_].term_num_;
+        StringRef term(cursor.term_);
+        for (; cursor.pos_ < positions.size() && positions[cursor.pos_].term_num_ == term_num; ++cursor.pos_) {
+            run_writer.Write(term, positions[cursor.pos_].doc_id_, positions[cursor.pos_].term_pos_);
+        }
+        if (cursor.pos_ < positions.size()) {
+            cursor.term_ = cursor.inverter_->GetTermFromNum(positions[cursor.pos_].term_num_);
+            heap.push(cursor);
+        }
+    }
+    run_writer.Finish();
 }
 
 } // namespace infinity
\ No newline at end of file
@@ -58,6 +58,9 @@ public:
 
     u32 GetMerged() { return merged_; }
 
+    // Approximate heap bytes held by the inverted and sorted results.
+    SizeT MemUsage() const;
+
     struct PosInfo {
         u32 term_num_{0};
         u32 doc_id_{0};
@@ -76,6 +79,10 @@ public:
 
     void SpillSortResults(FILE *spill_file, u64 &tuple_count);
 
+    // Spill several inverters, each already sorted by SortForOfflineDump, as one run. The inverters shall cover ascending
+    // doc id ranges, so that merging them term by term keeps postings of the same term in doc id order.
+    static void SpillSortResults(FILE *spill_file, u64 &tuple_count, const Vector<SharedPtr<ColumnInverter>> &inverters);
+
 private:
     using TermBuffer = Vector<char>;
     using PosInfoVec = Vector<PosInfo>;
@@ -369,7 +369,11 @@ void SortMerger<KeyType, LenType>::Output(FILE *f, u32 idx) {
             ;
 
         IASSERT(out_buf_size_[idx] <= OUT_BUF_SIZE_ / OUT_BUF_NUM_);
-        io_stream.Write(sub_out_buf_[idx], out_buf_size_[idx]);
+        if (consumer_) {
+            consumer_(sub_out_buf_[idx], out_buf_size_[idx]);
+        } else {
+            io_stream.Write(sub_out_buf_[idx], out_buf_size_[idx]);
+        }
         out_buf_full_[idx] = false;
         out_buf_size_[idx] = 0;
         ++out_buf_out_idx_;
@@ -381,7 +385,7 @@ void SortMerger<KeyType, LenType>::Output(FILE *f, u32 idx) {
 }
 
 template <typename KeyType, typename LenType>
-void SortMerger<KeyType, LenType>::Run() {
+void SortMerger<KeyType, LenType>::MergeRuns(FILE *out_f) {
     FILE *f = fopen(filenm_.c_str(), "r");
 
     DirectIO io_stream(f);
@@ -394,9 +398,9 @@ void SortMerger<KeyType, LenType>::Run() {
     Thread predict_thread(std::bind(&self_t::Predict, this, io_stream));
     Thread merge_thread(std::bind(&self_t::Merge, this));
 
-    FILE *out_f = fopen((filenm_ + ".out").c_str(), "w+");
-    IASSERT(out_f);
-    IASSERT(fwrite(&count_, sizeof(u64), 1, out_f) == 1);
+    if (out_f != nullptr) {
+        IASSERT(fwrite(&count_, sizeof(u64), 1, out_f) == 1);
+    }
 
     Vector<Thread *> out_thread(OUT_BUF_NUM_);
     for (u32 i = 0; i < OUT_BUF_NUM_; ++i)
@@ -410,6 +414,15 @@ void SortMerger<KeyType, LenType>::Run() {
     }
 
     fclose(f);
+}
+
+template <typename KeyType, typename LenType>
+void SortMerger<KeyType, LenType>::Run() {
+    FILE *out_f = fopen((filenm_ + ".out").c_str(), "w+");
+    IASSERT(out_f);
+
+    MergeRuns(out_f);
+
     fclose(out_f);
 
     if (std::filesystem::exists(filenm_))
@@ -418,6 +431,13 @@ void SortMerger<KeyType, LenType>::Run() {
         std::filesystem::rename(filenm_ + ".out", filenm_);
 }
 
+template <typename KeyType, typename LenType>
+void SortMerger<KeyType, LenType>::Run(OutputConsumer consumer) {
+    consumer_ = std::move(consumer);
+    MergeRuns(nullptr);
+    consumer_ = nullptr;
+}
+
 template class SortMerger<u32, u8>;
 template class SortMerger<TermTuple, u32>;
 } // namespace infinity
\ No newline at end of file
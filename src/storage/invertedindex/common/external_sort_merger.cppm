@@ -171,6 +171,11 @@ struct KeyAddress<KeyType, LenType, typename std::enable_if<std::is_scalar<KeyTy
 
 export template <typename KeyType, typename LenType>
 class SortMerger {
+public:
+    // Receives a chunk of merged output, which is a sequence of [LenType length][record] entries. Chunks are handed over in order.
+    using OutputConsumer = std::function<void(char *data, u32 size)>;
+
+private:
     typedef SortMerger<KeyType, LenType> self_t;
     typedef KeyAddress<KeyType, LenType> KeyAddr;
     String filenm_;
@@ -223,6 +228,8 @@ class SortMerger {
 
     u64 FILE_LEN_;
 
+    OutputConsumer consumer_{}; //!< if set, output threads pass the merged data to it instead of writing the output file
+
     void NewBuffer();
 
     void Init(DirectIO &io_stream);
@@ -233,6 +240,8 @@ class SortMerger {
 
     void Output(FILE *f, u32 idx);
 
+    void MergeRuns(FILE *out_f);
+
 public:
     SortMerger(const char *filenm, u32 group_size = 4, u32 bs = 100000000, u32 output_num = 2);
 
@@ -257,7 +266,12 @@ public:
             OUT_BUF_SIZE_ = min_buff_size_required;
     }
 
+    // Merge the runs and replace the input file with the merged result.
     void Run();
+
+    // Merge the runs and feed the merged result to consumer, so that it can be processed while the merge is still in progress.
+    // The input file is kept.
+    void Run(OutputConsumer consumer);
 };
 
 } // namespace infinity
@@ -73,6 +73,15 @@ public:
         }
     }
 
+    // Calls visitor(key, value) on each item in key order, under the read lock
+    template <typename Visitor>
+    void ForEach(Visitor &&visitor) {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        for (const auto &[key, value] : map_) {
+            visitor(key, value);
+        }
+    }
+
     // WARN: Caller shall ensure there's no concurrent write access
     Map<KeyType, ValueType>::iterator UnsafeBegin() { return map_.begin(); }
 
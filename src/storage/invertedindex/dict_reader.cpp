@@ -81,4 +81,17 @@ bool DictionaryReader::Next(String &term, TermMeta &term_meta) {
     return true;
 }
 
+void DictionaryReader::Search(Automaton &automaton, Vector<Pair<String, TermMeta>> &terms) {
+    FstAutomatonStream s(*fst_, automaton);
+    Vector<u8> key;
+    u64 val;
+    while (s.Next(key, val)) {
+        auto &[term, term_meta] = terms.emplace_back();
+        term = String((char *)key.data(), key.size());
+        u8 *data_cursor = data_ptr_ + val;
+        SizeT left_size = data_len_ - val;
+        meta_loader_.Load(data_cursor, left_size, term_meta);
+    }
+}
+
 } // namespace infinity
\ No newline at end of file
@@ -43,5 +43,9 @@ public:
     void InitIterator(const String &prefix);
 
     bool Next(String &term, TermMeta &term_meta);
+
+    /// Appends all terms accepted by the automaton, in lexicographical order.
+    /// Unlike InitIterator/Next it doesn't touch the shared stream.
+    void Search(Automaton &automaton, Vector<Pair<String, TermMeta>> &terms);
 };
 } // namespace infinity
@@ -27,6 +27,7 @@ import term_meta;
 import byte_slice;
 import posting_list_format;
 import internal_types;
+import fst;
 
 namespace infinity {
 
@@ -48,6 +49,25 @@ bool DiskIndexSegmentReader::GetSegmentPosting(const String &term, SegmentPostin
     TermMeta term_meta;
     if (!dict_reader_.get() || !dict_reader_->Lookup(term, term_meta))
         return false;
+    ReadSegmentPosting(term_meta, seg_posting, session_pool);
+    return true;
+}
+
+void DiskIndexSegmentReader::GetSegmentPostings(Automaton &automaton,
+                                                Vector<Pair<String, SegmentPosting>> &term_postings,
+                                                MemoryPool *session_pool) const {
+    if (!dict_reader_.get())
+        return;
+    Vector<Pair<String, TermMeta>> terms;
+    dict_reader_->Search(automaton, terms);
+    for (auto &[term, term_meta] : terms) {
+        auto &[posting_term, seg_posting] = term_postings.emplace_back();
+        posting_term = std::move(term);
+        ReadSegmentPosting(term_meta, seg_posting, session_pool);
+    }
+}
+
+void DiskIndexSegmentReader::ReadSegmentPosting(TermMeta &term_meta, SegmentPosting &seg_posting, MemoryPool *session_pool) const {
     u64 file_length = term_meta.pos_end_ - term_meta.doc_start_;
     ByteSlice *slice = ByteSlice::CreateSlice(file_length, session_pool);
     {
@@ -57,7 +77,6 @@ bool DiskIndexSegmentReader::GetSegmentPosting(const String &term, SegmentPostin
     }
     SharedPtr<ByteSliceList> byte_slice_list = MakeShared<ByteSliceList>(slice, session_pool);
     seg_posting.Init(std::move(byte_slice_list), base_row_id_, term_meta.doc_freq_, term_meta);
-    return true;
 }
 
 } // namespace infinity
@@ -25,6 +25,8 @@ import file_reader;
 import posting_list_format;
 import local_file_system;
 import internal_types;
+import term_meta;
+import fst;
 
 namespace infinity {
 export class DiskIndexSegmentReader : public IndexSegmentReader {
@@ -34,7 +36,11 @@ public:
 
     bool GetSegmentPosting(const String &term, SegmentPosting &seg_posting, MemoryPool *session_pool) const override;
 
+    void GetSegmentPostings(Automaton &automaton, Vector<Pair<String, SegmentPosting>> &term_postings, MemoryPool *session_pool) const override;
+
 private:
+    void ReadSegmentPosting(TermMeta &term_meta, SegmentPosting &seg_posting, MemoryPool *session_pool) const;
+
     RowID base_row_id_{INVALID_ROWID};
     SharedPtr<DictionaryReader> dict_reader_;
     mutable std::mutex mutex_;
@@ -26,6 +26,7 @@ public:
         }
         short_list_vbyte_compress_ = 0;
         has_block_max_ = (option_flag & of_block_max) ? 1 : 0;
+        simd_block_ = (option_flag & of_simd_block) ? 1 : 0;
         unused_ = 0;
         // when has_block_max_ is set, has_tf_list_ must also be set
         if (has_block_max_ and !has_tf_list_) {
@@ -37,9 +38,11 @@ public:
     bool HasTfList() const { return has_tf_list_ == 1; }
     bool HasDocPayload() const { return has_doc_payload_ == 1; }
     bool HasBlockMax() const { return has_block_max_ == 1; }
+    bool IsSIMDBlock() const { return simd_block_ == 1; }
     bool operator==(const DocListFormatOption &right) const {
         return has_tf_ == right.has_tf_ && has_tf_list_ == right.has_tf_list_ && has_doc_payload_ == right.has_doc_payload_ &&
-               short_list_vbyte_compress_ == right.short_list_vbyte_compress_ && has_block_max_ == right.has_block_max_;
+               short_list_vbyte_compress_ == right.short_list_vbyte_compress_ && has_block_max_ == right.has_block_max_ &&
+               simd_block_ == right.simd_block_;
     }
     bool IsShortListVbyteCompress() const { return short_list_vbyte_compress_ == 1; }
     void SetShortListVbyteCompress(bool flag) { short_list_vbyte_compress_ = flag ? 1 : 0; }
@@ -50,7 +53,8 @@ private:
     u8 has_doc_payload_ : 1;
     u8 short_list_vbyte_compress_ : 1;
     u8 has_block_max_ : 1;
-    u8 unused_ : 3;
+    u8 simd_block_ : 1;
+    u8 unused_ : 2;
 };
 
 export class DocSkipListFormat : public PostingFields {
@@ -130,18 +134,34 @@ public:
         u8 row_count = 0;
         u32 offset = 0;
         {
-            TypedPostingField<u32> *doc_id_field = new TypedPostingField<u32>;
+            PostingField *doc_id_field = nullptr;
+            if (option.IsSIMDBlock()) {
+                SIMDBlockPostingField<u32> *field = new SIMDBlockPostingField<u32>;
+                field->encoder_ = GetSIMDBlockEncoder();
+                doc_id_field = field;
+            } else {
+                TypedPostingField<u32> *field = new TypedPostingField<u32>;
+                field->encoder_ = GetDocIDEncoder();
+                doc_id_field = field;
+            }
             doc_id_field->location_ = row_count++;
             doc_id_field->offset_ = offset;
-            doc_id_field->encoder_ = GetDocIDEncoder();
             values_.push_back(doc_id_field);
             offset += sizeof(u32);
         }
         if (option.HasTfList()) {
-            TypedPostingField<u32> *tf_field = new TypedPostingField<u32>;
+            PostingField *tf_field = nullptr;
+            if (option.IsSIMDBlock()) {
+                SIMDBlockPostingField<u32> *field = new SIMDBlockPostingField<u32>;
+                field->encoder_ = GetSIMDBlockEncoder();
+                tf_field = field;
+            } else {
+                TypedPostingField<u32> *field = new TypedPostingField<u32>;
+                field->encoder_ = GetTFEncoder();
+                tf_field = field;
+            }
             tf_field->location_ = row_count++;
             tf_field->offset_ = offset;
-            tf_field->encoder_ = GetTFEncoder();
             values_.push_back(tf_field);
             offset += sizeof(u32);
         }
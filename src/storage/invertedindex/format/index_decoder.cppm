@@ -48,6 +48,9 @@ public:
         doc_id_encoder_ = GetDocIDEncoder();
         tf_list_encoder_ = GetTFEncoder();
         doc_payload_encoder_ = GetDocPayloadEncoder();
+        if (doc_list_format_option.IsSIMDBlock()) {
+            simd_block_encoder_ = GetSIMDBlockEncoder();
+        }
     }
 
     virtual ~SkipIndexDecoder() {
@@ -86,14 +89,14 @@ public:
         skiped_item_count_ = skiplist_reader_->GetSkippedItemCount();
 
         doc_list_reader_->Seek(offset + this->doc_list_begin_pos_);
-        doc_id_encoder_->Decode((u32 *)doc_buffer, MAX_DOC_PER_RECORD, *doc_list_reader_);
+        DecodeU32((u32 *)doc_buffer, doc_id_encoder_);
 
         first_doc_id = doc_buffer[0] + last_doc_id_in_prev_record;
         return true;
     }
 
     bool DecodeCurrentTFBuffer(tf_t *tf_buffer) {
-        tf_list_encoder_->Decode((u32 *)tf_buffer, MAX_DOC_PER_RECORD, *doc_list_reader_);
+        DecodeU32((u32 *)tf_buffer, tf_list_encoder_);
         return true;
     }
 
@@ -102,6 +105,13 @@ public:
     }
 
 private:
+    inline u32 DecodeU32(u32 *buffer, const Int32Encoder *encoder) {
+        if (simd_block_encoder_) {
+            return simd_block_encoder_->Decode(buffer, MAX_DOC_PER_RECORD, *doc_list_reader_);
+        }
+        return encoder->Decode(buffer, MAX_DOC_PER_RECORD, *doc_list_reader_);
+    }
+
     SkipListType *skiplist_reader_;
     MemoryPool *session_pool_;
     ByteSliceReader *doc_list_reader_;
@@ -109,6 +119,7 @@ private:
     const Int32Encoder *doc_id_encoder_;
     const Int32Encoder *tf_list_encoder_;
     const Int16Encoder *doc_payload_encoder_;
+    const SIMDBlockEncoder *simd_block_encoder_{nullptr};
 };
 
 } // namespace infinity
\ No newline at end of file
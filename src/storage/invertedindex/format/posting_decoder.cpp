@@ -34,6 +34,7 @@ void PostingDecoder::Init(TermMeta *term_meta,
     tf_list_encoder_ = nullptr;
     doc_payload_encoder_ = nullptr;
     position_encoder_ = nullptr;
+    simd_block_encoder_ = nullptr;
 
     posting_data_length_ = posting_data_len;
     InitDocListEncoder(posting_format_option_.GetDocListFormatOption(), term_meta_->GetDocFreq());
@@ -51,6 +52,7 @@ void PostingDecoder::Init(TermMeta *term_meta, bool is_doc_list, bool df_first)
     tf_list_encoder_ = nullptr;
     doc_payload_encoder_ = nullptr;
     position_encoder_ = nullptr;
+    simd_block_encoder_ = nullptr;
 
     posting_data_length_ = 0;
 }
@@ -61,9 +63,11 @@ u32 PostingDecoder::DecodeDocList(docid_t *doc_id_buf, tf_t *tf_list_buf, docpay
     }
 
     // decode normal doclist
-    auto doc_len = doc_id_encoder_->Decode((u32 *)doc_id_buf, len, *posting_list_reader_);
+    auto doc_len = simd_block_encoder_ ? simd_block_encoder_->Decode((u32 *)doc_id_buf, len, *posting_list_reader_)
+                                       : doc_id_encoder_->Decode((u32 *)doc_id_buf, len, *posting_list_reader_);
     if (tf_list_encoder_) {
-        auto tf_len = tf_list_encoder_->Decode((u32 *)tf_list_buf, len, *posting_list_reader_);
+        auto tf_len = simd_block_encoder_ ? simd_block_encoder_->Decode((u32 *)tf_list_buf, len, *posting_list_reader_)
+                                          : tf_list_encoder_->Decode((u32 *)tf_list_buf, len, *posting_list_reader_);
         if (doc_len != tf_len) {
             UnrecoverableError("doc/tf-list collapsed: ");
         }
@@ -102,6 +106,10 @@ void PostingDecoder::InitDocListEncoder(const DocListFormatOption &doc_list_form
     if (doc_list_format_option.HasDocPayload()) {
         doc_payload_encoder_ = GetDocPayloadEncoder();
     }
+
+    if (doc_list_format_option.IsSIMDBlock()) {
+        simd_block_encoder_ = GetSIMDBlockEncoder();
+    }
 }
 
 void PostingDecoder::InitPosListEncoder(const PositionListFormatOption &position_list_format_option, ttf_t total_tf) {
@@ -41,6 +41,7 @@ private:
     const Int32Encoder *tf_list_encoder_;
     const Int16Encoder *doc_payload_encoder_;
     const Int32Encoder *position_encoder_;
+    const SIMDBlockEncoder *simd_block_encoder_{nullptr};
 
     df_t decoded_doc_count_;
     tf_t decoded_pos_count_;
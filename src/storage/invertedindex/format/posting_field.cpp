@@ -4,6 +4,7 @@ import stl;
 import int_encoder;
 import no_compress_encoder;
 import vbyte_compress_encoder;
+import simd_block_encoder;
 
 module posting_field;
 
@@ -14,6 +15,7 @@ struct EncoderProvider {
     UniquePtr<Int16Encoder> int16_encoder_ = MakeUnique<Int16Encoder>();
     UniquePtr<NoCompressEncoder> no_compress_encoder_ = MakeUnique<NoCompressEncoder>();
     UniquePtr<VByteCompressEncoder> vbyte_compress_encoder_ = MakeUnique<VByteCompressEncoder>();
+    UniquePtr<SIMDBlockEncoder> simd_block_encoder_ = MakeUnique<SIMDBlockEncoder>();
 
     static EncoderProvider *GetInstance() {
         static EncoderProvider instance;
@@ -27,6 +29,8 @@ struct EncoderProvider {
     NoCompressEncoder *GetNoCompressEncoder() { return no_compress_encoder_.get(); }
 
     VByteCompressEncoder *GetVByteCompressEncoder() { return vbyte_compress_encoder_.get(); }
+
+    SIMDBlockEncoder *GetSIMDBlockEncoder() { return simd_block_encoder_.get(); }
 };
 
 const Int32Encoder *GetDocIDEncoder() { return EncoderProvider::GetInstance()->GetInt32Encoder(); }
@@ -41,4 +45,6 @@ const Int32Encoder *GetSkipListEncoder() { return EncoderProvider::GetInstance()
 
 const Int32Encoder *GetPosListEncoder() { return EncoderProvider::GetInstance()->GetInt32Encoder(); }
 
+const SIMDBlockEncoder *GetSIMDBlockEncoder() { return EncoderProvider::GetInstance()->GetSIMDBlockEncoder(); }
+
 } // namespace infinity
\ No newline at end of file
@@ -7,6 +7,7 @@ import byte_slice_reader;
 import byte_slice_writer;
 import no_compress_encoder;
 import vbyte_compress_encoder;
+import simd_block_encoder;
 
 export module posting_field;
 
@@ -48,6 +49,7 @@ export typedef IntEncoder<u32, SIMDBitPacking> Int32Encoder;
 export typedef IntEncoder<u16, NewPForDeltaCompressor> Int16Encoder;
 export typedef NoCompressIntEncoder<u32> NoCompressEncoder;
 export typedef VByteIntEncoder<u32> VByteCompressEncoder;
+export typedef SIMDBlockIntEncoder<u32> SIMDBlockEncoder;
 
 template <typename T>
 struct EncoderTypeTraits {
@@ -76,6 +78,8 @@ export const Int32Encoder *GetSkipListEncoder();
 
 export const Int32Encoder *GetPosListEncoder();
 
+export const SIMDBlockEncoder *GetSIMDBlockEncoder();
+
 export template <typename T>
 struct TypedPostingField : public PostingField {
     typedef typename EncoderTypeTraits<T>::Encoder Encoder;
@@ -125,6 +129,22 @@ struct VByteCompressPostingField : public PostingField {
     const VByteCompressEncoder *encoder_{nullptr};
 };
 
+export template <typename T>
+struct SIMDBlockPostingField : public PostingField {
+
+    SizeT GetSize() const override { return sizeof(T); }
+
+    u32 Encode(ByteSliceWriter &slice_writer, const u8 *src, u32 len) const override {
+        return encoder_->Encode(slice_writer, (const T *)src, len / sizeof(T));
+    }
+
+    u32 Decode(u8 *dest, u32 dest_len, ByteSliceReader &slice_reader) const override {
+        return encoder_->Decode((T *)dest, dest_len / sizeof(T), slice_reader);
+    }
+
+    const SIMDBlockEncoder *encoder_{nullptr};
+};
+
 export struct PostingFields {
     virtual ~PostingFields() {
         for (SizeT i = 0; i < values_.size(); ++i) {
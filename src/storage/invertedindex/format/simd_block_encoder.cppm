@@ -0,0 +1,74 @@
+module;
+
+import stl;
+import byte_slice_reader;
+import byte_slice_writer;
+import fastpfor;
+import infinity_exception;
+
+export module simd_block_encoder;
+
+namespace infinity {
+
+// Block-of-128 encoder for doc-id deltas and term frequencies.
+// A full block is written as: u8 count, u8 bit width, SIMD bit-packed payload.
+// A partial block (the tail of a posting list) is written as: u8 count, vbyte values.
+export template <typename T>
+class SIMDBlockIntEncoder {
+    static_assert(sizeof(T) == sizeof(u32), "SIMDBlockIntEncoder only supports 32-bit values");
+
+public:
+    SIMDBlockIntEncoder() = default;
+    ~SIMDBlockIntEncoder() = default;
+
+    inline u32 Encode(ByteSliceWriter &slice_writer, const T *src, u32 src_len) const;
+
+    inline u32 Decode(T *dest, u32 dest_len, ByteSliceReader &slice_reader) const;
+};
+
+template <typename T>
+u32 SIMDBlockIntEncoder<T>::Encode(ByteSliceWriter &slice_writer, const T *src, u32 src_len) const {
+    slice_writer.WriteByte((u8)src_len);
+    if (src_len != SIMD_BLOCK_SIZE) {
+        u32 len = 1;
+        for (u32 i = 0; i < src_len; ++i) {
+            len += slice_writer.WriteVInt(src[i]);
+        }
+        return len;
+    }
+    u32 buffer[SIMD_BLOCK_SIZE];
+    u32 bit = SIMDBlockMaxBits((const u32 *)src);
+    SIMDBlockPack((const u32 *)src, buffer, bit);
+    slice_writer.WriteByte((u8)bit);
+    u32 packed_bytes = SIMDBlockPackedSize(bit) * sizeof(u32);
+    slice_writer.Write((const void *)buffer, packed_bytes);
+    return 2 + packed_bytes;
+}
+
+template <typename T>
+u32 SIMDBlockIntEncoder<T>::Decode(T *dest, u32 dest_len, ByteSliceReader &slice_reader) const {
+    u32 len = slice_reader.ReadByte();
+    if (len > dest_len) {
+        UnrecoverableError("Decode posting FAILED: destination buffer too small");
+    }
+    if (len != SIMD_BLOCK_SIZE) {
+        for (u32 i = 0; i < len; ++i) {
+            dest[i] = slice_reader.ReadVUInt32();
+        }
+        return len;
+    }
+    u32 bit = slice_reader.ReadByte();
+    u32 packed_bytes = SIMDBlockPackedSize(bit) * sizeof(u32);
+    // ReadMayCopy hands out a pointer into the slice when the block does not straddle two slices,
+    // so the hot path unpacks straight from the posting memory without an intermediate copy.
+    u32 buffer[SIMD_BLOCK_SIZE];
+    void *buf_ptr = buffer;
+    SizeT read_len = slice_reader.ReadMayCopy(buf_ptr, packed_bytes);
+    if (read_len != packed_bytes) {
+        UnrecoverableError("Decode posting FAILED");
+    }
+    SIMDBlockUnpack((const u32 *)buf_ptr, (u32 *)dest, bit);
+    return len;
+}
+
+} // namespace infinity
@@ -0,0 +1,678 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+import stl;
+import third_party;
+module fst;
+
+namespace infinity {
+
+namespace {
+
+/// Returns the length of the UTF-8 sequence led by `b`, or 0 if `b` can't lead one.
+SizeT Utf8SequenceLen(u8 b) {
+    if (b < 0x80) {
+        return 1;
+    } else if ((b & 0xE0) == 0xC0) {
+        return 2;
+    } else if ((b & 0xF0) == 0xE0) {
+        return 3;
+    } else if ((b & 0xF8) == 0xF0) {
+        return 4;
+    }
+    return 0;
+}
+
+/// Decodes UTF-8 into code points. A byte which doesn't belong to a valid
+/// sequence is taken as a code point by itself.
+void DecodeUtf8(const String &s, Vector<u32> &code_points) {
+    SizeT i = 0;
+    while (i < s.size()) {
+        u8 b = s[i];
+        SizeT len = Utf8SequenceLen(b);
+        bool valid = len > 0 && i + len <= s.size();
+        for (SizeT j = 1; valid && j < len; j++) {
+            valid = ((u8)s[i + j] & 0xC0) == 0x80;
+        }
+        if (!valid || len == 1) {
+            code_points.push_back(b);
+            i++;
+            continue;
+        }
+        u32 cp = b & (0xFF >> (len + 1));
+        for (SizeT j = 1; j < len; j++) {
+            cp = (cp << 6) | ((u8)s[i + j] & 0x3F);
+        }
+        code_points.push_back(cp);
+        i += len;
+    }
+}
+
+} // namespace
+
+LevenshteinAutomaton::LevenshteinAutomaton(const String &query, u32 max_edits) : max_edits_(std::min(max_edits, MAX_EDITS)) {
+    DecodeUtf8(query, query_);
+    // the dead state
+    states_.emplace_back();
+    trans_.resize(256, DEAD);
+    Vector<u8> row(query_.size() + 1);
+    for (SizeT i = 0; i < row.size(); i++) {
+        row[i] = std::min<SizeT>(i, max_edits_ + 1);
+    }
+    start_ = AddState(std::move(row), 0, 0);
+}
+
+u32 LevenshteinAutomaton::AddState(Vector<u8> &&row, u32 code_point, u8 pending) {
+    u8 min_distance = row[0];
+    for (u8 distance : row) {
+        min_distance = std::min(min_distance, distance);
+    }
+    if (min_distance > max_edits_) {
+        return DEAD;
+    }
+    String key((const char *)row.data(), row.size());
+    key.append((const char *)&code_point, sizeof(code_point));
+    key.push_back((char)pending);
+    if (auto it = state_ids_.find(key); it != state_ids_.end()) {
+        return it->second;
+    }
+    u32 id = states_.size();
+    DfaState &state = states_.emplace_back();
+    state.is_match_ = pending == 0 && row.back() <= max_edits_;
+    state.row_ = std::move(row);
+    state.code_point_ = code_point;
+    state.pending_ = pending;
+    trans_.resize(trans_.size() + 256, UNKNOWN);
+    state_ids_.emplace(std::move(key), id);
+    return id;
+}
+
+u32 LevenshteinAutomaton::Step(const DfaState &state, u32 code_point) {
+    const Vector<u8> &row = state.row_;
+    const u32 cap = max_edits_ + 1;
+    Vector<u8> next(row.size());
+    next[0] = std::min<u32>(row[0] + 1, cap);
+    for (SizeT i = 1; i < row.size(); i++) {
+        u32 substitution = row[i - 1] + (query_[i - 1] == code_point ? 0 : 1);
+        u32 deletion = row[i] + 1;
+        u32 insertion = next[i - 1] + 1;
+        next[i] = std::min(std::min(substitution, deletion), std::min(insertion, cap));
+    }
+    return AddState(std::move(next), 0, 0);
+}
+
+u32 LevenshteinAutomaton::Accept(u32 state, u8 byte) {
+    if (state == DEAD) {
+        return DEAD;
+    }
+    SizeT idx = (SizeT)state * 256 + byte;
+    if (trans_[idx] != UNKNOWN) {
+        return trans_[idx];
+    }
+    // copy since AddState may reallocate states_
+    DfaState current = states_[state];
+    u32 next;
+    if (current.pending_ == 0) {
+        SizeT len = Utf8SequenceLen(byte);
+        if (len <= 1) {
+            // ASCII, or a stray byte taken as a code point by itself
+            next = Step(current, byte);
+        } else {
+            next = AddState(std::move(current.row_), byte & (0xFF >> (len + 1)), len - 1);
+        }
+    } else if ((byte & 0xC0) != 0x80) {
+        next = DEAD;
+    } else {
+        u32 code_point = (current.code_point_ << 6) | (byte & 0x3F);
+        if (current.pending_ == 1) {
+            next = Step(current, code_point);
+        } else {
+            next = AddState(std::move(current.row_), code_point, current.pending_ - 1);
+        }
+    }
+    trans_[idx] = next;
+    return next;
+}
+
+namespace {
+
+constexpr u32 REPEAT_INFINITE = std::numeric_limits<u32>::max();
+constexpr u32 MAX_REPEAT = 1000;
+
+struct RegexNode {
+    enum Kind : u8 { kEmpty, kBytes, kClass, kConcat, kAlt, kRepeat } kind_;
+    // kBytes
+    u8 lo_{0};
+    u8 hi_{0};
+    // kClass
+    Array<bool, 128> ascii_{};
+    bool negated_{false};
+    Vector<String> multibyte_; // non-ASCII code points in UTF-8
+    // kRepeat
+    u32 min_{0};
+    u32 max_{0};
+    Vector<UniquePtr<RegexNode>> children_;
+
+    explicit RegexNode(Kind kind) : kind_(kind) {}
+
+    static UniquePtr<RegexNode> Bytes(u8 lo, u8 hi) {
+        auto node = MakeUnique<RegexNode>(kBytes);
+        node->lo_ = lo;
+        node->hi_ = hi;
+        return node;
+    }
+
+    static UniquePtr<RegexNode> AnyChar() {
+        auto node = MakeUnique<RegexNode>(kClass);
+        node->negated_ = true;
+        return node;
+    }
+
+    static UniquePtr<RegexNode> Repeat(UniquePtr<RegexNode> child, u32 min, u32 max) {
+        auto node = MakeUnique<RegexNode>(kRepeat);
+        node->min_ = min;
+        node->max_ = max;
+        node->children_.push_back(std::move(child));
+        return node;
+    }
+
+    void AddAsciiRange(u8 lo, u8 hi) {
+        for (u32 b = lo; b <= hi; b++) {
+            ascii_[b] = true;
+        }
+    }
+};
+
+class PatternParser {
+public:
+    explicit PatternParser(const String &pattern) : p_(pattern) {}
+
+    UniquePtr<RegexNode> ParseRegex() {
+        auto node = ParseAlt();
+        if (pos_ < p_.size()) {
+            Error("unmatched )");
+        }
+        return node;
+    }
+
+    UniquePtr<RegexNode> ParseWildcard() {
+        auto concat = MakeUnique<RegexNode>(RegexNode::kConcat);
+        while (pos_ < p_.size()) {
+            char c = p_[pos_];
+            if (c == '*') {
+                pos_++;
+                concat->children_.push_back(RegexNode::Repeat(RegexNode::AnyChar(), 0, REPEAT_INFINITE));
+            } else if (c == '?') {
+                pos_++;
+                concat->children_.push_back(RegexNode::AnyChar());
+            } else {
+                if (c == '\\') {
+                    pos_++;
+                    if (pos_ == p_.size()) {
+                        Error("trailing \\");
+                    }
+                }
+                concat->children_.push_back(Literal(ReadCodePoint()));
+            }
+        }
+        return concat;
+    }
+
+private:
+    [[noreturn]] void Error(const char *reason) const { throw FstError::Regex(p_, reason); }
+
+    bool Peek(char c) const { return pos_ < p_.size() && p_[pos_] == c; }
+
+    /// Returns the UTF-8 bytes of the code point at pos_, and advances past it.
+    String ReadCodePoint() {
+        SizeT len = std::max<SizeT>(Utf8SequenceLen(p_[pos_]), 1);
+        len = std::min(len, p_.size() - pos_);
+        String cp = p_.substr(pos_, len);
+        pos_ += len;
+        return cp;
+    }
+
+    static UniquePtr<RegexNode> Literal(const String &code_point) {
+        if (code_point.size() == 1) {
+            return RegexNode::Bytes(code_point[0], code_point[0]);
+        }
+        auto concat = MakeUnique<RegexNode>(RegexNode::kConcat);
+        for (char b : code_point) {
+            concat->children_.push_back(RegexNode::Bytes(b, b));
+        }
+        return concat;
+    }
+
+    /// \d, \w and \s. Returns false for any other escaped character.
+    static bool AddEscapedClass(char c, RegexNode &node) {
+        switch (c) {
+            case 'd':
+                node.AddAsciiRange('0', '9');
+                return true;
+            case 'w':
+                node.AddAsciiRange('0', '9');
+                node.AddAsciiRange('a', 'z');
+                node.AddAsciiRange('A', 'Z');
+                node.ascii_['_'] = true;
+                return true;
+            case 's':
+                for (char ws : {' ', '\t', '\n', '\r', '\f', '\v'}) {
+                    node.ascii_[(u8)ws] = true;
+                }
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    UniquePtr<RegexNode> ParseAlt() {
+        auto first = ParseConcat();
+        if (!Peek('|')) {
+            return first;
+        }
+        auto alt = MakeUnique<RegexNode>(RegexNode::kAlt);
+        alt->children_.push_back(std::move(first));
+        while (Peek('|')) {
+            pos_++;
+            alt->children_.push_back(ParseConcat());
+        }
+        return alt;
+    }
+
+    UniquePtr<RegexNode> ParseConcat() {
+        auto concat = MakeUnique<RegexNode>(RegexNode::kConcat);
+        while (pos_ < p_.size() && !Peek('|') && !Peek(')')) {
+            concat->children_.push_back(ParseRepeat());
+        }
+        if (concat->children_.empty()) {
+            return MakeUnique<RegexNode>(RegexNode::kEmpty);
+        }
+        if (concat->children_.size() == 1) {
+            return std::move(concat->children_[0]);
+        }
+        return concat;
+    }
+
+    u32 ParseNumber() {
+        u32 n = 0;
+        SizeT begin = pos_;
+        while (pos_ < p_.size() && p_[pos_] >= '0' && p_[pos_] <= '9') {
+            n = n * 10 + (p_[pos_] - '0');
+            if (n > MAX_REPEAT) {
+                Error("repetition count too large");
+            }
+            pos_++;
+        }
+        if (pos_ == begin) {
+            Error("invalid repetition");
+        }
+        return n;
+    }
+
+    UniquePtr<RegexNode> ParseRepeat() {
+        auto node = ParseAtom();
+        while (pos_ < p_.size()) {
+            char c = p_[pos_];
+            u32 min, max;
+            if (c == '*') {
+                pos_++;
+                min = 0, max = REPEAT_INFINITE;
+            } else if (c == '+') {
+                pos_++;
+                min = 1, max = REPEAT_INFINITE;
+            } else if (c == '?') {
+                pos_++;
+                min = 0, max = 1;
+            } else if (c == '{') {
+                pos_++;
+                min = max = ParseNumber();
+                if (Peek(',')) {
+                    pos_++;
+                    max = Peek('}') ? REPEAT_INFINITE : ParseNumber();
+                }
+                if (!Peek('}')) {
+                    Error("unclosed {");
+                }
+                pos_++;
+                if (max < min) {
+                    Error("invalid repetition");
+                }
+            } else {
+                break;
+            }
+            node = RegexNode::Repeat(std::move(node), min, max);
+        }
+        return node;
+    }
+
+    UniquePtr<RegexNode> ParseAtom() {
+        char c = p_[pos_];
+        switch (c) {
+            case '(': {
+                pos_++;
+                auto node = ParseAlt();
+                if (!Peek(')')) {
+                    Error("unclosed (");
+                }
+                pos_++;
+                return node;
+            }
+            case '[': {
+                pos_++;
+                return ParseClass();
+            }
+            case '.': {
+                pos_++;
+                return RegexNode::AnyChar();
+            }
+            case '*':
+            case '+':
+            case '?':
+            case '{': {
+                Error("nothing to repeat");
+            }
+            case '\\': {
+                pos_++;
+                if (pos_ == p_.size()) {
+                    Error("trailing \\");
+                }
+                auto node = MakeUnique<RegexNode>(RegexNode::kClass);
+                if (AddEscapedClass(p_[pos_], *node)) {
+                    pos_++;
+                    return node;
+                }
+                return Literal(ReadCodePoint());
+            }
+            default: {
+                return Literal(ReadCodePoint());
+            }
+        }
+    }
+
+    UniquePtr<RegexNode> ParseClass() {
+        auto node = MakeUnique<RegexNode>(RegexNode::kClass);
+        if (Peek('^')) {
+            pos_++;
+            node->negated_ = true;
+        }
+        bool first = true;
+        while (true) {
+            if (pos_ == p_.size()) {
+                Error("unclosed [");
+            }
+            if (Peek(']') && !first) {
+                pos_++;
+                break;
+            }
+            first = false;
+            if (Peek('\\')) {
+                pos_++;
+                if (pos_ == p_.size()) {
+                    Error("trailing \\");
+                }
+                if (AddEscapedClass(p_[pos_], *node)) {
+                    pos_++;
+                    continue;
+                }
+            }
+            String lo = ReadCodePoint();
+            if (Peek('-') && pos_ + 1 < p_.size() && p_[pos_ + 1] != ']') {
+                pos_++;
+                if (Peek('\\')) {
+                    pos_++;
+                }
+                String hi = ReadCodePoint();
+                if (lo.size() != 1 || hi.size() != 1 || (u8)lo[0] >= 0x80 || (u8)hi[0] >= 0x80 || lo[0] > hi[0]) {
+                    Error("invalid or non-ASCII character range");
+                }
+                node->AddAsciiRange(lo[0], hi[0]);
+            } else if (lo.size() == 1 && (u8)lo[0] < 0x80) {
+                node->ascii_[(u8)lo[0]] = true;
+            } else {
+                node->multibyte_.push_back(std::move(lo));
+            }
+        }
+        if (node->negated_ && !node->multibyte_.empty()) {
+            Error("negated class of non-ASCII characters is unsupported");
+        }
+        return node;
+    }
+
+    const String &p_;
+    SizeT pos_{0};
+};
+
+class NfaCompiler {
+public:
+    using NfaState = RegexAutomaton::NfaState;
+
+    explicit NfaCompiler(const String &pattern) : pattern_(pattern) {}
+
+    Vector<NfaState> &nfa() { return nfa_; }
+
+    /// Compiles node so that its matches continue at next, returns the start state.
+    u32 Compile(const RegexNode &node, u32 next) {
+        switch (node.kind_) {
+            case RegexNode::kEmpty: {
+                return next;
+            }
+            case RegexNode::kBytes: {
+                return ByteRange(node.lo_, node.hi_, next);
+            }
+            case RegexNode::kConcat: {
+                u32 s = next;
+                for (auto it = node.children_.rbegin(); it != node.children_.rend(); ++it) {
+                    s = Compile(**it, s);
+                }
+                return s;
+            }
+            case RegexNode::kAlt: {
+                u32 s = Compile(*node.children_.back(), next);
+                for (SizeT i = node.children_.size() - 1; i > 0; i--) {
+                    s = Split(Compile(*node.children_[i - 1], next), s);
+                }
+                return s;
+            }
+            case RegexNode::kRepeat: {
+                const RegexNode &child = *node.children_[0];
+                u32 s = next;
+                if (node.max_ == REPEAT_INFINITE) {
+                    u32 loop = Split(0, next);
+                    u32 body = Compile(child, loop);
+                    nfa_[loop].out_ = body;
+                    s = loop;
+                } else {
+                    // each optional copy may skip straight to next
+                    for (u32 i = node.min_; i < node.max_; i++) {
+                        s = Split(Compile(child, s), next);
+                    }
+                }
+                for (u32 i = 0; i < node.min_; i++) {
+                    s = Compile(child, s);
+                }
+                return s;
+            }
+            case RegexNode::kClass: {
+                return CompileClass(node, next);
+            }
+        }
+        return next;
+    }
+
+    u32 Add(NfaState state) {
+        if (nfa_.size() >= RegexAutomaton::MAX_NFA_STATES) {
+            throw FstError::Regex(pattern_, "pattern too complex");
+        }
+        nfa_.push_back(state);
+        return nfa_.size() - 1;
+    }
+
+private:
+    u32 ByteRange(u8 lo, u8 hi, u32 out) { return Add({NfaState::kByteRange, lo, hi, out, 0}); }
+
+    u32 Split(u32 out, u32 out2) { return Add({NfaState::kSplit, 0, 0, out, out2}); }
+
+    u32 CompileClass(const RegexNode &node, u32 next) {
+        Vector<u32> alts;
+        for (u32 b = 0; b < 128;) {
+            if (node.ascii_[b] == node.negated_) {
+                b++;
+                continue;
+            }
+            u32 lo = b;
+            while (b < 128 && node.ascii_[b] != node.negated_) {
+                b++;
+            }
+            alts.push_back(ByteRange(lo, b - 1, next));
+        }
+        if (node.negated_) {
+            // any non-ASCII code point
+            alts.push_back(ByteRange(0xC2, 0xDF, ByteRange(0x80, 0xBF, next)));
+            alts.push_back(ByteRange(0xE0, 0xEF, ByteRange(0x80, 0xBF, ByteRange(0x80, 0xBF, next))));
+            alts.push_back(ByteRange(0xF0, 0xF4, ByteRange(0x80, 0xBF, ByteRange(0x80, 0xBF, ByteRange(0x80, 0xBF, next)))));
+        } else {
+            for (const String &code_point : node.multibyte_) {
+                u32 s = next;
+                for (auto it = code_point.rbegin(); it != code_point.rend(); ++it) {
+                    s = ByteRange(*it, *it, s);
+                }
+                alts.push_back(s);
+            }
+        }
+        if (alts.empty()) {
+            // empty class, never matches
+            return ByteRange(1, 0, next);
+        }
+        u32 s = alts.back();
+        for (SizeT i = alts.size() - 1; i > 0; i--) {
+            s = Split(alts[i - 1], s);
+        }
+        return s;
+    }
+
+    const String &pattern_;
+    Vector<NfaState> nfa_;
+};
+
+UniquePtr<RegexAutomaton> CompilePattern(const String &pattern, const RegexNode &root) {
+    NfaCompiler compiler(pattern);
+    u32 match = compiler.Add({RegexAutomaton::NfaState::kMatch, 0, 0, 0, 0});
+    u32 start = compiler.Compile(root, match);
+    return MakeUnique<RegexAutomaton>(std::move(compiler.nfa()), start);
+}
+
+} // namespace
+
+UniquePtr<RegexAutomaton> RegexAutomaton::FromRegex(const String &pattern) {
+    PatternParser parser(pattern);
+    auto root = parser.ParseRegex();
+    return CompilePattern(pattern, *root);
+}
+
+UniquePtr<RegexAutomaton> RegexAutomaton::FromWildcard(const String &pattern) {
+    PatternParser parser(pattern);
+    auto root = parser.ParseWildcard();
+    return CompilePattern(pattern, *root);
+}
+
+String RegexAutomaton::EscapeWildcard(const String &literal) {
+    String escaped;
+    escaped.reserve(literal.size());
+    for (char c : literal) {
+        if (c == '*' || c == '?' || c == '\\') {
+            escaped.push_back('\\');
+        }
+        escaped.push_back(c);
+    }
+    return escaped;
+}
+
+RegexAutomaton::RegexAutomaton(Vector<NfaState> &&nfa, u32 nfa_start) : nfa_(std::move(nfa)) {
+    closure_marks_.resize(nfa_.size(), 0);
+    // the dead state
+    dfa_states_.emplace_back();
+    trans_.resize(256, DEAD);
+    Vector<u32> nfa_states{nfa_start};
+    Closure(nfa_states);
+    start_ = AddState(std::move(nfa_states));
+}
+
+void RegexAutomaton::Closure(Vector<u32> &nfa_states) {
+    closure_epoch_++;
+    Vector<u32> stack;
+    stack.swap(nfa_states);
+    while (!stack.empty()) {
+        u32 s = stack.back();
+        stack.pop_back();
+        if (closure_marks_[s] == closure_epoch_) {
+            continue;
+        }
+        closure_marks_[s] = closure_epoch_;
+        if (nfa_[s].kind_ == NfaState::kSplit) {
+            stack.push_back(nfa_[s].out2_);
+            stack.push_back(nfa_[s].out_);
+        } else {
+            nfa_states.push_back(s);
+        }
+    }
+    std::sort(nfa_states.begin(), nfa_states.end());
+}
+
+u32 RegexAutomaton::AddState(Vector<u32> &&nfa_states) {
+    if (nfa_states.empty()) {
+        return DEAD;
+    }
+    if (auto it = dfa_state_ids_.find(nfa_states); it != dfa_state_ids_.end()) {
+        return it->second;
+    }
+    if (dfa_states_.size() >= MAX_DFA_STATES) {
+        throw FstError::Regex("", "pattern too complex");
+    }
+    u32 id = dfa_states_.size();
+    DfaState &state = dfa_states_.emplace_back();
+    for (u32 s : nfa_states) {
+        if (nfa_[s].kind_ == NfaState::kMatch) {
+            state.is_match_ = true;
+            break;
+        }
+    }
+    state.nfa_states_ = nfa_states;
+    trans_.resize(trans_.size() + 256, UNKNOWN);
+    dfa_state_ids_.emplace(std::move(nfa_states), id);
+    return id;
+}
+
+u32 RegexAutomaton::Accept(u32 state, u8 byte) {
+    if (state == DEAD) {
+        return DEAD;
+    }
+    SizeT idx = (SizeT)state * 256 + byte;
+    if (trans_[idx] != UNKNOWN) {
+        return trans_[idx];
+    }
+    Vector<u32> next;
+    for (u32 s : dfa_states_[state].nfa_states_) {
+        const NfaState &nfa_state = nfa_[s];
+        if (nfa_state.kind_ == NfaState::kByteRange && nfa_state.lo_ <= byte && byte <= nfa_state.hi_) {
+            next.push_back(nfa_state.out_);
+        }
+    }
+    Closure(next);
+    u32 id = AddState(std::move(next));
+    trans_[idx] = id;
+    return id;
+}
+
+} // namespace infinity
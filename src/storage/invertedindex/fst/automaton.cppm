@@ -0,0 +1,206 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+export module fst:automaton;
+import stl;
+import :error;
+
+namespace infinity {
+
+/// Automaton describes types that behave as a finite automaton over bytes.
+///
+/// All implementors are deterministic. An automaton drives the traversal of
+/// an fst (see `FstAutomatonStream`): a transition of the fst is followed
+/// only if the automaton can still match after consuming its input byte, so
+/// subtrees of the fst that can never match are never visited.
+///
+/// States are small integers handed out by the automaton itself. The state
+/// tables of the automata below are built lazily while the fst is traversed,
+/// hence `Accept` is not const and an automaton shall not be shared between
+/// threads.
+export class Automaton {
+public:
+    virtual ~Automaton() = default;
+
+    /// Returns the start state.
+    virtual u32 Start() = 0;
+
+    /// Returns true if and only if the input consumed so far is accepted.
+    virtual bool IsMatch(u32 state) = 0;
+
+    /// Returns false if no input following the one consumed so far can ever
+    /// be accepted.
+    virtual bool CanMatch(u32 state) = 0;
+
+    /// Returns the state reached from `state` by consuming `byte`.
+    virtual u32 Accept(u32 state, u8 byte) = 0;
+
+    /// Returns true if and only if the whole input is accepted.
+    bool Eval(const u8 *input, SizeT len) {
+        u32 state = Start();
+        for (SizeT i = 0; i < len; i++) {
+            if (!CanMatch(state)) {
+                return false;
+            }
+            state = Accept(state, input[i]);
+        }
+        return IsMatch(state);
+    }
+};
+
+/// An automaton that matches all keys starting with the given prefix.
+export class PrefixAutomaton final : public Automaton {
+private:
+    String prefix_;
+
+public:
+    explicit PrefixAutomaton(const String &prefix) : prefix_(prefix) {}
+
+    /// State `i` (i <= len) means `i` bytes of the prefix are matched, state
+    /// `len + 1` means the input diverged from the prefix.
+    u32 Start() override { return 0; }
+
+    bool IsMatch(u32 state) override { return state == prefix_.size(); }
+
+    bool CanMatch(u32 state) override { return state <= prefix_.size(); }
+
+    u32 Accept(u32 state, u8 byte) override {
+        if (state >= prefix_.size()) {
+            return state;
+        }
+        return (u8)prefix_[state] == byte ? state + 1 : prefix_.size() + 1;
+    }
+};
+
+/// An automaton that matches all keys within the given edit distance of the
+/// query, where an edit is the insertion, deletion or substitution of a
+/// unicode code point. Keys are expected to be UTF-8.
+///
+/// The automaton is the lazy determinization of the classical Levenshtein
+/// NFA: a state is a row of the edit distance matrix between the query and
+/// the input consumed so far, with distances capped at `max_edits + 1`,
+/// plus the bytes of an incomplete code point if any.
+export class LevenshteinAutomaton final : public Automaton {
+public:
+    /// The edit distance is limited since the number of states grows very
+    /// fast with it.
+    static constexpr u32 MAX_EDITS = 2;
+
+    LevenshteinAutomaton(const String &query, u32 max_edits);
+
+    u32 Start() override { return start_; }
+
+    bool IsMatch(u32 state) override { return states_[state].is_match_; }
+
+    bool CanMatch(u32 state) override { return state != DEAD; }
+
+    u32 Accept(u32 state, u8 byte) override;
+
+private:
+    struct DfaState {
+        Vector<u8> row_;
+        u32 code_point_{0}; // bits of the incomplete code point
+        u8 pending_{0};     // number of continuation bytes still expected
+        bool is_match_{false};
+    };
+
+    static constexpr u32 DEAD = 0;
+    static constexpr u32 UNKNOWN = std::numeric_limits<u32>::max();
+
+    u32 AddState(Vector<u8> &&row, u32 code_point, u8 pending);
+
+    u32 Step(const DfaState &state, u32 code_point);
+
+    Vector<u32> query_;
+    u32 max_edits_;
+    u32 start_;
+    Vector<DfaState> states_;
+    HashMap<String, u32> state_ids_;
+    Vector<u32> trans_; // 256 entries per state
+};
+
+/// An automaton that matches all keys accepted by a regular expression, or by
+/// a wildcard pattern. The whole key must match. Keys are expected to be
+/// UTF-8.
+///
+/// Supported regular expression syntax:
+///   - literals, `\` escapes any special character
+///   - `.` any code point
+///   - `[abc]`, `[a-z]`, `[^abc]` character classes, ranges must be ASCII
+///   - `\d`, `\w`, `\s`
+///   - `(...)` grouping, `|` alternation
+///   - `*`, `+`, `?`, `{m}`, `{m,}`, `{m,n}` repetition
+/// Wildcard patterns support `*` (any sequence of code points), `?` (one
+/// code point) and `\` escapes.
+///
+/// The pattern is compiled into a Thompson NFA over bytes which is
+/// determinized lazily, one DFA state per set of NFA states reached.
+/// An `FstError` is thrown for an invalid or too complex pattern.
+export class RegexAutomaton final : public Automaton {
+public:
+    static constexpr SizeT MAX_NFA_STATES = 100000;
+    static constexpr SizeT MAX_DFA_STATES = 10000;
+
+    static UniquePtr<RegexAutomaton> FromRegex(const String &pattern);
+
+    static UniquePtr<RegexAutomaton> FromWildcard(const String &pattern);
+
+    /// Escapes the special characters of a wildcard pattern.
+    static String EscapeWildcard(const String &literal);
+
+    u32 Start() override { return start_; }
+
+    bool IsMatch(u32 state) override { return dfa_states_[state].is_match_; }
+
+    bool CanMatch(u32 state) override { return state != DEAD; }
+
+    u32 Accept(u32 state, u8 byte) override;
+
+public:
+    /// NFA state: either consumes one byte in [lo_, hi_] and goes to out_,
+    /// or (split) goes to out_ and out2_ without consuming input, or matches.
+    struct NfaState {
+        enum Kind : u8 { kByteRange, kSplit, kMatch } kind_;
+        u8 lo_{0};
+        u8 hi_{0};
+        u32 out_{0};
+        u32 out2_{0};
+    };
+
+    explicit RegexAutomaton(Vector<NfaState> &&nfa, u32 nfa_start);
+
+private:
+    struct DfaState {
+        Vector<u32> nfa_states_; // sorted
+        bool is_match_{false};
+    };
+
+    static constexpr u32 DEAD = 0;
+    static constexpr u32 UNKNOWN = std::numeric_limits<u32>::max();
+
+    void Closure(Vector<u32> &nfa_states);
+
+    u32 AddState(Vector<u32> &&nfa_states);
+
+    Vector<NfaState> nfa_;
+    u32 start_;
+    Vector<DfaState> dfa_states_;
+    Map<Vector<u32>, u32> dfa_state_ids_;
+    Vector<u32> trans_; // 256 entries per state
+    Vector<u32> closure_marks_;
+    u32 closure_epoch_{0};
+};
+
+} // namespace infinity
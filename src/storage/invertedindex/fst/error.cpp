@@ -76,4 +76,8 @@ FstError FstError::Unsupported(const String &method) {
     return FstError(FstErrorCode::kUnsupported, MakeUnique<String>(fmt::format("Method {} is unsupported", method)));
 }
 
+FstError FstError::Regex(const String &pattern, const String &reason) {
+    return FstError(FstErrorCode::kRegex, MakeUnique<String>(fmt::format("Invalid pattern \"{}\": {}", pattern, reason)));
+}
+
 } // namespace infinity
\ No newline at end of file
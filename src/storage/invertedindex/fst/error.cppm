@@ -38,6 +38,7 @@ export enum FstErrorCode : long {
     kOutofOrderKey = 1006,
     kFromUtf8 = 1007,
     kUnsupported = 1008,
+    kRegex = 1009,
 };
 
 export class FstError {
@@ -75,6 +76,10 @@ public:
     /// An error that occurred when calling to unsupported methods.
     static FstError Unsupported(const String &method);
 
+    /// An error that occurred when compiling a regular expression or a
+    /// wildcard pattern into an automaton.
+    static FstError Regex(const String &pattern, const String &reason);
+
 public:
     FstError() = default;
 
@@ -19,6 +19,7 @@ import crc;
 import :error;
 import :bytes;
 import :node;
+import :automaton;
 
 /// An acyclic deterministic finite state transducer.
 ///
@@ -47,6 +48,7 @@ private:
     SizeT data_len_;
 
     friend class FstStream;
+    friend class FstAutomatonStream;
 
 public:
     /// Creates a transducer from its representation as a raw byte sequence.
@@ -251,16 +253,17 @@ public:
 
     void Reset(u8 *prefix_ptr, SizeT prefix_len) {
         Bound min(Bound::kIncluded, prefix_ptr, prefix_len);
+        // The keys starting with the prefix are those below the successor of
+        // the prefix, which is the prefix with its last non-0xFF byte
+        // incremented and anything after that byte removed.
         Bound max(Bound::kExcluded, prefix_ptr, prefix_len);
-        int i;
-        for (i = prefix_len - 1; i >= 0; i--) {
-            prefix_ptr[i]++;
-            if (prefix_ptr[i] != 0x00) {
-                break;
-            }
+        while (!max.key_.empty() && max.key_.back() == 0xFF) {
+            max.key_.pop_back();
         }
-        if (i < 0) {
+        if (max.key_.empty()) {
             max = Bound();
+        } else {
+            max.key_.back()++;
         }
         Reset(min, max);
     }
@@ -366,4 +369,81 @@ private:
     }
 };
 
+/// A lexicographically ordered stream of the key-value pairs from an fst
+/// whose keys are accepted by an automaton.
+///
+/// Transitions leading to automaton states which can never match are
+/// skipped, so only the part of the fst that may hold matching keys is
+/// visited.
+export class FstAutomatonStream {
+private:
+    struct State {
+        Node node_;
+        SizeT trans_;
+        Output out_;
+        u32 aut_state_;
+        State(const Node &node, SizeT trans, Output out, u32 aut_state) : node_(node), trans_(trans), out_(out), aut_state_(aut_state) {}
+    };
+
+    Fst &fst_;
+    Automaton &aut_;
+    Vector<u8> inp_;
+    Vector<State> stack_;
+    bool empty_match_{false};
+    u64 empty_val_{0};
+
+public:
+    FstAutomatonStream(Fst &fst, Automaton &aut) : fst_(fst), aut_(aut) {
+        u32 start = aut_.Start();
+        Node root = fst_.Root();
+        if (aut_.CanMatch(start)) {
+            stack_.emplace_back(root, 0, Output(), start);
+        }
+        // the empty key is never returned by Next()
+        empty_match_ = root.IsFinal() && aut_.IsMatch(start);
+        if (empty_match_) {
+            empty_val_ = root.FinalOutput().Value();
+        }
+    }
+
+    /// @brief Get next key-value pair accepted by the automaton per lexicographical order
+    /// @param key Stores the key of the pair when found
+    /// @param val Stores the value of the pair when found
+    /// @return true if found next pair, false if not
+    bool Next(Vector<u8> &key, u64 &val) {
+        if (empty_match_) {
+            empty_match_ = false;
+            key.clear();
+            val = empty_val_;
+            return true;
+        }
+        while (!stack_.empty()) {
+            State &state = stack_.back();
+            if (state.trans_ >= state.node_.Len()) {
+                if (stack_.size() > 1) {
+                    inp_.pop_back();
+                }
+                stack_.pop_back();
+                continue;
+            }
+            Transition trans = state.node_.TransAt(state.trans_);
+            state.trans_++;
+            u32 next_state = aut_.Accept(state.aut_state_, trans.inp_);
+            if (!aut_.CanMatch(next_state)) {
+                continue;
+            }
+            Output out = state.out_.Cat(trans.out_);
+            Node next_node = fst_.NodeAt(trans.addr_);
+            inp_.push_back(trans.inp_);
+            stack_.emplace_back(next_node, 0, out, next_state);
+            if (next_node.IsFinal() && aut_.IsMatch(next_state)) {
+                key = inp_;
+                val = out.Cat(next_node.FinalOutput()).Value();
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
 } // namespace infinity
\ No newline at end of file
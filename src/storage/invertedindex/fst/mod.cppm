@@ -20,3 +20,4 @@ export import :bytes;
 export import :error;
 export import :writer;
 export import :registry;
+export import :automaton;
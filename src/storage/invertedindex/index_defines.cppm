@@ -20,6 +20,7 @@ export {
         of_position_list = 4,  // 1 << 2
         of_term_frequency = 8, // 1 << 3
         of_block_max = 16,     // 1 << 4
+        of_simd_block = 32,    // 1 << 5, doc-id/tf blocks of 128 are SIMD bit-packed
     };
 
     typedef u16 docpayload_t;
@@ -54,6 +55,7 @@ export {
     constexpr const char *POSTING_SUFFIX = ".pos";
     constexpr const char *SPILL_SUFFIX = ".spill";
     constexpr const char *LENGTH_SUFFIX = ".len";
+    constexpr const char *NORM_SUFFIX = ".nrm";
 
     using ScoredId = Pair<float, u32>;
     using ScoredIds = Vector<ScoredId>;
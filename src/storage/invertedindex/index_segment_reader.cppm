@@ -18,6 +18,7 @@ import stl;
 import memory_pool;
 import segment_posting;
 import index_defines;
+import fst;
 export module index_segment_reader;
 
 namespace infinity {
@@ -27,6 +28,10 @@ public:
     virtual ~IndexSegmentReader() {}
 
     virtual bool GetSegmentPosting(const String &term, SegmentPosting &seg_posting, MemoryPool *session_pool) const = 0;
+
+    // Appends the postings of all terms accepted by the automaton, keyed by term
+    virtual void
+    GetSegmentPostings(Automaton &automaton, Vector<Pair<String, SegmentPosting>> &term_postings, MemoryPool *session_pool) const = 0;
 };
 
 } // namespace infinity
\ No newline at end of file
@@ -23,6 +23,7 @@ import index_segment_reader;
 import index_defines;
 import posting_writer;
 import memory_indexer;
+import fst;
 
 namespace infinity {
 InMemIndexSegmentReader::InMemIndexSegmentReader(MemoryIndexer *memory_indexer)
@@ -38,4 +39,16 @@ bool InMemIndexSegmentReader::GetSegmentPosting(const String &term, SegmentPosti
     return false;
 }
 
+void InMemIndexSegmentReader::GetSegmentPostings(Automaton &automaton,
+                                                 Vector<Pair<String, SegmentPosting>> &term_postings,
+                                                 MemoryPool *session_pool) const {
+    posting_table_->store_.ForEach([&](const String &term, const SharedPtr<PostingWriter> &writer) {
+        if (automaton.Eval((const u8 *)term.data(), term.size())) {
+            auto &[posting_term, seg_posting] = term_postings.emplace_back();
+            posting_term = term;
+            seg_posting.Init(base_row_id_, writer);
+        }
+    });
+}
+
 } // namespace infinity
\ No newline at end of file
@@ -25,9 +25,11 @@ module;
 #pragma clang diagnostic pop
 
 #include <cassert>
+#include <chrono>
 #include <filesystem>
 #include <iostream>
 #include <string.h>
+#include <thread>
 #include <unistd.h>
 module memory_indexer;
 
@@ -53,6 +55,7 @@ import dict_reader;
 import file_reader;
 import column_length_io;
 import logger;
+import default_values;
 
 namespace infinity {
 constexpr int MAX_TUPLE_LENGTH = 1024; // we assume that analyzed term, together with docid/offset info, will never exceed such length
@@ -71,9 +74,10 @@ MemoryIndexer::MemoryIndexer(const String &index_dir,
                              const String &analyzer,
                              MemoryPool &byte_slice_pool,
                              RecyclePool &buffer_pool,
-                             ThreadPool &thread_pool)
+                             ThreadPool &thread_pool,
+                             SizeT memory_budget)
     : index_dir_(index_dir), base_name_(base_name), base_row_id_(base_row_id), flag_(flag), analyzer_(analyzer), byte_slice_pool_(byte_slice_pool),
-      buffer_pool_(buffer_pool), thread_pool_(thread_pool), ring_inverted_(10UL), ring_sorted_(10UL) {
+      buffer_pool_(buffer_pool), thread_pool_(thread_pool), ring_inverted_(10UL), ring_sorted_(10UL), memory_budget_(memory_budget) {
     posting_table_ = MakeShared<PostingTable>();
     prepared_posting_ = MakeShared<PostingWriter>(nullptr, nullptr, PostingFormatOption(flag_), column_length_mutex_, column_length_array_);
     Path path = Path(index_dir) / "tmp.merge";
@@ -96,6 +100,16 @@ void MemoryIndexer::Insert(SharedPtr<ColumnVector> column_vector,
     if (is_spilled_)
         Load();
 
+    if (offline) {
+        // Back pressure: help spilling in caller's thread until the sorted inverters fit in the memory budget again.
+        while (GetOfflineMemUsage() >= memory_budget_) {
+            if (CommitOffline() == 0) {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait_for(lock, std::chrono::milliseconds(10));
+            }
+        }
+    }
+
     u64 seq_inserted(0);
     u32 doc_count(0);
     {
@@ -117,6 +131,11 @@ void MemoryIndexer::Insert(SharedPtr<ColumnVector> column_vector,
             inverter->GetTermListLength(length_handler->GetColumnLengthArray());
             length_handler->DumpToFile();
             inverter->SortForOfflineDump();
+            SizeT mem_usage = inverter->MemUsage();
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                offline_mem_usage_ += mem_usage;
+            }
             this->ring_sorted_.Put(task->task_seq_, inverter);
         };
         thread_pool_.push(std::move(func));
@@ -158,11 +177,14 @@ SizeT MemoryIndexer::CommitOffline(bool wait_if_empty) {
     Vector<SharedPtr<ColumnInverter>> inverters;
     this->ring_sorted_.GetBatch(inverters, wait_if_empty);
     SizeT num = inverters.size();
-    if (num > 0) {
-        for (auto &inverter : inverters) {
-            inverter->SpillSortResults(this->spill_file_handle_, this->tuple_count_);
-            num_runs_++;
-        }
+    for (auto &inverter : inverters) {
+        pending_mem_usage_ += inverter->MemUsage();
+        pending_inverters_.push_back(std::move(inverter));
+    }
+    // Collecting inverters up to half of the budget yields runs much larger than a single block, hence far fewer runs to merge.
+    // The other half is left for the inverters being sorted meanwhile.
+    if (pending_mem_usage_ * 2 >= memory_budget_) {
+        SpillPendingInverters();
     }
     generating_.compare_exchange_strong(generating, false);
     if (num > 0) {
@@ -175,6 +197,23 @@ SizeT MemoryIndexer::CommitOffline(bool wait_if_empty) {
     return num;
 }
 
+void MemoryIndexer::SpillPendingInverters() {
+    if (pending_inverters_.empty())
+        return;
+    if (nullptr == spill_file_handle_) {
+        PrepareSpillFile();
+    }
+    ColumnInverter::SpillSortResults(this->spill_file_handle_, this->tuple_count_, pending_inverters_);
+    num_runs_++;
+    pending_inverters_.clear();
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        offline_mem_usage_ -= pending_mem_usage_;
+        cv_.notify_all();
+    }
+    pending_mem_usage_ = 0;
+}
+
 SizeT MemoryIndexer::CommitSync() {
     Vector<SharedPtr<ColumnInverter>> inverters;
     u64 seq_commit = this->ring_inverted_.GetBatch(inverters);
@@ -212,6 +251,14 @@ void MemoryIndexer::Dump(bool offline, bool spill) {
         while (GetInflightTasks() > 0) {
             CommitOffline(true);
         }
+        // A queued Commit may still hold generating_ for an empty batch.
+        bool generating = false;
+        while (!generating_.compare_exchange_weak(generating, true)) {
+            generating = false;
+            std::this_thread::yield();
+        }
+        SpillPendingInverters();
+        generating_.store(false);
         OfflineDump();
         return;
     }
@@ -259,6 +306,10 @@ void MemoryIndexer::Dump(bool offline, bool spill) {
         fs.AppendFile(dict_file, fst_file);
         fs.DeleteFile(fst_file);
     }
+    if (!spill) {
+        std::shared_lock lock(column_length_mutex_);
+        WriteColumnNormFile(fs, index_prefix + NORM_SUFFIX, column_length_array_);
+    }
     is_spilled_ = spill;
     Reset();
     // LOG_INFO("MemoryIndexer::Dump end");
@@ -311,15 +362,16 @@ void MemoryIndexer::OfflineDump() {
     // 1. External sort merge
     // 2. Generate posting
     // 3. Dump disk segment data
+    // Step 2 and 3 consume the output of the merge threads directly, so that the merged tuples are never written back to disk,
+    // and posting generation overlaps with merging.
     // LOG_INFO(fmt::format("MemoryIndexer::OfflineDump begin, num_runs_ {}", num_runs_));
     FinalSpillFile();
-    constexpr u32 buffer_size_of_each_run = 2 * 1024 * 1024;
-    SortMerger<TermTuple, u32> *merger = new SortMerger<TermTuple, u32>(spill_full_path_.c_str(), num_runs_, buffer_size_of_each_run * num_runs_, 2);
-    merger->Run();
-    delete merger;
-    FILE *f = fopen(spill_full_path_.c_str(), "r");
-    u64 count;
-    fread((char *)&count, sizeof(u64), 1, f);
+    constexpr SizeT max_buffer_size_of_each_run = 2 * 1024 * 1024;
+    u32 num_runs = std::max(num_runs_, 1U);
+    SizeT buffer_size_of_each_run = std::clamp(memory_budget_ / num_runs, MIN_FULL_TEXT_MERGE_BUFFER_PER_RUN, max_buffer_size_of_each_run);
+    u32 buffer_size = std::min<SizeT>(buffer_size_of_each_run * num_runs, std::numeric_limits<u32>::max());
+    SortMerger<TermTuple, u32> *merger = new SortMerger<TermTuple, u32>(spill_full_path_.c_str(), num_runs_, buffer_size, 2);
+
     Path path = Path(index_dir_) / base_name_;
     String index_prefix = path.string();
     LocalFileSystem fs;
@@ -333,68 +385,72 @@ void MemoryIndexer::OfflineDump() {
     OstreamWriter wtr(ofs);
     FstBuilder fst_builder(wtr);
 
-    u32 record_length;
-    char buf[MAX_TUPLE_LENGTH];
     String last_term_str;
     std::string_view last_term;
     u32 last_doc_id = INVALID_DOCID;
     UniquePtr<PostingWriter> posting;
 
-    for (u64 i = 0; i < count; ++i) {
-        fread(&record_length, sizeof(u32), 1, f);
-        if (record_length >= MAX_TUPLE_LENGTH) {
-            // rubbish tuple, abandoned
-            char *buffer = new char[record_length];
-            fread(buffer, record_length, 1, f);
-            // TermTuple tuple(buffer, record_length);
-            delete[] buffer;
-            continue;
-        }
-        fread(buf, record_length, 1, f);
-        TermTuple tuple(buf, record_length);
-        if (tuple.term_ != last_term) {
-            assert(last_term < tuple.term_);
-            if (last_doc_id != INVALID_DOCID) {
-                posting->EndDocument(last_doc_id, 0);
-                // printf(" EndDocument1-%u\n", last_doc_id);
+    auto dump_term = [&]() {
+        TermMeta term_meta(posting->GetDF(), posting->GetTotalTF());
+        posting->Dump(posting_file_writer, term_meta);
+        SizeT term_meta_offset = dict_file_writer->TotalWrittenBytes();
+        term_meta_dumpler.Dump(dict_file_writer, term_meta);
+        fst_builder.Insert((u8 *)last_term.data(), last_term.length(), term_meta_offset);
+    };
+
+    merger->Run([&](char *data, u32 size) {
+        u32 record_length;
+        for (u32 pos = 0; pos < size; pos += sizeof(u32) + record_length) {
+            record_length = *(u32 *)(data + pos);
+            if (record_length >= MAX_TUPLE_LENGTH) {
+                // rubbish tuple, abandoned
+                continue;
             }
-            if (posting.get()) {
-                TermMeta term_meta(posting->GetDF(), posting->GetTotalTF());
-                posting->Dump(posting_file_writer, term_meta);
-                SizeT term_meta_offset = dict_file_writer->TotalWrittenBytes();
-                term_meta_dumpler.Dump(dict_file_writer, term_meta);
-                fst_builder.Insert((u8 *)last_term.data(), last_term.length(), term_meta_offset);
+            TermTuple tuple(data + pos + sizeof(u32), record_length);
+            if (tuple.term_ != last_term) {
+                assert(last_term < tuple.term_);
+                if (last_doc_id != INVALID_DOCID) {
+                    posting->EndDocument(last_doc_id, 0);
+                    // printf(" EndDocument1-%u\n", last_doc_id);
+                }
+                if (posting.get()) {
+                    dump_term();
+                }
+                posting = MakeUnique<PostingWriter>(&byte_slice_pool_,
+                                                    &buffer_pool_,
+                                                    PostingFormatOption(flag_),
+                                                    column_length_mutex_,
+                                                    column_length_array_);
+                // printf("\nswitched-term-%d-<%s>\n", i.term_num_, term.data());
+                last_term_str = String(tuple.term_);
+                last_term = std::string_view(last_term_str);
+            } else if (last_doc_id != tuple.doc_id_) {
+                assert(last_doc_id != INVALID_DOCID);
+                assert(last_doc_id < tuple.doc_id_);
+                assert(posting.get() != nullptr);
+                posting->EndDocument(last_doc_id, 0);
+                // printf(" EndDocument2-%u\n", last_doc_id);
             }
-            posting =
-                MakeUnique<PostingWriter>(&byte_slice_pool_, &buffer_pool_, PostingFormatOption(flag_), column_length_mutex_, column_length_array_);
-            // printf("\nswitched-term-%d-<%s>\n", i.term_num_, term.data());
-            last_term_str = String(tuple.term_);
-            last_term = std::string_view(last_term_str);
-        } else if (last_doc_id != tuple.doc_id_) {
-            assert(last_doc_id != INVALID_DOCID);
-            assert(last_doc_id < tuple.doc_id_);
-            assert(posting.get() != nullptr);
-            posting->EndDocument(last_doc_id, 0);
-            // printf(" EndDocument2-%u\n", last_doc_id);
+            last_doc_id = tuple.doc_id_;
+            posting->AddPosition(tuple.term_pos_);
+            // printf(" pos-%u", tuple.term_pos_);
         }
-        last_doc_id = tuple.doc_id_;
-        posting->AddPosition(tuple.term_pos_);
-        // printf(" pos-%u", tuple.term_pos_);
-    }
+    });
+    delete merger;
     if (last_doc_id != INVALID_DOCID) {
         posting->EndDocument(last_doc_id, 0);
         // printf(" EndDocument3-%u\n", last_doc_id);
-        TermMeta term_meta(posting->GetDF(), posting->GetTotalTF());
-        posting->Dump(posting_file_writer, term_meta);
-        SizeT term_meta_offset = dict_file_writer->TotalWrittenBytes();
-        term_meta_dumpler.Dump(dict_file_writer, term_meta);
-        fst_builder.Insert((u8 *)last_term.data(), last_term.length(), term_meta_offset);
+        dump_term();
     }
     posting_file_writer->Sync();
     dict_file_writer->Sync();
     fst_builder.Finish();
     fs.AppendFile(dict_file, fst_file);
     fs.DeleteFile(fst_file);
+    {
+        std::shared_lock lock(column_length_mutex_);
+        WriteColumnNormFile(fs, index_prefix + NORM_SUFFIX, column_length_array_);
+    }
 
     // LOG_INFO(fmt::format("MemoryIndexer::OfflineDump done, num_runs_ {}", num_runs_));
     num_runs_ = 0;
@@ -402,6 +458,9 @@ void MemoryIndexer::OfflineDump() {
 }
 
 void MemoryIndexer::FinalSpillFile() {
+    if (nullptr == spill_file_handle_) {
+        PrepareSpillFile();
+    }
     fseek(spill_file_handle_, 0, SEEK_SET);
     fwrite(&tuple_count_, sizeof(u64), 1, spill_file_handle_);
     fclose(spill_file_handle_);
@@ -29,6 +29,7 @@ import ring;
 import skiplist;
 import internal_types;
 import map_with_lock;
+import default_values;
 
 namespace infinity {
 
@@ -58,11 +59,13 @@ public:
                   const String &analyzer,
                   MemoryPool &byte_slice_pool,
                   RecyclePool &buffer_pool,
-                  ThreadPool &thread_pool);
+                  ThreadPool &thread_pool,
+                  SizeT memory_budget = DEFAULT_FULL_TEXT_BUILD_MEMORY_BUDGET);
 
     ~MemoryIndexer();
 
     // Insert is non-blocking. Caller must ensure there's no RowID gap between each call.
+    // For offline case, Insert blocks while the sorted but not yet spilled inverters exceed the memory budget.
     void Insert(SharedPtr<ColumnVector> column_vector,
                 u32 row_offset,
                 u32 row_count,
@@ -93,6 +96,8 @@ public:
 
     u32 GetDocCount() const { return doc_count_; }
 
+    SizeT GetMemoryBudget() const { return memory_budget_; }
+
     MemoryPool *GetPool() { return &byte_slice_pool_; }
 
     SharedPtr<PostingTable> GetPostingTable() { return posting_table_; }
@@ -107,9 +112,18 @@ private:
         cv_.wait(lock, [this] { return inflight_tasks_ == 0; });
     }
 
-    // CommitOffline is for offline case. It spill a batch of ColumnInverter. Returns the size of the batch.
+    // CommitOffline is for offline case. It collects a batch of sorted ColumnInverter, and spills the collected ones as a single run once
+    // they reach half of the memory budget. Returns the size of the batch.
     SizeT CommitOffline(bool wait_if_empty = false);
 
+    // Spill the collected inverters as one run. Caller must own generating_.
+    void SpillPendingInverters();
+
+    SizeT GetOfflineMemUsage() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return offline_mem_usage_;
+    }
+
     void OfflineDump();
 
     void FinalSpillFile();
@@ -137,10 +151,14 @@ private:
     std::condition_variable cv_;
     std::mutex mutex_;
 
-    u32 num_runs_{0};                  // For offline index building
-    FILE *spill_file_handle_{nullptr}; // Temp file for offline external merge sort
-    String spill_full_path_;           // Path of spill file
-    u64 tuple_count_{0};               // Number of tuples for external merge sort
+    SizeT memory_budget_{0};                              // For offline index building, upper bound of sorted inverters held in memory
+    SizeT offline_mem_usage_{0};                          // Memory of inverters which are sorted but not spilled yet
+    Vector<SharedPtr<ColumnInverter>> pending_inverters_; // Sorted inverters collected for the next run
+    SizeT pending_mem_usage_{0};                          // Memory of pending_inverters_
+    u32 num_runs_{0};                                     // For offline index building
+    FILE *spill_file_handle_{nullptr};                    // Temp file for offline external merge sort
+    String spill_full_path_;                              // Path of spill file
+    u64 tuple_count_{0};                                  // Number of tuples for external merge sort
 
     bool is_spilled_{false};
 
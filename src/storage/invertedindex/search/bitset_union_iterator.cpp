@@ -0,0 +1,84 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+module bitset_union_iterator;
+
+import stl;
+import index_defines;
+import doc_iterator;
+import posting_iterator;
+import internal_types;
+
+namespace infinity {
+
+BitsetUnionIterator::BitsetUnionIterator(Vector<UniquePtr<PostingIterator>> iterators) {
+    for (auto &iter : iterators) {
+        for (RowID doc_id = iter->SeekDoc(RowID(0, 0)); doc_id != INVALID_ROWID; doc_id = iter->SeekDoc(doc_id + 1)) {
+            Vector<u64> &words = GetSegmentBitmap(doc_id.segment_id_).words_;
+            SizeT word_idx = doc_id.segment_offset_ / 64;
+            if (word_idx >= words.size()) {
+                words.resize(std::max(word_idx + 1, words.size() * 2), 0);
+            }
+            words[word_idx] |= u64(1) << (doc_id.segment_offset_ % 64);
+        }
+    }
+    for (const auto &segment : segments_) {
+        for (u64 word : segment.words_) {
+            doc_freq_ += __builtin_popcountll(word);
+        }
+    }
+    DoSeek(RowID(0, 0));
+}
+
+BitsetUnionIterator::SegmentBitmap &BitsetUnionIterator::GetSegmentBitmap(SegmentID segment_id) {
+    // postings are visited per term, each in segment order, so the segment is usually the last one or close to it
+    auto it = std::lower_bound(segments_.begin(), segments_.end(), segment_id, [](const SegmentBitmap &segment, SegmentID id) {
+        return segment.segment_id_ < id;
+    });
+    if (it == segments_.end() || it->segment_id_ != segment_id) {
+        it = segments_.insert(it, SegmentBitmap{segment_id, {}});
+    }
+    return *it;
+}
+
+void BitsetUnionIterator::DoSeek(RowID doc_id) {
+    // segments before cursor_ are exhausted or behind a previous target
+    while (cursor_ < segments_.size()) {
+        const SegmentBitmap &segment = segments_[cursor_];
+        if (segment.segment_id_ >= doc_id.segment_id_) {
+            SegmentOffset offset = segment.segment_id_ == doc_id.segment_id_ ? doc_id.segment_offset_ : 0;
+            SizeT word_idx = offset / 64;
+            if (word_idx < segment.words_.size()) {
+                // mask off the bits below offset in the first word
+                u64 word = segment.words_[word_idx] & (~u64(0) << (offset % 64));
+                while (true) {
+                    if (word != 0) {
+                        doc_id_ = RowID(segment.segment_id_, word_idx * 64 + __builtin_ctzll(word));
+                        return;
+                    }
+                    if (++word_idx == segment.words_.size()) {
+                        break;
+                    }
+                    word = segment.words_[word_idx];
+                }
+            }
+        }
+        ++cursor_;
+    }
+    doc_id_ = INVALID_ROWID;
+}
+
+} // namespace infinity
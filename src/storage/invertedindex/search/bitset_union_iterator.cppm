@@ -0,0 +1,55 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+export module bitset_union_iterator;
+
+import stl;
+import index_defines;
+import doc_iterator;
+import posting_iterator;
+import internal_types;
+
+namespace infinity {
+
+// Union of the postings of many terms, e.g. all terms expanded from "foo*".
+// The postings are drained once into one bitmap per segment, so the union
+// costs O(total postings) instead of O(total postings * log(terms)) with an
+// OrIterator heap, and seeking is a scan over the bitmap words.
+// The term frequencies are lost, so Scorer scores the union as one term.
+export class BitsetUnionIterator final : public DocIterator {
+public:
+    explicit BitsetUnionIterator(Vector<UniquePtr<PostingIterator>> iterators);
+
+    ~BitsetUnionIterator() override = default;
+
+    void DoSeek(RowID doc_id) override;
+
+    u32 GetDF() const override { return doc_freq_; }
+
+private:
+    struct SegmentBitmap {
+        SegmentID segment_id_;
+        Vector<u64> words_;
+    };
+
+    SegmentBitmap &GetSegmentBitmap(SegmentID segment_id);
+
+    Vector<SegmentBitmap> segments_; // ordered by segment_id_
+    SizeT cursor_{0};
+    u32 doc_freq_{0};
+};
+
+} // namespace infinity
@@ -22,15 +22,10 @@ import stl;
 
 namespace infinity {
 
-constexpr float k1 = 1.2F;
-constexpr float b = 0.75F;
-
-BM25Ranker::BM25Ranker(u64 total_df) : total_df_(std::max(total_df, 1UL)) {}
-
-void BM25Ranker::AddTermParam(u64 tf, u64 df, float avg_column_len, u32 column_len, float weight) {
-    float smooth_idf = std::log(1.0F + (total_df_ - df + 0.5F) / (df + 0.5F));
-    float smooth_tf = (k1 + 1.0F) * tf / (tf + k1 * (1.0F - b + b * column_len / avg_column_len));
-    score_ += smooth_idf * smooth_tf * weight;
+float BM25Ranker::TermWeight(u64 total_df, u64 df, float weight) {
+    total_df = std::max(total_df, df);
+    float smooth_idf = std::log(1.0F + (total_df - df + 0.5F) / (df + 0.5F));
+    return smooth_idf * weight * (k1 + 1.0F);
 }
 
 } // namespace infinity
@@ -19,17 +19,19 @@ export module bm25_ranker;
 import stl;
 
 namespace infinity {
+// BM25 split into the factors constant per query, so that scoring a doc is
+// term_weight * tf / (tf + norm_factor), see Scorer
 export class BM25Ranker {
 public:
-    BM25Ranker(u64 total_df);
-    ~BM25Ranker() = default;
+    static constexpr float k1 = 1.2F;
+    static constexpr float b = 0.75F;
 
-    void AddTermParam(u64 tf, u64 df, float avg_column_len, u32 column_len, float weight);
+    // idf * weight * (k1 + 1)
+    static float TermWeight(u64 total_df, u64 df, float weight);
 
-    float GetScore() { return score_; }
+    // k1 * (1 - b + b * column_len / avg_column_len)
+    static float NormFactor(u32 column_len, float avg_column_len) { return k1 * (1.0F - b + b * column_len / avg_column_len); }
 
-private:
-    float score_{0};
-    u64 total_df_{0};
+    static float Score(float term_weight, float tf, float norm_factor) { return term_weight * tf / (tf + norm_factor); }
 };
 } // namespace infinity
\ No newline at end of file
@@ -14,6 +14,8 @@
 
 module;
 
+#include <algorithm>
+#include <cmath>
 #include <string>
 #include <vector>
 module column_length_io;
@@ -27,6 +29,8 @@ import column_index_reader;
 import file_system_type;
 import file_system;
 import local_file_system;
+import third_party;
+import mmap;
 
 namespace infinity {
 
@@ -87,49 +91,146 @@ void FullTextColumnLengthUpdateJob::DumpToFile() {
     column_length_array_.reset();
 }
 
-FullTextColumnLengthReader::FullTextColumnLengthReader(UniquePtr<FileSystem> file_system,
-                                                       const String &index_dir,
-                                                       const Vector<String> &base_names,
-                                                       const Vector<RowID> &base_row_ids)
-    : file_system_(std::move(file_system)), index_dir_(index_dir), base_names_(base_names), base_row_ids_(base_row_ids) {}
+namespace {
 
-void FullTextColumnLengthReader::SeekFile(RowID row_id) {
-    while (base_row_ids_[next_base_rowid_index_] <= row_id) {
-        ++next_base_rowid_index_;
+// Lengths below NUM_FREE_VALUES are encoded as is, the others as a small float with a 3 bit mantissa.
+constexpr u32 NUM_FREE_VALUES = 24;
+
+u32 LongToInt4(u32 i) {
+    u32 num_bits = 32 - __builtin_clz(i | 1);
+    if (num_bits < 4) {
+        return i;
     }
-    current_base_rowid_ = base_row_ids_[next_base_rowid_index_ - 1];
-    next_base_rowid_ = base_row_ids_[next_base_rowid_index_];
-    // load file
-    Path column_length_file_base = Path(index_dir_) / base_names_[next_base_rowid_index_ - 1];
-    String column_length_file_path_prefix = column_length_file_base.string();
-    String column_length_file_path = column_length_file_path_prefix + LENGTH_SUFFIX;
-    UniquePtr<FileHandler> file_handler = file_system_->OpenFile(column_length_file_path, FileFlags::READ_FLAG, FileLockType::kNoLock);
-    const u32 file_size = file_system_->GetFileSize(*file_handler);
-    if (u32 array_len = file_size / sizeof(u32); array_len > column_length_array_capacity_) {
-        column_length_array_capacity_ = std::max(array_len, std::min<u32>(2 * array_len, 1024 * 8192));
-        column_length_array_ = MakeUniqueForOverwrite<u32[]>(column_length_array_capacity_);
+    u32 shift = num_bits - 4;
+    return ((i >> shift) & 0x07) | ((shift + 1) << 3);
+}
+
+u32 Int4ToLong(u32 i) {
+    u32 bits = i & 0x07;
+    u32 shift = i >> 3;
+    return shift == 0 ? bits : (bits | 0x08) << (shift - 1);
+}
+
+const Array<u32, 256> &ColumnLengthDecodeTable() {
+    static const Array<u32, 256> table = [] {
+        Array<u32, 256> t{};
+        for (u32 i = 0; i < 256; ++i) {
+            t[i] = i < NUM_FREE_VALUES ? i : NUM_FREE_VALUES + Int4ToLong(i - NUM_FREE_VALUES);
+        }
+        return t;
+    }();
+    return table;
+}
+
+void ReadColumnLengthFile(FileSystem &file_system, const String &path, Vector<u32> &column_lengths) {
+    column_lengths.clear();
+    if (!file_system.Exists(path)) {
+        return;
     }
-    const i64 read_count = file_system_->Read(*file_handler, column_length_array_.get(), file_size);
+    UniquePtr<FileHandler> file_handler = file_system.OpenFile(path, FileFlags::READ_FLAG, FileLockType::kNoLock);
+    const SizeT file_size = file_system.GetFileSize(*file_handler);
+    column_lengths.resize(file_size / sizeof(u32));
+    const i64 read_count = file_system.Read(*file_handler, column_lengths.data(), column_lengths.size() * sizeof(u32));
     file_handler->Close();
-    if (read_count != file_size) {
-        UnrecoverableError("SeekFile: read_count != file_size");
+    if (read_count != i64(column_lengths.size() * sizeof(u32))) {
+        UnrecoverableError(fmt::format("ReadColumnLengthFile: failed to read {}", path));
+    }
+}
+
+// A norm file holds one byte per u32 of the length file. A crash between writing the two leaves a stale norm file, it is ignored.
+bool NormFileMatches(FileSystem &file_system, const String &len_path, const String &norm_path) {
+    if (!file_system.Exists(norm_path) || !file_system.Exists(len_path)) {
+        return false;
+    }
+    UniquePtr<FileHandler> norm_file_handler = file_system.OpenFile(norm_path, FileFlags::READ_FLAG, FileLockType::kNoLock);
+    const SizeT norm_file_size = file_system.GetFileSize(*norm_file_handler);
+    norm_file_handler->Close();
+    UniquePtr<FileHandler> len_file_handler = file_system.OpenFile(len_path, FileFlags::READ_FLAG, FileLockType::kNoLock);
+    const SizeT len_file_size = file_system.GetFileSize(*len_file_handler);
+    len_file_handler->Close();
+    return norm_file_size * sizeof(u32) == len_file_size;
+}
+
+} // namespace
+
+u8 EncodeColumnLength(u32 column_length) {
+    // clamp so that the encoding fits in a byte
+    column_length = std::min<u32>(column_length, std::numeric_limits<i32>::max());
+    if (column_length < NUM_FREE_VALUES) {
+        return column_length;
+    }
+    return NUM_FREE_VALUES + LongToInt4(column_length - NUM_FREE_VALUES);
+}
+
+u32 DecodeColumnLength(u8 norm) { return ColumnLengthDecodeTable()[norm]; }
+
+void WriteColumnNormFile(FileSystem &file_system, const String &norm_path, const Vector<u32> &column_lengths) {
+    Vector<u8> norms(column_lengths.size());
+    for (SizeT i = 0; i < column_lengths.size(); ++i) {
+        norms[i] = EncodeColumnLength(column_lengths[i]);
+    }
+    // written under another name and renamed, so that a reader never maps a partial file
+    String tmp_path = norm_path + ".tmp";
+    {
+        u8 file_flags = FileFlags::WRITE_FLAG | FileFlags::TRUNCATE_CREATE;
+        UniquePtr<FileHandler> file_handler = file_system.OpenFile(tmp_path, file_flags, FileLockType::kNoLock);
+        const i64 write_count = file_system.Write(*file_handler, norms.data(), norms.size());
+        if (write_count != i64(norms.size())) {
+            UnrecoverableError(fmt::format("WriteColumnNormFile: failed to write {}", tmp_path));
+        }
+        file_handler->Sync();
+        file_handler->Close();
+    }
+    file_system.Rename(tmp_path, norm_path);
+}
+
+FullTextColumnNorms::FullTextColumnNorms(const String &index_dir,
+                                         const Vector<String> &base_names,
+                                         const Vector<RowID> &base_row_ids,
+                                         const Vector<bool> &chunk_in_memory,
+                                         float avg_column_length)
+    : default_norm_(EncodeColumnLength(std::lround(avg_column_length))) {
+    LocalFileSystem fs;
+    chunks_.reserve(base_names.size());
+    for (SizeT i = 0; i < base_names.size(); ++i) {
+        Chunk &chunk = chunks_.emplace_back();
+        chunk.base_row_id_ = base_row_ids[i];
+        String path_prefix = (Path(index_dir) / base_names[i]).string();
+        String len_path = path_prefix + LENGTH_SUFFIX;
+        String norm_path = path_prefix + NORM_SUFFIX;
+        // a chunk on disk has a norm file written when it was dumped or merged
+        if (!chunk_in_memory[i] && NormFileMatches(fs, len_path, norm_path)) {
+            // an empty file can't be mapped, it holds no norm anyway
+            if (MmapFile(norm_path, chunk.mmap_ptr_, chunk.mmap_len_) == 0) {
+                chunk.norms_ = chunk.mmap_ptr_;
+                chunk.count_ = chunk.mmap_len_;
+            }
+            continue;
+        }
+        // the chunk of a memory indexer, or a chunk dumped without a norm file, e.g. by an older version
+        Vector<u32> column_lengths;
+        ReadColumnLengthFile(fs, len_path, column_lengths);
+        chunk.heap_norms_.resize(column_lengths.size());
+        for (SizeT j = 0; j < column_lengths.size(); ++j) {
+            chunk.heap_norms_[j] = EncodeColumnLength(column_lengths[j]);
+        }
+        chunk.norms_ = chunk.heap_norms_.data();
+        chunk.count_ = chunk.heap_norms_.size();
+    }
+}
+
+FullTextColumnNorms::~FullTextColumnNorms() {
+    for (Chunk &chunk : chunks_) {
+        MunmapFile(chunk.mmap_ptr_, chunk.mmap_len_);
     }
 }
 
-void ColumnLengthReader::LoadColumnLength(RowID first_doc_id,
-                                          IndexReader &index_reader,
-                                          const Vector<u64> &column_ids,
-                                          Vector<float> &avg_column_length) {
-    column_length_vector_.clear();
-    column_length_vector_.reserve(column_ids.size());
-    avg_column_length.resize(column_ids.size());
-    for (u32 i = 0; i < column_ids.size(); i++) {
-        u64 column_id = column_ids[i];
-        ColumnIndexReader *reader = index_reader.GetColumnIndexReader(column_id);
-        column_length_vector_.emplace_back(MakeUnique<LocalFileSystem>(), reader->index_dir_, reader->base_names_, reader->base_row_ids_);
-        column_length_vector_.back().SeekFile(first_doc_id);
-        avg_column_length[i] = reader->GetAvgColumnLength();
+SizeT FullTextColumnNorms::SeekChunk(RowID row_id) const {
+    auto it = std::upper_bound(chunks_.begin(), chunks_.end(), row_id, [](RowID id, const Chunk &chunk) { return id < chunk.base_row_id_; });
+    if (it == chunks_.begin()) {
+        return chunks_.size();
     }
+    return std::distance(chunks_.begin(), it) - 1;
 }
 
 } // namespace infinity
\ No newline at end of file
@@ -22,7 +22,6 @@ import internal_types;
 
 namespace infinity {
 class SegmentIndexEntry;
-class IndexReader;
 class FileSystem;
 class FileHandler;
 
@@ -60,42 +59,57 @@ private:
     Vector<u32> &memory_indexer_array_;
 };
 
-export class FullTextColumnLengthReader {
-public:
-    FullTextColumnLengthReader(UniquePtr<FileSystem> file_system,
-                               const String &index_dir,
-                               const Vector<String> &base_names,
-                               const Vector<RowID> &base_row_ids);
-
-    inline u32 GetColumnLength(RowID row_id) {
-        // assume that there is a file which contains row_id
-        if (row_id >= next_base_rowid_) [[unlikely]] {
-            SeekFile(row_id);
-        }
-        return column_length_array_[row_id - current_base_rowid_];
-    }
+// Column lengths are quantized into one byte for scoring: lengths below 24 are exact,
+// larger ones keep their 4 most significant bits, i.e. the relative error is below 1/8.
+export u8 EncodeColumnLength(u32 column_length);
 
-    void SeekFile(RowID row_id);
+export u32 DecodeColumnLength(u8 norm);
 
-private:
-    UniquePtr<FileSystem> file_system_;
-    const String &index_dir_;
-    const Vector<String> &base_names_;
-    const Vector<RowID> &base_row_ids_; // must in ascending order, have an INVALID_ROWID at the end
-    RowID current_base_rowid_ = INVALID_ROWID;
-    RowID next_base_rowid_ = INVALID_ROWID;
-    u32 next_base_rowid_index_ = 1;
-    UniquePtr<u32[]> column_length_array_;
-    u32 column_length_array_capacity_ = 0;
-};
-
-export class ColumnLengthReader {
-    Vector<FullTextColumnLengthReader> column_length_vector_;
+// Writes the quantized column lengths of a chunk dumped or merged to disk, FullTextColumnNorms maps the file on later loads.
+export void WriteColumnNormFile(FileSystem &file_system, const String &norm_path, const Vector<u32> &column_lengths);
 
+// Quantized column lengths of all chunks of a full-text column index, in row id order.
+// The norms of a chunk on disk are mapped from the norm file written with the chunk.
+// The norms of the chunk of a memory indexer are derived on each load, since the chunk is still growing.
+export class FullTextColumnNorms {
 public:
-    void LoadColumnLength(RowID first_doc_id, IndexReader &index_reader, const Vector<u64> &column_ids, Vector<float> &avg_column_length);
+    FullTextColumnNorms(const String &index_dir,
+                        const Vector<String> &base_names,
+                        const Vector<RowID> &base_row_ids,
+                        const Vector<bool> &chunk_in_memory,
+                        float avg_column_length);
+
+    ~FullTextColumnNorms();
+
+    // chunk_idx is a cursor kept by the caller, it is cheapest to look up row ids in ascending order
+    inline u8 GetNorm(RowID row_id, SizeT &chunk_idx) const {
+        if (chunk_idx >= chunks_.size() || row_id < chunks_[chunk_idx].base_row_id_ ||
+            (chunk_idx + 1 < chunks_.size() && row_id >= chunks_[chunk_idx + 1].base_row_id_)) [[unlikely]] {
+            chunk_idx = SeekChunk(row_id);
+            if (chunk_idx >= chunks_.size()) {
+                return default_norm_;
+            }
+        }
+        const Chunk &chunk = chunks_[chunk_idx];
+        u32 offset = row_id - chunk.base_row_id_;
+        // the length of a doc just inserted may not be written yet
+        return offset < chunk.count_ ? chunk.norms_[offset] : default_norm_;
+    }
 
-    inline u32 GetColumnLength(u32 scorer_column_idx, RowID row_id) { return column_length_vector_[scorer_column_idx].GetColumnLength(row_id); }
+private:
+    struct Chunk {
+        RowID base_row_id_;
+        const u8 *norms_{nullptr};
+        u32 count_{0};
+        u8 *mmap_ptr_{nullptr};
+        SizeT mmap_len_{0};
+        Vector<u8> heap_norms_;
+    };
+
+    SizeT SeekChunk(RowID row_id) const;
+
+    Vector<Chunk> chunks_;
+    u8 default_norm_;
 };
 
 } // namespace infinity
\ No newline at end of file
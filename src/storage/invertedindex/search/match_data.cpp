@@ -22,6 +22,7 @@ import index_defines;
 import bm25_ranker;
 import internal_types;
 import column_index_reader;
+import column_length_io;
 
 namespace infinity {
 
@@ -37,30 +38,98 @@ u32 Scorer::GetOrSetColumnIndex(u64 column_id) {
 
 void Scorer::AddDocIterator(TermDocIterator *iter, u64 column_id) {
     u32 column_index = GetOrSetColumnIndex(column_id);
-    iterators_.resize(column_index + 1);
-    iterators_[column_index].push_back(iter);
+    columns_.resize(column_counter_);
+    columns_[column_index].iterators_.push_back(iter);
+}
+
+void Scorer::AddUnionDocIterator(DocIterator *iter, u64 column_id, float weight) {
+    u32 column_index = GetOrSetColumnIndex(column_id);
+    columns_.resize(column_counter_);
+    columns_[column_index].union_iterators_.push_back(iter);
+    columns_[column_index].union_weights_.push_back(weight);
 }
 
 void Scorer::LoadColumnLength(RowID first_doc_id, IndexReader &index_reader) {
-    column_length_reader_.LoadColumnLength(first_doc_id, index_reader, column_ids_, avg_column_length_);
+    for (u32 i = 0; i < column_counter_; i++) {
+        ColumnScorer &column = columns_[i];
+        ColumnIndexReader *reader = index_reader.GetColumnIndexReader(column_ids_[i]);
+        float avg_column_length = reader->GetAvgColumnLength();
+        column.norms_ = reader->GetColumnNorms();
+        column.chunk_cursor_ = 0;
+        column.norms_->GetNorm(first_doc_id, column.chunk_cursor_);
+        for (u32 norm = 0; norm < 256; norm++) {
+            column.norm_factors_[norm] = BM25Ranker::NormFactor(DecodeColumnLength(norm), avg_column_length);
+        }
+        column.term_weights_.clear();
+        for (TermDocIterator *iter : column.iterators_) {
+            column.term_weights_.push_back(BM25Ranker::TermWeight(total_df_, iter->GetDF(), iter->GetWeight()));
+        }
+        for (u32 j = 0; j < column.union_iterators_.size(); j++) {
+            column.term_weights_.push_back(BM25Ranker::TermWeight(total_df_, column.union_iterators_[j]->GetDF(), column.union_weights_[j]));
+        }
+        column.batch_tfs_.assign(column.term_weights_.size() * BATCH_SIZE, 0.0F);
+    }
+    batch_size_ = 0;
 }
 
 float Scorer::Score(RowID doc_id) {
     float score = 0.0F;
+    TermColumnMatchData column_match_data;
     for (u32 i = 0; i < column_counter_; i++) {
-        BM25Ranker ranker(total_df_);
-        float avg_column_length = avg_column_length_[i];
-        u32 column_len = column_length_reader_.GetColumnLength(i, doc_id);
-        Vector<TermDocIterator *> &column_iters = iterators_[i];
-        TermColumnMatchData column_match_data;
-        for (u32 j = 0; j < column_iters.size(); j++) {
-            if (column_iters[j]->GetTermMatchData(column_match_data, doc_id)) {
-                ranker.AddTermParam(column_match_data.tf_, column_iters[j]->GetDF(), avg_column_length, column_len, column_iters[j]->GetWeight());
+        ColumnScorer &column = columns_[i];
+        float norm_factor = column.norm_factors_[column.norms_->GetNorm(doc_id, column.chunk_cursor_)];
+        for (u32 j = 0; j < column.iterators_.size(); j++) {
+            if (column.iterators_[j]->GetTermMatchData(column_match_data, doc_id)) {
+                score += BM25Ranker::Score(column.term_weights_[j], column_match_data.tf_, norm_factor);
+            }
+        }
+        const SizeT term_count = column.iterators_.size();
+        for (u32 j = 0; j < column.union_iterators_.size(); j++) {
+            if (column.union_iterators_[j]->Doc() == doc_id) {
+                score += BM25Ranker::Score(column.term_weights_[term_count + j], 1.0F, norm_factor);
             }
         }
-        score += ranker.GetScore();
     }
     return score;
 }
 
+void Scorer::CollectDoc(RowID doc_id) {
+    TermColumnMatchData column_match_data;
+    for (u32 i = 0; i < column_counter_; i++) {
+        ColumnScorer &column = columns_[i];
+        column.batch_norms_[batch_size_] = column.norms_->GetNorm(doc_id, column.chunk_cursor_);
+        for (u32 j = 0; j < column.iterators_.size(); j++) {
+            float tf = column.iterators_[j]->GetTermMatchData(column_match_data, doc_id) ? column_match_data.tf_ : 0.0F;
+            column.batch_tfs_[j * BATCH_SIZE + batch_size_] = tf;
+        }
+        const SizeT term_count = column.iterators_.size();
+        for (u32 j = 0; j < column.union_iterators_.size(); j++) {
+            float tf = column.union_iterators_[j]->Doc() == doc_id ? 1.0F : 0.0F;
+            column.batch_tfs_[(term_count + j) * BATCH_SIZE + batch_size_] = tf;
+        }
+    }
+    ++batch_size_;
+}
+
+void Scorer::ScoreCollected(float *scores) {
+    const u32 n = batch_size_;
+    std::fill_n(scores, n, 0.0F);
+    alignas(64) float norm_factors[BATCH_SIZE];
+    for (u32 i = 0; i < column_counter_; i++) {
+        ColumnScorer &column = columns_[i];
+        for (u32 k = 0; k < n; k++) {
+            norm_factors[k] = column.norm_factors_[column.batch_norms_[k]];
+        }
+        for (u32 j = 0; j < column.term_weights_.size(); j++) {
+            // tf / (tf + norm_factor) is 0 for a doc missing the term, since norm_factor > 0
+            const float term_weight = column.term_weights_[j];
+            const float *tfs = column.batch_tfs_.data() + j * BATCH_SIZE;
+            for (u32 k = 0; k < n; k++) {
+                scores[k] += BM25Ranker::Score(term_weight, tfs[k], norm_factors[k]);
+            }
+        }
+    }
+    batch_size_ = 0;
+}
+
 } // namespace infinity
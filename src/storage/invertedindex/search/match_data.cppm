@@ -21,6 +21,7 @@ import third_party;
 import index_defines;
 import column_length_io;
 import internal_types;
+import doc_iterator;
 
 namespace infinity {
 export struct TermColumnMatchData {
@@ -32,16 +33,34 @@ export struct TermColumnMatchData {
 class TermDocIterator;
 struct IndexReader;
 
+// BM25 scorer of the docs matched by the TermDocIterators added.
+// A union iterator added, e.g. the union of the many terms expanded from a pattern, is scored as one term which occurs
+// once in each doc it matches.
+// The factors constant per query are computed once in LoadColumnLength: a weight per term, and per column a
+// table mapping the quantized column length of a doc to its length normalization.
+// Docs are scored in batches: CollectDoc records the tf and norms of a doc while the iterators are positioned
+// on it, ScoreCollected then scores up to BATCH_SIZE docs with loops over the batch the compiler vectorizes.
 export class Scorer {
 public:
+    static constexpr u32 BATCH_SIZE = 128;
+
     void Init(u64 num_of_docs) { total_df_ = num_of_docs; }
 
     void AddDocIterator(TermDocIterator *iter, u64 column_id);
 
+    void AddUnionDocIterator(DocIterator *iter, u64 column_id, float weight);
+
     void LoadColumnLength(RowID first_doc_id, IndexReader &index_reader);
 
     float Score(RowID doc_id);
 
+    void CollectDoc(RowID doc_id);
+
+    u32 CollectedCount() const { return batch_size_; }
+
+    // scores the collected docs in collection order, then clears them
+    void ScoreCollected(float *scores);
+
 private:
     u32 GetOrSetColumnIndex(u64 column_id);
 
@@ -49,13 +68,26 @@ private:
         inline u64 operator()(const u64 &val) const { return val; }
     };
 
+    struct ColumnScorer {
+        Vector<TermDocIterator *> iterators_;
+        Vector<DocIterator *> union_iterators_;
+        Vector<float> union_weights_;
+        // weights of iterators_ followed by the ones of union_iterators_
+        Vector<float> term_weights_;
+        SharedPtr<FullTextColumnNorms> norms_;
+        SizeT chunk_cursor_{0};
+        Array<float, 256> norm_factors_{};
+        // batch_tfs_[i * BATCH_SIZE + j] is the tf of term i in the j-th collected doc, in the order of term_weights_
+        Vector<float> batch_tfs_;
+        Array<u8, BATCH_SIZE> batch_norms_{};
+    };
+
     u64 total_df_{0};
     u32 column_counter_{0};
     FlatHashMap<u64, u32, Hash> column_index_map_;
     Vector<u64> column_ids_;
-    Vector<Vector<TermDocIterator *>> iterators_;
-    Vector<float> avg_column_length_;
-    ColumnLengthReader column_length_reader_;
+    Vector<ColumnScorer> columns_;
+    u32 batch_size_{0};
 };
 
 } // namespace infinity
@@ -46,6 +46,13 @@ public:
 
     inline float Score(RowID doc_id) { return scorer_.Score(doc_id); }
 
+    // batched scoring, see Scorer
+    inline void CollectScoreDoc(RowID doc_id) { scorer_.CollectDoc(doc_id); }
+
+    inline u32 CollectedScoreDocCount() const { return scorer_.CollectedCount(); }
+
+    inline void ScoreCollected(float *scores) { scorer_.ScoreCollected(scores); }
+
 private:
     TransactionID txn_id_{};
     TxnTimeStamp begin_ts_{};
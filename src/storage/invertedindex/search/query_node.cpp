@@ -13,6 +13,8 @@ import table_entry;
 import column_index_reader;
 import match_data;
 import posting_iterator;
+import bitset_union_iterator;
+import fst;
 
 namespace infinity {
 
@@ -33,7 +35,13 @@ std::unique_ptr<QueryNode> QueryNode::GetOptimizedQueryTree(std::unique_ptr<Quer
     root->PushDownWeight();
     // optimize the query tree
     switch (root->GetType()) {
-        case QueryNodeType::TERM: {
+        case QueryNodeType::TERM:
+        case QueryNodeType::PREFIX_TERM:
+        case QueryNodeType::SUFFIX_TERM:
+        case QueryNodeType::SUBSTRING_TERM:
+        case QueryNodeType::WILDCARD_TERM:
+        case QueryNodeType::FUZZY_TERM:
+        case QueryNodeType::REGEX_TERM: {
             // no need to optimize
             return root;
         }
@@ -64,6 +72,12 @@ std::unique_ptr<QueryNode> MultiQueryNode::GetNewOptimizedQueryTree() {
     for (auto &child : children_) {
         switch (child->GetType()) {
             case QueryNodeType::TERM:
+            case QueryNodeType::PREFIX_TERM:
+            case QueryNodeType::SUFFIX_TERM:
+            case QueryNodeType::SUBSTRING_TERM:
+            case QueryNodeType::WILDCARD_TERM:
+            case QueryNodeType::FUZZY_TERM:
+            case QueryNodeType::REGEX_TERM:
                 // no need to optimize
                 break;
             case QueryNodeType::AND_NOT: {
@@ -113,6 +127,12 @@ std::unique_ptr<QueryNode> NotQueryNode::InnerGetNewOptimizedQueryTree() {
                 break;
             }
             case QueryNodeType::TERM:
+            case QueryNodeType::PREFIX_TERM:
+            case QueryNodeType::SUFFIX_TERM:
+            case QueryNodeType::SUBSTRING_TERM:
+            case QueryNodeType::WILDCARD_TERM:
+            case QueryNodeType::FUZZY_TERM:
+            case QueryNodeType::REGEX_TERM:
             case QueryNodeType::AND:
             case QueryNodeType::AND_NOT: {
                 new_not_list.emplace_back(std::move(child));
@@ -164,6 +184,12 @@ std::unique_ptr<QueryNode> AndQueryNode::InnerGetNewOptimizedQueryTree() {
                 break;
             }
             case QueryNodeType::TERM:
+            case QueryNodeType::PREFIX_TERM:
+            case QueryNodeType::SUFFIX_TERM:
+            case QueryNodeType::SUBSTRING_TERM:
+            case QueryNodeType::WILDCARD_TERM:
+            case QueryNodeType::FUZZY_TERM:
+            case QueryNodeType::REGEX_TERM:
             case QueryNodeType::OR: {
                 and_list.emplace_back(std::move(child));
                 break;
@@ -252,6 +278,12 @@ std::unique_ptr<QueryNode> OrQueryNode::InnerGetNewOptimizedQueryTree() {
                 break;
             }
             case QueryNodeType::TERM:
+            case QueryNodeType::PREFIX_TERM:
+            case QueryNodeType::SUFFIX_TERM:
+            case QueryNodeType::SUBSTRING_TERM:
+            case QueryNodeType::WILDCARD_TERM:
+            case QueryNodeType::FUZZY_TERM:
+            case QueryNodeType::REGEX_TERM:
             case QueryNodeType::AND:
             case QueryNodeType::AND_NOT: {
                 or_list.emplace_back(std::move(child));
@@ -330,6 +362,78 @@ std::unique_ptr<DocIterator> TermQueryNode::CreateSearch(const TableEntry *table
     return std::move(search);
 }
 
+std::unique_ptr<DocIterator> PatternTermQueryNode::CreateSearch(const TableEntry *table_entry, IndexReader &index_reader, Scorer *scorer) const {
+    ColumnID column_id = table_entry->GetColumnIdByName(column_);
+    ColumnIndexReader *column_index_reader = index_reader.GetColumnIndexReader(column_id);
+    if (!column_index_reader)
+        return nullptr;
+    UniquePtr<Automaton> automaton;
+    try {
+        switch (type_) {
+            case QueryNodeType::PREFIX_TERM: {
+                automaton = MakeUnique<PrefixAutomaton>(pattern_);
+                break;
+            }
+            case QueryNodeType::SUFFIX_TERM: {
+                automaton = RegexAutomaton::FromWildcard("*" + RegexAutomaton::EscapeWildcard(pattern_));
+                break;
+            }
+            case QueryNodeType::SUBSTRING_TERM: {
+                automaton = RegexAutomaton::FromWildcard("*" + RegexAutomaton::EscapeWildcard(pattern_) + "*");
+                break;
+            }
+            case QueryNodeType::WILDCARD_TERM: {
+                automaton = RegexAutomaton::FromWildcard(pattern_);
+                break;
+            }
+            case QueryNodeType::FUZZY_TERM: {
+                u32 max_edits = static_cast<const FuzzyTermQueryNode *>(this)->max_edits_;
+                automaton = MakeUnique<LevenshteinAutomaton>(pattern_, max_edits);
+                break;
+            }
+            case QueryNodeType::REGEX_TERM: {
+                automaton = RegexAutomaton::FromRegex(pattern_);
+                break;
+            }
+            default: {
+                UnrecoverableError("PatternTermQueryNode: Unexpected case!");
+                return nullptr;
+            }
+        }
+        // the dfa states of the automaton are built lazily, so patterns too complex are also reported by the lookup
+        auto posting_iterators = column_index_reader->LookupExpanded(*automaton, index_reader.session_pool_.get());
+        if (posting_iterators.empty()) {
+            return nullptr;
+        }
+        if (posting_iterators.size() <= MAX_SCORED_TERMS) {
+            // scored like an OR of the expanded terms
+            Vector<std::unique_ptr<DocIterator>> term_doc_iters;
+            term_doc_iters.reserve(posting_iterators.size());
+            for (auto &posting_iterator : posting_iterators) {
+                auto search = MakeUnique<TermDocIterator>(std::move(posting_iterator), column_id, GetWeight());
+                if (scorer) {
+                    // nodes under "not" will not be added to scorer
+                    scorer->AddDocIterator(search.get(), column_id);
+                }
+                term_doc_iters.emplace_back(std::move(search));
+            }
+            if (term_doc_iters.size() == 1) {
+                return std::move(term_doc_iters[0]);
+            }
+            return MakeUnique<OrIterator>(std::move(term_doc_iters));
+        }
+        // too many terms for a heap, the union is scored as one term
+        auto search = MakeUnique<BitsetUnionIterator>(std::move(posting_iterators));
+        if (scorer) {
+            scorer->AddUnionDocIterator(search.get(), column_id, GetWeight());
+        }
+        return std::move(search);
+    } catch (FstError &e) {
+        RecoverableError(Status::SyntaxError(e.message()));
+    }
+    return nullptr;
+}
+
 std::unique_ptr<DocIterator> AndQueryNode::CreateSearch(const TableEntry *table_entry, IndexReader &index_reader, Scorer *scorer) const {
     Vector<std::unique_ptr<DocIterator>> sub_doc_iters;
     sub_doc_iters.reserve(children_.size());
@@ -421,6 +525,12 @@ std::string QueryNodeTypeToString(QueryNodeType type) {
             return "SUFFIX_TERM";
         case QueryNodeType::SUBSTRING_TERM:
             return "SUBSTRING_TERM";
+        case QueryNodeType::WILDCARD_TERM:
+            return "WILDCARD_TERM";
+        case QueryNodeType::FUZZY_TERM:
+            return "FUZZY_TERM";
+        case QueryNodeType::REGEX_TERM:
+            return "REGEX_TERM";
     }
 }
 
@@ -434,6 +544,19 @@ void TermQueryNode::PrintTree(std::ostream &os, const std::string &prefix, bool
     os << '\n';
 }
 
+void PatternTermQueryNode::PrintTree(std::ostream &os, const std::string &prefix, bool is_final) const {
+    os << prefix;
+    os << (is_final ? "└──" : "├──");
+    os << QueryNodeTypeToString(type_);
+    os << " (weight: " << weight_ << ")";
+    os << " (column: " << column_ << ")";
+    os << " (pattern: " << pattern_ << ")";
+    if (type_ == QueryNodeType::FUZZY_TERM) {
+        os << " (max edits: " << static_cast<const FuzzyTermQueryNode *>(this)->max_edits_ << ")";
+    }
+    os << '\n';
+}
+
 void MultiQueryNode::PrintTree(std::ostream &os, const std::string &prefix, bool is_final) const {
     os << prefix;
     os << (is_final ? "└──" : "├──");
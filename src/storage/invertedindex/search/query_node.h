@@ -34,12 +34,15 @@ enum class QueryNodeType : char {
     AND,
     AND_NOT,
     OR,
-    // unimplemented:
-    WAND,
-    PHRASE,
     PREFIX_TERM,
     SUFFIX_TERM,
     SUBSTRING_TERM,
+    WILDCARD_TERM,
+    FUZZY_TERM,
+    REGEX_TERM,
+    // unimplemented:
+    WAND,
+    PHRASE,
 };
 
 std::string QueryNodeTypeToString(QueryNodeType type);
@@ -137,12 +140,52 @@ struct OrQueryNode final : public MultiQueryNode {
     std::unique_ptr<DocIterator> CreateSearch(const TableEntry *table_entry, IndexReader &index_reader, Scorer *scorer) const final;
 };
 
+// PatternTermQueryNode matches all terms of the column dictionary accepted by the pattern,
+// the pattern is normalized by the search driver the way the analyzer of the column folds terms
+// up to MAX_SCORED_TERMS matched terms are scored each as a term, more are unioned in bitmaps and scored as one term
+struct PatternTermQueryNode : public QueryNode {
+    static constexpr size_t MAX_SCORED_TERMS = 64;
+
+    std::string pattern_;
+    std::string column_;
+
+    explicit PatternTermQueryNode(QueryNodeType type) : QueryNode(type) {}
+
+    void PushDownWeight(float factor) final { MultiplyWeight(factor); }
+    std::unique_ptr<DocIterator> CreateSearch(const TableEntry *table_entry, IndexReader &index_reader, Scorer *scorer) const final;
+    void PrintTree(std::ostream &os, const std::string &prefix, bool is_final) const final;
+};
+
+// wildcard::"foo*"
+struct PrefixTermQueryNode final : public PatternTermQueryNode {
+    PrefixTermQueryNode() : PatternTermQueryNode(QueryNodeType::PREFIX_TERM) {}
+};
+// wildcard::"*foo"
+struct SuffixTermQueryNode final : public PatternTermQueryNode {
+    SuffixTermQueryNode() : PatternTermQueryNode(QueryNodeType::SUFFIX_TERM) {}
+};
+// wildcard::"*foo*"
+struct SubstringTermQueryNode final : public PatternTermQueryNode {
+    SubstringTermQueryNode() : PatternTermQueryNode(QueryNodeType::SUBSTRING_TERM) {}
+};
+// wildcard::"f?o*bar", supports "*", "?" and "\" escapes
+struct WildcardTermQueryNode final : public PatternTermQueryNode {
+    WildcardTermQueryNode() : PatternTermQueryNode(QueryNodeType::WILDCARD_TERM) {}
+};
+// fuzzy::"foo~1", terms within max_edits_ edits of the pattern, at most 2
+struct FuzzyTermQueryNode final : public PatternTermQueryNode {
+    uint32_t max_edits_ = 2;
+
+    FuzzyTermQueryNode() : PatternTermQueryNode(QueryNodeType::FUZZY_TERM) {}
+};
+// regex::"fo+ba[rz]"
+struct RegexTermQueryNode final : public PatternTermQueryNode {
+    RegexTermQueryNode() : PatternTermQueryNode(QueryNodeType::REGEX_TERM) {}
+};
+
 // unimplemented
 struct WandQueryNode;
 struct PhraseQueryNode;
-struct PrefixTermQueryNode;
-struct SuffixTermQueryNode;
-struct SubstringTermQueryNode;
 
 } // namespace infinity
 
@@ -30,12 +30,16 @@ export using infinity::AndQueryNode;
 export using infinity::AndNotQueryNode;
 export using infinity::OrQueryNode;
 export using infinity::NotQueryNode;
+export using infinity::PatternTermQueryNode;
+export using infinity::PrefixTermQueryNode;
+export using infinity::SuffixTermQueryNode;
+export using infinity::SubstringTermQueryNode;
+export using infinity::WildcardTermQueryNode;
+export using infinity::FuzzyTermQueryNode;
+export using infinity::RegexTermQueryNode;
 
 // unimplemented
 // export using infinity::WandQueryNode;
 // export using infinity::PhraseQueryNode;
-// export using infinity::PrefixTermQueryNode;
-// export using infinity::SuffixTermQueryNode;
-// export using infinity::SubstringTermQueryNode;
 
 } // namespace infinity
@@ -22,9 +22,12 @@
 #include "search_parser.h"
 #include "search_scanner.h"
 
+import stl;
 import term;
 import infinity_exception;
 import status;
+import third_party;
+import fst;
 
 namespace infinity {
 
@@ -117,6 +120,124 @@ std::unique_ptr<QueryNode> SearchDriver::ParseSingle(const std::string &query, c
     return result;
 }
 
+// Builds the term pattern of an explicit "op::pattern" query, op is one of:
+//   wildcard: "*" and "?" wildcards, "\" escapes, e.g. wildcard::"fo?ba*"
+//   regex:    regular expression over the whole term, e.g. regex::"fo+ba[rz]"
+//   fuzzy:    terms within N edits, N is at most 2 and defaults to 2, e.g. fuzzy::"foobar~1"
+// The pattern is normalized the way the analyzer of the field folds the terms, escaped characters are kept as is.
+std::unique_ptr<QueryNode> SearchDriver::BuildPatternQueryNode(const std::string &field, const std::string &op, std::string &&pattern) const {
+    u32 max_edits = LevenshteinAutomaton::MAX_EDITS;
+    if (op == "fuzzy") {
+        if (size_t tilde_idx = pattern.rfind('~'); tilde_idx != std::string::npos) {
+            std::string_view edits = std::string_view(pattern).substr(tilde_idx + 1);
+            if (edits.size() != 1 || edits[0] < '0' || edits[0] > '9') {
+                RecoverableError(Status::SyntaxError(fmt::format("Invalid fuzzy edit distance: {}", pattern)));
+                return nullptr;
+            }
+            max_edits = edits[0] - '0';
+            if (max_edits > LevenshteinAutomaton::MAX_EDITS) {
+                RecoverableError(
+                    Status::SyntaxError(fmt::format("Fuzzy edit distance {} exceeds the maximum {}", max_edits, LevenshteinAutomaton::MAX_EDITS)));
+                return nullptr;
+            }
+            pattern.resize(tilde_idx);
+        }
+    }
+    if (pattern.empty()) {
+        RecoverableError(Status::SyntaxError("Empty term pattern"));
+        return nullptr;
+    }
+    std::unique_ptr<PatternTermQueryNode> result;
+    if (op == "fuzzy") {
+        NormalizePattern(field, pattern, false);
+        auto fuzzy_node = std::make_unique<FuzzyTermQueryNode>();
+        fuzzy_node->max_edits_ = max_edits;
+        result = std::move(fuzzy_node);
+    } else if (op == "regex") {
+        NormalizePattern(field, pattern, true);
+        result = std::make_unique<RegexTermQueryNode>();
+    } else if (op == "wildcard") {
+        NormalizePattern(field, pattern, true);
+        result = BuildWildcardQueryNode(pattern);
+    } else {
+        RecoverableError(Status::SyntaxError(fmt::format("Unknown term pattern operator: {}", op)));
+        return nullptr;
+    }
+    if (result->pattern_.empty()) {
+        result->pattern_ = std::move(pattern);
+    }
+    result->column_ = field;
+    return result;
+}
+
+// Prefix, suffix and substring patterns without escapes are expanded by simpler automata than a wildcard.
+std::unique_ptr<PatternTermQueryNode> SearchDriver::BuildWildcardQueryNode(const std::string &pattern) {
+    // positions of the unescaped wildcards
+    std::vector<size_t> wildcards;
+    bool has_escape = false;
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        if (pattern[i] == '\\') {
+            has_escape = true;
+            ++i;
+        } else if (pattern[i] == '*' || pattern[i] == '?') {
+            wildcards.push_back(i);
+        }
+    }
+    const size_t last = pattern.size() - 1;
+    std::unique_ptr<PatternTermQueryNode> result;
+    if (!has_escape && pattern.size() > 1 && pattern[last] == '*') {
+        if (wildcards.size() == 1) {
+            result = std::make_unique<PrefixTermQueryNode>();
+            result->pattern_ = pattern.substr(0, last);
+            return result;
+        }
+        if (wildcards.size() == 2 && wildcards[0] == 0 && pattern.size() > 2) {
+            result = std::make_unique<SubstringTermQueryNode>();
+            result->pattern_ = pattern.substr(1, last - 1);
+            return result;
+        }
+    }
+    if (!has_escape && wildcards.size() == 1 && wildcards[0] == 0 && pattern.size() > 1) {
+        result = std::make_unique<SuffixTermQueryNode>();
+        result->pattern_ = pattern.substr(1);
+        return result;
+    }
+    return std::make_unique<WildcardTermQueryNode>();
+}
+
+void SearchDriver::NormalizePattern(const std::string &field, std::string &pattern, bool has_escapes) const {
+    if (normalize_func_ == nullptr) {
+        return;
+    }
+    auto it = field2analyzer_.find(field);
+    if (it == field2analyzer_.end() || it->second.empty()) {
+        return;
+    }
+    auto normalize_func = reinterpret_cast<void (*)(const std::string &, std::string &)>(normalize_func_);
+    if (!has_escapes) {
+        normalize_func(it->second, pattern);
+        return;
+    }
+    // normalize the runs between the escaped characters, "\S" must not become "\s"
+    std::string result;
+    result.reserve(pattern.size());
+    std::string run;
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        if (pattern[i] == '\\' && i + 1 < pattern.size()) {
+            normalize_func(it->second, run);
+            result += run;
+            run.clear();
+            result += pattern[i];
+            result += pattern[++i];
+        } else {
+            run += pattern[i];
+        }
+    }
+    normalize_func(it->second, run);
+    result += run;
+    pattern = std::move(result);
+}
+
 std::unique_ptr<QueryNode> SearchDriver::AnalyzeAndBuildQueryNode(const std::string &field, std::string &&text) const {
     if (text.empty()) {
         RecoverableError(Status::SyntaxError("Empty query text"));
@@ -22,6 +22,7 @@
 namespace infinity {
 
 struct QueryNode;
+struct PatternTermQueryNode;
 
 /**
  * Conducting the whole scanning and parsing.
@@ -40,14 +41,25 @@ public:
     // used in SearchParser in ParseSingle
     [[nodiscard]] std::unique_ptr<QueryNode> AnalyzeAndBuildQueryNode(const std::string &field, std::string &&text) const;
 
+    // used in SearchParser in ParseSingle, for the term patterns "op::pattern"
+    [[nodiscard]] std::unique_ptr<QueryNode> BuildPatternQueryNode(const std::string &field, const std::string &op, std::string &&pattern) const;
+
     // will be set in PhysicalMatch
     void (*analyze_func_)() = nullptr;
 
+    // will be set in PhysicalMatch
+    void (*normalize_func_)() = nullptr;
+
     /**
      * parsing options
      */
     const std::map<std::string, std::string> &field2analyzer_;
     const std::string &default_field_;
+
+private:
+    static std::unique_ptr<PatternTermQueryNode> BuildWildcardQueryNode(const std::string &pattern);
+
+    void NormalizePattern(const std::string &field, std::string &pattern, bool has_escapes) const;
 };
 
 } // namespace infinity
@@ -128,15 +128,22 @@ i64 LocalFileSystem::Read(FileHandler &file_handler, void *data, u64 nbytes) {
     return read_count;
 }
 
+namespace {
+thread_local u64 thread_written_bytes = 0;
+}
+
 i64 LocalFileSystem::Write(FileHandler &file_handler, const void *data, u64 nbytes) {
     i32 fd = ((LocalFileHandler &)file_handler).fd_;
     i64 write_count = write(fd, data, nbytes);
     if (write_count == -1) {
         UnrecoverableError(fmt::format("Can't write file: {}: {}. fd: {}", file_handler.path_.string(), strerror(errno), fd));
     }
+    thread_written_bytes += write_count;
     return write_count;
 }
 
+u64 LocalFileSystem::ThreadWrittenBytes() { return thread_written_bytes; }
+
 void LocalFileSystem::Seek(FileHandler &file_handler, i64 pos) {
     i32 fd = ((LocalFileHandler &)file_handler).fd_;
     if ((off_t)-1 == lseek(fd, pos, SEEK_SET)) {
@@ -223,6 +230,18 @@ void LocalFileSystem::CreateDirectory(const String &path) {
     }
 }
 
+void LocalFileSystem::SyncDirectory(const String &path) {
+    i32 fd = open(path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd == -1) {
+        UnrecoverableError(fmt::format("Can't open directory: {}, {}", path, strerror(errno)));
+    }
+    if (fsync(fd) != 0) {
+        close(fd);
+        UnrecoverableError(fmt::format("fsync failed: {}, {}", path, strerror(errno)));
+    }
+    close(fd);
+}
+
 u64 LocalFileSystem::DeleteDirectory(const String &path) {
     std::error_code error_code;
     Path p{path};
@@ -66,6 +66,9 @@ public:
     // return true if successfully created directory
     bool CreateDirectoryNoExp(const String &path);
 
+    // fsync the directory, so the files created, renamed or deleted in it survive a power failure
+    void SyncDirectory(const String &path);
+
     u64 DeleteDirectory(const String &path) final;
 
     void DeleteEmptyDirectory(const String &path) final;
@@ -76,6 +79,9 @@ public:
 
     static u64 GetFileSizeByPath(const String& path);
 
+    // Bytes written through Write by the calling thread so far.
+    static u64 ThreadWrittenBytes();
+
     static u64 GetFolderSizeByPath(const String& path);
 
     static String ConcatenateFilePath(const String& dir_path, const String& file_path);
@@ -0,0 +1,68 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+#include <chrono>
+#include <thread>
+
+export module rate_limiter;
+
+import stl;
+
+namespace infinity {
+
+// Throttles background I/O to a budget of bytes per second. The caller reports the bytes it has just read or written, and Request sleeps
+// until the I/O so far fits in the budget. Not thread-safe, each background job shall own one.
+export class RateLimiter {
+public:
+    // bytes_per_sec == 0 means unlimited
+    explicit RateLimiter(u64 bytes_per_sec) : bytes_per_sec_(bytes_per_sec), start_(std::chrono::steady_clock::now()) {}
+
+    void Request(u64 bytes) {
+        if (bytes_per_sec_ == 0 || bytes == 0) {
+            return;
+        }
+        const auto now = std::chrono::steady_clock::now();
+        if (now - Deadline() > MAX_IDLE) {
+            // don't let a long idle period turn into a burst
+            start_ = now;
+            consumed_bytes_ = 0;
+        }
+        consumed_bytes_ += bytes;
+        const auto deadline = Deadline();
+        if (deadline > now) {
+            total_wait_ += deadline - now;
+            std::this_thread::sleep_until(deadline);
+        }
+    }
+
+    u64 bytes_per_sec() const { return bytes_per_sec_; }
+
+    std::chrono::nanoseconds total_wait() const { return total_wait_; }
+
+private:
+    std::chrono::steady_clock::time_point Deadline() const {
+        return start_ + std::chrono::nanoseconds(u64(1e9 * consumed_bytes_ / bytes_per_sec_));
+    }
+
+    static constexpr std::chrono::seconds MAX_IDLE{1};
+
+    const u64 bytes_per_sec_;
+    std::chrono::steady_clock::time_point start_;
+    u64 consumed_bytes_{0};
+    std::chrono::nanoseconds total_wait_{0};
+};
+
+} // namespace infinity
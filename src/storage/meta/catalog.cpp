@@ -14,7 +14,11 @@
 
 module;
 
+#include <algorithm>
+#include <chrono>
+#include <exception>
 #include <fstream>
+#include <future>
 #include <thread>
 #include <vector>
 
@@ -23,6 +27,7 @@ module catalog;
 import stl;
 
 import txn_manager;
+import txn;
 import logger;
 import third_party;
 import status;
@@ -391,13 +396,13 @@ Tuple<SpecialFunction *, Status> Catalog::GetSpecialFunctionByNameNoExcept(Catal
     return {catalog->special_functions_[function_name].get(), Status::OK()};
 }
 
-nlohmann::json Catalog::Serialize(TxnTimeStamp max_commit_ts) {
+nlohmann::json Catalog::Serialize(TxnTimeStamp max_commit_ts, CatalogSnapshotWriter *snapshot_writer) {
     nlohmann::json json_res;
     Vector<DBMeta *> databases;
     {
         std::shared_lock<std::shared_mutex> lck(this->rw_locker());
         json_res["data_dir"] = *this->data_dir_;
-        json_res["next_txn_id"] = this->next_txn_id_;
+        json_res["next_txn_id"] = this->next_txn_id_.load();
         json_res["full_ckp_commit_ts"] = this->full_ckp_commit_ts_;
         databases.reserve(this->db_meta_map().size());
         for (auto &db_meta : this->db_meta_map()) {
@@ -406,7 +411,7 @@ nlohmann::json Catalog::Serialize(TxnTimeStamp max_commit_ts) {
     }
 
     for (auto &db_meta : databases) {
-        json_res["databases"].emplace_back(db_meta->Serialize(max_commit_ts));
+        json_res["databases"].emplace_back(db_meta->Serialize(max_commit_ts, snapshot_writer));
     }
     return json_res;
 }
@@ -450,6 +455,73 @@ Catalog::LoadFromFiles(const FullCatalogFileInfo &full_ckp_info, const Vector<De
     return catalog;
 }
 
+i32 Catalog::SaveDeltaCatalogFile(CatalogDeltaEntry *delta_entry, const String &delta_catalog_path) {
+    auto exp_size = delta_entry->GetSizeInBytes();
+    Vector<char> buf(exp_size);
+    char *ptr = buf.data();
+    delta_entry->WriteAdv(ptr);
+    i32 act_size = ptr - buf.data();
+    if (exp_size != act_size) {
+        UnrecoverableError(fmt::format("Save delta catalog failed, exp_size: {}, act_size: {}", exp_size, act_size));
+    }
+
+    LocalFileSystem fs;
+    u8 fileflags = FileFlags::WRITE_FLAG | FileFlags::TRUNCATE_CREATE;
+    UniquePtr<FileHandler> delta_file_handler = fs.OpenFile(delta_catalog_path, fileflags, FileLockType::kWriteLock);
+    i64 n_bytes = delta_file_handler->Write(buf.data(), act_size);
+    if (n_bytes != act_size) {
+        LOG_ERROR(fmt::format("Saving delta catalog file failed: {}", delta_catalog_path));
+        RecoverableError(Status::CatalogCorrupted(delta_catalog_path));
+    }
+    delta_file_handler->Sync();
+    delta_file_handler->Close();
+    return act_size;
+}
+
+SizeT Catalog::CompactDeltaCatalogFiles(const String &catalog_dir, TxnTimeStamp max_checkpoint_ts) {
+    auto catalog_fileinfo = CatalogFile::ParseValidCheckpointFilenames(catalog_dir, max_checkpoint_ts);
+    if (!catalog_fileinfo.has_value()) {
+        return 0;
+    }
+    const Vector<DeltaCatalogFileInfo> &delta_ckp_infos = catalog_fileinfo->second;
+    if (delta_ckp_infos.size() < 2) {
+        return 0;
+    }
+
+    auto begin_time = std::chrono::steady_clock::now();
+    Vector<UniquePtr<CatalogDeltaEntry>> delta_entries;
+    SizeT op_count = 0;
+    for (const auto &delta_ckp_info : delta_ckp_infos) {
+        auto delta_entry = Catalog::LoadFromFileDelta(delta_ckp_info);
+        op_count += delta_entry->operations().size();
+        delta_entries.push_back(std::move(delta_entry));
+    }
+    TxnTimeStamp merged_ts = delta_ckp_infos.back().max_commit_ts_;
+    UniquePtr<CatalogDeltaEntry> merged_entry = CatalogDeltaEntry::Merge(std::move(delta_entries));
+
+    // Written aside and renamed, the merged file replaces the delta files only once it is complete.
+    String tmp_path = fmt::format("{}/{}", catalog_dir, CatalogFile::TempMergedDeltaCheckpointFilename(merged_ts));
+    String merged_path = fmt::format("{}/{}", catalog_dir, CatalogFile::MergedDeltaCheckpointFilename(merged_ts));
+    i32 merged_size = SaveDeltaCatalogFile(merged_entry.get(), tmp_path);
+    LocalFileSystem fs;
+    fs.Rename(tmp_path, merged_path);
+    for (const auto &delta_ckp_info : delta_ckp_infos) {
+        if (delta_ckp_info.path_ != merged_path) {
+            fs.DeleteFile(delta_ckp_info.path_);
+        }
+    }
+
+    u64 duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - begin_time).count();
+    LOG_INFO(fmt::format("Merged {} delta catalog files into {}: {} ops pruned to {}, size: {}, cost {} ms",
+                         delta_ckp_infos.size(),
+                         merged_path,
+                         op_count,
+                         merged_entry->operations().size(),
+                         merged_size,
+                         duration_ms));
+    return delta_ckp_infos.size();
+}
+
 // called by Replay
 UniquePtr<CatalogDeltaEntry> Catalog::LoadFromFileDelta(const DeltaCatalogFileInfo &delta_ckp_info) {
     const auto &catalog_path = delta_ckp_info.path_;
@@ -819,6 +891,12 @@ void Catalog::LoadFromEntryDelta(TxnTimeStamp max_commit_ts, BufferManager *buff
 UniquePtr<Catalog> Catalog::LoadFromFile(const FullCatalogFileInfo &full_ckp_info, BufferManager *buffer_mgr) {
     const auto &catalog_path = full_ckp_info.path_;
 
+    if (CatalogSnapshotReader::IsSnapshotFile(catalog_path)) {
+        CatalogSnapshotReader snapshot_reader(catalog_path);
+        return Deserialize(snapshot_reader.Skeleton(), buffer_mgr, &snapshot_reader);
+    }
+
+    // Full catalog written as a single json document by older versions.
     LocalFileSystem fs;
     UniquePtr<FileHandler> catalog_file_handler = fs.OpenFile(catalog_path, FileFlags::READ_FLAG, FileLockType::kReadLock);
     SizeT file_size = fs.GetFileSize(*catalog_file_handler);
@@ -832,19 +910,23 @@ UniquePtr<Catalog> Catalog::LoadFromFile(const FullCatalogFileInfo &full_ckp_inf
     return Deserialize(catalog_json, buffer_mgr);
 }
 
-UniquePtr<Catalog> Catalog::Deserialize(const nlohmann::json &catalog_json, BufferManager *buffer_mgr) {
+UniquePtr<Catalog> Catalog::Deserialize(const nlohmann::json &catalog_json, BufferManager *buffer_mgr, CatalogSnapshotReader *snapshot_reader) {
     SharedPtr<String> data_dir = MakeShared<String>(catalog_json["data_dir"]);
 
     // FIXME: new catalog need a scheduler, current we use nullptr to represent it.
     auto catalog = MakeUnique<Catalog>(std::move(data_dir));
-    catalog->next_txn_id_ = catalog_json["next_txn_id"];
+    catalog->next_txn_id_ = catalog_json["next_txn_id"].get<TransactionID>();
     catalog->full_ckp_commit_ts_ = catalog_json["full_ckp_commit_ts"];
     if (catalog_json.contains("databases")) {
         for (const auto &db_json : catalog_json["databases"]) {
-            UniquePtr<DBMeta> db_meta = DBMeta::Deserialize(db_json, buffer_mgr);
+            UniquePtr<DBMeta> db_meta = DBMeta::Deserialize(db_json, buffer_mgr, snapshot_reader);
             catalog->db_meta_map().emplace(*db_meta->db_name(), std::move(db_meta));
         }
     }
+    if (snapshot_reader != nullptr) {
+        SizeT load_thread_num = std::clamp<SizeT>(Thread::hardware_concurrency(), 1, CATALOG_LOAD_MAX_THREAD_NUM);
+        snapshot_reader->LoadTables(load_thread_num);
+    }
     return catalog;
 }
 
@@ -852,36 +934,20 @@ void Catalog::SaveFullCatalog(TxnTimeStamp max_commit_ts, String &full_catalog_p
     full_catalog_path = fmt::format("{}/{}", *catalog_dir_, CatalogFile::FullCheckpoingFilename(max_commit_ts));
     String catalog_tmp_path = fmt::format("{}/{}", *catalog_dir_, CatalogFile::TempFullCheckpointFilename(max_commit_ts));
 
-    // Serialize catalog to string
-    full_ckp_commit_ts_ = max_commit_ts;
-    nlohmann::json catalog_json = Serialize(max_commit_ts);
-    String catalog_str = catalog_json.dump();
+    auto begin_time = std::chrono::steady_clock::now();
+    u64 written_bytes_before = LocalFileSystem::ThreadWrittenBytes();
 
-    // Save catalog to tmp file.
+    // Table entries are streamed to the tmp file while the catalog is serialized, the remaining skeleton is written last.
     // FIXME: Temp implementation, will be replaced by async task.
-    LocalFileSystem fs;
-
-    u8 fileflags = FileFlags::WRITE_FLAG;
-
-    if (!fs.Exists(catalog_tmp_path)) {
-        fileflags |= FileFlags::CREATE_FLAG;
-    }
-
-    UniquePtr<FileHandler> catalog_file_handler = fs.OpenFile(catalog_tmp_path, fileflags, FileLockType::kWriteLock);
-
-    // TODO: Save as a temp filename, then rename it to the real filename.
-    SizeT n_bytes = catalog_file_handler->Write(catalog_str.data(), catalog_str.size());
-    if (n_bytes != catalog_str.size()) {
-        LOG_ERROR(fmt::format("Saving catalog file failed: {}", catalog_tmp_path));
-        RecoverableError(Status::CatalogCorrupted(catalog_tmp_path));
-    }
-    catalog_file_handler->Sync();
-    catalog_file_handler->Close();
+    full_ckp_commit_ts_ = max_commit_ts;
+    CatalogSnapshotWriter snapshot_writer(full_catalog_path, catalog_tmp_path);
+    nlohmann::json catalog_json = Serialize(max_commit_ts, &snapshot_writer);
+    snapshot_writer.Finish(catalog_json);
 
-    // Rename temp file to regular catalog file
-    catalog_file_handler->Rename(catalog_tmp_path, full_catalog_path);
+    u64 duration_us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin_time).count();
+    RecordCheckpoint(true, max_commit_ts, LocalFileSystem::ThreadWrittenBytes() - written_bytes_before, duration_us);
 
-    LOG_INFO(fmt::format("Saved catalog to: {}", full_catalog_path));
+    LOG_INFO(fmt::format("Saved catalog to: {}, {} table entries", full_catalog_path, snapshot_writer.SectionCount()));
 }
 
 // called by bg_task
@@ -898,39 +964,15 @@ bool Catalog::SaveDeltaCatalog(TxnTimeStamp max_commit_ts, String &delta_catalog
     }
     LOG_INFO(fmt::format("Save delta catalog commit ts:{}, checkpoint max commit ts:{}.", flush_delta_entry->commit_ts(), max_commit_ts));
 
-    for (auto &op : flush_delta_entry->operations()) {
-        switch (op->GetType()) {
-            case CatalogDeltaOpType::ADD_BLOCK_ENTRY: {
-                auto *block_entry_op = static_cast<AddBlockEntryOp *>(op.get());
-                LOG_TRACE(fmt::format("Flush block entry: {}", block_entry_op->ToString()));
-                block_entry_op->FlushDataToDisk(max_commit_ts);
-                break;
-            }
-            case CatalogDeltaOpType::ADD_SEGMENT_INDEX_ENTRY: {
-                auto add_segment_index_entry_op = static_cast<AddSegmentIndexEntryOp *>(op.get());
-                LOG_TRACE(fmt::format("Flush segment index entry: {}", add_segment_index_entry_op->ToString()));
-                add_segment_index_entry_op->Flush(max_commit_ts);
-                break;
-            }
-            default:
-                break;
-        }
-    }
+    auto begin_time = std::chrono::steady_clock::now();
+    u64 written_bytes = FlushDeltaOps(flush_delta_entry.get(), max_commit_ts);
 
-    // Save the global catalog delta entry to disk.
-    auto exp_size = flush_delta_entry->GetSizeInBytes();
-    Vector<char> buf(exp_size);
-    char *ptr = buf.data();
-    flush_delta_entry->WriteAdv(ptr);
-    i32 act_size = ptr - buf.data();
-    if (exp_size != act_size) {
-        UnrecoverableError(fmt::format("Save delta catalog failed, exp_size: {}, act_size: {}", exp_size, act_size));
-    }
+    // Save the global catalog delta entry to disk, after all the files it refers to are written.
+    i32 act_size = SaveDeltaCatalogFile(flush_delta_entry.get(), delta_catalog_path);
+    written_bytes += act_size;
 
-    std::ofstream outfile;
-    outfile.open(delta_catalog_path, std::ios::binary);
-    outfile.write((reinterpret_cast<const char *>(buf.data())), act_size);
-    outfile.close();
+    u64 duration_us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin_time).count();
+    RecordCheckpoint(false, max_commit_ts, written_bytes, duration_us);
 
     // {
     // log for delta op debug
@@ -948,6 +990,97 @@ bool Catalog::SaveDeltaCatalog(TxnTimeStamp max_commit_ts, String &delta_catalog
     return false;
 }
 
+u64 Catalog::FlushDeltaOps(CatalogDeltaEntry *flush_delta_entry, TxnTimeStamp max_commit_ts) {
+    // Ops on the same entry write the same files, they are kept in order in one task. Different entries are flushed concurrently.
+    Vector<Vector<CatalogDeltaOperation *>> op_groups;
+    HashMap<String, SizeT> op_group_idx;
+    for (auto &op : flush_delta_entry->operations()) {
+        CatalogDeltaOpType op_type = op->GetType();
+        if (op_type != CatalogDeltaOpType::ADD_BLOCK_ENTRY && op_type != CatalogDeltaOpType::ADD_SEGMENT_INDEX_ENTRY) {
+            continue;
+        }
+        auto [iter, inserted] = op_group_idx.emplace(op->EncodeIndex(), op_groups.size());
+        if (inserted) {
+            op_groups.emplace_back();
+        }
+        op_groups[iter->second].push_back(op.get());
+    }
+
+    auto flush_ops = [max_commit_ts](const Vector<CatalogDeltaOperation *> &ops) {
+        u64 written_bytes_before = LocalFileSystem::ThreadWrittenBytes();
+        for (auto *op : ops) {
+            switch (op->GetType()) {
+                case CatalogDeltaOpType::ADD_BLOCK_ENTRY: {
+                    auto *block_entry_op = static_cast<AddBlockEntryOp *>(op);
+                    LOG_TRACE(fmt::format("Flush block entry: {}", block_entry_op->ToString()));
+                    block_entry_op->FlushDataToDisk(max_commit_ts);
+                    break;
+                }
+                case CatalogDeltaOpType::ADD_SEGMENT_INDEX_ENTRY: {
+                    auto *add_segment_index_entry_op = static_cast<AddSegmentIndexEntryOp *>(op);
+                    LOG_TRACE(fmt::format("Flush segment index entry: {}", add_segment_index_entry_op->ToString()));
+                    add_segment_index_entry_op->Flush(max_commit_ts);
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+        return LocalFileSystem::ThreadWrittenBytes() - written_bytes_before;
+    };
+
+    u64 written_bytes = 0;
+    if (checkpoint_io_pool_.get() == nullptr || op_groups.size() <= 1) {
+        for (const auto &ops : op_groups) {
+            written_bytes += flush_ops(ops);
+        }
+        return written_bytes;
+    }
+
+    Vector<std::future<u64>> futures;
+    futures.reserve(op_groups.size());
+    for (const auto &ops : op_groups) {
+        futures.push_back(checkpoint_io_pool_->push([&flush_ops, &ops](int) { return flush_ops(ops); }));
+    }
+    // Barrier: wait for all the tasks, they refer to the ops owned by the caller.
+    std::exception_ptr first_exception;
+    for (auto &future : futures) {
+        try {
+            written_bytes += future.get();
+        } catch (...) {
+            if (!first_exception) {
+                first_exception = std::current_exception();
+            }
+        }
+    }
+    if (first_exception) {
+        std::rethrow_exception(first_exception);
+    }
+    return written_bytes;
+}
+
+void Catalog::InitCheckpointIOPool(SizeT thread_num) {
+    if (thread_num > 1) {
+        checkpoint_io_pool_ = MakeUnique<ThreadPool>(thread_num);
+    }
+}
+
+void Catalog::RecordCheckpoint(bool is_full_checkpoint, TxnTimeStamp max_commit_ts, u64 written_bytes, u64 duration_us) {
+    std::lock_guard<std::mutex> lock(checkpoint_stats_mutex_);
+    checkpoint_stats_.is_full_checkpoint_ = is_full_checkpoint;
+    checkpoint_stats_.max_commit_ts_ = max_commit_ts;
+    checkpoint_stats_.written_bytes_ = written_bytes;
+    checkpoint_stats_.duration_us_ = duration_us;
+    ++checkpoint_stats_.checkpoint_count_;
+    checkpoint_stats_.total_written_bytes_ += written_bytes;
+    checkpoint_stats_.total_duration_us_ += duration_us;
+}
+
+CheckpointStatistics Catalog::GetCheckpointStatistics() {
+    std::lock_guard<std::mutex> lock(checkpoint_stats_mutex_);
+    return checkpoint_stats_;
+}
+
 void Catalog::AddDeltaEntry(UniquePtr<CatalogDeltaEntry> delta_entry, i64 wal_size) {
     global_catalog_delta_entry_->AddDeltaEntry(std::move(delta_entry), wal_size);
 }
@@ -983,6 +1116,18 @@ void Catalog::MemIndexRecover(BufferManager *buffer_manager) {
     }
 }
 
+SizeT Catalog::OptimizeIndexChunks(Txn *txn, const TieredChunkMergePolicy &policy, RateLimiter *rate_limiter) {
+    SizeT merge_count = 0;
+    auto db_meta_map_guard = db_meta_map_.GetMetaMap();
+    for (auto &[_, db_meta] : *db_meta_map_guard) {
+        auto [db_entry, status] = db_meta->GetEntryNolock(txn->TxnID(), txn->BeginTS());
+        if (status.ok()) {
+            merge_count += db_entry->OptimizeIndexChunks(txn, policy, rate_limiter);
+        }
+    }
+    return merge_count;
+}
+
 Tuple<TxnTimeStamp, i64> Catalog::GetCheckpointState() const { return global_catalog_delta_entry_->GetCheckpointState(); }
 
 void Catalog::InitDeltaEntry(TxnTimeStamp max_commit_ts) { global_catalog_delta_entry_->InitMaxCommitTS(max_commit_ts); }
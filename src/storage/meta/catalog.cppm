@@ -43,6 +43,9 @@ import base_entry;
 import meta_entry_interface;
 import cleanup_scanner;
 import log_file;
+import chunk_index_merge_policy;
+import rate_limiter;
+import catalog_snapshot;
 
 namespace infinity {
 
@@ -100,6 +103,19 @@ public:
 
 class GlobalCatalogDeltaEntry;
 class CatalogDeltaEntry;
+export struct CheckpointStatistics {
+    // last checkpoint
+    bool is_full_checkpoint_{false};
+    TxnTimeStamp max_commit_ts_{0};
+    u64 written_bytes_{0};
+    u64 duration_us_{0};
+
+    // since startup
+    u64 checkpoint_count_{0};
+    u64 total_written_bytes_{0};
+    u64 total_duration_us_{0};
+};
+
 export struct Catalog {
 public:
     explicit Catalog(SharedPtr<String> data_dir);
@@ -230,7 +246,7 @@ public:
 
 public:
     // Serialization and Deserialization
-    nlohmann::json Serialize(TxnTimeStamp max_commit_ts);
+    nlohmann::json Serialize(TxnTimeStamp max_commit_ts, CatalogSnapshotWriter *snapshot_writer = nullptr);
 
     void SaveFullCatalog(TxnTimeStamp max_commit_ts, String &full_path);
 
@@ -245,8 +261,15 @@ public:
     static UniquePtr<Catalog>
     LoadFromFiles(const FullCatalogFileInfo &full_ckp_info, const Vector<DeltaCatalogFileInfo> &delta_ckp_infos, BufferManager *buffer_mgr);
 
+    // Merges the delta catalog files since the last full checkpoint into one MERGED_DELTA file, returns the number of files merged,
+    // 0 if there are fewer than two.
+    static SizeT CompactDeltaCatalogFiles(const String &catalog_dir, TxnTimeStamp max_checkpoint_ts);
+
 private:
-    static UniquePtr<Catalog> Deserialize(const nlohmann::json &catalog_json, BufferManager *buffer_mgr);
+    static i32 SaveDeltaCatalogFile(CatalogDeltaEntry *delta_entry, const String &delta_catalog_path);
+
+    static UniquePtr<Catalog>
+    Deserialize(const nlohmann::json &catalog_json, BufferManager *buffer_mgr, CatalogSnapshotReader *snapshot_reader = nullptr);
 
     static UniquePtr<CatalogDeltaEntry> LoadFromFileDelta(const DeltaCatalogFileInfo &delta_ckp_info);
 
@@ -274,7 +297,7 @@ public:
 
     MetaMap<DBMeta> db_meta_map_{};
 
-    TransactionID next_txn_id_{};
+    Atomic<TransactionID> next_txn_id_{};
 
 private:
     TxnTimeStamp full_ckp_commit_ts_{};
@@ -303,6 +326,9 @@ private: // TODO: remove this
 public:
     void MemIndexRecover(BufferManager* buffer_manager);
 
+    // Merge full-text chunk indexes picked by the policy, in all tables visible to txn. Returns the number of merges done.
+    SizeT OptimizeIndexChunks(Txn *txn, const TieredChunkMergePolicy &policy, RateLimiter *rate_limiter);
+
     void PickCleanup(CleanupScanner *scanner);
 
     // delta checkpoint info
@@ -311,8 +337,22 @@ public:
 
     void InitDeltaEntry(TxnTimeStamp max_commit_ts);
 
+    // Without the pool, delta checkpoints flush on the calling thread.
+    void InitCheckpointIOPool(SizeT thread_num);
+
+    CheckpointStatistics GetCheckpointStatistics();
+
 private:
+    // Flushes the blocks and segment indexes of the delta ops, returns the number of bytes written.
+    u64 FlushDeltaOps(CatalogDeltaEntry *flush_delta_entry, TxnTimeStamp max_commit_ts);
+
+    void RecordCheckpoint(bool is_full_checkpoint, TxnTimeStamp max_commit_ts, u64 written_bytes, u64 duration_us);
+
     UniquePtr<GlobalCatalogDeltaEntry> global_catalog_delta_entry_{MakeUnique<GlobalCatalogDeltaEntry>()};
+
+    UniquePtr<ThreadPool> checkpoint_io_pool_{};
+    std::mutex checkpoint_stats_mutex_{};
+    CheckpointStatistics checkpoint_stats_{};
 };
 
 } // namespace infinity
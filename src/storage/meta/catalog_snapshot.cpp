@@ -0,0 +1,292 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <future>
+
+module catalog_snapshot;
+
+import stl;
+import third_party;
+import file_system;
+import file_system_type;
+import local_file_system;
+import logger;
+import status;
+import infinity_exception;
+import crc;
+import mmap;
+
+namespace infinity {
+
+namespace {
+
+constexpr SizeT HEADER_SIZE = sizeof(u64) + sizeof(u32) + sizeof(u32);
+constexpr SizeT DIRECTORY_ENTRY_SIZE = sizeof(u64) + sizeof(u64) + sizeof(u32) + sizeof(u32);
+constexpr SizeT TRAILER_SIZE = sizeof(u64) + sizeof(u64) + sizeof(u32) + sizeof(u32) + sizeof(u64) + sizeof(u32) + sizeof(u32) + sizeof(u64);
+constexpr SizeT RECORD_HEADER_SIZE = sizeof(u32) + sizeof(u32) + sizeof(u64);
+
+template <typename T>
+T ReadValue(const u8 *&ptr) {
+    T value;
+    std::memcpy(&value, ptr, sizeof(T));
+    ptr += sizeof(T);
+    return value;
+}
+
+} // namespace
+
+CatalogSnapshotWriter::CatalogSnapshotWriter(const String &path, const String &tmp_path) : path_(path), tmp_path_(tmp_path) {
+    u8 fileflags = FileFlags::WRITE_FLAG | FileFlags::TRUNCATE_CREATE;
+    if (!fs_.Exists(tmp_path_)) {
+        fileflags |= FileFlags::CREATE_FLAG;
+    }
+    file_handler_ = fs_.OpenFile(tmp_path_, fileflags, FileLockType::kWriteLock);
+
+    WriteValue<u64>(CATALOG_SNAPSHOT_MAGIC);
+    WriteValue<u32>(CATALOG_SNAPSHOT_VERSION);
+    WriteValue<u32>(0);
+}
+
+CatalogSnapshotWriter::~CatalogSnapshotWriter() {
+    if (!finished_ && file_handler_.get() != nullptr) {
+        // Serialization failed half way, the temp file is never renamed and will be overwritten by the next checkpoint.
+        file_handler_->Close();
+        LOG_WARN(fmt::format("Unfinished catalog snapshot: {}", tmp_path_));
+    }
+}
+
+void CatalogSnapshotWriter::Write(const void *data, SizeT size) {
+    i64 n_bytes = file_handler_->Write(data, size);
+    if (n_bytes < 0 || (SizeT)n_bytes != size) {
+        LOG_ERROR(fmt::format("Saving catalog file failed: {}", tmp_path_));
+        RecoverableError(Status::CatalogCorrupted(tmp_path_));
+    }
+    offset_ += size;
+}
+
+u32 CatalogSnapshotWriter::BeginSection() {
+    if (in_section_) {
+        UnrecoverableError(fmt::format("Catalog snapshot section {} is not ended", sections_.size() - 1));
+    }
+    in_section_ = true;
+    sections_.push_back(SectionInfo{offset_, 0, 0});
+    return sections_.size() - 1;
+}
+
+void CatalogSnapshotWriter::AddRecord(CatalogSnapshotRecordType record_type, const nlohmann::json &record_json) {
+    if (!in_section_) {
+        UnrecoverableError("Catalog snapshot record is written outside of a section");
+    }
+    Vector<u8> bytes = nlohmann::json::to_msgpack(record_json);
+    WriteValue<u32>(static_cast<u32>(record_type));
+    WriteValue<u32>(CRC32IEEE::makeCRC(bytes.data(), bytes.size()));
+    WriteValue<u64>(bytes.size());
+    Write(bytes.data(), bytes.size());
+    ++sections_.back().record_count_;
+}
+
+void CatalogSnapshotWriter::EndSection() {
+    if (!in_section_) {
+        UnrecoverableError("Catalog snapshot section is not begun");
+    }
+    in_section_ = false;
+    SectionInfo &section = sections_.back();
+    section.size_ = offset_ - section.offset_;
+}
+
+void CatalogSnapshotWriter::Finish(const nlohmann::json &skeleton_json) {
+    if (in_section_) {
+        UnrecoverableError(fmt::format("Catalog snapshot section {} is not ended", sections_.size() - 1));
+    }
+    Vector<u8> skeleton_bytes = nlohmann::json::to_msgpack(skeleton_json);
+    u64 skeleton_offset = offset_;
+    u32 skeleton_crc = CRC32IEEE::makeCRC(skeleton_bytes.data(), skeleton_bytes.size());
+    Write(skeleton_bytes.data(), skeleton_bytes.size());
+
+    u64 directory_offset = offset_;
+    for (const auto &section : sections_) {
+        WriteValue<u64>(section.offset_);
+        WriteValue<u64>(section.size_);
+        WriteValue<u32>(section.record_count_);
+        WriteValue<u32>(0);
+    }
+
+    WriteValue<u64>(skeleton_offset);
+    WriteValue<u64>(skeleton_bytes.size());
+    WriteValue<u32>(skeleton_crc);
+    WriteValue<u32>(sections_.size());
+    WriteValue<u64>(directory_offset);
+    WriteValue<u32>(CATALOG_SNAPSHOT_VERSION);
+    WriteValue<u32>(0);
+    WriteValue<u64>(CATALOG_SNAPSHOT_MAGIC);
+
+    file_handler_->Sync();
+    file_handler_->Close();
+    finished_ = true;
+
+    // Rename temp file to regular catalog file
+    file_handler_->Rename(tmp_path_, path_);
+}
+
+CatalogSnapshotReader::CatalogSnapshotReader(const String &path) : path_(path) {
+    if (MmapFile(path_, data_, data_len_) != 0) {
+        RecoverableError(Status::CatalogCorrupted(path_));
+    }
+    try {
+        ReadDirectory();
+    } catch (...) {
+        MunmapFile(data_, data_len_);
+        throw;
+    }
+}
+
+void CatalogSnapshotReader::ReadDirectory() {
+    if (data_len_ < HEADER_SIZE + TRAILER_SIZE) {
+        RecoverableError(Status::CatalogCorrupted(path_));
+    }
+    const u8 *ptr = data_;
+    u64 magic = ReadValue<u64>(ptr);
+    u32 version = ReadValue<u32>(ptr);
+    if (magic != CATALOG_SNAPSHOT_MAGIC) {
+        RecoverableError(Status::CatalogCorrupted(path_));
+    }
+    if (version > CATALOG_SNAPSHOT_VERSION) {
+        UnrecoverableError(
+            fmt::format("Catalog snapshot {} has version {}, newer than the supported version {}", path_, version, CATALOG_SNAPSHOT_VERSION));
+    }
+
+    ptr = data_ + data_len_ - TRAILER_SIZE;
+    skeleton_offset_ = ReadValue<u64>(ptr);
+    skeleton_size_ = ReadValue<u64>(ptr);
+    skeleton_crc_ = ReadValue<u32>(ptr);
+    u32 section_count = ReadValue<u32>(ptr);
+    u64 directory_offset = ReadValue<u64>(ptr);
+    ReadValue<u32>(ptr); // version
+    ReadValue<u32>(ptr); // reserved
+    if (ReadValue<u64>(ptr) != CATALOG_SNAPSHOT_MAGIC) {
+        // The trailer is written last, a missing trailer means the checkpoint was interrupted.
+        RecoverableError(Status::CatalogCorrupted(path_));
+    }
+
+    SizeT trailer_offset = data_len_ - TRAILER_SIZE;
+    if (directory_offset > trailer_offset || (trailer_offset - directory_offset) != (SizeT)section_count * DIRECTORY_ENTRY_SIZE ||
+        skeleton_offset_ < HEADER_SIZE || skeleton_offset_ + skeleton_size_ > directory_offset) {
+        RecoverableError(Status::CatalogCorrupted(path_));
+    }
+
+    sections_.resize(section_count);
+    ptr = data_ + directory_offset;
+    for (auto &section : sections_) {
+        section.offset_ = ReadValue<u64>(ptr);
+        section.size_ = ReadValue<u64>(ptr);
+        section.record_count_ = ReadValue<u32>(ptr);
+        ReadValue<u32>(ptr); // reserved
+        if (section.offset_ < HEADER_SIZE || section.offset_ + section.size_ > skeleton_offset_) {
+            RecoverableError(Status::CatalogCorrupted(path_));
+        }
+    }
+}
+
+CatalogSnapshotReader::~CatalogSnapshotReader() {
+    if (MunmapFile(data_, data_len_) != 0) {
+        LOG_ERROR(fmt::format("Failed to unmap catalog snapshot: {}", path_));
+    }
+}
+
+bool CatalogSnapshotReader::IsSnapshotFile(const String &path) {
+    LocalFileSystem fs;
+    UniquePtr<FileHandler> file_handler = fs.OpenFile(path, FileFlags::READ_FLAG, FileLockType::kReadLock);
+    u64 magic = 0;
+    i64 n_bytes = file_handler->Read(&magic, sizeof(magic));
+    file_handler->Close();
+    return n_bytes == sizeof(magic) && magic == CATALOG_SNAPSHOT_MAGIC;
+}
+
+nlohmann::json CatalogSnapshotReader::Skeleton() const {
+    const u8 *begin = data_ + skeleton_offset_;
+    if (CRC32IEEE::makeCRC(begin, skeleton_size_) != skeleton_crc_) {
+        RecoverableError(Status::CatalogCorrupted(path_));
+    }
+    return nlohmann::json::from_msgpack(begin, begin + skeleton_size_);
+}
+
+CatalogSnapshotSection CatalogSnapshotReader::Section(u32 section_id) const {
+    if (section_id >= sections_.size()) {
+        RecoverableError(Status::CatalogCorrupted(path_));
+    }
+    const SectionInfo &section = sections_[section_id];
+    const u8 *begin = data_ + section.offset_;
+    return CatalogSnapshotSection(path_, begin, begin + section.size_, section.record_count_);
+}
+
+bool CatalogSnapshotSection::Next(CatalogSnapshotRecordType &record_type, nlohmann::json &record_json) {
+    if (record_count_ == 0) {
+        if (ptr_ != end_) {
+            RecoverableError(Status::CatalogCorrupted(path_));
+        }
+        return false;
+    }
+    if (SizeT(end_ - ptr_) < RECORD_HEADER_SIZE) {
+        RecoverableError(Status::CatalogCorrupted(path_));
+    }
+    record_type = static_cast<CatalogSnapshotRecordType>(ReadValue<u32>(ptr_));
+    u32 record_crc = ReadValue<u32>(ptr_);
+    u64 record_size = ReadValue<u64>(ptr_);
+    if (record_size > SizeT(end_ - ptr_) || CRC32IEEE::makeCRC(ptr_, record_size) != record_crc) {
+        RecoverableError(Status::CatalogCorrupted(path_));
+    }
+    record_json = nlohmann::json::from_msgpack(ptr_, ptr_ + record_size);
+    ptr_ += record_size;
+    --record_count_;
+    return true;
+}
+
+void CatalogSnapshotReader::LoadTables(SizeT thread_num) {
+    Vector<std::function<void()>> table_loads = std::move(table_loads_);
+    table_loads_.clear();
+    if (thread_num <= 1 || table_loads.size() <= 1) {
+        for (auto &table_load : table_loads) {
+            table_load();
+        }
+        return;
+    }
+
+    ThreadPool thread_pool(std::min(thread_num, table_loads.size()));
+    Vector<std::future<void>> futures;
+    futures.reserve(table_loads.size());
+    for (auto &table_load : table_loads) {
+        futures.push_back(thread_pool.push([&table_load](int) { table_load(); }));
+    }
+    // Wait for all tasks before rethrowing, the tasks refer to the table metas owned by the caller.
+    std::exception_ptr first_exception;
+    for (auto &future : futures) {
+        try {
+            future.get();
+        } catch (...) {
+            if (!first_exception) {
+                first_exception = std::current_exception();
+            }
+        }
+    }
+    if (first_exception) {
+        std::rethrow_exception(first_exception);
+    }
+}
+
+} // namespace infinity
@@ -0,0 +1,153 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+#include <functional>
+
+export module catalog_snapshot;
+
+import stl;
+import third_party;
+import file_system;
+import local_file_system;
+
+namespace infinity {
+
+// Layout of a full catalog snapshot file, all integers little endian:
+//
+//   header:    magic (u64), version (u32), reserved (u32)
+//   sections:  one table entry per section, written while the catalog is serialized
+//   skeleton:  MessagePack encoded catalog json, whose table entries are replaced by {"snapshot_section": id}
+//   directory: offset (u64), size (u64), record count (u32), reserved (u32) of each section
+//   trailer:   skeleton offset (u64), skeleton size (u64), skeleton crc32 (u32), section count (u32),
+//              directory offset (u64), version (u32), reserved (u32), magic (u64)
+//
+// A section is a sequence of records: record type (u32), crc32 (u32), size (u64), followed by the MessagePack encoded record.
+// The table entry record comes first, then each segment entry record followed by the records of its blocks, then one record
+// per table index. Segments and blocks are written one at a time, so a table entry is never held in memory as a whole.
+//
+// The trailer is fixed sized, so a reader maps the file and finds the skeleton and the directory without scanning the sections.
+// Each table entry is decoded from its own section only when it is loaded.
+export constexpr u64 CATALOG_SNAPSHOT_MAGIC = 0x474C544143464E49ULL; // "INFCATLG"
+export constexpr u32 CATALOG_SNAPSHOT_VERSION = 1;
+
+export enum class CatalogSnapshotRecordType : u32 {
+    kTableEntry = 1,
+    kSegmentEntry = 2,
+    kBlockEntry = 3,
+    kTableIndex = 4,
+};
+
+export class CatalogSnapshotWriter {
+public:
+    // Writes to a temp file which is renamed to `path` by Finish.
+    CatalogSnapshotWriter(const String &path, const String &tmp_path);
+
+    ~CatalogSnapshotWriter();
+
+    // Starts the section of one table entry and returns the section id that refers to it.
+    u32 BeginSection();
+
+    // Writes one record to the current section.
+    void AddRecord(CatalogSnapshotRecordType record_type, const nlohmann::json &record_json);
+
+    void EndSection();
+
+    void Finish(const nlohmann::json &skeleton_json);
+
+    SizeT SectionCount() const { return sections_.size(); }
+
+private:
+    struct SectionInfo {
+        u64 offset_{};
+        u64 size_{};
+        u32 record_count_{};
+    };
+
+    void Write(const void *data, SizeT size);
+
+    template <typename T>
+    void WriteValue(T value) {
+        Write(&value, sizeof(T));
+    }
+
+    String path_;
+    String tmp_path_;
+    LocalFileSystem fs_;
+    UniquePtr<FileHandler> file_handler_;
+    u64 offset_{0};
+    Vector<SectionInfo> sections_;
+    bool in_section_{false};
+    bool finished_{false};
+};
+
+// Reads the records of one section in the order they were written.
+export class CatalogSnapshotSection {
+public:
+    CatalogSnapshotSection(const String &path, const u8 *begin, const u8 *end, u32 record_count)
+        : path_(path), ptr_(begin), end_(end), record_count_(record_count) {}
+
+    // Decodes the next record, returns false after the last one.
+    bool Next(CatalogSnapshotRecordType &record_type, nlohmann::json &record_json);
+
+    const String &path() const { return path_; }
+
+private:
+    String path_;
+    const u8 *ptr_{};
+    const u8 *end_{};
+    u32 record_count_{};
+};
+
+export class CatalogSnapshotReader {
+public:
+    explicit CatalogSnapshotReader(const String &path);
+
+    ~CatalogSnapshotReader();
+
+    // Returns true if the file starts with the snapshot magic, false for a legacy json catalog.
+    static bool IsSnapshotFile(const String &path);
+
+    nlohmann::json Skeleton() const;
+
+    CatalogSnapshotSection Section(u32 section_id) const;
+
+    SizeT SectionCount() const { return sections_.size(); }
+
+    // Table loads are collected while the skeleton is deserialized and run by LoadTables in parallel, one task per table meta.
+    void AddTableLoad(std::function<void()> table_load) { table_loads_.push_back(std::move(table_load)); }
+
+    void LoadTables(SizeT thread_num);
+
+private:
+    struct SectionInfo {
+        u64 offset_{};
+        u64 size_{};
+        u32 record_count_{};
+    };
+
+    void ReadDirectory();
+
+    String path_;
+    u8 *data_{nullptr};
+    SizeT data_len_{0};
+    u64 skeleton_offset_{};
+    u64 skeleton_size_{};
+    u32 skeleton_crc_{};
+    Vector<SectionInfo> sections_;
+    Vector<std::function<void()>> table_loads_;
+};
+
+} // namespace infinity
@@ -32,6 +32,7 @@ import infinity_exception;
 import varchar_layout;
 import logger;
 import data_file_worker;
+import file_worker;
 import catalog_delta_entry;
 import internal_types;
 import data_type;
@@ -106,6 +107,17 @@ ColumnVector BlockColumnEntry::GetColumnVector(BufferManager *buffer_mgr) {
     return column_vector;
 }
 
+void BlockColumnEntry::GetBufferObjs(BufferManager *buffer_mgr, Vector<BufferObj *> &buffer_objs) {
+    if (this->buffer_ == nullptr) {
+        auto file_worker = MakeUnique<DataFileWorker>(this->base_dir_, this->file_name_, 0);
+        this->buffer_ = buffer_mgr->Get(std::move(file_worker));
+    }
+    buffer_objs.push_back(this->buffer_);
+
+    std::shared_lock lock(mutex_);
+    buffer_objs.insert(buffer_objs.end(), outline_buffers_.begin(), outline_buffers_.end());
+}
+
 void BlockColumnEntry::Append(const ColumnVector *input_column_vector, u16 input_column_vector_offset, SizeT append_rows, BufferManager *buffer_mgr) {
     if (buffer_ == nullptr) {
         UnrecoverableError("Not initialize buffer handle");
@@ -114,9 +126,21 @@ void BlockColumnEntry::Append(const ColumnVector *input_column_vector, u16 input
     column_vector.AppendWith(*input_column_vector, input_column_vector_offset, append_rows);
 }
 
-void BlockColumnEntry::Flush(BlockColumnEntry *block_column_entry, SizeT checkpoint_row_count) {
+SharedPtr<ColumnBlockDictionary> BlockColumnEntry::GetDictionary() const {
+    if (buffer_ == nullptr) {
+        return nullptr;
+    }
+    return static_cast<DataFileWorker *>(buffer_->file_worker())->dictionary();
+}
+
+void BlockColumnEntry::Flush(BlockColumnEntry *block_column_entry, SizeT checkpoint_row_count, bool sealed) {
     // TODO: Opt, Flush certain row_count content
     DataType *column_type = block_column_entry->column_type_.get();
+    // Only fixed width values are encoded. Booleans are bit packed, and equal bytes of a varchar don't mean equal strings once they
+    // reference the outline buffers.
+    if (sealed && column_type->Plain()) {
+        static_cast<DataFileWorker *>(block_column_entry->buffer_->file_worker())->EnableEncoding(column_type->Size());
+    }
     switch (column_type->type()) {
         case kBoolean:
         case kTinyInt:
@@ -27,6 +27,7 @@ import vector_buffer;
 import txn;
 import internal_types;
 import base_entry;
+import column_block_encoding;
 
 namespace infinity {
 
@@ -71,6 +72,12 @@ public:
 
     ColumnVector GetColumnVector(BufferManager *buffer_mgr);
 
+    // Dictionary of the column block if it's stored dictionary or RLE encoded, available once the data buffer is loaded.
+    SharedPtr<ColumnBlockDictionary> GetDictionary() const;
+
+    // The data and outline buffers of the column, for a table scan to load them ahead.
+    void GetBufferObjs(BufferManager *buffer_mgr, Vector<BufferObj *> &buffer_objs);
+
     void AppendOutlineBuffer(BufferObj *buffer) {
         std::unique_lock lock(mutex_);
         outline_buffers_.emplace_back(buffer);
@@ -93,7 +100,8 @@ public:
 public:
     void Append(const ColumnVector *input_column_vector, u16 input_offset, SizeT append_rows, BufferManager *buffer_mgr);
 
-    static void Flush(BlockColumnEntry *block_column_entry, SizeT row_count);
+    // The data of a sealed column block won't change, so it may be stored encoded.
+    static void Flush(BlockColumnEntry *block_column_entry, SizeT row_count, bool sealed);
 
     void Cleanup();
 
@@ -89,42 +89,36 @@ Pair<BlockOffset, BlockOffset> BlockEntry::GetVisibleRange(TxnTimeStamp begin_ts
     std::shared_lock lock(rw_locker_);
     begin_ts = std::min(begin_ts, this->max_row_ts_);
     auto &block_version = this->block_version_;
-    auto &deleted = block_version->deleted_;
     BlockOffset block_offset_end = block_version->GetRowCount(begin_ts);
-    while (block_offset_begin < block_offset_end && deleted[block_offset_begin] != 0 && deleted[block_offset_begin] <= begin_ts) {
-        block_offset_begin++;
-    }
-    BlockOffset row_idx;
-    for (row_idx = block_offset_begin; row_idx < block_offset_end; ++row_idx) {
-        if (deleted[row_idx] != 0 && deleted[row_idx] <= begin_ts) {
-            break;
-        }
-    }
-    return {block_offset_begin, row_idx};
+    return block_version->VisibleRange(begin_ts, block_offset_begin, block_offset_end);
 }
 
 bool BlockEntry::CheckRowVisible(BlockOffset block_offset, TxnTimeStamp check_ts) const {
     std::shared_lock lock(rw_locker_);
-    auto &block_version = this->block_version_;
-    auto &deleted = block_version->deleted_;
-    return deleted[block_offset] == 0 || deleted[block_offset] > check_ts;
+    return !this->block_version_->CheckDeleted(block_offset, check_ts);
 }
 
 void BlockEntry::SetDeleteBitmask(TxnTimeStamp query_ts, Bitmask &bitmask) const {
-    BlockOffset read_offset = 0;
-    while (true) {
-        auto [row_begin, row_end] = GetVisibleRange(query_ts, read_offset);
-        if (row_begin == row_end) {
-            break;
+    std::shared_lock lock(rw_locker_);
+    const auto &block_version = this->block_version_;
+    query_ts = std::min(query_ts, this->max_row_ts_);
+    SizeT visible_row_count = block_version->GetRowCount(query_ts);
+    SizeT row_count = std::min<SizeT>(this->row_count_, bitmask.count());
+    visible_row_count = std::min(visible_row_count, row_count);
+    constexpr SizeT word_bits = BlockVersion::WORD_BITS;
+    // The rows deleted at query_ts and the rows appended after it are invisible.
+    for (SizeT word_idx = 0; word_idx * word_bits < row_count; ++word_idx) {
+        SizeT word_begin = word_idx * word_bits;
+        u64 invisible = block_version->DeletedWord(word_idx, query_ts);
+        if (visible_row_count < word_begin + word_bits) {
+            invisible |= visible_row_count <= word_begin ? ~u64(0) : ~u64(0) << (visible_row_count - word_begin);
         }
-        for (BlockOffset offset = read_offset; offset < row_begin; ++offset) {
-            bitmask.SetFalse(offset);
+        if (row_count < word_begin + word_bits) {
+            invisible &= ~(~u64(0) << (row_count - word_begin));
+        }
+        if (invisible != 0) {
+            bitmask.SetFalseUnit(word_idx, invisible);
         }
-        read_offset = row_end;
-    }
-    // FIXME: read row_count_ is not thread safe
-    for (BlockOffset offset = read_offset; offset < row_count_; ++offset) {
-        bitmask.SetFalse(offset);
     }
 }
 
@@ -179,7 +173,7 @@ void BlockEntry::DeleteData(TransactionID txn_id, TxnTimeStamp commit_ts, const
 
     auto &block_version = this->block_version_;
     for (BlockOffset block_offset : rows) {
-        block_version->deleted_[block_offset] = commit_ts;
+        block_version->Delete(block_offset, commit_ts);
     }
 
     LOG_TRACE(fmt::format("Segment {} Block {} has deleted {} rows", segment_id, block_id, rows.size()));
@@ -214,11 +208,13 @@ void BlockEntry::CommitBlock(TransactionID txn_id, TxnTimeStamp commit_ts) {
 }
 
 void BlockEntry::FlushData(int64_t checkpoint_row_count) {
+    // No more rows will be appended to a full block.
+    bool sealed = checkpoint_row_count == this->row_capacity_;
     SizeT column_count = this->columns_.size();
     SizeT column_idx = 0;
     while (column_idx < column_count) {
         BlockColumnEntry *block_column_entry = this->columns_[column_idx].get();
-        BlockColumnEntry::Flush(block_column_entry, checkpoint_row_count);
+        BlockColumnEntry::Flush(block_column_entry, checkpoint_row_count, sealed);
         LOG_TRACE(fmt::format("ColumnData {} is flushed", block_column_entry->column_id()));
         ++column_idx;
     }
@@ -234,7 +230,7 @@ void BlockEntry::Flush(TxnTimeStamp checkpoint_ts, bool check_commit) {
     }
     int checkpoint_row_count = 0;
 
-    BlockVersion checkpoint_version(this->block_version_->deleted_.size());
+    BlockVersion checkpoint_version(this->block_version_->capacity());
     {
         std::shared_lock<std::shared_mutex> lock(this->rw_locker_);
 
@@ -250,27 +246,16 @@ void BlockEntry::Flush(TxnTimeStamp checkpoint_ts, bool check_commit) {
             LOG_TRACE(fmt::format("Block entry {} is empty at checkpoint_ts {}", this->block_id_, checkpoint_ts));
             return;
         }
-        const Vector<TxnTimeStamp> &deleted = this->block_version_->deleted_;
         if (checkpoint_row_count <= this->checkpoint_row_count_) {
             // BlockEntry doesn't append rows between the previous checkpoint and checkpoint_ts.
-            bool deleted_between = false;
-            for (int i = 0; i < checkpoint_row_count; i++) {
-                if (deleted[i] > this->checkpoint_ts_ && deleted[i] <= checkpoint_ts) {
-                    deleted_between = true;
-                    break;
-                }
-            }
-            if (!deleted_between) // BlockEntry doesn't change between the previous checkpoint and checkpoint_ts.
+            if (!this->block_version_->HasDeleteBetween(this->checkpoint_ts_, checkpoint_ts)) {
+                // BlockEntry doesn't change between the previous checkpoint and checkpoint_ts.
                 return;
+            }
         }
-        checkpoint_version.created_ = this->block_version_->created_;
-        checkpoint_version.deleted_ = deleted;
-    }
-    for (int i = 0; i < checkpoint_row_count; i++) {
-        if (checkpoint_version.deleted_[i] > checkpoint_ts) {
-            checkpoint_version.deleted_[i] = 0;
-        }
+        checkpoint_version = *this->block_version_;
     }
+    checkpoint_version.RemoveDeletesAfter(checkpoint_ts);
 
     FlushVersion(checkpoint_version);
     FlushData(checkpoint_row_count);
@@ -14,6 +14,8 @@
 
 module;
 
+#include <algorithm>
+#include <bit>
 #include <fstream>
 
 module block_version;
@@ -29,19 +31,174 @@ import local_file_system;
 namespace infinity {
 
 bool BlockVersion::operator==(const BlockVersion &rhs) const {
-    if (this->created_.size() != rhs.created_.size() || this->deleted_.size() != rhs.deleted_.size())
+    if (this->created_.size() != rhs.created_.size() || this->delete_count_ != rhs.delete_count_)
         return false;
     for (SizeT i = 0; i < this->created_.size(); i++) {
         if (this->created_[i] != rhs.created_[i])
             return false;
     }
-    for (SizeT i = 0; i < this->deleted_.size(); i++) {
-        if (this->deleted_[i] != rhs.deleted_[i])
-            return false;
+    for (SizeT word_idx = 0; word_idx < this->delete_bitmap_.size(); ++word_idx) {
+        for (u64 bits = this->delete_bitmap_[word_idx]; bits != 0; bits &= bits - 1) {
+            BlockOffset block_offset = word_idx * WORD_BITS + std::countr_zero(bits);
+            if (this->DeleteTS(block_offset) != rhs.DeleteTS(block_offset))
+                return false;
+        }
     }
     return true;
 }
 
+void BlockVersion::Delete(BlockOffset block_offset, TxnTimeStamp commit_ts) {
+    if (block_offset >= capacity_ || commit_ts == 0) {
+        UnrecoverableError(fmt::format("Invalid delete of row {} at ts {}, block capacity: {}", block_offset, commit_ts, capacity_));
+    }
+    if (delete_bitmap_.empty()) {
+        delete_bitmap_.resize((capacity_ + WORD_BITS - 1) / WORD_BITS);
+        min_delete_ts_ = commit_ts;
+        max_delete_ts_ = commit_ts;
+    }
+    // A row deleted again keeps the bounds of its old ts, they only need to enclose the timestamps.
+    min_delete_ts_ = std::min(min_delete_ts_, commit_ts);
+    max_delete_ts_ = std::max(max_delete_ts_, commit_ts);
+
+    u64 &word = delete_bitmap_[block_offset / WORD_BITS];
+    u64 bit = u64(1) << (block_offset % WORD_BITS);
+    bool deleted = (word & bit) != 0;
+    word |= bit;
+    if (!dense_deleted_.empty()) {
+        dense_deleted_[block_offset] = commit_ts;
+        delete_count_ += !deleted;
+        return;
+    }
+    auto iter = std::lower_bound(sparse_deleted_.begin(), sparse_deleted_.end(), block_offset, [](const auto &deleted_row, BlockOffset offset) {
+        return deleted_row.first < offset;
+    });
+    if (deleted) {
+        iter->second = commit_ts;
+        return;
+    }
+    sparse_deleted_.emplace(iter, block_offset, commit_ts);
+    ++delete_count_;
+    if (delete_count_ > capacity_ / DENSE_DELETE_RATIO) {
+        ToDense();
+    }
+}
+
+void BlockVersion::ToDense() {
+    dense_deleted_.assign(capacity_, 0);
+    for (const auto &[block_offset, delete_ts] : sparse_deleted_) {
+        dense_deleted_[block_offset] = delete_ts;
+    }
+    Vector<Pair<BlockOffset, TxnTimeStamp>>().swap(sparse_deleted_);
+}
+
+void BlockVersion::ClearDeletes() {
+    delete_count_ = 0;
+    min_delete_ts_ = 0;
+    max_delete_ts_ = 0;
+    Vector<u64>().swap(delete_bitmap_);
+    Vector<Pair<BlockOffset, TxnTimeStamp>>().swap(sparse_deleted_);
+    Vector<TxnTimeStamp>().swap(dense_deleted_);
+}
+
+TxnTimeStamp BlockVersion::DeleteTS(BlockOffset block_offset) const {
+    if (delete_bitmap_.empty() || block_offset >= capacity_) {
+        return 0;
+    }
+    if ((delete_bitmap_[block_offset / WORD_BITS] & (u64(1) << (block_offset % WORD_BITS))) == 0) {
+        return 0;
+    }
+    if (!dense_deleted_.empty()) {
+        return dense_deleted_[block_offset];
+    }
+    auto iter = std::lower_bound(sparse_deleted_.begin(), sparse_deleted_.end(), block_offset, [](const auto &deleted_row, BlockOffset offset) {
+        return deleted_row.first < offset;
+    });
+    return iter->second;
+}
+
+bool BlockVersion::HasDeleteBetween(TxnTimeStamp begin_ts, TxnTimeStamp end_ts) const {
+    if (delete_count_ == 0 || max_delete_ts_ <= begin_ts || min_delete_ts_ > end_ts) {
+        return false;
+    }
+    for (SizeT word_idx = 0; word_idx < delete_bitmap_.size(); ++word_idx) {
+        for (u64 bits = delete_bitmap_[word_idx]; bits != 0; bits &= bits - 1) {
+            TxnTimeStamp delete_ts = DeleteTS(word_idx * WORD_BITS + std::countr_zero(bits));
+            if (delete_ts > begin_ts && delete_ts <= end_ts) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+u64 BlockVersion::DeletedWord(SizeT word_idx, TxnTimeStamp check_ts) const {
+    if (!HasDelete(check_ts) || word_idx >= delete_bitmap_.size()) {
+        return 0;
+    }
+    u64 word = delete_bitmap_[word_idx];
+    if (word == 0 || check_ts >= max_delete_ts_) {
+        return word;
+    }
+    // Some rows of the block are deleted after check_ts, check the rows of this word one by one.
+    for (u64 bits = word; bits != 0; bits &= bits - 1) {
+        u32 bit_idx = std::countr_zero(bits);
+        if (DeleteTS(word_idx * WORD_BITS + bit_idx) > check_ts) {
+            word &= ~(u64(1) << bit_idx);
+        }
+    }
+    return word;
+}
+
+Pair<BlockOffset, BlockOffset> BlockVersion::VisibleRange(TxnTimeStamp check_ts, BlockOffset block_offset_begin, BlockOffset block_offset_end) const {
+    if (block_offset_begin >= block_offset_end || !HasDelete(check_ts)) {
+        return {block_offset_begin, block_offset_end};
+    }
+    // Skip the deleted rows, then extend the range to the next deleted row.
+    SizeT range_begin = block_offset_begin;
+    while (range_begin < block_offset_end) {
+        SizeT word_idx = range_begin / WORD_BITS;
+        u64 visible = ~DeletedWord(word_idx, check_ts) & (~u64(0) << (range_begin % WORD_BITS));
+        if (visible != 0) {
+            range_begin = word_idx * WORD_BITS + std::countr_zero(visible);
+            break;
+        }
+        range_begin = (word_idx + 1) * WORD_BITS;
+    }
+    range_begin = std::min<SizeT>(range_begin, block_offset_end);
+    SizeT range_end = range_begin;
+    while (range_end < block_offset_end) {
+        SizeT word_idx = range_end / WORD_BITS;
+        u64 deleted = DeletedWord(word_idx, check_ts) & (~u64(0) << (range_end % WORD_BITS));
+        if (deleted != 0) {
+            range_end = word_idx * WORD_BITS + std::countr_zero(deleted);
+            break;
+        }
+        range_end = (word_idx + 1) * WORD_BITS;
+    }
+    range_end = std::min<SizeT>(range_end, block_offset_end);
+    return {BlockOffset(range_begin), BlockOffset(range_end)};
+}
+
+void BlockVersion::RemoveDeletesAfter(TxnTimeStamp max_ts) {
+    if (delete_count_ == 0 || max_delete_ts_ <= max_ts) {
+        return;
+    }
+    Vector<Pair<BlockOffset, TxnTimeStamp>> kept_deletes;
+    for (SizeT word_idx = 0; word_idx < delete_bitmap_.size(); ++word_idx) {
+        for (u64 bits = delete_bitmap_[word_idx]; bits != 0; bits &= bits - 1) {
+            BlockOffset block_offset = word_idx * WORD_BITS + std::countr_zero(bits);
+            TxnTimeStamp delete_ts = DeleteTS(block_offset);
+            if (delete_ts <= max_ts) {
+                kept_deletes.emplace_back(block_offset, delete_ts);
+            }
+        }
+    }
+    ClearDeletes();
+    for (const auto &[block_offset, delete_ts] : kept_deletes) {
+        Delete(block_offset, delete_ts);
+    }
+}
+
 i32 BlockVersion::GetRowCount(TxnTimeStamp begin_ts) {
     if (created_.empty())
         return 0;
@@ -70,27 +227,46 @@ void BlockVersion::LoadFromFile(const String &version_path) {
     i32 created_size = ReadBufAdv<i32>(ptr);
     i32 deleted_size = ReadBufAdv<i32>(ptr);
     created_.resize(created_size);
-    deleted_.resize(deleted_size);
     std::memcpy(created_.data(), ptr, created_size * sizeof(CreateField));
     ptr += created_size * sizeof(CreateField);
-    std::memcpy(deleted_.data(), ptr, deleted_size * sizeof(TxnTimeStamp));
-    ptr += deleted_.size() * sizeof(TxnTimeStamp);
+    ClearDeletes();
+    if (deleted_size >= 0) {
+        // Written by older versions: one ts per row, 0 for the rows not deleted.
+        for (i32 i = 0; i < deleted_size; ++i) {
+            TxnTimeStamp delete_ts = ReadBufAdv<TxnTimeStamp>(ptr);
+            if (delete_ts != 0) {
+                Delete(i, delete_ts);
+            }
+        }
+    } else {
+        for (i32 i = 0; i < -deleted_size; ++i) {
+            BlockOffset block_offset = ReadBufAdv<BlockOffset>(ptr);
+            TxnTimeStamp delete_ts = ReadBufAdv<TxnTimeStamp>(ptr);
+            Delete(block_offset, delete_ts);
+        }
+    }
     if (ptr - buf.data() != buf_len) {
         UnrecoverableError(fmt::format("Failed to load block_version file: {}", version_path));
     }
 }
 
 void BlockVersion::SaveToFile(const String &version_path) {
+    // Only the deleted rows are saved, as (offset, ts) pairs. A negative count tells them from the dense array of older versions.
     i32 exp_size = sizeof(i32) + created_.size() * sizeof(CreateField);
-    exp_size += sizeof(i32) + deleted_.size() * sizeof(TxnTimeStamp);
+    exp_size += sizeof(i32) + delete_count_ * (sizeof(BlockOffset) + sizeof(TxnTimeStamp));
     Vector<char> buf(exp_size, 0);
     char *ptr = buf.data();
     WriteBufAdv<i32>(ptr, i32(created_.size()));
-    WriteBufAdv<i32>(ptr, i32(deleted_.size()));
+    WriteBufAdv<i32>(ptr, -i32(delete_count_));
     std::memcpy(ptr, created_.data(), created_.size() * sizeof(CreateField));
     ptr += created_.size() * sizeof(CreateField);
-    std::memcpy(ptr, deleted_.data(), deleted_.size() * sizeof(TxnTimeStamp));
-    ptr += deleted_.size() * sizeof(TxnTimeStamp);
+    for (SizeT word_idx = 0; word_idx < delete_bitmap_.size(); ++word_idx) {
+        for (u64 bits = delete_bitmap_[word_idx]; bits != 0; bits &= bits - 1) {
+            BlockOffset block_offset = word_idx * WORD_BITS + std::countr_zero(bits);
+            WriteBufAdv<BlockOffset>(ptr, block_offset);
+            WriteBufAdv<TxnTimeStamp>(ptr, DeleteTS(block_offset));
+        }
+    }
     if (ptr - buf.data() != exp_size) {
         UnrecoverableError(fmt::format("Failed to save block_version file: {}", version_path));
     }
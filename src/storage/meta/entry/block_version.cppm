@@ -33,10 +33,17 @@ struct CreateField {
 };
 #pragma pack()
 
+// Delete timestamps of a block are kept in tiers, most blocks never leave the first one:
+//   empty:  no row is deleted, nothing is allocated
+//   sparse: a bitmap of the deleted rows and their timestamps sorted by offset
+//   dense:  the bitmap and one timestamp per row, once more than capacity / DENSE_DELETE_RATIO rows are deleted
+// Visibility is checked a bitmap word at a time, the timestamps are only read for words deleted after the checked ts.
 export struct BlockVersion {
     constexpr static std::string_view PATH = "version";
+    constexpr static SizeT DENSE_DELETE_RATIO = 16;
+    constexpr static SizeT WORD_BITS = 64;
 
-    explicit BlockVersion(SizeT capacity) : deleted_(capacity, 0) {}
+    explicit BlockVersion(SizeT capacity) : capacity_(capacity) {}
     bool operator==(const BlockVersion &rhs) const;
     bool operator!=(const BlockVersion &rhs) const { return !(*this == rhs); };
     i32 GetRowCount(TxnTimeStamp begin_ts);
@@ -45,9 +52,50 @@ export struct BlockVersion {
 
     void Cleanup(const String &version_path);
 
+    SizeT capacity() const { return capacity_; }
+
+    SizeT DeleteCount() const { return delete_count_; }
+
+    void Delete(BlockOffset block_offset, TxnTimeStamp commit_ts);
+
+    // Returns the commit ts of the delete of the row, 0 if the row is not deleted.
+    TxnTimeStamp DeleteTS(BlockOffset block_offset) const;
+
+    bool CheckDeleted(BlockOffset block_offset, TxnTimeStamp check_ts) const {
+        TxnTimeStamp delete_ts = DeleteTS(block_offset);
+        return delete_ts != 0 && delete_ts <= check_ts;
+    }
+
+    // False if no row is deleted at check_ts.
+    bool HasDelete(TxnTimeStamp check_ts) const { return delete_count_ != 0 && min_delete_ts_ <= check_ts; }
+
+    // True if a row is deleted in (begin_ts, end_ts].
+    bool HasDeleteBetween(TxnTimeStamp begin_ts, TxnTimeStamp end_ts) const;
+
+    // Bits of the rows in [word_idx * WORD_BITS, (word_idx + 1) * WORD_BITS) deleted at check_ts.
+    u64 DeletedWord(SizeT word_idx, TxnTimeStamp check_ts) const;
+
+    // Returns the first run of visible rows in [block_offset_begin, block_offset_end).
+    Pair<BlockOffset, BlockOffset> VisibleRange(TxnTimeStamp check_ts, BlockOffset block_offset_begin, BlockOffset block_offset_end) const;
+
+    // Forgets the deletes committed after max_ts, used to build the version saved by a checkpoint.
+    void RemoveDeletesAfter(TxnTimeStamp max_ts);
+
     Vector<CreateField> created_{}; // second field width is same as timestamp, otherwise Valgrind will issue BlockVersion::SaveToFile has
                                     // risk to write uninitialized buffer. (ts, rows)
-    Vector<TxnTimeStamp> deleted_{};
+
+private:
+    void ClearDeletes();
+
+    void ToDense();
+
+    SizeT capacity_{};
+    SizeT delete_count_{};
+    TxnTimeStamp min_delete_ts_{};
+    TxnTimeStamp max_delete_ts_{};
+    Vector<u64> delete_bitmap_{};
+    Vector<Pair<BlockOffset, TxnTimeStamp>> sparse_deleted_{};
+    Vector<TxnTimeStamp> dense_deleted_{};
 };
 
 } // namespace infinity
@@ -25,6 +25,10 @@ import base_entry;
 import meta_entry_interface;
 import cleanup_scanner;
 import segment_index_entry;
+import table_index_entry;
+import local_file_system;
+import index_defines;
+import logger;
 
 namespace infinity {
 
@@ -53,4 +57,18 @@ UniquePtr<ChunkIndexEntry> ChunkIndexEntry::Deserialize(const nlohmann::json &in
     return MakeUnique<ChunkIndexEntry>(segment_index_entry, base_name, base_rowid, row_count);
 }
 
+void ChunkIndexEntry::Cleanup() { CleanupFiles(*segment_index_entry_->table_index_entry()->index_dir(), base_name_); }
+
+void ChunkIndexEntry::CleanupFiles(const String &index_dir, const String &base_name) {
+    String index_prefix = (Path(index_dir) / base_name).string();
+    LocalFileSystem fs;
+    for (const char *suffix : {DICT_SUFFIX, POSTING_SUFFIX, LENGTH_SUFFIX, NORM_SUFFIX}) {
+        String file_path = index_prefix + suffix;
+        if (fs.Exists(file_path)) {
+            fs.DeleteFile(file_path);
+        }
+    }
+    LOG_INFO(fmt::format("Cleanup chunk index files: {}", index_prefix));
+}
+
 } // namespace infinity
@@ -23,6 +23,7 @@ import third_party;
 import base_entry;
 import meta_entry_interface;
 import cleanup_scanner;
+import default_values;
 
 namespace infinity {
 
@@ -49,14 +50,26 @@ public:
 
     static UniquePtr<ChunkIndexEntry> Deserialize(const nlohmann::json &index_entry_json, SegmentIndexEntry *segment_index_entry);
 
-    virtual void Cleanup() override {}
+    virtual void Cleanup() override;
     virtual void PickCleanup(CleanupScanner *scanner) override {}
 
+    // Deletes the files of a chunk: those of a chunk merged away, or the partial output of a failed merge.
+    static void CleanupFiles(const String &index_dir, const String &base_name);
+
+    // Set when the txn that merged this chunk into a bigger one commits.
+    void DeprecateChunk(TxnTimeStamp commit_ts) { deprecate_ts_.store(commit_ts); }
+
+    // Txns that began before the deprecate ts may still read the chunk.
+    bool CheckDeprecate(TxnTimeStamp check_ts) const { return check_ts > deprecate_ts_.load(); }
+
 public:
     SegmentIndexEntry *segment_index_entry_;
     String base_name_;
     RowID base_rowid_;
     u32 row_count_;
+
+private:
+    Atomic<TxnTimeStamp> deprecate_ts_{UNCOMMIT_TS};
 };
 
 } // namespace infinity
@@ -22,6 +22,7 @@ import table_entry_type;
 import stl;
 
 import txn_manager;
+import txn;
 import meta_info;
 import buffer_manager;
 import default_values;
@@ -220,7 +221,7 @@ SharedPtr<String> DBEntry::ToString() {
     return res;
 }
 
-nlohmann::json DBEntry::Serialize(TxnTimeStamp max_commit_ts) {
+nlohmann::json DBEntry::Serialize(TxnTimeStamp max_commit_ts, CatalogSnapshotWriter *snapshot_writer) {
     nlohmann::json json_res;
 
     Vector<TableMeta *> table_metas;
@@ -241,12 +242,13 @@ nlohmann::json DBEntry::Serialize(TxnTimeStamp max_commit_ts) {
         }
     }
     for (TableMeta *table_meta : table_metas) {
-        json_res["tables"].emplace_back(table_meta->Serialize(max_commit_ts));
+        json_res["tables"].emplace_back(table_meta->Serialize(max_commit_ts, snapshot_writer));
     }
     return json_res;
 }
 
-UniquePtr<DBEntry> DBEntry::Deserialize(const nlohmann::json &db_entry_json, DBMeta *db_meta, BufferManager *buffer_mgr) {
+UniquePtr<DBEntry>
+DBEntry::Deserialize(const nlohmann::json &db_entry_json, DBMeta *db_meta, BufferManager *buffer_mgr, CatalogSnapshotReader *snapshot_reader) {
     nlohmann::json json_res;
 
     bool deleted = db_entry_json["deleted"];
@@ -265,7 +267,7 @@ UniquePtr<DBEntry> DBEntry::Deserialize(const nlohmann::json &db_entry_json, DBM
 
     if (db_entry_json.contains("tables")) {
         for (const auto &table_meta_json : db_entry_json["tables"]) {
-            UniquePtr<TableMeta> table_meta = TableMeta::Deserialize(table_meta_json, res.get(), buffer_mgr);
+            UniquePtr<TableMeta> table_meta = TableMeta::Deserialize(table_meta_json, res.get(), buffer_mgr, snapshot_reader);
             res->table_meta_map().emplace(*table_meta->table_name_, std::move(table_meta));
         }
     }
@@ -303,6 +305,18 @@ void DBEntry::MemIndexCommit() {
     }
 }
 
+SizeT DBEntry::OptimizeIndexChunks(Txn *txn, const TieredChunkMergePolicy &policy, RateLimiter *rate_limiter) {
+    SizeT merge_count = 0;
+    auto table_meta_map_guard = table_meta_map_.GetMetaMap();
+    for (auto &[_, table_meta] : *table_meta_map_guard) {
+        auto [table_entry, status] = table_meta->GetEntryNolock(txn->TxnID(), txn->BeginTS());
+        if (status.ok()) {
+            merge_count += table_entry->OptimizeIndexChunks(txn, policy, rate_limiter);
+        }
+    }
+    return merge_count;
+}
+
 void DBEntry::MemIndexRecover(BufferManager *buffer_manager) {
     auto table_meta_map_guard = table_meta_map_.GetMetaMap();
     for (auto &[_, table_meta] : *table_meta_map_guard) {
@@ -31,6 +31,9 @@ import meta_map;
 import random;
 import meta_entry_interface;
 import cleanup_scanner;
+import chunk_index_merge_policy;
+import rate_limiter;
+import catalog_snapshot;
 
 namespace infinity {
 
@@ -67,9 +70,12 @@ public:
 public:
     SharedPtr<String> ToString();
 
-    nlohmann::json Serialize(TxnTimeStamp max_commit_ts);
+    nlohmann::json Serialize(TxnTimeStamp max_commit_ts, CatalogSnapshotWriter *snapshot_writer = nullptr);
 
-    static UniquePtr<DBEntry> Deserialize(const nlohmann::json &db_entry_json, DBMeta *db_meta, BufferManager *buffer_mgr);
+    static UniquePtr<DBEntry> Deserialize(const nlohmann::json &db_entry_json,
+                                          DBMeta *db_meta,
+                                          BufferManager *buffer_mgr,
+                                          CatalogSnapshotReader *snapshot_reader = nullptr);
 
     [[nodiscard]] const SharedPtr<String> &db_name_ptr() const { return db_name_; }
 
@@ -145,5 +151,6 @@ public:
 
     void MemIndexCommit();
     void MemIndexRecover(BufferManager *buffer_manager);
+    SizeT OptimizeIndexChunks(Txn *txn, const TieredChunkMergePolicy &policy, RateLimiter *rate_limiter);
 };
 } // namespace infinity
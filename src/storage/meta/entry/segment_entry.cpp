@@ -43,6 +43,7 @@ import compact_segments_task;
 import cleanup_scanner;
 import background_process;
 import wal_entry;
+import segment_statistics;
 
 namespace infinity {
 
@@ -353,7 +354,7 @@ SharedPtr<BlockEntry> SegmentEntry::GetBlockEntryByID(BlockID block_id) const {
     return block_entries_[block_id];
 }
 
-nlohmann::json SegmentEntry::Serialize(TxnTimeStamp max_commit_ts) {
+nlohmann::json SegmentEntry::Serialize(TxnTimeStamp max_commit_ts, CatalogSnapshotWriter *snapshot_writer) {
     nlohmann::json json_res;
 
     // const field
@@ -378,11 +379,21 @@ nlohmann::json SegmentEntry::Serialize(TxnTimeStamp max_commit_ts) {
             LOG_TRACE(fmt::format("SegmentEntry::Serialize: Begin try to save FastRoughFilter to json file"));
             this->GetFastRoughFilter()->SaveToJsonFile(json_res);
             LOG_TRACE(fmt::format("SegmentEntry::Serialize: End try to save FastRoughFilter to json file"));
+            if (statistics_) {
+                statistics_->SaveToJsonFile(json_res);
+            }
+        }
+        if (snapshot_writer != nullptr) {
+            snapshot_writer->AddRecord(CatalogSnapshotRecordType::kSegmentEntry, json_res);
         }
         for (auto &block_entry : this->block_entries_) {
             if (block_entry->commit_ts_ <= max_commit_ts) {
                 block_entry->Flush(max_commit_ts);
-                json_res["block_entries"].emplace_back(block_entry->Serialize(max_commit_ts));
+                if (snapshot_writer != nullptr) {
+                    snapshot_writer->AddRecord(CatalogSnapshotRecordType::kBlockEntry, block_entry->Serialize(max_commit_ts));
+                } else {
+                    json_res["block_entries"].emplace_back(block_entry->Serialize(max_commit_ts));
+                }
             }
         }
     }
@@ -422,6 +433,10 @@ SharedPtr<SegmentEntry> SegmentEntry::Deserialize(const nlohmann::json &segment_
         } else {
             LOG_TRACE("SegmentEntry::Deserialize: Cannot load FastRoughFilter from json file");
         }
+        auto statistics = MakeShared<SegmentStatistics>();
+        if (statistics->LoadFromJsonFile(segment_entry_json)) {
+            segment_entry->statistics_ = std::move(statistics);
+        }
     }
 
     LOG_TRACE(fmt::format("Segment: {}, Block count: {}", segment_entry->segment_id_, segment_entry->block_entries_.size()));
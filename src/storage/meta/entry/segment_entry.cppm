@@ -27,9 +27,11 @@ import infinity_exception;
 import txn;
 import txn_manager;
 import fast_rough_filter;
+import segment_statistics;
 import value;
 import meta_entry_interface;
 import cleanup_scanner;
+import catalog_snapshot;
 
 namespace infinity {
 
@@ -76,7 +78,8 @@ public:
                                                          TxnTimeStamp begin_ts,
                                                          TransactionID txn_id);
 
-    nlohmann::json Serialize(TxnTimeStamp max_commit_ts);
+    // With a snapshot writer, the segment and then each of its blocks are written as records, and no block is added to the result.
+    nlohmann::json Serialize(TxnTimeStamp max_commit_ts, CatalogSnapshotWriter *snapshot_writer = nullptr);
 
     static SharedPtr<SegmentEntry> Deserialize(const nlohmann::json &table_entry_json, TableEntry *table_entry, BufferManager *buffer_mgr);
 
@@ -117,6 +120,18 @@ public:
     const FastRoughFilter *GetFastRoughFilter() const { return &fast_rough_filter_; }
 
     void LoadFilterBinaryData(const String &segment_filter_data);
+
+    // nullptr before the segment is sealed
+    SharedPtr<const SegmentStatistics> GetStatistics() const {
+        std::shared_lock lock(rw_locker_);
+        return statistics_;
+    }
+
+    void SetStatistics(SharedPtr<const SegmentStatistics> statistics) {
+        std::unique_lock lock(rw_locker_);
+        statistics_ = std::move(statistics);
+    }
+
     static String SegmentStatusToString(const SegmentStatus &type);
 
 public:
@@ -208,6 +223,9 @@ private:
     // check if a value must not exist in the segment
     FastRoughFilter fast_rough_filter_;
 
+    // row counts, distinct count sketches and histograms for the cost model
+    SharedPtr<const SegmentStatistics> statistics_{};
+
     CompactSegmentsTask *compact_task_{};
     SegmentStatus status_;
 
@@ -55,7 +55,11 @@ import block_entry;
 import local_file_system;
 import column_length_io;
 import chunk_index_entry;
+import cleanup_scanner;
 import abstract_hnsw;
+import table_entry;
+import table_index_meta;
+import data_type;
 
 namespace infinity {
 
@@ -369,15 +373,23 @@ Status SegmentIndexEntry::CreateIndexPrepare(const SegmentEntry *segment_entry,
             break;
         }
         case IndexType::kSecondary: {
-            auto &data_type = column_def->type();
-            if (!(data_type->CanBuildSecondaryIndex())) {
-                UnrecoverableError(fmt::format("Cannot build secondary index on data type: {}", data_type->ToString()));
+            // key columns, the first one is column_def
+            Vector<ColumnID> column_ids;
+            Vector<SharedPtr<DataType>> data_types;
+            const TableEntry *table_entry = table_index_entry_->table_index_meta()->GetTableEntry();
+            for (const String &column_name : index_base->column_names_) {
+                const auto &key_column_def = table_entry->GetColumnDefByName(column_name);
+                if (!(key_column_def->type()->CanBuildSecondaryIndex())) {
+                    UnrecoverableError(fmt::format("Cannot build secondary index on data type: {}", key_column_def->type()->ToString()));
+                }
+                column_ids.push_back(key_column_def->id());
+                data_types.push_back(key_column_def->type());
             }
             // 1. build secondary index by merge sort
             u32 part_capacity = DEFAULT_BLOCK_CAPACITY;
             // fetch the row_count from segment_entry
-            auto secondary_index_builder = GetSecondaryIndexDataBuilder(data_type, segment_entry->row_count(), part_capacity);
-            secondary_index_builder->LoadSegmentData(segment_entry, buffer_mgr, column_def->id(), begin_ts, check_ts);
+            auto secondary_index_builder = GetSecondaryIndexDataBuilder(data_types, segment_entry->row_count(), part_capacity);
+            secondary_index_builder->LoadSegmentData(segment_entry, buffer_mgr, column_ids, begin_ts, check_ts);
             secondary_index_builder->StartOutput();
             // 2. output into SecondaryIndexDataPart
             {
@@ -479,7 +491,18 @@ void SegmentIndexEntry::Cleanup() {
     }
 }
 
-void SegmentIndexEntry::PickCleanup(CleanupScanner *scanner) {}
+void SegmentIndexEntry::PickCleanup(CleanupScanner *scanner) {
+    std::unique_lock lock(rw_locker_);
+    TxnTimeStamp visible_ts = scanner->visible_ts();
+    for (auto iter = deprecated_chunk_index_entries_.begin(); iter != deprecated_chunk_index_entries_.end();) {
+        if ((*iter)->CheckDeprecate(visible_ts)) {
+            scanner->AddEntry(std::move(*iter));
+            iter = deprecated_chunk_index_entries_.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
 
 UniquePtr<CreateIndexParam>
 SegmentIndexEntry::GetCreateIndexParam(SharedPtr<IndexBase> index_base, SizeT seg_row_count, SharedPtr<ColumnDef> column_def) {
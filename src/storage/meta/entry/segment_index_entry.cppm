@@ -114,7 +114,7 @@ public:
     }
 
     void ReplaceChunkIndexEntries(SharedPtr<ChunkIndexEntry> merged_chunk_index_entry) {
-        std::shared_lock lock(rw_locker_);
+        std::unique_lock lock(rw_locker_);
         SizeT num_entries = chunk_index_entries_.size();
         SizeT idx_first = num_entries;
         for (SizeT i = 0; i < num_entries; i++) {
@@ -134,6 +134,10 @@ public:
             }
         }
         assert(idx_last < num_entries);
+        // The replaced chunks are kept until cleanup, the txns that began before the merge commits may still read them.
+        deprecated_chunk_index_entries_.insert(deprecated_chunk_index_entries_.end(),
+                                               chunk_index_entries_.begin() + idx_first,
+                                               chunk_index_entries_.begin() + idx_last + 1);
         chunk_index_entries_[idx_first] = merged_chunk_index_entry;
         chunk_index_entries_.erase(chunk_index_entries_.begin() + idx_first + 1, chunk_index_entries_.begin() + idx_last + 1);
     }
@@ -149,6 +153,29 @@ public:
         }
         return {base_names, base_rowids, memory_indexer_.get()};
     }
+    // At most one merge of the chunk indexes of a segment runs at a time, be it OPTIMIZE or the background merge.
+    bool TrySetOptimizing() {
+        std::lock_guard lock(optimizing_mutex_);
+        if (optimizing_) {
+            return false;
+        }
+        optimizing_ = true;
+        return true;
+    }
+    // Blocks until the merge running on the segment, if any, is done.
+    void SetOptimizing() {
+        std::unique_lock lock(optimizing_mutex_);
+        optimizing_cv_.wait(lock, [this] { return !optimizing_; });
+        optimizing_ = true;
+    }
+    void ResetOptimizing() {
+        {
+            std::lock_guard lock(optimizing_mutex_);
+            optimizing_ = false;
+        }
+        optimizing_cv_.notify_all();
+    }
+
     Pair<u64, u32> GetFulltextColumnLenInfo() {
         std::shared_lock lock(rw_locker_);
         return {ft_column_len_sum_, ft_column_len_cnt_};
@@ -185,10 +212,15 @@ private:
     TxnTimeStamp checkpoint_ts_{0};
 
     Vector<SharedPtr<ChunkIndexEntry>> chunk_index_entries_{};
+    Vector<SharedPtr<ChunkIndexEntry>> deprecated_chunk_index_entries_{};
     UniquePtr<MemoryIndexer> memory_indexer_{};
 
     u64 ft_column_len_sum_{}; // increase only
     u32 ft_column_len_cnt_{}; // increase only
+
+    std::mutex optimizing_mutex_{};
+    std::condition_variable optimizing_cv_{};
+    bool optimizing_{false};
 };
 
 } // namespace infinity
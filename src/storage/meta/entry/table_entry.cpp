@@ -52,6 +52,8 @@ import segment_index_entry;
 import chunk_index_entry;
 import cleanup_scanner;
 import column_index_merger;
+import chunk_index_merge_policy;
+import rate_limiter;
 
 namespace infinity {
 
@@ -698,7 +700,6 @@ void TableEntry::MemIndexRecover(BufferManager *buffer_manager) {
 }
 
 void TableEntry::OptimizeIndex(Txn *txn) {
-    TxnTableStore *txn_table_store = txn->GetTxnTableStore(this);
     auto index_meta_map_guard = index_meta_map_.GetMetaMap();
     for (auto &[_, table_index_meta] : *index_meta_map_guard) {
         auto [table_index_entry, status] = table_index_meta->GetEntryNolock(txn->TxnID(), txn->BeginTS());
@@ -711,47 +712,104 @@ void TableEntry::OptimizeIndex(Txn *txn) {
             LOG_WARN(*err_msg);
             continue;
         }
-        const IndexFullText *index_fulltext = static_cast<const IndexFullText *>(index_base);
         for (auto &[segment_id, segment_index_entry] : table_index_entry->index_by_segment()) {
+            // Wait for the background merge of this segment, if any, then merge whatever it left.
+            segment_index_entry->SetOptimizing();
             Vector<SharedPtr<ChunkIndexEntry>> chunk_index_entries;
             segment_index_entry->GetChunkIndexEntries(chunk_index_entries);
-            if (chunk_index_entries.size() <= 1) {
-                continue;
+            if (chunk_index_entries.size() > 1) {
+                try {
+                    MergeChunkIndexEntries(txn, table_index_entry, segment_index_entry.get(), chunk_index_entries, nullptr);
+                } catch (...) {
+                    segment_index_entry->ResetOptimizing();
+                    throw;
+                }
             }
+            segment_index_entry->ResetOptimizing();
+        }
+    }
+}
 
-            Vector<String> base_names;
-            Vector<RowID> base_rowids;
-            RowID base_rowid = chunk_index_entries[0]->base_rowid_;
-            u32 total_row_count = 0;
-            for (SizeT i = 0; i < chunk_index_entries.size(); i++) {
-                auto &chunk_index_entry = chunk_index_entries[i];
-                base_names.push_back(chunk_index_entry->base_name_);
-                base_rowids.push_back(chunk_index_entry->base_rowid_);
-                total_row_count += chunk_index_entry->row_count_;
+SizeT TableEntry::OptimizeIndexChunks(Txn *txn, const TieredChunkMergePolicy &policy, RateLimiter *rate_limiter) {
+    SizeT merge_count = 0;
+    auto index_meta_map_guard = index_meta_map_.GetMetaMap();
+    for (auto &[_, table_index_meta] : *index_meta_map_guard) {
+        auto [table_index_entry, status] = table_index_meta->GetEntryNolock(txn->TxnID(), txn->BeginTS());
+        if (!status.ok() || table_index_entry->index_base()->index_type_ != IndexType::kFullText) {
+            continue;
+        }
+        for (auto &[segment_id, segment_index_entry] : table_index_entry->index_by_segment()) {
+            if (!segment_index_entry->TrySetOptimizing()) {
+                continue;
             }
-            String dst_base_name = fmt::format("ft_{}_{}", base_rowid.ToUint64(), total_row_count);
-            ColumnIndexMerger column_index_merger(*table_index_entry->index_dir_,
-                                                  index_fulltext->flag_,
-                                                  &table_index_entry->GetFulltextByteSlicePool(),
-                                                  &table_index_entry->GetFulltextBufferPool());
-            column_index_merger.Merge(base_names, base_rowids, dst_base_name);
-
-            for (SizeT i = 0; i < chunk_index_entries.size(); i++) {
-                auto &chunk_index_entry = chunk_index_entries[i];
-                // TODO yzc: txn_store.cpp:87
-                // chunk_index_entry->deleted_ = true;
-                txn_table_store->AddChunkIndexStore(table_index_entry, chunk_index_entry.get());
+            Vector<SharedPtr<ChunkIndexEntry>> chunk_index_entries;
+            segment_index_entry->GetChunkIndexEntries(chunk_index_entries);
+            Vector<u32> row_counts;
+            row_counts.reserve(chunk_index_entries.size());
+            for (const auto &chunk_index_entry : chunk_index_entries) {
+                row_counts.push_back(chunk_index_entry->row_count_);
             }
-            SharedPtr<ChunkIndexEntry> chunk_index_entry =
-                MakeShared<ChunkIndexEntry>(segment_index_entry.get(), dst_base_name, base_rowid, total_row_count);
-            txn_table_store->AddChunkIndexStore(table_index_entry, chunk_index_entry.get());
-            segment_index_entry->ReplaceChunkIndexEntries(chunk_index_entry);
-            // OPTIMIZE invoke this func at which the txn hasn't been commited yet.
-            TxnTimeStamp ts = std::max(txn->BeginTS(), txn->CommitTS());
-            assert(ts >= table_index_entry->GetFulltexSegmentUpdateTs());
-            table_index_entry->UpdateFulltextSegmentTs(ts);
+            auto [begin, end] = policy.Pick(row_counts);
+            if (end - begin > 1) {
+                Vector<SharedPtr<ChunkIndexEntry>> to_merge(chunk_index_entries.begin() + begin, chunk_index_entries.begin() + end);
+                try {
+                    MergeChunkIndexEntries(txn, table_index_entry, segment_index_entry.get(), to_merge, rate_limiter);
+                    ++merge_count;
+                } catch (RecoverableException &e) {
+                    // The segment keeps serving its old chunks, the merges of the other segments still commit.
+                    LOG_ERROR(fmt::format("Merge chunk index of segment {} failed: {}", segment_id, e.what()));
+                }
+            }
+            segment_index_entry->ResetOptimizing();
         }
     }
+    return merge_count;
+}
+
+void TableEntry::MergeChunkIndexEntries(Txn *txn,
+                                        TableIndexEntry *table_index_entry,
+                                        SegmentIndexEntry *segment_index_entry,
+                                        const Vector<SharedPtr<ChunkIndexEntry>> &chunk_index_entries,
+                                        RateLimiter *rate_limiter) {
+    TxnTableStore *txn_table_store = txn->GetTxnTableStore(this);
+    const IndexFullText *index_fulltext = static_cast<const IndexFullText *>(table_index_entry->index_base());
+    Vector<String> base_names;
+    Vector<RowID> base_rowids;
+    RowID base_rowid = chunk_index_entries[0]->base_rowid_;
+    u32 total_row_count = 0;
+    for (SizeT i = 0; i < chunk_index_entries.size(); i++) {
+        auto &chunk_index_entry = chunk_index_entries[i];
+        base_names.push_back(chunk_index_entry->base_name_);
+        base_rowids.push_back(chunk_index_entry->base_rowid_);
+        total_row_count += chunk_index_entry->row_count_;
+    }
+    String dst_base_name = fmt::format("ft_{}_{}", base_rowid.ToUint64(), total_row_count);
+    ColumnIndexMerger column_index_merger(*table_index_entry->index_dir_,
+                                          index_fulltext->flag_,
+                                          &table_index_entry->GetFulltextByteSlicePool(),
+                                          &table_index_entry->GetFulltextBufferPool());
+    try {
+        column_index_merger.Merge(base_names, base_rowids, dst_base_name, rate_limiter);
+    } catch (...) {
+        // Nothing is published before the merged chunk is complete, only its partial files are left to remove.
+        ChunkIndexEntry::CleanupFiles(*table_index_entry->index_dir_, dst_base_name);
+        throw;
+    }
+
+    for (SizeT i = 0; i < chunk_index_entries.size(); i++) {
+        auto &chunk_index_entry = chunk_index_entries[i];
+        txn_table_store->AddChunkIndexStore(table_index_entry, chunk_index_entry.get());
+        // Its files are deleted by cleanup once no txn can read it.
+        txn_table_store->DeprecateChunkIndexStore(table_index_entry, chunk_index_entry.get());
+    }
+    SharedPtr<ChunkIndexEntry> chunk_index_entry = MakeShared<ChunkIndexEntry>(segment_index_entry, dst_base_name, base_rowid, total_row_count);
+    txn_table_store->AddChunkIndexStore(table_index_entry, chunk_index_entry.get());
+    segment_index_entry->ReplaceChunkIndexEntries(chunk_index_entry);
+    // Invoked before the txn commits. Appends committed meanwhile may already have moved the segment update ts past
+    // the begin ts of this txn, and the reader cache requires it to never go backwards.
+    TxnTimeStamp ts = std::max(txn->BeginTS(), txn->CommitTS());
+    ts = std::max(ts, table_index_entry->GetFulltexSegmentUpdateTs());
+    table_index_entry->UpdateFulltextSegmentTs(ts);
 }
 
 SharedPtr<SegmentEntry> TableEntry::GetSegmentByID(SegmentID segment_id, TxnTimeStamp ts) const {
@@ -803,7 +861,7 @@ SharedPtr<BlockIndex> TableEntry::GetBlockIndex(TxnTimeStamp begin_ts) {
     return result;
 }
 
-nlohmann::json TableEntry::Serialize(TxnTimeStamp max_commit_ts) {
+nlohmann::json TableEntry::Serialize(TxnTimeStamp max_commit_ts, CatalogSnapshotWriter *snapshot_writer) {
     nlohmann::json json_res;
 
     Vector<SegmentEntry *> segment_candidates;
@@ -849,11 +907,19 @@ nlohmann::json TableEntry::Serialize(TxnTimeStamp max_commit_ts) {
         }
     }
 
+    json_res["unsealed_id"] = unsealed_id_;
+    if (snapshot_writer != nullptr) {
+        snapshot_writer->AddRecord(CatalogSnapshotRecordType::kTableEntry, json_res);
+    }
+
     // Serialize segments
     for (const auto &segment_entry : segment_candidates) {
-        json_res["segments"].emplace_back(segment_entry->Serialize(max_commit_ts));
+        if (snapshot_writer != nullptr) {
+            segment_entry->Serialize(max_commit_ts, snapshot_writer);
+        } else {
+            json_res["segments"].emplace_back(segment_entry->Serialize(max_commit_ts));
+        }
     }
-    json_res["unsealed_id"] = unsealed_id_;
 
     // Serialize indexes
     SizeT table_index_count = table_index_meta_candidates.size();
@@ -861,7 +927,11 @@ nlohmann::json TableEntry::Serialize(TxnTimeStamp max_commit_ts) {
         TableIndexMeta *table_index_meta = table_index_meta_candidates[idx];
         nlohmann::json index_def_meta_json = table_index_meta->Serialize(max_commit_ts);
         index_def_meta_json["index_name"] = table_index_name_candidates[idx];
-        json_res["table_indexes"].emplace_back(index_def_meta_json);
+        if (snapshot_writer != nullptr) {
+            snapshot_writer->AddRecord(CatalogSnapshotRecordType::kTableIndex, index_def_meta_json);
+        } else {
+            json_res["table_indexes"].emplace_back(index_def_meta_json);
+        }
     }
 
     return json_res;
@@ -937,6 +1007,55 @@ UniquePtr<TableEntry> TableEntry::Deserialize(const nlohmann::json &table_entry_
     return table_entry;
 }
 
+UniquePtr<TableEntry> TableEntry::Deserialize(CatalogSnapshotSection &section, TableMeta *table_meta, BufferManager *buffer_mgr) {
+    CatalogSnapshotRecordType record_type;
+    nlohmann::json record_json;
+    if (!section.Next(record_type, record_json) || record_type != CatalogSnapshotRecordType::kTableEntry) {
+        RecoverableError(Status::CatalogCorrupted(section.path()));
+    }
+    UniquePtr<TableEntry> table_entry = Deserialize(record_json, table_meta, buffer_mgr);
+
+    // Each block record belongs to the segment record before it.
+    SegmentEntry *segment_entry = nullptr;
+    while (section.Next(record_type, record_json)) {
+        switch (record_type) {
+            case CatalogSnapshotRecordType::kSegmentEntry: {
+                SharedPtr<SegmentEntry> new_segment_entry = SegmentEntry::Deserialize(record_json, table_entry.get(), buffer_mgr);
+                segment_entry = new_segment_entry.get();
+                table_entry->segment_map_.emplace(segment_entry->segment_id(), std::move(new_segment_entry));
+                break;
+            }
+            case CatalogSnapshotRecordType::kBlockEntry: {
+                if (segment_entry == nullptr) {
+                    RecoverableError(Status::CatalogCorrupted(section.path()));
+                }
+                SharedPtr<BlockEntry> block_entry = BlockEntry::Deserialize(record_json, segment_entry, buffer_mgr);
+                BlockID block_id = block_entry->block_id();
+                segment_entry->AddBlockReplay(std::move(block_entry), block_id);
+                break;
+            }
+            case CatalogSnapshotRecordType::kTableIndex: {
+                UniquePtr<TableIndexMeta> table_index_meta = TableIndexMeta::Deserialize(record_json, table_entry.get(), buffer_mgr);
+                String index_name = record_json["index_name"];
+                table_entry->index_meta_map().emplace(std::move(index_name), std::move(table_index_meta));
+                break;
+            }
+            default: {
+                RecoverableError(Status::CatalogCorrupted(section.path()));
+            }
+        }
+    }
+
+    // here the unsealed_segment_ may be nullptr
+    if (auto iter = table_entry->segment_map_.find(table_entry->unsealed_id_); iter != table_entry->segment_map_.end()) {
+        table_entry->unsealed_segment_ = iter->second;
+    }
+    if (table_entry->deleted_ && !table_entry->segment_map_.empty()) {
+        UnrecoverableError("deleted table should have no segment");
+    }
+    return table_entry;
+}
+
 u64 TableEntry::GetColumnIdByName(const String &column_name) const {
     auto it = column_name2column_id_.find(column_name);
     if (it == column_name2column_id_.end()) {
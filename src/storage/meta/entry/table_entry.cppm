@@ -43,11 +43,16 @@ import memory_pool;
 import meta_info;
 import block_entry;
 import column_index_reader;
+import chunk_index_merge_policy;
+import rate_limiter;
+import catalog_snapshot;
 
 namespace infinity {
 
 class IndexBase;
 struct TableIndexEntry;
+class SegmentIndexEntry;
+class ChunkIndexEntry;
 class TableMeta;
 class Txn;
 struct Catalog;
@@ -180,6 +185,17 @@ public:
 
     void OptimizeIndex(Txn *txn);
 
+    // Background counterpart of OptimizeIndex: merges at most one run of chunks per segment, picked by the policy, and skips segments
+    // that are being merged already. Returns the number of merges done.
+    SizeT OptimizeIndexChunks(Txn *txn, const TieredChunkMergePolicy &policy, RateLimiter *rate_limiter);
+
+private:
+    void MergeChunkIndexEntries(Txn *txn,
+                                TableIndexEntry *table_index_entry,
+                                SegmentIndexEntry *segment_index_entry,
+                                const Vector<SharedPtr<ChunkIndexEntry>> &chunk_index_entries,
+                                RateLimiter *rate_limiter);
+
 public:
     // Getter
 
@@ -212,10 +228,14 @@ public:
     void GetFulltextAnalyzers(TransactionID txn_id, TxnTimeStamp begin_ts, Map<String, String> &column2analyzer);
 
 public:
-    nlohmann::json Serialize(TxnTimeStamp max_commit_ts);
+    // With a snapshot writer, the table entry is written as records of the current section: the returned table entry fields first,
+    // then each segment followed by its blocks, then each index.
+    nlohmann::json Serialize(TxnTimeStamp max_commit_ts, CatalogSnapshotWriter *snapshot_writer = nullptr);
 
     static UniquePtr<TableEntry> Deserialize(const nlohmann::json &table_entry_json, TableMeta *table_meta, BufferManager *buffer_mgr);
 
+    static UniquePtr<TableEntry> Deserialize(CatalogSnapshotSection &section, TableMeta *table_meta, BufferManager *buffer_mgr);
+
     bool CheckDeleteConflict(const Vector<RowID> &delete_row_ids, TransactionID txn_id);
 
 public:
@@ -75,7 +75,8 @@ SharedPtr<TableIndexEntry> TableIndexEntry::NewTableIndexEntry(const SharedPtr<I
     auto table_index_entry = MakeShared<TableIndexEntry>(index_base, is_delete, table_index_meta, index_dir, txn_id, begin_ts);
 
     // Get column info
-    if (index_base->column_names_.size() != 1) {
+    // only secondary index can be built on several columns
+    if (index_base->column_names_.size() != 1 and index_base->index_type_ != IndexType::kSecondary) {
         RecoverableError(Status::SyntaxError("Currently, composite index doesn't supported."));
     }
     return table_index_entry;
@@ -266,7 +267,7 @@ TableIndexEntry::CreateIndexPrepare(TableEntry *table_entry, BlockIndex *block_i
 }
 
 Status TableIndexEntry::CreateIndexDo(const TableEntry *table_entry, HashMap<SegmentID, atomic_u64> &create_index_idxes) {
-    if (this->index_base_->column_names_.size() != 1) {
+    if (this->index_base_->column_names_.size() != 1 and this->index_base_->index_type_ != IndexType::kSecondary) {
         // TODO
         RecoverableError(Status::NotSupport("Not implemented"));
     }
@@ -401,7 +402,12 @@ void TableIndexEntry::Cleanup() {
     fs.DeleteDirectory(*index_dir_);
 }
 
-void TableIndexEntry::PickCleanup(CleanupScanner *scanner) {}
+void TableIndexEntry::PickCleanup(CleanupScanner *scanner) {
+    std::shared_lock lock(rw_locker_);
+    for (auto &[segment_id, segment_index_entry] : index_by_segment_) {
+        segment_index_entry->PickCleanup(scanner);
+    }
+}
 
 void TableIndexEntry::PickCleanupBySegments(const Vector<SegmentID> &sorted_segment_ids, CleanupScanner *scanner) {
     for (auto iter = index_by_segment_.begin(); iter != index_by_segment_.end();) {
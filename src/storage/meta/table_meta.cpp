@@ -153,7 +153,7 @@ SharedPtr<String> TableMeta::ToString() {
     return res;
 }
 
-nlohmann::json TableMeta::Serialize(TxnTimeStamp max_commit_ts) {
+nlohmann::json TableMeta::Serialize(TxnTimeStamp max_commit_ts, CatalogSnapshotWriter *snapshot_writer) {
     nlohmann::json json_res;
     Vector<TableEntry *> table_candidates;
     {
@@ -170,7 +170,15 @@ nlohmann::json TableMeta::Serialize(TxnTimeStamp max_commit_ts) {
         }
     }
     for (TableEntry *table_entry : table_candidates) {
-        json_res["table_entries"].emplace_back(table_entry->Serialize(max_commit_ts));
+        if (snapshot_writer == nullptr) {
+            json_res["table_entries"].emplace_back(table_entry->Serialize(max_commit_ts));
+        } else {
+            // The table entry is written out segment by segment, only a reference to its section stays in the skeleton.
+            u32 section_id = snapshot_writer->BeginSection();
+            table_entry->Serialize(max_commit_ts, snapshot_writer);
+            snapshot_writer->EndSection();
+            json_res["table_entries"].emplace_back(nlohmann::json{{"snapshot_section", section_id}});
+        }
     }
     return json_res;
 }
@@ -184,14 +192,36 @@ nlohmann::json TableMeta::Serialize(TxnTimeStamp max_commit_ts) {
  *        The dummy entry is added during the deserialization.
  * @param table_meta_json
  * @param db_entry
+ *        With a snapshot reader, the table entries are stored in sections of the snapshot, and are loaded later by
+ *        CatalogSnapshotReader::LoadTables together with the ones of the other tables.
  * @param buffer_mgr
  * @return UniquePtr<TableMeta>
  */
-UniquePtr<TableMeta> TableMeta::Deserialize(const nlohmann::json &table_meta_json, DBEntry *db_entry, BufferManager *buffer_mgr) {
+UniquePtr<TableMeta>
+TableMeta::Deserialize(const nlohmann::json &table_meta_json, DBEntry *db_entry, BufferManager *buffer_mgr, CatalogSnapshotReader *snapshot_reader) {
     SharedPtr<String> db_entry_dir = MakeShared<String>(table_meta_json["db_entry_dir"]);
     SharedPtr<String> table_name = MakeShared<String>(table_meta_json["table_name"]);
     LOG_TRACE(fmt::format("load table {}", *table_name));
     UniquePtr<TableMeta> res = MakeUnique<TableMeta>(db_entry_dir, table_name, db_entry);
+    if (snapshot_reader != nullptr) {
+        Vector<u32> section_ids;
+        if (table_meta_json.contains("table_entries")) {
+            for (const auto &table_entry_json : table_meta_json["table_entries"]) {
+                section_ids.push_back(table_entry_json["snapshot_section"]);
+            }
+        }
+        TableMeta *table_meta = res.get();
+        snapshot_reader->AddTableLoad([table_meta, section_ids = std::move(section_ids), buffer_mgr, snapshot_reader] {
+            for (u32 section_id : section_ids) {
+                CatalogSnapshotSection section = snapshot_reader->Section(section_id);
+                UniquePtr<TableEntry> table_entry = TableEntry::Deserialize(section, table_meta, buffer_mgr);
+                table_meta->table_entry_list().emplace_back(std::move(table_entry));
+            }
+            table_meta->table_entry_list().sort(
+                [](const SharedPtr<BaseEntry> &ent1, const SharedPtr<BaseEntry> &ent2) { return ent1->commit_ts_ > ent2->commit_ts_; });
+        });
+        return res;
+    }
     if (table_meta_json.contains("table_entries")) {
         for (const auto &table_entry_json : table_meta_json["table_entries"]) {
             UniquePtr<TableEntry> table_entry = TableEntry::Deserialize(table_entry_json, res.get(), buffer_mgr);
@@ -31,6 +31,7 @@ import entry_list;
 import meta_info;
 import meta_entry_interface;
 import cleanup_scanner;
+import catalog_snapshot;
 
 namespace infinity {
 
@@ -51,9 +52,12 @@ public:
 
     SharedPtr<String> ToString();
 
-    nlohmann::json Serialize(TxnTimeStamp max_commit_ts);
+    nlohmann::json Serialize(TxnTimeStamp max_commit_ts, CatalogSnapshotWriter *snapshot_writer = nullptr);
 
-    static UniquePtr<TableMeta> Deserialize(const nlohmann::json &table_meta_json, DBEntry *db_entry, BufferManager *buffer_mgr);
+    static UniquePtr<TableMeta> Deserialize(const nlohmann::json &table_meta_json,
+                                            DBEntry *db_entry,
+                                            BufferManager *buffer_mgr,
+                                            CatalogSnapshotReader *snapshot_reader = nullptr);
 
     [[nodiscard]] const SharedPtr<String> &table_name_ptr() const { return table_name_; }
     [[nodiscard]] const String &table_name() const { return *table_name_; }
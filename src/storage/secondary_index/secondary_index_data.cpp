@@ -31,7 +31,10 @@ import third_party;
 import segment_iter;
 import buffer_manager;
 import secondary_index_pgm;
+import secondary_index_key;
 import logger;
+import block_entry;
+import block_column_iter;
 
 namespace infinity {
 
@@ -78,9 +81,16 @@ public:
 
     ~SecondaryIndexDataBuilder() final = default;
 
-    void
-    LoadSegmentData(const SegmentEntry *segment_entry, BufferManager *buffer_mgr, ColumnID column_id, TxnTimeStamp begin_ts, bool check_ts) final {
+    void LoadSegmentData(const SegmentEntry *segment_entry,
+                         BufferManager *buffer_mgr,
+                         const Vector<ColumnID> &column_ids,
+                         TxnTimeStamp begin_ts,
+                         bool check_ts) final {
         static_assert(std::is_same_v<OffsetType, SegmentOffset>, "OffsetType != SegmentOffset, need to fix");
+        if (column_ids.size() != 1) {
+            UnrecoverableError("LoadSegmentData(): index on number type should have only one column.");
+        }
+        ColumnID column_id = column_ids[0];
         if (check_ts) {
             OneColumnIterator<RawValueType> iter(segment_entry, buffer_mgr, column_id, begin_ts);
             return LoadFromSegmentColumnIterator(iter, sorted_key_offset_pair_, full_data_num_, data_num_);
@@ -223,11 +233,210 @@ private:
     UniquePtr<KeyType[]> sorted_keys_;                       // for pgm. Will be created in StartOutput().
 };
 
-UniquePtr<SecondaryIndexDataBuilderBase> GetSecondaryIndexDataBuilder(const SharedPtr<DataType> &data_type, u32 full_data_num, u32 part_capacity) {
-    if (!(data_type->CanBuildSecondaryIndex())) {
-        UnrecoverableError(fmt::format("Cannot build secondary index on data type: {}", data_type->ToString()));
+template <bool CheckTS>
+inline void LoadEncodedKeysFromSegment(const SegmentEntry *segment_entry,
+                                       BufferManager *buffer_mgr,
+                                       const Vector<ColumnID> &column_ids,
+                                       TxnTimeStamp begin_ts,
+                                       Vector<Pair<String, SegmentOffset>> &key_offset_pairs,
+                                       const u32 full_data_num) {
+    BlockEntryIter block_entry_iter(segment_entry);
+    for (auto *block_entry = block_entry_iter.Next(); block_entry != nullptr; block_entry = block_entry_iter.Next()) {
+        Vector<BlockColumnIter<CheckTS>> column_iters;
+        column_iters.reserve(column_ids.size());
+        for (ColumnID column_id : column_ids) {
+            column_iters.emplace_back(block_entry->GetColumnBlockEntry(column_id), buffer_mgr, begin_ts);
+        }
+        // FIXME: segment_entry should store the block capacity
+        const SegmentOffset block_offset = block_entry->block_id() * DEFAULT_BLOCK_CAPACITY;
+        while (true) {
+            auto first_opt = column_iters[0].Next();
+            if (!first_opt) {
+                break;
+            }
+            if (key_offset_pairs.size() >= full_data_num) {
+                UnrecoverableError("LoadEncodedKeysFromSegment(): segment row count more than expected");
+            }
+            BlockOffset offset = first_opt->second;
+            for (SizeT i = 1; i < column_iters.size(); ++i) {
+                column_iters[i].Next();
+            }
+            String key;
+            for (auto &column_iter : column_iters) {
+                AppendSecondaryIndexKey(key, column_iter.column_vector()->GetValue(offset));
+            }
+            key_offset_pairs.emplace_back(std::move(key), block_offset + offset);
+        }
+    }
+    // finally, sort
+    std::sort(key_offset_pairs.begin(), key_offset_pairs.end());
+}
+
+// Builder of the index on varchar column or on several columns.
+// Keys are encoded by AppendSecondaryIndexKey(), the parts store the u64 key prefixes and the overflow bytes,
+// and the PGM index in SecondaryIndexDataHead is built on the key prefixes.
+class SecondaryIndexEncodedKeyDataBuilder final : public SecondaryIndexDataBuilderBase {
+public:
+    explicit SecondaryIndexEncodedKeyDataBuilder(u32 full_data_num, u32 part_capacity)
+        : full_data_num_(full_data_num), output_part_capacity_(part_capacity) {
+        output_part_num_ = (full_data_num + output_part_capacity_ - 1) / output_part_capacity_;
+        key_offset_pairs_.reserve(full_data_num_);
+    }
+
+    ~SecondaryIndexEncodedKeyDataBuilder() final = default;
+
+    void LoadSegmentData(const SegmentEntry *segment_entry,
+                         BufferManager *buffer_mgr,
+                         const Vector<ColumnID> &column_ids,
+                         TxnTimeStamp begin_ts,
+                         bool check_ts) final {
+        if (!key_offset_pairs_.empty()) {
+            UnrecoverableError("LoadSegmentData(): data is already loaded");
+        }
+        if (check_ts) {
+            LoadEncodedKeysFromSegment<true>(segment_entry, buffer_mgr, column_ids, begin_ts, key_offset_pairs_, full_data_num_);
+        } else {
+            LoadEncodedKeysFromSegment<false>(segment_entry, buffer_mgr, column_ids, begin_ts, key_offset_pairs_, full_data_num_);
+        }
+        data_num_ = key_offset_pairs_.size();
+    }
+
+    void StartOutput() final {
+        output_row_progress_ = 0;
+        output_part_progress_ = 0;
+        sorted_prefixes_ = MakeUniqueForOverwrite<u64[]>(data_num_);
+        LOG_TRACE(fmt::format("StartOutput(), output_row_progress_: {}, data_num_: {}.", output_row_progress_, data_num_));
+    }
+
+    void EndOutput() final {
+        if (output_row_progress_ != data_num_) {
+            UnrecoverableError("EndOutput(): output is not complete: output_row_progress_ != data_num_.");
+        }
+        if (output_part_progress_ != output_part_num_ + 1) {
+            UnrecoverableError("EndOutput(): output is not complete: output_part_progress_ != output_part_num_ + 1.");
+        }
+        sorted_prefixes_.reset();
+        LOG_TRACE(fmt::format("EndOutput(), output_row_progress_: {}, data_num_: {}.", output_row_progress_, data_num_));
+    }
+
+    void OutputToHeader(SecondaryIndexDataHead *index_head) final {
+        if (output_part_progress_ != output_part_num_ or output_row_progress_ != data_num_) {
+            UnrecoverableError("OutputToHeader(): need to call OutputToHeader() after OutputToPart().");
+        }
+        // 1. metadata
+        {
+            if (index_head->full_data_num_ != full_data_num_) {
+                UnrecoverableError("OutputToHeader(): error: index_head->full_data_num_ != full_data_num_");
+            }
+            if (index_head->data_num_ != 0) {
+                UnrecoverableError("OutputToHeader(): index_head->data_num_ already exist");
+            }
+            index_head->data_num_ = data_num_;
+            if (index_head->part_capacity_ != output_part_capacity_ or index_head->part_num_ != output_part_num_) {
+                UnrecoverableError("OutputToHeader(): error: part capacity or part number mismatch");
+            }
+            index_head->data_type_key_ = LogicalType::kVarchar;
+            index_head->data_type_offset_ = LogicalType::kInteger;
+        }
+        // 2. pgm on key prefixes
+        key_offset_pairs_.clear();
+        key_offset_pairs_.shrink_to_fit(); // release some memory
+        {
+            index_head->pgm_index_ = GenerateSecondaryPGMIndex<u64>();
+            index_head->pgm_index_->BuildIndex(data_num_, sorted_prefixes_.get());
+            LOG_TRACE("OutputToHeader(): Successfully built pgm index on key prefixes.");
+        }
+        // 3. finish
+        ++output_part_progress_;
+        index_head->loaded_ = true;
+        LOG_TRACE(fmt::format("OutputToHeader(), output_row_progress_: {}, data_num_: {}.", output_row_progress_, data_num_));
+    }
+
+    void OutputToPart(SecondaryIndexDataPart *index_part) final {
+        if (output_part_progress_ != index_part->part_id_) {
+            UnrecoverableError("OutputToPart(): error: unexpected index_part->part_id_ value");
+        }
+        if (auto expect_size = std::min(output_part_capacity_, data_num_ - output_row_progress_); expect_size != index_part->part_size_) {
+            if (index_part->part_size_ < expect_size) {
+                UnrecoverableError("OutputToPart(): error: index_part->part_size_");
+            } else {
+                LOG_INFO(fmt::format("OutputToPart(): index_part->part_size_: {}, expect_size: {}. Maybe some rows are deleted.",
+                                     index_part->part_size_,
+                                     expect_size));
+                index_part->part_size_ = expect_size;
+            }
+        }
+        if (index_part->part_size_ == 0) {
+            index_part->loaded_ = true;
+            ++output_part_progress_;
+            return;
+        }
+        index_part->data_type_key_ = LogicalType::kVarchar;
+        index_part->data_type_offset_ = LogicalType::kInteger;
+        {
+            index_part->column_key_ = MakeUnique<ColumnVector>(MakeShared<DataType>(LogicalType::kBigInt));
+            index_part->column_key_->Initialize();
+            index_part->column_offset_ = MakeUnique<ColumnVector>(MakeShared<DataType>(LogicalType::kInteger));
+            index_part->column_offset_->Initialize();
+            auto prefix_ptr = reinterpret_cast<u64 *>(index_part->column_key_->data());
+            auto offset_ptr = reinterpret_cast<SegmentOffset *>(index_part->column_offset_->data());
+            index_part->key_overflow_offsets_.clear();
+            index_part->key_overflow_offsets_.reserve(index_part->part_size_ + 1);
+            index_part->key_overflow_data_.clear();
+            for (u32 i = 0; i < index_part->part_size_; ++i) {
+                const auto &[key, offset] = key_offset_pairs_[output_row_progress_ + i];
+                prefix_ptr[i] = SecondaryIndexKeyPrefix(key);
+                offset_ptr[i] = offset;
+                index_part->key_overflow_offsets_.push_back(index_part->key_overflow_data_.size());
+                index_part->key_overflow_data_.append(SecondaryIndexKeyOverflow(key));
+            }
+            index_part->key_overflow_offsets_.push_back(index_part->key_overflow_data_.size());
+            std::copy(prefix_ptr, prefix_ptr + index_part->part_size_, sorted_prefixes_.get() + output_row_progress_);
+            index_part->column_key_->Finalize(index_part->part_size_);
+            index_part->column_offset_->Finalize(index_part->part_size_);
+        }
+        index_part->loaded_ = true;
+        output_row_progress_ += index_part->part_size_;
+        ++output_part_progress_;
+        LOG_TRACE(fmt::format("OutputToPart(), output_row_progress_: {}, data_num_: {}.", output_row_progress_, data_num_));
+    }
+
+private:
+    const u32 full_data_num_{};                           // number of rows in the segment, include those deleted
+    u32 data_num_{};                                      // number of rows in the segment, except those deleted
+    Vector<Pair<String, SegmentOffset>> key_offset_pairs_; // sorted (encoded key, offset) pairs. Will be released in OutputToHeader().
+
+private:
+    u32 output_part_capacity_{};      // number of rows in each full output part
+    u32 output_part_num_{};           // number of output parts
+    u32 output_row_progress_{};       // record output progress
+    u32 output_part_progress_{};      // record output progress
+    UniquePtr<u64[]> sorted_prefixes_; // for pgm. Will be created in StartOutput().
+};
+
+LogicalType GetSecondaryIndexKeyType(const Vector<SharedPtr<DataType>> &data_types) {
+    if (data_types.size() == 1 and data_types[0]->type() != LogicalType::kVarchar) {
+        return data_types[0]->type();
+    }
+    return LogicalType::kVarchar;
+}
+
+UniquePtr<SecondaryIndexDataBuilderBase>
+GetSecondaryIndexDataBuilder(const Vector<SharedPtr<DataType>> &data_types, u32 full_data_num, u32 part_capacity) {
+    if (data_types.empty()) {
+        UnrecoverableError("Cannot build secondary index without column");
         return {};
     }
+    for (const auto &data_type : data_types) {
+        if (!(data_type->CanBuildSecondaryIndex())) {
+            UnrecoverableError(fmt::format("Cannot build secondary index on data type: {}", data_type->ToString()));
+            return {};
+        }
+    }
+    if (GetSecondaryIndexKeyType(data_types) == LogicalType::kVarchar) {
+        return MakeUnique<SecondaryIndexEncodedKeyDataBuilder>(full_data_num, part_capacity);
+    }
+    const auto &data_type = data_types[0];
     switch (data_type->type()) {
         case LogicalType::kTinyInt: {
             return MakeUnique<SecondaryIndexDataBuilder<TinyIntT>>(full_data_num, part_capacity);
@@ -319,6 +528,11 @@ void SecondaryIndexDataHead::ReadIndexInner(FileHandler &file_handler) {
             pgm_index_ = GenerateSecondaryPGMIndex<DoubleT>();
             break;
         }
+        case LogicalType::kVarchar: {
+            // encoded keys, pgm on key prefixes
+            pgm_index_ = GenerateSecondaryPGMIndex<u64>();
+            break;
+        }
         default: {
             UnrecoverableError(fmt::format("Need to add support for data type: {}", DataType(data_type_key_).ToString()));
         }
@@ -351,6 +565,11 @@ void SecondaryIndexDataPart::SaveIndexInner(FileHandler &file_handler) const {
         UnrecoverableError("SaveIndexInner(): error: column_offset_ size != part_size_.");
     }
     file_handler.Write(column_offset_->data(), part_size_ * (column_offset_->data_type_size_));
+    // overflow bytes of encoded keys
+    if (data_type_key_ == LogicalType::kVarchar) {
+        file_handler.Write(key_overflow_offsets_.data(), (part_size_ + 1) * sizeof(u32));
+        file_handler.Write(key_overflow_data_.data(), key_overflow_offsets_.back());
+    }
     LOG_TRACE(fmt::format("SaveIndexInner() done. part_id_: {}.", part_id_));
 }
 
@@ -365,7 +584,8 @@ void SecondaryIndexDataPart::ReadIndexInner(FileHandler &file_handler) {
     }
     // key type
     file_handler.Read(&data_type_key_, sizeof(data_type_key_));
-    auto data_type_key = MakeShared<DataType>(data_type_key_);
+    // encoded keys: u64 key prefixes are stored in a BigIntT column
+    auto data_type_key = MakeShared<DataType>(data_type_key_ == LogicalType::kVarchar ? LogicalType::kBigInt : data_type_key_);
     // offset type
     file_handler.Read(&data_type_offset_, sizeof(data_type_offset_));
     if (data_type_offset_ != LogicalType::kInteger) {
@@ -382,6 +602,13 @@ void SecondaryIndexDataPart::ReadIndexInner(FileHandler &file_handler) {
     column_offset_->Initialize();
     file_handler.Read(column_offset_->data(), part_size_ * (column_offset_->data_type_size_));
     column_offset_->Finalize(part_size_);
+    // overflow bytes of encoded keys
+    if (data_type_key_ == LogicalType::kVarchar) {
+        key_overflow_offsets_.resize(part_size_ + 1);
+        file_handler.Read(key_overflow_offsets_.data(), (part_size_ + 1) * sizeof(u32));
+        key_overflow_data_.resize(key_overflow_offsets_.back());
+        file_handler.Read(key_overflow_data_.data(), key_overflow_offsets_.back());
+    }
     // update loaded_
     loaded_ = true;
     LOG_TRACE(fmt::format("ReadIndexInner() done. part_id_: {}.", part_id_));
@@ -119,8 +119,11 @@ class SecondaryIndexDataBuilderBase {
 public:
     SecondaryIndexDataBuilderBase() = default;
     virtual ~SecondaryIndexDataBuilderBase() = default;
-    virtual void
-    LoadSegmentData(const SegmentEntry *segment_entry, BufferManager *buffer_mgr, ColumnID column_id, TxnTimeStamp begin_ts, bool check_ts) = 0;
+    virtual void LoadSegmentData(const SegmentEntry *segment_entry,
+                                 BufferManager *buffer_mgr,
+                                 const Vector<ColumnID> &column_ids,
+                                 TxnTimeStamp begin_ts,
+                                 bool check_ts) = 0;
     virtual void StartOutput() = 0;
     virtual void EndOutput() = 0;
     virtual void OutputToHeader(SecondaryIndexDataHead *index_head) = 0;
@@ -128,18 +131,22 @@ public:
 };
 
 // create a secondary index on each segment
-// now only support index for single column
-// now only support create index for POD type with size <= sizeof(i64)
-// need to convert values in column into ordered number type
+// single column of POD type with size <= sizeof(i64): values in column are converted into ordered number type
+// varchar column or composite key (data_types.size() > 1): values are encoded into order preserving keys, see secondary_index_key
 // data_num : number of rows in the segment, except those deleted
 export UniquePtr<SecondaryIndexDataBuilderBase>
-GetSecondaryIndexDataBuilder(const SharedPtr<DataType> &data_type, u32 full_data_num, u32 part_capacity);
+GetSecondaryIndexDataBuilder(const Vector<SharedPtr<DataType>> &data_types, u32 full_data_num, u32 part_capacity);
+
+// key type of the index on the columns, LogicalType::kVarchar for the encoded keys
+export LogicalType GetSecondaryIndexKeyType(const Vector<SharedPtr<DataType>> &data_types);
 
 // includes: metadata and PGM index
+// for encoded keys (data_type_key_ is kVarchar), the PGM index is built on the u64 key prefixes
 class SecondaryIndexDataHead {
     friend class SecondaryIndexDataBuilderBase;
     template <typename ValueT>
     friend class SecondaryIndexDataBuilder;
+    friend class SecondaryIndexEncodedKeyDataBuilder;
 
 private:
     bool loaded_{false};  // whether data of this part is in memory
@@ -174,6 +181,7 @@ public:
     [[nodiscard]] u32 GetPartCapacity() const { return part_capacity_; }
     [[nodiscard]] u32 GetPartNum() const { return part_num_; }
     [[nodiscard]] u32 GetDataNum() const { return data_num_; }
+    [[nodiscard]] bool IsEncodedKey() const { return data_type_key_ == LogicalType::kVarchar; }
 
     [[nodiscard]] auto SearchPGM(const void *val_ptr) const {
         if (!pgm_index_) {
@@ -189,10 +197,13 @@ public:
 
 // an index may include several parts
 // includes: a part of keys and corresponding offsets in the segment
+// for encoded keys, column_key_ holds the u64 key prefixes and the overflow bytes of key i are
+// key_overflow_data_[key_overflow_offsets_[i], key_overflow_offsets_[i + 1])
 class SecondaryIndexDataPart {
     friend class SecondaryIndexDataBuilderBase;
     template <typename ValueT>
     friend class SecondaryIndexDataBuilder;
+    friend class SecondaryIndexEncodedKeyDataBuilder;
 
 private:
     bool loaded_{false}; // whether data of this part is in memory
@@ -204,6 +215,9 @@ private:
     // key-offset pairs
     UniquePtr<ColumnVector> column_key_;
     UniquePtr<ColumnVector> column_offset_;
+    // overflow bytes of encoded keys
+    Vector<u32> key_overflow_offsets_;
+    String key_overflow_data_;
 
 public:
     // will be called when an old index is loaded
@@ -224,6 +238,10 @@ public:
 
     [[nodiscard]] const void *GetColumnOffsetData() const { return column_offset_->data(); }
 
+    [[nodiscard]] std::string_view GetKeyOverflow(u32 i) const {
+        return std::string_view(key_overflow_data_).substr(key_overflow_offsets_[i], key_overflow_offsets_[i + 1] - key_overflow_offsets_[i]);
+    }
+
     void SaveIndexInner(FileHandler &file_handler) const;
 
     void ReadIndexInner(FileHandler &file_handler);
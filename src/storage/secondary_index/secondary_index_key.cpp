@@ -0,0 +1,140 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+module;
+
+#include <string>
+
+module secondary_index_key;
+
+import stl;
+import value;
+import logical_type;
+import internal_types;
+import infinity_exception;
+import third_party;
+
+namespace infinity {
+
+bool CanEncodeSecondaryIndexKey(LogicalType type) {
+    switch (type) {
+        case LogicalType::kTinyInt:
+        case LogicalType::kSmallInt:
+        case LogicalType::kInteger:
+        case LogicalType::kBigInt:
+        case LogicalType::kFloat:
+        case LogicalType::kDouble:
+        case LogicalType::kDate:
+        case LogicalType::kTime:
+        case LogicalType::kDateTime:
+        case LogicalType::kTimestamp:
+        case LogicalType::kVarchar: {
+            return true;
+        }
+        default: {
+            return false;
+        }
+    }
+}
+
+void AppendSecondaryIndexKeyVarchar(String &key, std::string_view value) {
+    key.reserve(key.size() + value.size() + 2);
+    for (char c : value) {
+        key.push_back(c);
+        if (c == '\0') {
+            key.push_back('\xFF');
+        }
+    }
+    key.push_back('\0');
+    key.push_back('\0');
+}
+
+void AppendSecondaryIndexKey(String &key, const Value &value) {
+    switch (value.type().type()) {
+        case LogicalType::kTinyInt: {
+            return AppendSecondaryIndexKeyT(key, value.GetValue<TinyIntT>());
+        }
+        case LogicalType::kSmallInt: {
+            return AppendSecondaryIndexKeyT(key, value.GetValue<SmallIntT>());
+        }
+        case LogicalType::kInteger: {
+            return AppendSecondaryIndexKeyT(key, value.GetValue<IntegerT>());
+        }
+        case LogicalType::kBigInt: {
+            return AppendSecondaryIndexKeyT(key, value.GetValue<BigIntT>());
+        }
+        case LogicalType::kFloat: {
+            return AppendSecondaryIndexKeyT(key, value.GetValue<FloatT>());
+        }
+        case LogicalType::kDouble: {
+            return AppendSecondaryIndexKeyT(key, value.GetValue<DoubleT>());
+        }
+        case LogicalType::kDate: {
+            return AppendSecondaryIndexKeyT(key, value.GetValue<DateT>().GetValue());
+        }
+        case LogicalType::kTime: {
+            return AppendSecondaryIndexKeyT(key, value.GetValue<TimeT>().GetValue());
+        }
+        case LogicalType::kDateTime: {
+            return AppendSecondaryIndexKeyT(key, value.GetValue<DateTimeT>().GetEpochTime());
+        }
+        case LogicalType::kTimestamp: {
+            return AppendSecondaryIndexKeyT(key, value.GetValue<TimestampT>().GetEpochTime());
+        }
+        case LogicalType::kVarchar: {
+            return AppendSecondaryIndexKeyVarchar(key, value.GetVarchar());
+        }
+        default: {
+            UnrecoverableError(fmt::format("AppendSecondaryIndexKey(): unsupported type: {}.", value.type().ToString()));
+        }
+    }
+}
+
+String SecondaryIndexKeySuccessor(const String &key) {
+    String successor = key;
+    while (!successor.empty()) {
+        auto &last = reinterpret_cast<u8 &>(successor.back());
+        if (last != 0xFF) {
+            ++last;
+            return successor;
+        }
+        successor.pop_back();
+    }
+    return successor;
+}
+
+u64 SecondaryIndexKeyPrefix(std::string_view key) {
+    u64 prefix = 0;
+    SizeT prefix_len = std::min(key.size(), kSecondaryIndexKeyPrefixBytes);
+    for (SizeT i = 0; i < prefix_len; ++i) {
+        prefix |= u64(static_cast<u8>(key[i])) << ((7 - i) * 8);
+    }
+    return prefix | std::min<u64>(key.size(), kSecondaryIndexKeyPrefixBytes + 1);
+}
+
+std::string_view SecondaryIndexKeyOverflow(std::string_view key) {
+    return key.size() > kSecondaryIndexKeyPrefixBytes ? key.substr(kSecondaryIndexKeyPrefixBytes) : std::string_view();
+}
+
+i32 CompareSecondaryIndexKey(u64 prefix, std::string_view overflow, u64 other_prefix, std::string_view other_overflow) {
+    if (prefix != other_prefix) {
+        return prefix < other_prefix ? -1 : 1;
+    }
+    // equal prefixes: both keys are shorter than 8 bytes and equal, or both have overflow bytes
+    i32 cmp = overflow.compare(other_overflow);
+    return cmp < 0 ? -1 : (cmp > 0 ? 1 : 0);
+}
+
+} // namespace infinity
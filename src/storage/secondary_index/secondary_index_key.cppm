@@ -0,0 +1,81 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+module;
+
+#include <type_traits>
+
+export module secondary_index_key;
+
+import stl;
+import value;
+import logical_type;
+import internal_types;
+
+namespace infinity {
+
+// Order preserving key of the secondary index on varchar and composite columns.
+// The encoded keys compare with memcmp in the same order as the values, column after column:
+//  - integers: big endian with the sign bit flipped
+//  - floating point: big endian, sign bit flipped for positive values, all bits flipped for negative values
+//  - date, time: as IntegerT. datetime, timestamp: as the BigIntT epoch time
+//  - varchar: 0x00 is escaped to 0x00 0xFF and the string ends with 0x00 0x00,
+//    so that no encoded value is a prefix of another value of the same column
+
+export bool CanEncodeSecondaryIndexKey(LogicalType type);
+
+export template <typename T>
+    requires std::is_arithmetic_v<T>
+void AppendSecondaryIndexKeyT(String &key, T value) {
+    using U = std::conditional_t<sizeof(T) == 1, u8, std::conditional_t<sizeof(T) == 2, u16, std::conditional_t<sizeof(T) == 4, u32, u64>>>;
+    U bits{};
+    if constexpr (std::is_floating_point_v<T>) {
+        // -0.0 and 0.0 are the same key
+        bits = value == 0 ? U{} : std::bit_cast<U>(value);
+        constexpr U sign_bit = U(1) << (sizeof(U) * 8 - 1);
+        bits = (bits & sign_bit) ? ~bits : (bits | sign_bit);
+    } else {
+        bits = static_cast<U>(value);
+        if constexpr (std::is_signed_v<T>) {
+            bits ^= U(1) << (sizeof(U) * 8 - 1);
+        }
+    }
+    for (SizeT i = sizeof(U); i > 0; --i) {
+        key.push_back(static_cast<char>(bits >> ((i - 1) * 8)));
+    }
+}
+
+export void AppendSecondaryIndexKeyVarchar(String &key, std::string_view value);
+
+// value type needs to be CanEncodeSecondaryIndexKey()
+export void AppendSecondaryIndexKey(String &key, const Value &value);
+
+// The smallest key that is greater than every key starting with "key".
+// Empty if there is none, which is used as "no upper bound".
+export String SecondaryIndexKeySuccessor(const String &key);
+
+// A stored key is split into a u64 prefix, which the PGM index is built on, and the overflow bytes.
+// prefix: the first kSecondaryIndexKeyPrefixBytes bytes big endian (zero padded), then min(key length, 8) in the lowest byte.
+// overflow: the bytes after the first kSecondaryIndexKeyPrefixBytes bytes, only compared when the prefixes are equal.
+// Comparing (prefix, overflow) is the same as comparing the whole keys.
+export constexpr SizeT kSecondaryIndexKeyPrefixBytes = 7;
+
+export u64 SecondaryIndexKeyPrefix(std::string_view key);
+
+export std::string_view SecondaryIndexKeyOverflow(std::string_view key);
+
+export i32 CompareSecondaryIndexKey(u64 prefix, std::string_view overflow, u64 other_prefix, std::string_view other_overflow);
+
+} // namespace infinity
@@ -0,0 +1,77 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+#include <bit>
+#include <cmath>
+
+module hyper_log_log;
+
+import stl;
+
+namespace infinity {
+
+namespace {
+
+// splitmix64 finalizer, the keys are raw values (integers, dates) which are far from uniform
+inline u64 MixKey(u64 key) {
+    key ^= key >> 30;
+    key *= 0xbf58476d1ce4e5b9ULL;
+    key ^= key >> 27;
+    key *= 0x94d049bb133111ebULL;
+    key ^= key >> 31;
+    return key;
+}
+
+} // namespace
+
+void HyperLogLog::Add(u64 key) {
+    u64 hash = MixKey(key);
+    u32 register_idx = hash >> (64 - kPrecision);
+    u64 remain = hash << kPrecision;
+    u8 rank = remain == 0 ? (64 - kPrecision + 1) : (std::countl_zero(remain) + 1);
+    registers_[register_idx] = std::max(registers_[register_idx], rank);
+}
+
+void HyperLogLog::Merge(const HyperLogLog &other) {
+    for (u32 i = 0; i < kRegisterCount; ++i) {
+        registers_[i] = std::max(registers_[i], other.registers_[i]);
+    }
+}
+
+f64 HyperLogLog::Estimate() const {
+    constexpr f64 m = kRegisterCount;
+    constexpr f64 alpha = 0.7213 / (1.0 + 1.079 / m);
+    f64 sum = 0;
+    u32 zero_count = 0;
+    for (u8 value : registers_) {
+        sum += std::ldexp(1.0, -value);
+        zero_count += (value == 0);
+    }
+    f64 estimate = alpha * m * m / sum;
+    if (estimate <= 2.5 * m and zero_count > 0) {
+        // linear counting for small cardinalities
+        estimate = m * std::log(m / zero_count);
+    }
+    return estimate;
+}
+
+void HyperLogLog::SerializeToStringStream(OStringStream &os) const {
+    os.write(reinterpret_cast<const char *>(registers_.data()), kRegisterCount);
+}
+
+void HyperLogLog::DeserializeFromStringStream(IStringStream &is) { is.read(reinterpret_cast<char *>(registers_.data()), kRegisterCount); }
+
+} // namespace infinity
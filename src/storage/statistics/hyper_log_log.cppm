@@ -0,0 +1,49 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+export module hyper_log_log;
+
+import stl;
+
+namespace infinity {
+
+// Distinct count sketch of a column, about 3% standard error with 1024 one byte registers.
+// Sketches of the same column in different segments are merged to get the distinct count of the table.
+export class HyperLogLog {
+public:
+    static constexpr u32 kPrecision = 10;
+    static constexpr u32 kRegisterCount = 1u << kPrecision;
+
+    HyperLogLog() : registers_(kRegisterCount, 0) {}
+
+    // key does not need to be a hash, it is mixed before use
+    void Add(u64 key);
+
+    void Merge(const HyperLogLog &other);
+
+    f64 Estimate() const;
+
+    static constexpr u32 GetSerializeSizeInBytes() { return kRegisterCount; }
+
+    void SerializeToStringStream(OStringStream &os) const;
+
+    void DeserializeFromStringStream(IStringStream &is);
+
+private:
+    Vector<u8> registers_;
+};
+
+} // namespace infinity
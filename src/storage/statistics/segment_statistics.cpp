@@ -0,0 +1,232 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+#include "base64.hpp"
+#include <algorithm>
+
+module segment_statistics;
+
+import stl;
+import value;
+import internal_types;
+import logical_type;
+import third_party;
+import logger;
+import infinity_exception;
+import hyper_log_log;
+
+namespace infinity {
+
+Optional<f64> ToStatisticsKey(const Value &value) {
+    switch (value.type().type()) {
+        case kTinyInt: {
+            return ToStatisticsKey(value.GetValue<TinyIntT>());
+        }
+        case kSmallInt: {
+            return ToStatisticsKey(value.GetValue<SmallIntT>());
+        }
+        case kInteger: {
+            return ToStatisticsKey(value.GetValue<IntegerT>());
+        }
+        case kBigInt: {
+            return ToStatisticsKey(value.GetValue<BigIntT>());
+        }
+        case kFloat: {
+            return ToStatisticsKey(value.GetValue<FloatT>());
+        }
+        case kDouble: {
+            return ToStatisticsKey(value.GetValue<DoubleT>());
+        }
+        case kDate: {
+            return ToStatisticsKey(value.GetValue<DateT>());
+        }
+        case kTime: {
+            return ToStatisticsKey(value.GetValue<TimeT>());
+        }
+        case kDateTime: {
+            return ToStatisticsKey(value.GetValue<DateTimeT>());
+        }
+        case kTimestamp: {
+            return ToStatisticsKey(value.GetValue<TimestampT>());
+        }
+        default: {
+            return None;
+        }
+    }
+}
+
+EquiDepthHistogram::EquiDepthHistogram(const Vector<f64> &sorted_keys, u32 bucket_count) {
+    SizeT key_count = sorted_keys.size();
+    if (key_count == 0 or bucket_count == 0) {
+        return;
+    }
+    bucket_count = std::min<SizeT>(bucket_count, key_count);
+    bounds_.reserve(bucket_count + 1);
+    for (u32 i = 0; i < bucket_count; ++i) {
+        bounds_.push_back(sorted_keys[i * key_count / bucket_count]);
+    }
+    bounds_.push_back(sorted_keys.back());
+}
+
+f64 EquiDepthHistogram::FractionLess(f64 key) const {
+    if (bounds_.empty() or key <= bounds_.front()) {
+        return 0;
+    }
+    if (key > bounds_.back()) {
+        return 1;
+    }
+    SizeT bucket_count = bounds_.size() - 1;
+    f64 bucket_fraction = 0;
+    for (SizeT i = 0; i < bucket_count; ++i) {
+        f64 low = bounds_[i];
+        f64 high = bounds_[i + 1];
+        if (high < key) {
+            bucket_fraction += 1;
+        } else {
+            if (low < key) {
+                // low < key <= high
+                bucket_fraction += (key - low) / (high - low);
+            }
+            break;
+        }
+    }
+    return bucket_fraction / bucket_count;
+}
+
+f64 EquiDepthHistogram::FractionEqual(f64 key) const {
+    if (bounds_.empty() or key < bounds_.front() or key > bounds_.back()) {
+        return 0;
+    }
+    SizeT bucket_count = bounds_.size() - 1;
+    SizeT equal_bucket_count = 0;
+    for (SizeT i = 0; i < bucket_count; ++i) {
+        equal_bucket_count += (bounds_[i] == key and bounds_[i + 1] == key);
+    }
+    return f64(equal_bucket_count) / bucket_count;
+}
+
+u32 EquiDepthHistogram::GetSerializeSizeInBytes() const { return sizeof(u32) + bounds_.size() * sizeof(f64); }
+
+void EquiDepthHistogram::SerializeToStringStream(OStringStream &os) const {
+    u32 bound_count = bounds_.size();
+    os.write(reinterpret_cast<const char *>(&bound_count), sizeof(bound_count));
+    os.write(reinterpret_cast<const char *>(bounds_.data()), bound_count * sizeof(f64));
+}
+
+void EquiDepthHistogram::DeserializeFromStringStream(IStringStream &is) {
+    u32 bound_count;
+    is.read(reinterpret_cast<char *>(&bound_count), sizeof(bound_count));
+    bounds_.resize(bound_count);
+    is.read(reinterpret_cast<char *>(bounds_.data()), bound_count * sizeof(f64));
+}
+
+f64 ColumnStatistics::NullFraction() const { return row_count_ == 0 ? 0 : f64(null_count_) / row_count_; }
+
+f64 ColumnStatistics::DistinctCount() const {
+    u64 non_null_count = row_count_ - null_count_;
+    if (non_null_count == 0) {
+        return 0;
+    }
+    return std::clamp(distinct_sketch_.Estimate(), 1.0, f64(non_null_count));
+}
+
+u32 SegmentStatistics::GetSerializeSizeInBytes() const {
+    u32 total_binary_bytes = sizeof(total_binary_bytes) + sizeof(u32);
+    for (const auto &column_statistics : columns_) {
+        total_binary_bytes += sizeof(char);
+        if (column_statistics) {
+            total_binary_bytes += sizeof(column_statistics->row_count_) + sizeof(column_statistics->null_count_);
+            total_binary_bytes += HyperLogLog::GetSerializeSizeInBytes();
+            total_binary_bytes += column_statistics->histogram_.GetSerializeSizeInBytes();
+        }
+    }
+    return total_binary_bytes;
+}
+
+void SegmentStatistics::SerializeToStringStream(OStringStream &os, u32 total_binary_bytes) const {
+    if (total_binary_bytes == 0) {
+        total_binary_bytes = GetSerializeSizeInBytes();
+    }
+    u32 column_count = columns_.size();
+    auto begin_pos = os.tellp();
+    os.write(reinterpret_cast<const char *>(&total_binary_bytes), sizeof(total_binary_bytes));
+    os.write(reinterpret_cast<const char *>(&column_count), sizeof(column_count));
+    for (const auto &column_statistics : columns_) {
+        char exist = column_statistics ? 1 : 0;
+        os.write(reinterpret_cast<const char *>(&exist), sizeof(exist));
+        if (column_statistics) {
+            os.write(reinterpret_cast<const char *>(&column_statistics->row_count_), sizeof(column_statistics->row_count_));
+            os.write(reinterpret_cast<const char *>(&column_statistics->null_count_), sizeof(column_statistics->null_count_));
+            column_statistics->distinct_sketch_.SerializeToStringStream(os);
+            column_statistics->histogram_.SerializeToStringStream(os);
+        }
+    }
+    auto end_pos = os.tellp();
+    if (end_pos - begin_pos != total_binary_bytes) {
+        UnrecoverableError("SegmentStatistics::SerializeToStringStream(): save size error");
+    }
+}
+
+void SegmentStatistics::DeserializeFromStringStream(IStringStream &is) {
+    auto begin_pos = is.tellg();
+    u32 expected_total_binary_bytes;
+    is.read(reinterpret_cast<char *>(&expected_total_binary_bytes), sizeof(expected_total_binary_bytes));
+    u32 column_count;
+    is.read(reinterpret_cast<char *>(&column_count), sizeof(column_count));
+    columns_.clear();
+    columns_.resize(column_count);
+    for (char exist; auto &column_statistics : columns_) {
+        is.read(reinterpret_cast<char *>(&exist), sizeof(exist));
+        if (exist) {
+            column_statistics = MakeUnique<ColumnStatistics>();
+            is.read(reinterpret_cast<char *>(&column_statistics->row_count_), sizeof(column_statistics->row_count_));
+            is.read(reinterpret_cast<char *>(&column_statistics->null_count_), sizeof(column_statistics->null_count_));
+            column_statistics->distinct_sketch_.DeserializeFromStringStream(is);
+            column_statistics->histogram_.DeserializeFromStringStream(is);
+        }
+    }
+    auto end_pos = is.tellg();
+    if (end_pos - begin_pos != expected_total_binary_bytes) {
+        UnrecoverableError("SegmentStatistics::DeserializeFromStringStream(): position error");
+    }
+}
+
+void SegmentStatistics::SaveToJsonFile(nlohmann::json &entry_json) const {
+    u32 total_binary_bytes = GetSerializeSizeInBytes();
+    String save_to_binary;
+    save_to_binary.reserve(total_binary_bytes);
+    OStringStream os(std::move(save_to_binary));
+    SerializeToStringStream(os, total_binary_bytes);
+    entry_json[JsonTag] = base64::to_base64(os.view());
+}
+
+bool SegmentStatistics::LoadFromJsonFile(const nlohmann::json &entry_json) {
+    if (!entry_json.contains(JsonTag)) {
+        LOG_TRACE("SegmentStatistics::LoadFromJsonFile(): found no data.");
+        return false;
+    }
+    String statistics_base64 = entry_json[JsonTag];
+    auto statistics_binary = base64::from_base64(statistics_base64);
+    IStringStream is(statistics_binary);
+    DeserializeFromStringStream(is);
+    if (!is or u32(is.tellg()) != is.view().size()) {
+        UnrecoverableError("SegmentStatistics::LoadFromJsonFile(): load size error");
+        return false;
+    }
+    return true;
+}
+
+} // namespace infinity
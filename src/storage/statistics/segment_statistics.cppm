@@ -0,0 +1,127 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+module;
+
+export module segment_statistics;
+
+import stl;
+import value;
+import internal_types;
+import third_party;
+import column_vector;
+import hyper_log_log;
+
+namespace infinity {
+
+export constexpr u32 STATISTICS_HISTOGRAM_BUCKET_COUNT = 64;
+
+// at most this many keys of a segment column are sampled to build the histogram
+export constexpr SizeT STATISTICS_HISTOGRAM_SAMPLE_SIZE = 64 * 1024;
+
+// Types whose values are mapped to an ordered f64 key and get a histogram.
+export template <typename T>
+concept HaveStatisticsKey = IsAnyOf<T, TinyIntT, SmallIntT, IntegerT, BigIntT, FloatT, DoubleT, DateT, TimeT, DateTimeT, TimestampT>;
+
+export template <HaveStatisticsKey T>
+f64 ToStatisticsKey(const T &value) {
+    if constexpr (IsAnyOf<T, DateT, TimeT>) {
+        return value.GetValue();
+    } else if constexpr (IsAnyOf<T, DateTimeT, TimestampT>) {
+        return value.GetEpochTime();
+    } else {
+        return static_cast<f64>(value);
+    }
+}
+
+// None if the type of the value has no histogram.
+export Optional<f64> ToStatisticsKey(const Value &value);
+
+// Bucket bounds of the keys, every bucket holds the same number of keys.
+export class EquiDepthHistogram {
+public:
+    EquiDepthHistogram() = default;
+
+    EquiDepthHistogram(const Vector<f64> &sorted_keys, u32 bucket_count);
+
+    [[nodiscard]] inline bool empty() const { return bounds_.empty(); }
+
+    [[nodiscard]] inline f64 min() const { return bounds_.front(); }
+
+    [[nodiscard]] inline f64 max() const { return bounds_.back(); }
+
+    // Fraction of the keys less than key, interpolated inside a bucket.
+    f64 FractionLess(f64 key) const;
+
+    // Fraction of the keys equal to key, counted by the buckets holding only key. Zero for keys that are not frequent.
+    f64 FractionEqual(f64 key) const;
+
+    u32 GetSerializeSizeInBytes() const;
+
+    void SerializeToStringStream(OStringStream &os) const;
+
+    void DeserializeFromStringStream(IStringStream &is);
+
+private:
+    // bounds_[i] and bounds_[i + 1] are the smallest and the largest key of bucket i
+    Vector<f64> bounds_;
+};
+
+export struct ColumnStatistics {
+    u64 row_count_{};
+    u64 null_count_{};
+    HyperLogLog distinct_sketch_{};
+    EquiDepthHistogram histogram_{};
+
+    [[nodiscard]] f64 NullFraction() const;
+
+    // at least 1 if the column has a non-null row
+    [[nodiscard]] f64 DistinctCount() const;
+};
+
+// Statistics of a sealed segment, collected at seal time and persisted with the segment entry.
+export class SegmentStatistics {
+public:
+    constexpr static std::string_view JsonTag = "segment_statistics";
+
+    SegmentStatistics() = default;
+
+    explicit SegmentStatistics(u32 column_count) : columns_(column_count) {}
+
+    // nullptr for columns of types without statistics
+    [[nodiscard]] inline const ColumnStatistics *GetColumnStatistics(ColumnID column_id) const {
+        return column_id < columns_.size() ? columns_[column_id].get() : nullptr;
+    }
+
+    inline void SetColumnStatistics(ColumnID column_id, UniquePtr<ColumnStatistics> column_statistics) {
+        columns_[column_id] = std::move(column_statistics);
+    }
+
+    [[nodiscard]] inline SizeT ColumnCount() const { return columns_.size(); }
+
+    u32 GetSerializeSizeInBytes() const;
+
+    void SerializeToStringStream(OStringStream &os, u32 total_binary_bytes = 0) const;
+
+    void DeserializeFromStringStream(IStringStream &is);
+
+    void SaveToJsonFile(nlohmann::json &entry_json) const;
+
+    bool LoadFromJsonFile(const nlohmann::json &entry_json);
+
+private:
+    Vector<UniquePtr<ColumnStatistics>> columns_;
+};
+
+} // namespace infinity
@@ -49,14 +49,19 @@ Storage::Storage(const Config *config_ptr) : config_ptr_(config_ptr) {}
 
 void Storage::Init() {
     // Construct buffer manager
-    buffer_mgr_ = MakeUnique<BufferManager>(config_ptr_->buffer_pool_size(), config_ptr_->data_dir(), config_ptr_->temp_dir());
+    buffer_mgr_ = MakeUnique<BufferManager>(config_ptr_->buffer_pool_size(),
+                                            config_ptr_->data_dir(),
+                                            config_ptr_->temp_dir(),
+                                            config_ptr_->read_ahead_thread_num());
 
     // Construct wal manager
     wal_mgr_ = MakeUnique<WalManager>(this,
                                       *config_ptr_->wal_dir(),
                                       config_ptr_->wal_size_threshold(),
                                       config_ptr_->delta_checkpoint_interval_wal_bytes(),
-                                      config_ptr_->flush_at_commit());
+                                      config_ptr_->flush_at_commit(),
+                                      config_ptr_->wal_compress_threshold(),
+                                      config_ptr_->delta_checkpoint_compact_threshold());
 
     // Must init catalog before txn manager.
     // Replay wal file wrap init catalog
@@ -64,6 +69,7 @@ void Storage::Init() {
 
     BuiltinFunctions builtin_functions(new_catalog_);
     builtin_functions.Init();
+    new_catalog_->InitCheckpointIOPool(config_ptr_->checkpoint_io_thread_num());
     // Catalog finish init here.
 
     bg_processor_ = MakeUnique<BGTaskProcessor>(wal_mgr_.get(), new_catalog_.get());
@@ -72,7 +78,7 @@ void Storage::Init() {
                                       buffer_mgr_.get(),
                                       bg_processor_.get(),
                                       wal_mgr_.get(),
-                                      new_catalog_->next_txn_id_,
+                                      new_catalog_->next_txn_id_.load(),
                                       system_start_ts,
                                       config_ptr_->enable_compaction());
 
@@ -101,6 +107,14 @@ void Storage::Init() {
             LOG_WARN("Cleanup interval is not set, auto cleanup task will not be triggered");
         }
 
+        std::chrono::seconds optimize_interval = config_ptr_->optimize_interval();
+        if (optimize_interval.count() > 0) {
+            periodic_trigger_thread_->AddTrigger(
+                MakeUnique<OptimizeIndexPeriodicTrigger>(optimize_interval, bg_processor_.get(), txn_mgr_.get(), config_ptr_->optimize_io_budget()));
+        } else {
+            LOG_WARN("Optimize interval is not set, background merge of full-text chunk indexes will NOT be triggered");
+        }
+
         i64 full_checkpoint_interval_sec = config_ptr_->full_checkpoint_interval_sec();
         if (full_checkpoint_interval_sec > 0) {
             periodic_trigger_thread_->AddTrigger(
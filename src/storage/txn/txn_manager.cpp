@@ -53,10 +53,18 @@ Txn *TxnManager::BeginTxn() {
         UnrecoverableError("TxnManager is not running, cannot create txn");
     }
 
-    rw_locker_.lock();
-
     // Assign a new txn id
-    u64 new_txn_id = ++catalog_->next_txn_id_;
+    u64 new_txn_id = GetNewTxnID();
+
+    TxnShard &shard = GetShard(new_txn_id);
+    std::unique_lock<std::mutex> lock(shard.mutex_);
+
+    // Lower the min ts of the shard before the begin ts is allocated, so that GetMinUnflushedTS never misses a txn
+    // whose ts is allocated but not registered yet.
+    TxnTimeStamp ts_bound = start_ts_.load() + 1;
+    if (shard.min_ts_.load() > ts_bound) {
+        shard.min_ts_.store(ts_bound);
+    }
 
     // Record the start ts of the txn
     TxnTimeStamp ts = ++start_ts_;
@@ -66,19 +74,19 @@ Txn *TxnManager::BeginTxn() {
 
     // Storage txn in txn manager
     Txn *res = new_txn.get();
-    txn_map_[new_txn_id] = std::move(new_txn);
-    ts_map_.emplace(ts, new_txn_id);
-    rw_locker_.unlock();
+    shard.txn_map_[new_txn_id] = std::move(new_txn);
+    shard.ts_map_.emplace(ts, new_txn_id);
+    shard.UpdateMinTS();
+    lock.unlock();
 
     LOG_TRACE(fmt::format("Txn: {} is Begin. begin ts: {}", new_txn_id, ts));
     return res;
 }
 
 Txn *TxnManager::GetTxn(TransactionID txn_id) {
-    rw_locker_.lock_shared();
-    Txn *res = txn_map_.at(txn_id).get();
-    rw_locker_.unlock_shared();
-    return res;
+    TxnShard &shard = GetShard(txn_id);
+    std::lock_guard<std::mutex> lock(shard.mutex_);
+    return shard.txn_map_.at(txn_id).get();
 }
 
 TxnState TxnManager::GetTxnState(TransactionID txn_id) { return GetTxn(txn_id)->GetTxnState(); }
@@ -128,17 +136,21 @@ void TxnManager::Stop() {
     }
 
     LOG_INFO("Txn manager is stopping...");
-    std::unique_lock<std::shared_mutex> w_locker(rw_locker_);
-    auto it = txn_map_.begin();
-    while (it != txn_map_.end()) {
-        // remove and notify the wal manager condition variable
-        Txn *txn_ptr = it->second.get();
-        if (txn_ptr != nullptr) {
-            txn_ptr->CancelCommitBottom();
+    for (auto &shard : txn_shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex_);
+        for (auto &[txn_id, txn] : shard.txn_map_) {
+            // remove and notify the wal manager condition variable
+            Txn *txn_ptr = txn.get();
+            if (txn_ptr != nullptr) {
+                txn_ptr->CancelCommitBottom();
+                if (!shard.wait_flush_txns_.contains(txn_id)) {
+                    shard.ts_map_.erase(txn_ptr->BeginTS());
+                }
+            }
         }
-        ++it;
+        shard.txn_map_.clear();
+        shard.UpdateMinTS();
     }
-    txn_map_.clear();
     LOG_INFO("TxnManager is stopped");
 }
 
@@ -146,17 +158,25 @@ bool TxnManager::Stopped() { return !is_running_.load(); }
 
 TxnTimeStamp TxnManager::CommitTxn(Txn *txn) {
     TxnTimeStamp txn_ts = txn->Commit();
-    rw_locker_.lock();
-    txn_map_.erase(txn->TxnID());
-    rw_locker_.unlock();
+    RemoveTxn(txn);
     return txn_ts;
 }
 
 void TxnManager::RollBackTxn(Txn *txn) {
     txn->Rollback();
-    rw_locker_.lock();
-    txn_map_.erase(txn->TxnID());
-    rw_locker_.unlock();
+    RemoveTxn(txn);
+}
+
+void TxnManager::RemoveTxn(Txn *txn) {
+    TransactionID txn_id = txn->TxnID();
+    TxnShard &shard = GetShard(txn_id);
+    std::lock_guard<std::mutex> lock(shard.mutex_);
+    if (!shard.wait_flush_txns_.contains(txn_id)) {
+        shard.ts_map_.erase(txn->BeginTS());
+        shard.UpdateMinTS();
+    }
+    // The txn is destroyed here
+    shard.txn_map_.erase(txn_id);
 }
 
 void TxnManager::AddWaitFlushTxn(TransactionID txn_id) {
@@ -165,8 +185,12 @@ void TxnManager::AddWaitFlushTxn(TransactionID txn_id) {
     //     ss << txn_id << " ";
     // }
     // LOG_INFO(fmt::format("Current wait flush set: {}, add txn: {} to wait flush set", ss.str(), txn_id));
-    std::unique_lock w_lock(rw_locker_);
-    wait_flush_txns_.insert(txn_id);
+    TxnShard &shard = GetShard(txn_id);
+    std::lock_guard<std::mutex> lock(shard.mutex_);
+    auto iter = shard.txn_map_.find(txn_id);
+    // The txn is still registered since CommitTxn unregisters it after the commit bottom is done, unless the manager is stopping.
+    TxnTimeStamp begin_ts = iter != shard.txn_map_.end() ? iter->second->BeginTS() : UNSET_TS;
+    shard.wait_flush_txns_.emplace(txn_id, begin_ts);
 }
 
 void TxnManager::RemoveWaitFlushTxns(const Vector<TransactionID> &txn_ids) {
@@ -179,30 +203,31 @@ void TxnManager::RemoveWaitFlushTxns(const Vector<TransactionID> &txn_ids) {
     //     ss2 << txn_id << " ";
     // }
     // LOG_INFO(fmt::format("Current wait flush set: {}, Remove txn: {} from wait flush set", ss1.str(), ss2.str()));
-    std::unique_lock w_lock(rw_locker_);
     for (auto txn_id : txn_ids) {
-        if (!wait_flush_txns_.erase(txn_id)) {
+        TxnShard &shard = GetShard(txn_id);
+        std::lock_guard<std::mutex> lock(shard.mutex_);
+        auto iter = shard.wait_flush_txns_.find(txn_id);
+        if (iter == shard.wait_flush_txns_.end()) {
             UnrecoverableError(fmt::format("Txn: {} not found in wait flush set", txn_id));
         }
+        TxnTimeStamp begin_ts = iter->second;
+        shard.wait_flush_txns_.erase(iter);
+        if (begin_ts != UNSET_TS && !shard.txn_map_.contains(txn_id)) {
+            shard.ts_map_.erase(begin_ts);
+            shard.UpdateMinTS();
+        }
     }
 }
 
+// Lock free: the last allocated ts is read first, any txn with a begin ts not larger than it has lowered the min ts of its
+// shard before, see BeginTxn.
 TxnTimeStamp TxnManager::GetMinUnflushedTS() {
-    std::shared_lock r_locker(rw_locker_);
-    for (auto iter = ts_map_.begin(); iter != ts_map_.end();) {
-        auto &[ts, txn_id] = *iter;
-        if (txn_map_.find(txn_id) != txn_map_.end()) {
-            LOG_TRACE(fmt::format("Txn: {} not found in txn map", txn_id));
-            return ts;
-        }
-        if (wait_flush_txns_.find(txn_id) != wait_flush_txns_.end()) {
-            LOG_TRACE(fmt::format("Txn: {} wait flush", txn_id));
-            return ts;
-        }
-        iter = ts_map_.erase(iter);
+    TxnTimeStamp min_ts = start_ts_.load();
+    for (auto &shard : txn_shards_) {
+        min_ts = std::min(min_ts, shard.min_ts_.load());
     }
-    LOG_TRACE(fmt::format("No txn is active, return the next ts {}", start_ts_));
-    return start_ts_;
+    LOG_TRACE(fmt::format("Min unflushed ts {}", min_ts));
+    return min_ts;
 }
 
 } // namespace infinity
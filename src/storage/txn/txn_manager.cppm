@@ -47,10 +47,6 @@ public:
 
     TxnState GetTxnState(TransactionID txn_id);
 
-    inline void Lock() { rw_locker_.lock(); }
-
-    inline void UnLock() { rw_locker_.unlock(); }
-
     BufferManager *GetBufferMgr() const { return buffer_mgr_; }
 
     Catalog *GetCatalog() const { return catalog_; }
@@ -88,21 +84,37 @@ public:
 private:
     TransactionID GetNewTxnID();
 
+    // Txns are registered in one of TXN_SHARD_NUM shards chosen by txn id, so that concurrent begins and commits
+    // seldom contend on the same mutex.
+    static constexpr SizeT TXN_SHARD_NUM = 64;
+    static constexpr TxnTimeStamp UNSET_TS = std::numeric_limits<TxnTimeStamp>::max();
+
+    struct alignas(64) TxnShard {
+        std::mutex mutex_{};
+        HashMap<TransactionID, SharedPtr<Txn>> txn_map_{};
+        // Begin ts of the txns of this shard which are active or waiting for their delta entry to be flushed
+        Map<TxnTimeStamp, TransactionID> ts_map_{};
+        HashMap<TransactionID, TxnTimeStamp> wait_flush_txns_{};
+        // Lower bound of the ts in ts_map_, UNSET_TS if empty. Read without the mutex by GetMinUnflushedTS.
+        Atomic<TxnTimeStamp> min_ts_{UNSET_TS};
+
+        void UpdateMinTS() { min_ts_.store(ts_map_.empty() ? UNSET_TS : ts_map_.begin()->first); }
+    };
+
+    TxnShard &GetShard(TransactionID txn_id) { return txn_shards_[txn_id % TXN_SHARD_NUM]; }
+
+    // Unregister an ended txn, its begin ts stays pinned as long as it waits for flush.
+    void RemoveTxn(Txn *txn);
+
 private:
     Catalog *catalog_{};
-    std::shared_mutex rw_locker_{};
     BufferManager *buffer_mgr_{};
     BGTaskProcessor *bg_task_processor_{};
-    HashMap<TransactionID, SharedPtr<Txn>> txn_map_{};
     WalManager *wal_mgr_;
 
     TransactionID start_txn_id_{};
-    // Use a variant of priority queue to ensure entries are putted to WalManager in the same order as commit_ts allocation.
-    //    std::mutex mutex_;
-    Atomic<TxnTimeStamp> start_ts_{}; // The next txn ts
-    // Deque<TxnTimeStamp> ts_queue_{}; // the ts queue
-    Map<TxnTimeStamp, TransactionID> ts_map_{};
-    HashSet<TransactionID> wait_flush_txns_{};
+    Atomic<TxnTimeStamp> start_ts_{}; // The last allocated txn ts
+    Array<TxnShard, TXN_SHARD_NUM> txn_shards_{};
 
     //    Map<TxnTimeStamp, SharedPtr<WalEntry>> priority_que_; // TODO: use C++23 std::flat_map?
     // For stop the txn manager
@@ -37,6 +37,7 @@ import background_process;
 import bg_task;
 import compact_segments_task;
 import build_fast_rough_filter_task;
+import build_segment_statistics_task;
 
 namespace infinity {
 
@@ -78,6 +79,9 @@ void TxnIndexStore::Commit(TransactionID txn_id, TxnTimeStamp commit_ts) const {
     for (auto chunk_index_entry : chunk_index_entries_) {
         chunk_index_entry->Commit(commit_ts);
     }
+    for (auto chunk_index_entry : deprecate_chunk_index_entries_) {
+        chunk_index_entry->DeprecateChunk(commit_ts);
+    }
 }
 
 ///-----------------------------------------------------------------------------
@@ -168,6 +172,11 @@ void TxnTableStore::AddChunkIndexStore(TableIndexEntry *table_index_entry, Chunk
     txn_index_store->chunk_index_entries_.push_back(chunk_index_entry);
 }
 
+void TxnTableStore::DeprecateChunkIndexStore(TableIndexEntry *table_index_entry, ChunkIndexEntry *chunk_index_entry) {
+    auto *txn_index_store = this->GetIndexStore(table_index_entry);
+    txn_index_store->deprecate_chunk_index_entries_.push_back(chunk_index_entry);
+}
+
 void TxnTableStore::DropIndexStore(TableIndexEntry *table_index_entry) {
     if (txn_indexes_.contains(table_index_entry)) {
         table_index_entry->Cleanup();
@@ -338,6 +347,8 @@ void TxnTableStore::AddDeltaOp(CatalogDeltaEntry *local_delta_ops,
         // build minmax filter
         BuildFastRoughFilterTask::ExecuteOnNewSealedSegment(sealed_segment, txn_->buffer_mgr(), commit_ts);
         // now have minmax filter and optional bloom filter
+        // collect statistics for the cost model
+        BuildSegmentStatisticsTask::ExecuteOnNewSealedSegment(sealed_segment, txn_->buffer_mgr(), commit_ts);
         // serialize filter
         if (!sealed_segment->SetSealed()) {
             UnrecoverableError(fmt::format("Set sealed segment failed, segment id: {}", sealed_segment->segment_id()));
@@ -71,6 +71,7 @@ public:
 
     HashMap<SegmentID, SegmentIndexEntry *> index_entry_map_{};
     Vector<ChunkIndexEntry *> chunk_index_entries_{};
+    Vector<ChunkIndexEntry *> deprecate_chunk_index_entries_{};
 };
 
 export struct TxnCompactStore {
@@ -98,6 +99,8 @@ public:
 
     void AddChunkIndexStore(TableIndexEntry *table_index_entry, ChunkIndexEntry *chunk_index_entry);
 
+    void DeprecateChunkIndexStore(TableIndexEntry *table_index_entry, ChunkIndexEntry *chunk_index_entry);
+
     TxnIndexStore *GetIndexStore(TableIndexEntry *table_index_entry);
 
     void DropIndexStore(TableIndexEntry *table_index_entry);
@@ -853,7 +853,7 @@ UniquePtr<CatalogDeltaEntry> CatalogDeltaEntry::ReadAdv(char *&ptr, i32 max_byte
     }
     {
         for (const auto &operation : entry->operations_) {
-            LOG_INFO(fmt::format("Read delta op: {}", operation->ToString()));
+            LOG_TRACE(fmt::format("Read delta op: {}", operation->ToString()));
         }
     }
     return entry;
@@ -930,6 +930,16 @@ String CatalogDeltaEntry::ToString() const {
 
 void CatalogDeltaEntry::AddOperation(UniquePtr<CatalogDeltaOperation> operation) { operations_.emplace_back(std::move(operation)); }
 
+UniquePtr<CatalogDeltaEntry> CatalogDeltaEntry::Merge(Vector<UniquePtr<CatalogDeltaEntry>> delta_entries) {
+    GlobalCatalogDeltaEntry merged_entry;
+    TxnTimeStamp max_commit_ts = 0;
+    for (auto &delta_entry : delta_entries) {
+        max_commit_ts = std::max(max_commit_ts, delta_entry->commit_ts());
+        merged_entry.ReplayDeltaEntry(std::move(delta_entry));
+    }
+    return merged_entry.PickFlushEntry(0, max_commit_ts);
+}
+
 void GlobalCatalogDeltaEntry::AddDeltaEntry(UniquePtr<CatalogDeltaEntry> delta_entry, i64 wal_size) {
     // {
     //     for (auto &delta_entry : delta_entries) {
@@ -630,6 +630,10 @@ public:
 
     void AddOperation(UniquePtr<CatalogDeltaOperation> operation);
 
+    // Prune pass over delta entries ordered by commit ts: folds them into one entry that keeps the latest op of each catalog entry,
+    // and drops the ops superseded later, e.g. those of entries created and dropped in between or under a dropped parent.
+    static UniquePtr<CatalogDeltaEntry> Merge(Vector<UniquePtr<CatalogDeltaEntry>> delta_entries);
+
 public:
     // Attention: only use in unit test or thread safe context
     Vector<UniquePtr<CatalogDeltaOperation>> &operations() { return operations_; }
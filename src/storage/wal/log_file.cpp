@@ -14,6 +14,8 @@
 
 module;
 
+#include <algorithm>
+#include <iterator>
 #include <vector>
 
 module log_file;
@@ -31,7 +33,9 @@ Optional<Pair<FullCatalogFileInfo, Vector<DeltaCatalogFileInfo>>> CatalogFile::P
                                                                                                              TxnTimeStamp max_checkpoint_ts) {
     auto [full_infos, delta_infos] = ParseCheckpointFilenames(catalog_dir);
     std::sort(full_infos.begin(), full_infos.end(), [](const auto &lhs, const auto &rhs) { return lhs.max_commit_ts_ < rhs.max_commit_ts_; });
-    std::sort(delta_infos.begin(), delta_infos.end(), [](const auto &lhs, const auto &rhs) { return lhs.max_commit_ts_ < rhs.max_commit_ts_; });
+    std::sort(delta_infos.begin(), delta_infos.end(), [](const auto &lhs, const auto &rhs) {
+        return lhs.max_commit_ts_ < rhs.max_commit_ts_ || (lhs.max_commit_ts_ == rhs.max_commit_ts_ && !lhs.merged_ && rhs.merged_);
+    });
 
     while (!full_infos.empty() && full_infos.back().max_commit_ts_ > max_checkpoint_ts) {
         LOG_WARN(fmt::format("Full catalog file {} is newer than the max checkpoint ts {}", full_infos.back().path_, max_checkpoint_ts));
@@ -53,17 +57,26 @@ Optional<Pair<FullCatalogFileInfo, Vector<DeltaCatalogFileInfo>>> CatalogFile::P
         LOG_WARN(fmt::format("Delta catalog file {} is older than the full catalog file {}", delta_infos.front().path_, last_full_info.path_));
         delta_infos.erase(delta_infos.begin());
     }
+    // A merged file replaces the delta files up to its ts, those left are only there if the merge was interrupted before removing them.
+    auto merged_iter = std::find_if(delta_infos.rbegin(), delta_infos.rend(), [](const auto &delta_info) { return delta_info.merged_; });
+    if (merged_iter != delta_infos.rend()) {
+        delta_infos.erase(delta_infos.begin(), std::prev(merged_iter.base()));
+    }
 
     auto res = Pair<FullCatalogFileInfo, Vector<DeltaCatalogFileInfo>>{last_full_info, std::move(delta_infos)};
     return res;
 }
 
-String CatalogFile::FullCheckpoingFilename(TxnTimeStamp max_commit_ts) { return fmt::format("FULL.{}.json", max_commit_ts); }
+String CatalogFile::FullCheckpoingFilename(TxnTimeStamp max_commit_ts) { return fmt::format("FULL.{}.snap", max_commit_ts); }
 
-String CatalogFile::TempFullCheckpointFilename(TxnTimeStamp max_commit_ts) { return fmt::format("_FULL.{}.json", max_commit_ts); }
+String CatalogFile::TempFullCheckpointFilename(TxnTimeStamp max_commit_ts) { return fmt::format("_FULL.{}.snap", max_commit_ts); }
 
 String CatalogFile::DeltaCheckpointFilename(TxnTimeStamp max_commit_ts) { return fmt::format("DELTA.{}", max_commit_ts); }
 
+String CatalogFile::MergedDeltaCheckpointFilename(TxnTimeStamp max_commit_ts) { return fmt::format("MERGED_DELTA.{}", max_commit_ts); }
+
+String CatalogFile::TempMergedDeltaCheckpointFilename(TxnTimeStamp max_commit_ts) { return fmt::format("_MERGED_DELTA.{}", max_commit_ts); }
+
 void CatalogFile::RecycleCatalogFile(TxnTimeStamp max_commit_ts, const String &catalog_dir) {
     auto [full_infos, delta_infos] = ParseCheckpointFilenames(catalog_dir);
     bool found = false;
@@ -109,7 +122,8 @@ Pair<Vector<FullCatalogFileInfo>, Vector<DeltaCatalogFileInfo>> CatalogFile::Par
             continue;
         }
         auto suffix = filename.substr(dot_pos + 1);
-        if (IsEqual(suffix, String("json"))) {
+        // "json" is the suffix of the full catalog files written before the binary snapshot format.
+        if (IsEqual(suffix, String("snap")) || IsEqual(suffix, String("json"))) {
             if (dot_pos == 0) {
                 LOG_WARN(fmt::format("Catalog file {} has wrong file name", entry->path().string()));
                 continue;
@@ -137,11 +151,12 @@ Pair<Vector<FullCatalogFileInfo>, Vector<DeltaCatalogFileInfo>> CatalogFile::Par
                 continue;
             }
             auto file_prefix = filename.substr(0, dot_pos);
-            if (!IsEqual(file_prefix, String("DELTA"))) {
+            bool merged = IsEqual(file_prefix, String("MERGED_DELTA"));
+            if (!merged && !IsEqual(file_prefix, String("DELTA"))) {
                 LOG_WARN(fmt::format("Catalog file {} has wrong file name", entry->path().string()));
                 continue;
             }
-            delta_infos.push_back({entry->path().string(), checkpoint_ts});
+            delta_infos.push_back({entry->path().string(), checkpoint_ts, merged});
         }
     }
     return {full_infos, delta_infos};
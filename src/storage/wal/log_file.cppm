@@ -30,6 +30,7 @@ export struct FullCatalogFileInfo {
 export struct DeltaCatalogFileInfo {
     String path_;
     TxnTimeStamp max_commit_ts_;
+    bool merged_{false}; // merged from all the delta files since the last full checkpoint
 };
 
 export struct TempWalFileInfo {
@@ -52,6 +53,10 @@ public:
 
     static String DeltaCheckpointFilename(TxnTimeStamp max_commit_ts);
 
+    static String MergedDeltaCheckpointFilename(TxnTimeStamp max_commit_ts);
+
+    static String TempMergedDeltaCheckpointFilename(TxnTimeStamp max_commit_ts);
+
     // max_commit_ts is the largest commit ts before the latest full checkpoint
     static void RecycleCatalogFile(TxnTimeStamp max_commit_ts, const String &catalog_dir);
 
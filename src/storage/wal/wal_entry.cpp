@@ -15,6 +15,8 @@
 module;
 
 #include <fstream>
+#include <future>
+#include <lz4.h>
 #include <vector>
 
 module wal_entry;
@@ -592,6 +594,11 @@ bool WalEntry::operator!=(const WalEntry &other) const { return !operator==(othe
 
 i32 WalEntry::GetSizeInBytes() const {
     i32 size = sizeof(WalEntryHeader) + sizeof(i32);
+    if (!compressed_cmds_.empty()) {
+        size += sizeof(i32) * 2 + compressed_cmds_.size();
+        size += sizeof(i32); // pad
+        return size;
+    }
     SizeT cmd_count = cmds_.size();
     for (SizeT idx = 0; idx < cmd_count; ++idx) {
         const auto &cmd = cmds_[idx];
@@ -611,6 +618,10 @@ i32 WalEntry::GetSizeInBytes() const {
  * - number of WalCmd
  *   - (repeated) WalCmd
  * - 4 bytes pad
+ * When the commands are compressed, CMDS_LZ4_FLAG is set in the number of WalCmd, which is followed by:
+ *   - size of the serialized WalCmds
+ *   - size of the compressed WalCmds
+ *   - LZ4 compressed WalCmds
  * @param ptr
  */
 
@@ -618,11 +629,19 @@ void WalEntry::WriteAdv(char *&ptr) const {
     char *const saved_ptr = ptr;
     std::memcpy(ptr, this, sizeof(WalEntryHeader));
     ptr += sizeof(WalEntryHeader);
-    WriteBufAdv(ptr, static_cast<i32>(cmds_.size()));
-    SizeT cmd_count = cmds_.size();
-    for (SizeT idx = 0; idx < cmd_count; ++idx) {
-        const auto &cmd = cmds_[idx];
-        cmd->WriteAdv(ptr);
+    if (!compressed_cmds_.empty()) {
+        WriteBufAdv(ptr, static_cast<i32>(cmds_.size()) | CMDS_LZ4_FLAG);
+        WriteBufAdv(ptr, raw_cmds_size_);
+        WriteBufAdv(ptr, static_cast<i32>(compressed_cmds_.size()));
+        std::memcpy(ptr, compressed_cmds_.data(), compressed_cmds_.size());
+        ptr += compressed_cmds_.size();
+    } else {
+        WriteBufAdv(ptr, static_cast<i32>(cmds_.size()));
+        SizeT cmd_count = cmds_.size();
+        for (SizeT idx = 0; idx < cmd_count; ++idx) {
+            const auto &cmd = cmds_[idx];
+            cmd->WriteAdv(ptr);
+        }
     }
     i32 size = ptr - saved_ptr + sizeof(i32);
     WriteBufAdv(ptr, size);
@@ -656,6 +675,30 @@ SharedPtr<WalEntry> WalEntry::ReadAdv(char *&ptr, i32 max_bytes) {
     }
     ptr += sizeof(WalEntryHeader);
     i32 cnt = ReadBufAdv<i32>(ptr);
+    if (cnt & CMDS_LZ4_FLAG) {
+        cnt &= ~CMDS_LZ4_FLAG;
+        i32 raw_size = ReadBufAdv<i32>(ptr);
+        i32 compressed_size = ReadBufAdv<i32>(ptr);
+        if (raw_size < 0 || compressed_size < 0 || compressed_size > ptr_end - ptr) {
+            UnrecoverableError("ptr goes out of range when reading WalEntry");
+        }
+        Vector<char> raw_cmds(raw_size);
+        i32 decompressed_size = LZ4_decompress_safe(ptr, raw_cmds.data(), compressed_size, raw_size);
+        if (decompressed_size != raw_size) {
+            UnrecoverableError(fmt::format("Failed to decompress WalEntry commands, expect {} bytes, got {}", raw_size, decompressed_size));
+        }
+        ptr += compressed_size;
+        char *raw_ptr = raw_cmds.data();
+        char *const raw_end = raw_ptr + raw_size;
+        for (i32 i = 0; i < cnt; i++) {
+            i32 raw_max_bytes = raw_end - raw_ptr;
+            if (raw_max_bytes <= 0) {
+                UnrecoverableError("ptr goes out of range when reading WalEntry");
+            }
+            entry->cmds_.push_back(WalCmd::ReadAdv(raw_ptr, raw_max_bytes));
+        }
+        cnt = 0;
+    }
     for (i32 i = 0; i < cnt; i++) {
         max_bytes = ptr_end - ptr;
         if (max_bytes <= 0) {
@@ -672,6 +715,34 @@ SharedPtr<WalEntry> WalEntry::ReadAdv(char *&ptr, i32 max_bytes) {
     return entry;
 }
 
+void WalEntry::CompressCmds(SizeT threshold) {
+    compressed_cmds_.clear();
+    raw_cmds_size_ = 0;
+    SizeT raw_size = 0;
+    for (const auto &cmd : cmds_) {
+        raw_size += cmd->GetSizeInBytes();
+    }
+    if (raw_size < threshold || raw_size > SizeT(LZ4_MAX_INPUT_SIZE)) {
+        return;
+    }
+    Vector<char> raw_cmds(raw_size);
+    char *ptr = raw_cmds.data();
+    for (const auto &cmd : cmds_) {
+        cmd->WriteAdv(ptr);
+    }
+    i32 actual_size = ptr - raw_cmds.data();
+
+    Vector<char> compressed_cmds(LZ4_compressBound(actual_size));
+    i32 compressed_size = LZ4_compress_default(raw_cmds.data(), compressed_cmds.data(), actual_size, compressed_cmds.size());
+    // Keep the commands verbatim if they don't compress well
+    if (compressed_size <= 0 || compressed_size >= actual_size - actual_size / 8) {
+        return;
+    }
+    compressed_cmds.resize(compressed_size);
+    compressed_cmds_ = std::move(compressed_cmds);
+    raw_cmds_size_ = actual_size;
+}
+
 bool WalEntry::IsCheckPoint(Vector<SharedPtr<WalEntry>> replay_entries, WalCmdCheckpoint *&checkpoint_cmd) const {
     auto iter = cmds_.begin();
     while (iter != cmds_.end()) {
@@ -818,21 +889,71 @@ WalEntryIterator WalEntryIterator::Make(const String &wal_path) {
     return WalEntryIterator(std::move(buf), wal_size);
 }
 
+bool WalEntryIterator::PrevEntry(char *&begin, i32 &entry_size) {
+    if (end_ - buf_.data() < i64(sizeof(i32))) {
+        return false;
+    }
+    std::memcpy(&entry_size, end_ - sizeof(i32), sizeof(entry_size));
+    if (entry_size < i32(sizeof(WalEntryHeader) + sizeof(i32)) || entry_size > end_ - buf_.data()) {
+        return false;
+    }
+    begin = end_ - entry_size;
+    return true;
+}
+
 SharedPtr<WalEntry> WalEntryIterator::Next() {
-    if (end_ > buf_.data()) {
-        i32 entry_size;
-        std::memcpy(&entry_size, end_ - sizeof(i32), sizeof(entry_size));
-        end_ = end_ - entry_size;
-        auto entry = WalEntry::ReadAdv(end_, entry_size);
-        end_ = end_ - entry_size;
-        return entry;
-    } else {
+    char *begin = nullptr;
+    i32 entry_size = 0;
+    if (!PrevEntry(begin, entry_size)) {
+        end_ = buf_.data();
         return nullptr;
     }
+    end_ = begin;
+    return WalEntry::ReadAdv(begin, entry_size);
+}
+
+Vector<SharedPtr<WalEntry>> WalEntryIterator::DecodeAll(ThreadPool &thread_pool) {
+    // Locating the entries only reads their trailing size, the checksum and decoding are done in parallel.
+    Vector<Pair<char *, i32>> entry_ranges;
+    char *begin = nullptr;
+    i32 entry_size = 0;
+    while (PrevEntry(begin, entry_size)) {
+        entry_ranges.emplace_back(begin, entry_size);
+        end_ = begin;
+    }
+    end_ = buf_.data();
+
+    Vector<SharedPtr<WalEntry>> entries(entry_ranges.size());
+    SizeT task_num = std::min(entry_ranges.size(), SizeT(thread_pool.size()) * 4);
+    Vector<std::future<void>> futures;
+    for (SizeT task_id = 0; task_id < task_num; ++task_id) {
+        SizeT range_begin = entry_ranges.size() * task_id / task_num;
+        SizeT range_end = entry_ranges.size() * (task_id + 1) / task_num;
+        futures.push_back(thread_pool.push([&, range_begin, range_end](int) {
+            for (SizeT i = range_begin; i < range_end; ++i) {
+                char *ptr = entry_ranges[i].first;
+                entries[i] = WalEntry::ReadAdv(ptr, entry_ranges[i].second);
+            }
+        }));
+    }
+    for (auto &future : futures) {
+        future.get();
+    }
+    for (SizeT i = 0; i < entries.size(); ++i) {
+        if (entries[i].get() == nullptr) {
+            entries.resize(i);
+            break;
+        }
+    }
+    return entries;
 }
 
 SharedPtr<WalEntry> WalListIterator::Next() {
-    if (iter_.get() != nullptr) {
+    if (thread_pool_ != nullptr) {
+        if (decoded_idx_ < decoded_entries_.size()) {
+            return std::move(decoded_entries_[decoded_idx_++]);
+        }
+    } else if (iter_.get() != nullptr) {
         SharedPtr<WalEntry> entry = iter_->Next();
 
         if (entry.get() != nullptr) {
@@ -842,6 +963,11 @@ SharedPtr<WalEntry> WalListIterator::Next() {
     if (!wal_deque_.empty()) {
         iter_ = MakeUnique<WalEntryIterator>(WalEntryIterator::Make(wal_deque_.front()));
         wal_deque_.pop_front();
+        if (thread_pool_ != nullptr) {
+            decoded_entries_ = iter_->DecodeAll(*thread_pool_);
+            decoded_idx_ = 0;
+            iter_.reset();
+        }
 
         return Next();
     } else {
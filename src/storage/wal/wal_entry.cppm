@@ -367,6 +367,9 @@ export struct WalEntryHeader {
 };
 
 export struct WalEntry : WalEntryHeader {
+    // Set in the command count of an entry whose commands are LZ4 compressed.
+    static constexpr i32 CMDS_LZ4_FLAG = 1 << 30;
+
     bool operator==(const WalEntry &other) const;
 
     bool operator!=(const WalEntry &other) const;
@@ -380,8 +383,16 @@ export struct WalEntry : WalEntryHeader {
     // Read from a serialized version
     static SharedPtr<WalEntry> ReadAdv(char *&ptr, i32 max_bytes);
 
+    // Compresses the serialized commands with LZ4 if they take at least `threshold` bytes and compression saves
+    // space. WriteAdv then writes the compressed commands. The commands must not change afterwards.
+    void CompressCmds(SizeT threshold);
+
     Vector<SharedPtr<WalCmd>> cmds_{};
 
+    // Empty unless CompressCmds compressed the commands.
+    Vector<char> compressed_cmds_{};
+    i32 raw_cmds_size_{};
+
     [[nodiscard]] bool IsCheckPoint(Vector<SharedPtr<WalEntry>> replay_entries, WalCmdCheckpoint *&checkpoint_cmd) const;
 
     [[nodiscard]] String ToString() const;
@@ -394,7 +405,14 @@ public:
 
     [[nodiscard]] SharedPtr<WalEntry> Next();
 
+    // Decodes and checks all the remaining entries with the thread pool. The entries come in the order of Next, and
+    // stop before the first bad one like Next does.
+    [[nodiscard]] Vector<SharedPtr<WalEntry>> DecodeAll(ThreadPool &thread_pool);
+
 private:
+    // Locates the entry ending at end_, returns false if there is none or its size is corrupted.
+    bool PrevEntry(char *&begin, i32 &entry_size);
+
     WalEntryIterator(Vector<char> &&buf, std::streamsize wal_size) : buf_(std::move(buf)), wal_size_(wal_size) { end_ = buf_.data() + wal_size_; }
 
     Vector<char> buf_{};
@@ -402,9 +420,11 @@ private:
     char *end_{};
 };
 
+// Iterates the entries of the wal files from the last to the first one. With a thread pool, each file is decoded in
+// parallel when it's reached.
 export class WalListIterator {
 public:
-    explicit WalListIterator(const Vector<String> &wal_list) {
+    explicit WalListIterator(const Vector<String> &wal_list, ThreadPool *thread_pool = nullptr) : thread_pool_(thread_pool) {
         for (SizeT i = 0; i < wal_list.size(); ++i) {
             wal_deque_.push_back(wal_list[i]);
         }
@@ -415,6 +435,9 @@ public:
 private:
     Deque<String> wal_deque_{};
     UniquePtr<WalEntryIterator> iter_{};
+    ThreadPool *thread_pool_{};
+    Vector<SharedPtr<WalEntry>> decoded_entries_{};
+    SizeT decoded_idx_{};
 };
 
 } // namespace infinity
@@ -14,6 +14,8 @@
 
 module;
 
+#include <chrono>
+
 export module wal_entry_blocking_queue;
 
 import stl;
@@ -70,6 +72,26 @@ public:
         full_cv_.notify_one();
     }
 
+    // Same as above, but once the queue is not empty, keeps waiting up to `window` for it to hold `min_count` entries,
+    // so that more transactions share one write and one sync of the wal.
+    void DequeueBulk(Deque<WalEntry*> &output_array, SizeT min_count, std::chrono::microseconds window) {
+        std::unique_lock<std::mutex> lock(queue_mutex_);
+        empty_cv_.wait(lock, [this] {
+            return !queue_.empty();
+        });
+        min_count = std::min(min_count, capacity_);
+        if (queue_.size() < min_count && window.count() > 0) {
+            // a nullptr entry stops the flush thread, don't hold it back
+            empty_cv_.wait_for(lock, window, [this, min_count] {
+                return queue_.size() >= min_count || queue_.back() == nullptr;
+            });
+        }
+
+        output_array.swap(queue_);
+        queue_.clear();
+        full_cv_.notify_all();
+    }
+
     [[nodiscard]] SizeT Size() const {
         std::lock_guard<std::mutex> lock(queue_mutex_);
         return queue_.size();
@@ -0,0 +1,204 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+module;
+
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+import stl;
+import third_party;
+import logger;
+import infinity_exception;
+
+module wal_file_writer;
+
+namespace infinity {
+
+WalFileWriter::WalFileWriter(SizeT buffer_size) : default_buffer_capacity_((buffer_size + PAGE_SIZE - 1) / PAGE_SIZE * PAGE_SIZE) {
+    AllocateBuffer(default_buffer_capacity_);
+}
+
+WalFileWriter::~WalFileWriter() {
+    if (fd_ != -1) {
+        if (::close(fd_) != 0) {
+            LOG_ERROR(fmt::format("Failed to close wal file: {}: {}", path_, strerror(errno)));
+        }
+        fd_ = -1;
+    }
+    std::free(buffer_);
+}
+
+void WalFileWriter::AllocateBuffer(SizeT capacity) {
+    std::free(buffer_);
+    buffer_ = static_cast<char *>(std::aligned_alloc(PAGE_SIZE, capacity));
+    if (buffer_ == nullptr) {
+        buffer_capacity_ = 0;
+        UnrecoverableError(fmt::format("Failed to allocate {} bytes of wal write buffer", capacity));
+    }
+    buffer_capacity_ = capacity;
+}
+
+void WalFileWriter::Open(const String &path) {
+    std::lock_guard guard(mutex_);
+    if (fd_ != -1) {
+        UnrecoverableError(fmt::format("Wal file {} is already open when opening {}", path_, path));
+    }
+    i32 fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC, 0666);
+    if (fd == -1) {
+        UnrecoverableError(fmt::format("Failed to open wal file: {}: {}", path, strerror(errno)));
+    }
+    struct stat st {};
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        UnrecoverableError(fmt::format("Failed to stat wal file: {}: {}", path, strerror(errno)));
+    }
+    path_ = path;
+    fd_ = fd;
+    file_size_.store(st.st_size);
+    synced_size_.store(st.st_size);
+}
+
+void WalFileWriter::Close(bool sync) {
+    std::lock_guard guard(mutex_);
+    if (fd_ == -1) {
+        return;
+    }
+    if (buffer_offset_ > 0) {
+        WriteAt(buffer_, buffer_offset_);
+        buffer_offset_ = 0;
+    }
+    if (sync && synced_size_.load() != file_size_.load()) {
+        if (::fdatasync(fd_) != 0) {
+            UnrecoverableError(fmt::format("Failed to sync wal file: {}: {}", path_, strerror(errno)));
+        }
+    }
+    if (::close(fd_) != 0) {
+        fd_ = -1;
+        UnrecoverableError(fmt::format("Failed to close wal file: {}: {}", path_, strerror(errno)));
+    }
+    fd_ = -1;
+}
+
+void WalFileWriter::Write(const Vector<Pair<const char *, SizeT>> &buffers) {
+    if (fd_ == -1) {
+        UnrecoverableError(fmt::format("Wal file {} is not open", path_));
+    }
+    if (buffer_offset_ != 0) {
+        UnrecoverableError(fmt::format("Wal file {} has {} bytes buffered when writing directly", path_, buffer_offset_));
+    }
+    Vector<struct iovec> iovs;
+    iovs.reserve(buffers.size());
+    for (const auto &[data, size] : buffers) {
+        if (size > 0) {
+            iovs.push_back({const_cast<char *>(data), size});
+        }
+    }
+    u64 offset = file_size_.load();
+    SizeT iov_idx = 0;
+    while (iov_idx < iovs.size()) {
+        i32 iov_cnt = std::min<SizeT>(iovs.size() - iov_idx, IOV_MAX);
+        ssize_t written = ::pwritev(fd_, iovs.data() + iov_idx, iov_cnt, offset);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            UnrecoverableError(fmt::format("Failed to write wal file: {}: {}", path_, strerror(errno)));
+        }
+        offset += written;
+        // skip the fully written buffers and trim the partially written one
+        SizeT left = written;
+        while (iov_idx < iovs.size() && left >= iovs[iov_idx].iov_len) {
+            left -= iovs[iov_idx].iov_len;
+            ++iov_idx;
+        }
+        if (left > 0) {
+            iovs[iov_idx].iov_base = static_cast<char *>(iovs[iov_idx].iov_base) + left;
+            iovs[iov_idx].iov_len -= left;
+        }
+    }
+    file_size_.store(offset);
+}
+
+char *WalFileWriter::Reserve(SizeT size) {
+    if (buffer_offset_ + size > buffer_capacity_) {
+        FlushBuffer();
+        if (size > buffer_capacity_) {
+            // Kept until FlushBuffer writes the entry out
+            AllocateBuffer((size + PAGE_SIZE - 1) / PAGE_SIZE * PAGE_SIZE);
+        }
+    }
+    reserved_size_ = size;
+    return buffer_ + buffer_offset_;
+}
+
+void WalFileWriter::Commit(SizeT size) {
+    if (size > reserved_size_) {
+        UnrecoverableError(fmt::format("Wal entry of {} bytes overflows the {} bytes reserved", size, reserved_size_));
+    }
+    buffer_offset_ += size;
+    reserved_size_ = 0;
+}
+
+void WalFileWriter::FlushBuffer() {
+    if (buffer_offset_ > 0) {
+        WriteAt(buffer_, buffer_offset_);
+        buffer_offset_ = 0;
+    }
+    if (buffer_capacity_ > default_buffer_capacity_) {
+        AllocateBuffer(default_buffer_capacity_);
+    }
+}
+
+void WalFileWriter::WriteAt(const char *data, SizeT size) {
+    if (fd_ == -1) {
+        UnrecoverableError(fmt::format("Wal file {} is not open", path_));
+    }
+    u64 offset = file_size_.load();
+    while (size > 0) {
+        ssize_t written = ::pwrite(fd_, data, size, offset);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            UnrecoverableError(fmt::format("Failed to write wal file: {}: {}", path_, strerror(errno)));
+        }
+        data += written;
+        size -= written;
+        offset += written;
+    }
+    file_size_.store(offset);
+}
+
+bool WalFileWriter::Sync() {
+    std::lock_guard guard(mutex_);
+    u64 file_size = file_size_.load();
+    if (fd_ == -1 || synced_size_.load() == file_size) {
+        return false;
+    }
+    if (::fdatasync(fd_) != 0) {
+        UnrecoverableError(fmt::format("Failed to sync wal file: {}: {}", path_, strerror(errno)));
+    }
+    synced_size_.store(file_size);
+    return true;
+}
+
+} // namespace infinity
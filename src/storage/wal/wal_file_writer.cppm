@@ -0,0 +1,90 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+module;
+
+export module wal_file_writer;
+
+import stl;
+
+namespace infinity {
+
+// Appends to the current wal file through a raw file descriptor, so that a whole batch of wal entries goes out with
+// one write and is made durable with one fdatasync(2) (group commit).
+// Entries are serialized in place into a reusable page-aligned buffer (Reserve/Commit) and written out by
+// FlushBuffer, so that the commit path does not allocate per entry. The buffer only grows for an entry larger than it,
+// and shrinks back once that entry is written.
+// Write and the buffer are only used by the flush thread, which also owns Open/Close. Sync may additionally be called
+// by the background sync thread, the mutex keeps it from racing with Close.
+export class WalFileWriter {
+public:
+    static constexpr SizeT PAGE_SIZE = 4096;
+    static constexpr SizeT DEFAULT_BUFFER_SIZE = 4 * 1024 * 1024;
+
+    explicit WalFileWriter(SizeT buffer_size = DEFAULT_BUFFER_SIZE);
+
+    ~WalFileWriter();
+
+    void Open(const String &path);
+
+    // Syncs the pending data first if `sync` is true.
+    void Close(bool sync);
+
+    bool IsOpen() const { return fd_ != -1; }
+
+    // Writes the buffers at the end of the file, in order. Short writes are retried until everything is written.
+    // The data in the write buffer must have been flushed before.
+    void Write(const Vector<Pair<const char *, SizeT>> &buffers);
+
+    // Returns room for `size` bytes in the write buffer. If they don't fit behind the data already buffered, that data
+    // is written to the file first.
+    char *Reserve(SizeT size);
+
+    // Appends the first `size` bytes of the last reserved room to the buffered data.
+    void Commit(SizeT size);
+
+    // Writes the buffered data at the end of the file with one write.
+    void FlushBuffer();
+
+    SizeT BufferedSize() const { return buffer_offset_; }
+
+    SizeT BufferCapacity() const { return buffer_capacity_; }
+
+    // fdatasync(2) the data written so far. Returns false if there was nothing to sync.
+    bool Sync();
+
+    u64 FileSize() const { return file_size_.load(); }
+
+    bool Dirty() const { return synced_size_.load() != file_size_.load(); }
+
+private:
+    void WriteAt(const char *data, SizeT size);
+
+    void AllocateBuffer(SizeT capacity);
+
+    String path_{};
+    i32 fd_{-1};
+    Atomic<u64> file_size_{0};
+    Atomic<u64> synced_size_{0};
+    std::mutex mutex_{};
+
+    char *buffer_{};
+    SizeT buffer_capacity_{};
+    SizeT buffer_offset_{};
+    SizeT reserved_size_{};
+    const SizeT default_buffer_capacity_;
+};
+
+} // namespace infinity
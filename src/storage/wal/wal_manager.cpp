@@ -14,8 +14,11 @@
 
 module;
 
+#include <algorithm>
+#include <chrono>
+#include <exception>
 #include <filesystem>
-#include <fstream>
+#include <future>
 #include <thread>
 
 import stl;
@@ -52,15 +55,38 @@ import table_index_entry;
 import log_file;
 import default_values;
 import defer_op;
+import wal_file_writer;
 
 module wal_manager;
 
 namespace infinity {
 
-WalManager::WalManager(Storage *storage, String wal_dir, u64 wal_size_threshold, u64 delta_checkpoint_interval_wal_bytes, FlushOption flush_option)
-    : cfg_wal_size_threshold_(wal_size_threshold), cfg_delta_checkpoint_interval_wal_bytes_(delta_checkpoint_interval_wal_bytes), wal_dir_(wal_dir),
-      wal_path_(wal_dir + "/" + WalFile::TempWalFilename()), storage_(storage), running_(false), flush_option_(flush_option), last_ckp_wal_size_(0),
-      checkpoint_in_progress_(false), last_ckp_ts_(UNCOMMIT_TS), last_full_ckp_ts_(UNCOMMIT_TS) {}
+namespace {
+
+// Appends and deletes only change the table they target.
+bool IsTableDataEntry(const WalEntry &entry) {
+    for (const auto &cmd : entry.cmds_) {
+        WalCommandType type = cmd->GetType();
+        if (type != WalCommandType::APPEND && type != WalCommandType::DELETE) {
+            return false;
+        }
+    }
+    return !entry.cmds_.empty();
+}
+
+} // namespace
+
+WalManager::WalManager(Storage *storage,
+                       String wal_dir,
+                       u64 wal_size_threshold,
+                       u64 delta_checkpoint_interval_wal_bytes,
+                       FlushOption flush_option,
+                       u64 wal_compress_threshold,
+                       u64 delta_checkpoint_compact_threshold)
+    : cfg_wal_size_threshold_(wal_size_threshold), cfg_delta_checkpoint_interval_wal_bytes_(delta_checkpoint_interval_wal_bytes),
+      cfg_wal_compress_threshold_(wal_compress_threshold), cfg_delta_checkpoint_compact_threshold_(delta_checkpoint_compact_threshold),
+      wal_dir_(wal_dir), wal_path_(wal_dir + "/" + WalFile::TempWalFilename()), storage_(storage), running_(false), flush_option_(flush_option),
+      last_ckp_wal_size_(0), checkpoint_in_progress_(false), last_ckp_ts_(UNCOMMIT_TS), last_full_ckp_ts_(UNCOMMIT_TS) {}
 
 WalManager::~WalManager() {
     if (running_.load()) {
@@ -79,14 +105,18 @@ void WalManager::Start() {
         fs.CreateDirectory(wal_dir_);
     }
     // TODO: recovery from wal checkpoint
-    ofs_ = std::ofstream(wal_path_, std::ios::app | std::ios::binary);
-    if (!ofs_.is_open()) {
-        UnrecoverableError(fmt::format("Failed to open wal file: {}", wal_path_));
-    }
+    wal_writer_.Open(wal_path_);
+    fs.SyncDirectory(wal_dir_);
     LOG_INFO(fmt::format("Open wal file: {}", wal_path_));
 
     wal_size_ = 0;
+    sync_cost_us_ = 0;
+    last_batch_size_ = 0;
     flush_thread_ = Thread([this] { Flush(); });
+    if (flush_option_ == FlushOption::kFlushPerSecond) {
+        sync_stop_ = false;
+        sync_thread_ = Thread([this] { SyncTimer(); });
+    }
     // checkpoint_thread_ = Thread([this] { CheckpointTimer(); });
     LOG_INFO("WAL manager is started.");
 }
@@ -113,7 +143,16 @@ void WalManager::Stop() {
     LOG_TRACE("WalManager::Stop flush thread join");
     flush_thread_.join();
 
-    ofs_.close();
+    if (sync_thread_.joinable()) {
+        {
+            std::lock_guard guard(sync_mutex_);
+            sync_stop_ = true;
+        }
+        sync_cv_.notify_one();
+        sync_thread_.join();
+    }
+
+    wal_writer_.Close(flush_option_ != FlushOption::kOnlyWrite);
     LOG_INFO("WAL manager is stopped.");
 }
 
@@ -124,6 +163,9 @@ void WalManager::PutEntry(WalEntry *entry, Txn *txn) {
         return;
     }
 
+    if (cfg_wal_compress_threshold_ > 0) {
+        entry->CompressCmds(cfg_wal_compress_threshold_);
+    }
     blocking_queue_.Enqueue(entry, txn);
 
     return;
@@ -148,12 +190,22 @@ void WalManager::Flush() {
 
     Deque<WalEntry *> log_batch{};
     while (running_.load()) {
-        blocking_queue_.DequeueBulk(log_batch);
+        // Group commit: when the last batch gathered several transactions, i.e. there are concurrent committers, let
+        // the next batch grow for at most half the cost of a sync, so that they share one write and one fdatasync.
+        // A lone committer is never held back.
+        SizeT min_batch_size = 0;
+        std::chrono::microseconds window(0);
+        if (flush_option_ == FlushOption::kFlushAtOnce && last_batch_size_ > 1) {
+            min_batch_size = last_batch_size_;
+            window = std::chrono::microseconds(std::min<i64>(sync_cost_us_ / 2, WAL_GROUP_COMMIT_MAX_WINDOW_US));
+        }
+        blocking_queue_.DequeueBulk(log_batch, min_batch_size, window);
         if (log_batch.empty()) {
             LOG_WARN("WalManager::Dequeue empty batch logs");
             continue;
         }
         // auto [max_commit_ts, wal_size] = GetWalState();
+        SizeT write_count = 0;
         for (const auto &entry : log_batch) {
             // Empty WalEntry (read-only transactions) shouldn't go into WalManager.
             if (entry == nullptr) {
@@ -164,21 +216,25 @@ void WalManager::Flush() {
             if (entry->cmds_.empty()) {
                 UnrecoverableError(fmt::format("WalEntry of txn_id {} commands is empty", entry->txn_id_));
             }
+            // Serialize in place into the write buffer of the wal file
             i32 exp_size = entry->GetSizeInBytes();
-            Vector<char> buf(exp_size);
-            char *ptr = buf.data();
+            char *const buf = wal_writer_.Reserve(exp_size);
+            char *ptr = buf;
             entry->WriteAdv(ptr);
-            i32 act_size = ptr - buf.data();
+            i32 act_size = ptr - buf;
             if (exp_size != act_size) {
                 UnrecoverableError(fmt::format("WalManager::Flush WalEntry estimated size {} differ with the actual one {}", exp_size, act_size));
             }
-            ofs_.write(buf.data(), ptr - buf.data());
-            LOG_TRACE(fmt::format("WalManager::Flush done writing wal for txn_id {}, commit_ts {}", entry->txn_id_, entry->commit_ts_));
+            wal_writer_.Commit(act_size);
+            ++write_count;
 
             // update
             max_commit_ts_ = entry->commit_ts_;
             wal_size_ += act_size;
         }
+        // One write for the whole batch, unless it overflowed the write buffer
+        wal_writer_.FlushBuffer();
+        LOG_TRACE(fmt::format("WalManager::Flush done writing wal for {} txns, max commit_ts {}", write_count, max_commit_ts_));
 
         if (!running_.load()) {
             break;
@@ -186,18 +242,23 @@ void WalManager::Flush() {
 
         switch (flush_option_) {
             case FlushOption::kFlushAtOnce: {
-                ofs_.flush();
+                // One sync for the whole batch, before any txn of it is committed
+                auto begin = std::chrono::steady_clock::now();
+                wal_writer_.Sync();
+                i64 sync_cost_us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count();
+                sync_cost_us_ = (sync_cost_us_ * 7 + sync_cost_us) / 8;
                 break;
             }
             case FlushOption::kOnlyWrite: {
-                ofs_.flush(); // FIXME: not flush, only write
+                // Data is in the page cache, the OS decides when it gets persisted
                 break;
             }
             case FlushOption::kFlushPerSecond: {
-                ofs_.flush(); // FIXME: not flush, flush per second
+                // SyncTimer persists the data
                 break;
             }
         }
+        last_batch_size_ = log_batch.size();
 
         TxnManager *txn_mgr = storage_->txn_manager();
         // Commit sequentially so they get visible in the same order with wal.
@@ -211,9 +272,7 @@ void WalManager::Flush() {
 
         // Check if the wal file is too large, swap to a new one.
         try {
-            LocalFileSystem fs;
-            auto file_size = fs.GetFileSizeByPath(wal_path_);
-            if (file_size > cfg_wal_size_threshold_) {
+            if (wal_writer_.FileSize() > cfg_wal_size_threshold_) {
                 this->SwapWalFile(max_commit_ts_);
             }
         } catch (RecoverableException &e) {
@@ -237,6 +296,15 @@ void WalManager::Flush() {
     LOG_TRACE("WalManager::Flush mainloop end");
 }
 
+void WalManager::SyncTimer() {
+    LOG_TRACE("WalManager::SyncTimer mainloop begin");
+    std::unique_lock lock(sync_mutex_);
+    while (!sync_cv_.wait_for(lock, std::chrono::milliseconds(WAL_SYNC_INTERVAL_MS), [this] { return sync_stop_; })) {
+        wal_writer_.Sync();
+    }
+    LOG_TRACE("WalManager::SyncTimer mainloop end");
+}
+
 bool WalManager::TrySubmitCheckpointTask(SharedPtr<CheckpointTaskBase> ckp_task) {
     bool expect = false;
     if (checkpoint_in_progress_.compare_exchange_strong(expect, true)) {
@@ -308,12 +376,34 @@ void WalManager::CheckpointInner(bool is_full_checkpoint, Txn *txn, TxnTimeStamp
         LOG_CRITICAL(fmt::format("WalManager::Checkpoint failed: {}", e.what()));
         throw e;
     }
+    TxnTimeStamp prev_ckp_ts = last_ckp_ts_;
     last_ckp_ts_ = max_commit_ts;
     WalFile::RecycleWalFile(max_commit_ts, wal_dir_);
     if (is_full_checkpoint) {
         last_full_ckp_ts_ = max_commit_ts;
         const auto &catalog_dir = *storage_->catalog()->CatalogDir();
         CatalogFile::RecycleCatalogFile(max_commit_ts, catalog_dir);
+        delta_ckp_file_count_ = 0;
+    } else {
+        ++delta_ckp_file_count_;
+        // The checkpoint just done isn't in the wal until its txn commits, only the files of the previous checkpoints are merged.
+        if (cfg_delta_checkpoint_compact_threshold_ != 0 && delta_ckp_file_count_ >= cfg_delta_checkpoint_compact_threshold_ &&
+            prev_ckp_ts != UNCOMMIT_TS) {
+            this->CompactDeltaCatalog(prev_ckp_ts);
+        }
+    }
+}
+
+void WalManager::CompactDeltaCatalog(TxnTimeStamp max_checkpoint_ts) {
+    // Runs on the background processor after the delta checkpoint, it only reads and writes catalog files so commits go on meanwhile.
+    const auto &catalog_dir = *storage_->catalog()->CatalogDir();
+    try {
+        SizeT merged_file_count = Catalog::CompactDeltaCatalogFiles(catalog_dir, max_checkpoint_ts);
+        if (merged_file_count > 0) {
+            delta_ckp_file_count_ -= merged_file_count - 1;
+        }
+    } catch (RecoverableException &e) {
+        LOG_ERROR(fmt::format("WalManager::CompactDeltaCatalog failed: {}", e.what()));
     }
 }
 
@@ -327,9 +417,8 @@ void WalManager::CheckpointInner(bool is_full_checkpoint, Txn *txn, TxnTimeStamp
  * current wal file.
  */
 void WalManager::SwapWalFile(const TxnTimeStamp max_commit_ts) {
-    if (ofs_.is_open()) {
-        ofs_.close();
-    }
+    // The renamed file is not written anymore, make it durable unless the user opted out of syncing.
+    wal_writer_.Close(flush_option_ != FlushOption::kOnlyWrite);
 
     String new_file_path = fmt::format("{}/{}", wal_dir_, WalFile::WalFilename(max_commit_ts));
     LOG_INFO(fmt::format("Wal {} swap to new path: {}", wal_path_, new_file_path));
@@ -337,12 +426,11 @@ void WalManager::SwapWalFile(const TxnTimeStamp max_commit_ts) {
     // Rename the current wal file to a new one.
     LocalFileSystem fs;
     fs.Rename(wal_path_, new_file_path);
+    fs.SyncDirectory(wal_dir_);
 
     // Create a new wal file with the original name.
-    ofs_ = std::ofstream(wal_path_, std::ios::app | std::ios::binary);
-    if (!ofs_.is_open()) {
-        UnrecoverableError(fmt::format("Failed to open wal file: {}", wal_path_));
-    }
+    wal_writer_.Open(wal_path_);
+    fs.SyncDirectory(wal_dir_);
     LOG_INFO(fmt::format("Open new wal file {}", wal_path_));
 }
 
@@ -415,13 +503,17 @@ i64 WalManager::ReplayWalFile() {
     LOG_INFO("Start Wal Replay");
     // log the wal files.
 
+    // Decodes the wal files, and replays the data of independent tables, in parallel
+    SizeT replay_thread_num = std::clamp<SizeT>(Thread::hardware_concurrency(), 1, WAL_REPLAY_MAX_THREAD_NUM);
+    ThreadPool replay_thread_pool(replay_thread_num);
+
     TxnTimeStamp max_commit_ts = 0;
     Vector<SharedPtr<WalEntry>> replay_entries;
     String catalog_dir = "";
     TxnTimeStamp system_start_ts = 0;
 
     { // if no checkpoint, max_commit_ts is 0
-        WalListIterator iterator(wal_list);
+        WalListIterator iterator(wal_list, &replay_thread_pool);
         // phase 1: find the max commit ts and catalog path
         LOG_INFO("Replay phase 1: find the max commit ts and catalog path");
         while (true) {
@@ -430,7 +522,7 @@ i64 WalManager::ReplayWalFile() {
                 break;
             }
 
-            LOG_INFO(wal_entry->ToString());
+            LOG_TRACE(wal_entry->ToString());
 
             WalCmdCheckpoint *checkpoint_cmd = nullptr;
             if (wal_entry->IsCheckPoint(replay_entries, checkpoint_cmd)) {
@@ -472,22 +564,33 @@ i64 WalManager::ReplayWalFile() {
     }
     auto &[full_catalog_fileinfo, delta_catalog_fileinfos] = catalog_fileinfo.value();
     storage_->AttachCatalog(full_catalog_fileinfo, delta_catalog_fileinfos);
+    delta_ckp_file_count_ = delta_catalog_fileinfos.size();
 
     // phase 3: replay the entries
     LOG_INFO(fmt::format("Replay phase 3: replay {} entries", replay_entries.size()));
     std::reverse(replay_entries.begin(), replay_entries.end());
     TransactionID last_txn_id = 0;
 
+    Vector<const WalEntry *> table_data_entries;
     for (SizeT replay_count = 0; replay_count < replay_entries.size(); ++replay_count) {
-        if (replay_entries[replay_count]->commit_ts_ < max_commit_ts) {
+        const WalEntry &entry = *replay_entries[replay_count];
+        if (entry.commit_ts_ < max_commit_ts) {
             UnrecoverableError("Wal Replay: Commit ts should be greater than max commit ts");
         }
-        system_start_ts = replay_entries[replay_count]->commit_ts_;
-        last_txn_id = replay_entries[replay_count]->txn_id_;
+        system_start_ts = entry.commit_ts_;
+        last_txn_id = entry.txn_id_;
+        LOG_TRACE(entry.ToString());
 
-        ReplayWalEntry(*replay_entries[replay_count]);
-        LOG_INFO(replay_entries[replay_count]->ToString());
+        if (IsTableDataEntry(entry)) {
+            table_data_entries.push_back(&entry);
+            continue;
+        }
+        // Other commands create, drop or reorganize tables, replay the data they may depend on first.
+        ReplayTableDataEntries(table_data_entries, replay_thread_pool);
+        table_data_entries.clear();
+        ReplayWalEntry(entry);
     }
+    ReplayTableDataEntries(table_data_entries, replay_thread_pool);
 
     LOG_TRACE(fmt::format("System start ts: {}, lastest txn id: {}", system_start_ts, last_txn_id));
     storage_->catalog()->next_txn_id_ = last_txn_id;
@@ -498,6 +601,65 @@ i64 WalManager::ReplayWalFile() {
     return system_start_ts;
 }
 
+void WalManager::ReplayTableDataEntries(const Vector<const WalEntry *> &entries, ThreadPool &thread_pool) {
+    if (entries.empty()) {
+        return;
+    }
+    Map<Pair<String, String>, Vector<Pair<WalCmd *, const WalEntry *>>> table_cmds;
+    for (const WalEntry *entry : entries) {
+        for (const auto &cmd : entry->cmds_) {
+            switch (cmd->GetType()) {
+                case WalCommandType::APPEND: {
+                    auto *append_cmd = static_cast<WalCmdAppend *>(cmd.get());
+                    table_cmds[{append_cmd->db_name_, append_cmd->table_name_}].emplace_back(cmd.get(), entry);
+                    break;
+                }
+                case WalCommandType::DELETE: {
+                    auto *delete_cmd = static_cast<WalCmdDelete *>(cmd.get());
+                    table_cmds[{delete_cmd->db_name_, delete_cmd->table_name_}].emplace_back(cmd.get(), entry);
+                    break;
+                }
+                default: {
+                    UnrecoverableError(fmt::format("Wal Replay: unexpected wal command {} in table data", WalCmd::WalCommandTypeToString(cmd->GetType())));
+                }
+            }
+        }
+    }
+
+    auto replay_table = [this](const Vector<Pair<WalCmd *, const WalEntry *>> &cmds) {
+        for (const auto &[cmd, entry] : cmds) {
+            LOG_TRACE(fmt::format("Replay wal cmd: {}, commit ts: {}", WalCmd::WalCommandTypeToString(cmd->GetType()).c_str(), entry->commit_ts_));
+            if (cmd->GetType() == WalCommandType::APPEND) {
+                WalCmdAppendReplay(*static_cast<const WalCmdAppend *>(cmd), entry->txn_id_, entry->commit_ts_);
+            } else {
+                WalCmdDeleteReplay(*static_cast<const WalCmdDelete *>(cmd), entry->txn_id_, entry->commit_ts_);
+            }
+        }
+    };
+    if (table_cmds.size() == 1) {
+        replay_table(table_cmds.begin()->second);
+        return;
+    }
+    Vector<std::future<void>> futures;
+    for (const auto &[table_name, cmds] : table_cmds) {
+        futures.push_back(thread_pool.push([&replay_table, &cmds](int) { replay_table(cmds); }));
+    }
+    // Wait for all the tables before rethrowing, they reference table_cmds.
+    std::exception_ptr exception;
+    for (auto &future : futures) {
+        try {
+            future.get();
+        } catch (...) {
+            if (!exception) {
+                exception = std::current_exception();
+            }
+        }
+    }
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+}
+
 void WalManager::ReplayWalEntry(const WalEntry &entry) {
     for (const auto &cmd : entry.cmds_) {
         LOG_TRACE(fmt::format("Replay wal cmd: {}, commit ts: {}", WalCmd::WalCommandTypeToString(cmd->GetType()).c_str(), entry.commit_ts_));
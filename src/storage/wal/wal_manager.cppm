@@ -22,6 +22,7 @@ import wal_entry;
 import options;
 import catalog_delta_entry;
 import wal_entry_blocking_queue;
+import wal_file_writer;
 
 namespace infinity {
 
@@ -33,7 +34,13 @@ class SegmentEntry;
 
 export class WalManager {
 public:
-    WalManager(Storage *storage, String wal_dir, u64 wal_size_threshold, u64 delta_checkpoint_interval_wal_bytes, FlushOption flush_option);
+    WalManager(Storage *storage,
+               String wal_dir,
+               u64 wal_size_threshold,
+               u64 delta_checkpoint_interval_wal_bytes,
+               FlushOption flush_option,
+               u64 wal_compress_threshold = 0,
+               u64 delta_checkpoint_compact_threshold = 0);
 
     ~WalManager();
 
@@ -42,7 +49,8 @@ public:
     void Stop();
 
     // Session request to persist an entry. Assuming txn_id of the entry has
-    // been initialized.
+    // been initialized. Large entries are compressed here, in the committing
+    // thread, to keep the flush thread serial part short.
     void PutEntry(WalEntry *entry, Txn *txn);
 
     // Flush is scheduled regularly. It collects a batch of transactions, sync
@@ -51,6 +59,9 @@ public:
     // checkpoint for a batch of sync.
     void Flush();
 
+    // Syncs the wal file every WAL_SYNC_INTERVAL_MS, only runs with FlushOption::kFlushPerSecond.
+    void SyncTimer();
+
     bool TrySubmitCheckpointTask(SharedPtr<CheckpointTaskBase> ckp_task);
 
     void Checkpoint(bool is_full_checkpoint, TxnTimeStamp max_commit_ts, i64 wal_size);
@@ -63,6 +74,10 @@ public:
 
     void ReplayWalEntry(const WalEntry &entry);
 
+    // Replays consecutive entries made only of appends and deletes. The commands are partitioned by table, and the
+    // tables are replayed concurrently, each in commit order.
+    void ReplayTableDataEntries(const Vector<const WalEntry *> &entries, ThreadPool &thread_pool);
+
     void RecycleWalFile(TxnTimeStamp full_ckp_ts);
 
     // Should only call in `Flush` thread
@@ -72,6 +87,10 @@ private:
     // Checkpoint Helper
     void CheckpointInner(bool is_full_checkpoint, Txn *txn, TxnTimeStamp max_commit_ts, i64 wal_size);
 
+    // Merges the delta catalog files written since the last full checkpoint into one, so that a restart reads and replays
+    // a delta bounded by the catalog size instead of every delta checkpoint of the day.
+    void CompactDeltaCatalog(TxnTimeStamp max_checkpoint_ts);
+
     void SetLastCkpWalSize(i64 wal_size);
     i64 GetLastCkpWalSize();
 
@@ -95,6 +114,8 @@ private:
 public:
     u64 cfg_wal_size_threshold_{};
     u64 cfg_delta_checkpoint_interval_wal_bytes_{};
+    u64 cfg_wal_compress_threshold_{}; // 0: never compress
+    u64 cfg_delta_checkpoint_compact_threshold_{}; // 0: never merge delta catalog files
 
 private:
     // Concurrent writing WAL is disallowed. So put all WAL writing into a queue
@@ -107,15 +128,25 @@ private:
     // WalManager state
     Atomic<bool> running_{};
     Thread flush_thread_{};
+    Thread sync_thread_{};
+    std::mutex sync_mutex_{};
+    std::condition_variable sync_cv_{};
+    bool sync_stop_{false};
 
     // TxnManager and Flush thread access following members
     WALEntryBlockingQueue blocking_queue_{};
 
     // Only Flush thread access following members
-    std::ofstream ofs_{};
     TxnTimeStamp max_commit_ts_{};
     i64 wal_size_{};
     FlushOption flush_option_{FlushOption::kOnlyWrite};
+    // Group commit state for FlushOption::kFlushAtOnce: the moving average of the fdatasync cost and the size of the
+    // last batch decide how long the next batch may wait to grow.
+    i64 sync_cost_us_{};
+    SizeT last_batch_size_{};
+
+    // Flush thread writes, sync thread syncs
+    WalFileWriter wal_writer_{};
 
     // Flush and Checkpoint threads access following members
     std::mutex mutex2_{};
@@ -125,6 +156,7 @@ private:
     // Only Checkpoint thread access following members
     TxnTimeStamp last_ckp_ts_{};
     TxnTimeStamp last_full_ckp_ts_{};
+    SizeT delta_ckp_file_count_{}; // delta catalog files since the last full checkpoint
 };
 
 } // namespace infinity
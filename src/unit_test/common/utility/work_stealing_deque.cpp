@@ -0,0 +1,87 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "unit_test/base_test.h"
+
+import stl;
+import work_stealing_deque;
+
+using namespace infinity;
+
+class WorkStealingDequeTest : public BaseTest {};
+
+TEST_F(WorkStealingDequeTest, pop_and_steal) {
+    WorkStealingDeque<SizeT> deque(2);
+    SizeT item = 0;
+    EXPECT_FALSE(deque.Pop(item));
+    EXPECT_FALSE(deque.Steal(item));
+
+    // grows past the initial capacity
+    for (SizeT i = 0; i < 10; ++i) {
+        deque.Push(i);
+    }
+    // the owner takes the last pushed, thieves the first pushed
+    ASSERT_TRUE(deque.Pop(item));
+    EXPECT_EQ(item, 9u);
+    ASSERT_TRUE(deque.Steal(item));
+    EXPECT_EQ(item, 0u);
+    for (SizeT i = 8; i >= 1; --i) {
+        ASSERT_TRUE(deque.Pop(item));
+        EXPECT_EQ(item, i);
+    }
+    EXPECT_TRUE(deque.Empty());
+    EXPECT_FALSE(deque.Pop(item));
+    EXPECT_FALSE(deque.Steal(item));
+}
+
+TEST_F(WorkStealingDequeTest, concurrent_steal) {
+    constexpr SizeT item_count = 100000;
+    constexpr SizeT thief_count = 3;
+    WorkStealingDeque<SizeT> deque;
+    Vector<Atomic<u32>> taken(item_count);
+    atomic_bool done{false};
+
+    auto take = [&](SizeT item) { ++taken[item]; };
+    Vector<Thread> thieves;
+    for (SizeT i = 0; i < thief_count; ++i) {
+        thieves.emplace_back([&] {
+            SizeT item = 0;
+            while (!done) {
+                if (deque.Steal(item)) {
+                    take(item);
+                }
+            }
+        });
+    }
+    // the owner pushes, and pops every other round
+    SizeT item = 0;
+    for (SizeT i = 0; i < item_count; ++i) {
+        deque.Push(i);
+        if (i % 2 == 1 && deque.Pop(item)) {
+            take(item);
+        }
+    }
+    while (deque.Pop(item)) {
+        take(item);
+    }
+    done = true;
+    for (auto &thief : thieves) {
+        thief.join();
+    }
+    // every item is taken exactly once
+    for (SizeT i = 0; i < item_count; ++i) {
+        ASSERT_EQ(taken[i].load(), 1u) << "item " << i;
+    }
+}
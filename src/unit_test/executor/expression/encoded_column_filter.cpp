@@ -0,0 +1,135 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "unit_test/base_test.h"
+
+import infinity_exception;
+
+import stl;
+import catalog;
+import less;
+import equals;
+import and_func;
+import base_expression;
+import value_expression;
+import in_expression;
+import column_vector;
+import column_block_encoding;
+import expression_selector;
+import value;
+import data_block;
+import default_values;
+import logical_type;
+import internal_types;
+import data_type;
+import expression_test_helper;
+
+using namespace infinity;
+
+// Filters over dictionary / RLE encoded columns, as the table scan emits them for sealed blocks.
+class EncodedColumnFilterTest : public BaseTest {
+protected:
+    void SetUp() override {
+        BaseTest::SetUp();
+        catalog_ = MakeUnique<Catalog>(MakeShared<String>("/tmp/infinity/data"));
+        RegisterLessFunction(catalog_);
+        RegisterEqualsFunction(catalog_);
+        RegisterAndFunction(catalog_);
+    }
+
+    // c0 = i, c1 = elements[start_row + i] read encoded from a block of elements, up to the end of the block
+    static SharedPtr<DataBlock> MakeBlock(const Vector<i64> &elements, SizeT start_row, ColumnBlockEncoding expected_encoding) {
+        auto data_type = MakeShared<DataType>(LogicalType::kBigInt);
+        auto block_column = MakeShared<ColumnVector>(data_type);
+        block_column->Initialize(ColumnVectorType::kFlat, elements.size());
+        for (i64 element : elements) {
+            block_column->AppendValue(Value::MakeBigInt(element));
+        }
+        SharedPtr<ColumnBlockDictionary> dictionary =
+            AnalyzeColumnBlock(reinterpret_cast<const char *>(elements.data()), sizeof(i64), elements.size());
+        EXPECT_NE(dictionary, nullptr);
+        EXPECT_EQ(dictionary->encoding_, expected_encoding);
+
+        auto encoded_column = MakeShared<ColumnVector>(data_type);
+        encoded_column->InitializeEncoded(*block_column, *dictionary, start_row, elements.size() - start_row);
+        EXPECT_TRUE(encoded_column->IsEncoded());
+
+        auto row_column = MakeShared<ColumnVector>(data_type);
+        row_column->Initialize();
+        for (SizeT i = start_row; i < elements.size(); ++i) {
+            row_column->AppendValue(Value::MakeBigInt(i - start_row));
+        }
+        auto data_block = DataBlock::Make();
+        data_block->Init(Vector<SharedPtr<ColumnVector>>{row_column, encoded_column});
+        return data_block;
+    }
+
+    SharedPtr<BaseExpression> MakeCompare(const String &op, SizeT column_idx, i64 value) {
+        auto column = ExpressionTestHelper::MakeColumn(LogicalType::kBigInt, column_idx);
+        return ExpressionTestHelper::MakeFunction(catalog_.get(), op, {column, MakeShared<ValueExpression>(Value::MakeBigInt(value))});
+    }
+
+    // Runs the filters over the block and checks the selected rows against the plain elements.
+    void CheckFilters(const Vector<i64> &elements, SizeT start_row, ColumnBlockEncoding expected_encoding) {
+        auto data_block = MakeBlock(elements, start_row, expected_encoding);
+        auto expect_rows = [&](const std::function<bool(i64, SizeT)> &predicate) {
+            Vector<SizeT> rows;
+            for (SizeT i = 0; i + start_row < elements.size(); ++i) {
+                if (predicate(elements[start_row + i], i)) {
+                    rows.push_back(i);
+                }
+            }
+            return rows;
+        };
+        ExpressionSelector selector;
+
+        // c1 < 3, evaluated once per dictionary entry
+        EXPECT_EQ(ExpressionTestHelper::SelectRows(selector, MakeCompare("<", 1, 3), data_block.get()),
+                  expect_rows([](i64 value, SizeT) { return value < 3; }));
+
+        // c1 IN (1, 4)
+        auto column = ExpressionTestHelper::MakeColumn(LogicalType::kBigInt, 1);
+        Vector<SharedPtr<BaseExpression>> value_list{MakeShared<ValueExpression>(Value::MakeBigInt(1)),
+                                                     MakeShared<ValueExpression>(Value::MakeBigInt(4))};
+        auto in_expr = MakeShared<InExpression>(InType::kIn, column, value_list);
+        EXPECT_EQ(ExpressionTestHelper::SelectRows(selector, in_expr, data_block.get()),
+                  expect_rows([](i64 value, SizeT) { return value == 1 || value == 4; }));
+
+        // c1 = 2 AND c0 < 5000, the encoded conjunct runs over the rows surviving the other one or the other way round
+        auto and_expr = ExpressionTestHelper::MakeFunction(catalog_.get(), "AND", {MakeCompare("=", 1, 2), MakeCompare("<", 0, 5000)});
+        for (SizeT round = 0; round < 4; ++round) {
+            EXPECT_EQ(ExpressionTestHelper::SelectRows(selector, and_expr, data_block.get()),
+                      expect_rows([](i64 value, SizeT row) { return value == 2 && row < 5000; }));
+        }
+    }
+
+    UniquePtr<Catalog> catalog_{};
+};
+
+TEST_F(EncodedColumnFilterTest, Dictionary) {
+    Vector<i64> elements;
+    for (SizeT i = 0; i < DEFAULT_BLOCK_CAPACITY; ++i) {
+        elements.push_back((i * 7) % 5);
+    }
+    CheckFilters(elements, 1000, ColumnBlockEncoding::kDictionary);
+}
+
+TEST_F(EncodedColumnFilterTest, RunLength) {
+    Vector<i64> elements;
+    for (SizeT i = 0; i < DEFAULT_BLOCK_CAPACITY; ++i) {
+        elements.push_back(i / 300 % 5);
+    }
+    CheckFilters(elements, 1000, ColumnBlockEncoding::kRLE);
+}
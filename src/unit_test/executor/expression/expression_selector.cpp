@@ -0,0 +1,134 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "unit_test/base_test.h"
+
+import infinity_exception;
+
+import stl;
+import catalog;
+import less;
+import equals;
+import and_func;
+import or_func;
+import base_expression;
+import value_expression;
+import column_vector;
+import expression_state;
+import expression_selector;
+import selection;
+import value;
+import data_block;
+import default_values;
+import logical_type;
+import internal_types;
+import data_type;
+import expression_test_helper;
+
+using namespace infinity;
+
+class ExpressionSelectorTest : public BaseTest {
+protected:
+    void SetUp() override {
+        BaseTest::SetUp();
+        catalog_ = MakeUnique<Catalog>(MakeShared<String>("/tmp/infinity/data"));
+        RegisterLessFunction(catalog_);
+        RegisterEqualsFunction(catalog_);
+        RegisterAndFunction(catalog_);
+        RegisterOrFunction(catalog_);
+    }
+
+    SharedPtr<BaseExpression> MakeFunction(const String &name, Vector<SharedPtr<BaseExpression>> arguments) {
+        return ExpressionTestHelper::MakeFunction(catalog_.get(), name, std::move(arguments));
+    }
+
+    // column_idx op value
+    SharedPtr<BaseExpression> MakeCompare(const String &op, SizeT column_idx, i64 value) {
+        auto column = ExpressionTestHelper::MakeColumn(LogicalType::kBigInt, column_idx);
+        return MakeFunction(op, {column, MakeShared<ValueExpression>(Value::MakeBigInt(value))});
+    }
+
+    // c0 = i, c1 = i % 10
+    SharedPtr<DataBlock> MakeBlock() {
+        auto data_type = MakeShared<DataType>(LogicalType::kBigInt);
+        auto data_block = DataBlock::Make();
+        data_block->Init({data_type, data_type});
+        for (SizeT i = 0; i < DEFAULT_VECTOR_SIZE; ++i) {
+            data_block->AppendValue(0, Value::MakeBigInt(i));
+            data_block->AppendValue(1, Value::MakeBigInt(i % 10));
+        }
+        data_block->Finalize();
+        return data_block;
+    }
+
+    UniquePtr<Catalog> catalog_{};
+};
+
+TEST_F(ExpressionSelectorTest, ShortCircuitAnd) {
+    auto data_block = MakeBlock();
+    // c0 < 1000 AND c1 = 3 AND c0 < 500
+    auto expr = MakeFunction("AND", {MakeFunction("AND", {MakeCompare("<", 0, 1000), MakeCompare("=", 1, 3)}), MakeCompare("<", 0, 500)});
+
+    ExpressionSelector selector;
+    // The order of the conjuncts changes over the blocks, the result doesn't.
+    for (SizeT round = 0; round < 4; ++round) {
+        Vector<SizeT> rows = ExpressionTestHelper::SelectRows(selector, expr, data_block.get());
+        ASSERT_EQ(rows.size(), 50u);
+        for (SizeT i = 0; i < rows.size(); ++i) {
+            EXPECT_EQ(rows[i], i * 10 + 3);
+        }
+    }
+}
+
+TEST_F(ExpressionSelectorTest, ShortCircuitOr) {
+    auto data_block = MakeBlock();
+    // c0 < 10 OR c1 = 3 OR c0 = 8000
+    auto expr = MakeFunction("OR", {MakeFunction("OR", {MakeCompare("<", 0, 10), MakeCompare("=", 1, 3)}), MakeCompare("=", 0, 8000)});
+
+    Vector<SizeT> expected;
+    for (SizeT i = 0; i < DEFAULT_VECTOR_SIZE; ++i) {
+        if (i < 10 || i % 10 == 3 || i == 8000) {
+            expected.push_back(i);
+        }
+    }
+    ExpressionSelector selector;
+    for (SizeT round = 0; round < 4; ++round) {
+        EXPECT_EQ(ExpressionTestHelper::SelectRows(selector, expr, data_block.get()), expected);
+    }
+}
+
+TEST_F(ExpressionSelectorTest, NestedAndOr) {
+    auto data_block = MakeBlock();
+    // c0 < 2000 AND (c1 = 1 OR c1 = 2)
+    auto expr = MakeFunction("AND", {MakeCompare("<", 0, 2000), MakeFunction("OR", {MakeCompare("=", 1, 1), MakeCompare("=", 1, 2)})});
+
+    // Rows not selected by the AND are returned as false rows.
+    ExpressionSelector selector;
+    SharedPtr<ExpressionState> state = ExpressionState::CreateState(expr);
+    auto true_select = MakeShared<Selection>();
+    true_select->Initialize(DEFAULT_VECTOR_SIZE);
+    auto false_select = MakeShared<Selection>();
+    false_select->Initialize(DEFAULT_VECTOR_SIZE);
+    SharedPtr<DataBlock> output_block = DataBlock::Make();
+    SizeT count = selector.Select(expr, state, data_block.get(), output_block.get(), DEFAULT_VECTOR_SIZE);
+    EXPECT_EQ(count, 400u);
+
+    state = ExpressionState::CreateState(expr);
+    selector.Select(expr, state, DEFAULT_VECTOR_SIZE, nullptr, true_select, false_select);
+    ASSERT_EQ(true_select->Size(), 400u);
+    EXPECT_EQ(false_select->Size(), DEFAULT_VECTOR_SIZE - 400);
+    for (SizeT i = 0; i < true_select->Size(); ++i) {
+        EXPECT_EQ((*true_select)[i], (i / 2) * 10 + 1 + i % 2);
+    }
+}
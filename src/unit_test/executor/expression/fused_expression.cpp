@@ -0,0 +1,151 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "unit_test/base_test.h"
+
+import stl;
+import third_party;
+import catalog;
+import function_set;
+import scalar_function;
+import scalar_function_set;
+import add;
+import substract;
+import multiply;
+import greater;
+import less;
+import base_expression;
+import value_expression;
+import reference_expression;
+import function_expression;
+import column_vector;
+import expression_state;
+import expression_evaluator;
+import value;
+import data_block;
+import default_values;
+import logical_type;
+import internal_types;
+import data_type;
+
+using namespace infinity;
+
+class FusedExpressionTest : public BaseTest {
+protected:
+    void SetUp() override {
+        BaseTest::SetUp();
+        catalog_ = MakeUnique<Catalog>(MakeShared<String>("/tmp/infinity/data"));
+        RegisterAddFunction(catalog_);
+        RegisterSubtractFunction(catalog_);
+        RegisterMulFunction(catalog_);
+        RegisterGreaterFunction(catalog_);
+        RegisterLessFunction(catalog_);
+    }
+
+    SharedPtr<BaseExpression> MakeFunction(const String &name, SharedPtr<BaseExpression> left, SharedPtr<BaseExpression> right) {
+        SharedPtr<FunctionSet> function_set = Catalog::GetFunctionSetByName(catalog_.get(), name);
+        auto scalar_function_set = std::static_pointer_cast<ScalarFunctionSet>(function_set);
+        Vector<SharedPtr<BaseExpression>> arguments{std::move(left), std::move(right)};
+        ScalarFunction func = scalar_function_set->GetMostMatchFunction(arguments);
+        return MakeShared<FunctionExpression>(func, arguments);
+    }
+
+    static SharedPtr<BaseExpression> MakeColumn(LogicalType type, SizeT column_idx) {
+        return ReferenceExpression::Make(DataType(type), "t1", fmt::format("c{}", column_idx), String(), column_idx);
+    }
+
+    // three columns of the type, every 7th row of c1 is null
+    template <typename T>
+    static SharedPtr<DataBlock> MakeBlock(LogicalType type, std::function<Value(T)> make_value, const Array<T, 3> &scales) {
+        auto data_block = DataBlock::Make();
+        auto data_type = MakeShared<DataType>(type);
+        data_block->Init({data_type, data_type, data_type});
+        for (SizeT i = 0; i < DEFAULT_VECTOR_SIZE; ++i) {
+            for (SizeT column_idx = 0; column_idx < 3; ++column_idx) {
+                data_block->AppendValue(column_idx, make_value(static_cast<T>(i) * scales[column_idx]));
+            }
+        }
+        data_block->Finalize();
+        for (SizeT i = 0; i < DEFAULT_VECTOR_SIZE; i += 7) {
+            data_block->column_vectors[1]->nulls_ptr_->SetFalse(i);
+        }
+        return data_block;
+    }
+
+    static SharedPtr<ColumnVector> Evaluate(const SharedPtr<BaseExpression> &expr, const DataBlock *data_block, bool fuse, bool &fused) {
+        ExpressionState::enable_expression_fusion_ = fuse;
+        SharedPtr<ExpressionState> state = ExpressionState::CreateState(expr);
+        ExpressionState::enable_expression_fusion_ = true;
+        fused = state->fused_expression_ != nullptr;
+        ExpressionEvaluator evaluator;
+        evaluator.Init(data_block);
+        SharedPtr<ColumnVector> output = state->OutputColumnVector();
+        evaluator.Execute(expr, state, output);
+        return output;
+    }
+
+    // evaluates the expression both ways and compares the results row by row
+    static void CheckSameResult(const SharedPtr<BaseExpression> &expr, const DataBlock *data_block, bool expect_fused) {
+        bool fused = false;
+        SharedPtr<ColumnVector> fused_output = Evaluate(expr, data_block, true, fused);
+        EXPECT_EQ(fused, expect_fused);
+        SharedPtr<ColumnVector> expected_output = Evaluate(expr, data_block, false, fused);
+        EXPECT_FALSE(fused);
+        ASSERT_EQ(fused_output->Size(), expected_output->Size());
+        for (SizeT i = 0; i < expected_output->Size(); ++i) {
+            bool is_valid = expected_output->nulls_ptr_->IsTrue(i);
+            ASSERT_EQ(fused_output->nulls_ptr_->IsTrue(i), is_valid) << "row " << i;
+            if (is_valid) {
+                ASSERT_EQ(fused_output->GetValue(i), expected_output->GetValue(i)) << "row " << i;
+            }
+        }
+    }
+
+    UniquePtr<Catalog> catalog_{};
+};
+
+TEST_F(FusedExpressionTest, compare_arithmetic_bigint) {
+    // c0 * 2 overflows from row 5000 on
+    auto block = MakeBlock<BigIntT>(LogicalType::kBigInt, Value::MakeBigInt, {std::numeric_limits<BigIntT>::max() / 10000, 3, 5});
+    auto c0 = MakeColumn(LogicalType::kBigInt, 0);
+    auto c1 = MakeColumn(LogicalType::kBigInt, 1);
+    auto c2 = MakeColumn(LogicalType::kBigInt, 2);
+    auto two = MakeShared<ValueExpression>(Value::MakeBigInt(2));
+
+    // c0 * 2 + c1 > c2
+    CheckSameResult(MakeFunction(">", MakeFunction("+", MakeFunction("*", c0, two), c1), c2), block.get(), true);
+    // c0 + c1 < c2
+    CheckSameResult(MakeFunction("<", MakeFunction("+", c0, c1), c2), block.get(), true);
+    // c2 > c1 * 2, the arithmetic child is on the right
+    CheckSameResult(MakeFunction(">", c2, MakeFunction("*", c1, two)), block.get(), true);
+    // c0 - c1 * 2, the arithmetic child of "-" is on the right, not fused
+    CheckSameResult(MakeFunction("-", c0, MakeFunction("*", c1, two)), block.get(), false);
+    // c0 + c1, a single node is not fused
+    CheckSameResult(MakeFunction("+", c0, c1), block.get(), false);
+}
+
+TEST_F(FusedExpressionTest, arithmetic_double) {
+    auto block = MakeBlock<DoubleT>(LogicalType::kDouble, Value::MakeDouble, {0.5, -1.25, 3.0});
+    auto c0 = MakeColumn(LogicalType::kDouble, 0);
+    auto c1 = MakeColumn(LogicalType::kDouble, 1);
+    auto c2 = MakeColumn(LogicalType::kDouble, 2);
+    auto constant = MakeShared<ValueExpression>(Value::MakeDouble(3.5));
+
+    // (c0 - 3.5) * c1
+    CheckSameResult(MakeFunction("*", MakeFunction("-", c0, constant), c1), block.get(), true);
+    // c2 + c0 * c1, swapped to c0 * c1 + c2
+    CheckSameResult(MakeFunction("+", c2, MakeFunction("*", c0, c1)), block.get(), true);
+    // (c0 * c1 - c2) < 3.5
+    CheckSameResult(MakeFunction("<", MakeFunction("-", MakeFunction("*", c0, c1), c2), constant), block.get(), true);
+}
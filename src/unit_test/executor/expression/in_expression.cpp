@@ -0,0 +1,111 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "unit_test/base_test.h"
+
+import infinity_exception;
+
+import stl;
+import third_party;
+import base_expression;
+import value_expression;
+import in_expression;
+import in_value_set;
+import column_vector;
+import expression_selector;
+import value;
+import data_block;
+import default_values;
+import logical_type;
+import internal_types;
+import data_type;
+import expression_test_helper;
+
+using namespace infinity;
+
+class InExpressionTest : public BaseTest {
+protected:
+    // c0 = i, c1 = "value_{i % 100}"
+    SharedPtr<DataBlock> MakeBlock() {
+        auto data_block = DataBlock::Make();
+        data_block->Init({MakeShared<DataType>(LogicalType::kBigInt), MakeShared<DataType>(LogicalType::kVarchar)});
+        for (SizeT i = 0; i < DEFAULT_VECTOR_SIZE; ++i) {
+            data_block->AppendValue(0, Value::MakeBigInt(i));
+            data_block->AppendValue(1, Value::MakeVarchar(fmt::format("value_{}", i % 100)));
+        }
+        data_block->Finalize();
+        return data_block;
+    }
+
+    SharedPtr<BaseExpression> MakeIn(InType in_type, SizeT column_idx, const Vector<Value> &values) {
+        auto column = ExpressionTestHelper::MakeColumn(column_idx == 0 ? LogicalType::kBigInt : LogicalType::kVarchar, column_idx);
+        Vector<SharedPtr<BaseExpression>> value_list;
+        for (const auto &value : values) {
+            value_list.push_back(MakeShared<ValueExpression>(value));
+        }
+        return MakeShared<InExpression>(in_type, column, value_list);
+    }
+
+    static Vector<SizeT> SelectRows(const SharedPtr<BaseExpression> &expr, const DataBlock *data_block) {
+        ExpressionSelector selector;
+        return ExpressionTestHelper::SelectRows(selector, expr, data_block);
+    }
+};
+
+TEST_F(InExpressionTest, SmallAndLargeList) {
+    auto data_block = MakeBlock();
+    // Duplicated, out of block and non integral values never match.
+    Vector<Value> small_list{Value::MakeBigInt(7), Value::MakeBigInt(3), Value::MakeBigInt(7), Value::MakeDouble(5.5), Value::MakeBigInt(-1)};
+    EXPECT_EQ(SelectRows(MakeIn(InType::kIn, 0, small_list), data_block.get()), (Vector<SizeT>{3, 7}));
+
+    Vector<Value> large_list;
+    Vector<SizeT> expected;
+    for (SizeT i = 0; i < DEFAULT_VECTOR_SIZE; i += 97) {
+        large_list.push_back(Value::MakeBigInt(i));
+        expected.push_back(i);
+    }
+    ASSERT_GT(large_list.size(), IN_SMALL_LIST_SIZE);
+    EXPECT_EQ(SelectRows(MakeIn(InType::kIn, 0, large_list), data_block.get()), expected);
+
+    Vector<SizeT> rows = SelectRows(MakeIn(InType::kNotIn, 0, large_list), data_block.get());
+    EXPECT_EQ(rows.size(), DEFAULT_VECTOR_SIZE - expected.size());
+    for (SizeT row : rows) {
+        EXPECT_NE(row % 97, 0u);
+    }
+}
+
+TEST_F(InExpressionTest, VarcharList) {
+    auto data_block = MakeBlock();
+    Vector<Value> values{Value::MakeVarchar("value_42"), Value::MakeVarchar("value_4"), Value::MakeVarchar("a_long_value_not_in_the_table")};
+    Vector<SizeT> rows = SelectRows(MakeIn(InType::kIn, 1, values), data_block.get());
+    EXPECT_EQ(rows.size(), DEFAULT_VECTOR_SIZE / 100 * 2);
+    for (SizeT row : rows) {
+        EXPECT_TRUE(row % 100 == 42 || row % 100 == 4);
+    }
+}
+
+TEST_F(InExpressionTest, NullInList) {
+    auto data_block = MakeBlock();
+    // x IN (1, NULL) is true or null, x NOT IN (1, NULL) is false or null, so no row passes NOT IN.
+    Vector<Value> values{Value::MakeBigInt(1), Value::MakeNull()};
+    EXPECT_EQ(SelectRows(MakeIn(InType::kIn, 0, values), data_block.get()), (Vector<SizeT>{1}));
+    EXPECT_TRUE(SelectRows(MakeIn(InType::kNotIn, 0, values), data_block.get()).empty());
+
+    InValueSet value_set(DataType(LogicalType::kInteger), {Value::MakeBigInt(1), Value::MakeBigInt(1L << 40), Value::MakeNull()});
+    EXPECT_TRUE(value_set.HasNull());
+    EXPECT_EQ(value_set.ValueCount(), 1u);
+    Vector<Value> points = value_set.ToValues();
+    ASSERT_EQ(points.size(), 1u);
+    EXPECT_EQ(points[0], Value::MakeInt(1));
+}
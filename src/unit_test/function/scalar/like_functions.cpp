@@ -0,0 +1,159 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "unit_test/base_test.h"
+
+import infinity_exception;
+
+import third_party;
+import stl;
+import catalog;
+import like;
+import scalar_function;
+import scalar_function_set;
+import function_set;
+import function;
+import column_expression;
+import value;
+import default_values;
+import data_block;
+import base_expression;
+import column_vector;
+import bitmask;
+import logical_type;
+import internal_types;
+import data_type;
+
+using namespace infinity;
+
+class LikeFunctionsTest : public BaseTest {
+protected:
+    static bool Match(const String &pattern, const String &str) { return LikePattern(pattern.data(), pattern.size()).Match(str.data(), str.size()); }
+};
+
+TEST_F(LikeFunctionsTest, pattern_type) {
+    EXPECT_EQ(LikePattern("abc", 3).type(), LikePatternType::kExact);
+    EXPECT_EQ(LikePattern("abc%", 4).type(), LikePatternType::kPrefix);
+    EXPECT_EQ(LikePattern("%%", 2).type(), LikePatternType::kPrefix);
+    EXPECT_EQ(LikePattern("%abc", 4).type(), LikePatternType::kSuffix);
+    EXPECT_EQ(LikePattern("%abc%", 5).type(), LikePatternType::kContains);
+    EXPECT_EQ(LikePattern("a%b%c", 5).type(), LikePatternType::kSegments);
+    EXPECT_EQ(LikePattern("a_c%", 4).type(), LikePatternType::kGeneral);
+}
+
+TEST_F(LikeFunctionsTest, pattern_match) {
+    EXPECT_TRUE(Match("abc", "abc"));
+    EXPECT_FALSE(Match("abc", "abcd"));
+    EXPECT_TRUE(Match("", ""));
+    EXPECT_FALSE(Match("", "a"));
+
+    EXPECT_TRUE(Match("abc%", "abcdefghijklmnopqrstuvwxyz"));
+    EXPECT_FALSE(Match("abc%", "ab"));
+    EXPECT_TRUE(Match("%", ""));
+    EXPECT_TRUE(Match("%%", "anything"));
+
+    EXPECT_TRUE(Match("%xyz", "abcdefghijklmnopqrstuvwxyz"));
+    EXPECT_FALSE(Match("%xyz", "xyzw"));
+
+    EXPECT_TRUE(Match("%mno%", "abcdefghijklmnopqrstuvwxyz"));
+    EXPECT_TRUE(Match("%m%", "abcdefghijklmnopqrstuvwxyz"));
+    EXPECT_FALSE(Match("%mnp%", "abcdefghijklmnopqrstuvwxyz"));
+
+    EXPECT_TRUE(Match("a%b%c", "a__b__c"));
+    EXPECT_TRUE(Match("a%bc%bc", "abcbc"));
+    EXPECT_FALSE(Match("a%bc%bc", "abc"));
+    // The anchored segments may not overlap.
+    EXPECT_FALSE(Match("ab%ba", "aba"));
+    EXPECT_TRUE(Match("%ab%cd%", "xxabyycdzz"));
+    EXPECT_FALSE(Match("%cd%ab%", "xxabyycdzz"));
+
+    EXPECT_TRUE(Match("a_c", "abc"));
+    EXPECT_FALSE(Match("a_c", "ac"));
+    EXPECT_TRUE(Match("%b_d%", "abcde"));
+    // '_' at the end of the pattern doesn't read past the string.
+    EXPECT_FALSE(Match("abc_", "abc"));
+}
+
+TEST_F(LikeFunctionsTest, like_func) {
+    UniquePtr<Catalog> catalog_ptr = MakeUnique<Catalog>(MakeShared<String>("/tmp/infinity/data"));
+    RegisterLikeFunction(catalog_ptr);
+    RegisterNotLikeFunction(catalog_ptr);
+
+    SharedPtr<DataType> data_type = MakeShared<DataType>(LogicalType::kVarchar);
+    SharedPtr<DataType> result_type = MakeShared<DataType>(LogicalType::kBoolean);
+    SharedPtr<ColumnExpression> col1_expr_ptr = MakeShared<ColumnExpression>(*data_type, "t1", 1, "c1", 0, 0);
+    SharedPtr<ColumnExpression> col2_expr_ptr = MakeShared<ColumnExpression>(*data_type, "t1", 1, "c2", 1, 0);
+    Vector<SharedPtr<BaseExpression>> inputs{col1_expr_ptr, col2_expr_ptr};
+
+    // Strings longer than the inlined size are stored in the heap.
+    SizeT row_count = DEFAULT_VECTOR_SIZE;
+    auto left = MakeShared<ColumnVector>(data_type);
+    left->Initialize();
+    for (SizeT i = 0; i < row_count; ++i) {
+        left->AppendValue(Value::MakeVarchar(fmt::format("a_long_prefix_{}_suffix", i)));
+    }
+    auto pattern = MakeShared<ColumnVector>(data_type);
+    pattern->Initialize(ColumnVectorType::kConstant, 1);
+    pattern->AppendValue(Value::MakeVarchar("%_12%"));
+
+    for (const String func_name : {"like", "not_like"}) {
+        SharedPtr<ScalarFunctionSet> function_set =
+            std::static_pointer_cast<ScalarFunctionSet>(Catalog::GetFunctionSetByName(catalog_ptr.get(), func_name));
+        ScalarFunction func = function_set->GetMostMatchFunction(inputs);
+
+        DataBlock data_block;
+        data_block.Init({left, pattern});
+        SharedPtr<ColumnVector> result = MakeShared<ColumnVector>(result_type);
+        result->Initialize();
+        func.function_(data_block, result);
+
+        bool not_like = func_name == "not_like";
+        for (SizeT i = 0; i < row_count; ++i) {
+            Value v = result->GetValue(i);
+            EXPECT_EQ(v.type_.type(), LogicalType::kBoolean);
+            // '_' is any character, the '_' of the prefix or a digit, so every i containing "12" matches
+            bool expected = fmt::format("{}", i).find("12") != String::npos;
+            EXPECT_EQ(v.value_.boolean, expected != not_like);
+        }
+    }
+
+    // A pattern per row
+    auto patterns = MakeShared<ColumnVector>(data_type);
+    patterns->Initialize();
+    for (SizeT i = 0; i < row_count; ++i) {
+        if (i % 3 == 0) {
+            patterns->AppendValue(Value::MakeVarchar(fmt::format("%_{}_%", i)));
+        } else if (i % 3 == 1) {
+            patterns->AppendValue(Value::MakeVarchar(fmt::format("%_{}_suffix", i + 1)));
+        } else {
+            patterns->AppendValue(Value::MakeVarchar("%"));
+            patterns->nulls_ptr_->SetFalse(i);
+        }
+    }
+    SharedPtr<ScalarFunctionSet> function_set = std::static_pointer_cast<ScalarFunctionSet>(Catalog::GetFunctionSetByName(catalog_ptr.get(), "like"));
+    ScalarFunction func = function_set->GetMostMatchFunction(inputs);
+    DataBlock data_block;
+    data_block.Init({left, patterns});
+    SharedPtr<ColumnVector> result = MakeShared<ColumnVector>(result_type);
+    result->Initialize();
+    func.function_(data_block, result);
+    for (SizeT i = 0; i < row_count; ++i) {
+        Value v = result->GetValue(i);
+        if (i % 3 == 2) {
+            EXPECT_FALSE(result->nulls_ptr_->IsTrue(i));
+        } else {
+            EXPECT_EQ(v.value_.boolean, i % 3 == 0);
+        }
+    }
+}
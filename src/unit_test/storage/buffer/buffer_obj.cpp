@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "unit_test/base_test.h"
+#include <future>
 
 import infinity;
 import infinity_exception;
@@ -283,6 +284,62 @@ TEST_F(BufferObjTest, test1) {
     buf1->CheckState();
 }
 
+// Buffers loaded by the read ahead threads stay in memory while their handles are held.
+TEST_F(BufferObjTest, test_prefetch) {
+    // read ahead may pin a quarter of it, i.e. two of the buffers
+    SizeT memory_limit = 8192;
+    auto temp_dir = MakeShared<String>("/tmp/infinity/spill");
+    auto base_dir = MakeShared<String>("/tmp/infinity/data");
+
+    BufferManager buffer_manager(memory_limit, base_dir, temp_dir, 2);
+
+    Vector<BufferObj *> buffer_objs;
+    for (SizeT i = 0; i < 3; ++i) {
+        auto file_dir = MakeShared<String>(fmt::format("/tmp/infinity/data/dir{}", i));
+        auto file_name = MakeShared<String>(fmt::format("test{}", i));
+        buffer_objs.push_back(buffer_manager.Allocate(MakeUnique<DataFileWorker>(file_dir, file_name, 1024)));
+    }
+
+    {
+        Vector<std::future<BufferHandle>> prefetches;
+        ReadAheadReservation reservation;
+        EXPECT_TRUE(buffer_manager.Prefetch({buffer_objs[0], buffer_objs[1]}, prefetches, reservation));
+        Vector<BufferHandle> handles;
+        handles.reserve(prefetches.size());
+        for (auto &prefetch : prefetches) {
+            handles.push_back(prefetch.get());
+        }
+        for (SizeT i = 0; i < 2; ++i) {
+            EXPECT_EQ(buffer_objs[i]->status(), BufferStatus::kLoaded);
+            buffer_objs[i]->CheckState();
+        }
+
+        // Loading a prefetched buffer again only pins it once more.
+        auto handle = buffer_objs[0]->Load();
+        EXPECT_EQ(buffer_objs[0]->rc(), 2u);
+
+        // The read ahead budget is used up until the reservation is given back.
+        Vector<std::future<BufferHandle>> prefetches2;
+        ReadAheadReservation reservation2;
+        EXPECT_FALSE(buffer_manager.Prefetch({buffer_objs[2]}, prefetches2, reservation2));
+        EXPECT_TRUE(prefetches2.empty());
+        EXPECT_EQ(buffer_objs[2]->status(), BufferStatus::kNew);
+    }
+
+    for (SizeT i = 0; i < 2; ++i) {
+        EXPECT_EQ(buffer_objs[i]->status(), BufferStatus::kUnloaded);
+        buffer_objs[i]->CheckState();
+    }
+
+    {
+        Vector<std::future<BufferHandle>> prefetches;
+        ReadAheadReservation reservation;
+        EXPECT_TRUE(buffer_manager.Prefetch({buffer_objs[2]}, prefetches, reservation));
+        auto handle = prefetches[0].get();
+        EXPECT_EQ(buffer_objs[2]->status(), BufferStatus::kLoaded);
+    }
+}
+
 // unit test for BufferStatus::kClean transformation
 TEST_F(BufferObjTest, test_status_clean) {
     SizeT memory_limit = 1024;
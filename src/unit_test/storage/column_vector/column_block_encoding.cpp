@@ -0,0 +1,140 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "unit_test/base_test.h"
+
+import infinity_exception;
+
+import stl;
+import column_block_encoding;
+import column_vector;
+import selection;
+import value;
+import default_values;
+import logical_type;
+import internal_types;
+import data_type;
+
+using namespace infinity;
+
+class ColumnBlockEncodingTest : public BaseTest {
+protected:
+    // Encodes and decodes the elements, returns the dictionary read back.
+    static SharedPtr<ColumnBlockDictionary> RoundTrip(const Vector<i64> &elements, ColumnBlockEncoding expected_encoding) {
+        const char *data = reinterpret_cast<const char *>(elements.data());
+        SharedPtr<ColumnBlockDictionary> dictionary = AnalyzeColumnBlock(data, sizeof(i64), elements.size());
+        EXPECT_NE(dictionary, nullptr);
+        EXPECT_EQ(dictionary->encoding_, expected_encoding);
+
+        SizeT encoded_size = EncodedColumnBlockSize(*dictionary, sizeof(i64), elements.size());
+        EXPECT_LT(encoded_size, elements.size() * sizeof(i64));
+        auto buffer = MakeUnique<char[]>(encoded_size);
+        char *write_ptr = buffer.get();
+        EncodeColumnBlock(*dictionary, data, sizeof(i64), elements.size(), write_ptr);
+        EXPECT_EQ(SizeT(write_ptr - buffer.get()), encoded_size);
+
+        Vector<i64> decoded(elements.size());
+        const char *read_ptr = buffer.get();
+        SharedPtr<ColumnBlockDictionary> read_dictionary =
+            DecodeColumnBlock(read_ptr, reinterpret_cast<char *>(decoded.data()), sizeof(i64), elements.size());
+        EXPECT_EQ(read_ptr, buffer.get() + encoded_size);
+        EXPECT_EQ(decoded, elements);
+        EXPECT_EQ(read_dictionary->encoding_, dictionary->encoding_);
+        EXPECT_EQ(read_dictionary->codes_, dictionary->codes_);
+        EXPECT_EQ(read_dictionary->value_rows_, dictionary->value_rows_);
+        return read_dictionary;
+    }
+
+    static SharedPtr<ColumnVector> MakeColumn(const Vector<i64> &elements) {
+        auto column = MakeShared<ColumnVector>(MakeShared<DataType>(LogicalType::kBigInt));
+        column->Initialize();
+        for (i64 element : elements) {
+            column->AppendValue(Value::MakeBigInt(element));
+        }
+        return column;
+    }
+};
+
+TEST_F(ColumnBlockEncodingTest, Dictionary) {
+    Vector<i64> elements;
+    for (SizeT i = 0; i < DEFAULT_BLOCK_CAPACITY; ++i) {
+        elements.push_back((i * 7) % 10 * 1000);
+    }
+    SharedPtr<ColumnBlockDictionary> dictionary = RoundTrip(elements, ColumnBlockEncoding::kDictionary);
+    EXPECT_EQ(dictionary->EntryCount(), 10u);
+}
+
+TEST_F(ColumnBlockEncodingTest, RunLength) {
+    Vector<i64> elements;
+    for (SizeT i = 0; i < DEFAULT_BLOCK_CAPACITY; ++i) {
+        elements.push_back(i / 1000);
+    }
+    SharedPtr<ColumnBlockDictionary> dictionary = RoundTrip(elements, ColumnBlockEncoding::kRLE);
+    EXPECT_EQ(dictionary->EntryCount(), DEFAULT_BLOCK_CAPACITY / 1000 + 1);
+    EXPECT_EQ(dictionary->codes_.back(), DEFAULT_BLOCK_CAPACITY);
+}
+
+TEST_F(ColumnBlockEncodingTest, HighCardinality) {
+    Vector<i64> elements;
+    for (SizeT i = 0; i < DEFAULT_BLOCK_CAPACITY; ++i) {
+        elements.push_back(i * 31 % 8191);
+    }
+    EXPECT_EQ(AnalyzeColumnBlock(reinterpret_cast<const char *>(elements.data()), sizeof(i64), elements.size()), nullptr);
+}
+
+TEST_F(ColumnBlockEncodingTest, EncodedColumnVector) {
+    for (i64 run_length : {1, 300}) {
+        Vector<i64> elements;
+        for (SizeT i = 0; i < DEFAULT_BLOCK_CAPACITY; ++i) {
+            elements.push_back(i / run_length % 5);
+        }
+        SharedPtr<ColumnVector> block_column = MakeColumn(elements);
+        SharedPtr<ColumnBlockDictionary> dictionary =
+            AnalyzeColumnBlock(reinterpret_cast<const char *>(elements.data()), sizeof(i64), elements.size());
+        ASSERT_NE(dictionary, nullptr);
+        EXPECT_EQ(dictionary->encoding_, run_length == 1 ? ColumnBlockEncoding::kDictionary : ColumnBlockEncoding::kRLE);
+
+        SizeT start_row = 1000;
+        SizeT row_count = 2000;
+        ColumnVector encoded(block_column->data_type());
+        encoded.InitializeEncoded(*block_column, *dictionary, start_row, row_count);
+        EXPECT_TRUE(encoded.IsEncoded());
+        EXPECT_EQ(encoded.Size(), row_count);
+        EXPECT_LE(encoded.dictionary()->Size(), run_length == 1 ? 5u : row_count / run_length + 2);
+        for (SizeT row = 0; row < row_count; row += 17) {
+            EXPECT_EQ(encoded.GetValue(row), Value::MakeBigInt(elements[start_row + row]));
+        }
+
+        SharedPtr<ColumnVector> decoded = encoded.Decode();
+        EXPECT_EQ(decoded->vector_type(), ColumnVectorType::kFlat);
+        ASSERT_EQ(decoded->Size(), row_count);
+        for (SizeT row = 0; row < row_count; ++row) {
+            EXPECT_EQ(decoded->GetValue(row), Value::MakeBigInt(elements[start_row + row]));
+        }
+
+        // Gathered rows are decoded.
+        Selection select;
+        select.Initialize(row_count / 3 + 1);
+        for (SizeT row = 0; row < row_count; row += 3) {
+            select.Append(row);
+        }
+        ColumnVector gathered(block_column->data_type());
+        gathered.Initialize(encoded, select);
+        EXPECT_EQ(gathered.vector_type(), ColumnVectorType::kFlat);
+        ASSERT_EQ(gathered.Size(), select.Size());
+        for (SizeT idx = 0; idx < select.Size(); ++idx) {
+            EXPECT_EQ(gathered.GetValue(idx), Value::MakeBigInt(elements[start_row + select[idx]]));
+        }
+    }
+}
@@ -0,0 +1,53 @@
+#include "unit_test/base_test.h"
+
+import stl;
+import chunk_index_merge_policy;
+import rate_limiter;
+
+using namespace infinity;
+
+class ChunkIndexMergePolicyTest : public BaseTest {};
+
+TEST_F(ChunkIndexMergePolicyTest, test1) {
+    using namespace infinity;
+    // tiers: [0, 100) [100, 400) [400, 1600) ...
+    TieredChunkMergePolicy policy(4, 8, 100);
+    ASSERT_EQ(policy.Tier(0), 0u);
+    ASSERT_EQ(policy.Tier(99), 0u);
+    ASSERT_EQ(policy.Tier(100), 1u);
+    ASSERT_EQ(policy.Tier(399), 1u);
+    ASSERT_EQ(policy.Tier(400), 2u);
+
+    using Range = Pair<SizeT, SizeT>;
+    ASSERT_EQ(policy.Pick({}), Range(0, 0));
+    ASSERT_EQ(policy.Pick({10}), Range(0, 0));
+    // not enough chunks of the same tier
+    ASSERT_EQ(policy.Pick({50, 50, 50}), Range(0, 0));
+    ASSERT_EQ(policy.Pick({500, 50, 50, 150, 50}), Range(0, 0));
+    // merge_factor adjacent chunks of the same tier
+    ASSERT_EQ(policy.Pick({500, 50, 50, 50, 50, 10}), Range(1, 5));
+    // the lowest tier goes first
+    ASSERT_EQ(policy.Pick({500, 150, 150, 150, 150, 50, 50, 50, 50}), Range(5, 9));
+}
+
+TEST_F(ChunkIndexMergePolicyTest, test2) {
+    using namespace infinity;
+    // more than max_chunks chunks of mixed tiers: merge the smallest adjacent window
+    TieredChunkMergePolicy policy(4, 8, 100);
+    using Range = Pair<SizeT, SizeT>;
+    ASSERT_EQ(policy.Pick({500, 50, 150, 50, 500, 150, 50, 150, 500, 50}), Range(1, 4));
+    ASSERT_EQ(policy.Pick({500, 150, 500, 150, 500, 150, 500, 50, 40}), Range(7, 9));
+}
+
+TEST_F(ChunkIndexMergePolicyTest, test3) {
+    using namespace infinity;
+    RateLimiter unlimited(0);
+    unlimited.Request(1 << 30);
+    ASSERT_EQ(unlimited.total_wait().count(), 0);
+
+    // 1MB at 10MB/s takes about 100ms
+    RateLimiter limiter(10 << 20);
+    limiter.Request(1 << 20);
+    ASSERT_GT(limiter.total_wait(), std::chrono::milliseconds(50));
+    ASSERT_LE(limiter.total_wait(), std::chrono::milliseconds(100));
+}
@@ -59,7 +59,7 @@ public:
 
 protected:
     template <class KeyType, class LenType>
-    void CheckMerger(const u64 SIZE, u32 bs = 100000000) {
+    void CheckMerger(const u64 SIZE, u32 bs = 100000000, bool consume = false) {
         std::filesystem::remove("./tt");
 
         Vector<char> str;
@@ -92,6 +92,18 @@ protected:
         fclose(f);
 
         SortMerger<KeyType, LenType> merger("./tt", run_num, bs, 2);
+        if (consume) {
+            u64 count = 0;
+            merger.Run([&](char *data, u32 size) {
+                for (u32 pos = 0; pos < size; pos += *(LenType *)(data + pos) + sizeof(LenType)) {
+                    EXPECT_EQ(*(KeyType *)(data + pos + sizeof(LenType)), count);
+                    ++count;
+                }
+            });
+            EXPECT_EQ(count, SIZE);
+            std::filesystem::remove("./tt");
+            return;
+        }
         merger.Run();
 
         f = fopen("./tt", "r");
@@ -181,3 +193,8 @@ TEST_F(ExternalSortTest, test1) {
 }
 
 TEST_F(ExternalSortTest, test2) { CheckTermTuple(100, 1000000); }
+
+TEST_F(ExternalSortTest, test3) {
+    CheckMerger<u32, u8>(1000, 100000, true);
+    CheckMerger<u32, u8>(10000, 1000000, true);
+}
@@ -0,0 +1,114 @@
+#include "unit_test/base_test.h"
+
+import stl;
+import memory_pool;
+import byte_slice_reader;
+import byte_slice_writer;
+import posting_field;
+import doc_list_format_option;
+import posting_byte_slice;
+import posting_byte_slice_reader;
+import index_defines;
+
+using namespace infinity;
+
+class SIMDBlockEncoderTest : public BaseTest {
+public:
+    void SetUp() override {}
+    void TearDown() override {}
+
+protected:
+    void CheckRoundTrip(const Vector<u32> &values) {
+        const SIMDBlockEncoder *encoder = GetSIMDBlockEncoder();
+        ByteSliceWriter writer;
+        SizeT offset = 0;
+        u32 total_len = 0;
+        while (offset < values.size()) {
+            u32 len = std::min<SizeT>(MAX_DOC_PER_RECORD, values.size() - offset);
+            total_len += encoder->Encode(writer, values.data() + offset, len);
+            offset += len;
+        }
+        ASSERT_EQ(total_len, writer.GetSize());
+
+        ByteSliceReader reader(writer.GetByteSliceList());
+        u32 buffer[MAX_DOC_PER_RECORD];
+        offset = 0;
+        while (offset < values.size()) {
+            u32 len = encoder->Decode(buffer, MAX_DOC_PER_RECORD, reader);
+            ASSERT_EQ(len, std::min<SizeT>(MAX_DOC_PER_RECORD, values.size() - offset));
+            for (u32 i = 0; i < len; ++i) {
+                ASSERT_EQ(values[offset + i], buffer[i]);
+            }
+            offset += len;
+        }
+    }
+};
+
+TEST_F(SIMDBlockEncoderTest, test1) {
+    using namespace infinity;
+    // full blocks with various bit widths plus a vbyte tail
+    Vector<u32> values;
+    for (u32 i = 0; i < MAX_DOC_PER_RECORD * 3 + 17; ++i) {
+        values.push_back(i % 7 + 1);
+    }
+    for (u32 i = 0; i < MAX_DOC_PER_RECORD; ++i) {
+        values[MAX_DOC_PER_RECORD + i] = i * 100000 + 1;
+    }
+    values[MAX_DOC_PER_RECORD * 2] = std::numeric_limits<u32>::max();
+    CheckRoundTrip(values);
+}
+
+TEST_F(SIMDBlockEncoderTest, test2) {
+    using namespace infinity;
+    // zero bit width block
+    Vector<u32> values(MAX_DOC_PER_RECORD, 0);
+    CheckRoundTrip(values);
+    // short list only
+    Vector<u32> short_values{3, 1, 4, 1, 5};
+    CheckRoundTrip(short_values);
+}
+
+TEST_F(SIMDBlockEncoderTest, test3) {
+    using namespace infinity;
+    // doc list format selects SIMD block fields from the option flag
+    MemoryPool byte_slice_pool(1024);
+    RecyclePool buffer_pool(1024);
+    DocListFormatOption option(NO_BLOCK_MAX | of_simd_block);
+    ASSERT_TRUE(option.IsSIMDBlock());
+    ASSERT_FALSE(option == DocListFormatOption(NO_BLOCK_MAX));
+    DocListFormat doc_list_format(option);
+
+    PostingByteSlice posting_byte_slice(&byte_slice_pool, &buffer_pool);
+    posting_byte_slice.Init(&doc_list_format);
+    const u32 count = MAX_DOC_PER_RECORD + 10;
+    for (u32 i = 0; i < count; ++i) {
+        posting_byte_slice.PushBack(0, i + 1);
+        posting_byte_slice.PushBack(1, i % 3 + 1);
+        posting_byte_slice.PushBack(2, (u16)i);
+        posting_byte_slice.EndPushBack();
+        if (posting_byte_slice.NeedFlush()) {
+            posting_byte_slice.Flush();
+        }
+    }
+    posting_byte_slice.Flush();
+
+    PostingByteSliceReader reader;
+    reader.Open(&posting_byte_slice);
+    u32 doc_buffer[MAX_DOC_PER_RECORD];
+    u32 tf_buffer[MAX_DOC_PER_RECORD];
+    u16 payload_buffer[MAX_DOC_PER_RECORD];
+    u32 decoded = 0;
+    while (decoded < count) {
+        SizeT decode_len = 0;
+        ASSERT_TRUE(reader.Decode(doc_buffer, MAX_DOC_PER_RECORD, decode_len));
+        ASSERT_TRUE(reader.Decode(tf_buffer, MAX_DOC_PER_RECORD, decode_len));
+        ASSERT_TRUE(reader.Decode(payload_buffer, MAX_DOC_PER_RECORD, decode_len));
+        for (SizeT i = 0; i < decode_len; ++i) {
+            ASSERT_EQ(decoded + i + 1, doc_buffer[i]);
+            ASSERT_EQ((decoded + i) % 3 + 1, tf_buffer[i]);
+            ASSERT_EQ((u16)(decoded + i), payload_buffer[i]);
+        }
+        decoded += decode_len;
+    }
+    ASSERT_EQ(count, decoded);
+}
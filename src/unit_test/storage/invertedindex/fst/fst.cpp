@@ -120,3 +120,91 @@ TEST_F(FstTest, Iterate) {
     }
     EXPECT_EQ(i, b2_num);
 }
+
+TEST_F(FstTest, IteratePrefix) {
+    Vector<u8> buffer;
+    BufferWriter wtr(buffer);
+    FstBuilder builder(wtr);
+    for (auto &month : months) {
+        builder.Insert((u8 *)month.first.c_str(), month.first.length(), month.second);
+    }
+    builder.Finish();
+
+    Fst f(buffer.data(), buffer.size());
+    String prefix = "Ju";
+    FstStream s(f, (u8 *)prefix.data(), prefix.length());
+    // the prefix buffer shall be left untouched
+    EXPECT_EQ(prefix, "Ju");
+    Vector<u8> key;
+    u64 val;
+    Vector<String> names;
+    while (s.Next(key, val)) {
+        names.emplace_back((char *)key.data(), key.size());
+    }
+    EXPECT_EQ(names, Vector<String>({"July", "June"}));
+}
+
+TEST_F(FstTest, Automaton) {
+    Vector<u8> buffer;
+    BufferWriter wtr(buffer);
+    FstBuilder builder(wtr);
+    for (auto &month : months) {
+        builder.Insert((u8 *)month.first.c_str(), month.first.length(), month.second);
+    }
+    builder.Finish();
+
+    Fst f(buffer.data(), buffer.size());
+    auto search = [&](Automaton &aut) {
+        FstAutomatonStream s(f, aut);
+        Vector<u8> key;
+        u64 val;
+        Vector<String> names;
+        while (s.Next(key, val)) {
+            String name((char *)key.data(), key.size());
+            auto it = std::find_if(months.begin(), months.end(), [&](const Pair<String, u64> &month) { return month.first == name; });
+            EXPECT_TRUE(it != months.end());
+            EXPECT_EQ(val, it->second);
+            names.push_back(std::move(name));
+        }
+        return names;
+    };
+
+    PrefixAutomaton prefix("Ma");
+    EXPECT_EQ(search(prefix), Vector<String>({"March", "May"}));
+
+    LevenshteinAutomaton levenshtein("Jume", 1);
+    EXPECT_EQ(search(levenshtein), Vector<String>({"June"}));
+    LevenshteinAutomaton levenshtein2("Jume", 2);
+    EXPECT_EQ(search(levenshtein2), Vector<String>({"July", "June"}));
+
+    auto wildcard = RegexAutomaton::FromWildcard("*ber");
+    EXPECT_EQ(search(*wildcard), Vector<String>({"December", "November", "October", "September"}));
+    auto wildcard2 = RegexAutomaton::FromWildcard("?u*");
+    EXPECT_EQ(search(*wildcard2), Vector<String>({"August", "July", "June"}));
+
+    auto regex = RegexAutomaton::FromRegex("(Jan|Feb)[a-z]+y");
+    EXPECT_EQ(search(*regex), Vector<String>({"February", "January"}));
+    auto regex2 = RegexAutomaton::FromRegex("[^A-L]\\w{2,3}");
+    EXPECT_EQ(search(*regex2), Vector<String>({"May"}));
+
+    EXPECT_THROW(RegexAutomaton::FromRegex("(Jan"), FstError);
+    EXPECT_THROW(RegexAutomaton::FromRegex("*Jan"), FstError);
+    EXPECT_THROW(RegexAutomaton::FromRegex("[z-a]"), FstError);
+}
+
+TEST_F(FstTest, AutomatonUtf8) {
+    // edits count code points rather than bytes
+    LevenshteinAutomaton levenshtein("café", 1);
+    for (String term : {"café", "cafe", "cafés", "caf", "cafè"}) {
+        EXPECT_TRUE(levenshtein.Eval((const u8 *)term.data(), term.size())) << term;
+    }
+    for (String term : {"cofè", "ca"}) {
+        EXPECT_FALSE(levenshtein.Eval((const u8 *)term.data(), term.size())) << term;
+    }
+    auto wildcard = RegexAutomaton::FromWildcard("caf?");
+    for (String term : {"café", "cafe"}) {
+        EXPECT_TRUE(wildcard->Eval((const u8 *)term.data(), term.size())) << term;
+    }
+    String term = "cafés";
+    EXPECT_FALSE(wildcard->Eval((const u8 *)term.data(), term.size()));
+}
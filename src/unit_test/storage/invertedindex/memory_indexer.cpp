@@ -165,6 +165,30 @@ TEST_F(MemoryIndexerTest, test2) {
     Check(reader);
 }
 
+TEST_F(MemoryIndexerTest, OfflineMemoryBudget) {
+    auto fake_segment_index_entry_1 = SegmentIndexEntry::CreateFakeEntry();
+    String column_length_file_path = String("/tmp/infinity/fulltext_tbl1_col1/chunk1") + LENGTH_SUFFIX;
+    auto column_length_file_handler =
+        MakeShared<FullTextColumnLengthFileHandler>(MakeUnique<LocalFileSystem>(), column_length_file_path, fake_segment_index_entry_1.get());
+    // A budget smaller than any inverter makes every Insert wait for the previous block to be spilled as its own run.
+    MemoryIndexer
+        indexer1("/tmp/infinity/fulltext_tbl1_col1", "chunk1", RowID(0U, 0U), flag_, "standard", byte_slice_pool_, buffer_pool_, thread_pool_, 1);
+    ASSERT_EQ(indexer1.GetMemoryBudget(), 1U);
+    indexer1.Insert(column_, 0, 2, column_length_file_handler, true);
+    indexer1.Commit(true);
+    indexer1.Insert(column_, 2, 2, column_length_file_handler, true);
+    indexer1.Commit(true);
+    indexer1.Insert(column_, 4, 1, std::move(column_length_file_handler), true);
+    indexer1.Dump(true);
+    fake_segment_index_entry_1->AddChunkIndexEntry("chunk1", RowID(0U, 0U).ToUint64(), 5U);
+
+    Map<SegmentID, SharedPtr<SegmentIndexEntry>> index_by_segment = {{1, fake_segment_index_entry_1}};
+
+    ColumnIndexReader reader;
+    reader.Open(flag_, "/tmp/infinity/fulltext_tbl1_col1", std::move(index_by_segment));
+    Check(reader);
+}
+
 TEST_F(MemoryIndexerTest, SpillLoadTest) {
     String column_length_file_path = String("/tmp/infinity/fulltext_tbl1_col1/chunk1") + LENGTH_SUFFIX;
     auto fake_segment_index_entry_1 = SegmentIndexEntry::CreateFakeEntry();
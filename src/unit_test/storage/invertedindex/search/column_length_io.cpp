@@ -0,0 +1,111 @@
+//  Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include "unit_test/base_test.h"
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+
+import stl;
+import index_defines;
+import internal_types;
+import column_length_io;
+import bm25_ranker;
+import local_file_system;
+
+using namespace infinity;
+
+class ColumnLengthIOTest : public BaseTest {
+protected:
+    String index_dir_ = "/tmp/infinity/column_length_io_test";
+
+    void SetUp() override {
+        std::filesystem::remove_all(index_dir_);
+        std::filesystem::create_directories(index_dir_);
+    }
+
+    void TearDown() override { std::filesystem::remove_all(index_dir_); }
+
+    void WriteLengthFile(const String &base_name, const Vector<u32> &column_lengths) {
+        std::ofstream ofs(index_dir_ + "/" + base_name + LENGTH_SUFFIX, std::ios::binary | std::ios::trunc);
+        ofs.write((const char *)column_lengths.data(), column_lengths.size() * sizeof(u32));
+    }
+};
+
+TEST_F(ColumnLengthIOTest, EncodeColumnLength) {
+    for (u32 len = 0; len < 24; ++len) {
+        EXPECT_EQ(DecodeColumnLength(EncodeColumnLength(len)), len);
+    }
+    // monotonic, rounded down by less than 1/8
+    u8 prev_norm = 0;
+    for (u32 len = 1; len < 1000000; len += len / 16 + 1) {
+        u8 norm = EncodeColumnLength(len);
+        EXPECT_GE(norm, prev_norm);
+        u32 decoded = DecodeColumnLength(norm);
+        EXPECT_LE(decoded, len);
+        EXPECT_GT(decoded, len - len / 8 - 1);
+        prev_norm = norm;
+    }
+    EXPECT_EQ(EncodeColumnLength(std::numeric_limits<u32>::max()), 255);
+}
+
+TEST_F(ColumnLengthIOTest, ColumnNorms) {
+    Vector<u32> lengths1{3, 10, 100, 1000};
+    Vector<u32> lengths2{7, 8};
+    WriteLengthFile("chunk1", lengths1);
+    WriteLengthFile("chunk2", lengths2);
+    Vector<String> base_names{"chunk1", "chunk2"};
+    Vector<RowID> base_row_ids{RowID(0, 0), RowID(1, 0), INVALID_ROWID};
+    // chunk2 is in memory, its norms are not persisted
+    Vector<bool> chunk_in_memory{false, true};
+    LocalFileSystem fs;
+    String norm_path = index_dir_ + "/chunk1" + NORM_SUFFIX;
+    // round 0: no norm file, round 1: the norm file written on dump, round 2: a stale norm file
+    for (int round = 0; round < 3; ++round) {
+        if (round == 1) {
+            WriteColumnNormFile(fs, norm_path, lengths1);
+            EXPECT_EQ(std::filesystem::file_size(norm_path), lengths1.size());
+        } else if (round == 2) {
+            WriteColumnNormFile(fs, norm_path, lengths2);
+        }
+        FullTextColumnNorms norms(index_dir_, base_names, base_row_ids, chunk_in_memory, 20.0F);
+        SizeT cursor = 0;
+        for (u32 i = 0; i < lengths1.size(); ++i) {
+            EXPECT_EQ(norms.GetNorm(RowID(0, i), cursor), EncodeColumnLength(lengths1[i]));
+        }
+        for (u32 i = 0; i < lengths2.size(); ++i) {
+            EXPECT_EQ(norms.GetNorm(RowID(1, i), cursor), EncodeColumnLength(lengths2[i]));
+        }
+        // a doc whose length is not written yet gets the average length
+        EXPECT_EQ(norms.GetNorm(RowID(1, 5), cursor), EncodeColumnLength(20));
+        // seeking backwards
+        EXPECT_EQ(norms.GetNorm(RowID(0, 1), cursor), EncodeColumnLength(10));
+        // loading never writes norm files
+        EXPECT_EQ(std::filesystem::exists(norm_path), round != 0);
+        EXPECT_FALSE(std::filesystem::exists(index_dir_ + "/chunk2" + NORM_SUFFIX));
+    }
+}
+
+TEST_F(ColumnLengthIOTest, BM25) {
+    // the factored form matches the textbook formula
+    const float k1 = 1.2F, b = 0.75F;
+    u64 total_df = 1000, df = 10;
+    float tf = 3, avg_len = 50, weight = 2;
+    u32 len = 80;
+    float idf = std::log(1.0F + (total_df - df + 0.5F) / (df + 0.5F));
+    float expected = idf * weight * (k1 + 1.0F) * tf / (tf + k1 * (1.0F - b + b * len / avg_len));
+    float score = BM25Ranker::Score(BM25Ranker::TermWeight(total_df, df, weight), tf, BM25Ranker::NormFactor(len, avg_len));
+    EXPECT_NEAR(score, expected, 1e-5);
+    EXPECT_EQ(BM25Ranker::Score(BM25Ranker::TermWeight(total_df, df, weight), 0, BM25Ranker::NormFactor(len, avg_len)), 0.0F);
+}
@@ -104,6 +104,12 @@ name:star OR name:duna
 _exists_:"author" AND page_count:yyy AND (name:star OR name:duna)
 _exists_:"author" AND page_count:zzz^1.3 AND (name:star^0.1 OR name:duna^1.2)^1.2
 
+#term pattern
+name:wildcard::"dun*"
+wildcard::"*une" AND name:wildcard::"*un*"
+name:wildcard::"d?ne" OR name:fuzzy::"dune~1" OR name:regex::"du(n|k)e"
+foo AND NOT name:wildcard::"god*"^1.2
+
 #test invalid not query
 NOT (name:god^2 || kddd:ss^4) OR ee:ff^1.2
 (NOT name:god^2 OR NOT kddd:ss^4) OR ee:ff^1.2
@@ -127,3 +133,61 @@ sda:rtw AND ((NOT name:god^2 OR NOT kddd:ss^4) OR NOT ee:ff^1.2)
     int rc = ParseAndOptimizeFromStream(driver, iss);
     EXPECT_EQ(rc, 0);
 }
+
+TEST_F(QueryParserAndOptimizerTest, term_pattern) {
+    using namespace infinity;
+
+    Map<String, String> column2analyzer{{"name", "standard"}};
+    String default_field("body");
+    SearchDriver driver(column2analyzer, default_field);
+    // folds the patterns of the analyzed column like the standard analyzer
+    driver.normalize_func_ = reinterpret_cast<void (*)()>(+[](const String &, String &text) {
+        for (char &c : text) {
+            if (c >= 'A' && c <= 'Z') {
+                c += 'a' - 'A';
+            }
+        }
+    });
+    auto parse_pattern = [&](const String &query, QueryNodeType expected_type) -> String {
+        std::unique_ptr<QueryNode> result = driver.ParseSingle(query);
+        EXPECT_NE(result, nullptr);
+        if (!result) {
+            return {};
+        }
+        EXPECT_EQ(result->GetType(), expected_type);
+        return static_cast<const PatternTermQueryNode *>(result.get())->pattern_;
+    };
+
+    EXPECT_EQ(parse_pattern(R"(wildcard::"dun*")", QueryNodeType::PREFIX_TERM), "dun");
+    EXPECT_EQ(parse_pattern(R"(wildcard::"*une")", QueryNodeType::SUFFIX_TERM), "une");
+    EXPECT_EQ(parse_pattern(R"(wildcard::"*un*")", QueryNodeType::SUBSTRING_TERM), "un");
+    EXPECT_EQ(parse_pattern(R"(wildcard::"d?n\*")", QueryNodeType::WILDCARD_TERM), "d?n\\*");
+    EXPECT_EQ(parse_pattern(R"(regex::"du(n|k)e")", QueryNodeType::REGEX_TERM), "du(n|k)e");
+
+    // patterns of an analyzed column are folded, but not the escaped characters
+    EXPECT_EQ(parse_pattern(R"(name:wildcard::"DUN*")", QueryNodeType::PREFIX_TERM), "dun");
+    EXPECT_EQ(parse_pattern(R"(name:regex::"D\S+E")", QueryNodeType::REGEX_TERM), "d\\S+e");
+    EXPECT_EQ(parse_pattern(R"(name:fuzzy::"DUNE~1")", QueryNodeType::FUZZY_TERM), "dune");
+    EXPECT_EQ(parse_pattern(R"(body:wildcard::"DUN*")", QueryNodeType::PREFIX_TERM), "DUN");
+
+    {
+        std::unique_ptr<QueryNode> result = driver.ParseSingle(R"(fuzzy::"dune")");
+        ASSERT_NE(result, nullptr);
+        EXPECT_EQ(static_cast<const FuzzyTermQueryNode *>(result.get())->max_edits_, 2u);
+        result = driver.ParseSingle(R"(fuzzy::"dune~0")");
+        ASSERT_NE(result, nullptr);
+        EXPECT_EQ(static_cast<const FuzzyTermQueryNode *>(result.get())->max_edits_, 0u);
+    }
+
+    // quoted text without an operator is a term, whatever characters it contains
+    for (const String query : {R"("why?")", R"("foo~")", R"("dun*")", R"("/du(n|k)e/")"}) {
+        std::unique_ptr<QueryNode> result = driver.ParseSingle(query);
+        ASSERT_NE(result, nullptr);
+        EXPECT_EQ(result->GetType(), QueryNodeType::TERM);
+    }
+
+    EXPECT_THROW(driver.ParseSingle(R"(fuzzy::"dune~3")"), RecoverableException);
+    EXPECT_THROW(driver.ParseSingle(R"(fuzzy::"dune~a")"), RecoverableException);
+    EXPECT_THROW(driver.ParseSingle(R"(fuzzy::"~1")"), RecoverableException);
+    EXPECT_THROW(driver.ParseSingle(R"(prefix::"dun")"), RecoverableException);
+}
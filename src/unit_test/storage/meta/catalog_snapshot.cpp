@@ -0,0 +1,145 @@
+//  Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include "unit_test/base_test.h"
+#include <filesystem>
+#include <fstream>
+
+import stl;
+import third_party;
+import infinity_exception;
+import catalog_snapshot;
+
+using namespace infinity;
+
+class CatalogSnapshotTest : public BaseTest {
+protected:
+    String catalog_dir_ = "/tmp/infinity/catalog_snapshot_test";
+
+    void SetUp() override {
+        std::filesystem::remove_all(catalog_dir_);
+        std::filesystem::create_directories(catalog_dir_);
+    }
+
+    void TearDown() override { std::filesystem::remove_all(catalog_dir_); }
+};
+
+TEST_F(CatalogSnapshotTest, RoundTrip) {
+    String path = catalog_dir_ + "/FULL.100.snap";
+    String tmp_path = catalog_dir_ + "/_FULL.100.snap";
+    constexpr u32 table_count = 100;
+    {
+        CatalogSnapshotWriter writer(path, tmp_path);
+        nlohmann::json skeleton;
+        skeleton["data_dir"] = "/tmp/infinity/data";
+        for (u32 i = 0; i < table_count; ++i) {
+            u32 section_id = writer.BeginSection();
+            EXPECT_EQ(section_id, i);
+            writer.AddRecord(CatalogSnapshotRecordType::kTableEntry, nlohmann::json{{"table_name", fmt::format("t{}", i)}, {"row_count", i * 1000}});
+            // One segment record per table, followed by `i % 3` block records.
+            writer.AddRecord(CatalogSnapshotRecordType::kSegmentEntry, nlohmann::json{{"segment_id", i}});
+            for (u32 j = 0; j < i % 3; ++j) {
+                writer.AddRecord(CatalogSnapshotRecordType::kBlockEntry, nlohmann::json{{"block_id", j}});
+            }
+            writer.EndSection();
+            skeleton["table_entries"].emplace_back(nlohmann::json{{"snapshot_section", section_id}});
+        }
+        writer.Finish(skeleton);
+        EXPECT_EQ(writer.SectionCount(), table_count);
+    }
+    EXPECT_FALSE(std::filesystem::exists(tmp_path));
+    ASSERT_TRUE(CatalogSnapshotReader::IsSnapshotFile(path));
+
+    CatalogSnapshotReader reader(path);
+    EXPECT_EQ(reader.SectionCount(), table_count);
+    nlohmann::json skeleton = reader.Skeleton();
+    EXPECT_EQ(skeleton["data_dir"], "/tmp/infinity/data");
+    ASSERT_EQ(skeleton["table_entries"].size(), table_count);
+
+    // Tables are decoded from their own sections, in parallel.
+    Vector<Vector<Pair<CatalogSnapshotRecordType, nlohmann::json>>> tables(table_count);
+    for (u32 i = 0; i < table_count; ++i) {
+        u32 section_id = skeleton["table_entries"][i]["snapshot_section"];
+        reader.AddTableLoad([&reader, &tables, i, section_id] {
+            CatalogSnapshotSection section = reader.Section(section_id);
+            CatalogSnapshotRecordType record_type;
+            nlohmann::json record_json;
+            while (section.Next(record_type, record_json)) {
+                tables[i].emplace_back(record_type, std::move(record_json));
+            }
+        });
+    }
+    reader.LoadTables(4);
+    for (u32 i = 0; i < table_count; ++i) {
+        const auto &records = tables[i];
+        ASSERT_EQ(records.size(), 2 + i % 3);
+        EXPECT_EQ(records[0].first, CatalogSnapshotRecordType::kTableEntry);
+        EXPECT_EQ(records[0].second["table_name"], fmt::format("t{}", i));
+        EXPECT_EQ(records[0].second["row_count"], i * 1000);
+        EXPECT_EQ(records[1].first, CatalogSnapshotRecordType::kSegmentEntry);
+        EXPECT_EQ(records[1].second["segment_id"], i);
+        for (u32 j = 0; j < i % 3; ++j) {
+            EXPECT_EQ(records[2 + j].first, CatalogSnapshotRecordType::kBlockEntry);
+            EXPECT_EQ(records[2 + j].second["block_id"], j);
+        }
+    }
+}
+
+TEST_F(CatalogSnapshotTest, LegacyAndCorrupted) {
+    // Full catalog files of older versions are plain json.
+    String json_path = catalog_dir_ + "/FULL.1.json";
+    {
+        std::ofstream ofs(json_path);
+        ofs << R"({"data_dir": "/tmp/infinity/data", "next_txn_id": 1, "full_ckp_commit_ts": 1})";
+    }
+    EXPECT_FALSE(CatalogSnapshotReader::IsSnapshotFile(json_path));
+
+    String path = catalog_dir_ + "/FULL.2.snap";
+    {
+        CatalogSnapshotWriter writer(path, catalog_dir_ + "/_FULL.2.snap");
+        writer.BeginSection();
+        writer.AddRecord(CatalogSnapshotRecordType::kTableEntry, nlohmann::json{{"table_name", "t1"}});
+        writer.EndSection();
+        writer.Finish(nlohmann::json{{"data_dir", "/tmp/infinity/data"}});
+    }
+    // A snapshot cut before its trailer is rejected.
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 8);
+    EXPECT_TRUE(CatalogSnapshotReader::IsSnapshotFile(path));
+    EXPECT_THROW(CatalogSnapshotReader reader(path), RecoverableException);
+}
+
+TEST_F(CatalogSnapshotTest, CorruptedRecord) {
+    String path = catalog_dir_ + "/FULL.3.snap";
+    {
+        CatalogSnapshotWriter writer(path, catalog_dir_ + "/_FULL.3.snap");
+        writer.BeginSection();
+        writer.AddRecord(CatalogSnapshotRecordType::kTableEntry, nlohmann::json{{"table_name", "t1"}});
+        writer.EndSection();
+        writer.Finish(nlohmann::json{{"data_dir", "/tmp/infinity/data"}});
+    }
+    // Flip the last byte of the record, right after the header and the record header.
+    {
+        std::fstream fs(path, std::ios::in | std::ios::out | std::ios::binary);
+        SizeT record_end = 16 + 16 + nlohmann::json::to_msgpack(nlohmann::json{{"table_name", "t1"}}).size();
+        fs.seekg(record_end - 1);
+        char c = fs.get();
+        fs.seekp(record_end - 1);
+        fs.put(c ^ 0x1);
+    }
+    CatalogSnapshotReader reader(path);
+    CatalogSnapshotSection section = reader.Section(0);
+    CatalogSnapshotRecordType record_type;
+    nlohmann::json record_json;
+    EXPECT_THROW(section.Next(record_type, record_json), RecoverableException);
+}
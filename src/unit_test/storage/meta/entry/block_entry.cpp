@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include "unit_test/base_test.h"
+#include <algorithm>
+#include <fstream>
 #include <string>
 
 import infinity;
@@ -34,12 +36,101 @@ TEST_F(BlockVersionTest, SaveAndLoad) {
     BlockVersion block_version(8192);
     block_version.created_.emplace_back(10, 3);
     block_version.created_.emplace_back(20, 6);
-    block_version.deleted_[2] = 30;
-    block_version.deleted_[5] = 40;
+    block_version.Delete(2, 30);
+    block_version.Delete(5, 40);
     String version_path("/tmp/block_version_test");
     block_version.SaveToFile(version_path);
 
     BlockVersion block_verson2(8192);
     block_verson2.LoadFromFile(version_path);
     ASSERT_EQ(block_version, block_verson2);
+    EXPECT_EQ(block_verson2.DeleteTS(5), 40u);
+    EXPECT_EQ(block_verson2.DeleteTS(6), 0u);
+}
+
+TEST_F(BlockVersionTest, LoadLegacyFile) {
+    using namespace infinity;
+    // Older versions saved one delete ts per row.
+    Vector<TxnTimeStamp> deleted(8192, 0);
+    deleted[3] = 30;
+    deleted[100] = 40;
+    String version_path("/tmp/block_version_legacy_test");
+    {
+        std::ofstream ofs(version_path, std::ios::trunc | std::ios::binary);
+        i32 created_size = 1;
+        i32 deleted_size = deleted.size();
+        ofs.write(reinterpret_cast<const char *>(&created_size), sizeof(i32));
+        ofs.write(reinterpret_cast<const char *>(&deleted_size), sizeof(i32));
+        TxnTimeStamp create_ts = 10;
+        i32 row_count = 200;
+        ofs.write(reinterpret_cast<const char *>(&create_ts), sizeof(TxnTimeStamp));
+        ofs.write(reinterpret_cast<const char *>(&row_count), sizeof(i32));
+        ofs.write(reinterpret_cast<const char *>(deleted.data()), deleted.size() * sizeof(TxnTimeStamp));
+    }
+    BlockVersion block_version(8192);
+    block_version.LoadFromFile(version_path);
+    EXPECT_EQ(block_version.GetRowCount(10), 200);
+    EXPECT_EQ(block_version.DeleteCount(), 2u);
+    EXPECT_EQ(block_version.DeleteTS(3), 30u);
+    EXPECT_EQ(block_version.DeleteTS(100), 40u);
+    EXPECT_EQ(block_version.DeleteTS(4), 0u);
+}
+
+TEST_F(BlockVersionTest, Visibility) {
+    using namespace infinity;
+    constexpr SizeT capacity = 8192;
+    BlockVersion block_version(capacity);
+    EXPECT_FALSE(block_version.HasDelete(100));
+    EXPECT_EQ(block_version.VisibleRange(100, 0, capacity), (Pair<BlockOffset, BlockOffset>(0, capacity)));
+
+    // Rows deleted at ts 11 + offset % 7, enough of them to switch to the dense tier.
+    Vector<TxnTimeStamp> expected(capacity, 0);
+    for (SizeT offset = 1; offset < capacity; offset += 3) {
+        expected[offset] = 11 + offset % 7;
+        block_version.Delete(offset, expected[offset]);
+        if (offset == 1) {
+            EXPECT_EQ(block_version.VisibleRange(11, 0, capacity), (Pair<BlockOffset, BlockOffset>(0, capacity)));
+            EXPECT_EQ(block_version.VisibleRange(12, 0, capacity), (Pair<BlockOffset, BlockOffset>(0, 1)));
+            EXPECT_EQ(block_version.VisibleRange(12, 1, capacity), (Pair<BlockOffset, BlockOffset>(2, capacity)));
+        }
+    }
+    EXPECT_FALSE(block_version.HasDelete(10));
+    EXPECT_TRUE(block_version.HasDeleteBetween(12, 13));
+    EXPECT_FALSE(block_version.HasDeleteBetween(17, 100));
+
+    for (TxnTimeStamp check_ts : {10, 13, 17}) {
+        for (SizeT word_idx = 0; word_idx < capacity / BlockVersion::WORD_BITS; ++word_idx) {
+            u64 expected_word = 0;
+            for (SizeT bit = 0; bit < BlockVersion::WORD_BITS; ++bit) {
+                TxnTimeStamp delete_ts = expected[word_idx * BlockVersion::WORD_BITS + bit];
+                if (delete_ts != 0 && delete_ts <= check_ts) {
+                    expected_word |= u64(1) << bit;
+                }
+            }
+            ASSERT_EQ(block_version.DeletedWord(word_idx, check_ts), expected_word);
+        }
+        // The visible ranges cover exactly the rows not deleted at check_ts.
+        SizeT visible_count = 0;
+        BlockOffset read_offset = 0;
+        while (true) {
+            auto [range_begin, range_end] = block_version.VisibleRange(check_ts, read_offset, capacity);
+            if (range_begin == range_end) {
+                break;
+            }
+            for (BlockOffset offset = read_offset; offset < range_end; ++offset) {
+                bool visible = expected[offset] == 0 || expected[offset] > check_ts;
+                ASSERT_EQ(visible, offset >= range_begin);
+            }
+            visible_count += range_end - range_begin;
+            read_offset = range_end;
+        }
+        SizeT expected_count = std::count_if(expected.begin(), expected.end(), [&](TxnTimeStamp ts) { return ts == 0 || ts > check_ts; });
+        EXPECT_EQ(visible_count, expected_count);
+    }
+
+    BlockVersion checkpoint_version = block_version;
+    checkpoint_version.RemoveDeletesAfter(12);
+    for (SizeT offset = 0; offset < capacity; ++offset) {
+        ASSERT_EQ(checkpoint_version.DeleteTS(offset), expected[offset] <= 12 ? expected[offset] : 0);
+    }
 }
@@ -0,0 +1,120 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "unit_test/base_test.h"
+
+import stl;
+import third_party;
+import hyper_log_log;
+import segment_statistics;
+
+using namespace infinity;
+
+class SegmentStatisticsTest : public BaseTest {};
+
+TEST_F(SegmentStatisticsTest, hyper_log_log) {
+    HyperLogLog empty_sketch;
+    EXPECT_EQ(empty_sketch.Estimate(), 0);
+
+    // small cardinality is exact enough through linear counting
+    HyperLogLog small_sketch;
+    for (u64 i = 0; i < 100; ++i) {
+        small_sketch.Add(i % 10);
+    }
+    EXPECT_NEAR(small_sketch.Estimate(), 10, 1);
+
+    constexpr u64 NUM = 100000;
+    HyperLogLog sketch_a, sketch_b;
+    for (u64 i = 0; i < NUM; ++i) {
+        sketch_a.Add(i);
+        sketch_b.Add(i + NUM / 2);
+    }
+    EXPECT_NEAR(sketch_a.Estimate(), NUM, NUM * 0.1);
+    sketch_a.Merge(sketch_b);
+    EXPECT_NEAR(sketch_a.Estimate(), NUM * 1.5, NUM * 1.5 * 0.1);
+}
+
+TEST_F(SegmentStatisticsTest, equi_depth_histogram) {
+    // 0, 1, ..., 999
+    Vector<f64> keys;
+    for (u32 i = 0; i < 1000; ++i) {
+        keys.push_back(i);
+    }
+    EquiDepthHistogram histogram(keys, 10);
+    EXPECT_EQ(histogram.min(), 0);
+    EXPECT_EQ(histogram.max(), 999);
+    EXPECT_EQ(histogram.FractionLess(-1), 0);
+    EXPECT_EQ(histogram.FractionLess(1000), 1);
+    EXPECT_NEAR(histogram.FractionLess(500), 0.5, 0.01);
+    EXPECT_NEAR(histogram.FractionLess(250), 0.25, 0.01);
+    EXPECT_EQ(histogram.FractionEqual(500), 0);
+
+    // half of the keys are 7
+    Vector<f64> skewed_keys;
+    for (u32 i = 0; i < 1000; ++i) {
+        skewed_keys.push_back(i < 500 ? 7 : i);
+    }
+    EquiDepthHistogram skewed_histogram(skewed_keys, 10);
+    EXPECT_NEAR(skewed_histogram.FractionEqual(7), 0.5, 0.1);
+    EXPECT_EQ(skewed_histogram.FractionEqual(8), 0);
+}
+
+TEST_F(SegmentStatisticsTest, json_round_trip) {
+    SegmentStatistics statistics(3);
+    {
+        auto column_statistics = MakeUnique<ColumnStatistics>();
+        Vector<f64> keys;
+        for (u32 i = 0; i < 8192; ++i) {
+            column_statistics->distinct_sketch_.Add(i);
+            keys.push_back(i);
+        }
+        column_statistics->row_count_ = 8200;
+        column_statistics->null_count_ = 8;
+        column_statistics->histogram_ = EquiDepthHistogram(keys, STATISTICS_HISTOGRAM_BUCKET_COUNT);
+        statistics.SetColumnStatistics(0, std::move(column_statistics));
+    }
+    {
+        auto column_statistics = MakeUnique<ColumnStatistics>();
+        column_statistics->row_count_ = 8200;
+        column_statistics->distinct_sketch_.Add(1);
+        statistics.SetColumnStatistics(2, std::move(column_statistics));
+    }
+
+    nlohmann::json entry_json;
+    statistics.SaveToJsonFile(entry_json);
+    SegmentStatistics loaded_statistics;
+    EXPECT_TRUE(loaded_statistics.LoadFromJsonFile(entry_json));
+    EXPECT_EQ(loaded_statistics.ColumnCount(), 3u);
+    EXPECT_EQ(loaded_statistics.GetColumnStatistics(1), nullptr);
+    EXPECT_EQ(loaded_statistics.GetColumnStatistics(3), nullptr);
+
+    const ColumnStatistics *column_0 = loaded_statistics.GetColumnStatistics(0);
+    ASSERT_NE(column_0, nullptr);
+    EXPECT_EQ(column_0->row_count_, 8200u);
+    EXPECT_EQ(column_0->null_count_, 8u);
+    EXPECT_EQ(column_0->DistinctCount(), statistics.GetColumnStatistics(0)->DistinctCount());
+    EXPECT_NEAR(column_0->NullFraction(), 8.0 / 8200, 1e-9);
+    EXPECT_EQ(column_0->histogram_.min(), 0);
+    EXPECT_EQ(column_0->histogram_.max(), 8191);
+    EXPECT_NEAR(column_0->histogram_.FractionLess(4096), 0.5, 0.02);
+
+    const ColumnStatistics *column_2 = loaded_statistics.GetColumnStatistics(2);
+    ASSERT_NE(column_2, nullptr);
+    EXPECT_TRUE(column_2->histogram_.empty());
+    EXPECT_NEAR(column_2->DistinctCount(), 1, 0.01);
+
+    nlohmann::json empty_json;
+    SegmentStatistics empty_statistics;
+    EXPECT_FALSE(empty_statistics.LoadFromJsonFile(empty_json));
+}
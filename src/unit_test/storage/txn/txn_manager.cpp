@@ -0,0 +1,99 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "unit_test/base_test.h"
+
+import infinity_context;
+import infinity_exception;
+
+import stl;
+import global_resource_usage;
+import third_party;
+import logger;
+import txn_manager;
+import txn;
+
+class TxnManagerTest : public BaseTest {
+    void SetUp() override {
+        system("rm -rf /tmp/infinity");
+#ifdef INFINITY_DEBUG
+        infinity::GlobalResourceUsage::Init();
+#endif
+        std::shared_ptr<std::string> config_path = nullptr;
+        infinity::InfinityContext::instance().Init(config_path);
+    }
+
+    void TearDown() override {
+        infinity::InfinityContext::instance().UnInit();
+#ifdef INFINITY_DEBUG
+        EXPECT_EQ(infinity::GlobalResourceUsage::GetObjectCount(), 0);
+        EXPECT_EQ(infinity::GlobalResourceUsage::GetRawMemoryCount(), 0);
+        infinity::GlobalResourceUsage::UnInit();
+#endif
+        BaseTest::TearDown();
+    }
+};
+
+TEST_F(TxnManagerTest, min_unflushed_ts) {
+    using namespace infinity;
+    TxnManager *txn_mgr = infinity::InfinityContext::instance().storage()->txn_manager();
+
+    Txn *txn1 = txn_mgr->BeginTxn();
+    Txn *txn2 = txn_mgr->BeginTxn();
+    TxnTimeStamp begin_ts1 = txn1->BeginTS();
+    TxnTimeStamp begin_ts2 = txn2->BeginTS();
+    EXPECT_LT(begin_ts1, begin_ts2);
+    EXPECT_EQ(txn_mgr->GetMinUnflushedTS(), begin_ts1);
+    EXPECT_EQ(txn_mgr->GetTxn(txn2->TxnID()), txn2);
+
+    // Read only txns never wait for flush
+    txn_mgr->CommitTxn(txn1);
+    EXPECT_EQ(txn_mgr->GetMinUnflushedTS(), begin_ts2);
+
+    TxnTimeStamp commit_ts2 = txn_mgr->CommitTxn(txn2);
+    EXPECT_EQ(txn_mgr->GetMinUnflushedTS(), commit_ts2);
+}
+
+TEST_F(TxnManagerTest, concurrent_begin_commit) {
+    using namespace infinity;
+    TxnManager *txn_mgr = infinity::InfinityContext::instance().storage()->txn_manager();
+
+    constexpr SizeT thread_num = 8;
+    constexpr SizeT txn_count = 2000;
+    Atomic<SizeT> violation_count{0};
+    Vector<Thread> threads;
+    for (SizeT i = 0; i < thread_num; ++i) {
+        threads.emplace_back([&] {
+            TxnTimeStamp last_min_ts = 0;
+            for (SizeT j = 0; j < txn_count; ++j) {
+                Txn *txn = txn_mgr->BeginTxn();
+                TxnTimeStamp min_ts = txn_mgr->GetMinUnflushedTS();
+                // An active txn is never considered flushed, and the min ts never goes back.
+                if (min_ts > txn->BeginTS() || min_ts < last_min_ts) {
+                    ++violation_count;
+                }
+                last_min_ts = min_ts;
+                txn_mgr->CommitTxn(txn);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(violation_count.load(), 0u);
+
+    Txn *txn = txn_mgr->BeginTxn();
+    EXPECT_EQ(txn_mgr->GetMinUnflushedTS(), txn->BeginTS());
+    txn_mgr->CommitTxn(txn);
+}
@@ -544,4 +544,63 @@ TEST_F(CatalogDeltaEntryTest, ComplicateMergeEntries) {
             EXPECT_EQ(merged_entry->operations().size(), 1u);
         }
     }
-}
\ No newline at end of file
+}
+
+TEST_F(CatalogDeltaEntryTest, MergeDeltaFiles) {
+    std::shared_ptr<std::string> config_path = nullptr;
+    InfinityContext::instance().Init(config_path);
+
+    auto db_name = MakeShared<String>("db_test");
+    auto db_dir = MakeShared<String>("data");
+    auto table_name = MakeShared<String>("table_test");
+    auto table_entry_dir = MakeShared<String>("data/db_test/table_test");
+
+    auto MakeDeltaEntry = [&](TxnTimeStamp commit_ts, Vector<Pair<bool, MergeFlag>> ops) {
+        auto delta_entry = std::make_unique<CatalogDeltaEntry>();
+        delta_entry->set_txn_ids({commit_ts});
+        delta_entry->set_commit_ts(commit_ts);
+        for (auto [is_db, merge_flag] : ops) {
+            if (is_db) {
+                auto op = MakeUnique<AddDBEntryOp>();
+                op->db_name_ = db_name;
+                op->db_entry_dir_ = db_dir;
+                op->merge_flag_ = merge_flag;
+                op->commit_ts_ = commit_ts;
+                delta_entry->operations().push_back(std::move(op));
+            } else {
+                auto op = MakeUnique<AddTableEntryOp>();
+                op->db_name_ = db_name;
+                op->table_name_ = table_name;
+                op->table_entry_dir_ = table_entry_dir;
+                op->merge_flag_ = merge_flag;
+                op->commit_ts_ = commit_ts;
+                delta_entry->operations().push_back(std::move(op));
+            }
+        }
+        return delta_entry;
+    };
+
+    {
+        // The table is created and dropped in between, only the database is left.
+        Vector<UniquePtr<CatalogDeltaEntry>> delta_entries;
+        delta_entries.push_back(MakeDeltaEntry(1, {{true, MergeFlag::kNew}, {false, MergeFlag::kNew}}));
+        delta_entries.push_back(MakeDeltaEntry(2, {{false, MergeFlag::kUpdate}}));
+        delta_entries.push_back(MakeDeltaEntry(3, {{false, MergeFlag::kDelete}}));
+        auto merged_entry = CatalogDeltaEntry::Merge(std::move(delta_entries));
+        EXPECT_EQ(merged_entry->commit_ts(), 3u);
+        ASSERT_EQ(merged_entry->operations().size(), 1u);
+        EXPECT_EQ(merged_entry->operations()[0]->GetType(), CatalogDeltaOpType::ADD_DATABASE_ENTRY);
+        EXPECT_EQ(merged_entry->operations()[0]->merge_flag_, MergeFlag::kNew);
+    }
+    {
+        // Updates of the same table fold into its latest op.
+        Vector<UniquePtr<CatalogDeltaEntry>> delta_entries;
+        for (TxnTimeStamp commit_ts = 1; commit_ts <= 10; ++commit_ts) {
+            delta_entries.push_back(MakeDeltaEntry(commit_ts, {{false, MergeFlag::kUpdate}}));
+        }
+        auto merged_entry = CatalogDeltaEntry::Merge(std::move(delta_entries));
+        ASSERT_EQ(merged_entry->operations().size(), 1u);
+        EXPECT_EQ(merged_entry->operations()[0]->commit_ts_, 10u);
+    }
+    infinity::InfinityContext::instance().UnInit();
+}
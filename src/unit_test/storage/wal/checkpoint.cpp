@@ -209,6 +209,12 @@ TEST_F(CheckpointTest, test_cleanup_and_checkpoint) {
     WaitCleanup(catalog, txn_mgr, last_commit_ts);
     usleep(5000 * 1000);
     WaitFlushDeltaOp(txn_mgr, last_commit_ts);
+    {
+        // at least the full checkpoint at startup
+        CheckpointStatistics checkpoint_stats = catalog->GetCheckpointStatistics();
+        EXPECT_GT(checkpoint_stats.checkpoint_count_, 0u);
+        EXPECT_GT(checkpoint_stats.total_written_bytes_, 0u);
+    }
     infinity::InfinityContext::instance().UnInit();
 #ifdef INFINITY_DEBUG
     EXPECT_EQ(infinity::GlobalResourceUsage::GetObjectCount(), 0);
@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include "unit_test/base_test.h"
+#include <filesystem>
+#include <fstream>
 
 import stl;
 import global_resource_usage;
@@ -239,3 +241,24 @@ TEST_F(RecycleLogTest, recycle_wal_after_full_checkpoint) {
 #endif
     }
 }
+
+TEST_F(RecycleLogTest, parse_merged_delta_catalog_files) {
+    std::shared_ptr<std::string> config_path = nullptr;
+    infinity::InfinityContext::instance().Init(config_path);
+    String catalog_dir = "/tmp/infinity/catalog_parse_test";
+    std::filesystem::create_directories(catalog_dir);
+    for (const char *filename : {"FULL.10.snap", "DELTA.8", "DELTA.12", "DELTA.15", "MERGED_DELTA.15", "DELTA.18", "_MERGED_DELTA.18", "DELTA.25"}) {
+        std::ofstream ofs(catalog_dir + "/" + filename);
+    }
+    auto catalog_fileinfo = CatalogFile::ParseValidCheckpointFilenames(catalog_dir, 20);
+    ASSERT_TRUE(catalog_fileinfo.has_value());
+    const auto &[full_info, delta_infos] = catalog_fileinfo.value();
+    EXPECT_EQ(full_info.max_commit_ts_, 10u);
+    // The merged file replaces the delta files up to its ts, even those left by an interrupted merge.
+    ASSERT_EQ(delta_infos.size(), 2u);
+    EXPECT_EQ(delta_infos[0].path_, catalog_dir + "/MERGED_DELTA.15");
+    EXPECT_TRUE(delta_infos[0].merged_);
+    EXPECT_EQ(delta_infos[1].path_, catalog_dir + "/DELTA.18");
+    EXPECT_FALSE(delta_infos[1].merged_);
+    infinity::InfinityContext::instance().UnInit();
+}
@@ -396,3 +396,92 @@ TEST_F(WalEntryTest, WalListIterator) {
     EXPECT_EQ(catalog_path, "/tmp/infinity/data/catalog/META_123.full.json");
     EXPECT_EQ(replay_entries.size(), 1u);
 }
+
+TEST_F(WalEntryTest, WalListIteratorParallelDecode) {
+    using namespace infinity;
+    String wal_file_path = "/tmp/infinity/wal/wal.log";
+    std::filesystem::remove(wal_file_path);
+    MockWalFile(wal_file_path);
+
+    Vector<SharedPtr<WalEntry>> expected_entries;
+    {
+        WalListIterator iterator({wal_file_path});
+        for (auto entry = iterator.Next(); entry != nullptr; entry = iterator.Next()) {
+            expected_entries.push_back(entry);
+        }
+    }
+    EXPECT_EQ(expected_entries.size(), 6u);
+
+    ThreadPool thread_pool(3);
+    {
+        WalListIterator iterator({wal_file_path}, &thread_pool);
+        for (const auto &expected_entry : expected_entries) {
+            auto entry = iterator.Next();
+            ASSERT_NE(entry, nullptr);
+            EXPECT_EQ(entry->commit_ts_, expected_entry->commit_ts_);
+            EXPECT_TRUE(*entry == *expected_entry);
+        }
+        EXPECT_EQ(iterator.Next(), nullptr);
+    }
+
+    // Corrupt the second entry from the end, the entries before it are not returned.
+    {
+        std::fstream fs(wal_file_path, std::ios::in | std::ios::out | std::ios::binary);
+        fs.seekp(-(expected_entries[0]->size_ + expected_entries[1]->size_ / 2), std::ios::end);
+        fs.put('\xff');
+    }
+    {
+        WalListIterator iterator({wal_file_path}, &thread_pool);
+        auto entry = iterator.Next();
+        ASSERT_NE(entry, nullptr);
+        EXPECT_EQ(entry->commit_ts_, expected_entries[0]->commit_ts_);
+        EXPECT_EQ(iterator.Next(), nullptr);
+    }
+}
+
+TEST_F(WalEntryTest, CompressCmds) {
+    using namespace infinity;
+    auto entry = MakeShared<WalEntry>();
+    entry->txn_id_ = 7;
+    entry->commit_ts_ = 8;
+    {
+        auto data_block = DataBlock::Make();
+        Vector<SharedPtr<DataType>> column_types;
+        column_types.emplace_back(MakeShared<DataType>(LogicalType::kBoolean));
+        column_types.emplace_back(MakeShared<DataType>(LogicalType::kTinyInt));
+        SizeT row_count = DEFAULT_VECTOR_SIZE;
+        data_block->Init(column_types);
+        for (SizeT i = 0; i < row_count; ++i) {
+            data_block->AppendValue(0, Value::MakeBool(i % 2 == 0));
+            data_block->AppendValue(1, Value::MakeTinyInt(static_cast<i8>(i)));
+        }
+        data_block->Finalize();
+        entry->cmds_.push_back(MakeShared<WalCmdAppend>("db1", "tbl1", data_block));
+    }
+    entry->cmds_.push_back(MakeShared<WalCmdDelete>("db1", "tbl1", Vector<RowID>{RowID(1, 3)}));
+    i32 raw_size = entry->GetSizeInBytes();
+
+    // below the threshold
+    entry->CompressCmds(raw_size * 2);
+    EXPECT_TRUE(entry->compressed_cmds_.empty());
+    EXPECT_EQ(entry->GetSizeInBytes(), raw_size);
+
+    entry->CompressCmds(1024);
+    EXPECT_FALSE(entry->compressed_cmds_.empty());
+    i32 exp_size = entry->GetSizeInBytes();
+    EXPECT_LT(exp_size, raw_size);
+
+    Vector<char> buf(exp_size, char(0));
+    char *ptr = buf.data();
+    entry->WriteAdv(ptr);
+    EXPECT_EQ(ptr - buf.data(), exp_size);
+
+    ptr = buf.data();
+    SharedPtr<WalEntry> entry2 = WalEntry::ReadAdv(ptr, exp_size);
+    ASSERT_NE(entry2, nullptr);
+    EXPECT_EQ(ptr - buf.data(), exp_size);
+    EXPECT_EQ(entry2->txn_id_, 7);
+    EXPECT_EQ(entry2->commit_ts_, 8u);
+    EXPECT_TRUE(entry2->compressed_cmds_.empty());
+    EXPECT_TRUE(*entry == *entry2);
+}
@@ -0,0 +1,132 @@
+//  Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include "unit_test/base_test.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+import stl;
+import wal_file_writer;
+
+using namespace infinity;
+
+class WalFileWriterTest : public BaseTest {
+protected:
+    String wal_dir_ = "/tmp/infinity/wal_file_writer_test";
+
+    void SetUp() override {
+        std::filesystem::remove_all(wal_dir_);
+        std::filesystem::create_directories(wal_dir_);
+    }
+
+    void TearDown() override { std::filesystem::remove_all(wal_dir_); }
+
+    static String ReadFile(const String &path) {
+        std::ifstream ifs(path, std::ios::binary);
+        return String(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+    }
+};
+
+TEST_F(WalFileWriterTest, WriteBatch) {
+    String path = wal_dir_ + "/wal.log";
+    WalFileWriter writer;
+    writer.Open(path);
+    EXPECT_TRUE(writer.IsOpen());
+    EXPECT_EQ(writer.FileSize(), 0u);
+    EXPECT_FALSE(writer.Dirty());
+    EXPECT_FALSE(writer.Sync());
+
+    String a = "hello ", b = "", c(5000, 'x');
+    writer.Write({{a.data(), a.size()}, {b.data(), b.size()}, {c.data(), c.size()}});
+    EXPECT_EQ(writer.FileSize(), a.size() + c.size());
+    EXPECT_TRUE(writer.Dirty());
+    EXPECT_TRUE(writer.Sync());
+    EXPECT_FALSE(writer.Dirty());
+    EXPECT_FALSE(writer.Sync());
+    writer.Close(true);
+    EXPECT_FALSE(writer.IsOpen());
+    EXPECT_EQ(ReadFile(path), a + c);
+}
+
+TEST_F(WalFileWriterTest, Reopen) {
+    String path = wal_dir_ + "/wal.log";
+    WalFileWriter writer;
+    writer.Open(path);
+    String a = "first batch";
+    writer.Write({{a.data(), a.size()}});
+    writer.Close(false);
+
+    // appends after the existing content, like a restarted or swapped wal file
+    writer.Open(path);
+    EXPECT_EQ(writer.FileSize(), a.size());
+    EXPECT_FALSE(writer.Dirty());
+    Vector<String> entries;
+    Vector<Pair<const char *, SizeT>> buffers;
+    for (SizeT i = 0; i < 2000; ++i) {
+        entries.push_back(std::to_string(i) + ";");
+    }
+    for (const auto &entry : entries) {
+        buffers.emplace_back(entry.data(), entry.size());
+    }
+    // more buffers than IOV_MAX
+    writer.Write(buffers);
+    writer.Close(true);
+
+    String expected = a;
+    for (const auto &entry : entries) {
+        expected += entry;
+    }
+    EXPECT_EQ(ReadFile(path), expected);
+}
+
+TEST_F(WalFileWriterTest, WriteBuffer) {
+    String path = wal_dir_ + "/wal.log";
+    WalFileWriter writer(3 * WalFileWriter::PAGE_SIZE);
+    writer.Open(path);
+    EXPECT_EQ(writer.BufferCapacity(), 3 * WalFileWriter::PAGE_SIZE);
+
+    String expected;
+    auto append = [&](SizeT size, char c, SizeT reserve_more = 0) {
+        bool empty = writer.BufferedSize() == 0;
+        char *buf = writer.Reserve(size + reserve_more);
+        if (empty || writer.BufferedSize() == 0) {
+            EXPECT_EQ(reinterpret_cast<uintptr_t>(buf) % WalFileWriter::PAGE_SIZE, 0u);
+        }
+        std::memset(buf, c, size);
+        writer.Commit(size);
+        expected.append(size, c);
+    };
+    append(100, 'a', 50);
+    append(5000, 'b');
+    EXPECT_EQ(writer.BufferedSize(), 5100u);
+    EXPECT_EQ(writer.FileSize(), 0u);
+    // doesn't fit behind the buffered data, which gets written first
+    append(8000, 'c');
+    EXPECT_EQ(writer.FileSize(), 5100u);
+    EXPECT_EQ(writer.BufferedSize(), 8000u);
+    // larger than the whole buffer
+    append(20000, 'd');
+    EXPECT_EQ(writer.FileSize(), 13100u);
+    EXPECT_GE(writer.BufferCapacity(), 20000u);
+    writer.FlushBuffer();
+    EXPECT_EQ(writer.BufferedSize(), 0u);
+    EXPECT_EQ(writer.FileSize(), 33100u);
+    EXPECT_EQ(writer.BufferCapacity(), 3 * WalFileWriter::PAGE_SIZE);
+    // buffered data is written on close
+    append(10, 'e');
+    writer.Close(true);
+    EXPECT_EQ(ReadFile(path), expected);
+}
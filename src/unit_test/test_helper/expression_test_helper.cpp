@@ -0,0 +1,59 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+module;
+
+module expression_test_helper;
+
+import stl;
+import third_party;
+import catalog;
+import function_set;
+import scalar_function;
+import scalar_function_set;
+import base_expression;
+import reference_expression;
+import function_expression;
+import expression_state;
+import expression_selector;
+import data_block;
+import value;
+import logical_type;
+import data_type;
+
+namespace infinity {
+
+SharedPtr<BaseExpression> ExpressionTestHelper::MakeColumn(LogicalType type, SizeT column_idx) {
+    return ReferenceExpression::Make(DataType(type), "t1", fmt::format("c{}", column_idx), String(), column_idx);
+}
+
+SharedPtr<BaseExpression> ExpressionTestHelper::MakeFunction(Catalog *catalog, const String &name, Vector<SharedPtr<BaseExpression>> arguments) {
+    SharedPtr<FunctionSet> function_set = Catalog::GetFunctionSetByName(catalog, name);
+    ScalarFunction func = std::static_pointer_cast<ScalarFunctionSet>(function_set)->GetMostMatchFunction(arguments);
+    return MakeShared<FunctionExpression>(func, std::move(arguments));
+}
+
+Vector<SizeT> ExpressionTestHelper::SelectRows(ExpressionSelector &selector, const SharedPtr<BaseExpression> &expr, const DataBlock *data_block) {
+    SharedPtr<ExpressionState> state = ExpressionState::CreateState(expr);
+    DataBlock output_block;
+    SizeT count = selector.Select(expr, state, data_block, &output_block, data_block->row_count());
+    Vector<SizeT> rows;
+    for (SizeT i = 0; i < count; ++i) {
+        rows.push_back(output_block.GetValue(0, i).value_.big_int);
+    }
+    return rows;
+}
+
+} // namespace infinity
@@ -0,0 +1,42 @@
+// Copyright(C) 2023 InfiniFlow, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+module;
+
+export module expression_test_helper;
+
+import stl;
+import catalog;
+import base_expression;
+import expression_selector;
+import data_block;
+import logical_type;
+
+namespace infinity {
+
+// Builders shared by the expression unit tests.
+export class ExpressionTestHelper {
+public:
+    // column "c{column_idx}" of table "t1"
+    static SharedPtr<BaseExpression> MakeColumn(LogicalType type, SizeT column_idx);
+
+    // the scalar function of the catalog best matching the argument types
+    static SharedPtr<BaseExpression> MakeFunction(Catalog *catalog, const String &name, Vector<SharedPtr<BaseExpression>> arguments);
+
+    // Filters the block with the expression, returns column 0 of the selected rows, a BigInt row number.
+    static Vector<SizeT> SelectRows(ExpressionSelector &selector, const SharedPtr<BaseExpression> &expr, const DataBlock *data_block);
+};
+
+} // namespace infinity